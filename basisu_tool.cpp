@@ -122,7 +122,8 @@ enum tool_mode
 	cTinyDDSInfo,
 	cKTXInfo,
 	cBenchmarkSingle,
-	cBenchmarkSweep
+	cBenchmarkSweep,
+	cTrainGlobalCodebooks
 };
 
 static void print_usage()
@@ -321,6 +322,16 @@ class command_line_params
 			m_transcode_disable_deblocking = true;
 			return true;
 		}
+		else if (opt_match(pArg, "-stream_zstd_transcoding"))
+		{
+			m_stream_zstd_transcoding = true;
+			return true;
+		}
+		else if (opt_match(pArg, "-mmap"))
+		{
+			m_use_mmap = true;
+			return true;
+		}
 		
 		return false;
 	}
@@ -1099,6 +1110,11 @@ class command_line_params
 			// TODO
 		}
 #endif
+		else if (opt_match(pArg, "-train_global_codebooks"))
+		{
+			m_mode = cTrainGlobalCodebooks;
+			return true;
+		}
 		else if (opt_match(pArg, "-use_global_codebooks"))
 		{
 			REMAINING_ARGS_CHECK(1);
@@ -1106,6 +1122,11 @@ class command_line_params
 			arg_count++;
 			return true;
 		}
+		else if (opt_match(pArg, "-fast_global_codebooks"))
+		{
+			m_comp_params.m_fast_global_codebook_search = true;
+			return true;
+		}
 		else if (opt_match(pArg, "-etc1_only"))
 		{
 			m_etc1_only = true;
@@ -1213,6 +1234,8 @@ public:
 		m_higher_quality_transcoding(false), 
 		m_transcode_force_deblocking(false), 
 		m_transcode_disable_deblocking(false), 
+		m_stream_zstd_transcoding(false),
+		m_use_mmap(false),
 		m_effort_level(-1),
 		m_quality_level(-1),
 		m_used_old_style_codec_config_param(false)
@@ -1669,12 +1692,43 @@ public:
 			{
 #if BASISU_SUPPORT_SSE
 				g_cpu_supports_sse41 = false;
+				g_cpu_supports_avx2 = false;
 #endif
 			}
+			else if (opt_match(pArg, "-no_avx2"))
+			{
+				g_cpu_supports_avx2 = false;
+			}
 			else if (opt_match(pArg, {"-no_status_output", "-quiet"}))
 			{
 				m_comp_params.m_status_output = false;
 			}
+			else if (opt_match(pArg, "-deadline"))
+			{
+				REMAINING_ARGS_CHECK(1);
+				m_comp_params.m_encode_deadline_secs = (float)atof(arg_v[arg_index + 1]);
+				arg_count++;
+			}
+			else if (opt_match(pArg, "-target_time"))
+			{
+				REMAINING_ARGS_CHECK(1);
+				m_comp_params.m_target_encode_time_secs = (float)atof(arg_v[arg_index + 1]);
+				arg_count++;
+			}
+			else if (opt_match(pArg, "-strip_height"))
+			{
+				REMAINING_ARGS_CHECK(1);
+				m_comp_params.m_strip_height = atoi(arg_v[arg_index + 1]);
+				arg_count++;
+			}
+			else if (opt_match(pArg, "-low_memory"))
+				m_comp_params.m_low_memory = true;
+			else if (opt_match(pArg, "-trace"))
+			{
+				REMAINING_ARGS_CHECK(1);
+				m_trace_filename = arg_v[arg_index + 1];
+				arg_count++;
+			}
 			else if (opt_match(pArg, "-file"))
 			{
 				REMAINING_ARGS_CHECK(1);
@@ -1936,6 +1990,12 @@ public:
 				m_comp_params.m_us_per_frame = clamp<int>(static_cast<int>(us_per_frame + .5f), 0, basist::cBASISMaxUSPerFrame);
 				arg_count++;
 			}
+			else if (opt_match(pArg, "-iframe_interval"))
+			{
+				REMAINING_ARGS_CHECK(1);
+				m_comp_params.m_etc1s_video_iframe_interval = maximum(0, atoi(arg_v[arg_index + 1]));
+				arg_count++;
+			}
 			else if (opt_match(pArg, "-cubemap"))
 			{
 				m_comp_params.m_tex_type = basist::cBASISTexTypeCubemapArray;
@@ -2170,6 +2230,9 @@ public:
 
 	std::string m_csv_file;
 
+	// -trace: Chrome trace event JSON file to write the compression profile to.
+	std::string m_trace_filename;
+
 	std::string m_etc1s_use_global_codebooks_file;
 
 	std::string m_test_file_dir;
@@ -2215,6 +2278,8 @@ public:
 	bool m_higher_quality_transcoding;
 	bool m_transcode_force_deblocking;
 	bool m_transcode_disable_deblocking; 
+	bool m_stream_zstd_transcoding;
+	bool m_use_mmap; // -mmap: memory map -info/-unpack/-validate input files instead of reading them into memory
 	
 	int m_effort_level;
 	int m_quality_level; // new-style -quality X
@@ -2311,6 +2376,35 @@ static basis_data *load_basis_file(const char *pInput_filename, bool force_etc1s
 	return p;
 }
 
+// Loads the codebooks for -use_global_codebooks: either a codebook file written by -train_global_codebooks, or any ETC1S .basis file 
+// (whose codebooks are used).
+static basis_data* load_global_codebooks(const char* pFilename)
+{
+	uint8_vec file_data;
+	if (!basisu::read_file_to_vec(pFilename, file_data))
+	{
+		error_printf("Failed reading file \"%s\"\n", pFilename);
+		return nullptr;
+	}
+
+	if ((file_data.size() < sizeof(basist::basis_global_codebooks_header)) || 
+		(reinterpret_cast<const basist::basis_global_codebooks_header*>(file_data.data())->m_sig != basist::basis_global_codebooks_header::cSigValue))
+	{
+		return load_basis_file(pFilename, true);
+	}
+
+	basis_data* p = new basis_data;
+	if (!p->m_transcoder.get_lowlevel_etc1s_decoder().decode_global_codebooks(file_data.data(), file_data.size_u32()))
+	{
+		error_printf("Failed decoding global codebook file \"%s\"\n", pFilename);
+		delete p;
+		return nullptr;
+	}
+
+	p->m_file_data.swap(file_data);
+	return p;
+}
+
 static uint32_t get_transcode_flags_from_options(const command_line_params& opts)
 {
 	uint32_t transcode_flags = opts.m_higher_quality_transcoding ? basist::cDecodeFlagsHighQuality : 0;
@@ -2324,6 +2418,8 @@ static uint32_t get_transcode_flags_from_options(const command_line_params& opts
 		transcode_flags |= basist::cDecodeFlagsNoETC1SChromaFiltering;
 	if (opts.m_xuastc_ldr_disable_bc7_transcoding)
 		transcode_flags |= basist::cDecodeFlagXUASTCLDRDisableFastBC7Transcoding;
+	if (opts.m_stream_zstd_transcoding)
+		transcode_flags |= basist::cDecodeFlagsStreamZstdLevelData;
 
 	return transcode_flags;
 }
@@ -2362,11 +2458,11 @@ static bool compress_mode(command_line_params &opts)
 	basis_data* pGlobal_codebook_data = nullptr;
 	if (opts.m_etc1s_use_global_codebooks_file.size())
 	{
-		pGlobal_codebook_data = load_basis_file(opts.m_etc1s_use_global_codebooks_file.c_str(), true);
+		pGlobal_codebook_data = load_global_codebooks(opts.m_etc1s_use_global_codebooks_file.c_str());
 		if (!pGlobal_codebook_data)
 			return false;
 
-		printf("Loaded global codebooks from .basis file \"%s\"\n", opts.m_etc1s_use_global_codebooks_file.c_str());
+		printf("Loaded global codebooks from file \"%s\"\n", opts.m_etc1s_use_global_codebooks_file.c_str());
 	}
 						
 	basis_compressor_params &params = opts.m_comp_params;
@@ -2426,6 +2522,10 @@ static bool compress_mode(command_line_params &opts)
 	}
 
 	printf("Processing %u total file(s)\n", (uint32_t)opts.m_input_filenames.size());
+
+	// One trace session covers all the files, including parallel compression.
+	if (opts.m_trace_filename.size())
+		trace_recorder::begin_session();
 				
 	interval_timer all_tm;
 	all_tm.start();
@@ -2531,11 +2631,13 @@ static bool compress_mode(command_line_params &opts)
 
 				if (params.m_status_output)
 				{
-					fmt_printf("Compression succeeded to file \"{}\" size {} bytes in {3.3} secs, {3.3} bits/texel\n",
+					fmt_printf("Compression succeeded to file \"{}\" size {} bytes in {3.3} secs, {3.3} bits/texel, peak RSS {3.1} MB, peak buffers {3.1} MB\n",
 						params.m_out_filename.c_str(),
-						opts.m_ktx2_mode ? (uint64_t)c.get_output_ktx2_file().size() : (uint64_t)c.get_output_basis_file().size(),
+						opts.m_ktx2_mode ? c.get_ktx2_file_size() : (uint64_t)c.get_output_basis_file().size(),
 						tm.get_elapsed_secs(),
-						opts.m_ktx2_mode ? c.get_ktx2_bits_per_texel() : c.get_basis_bits_per_texel());
+						opts.m_ktx2_mode ? c.get_ktx2_bits_per_texel() : c.get_basis_bits_per_texel(),
+						c.get_stats().size() ? (c.get_stats()[0].m_peak_rss_bytes / (1024.0f * 1024.0f)) : 0.0f,
+						c.get_peak_buffer_bytes() / (1024.0f * 1024.0f));
 				}
 			}
 			else
@@ -2598,6 +2700,15 @@ static bool compress_mode(command_line_params &opts)
 				case basis_compressor::cECFailedCreateKTX2File:
 					error_printf("Compressor failed creating KTX2 file data!\n");
 					break;
+				case basis_compressor::cECDeadlineExceeded:
+				{
+					error_printf("Compressor exceeded the -deadline time limit!\n");
+
+					if (opts.m_individual)
+						exit_flag = false;
+
+					break;
+				}
 				default:
 					error_printf("basis_compress::process() failed!\n");
 					break;
@@ -2703,6 +2814,16 @@ static bool compress_mode(command_line_params &opts)
 	if (total_files > 1)
 		printf("Total compression time: %3.3f secs\n", all_tm.get_elapsed_secs());
 
+	if (opts.m_trace_filename.size())
+	{
+		trace_recorder::end_session();
+
+		if (trace_recorder::write_json(opts.m_trace_filename.c_str()))
+			printf("Wrote trace file \"%s\" (%zu events)\n", opts.m_trace_filename.c_str(), trace_recorder::get_total_events());
+		else
+			result = false;
+	}
+
 	if (pCSV_file)
 	{
 		fclose(pCSV_file);
@@ -2717,12 +2838,13 @@ static bool compress_mode(command_line_params &opts)
 static bool unpack_and_validate_ktx2_file(
 	uint32_t file_index,
 	const std::string& base_filename,
-	uint8_vec& ktx2_file_data,
+	const readable_span<uint8_t>& ktx2_file_data,
 	command_line_params& opts,
 	FILE* pCSV_file,
 	basis_data* pGlobal_codebook_data,
 	uint32_t& total_unpack_warnings,
-	uint32_t& total_pvrtc_nonpow2_warnings)
+	uint32_t& total_pvrtc_nonpow2_warnings,
+	memory_mapped_file* pMapped_file = nullptr)
 {
 	BASISU_NOTE_UNUSED(pCSV_file);
 	BASISU_NOTE_UNUSED(file_index);
@@ -2737,7 +2859,7 @@ static bool unpack_and_validate_ktx2_file(
 
 	basist::ktx2_transcoder dec;
 
-	if (!dec.init(ktx2_file_data.data(), ktx2_file_data.size_u32()))
+	if (!dec.init(ktx2_file_data.get_ptr(), (uint32_t)ktx2_file_data.size()))
 	{
 		error_printf("ktx2_transcoder::init() failed! File either uses an unsupported feature, is invalid, was corrupted, or this is a bug.\n");
 		return false;
@@ -3040,6 +3162,14 @@ static bool unpack_and_validate_ktx2_file(
 		return true;
 	}
 
+	// Everything up to here only touched the header, level index, DFD, KVD and SGD. When the file is memory mapped,
+	// ask the OS to start paging in the level data now that we know we're going to transcode all of it.
+	if (pMapped_file)
+	{
+		for (uint32_t level_index = 0; level_index < dec.get_levels(); level_index++)
+			advise_mapped_ktx2_level(*pMapped_file, dec, level_index, memory_mapped_file::cHintWillNeed);
+	}
+
 	// gpu_images[format][face][layer][level]
 
 	basisu::vector< gpu_image_vec > gpu_images[(int)basist::transcoder_texture_format::cTFTotalTextureFormats][6];
@@ -3886,7 +4016,7 @@ static bool vec_is_ascii(const uint8_vec& v)
 static bool unpack_and_validate_basis_file(
 	uint32_t file_index,
 	const std::string &base_filename,
-	uint8_vec &basis_file_data,
+	const readable_span<uint8_t>& basis_file_data,
 	command_line_params& opts, 
 	FILE *pCSV_file,
 	basis_data* pGlobal_codebook_data,
@@ -5032,7 +5162,7 @@ static bool unpack_and_validate_basis_file(
 // -unpack_format_only N (restrict to the single transcoder format whose enum index == N). BC6H/HDR DDS is future work (post v2.5).
 static bool unpack_and_validate_dds_file(
 	const std::string& base_filename,
-	uint8_vec& dds_file_data,
+	const readable_span<uint8_t>& dds_file_data,
 	command_line_params& opts,
 	uint32_t& total_unpack_warnings,
 	uint32_t& total_pvrtc_nonpow2_warnings)
@@ -5045,7 +5175,7 @@ static bool unpack_and_validate_dds_file(
 
 	basist::dds_transcoder dec;
 
-	if (!dec.init(dds_file_data.data(), dds_file_data.size_u32()))
+	if (!dec.init(dds_file_data.get_ptr(), (uint32_t)dds_file_data.size()))
 	{
 		error_printf("dds_transcoder::init() failed! File either uses an unsupported feature, is invalid, was corrupted, or this is a bug.\n");
 		return false;
@@ -5420,10 +5550,10 @@ static bool unpack_and_validate_dds_file(
 }
 
 // Prints basic header info about a PNG file (used by -info). Uses pv_png::get_png_info (no full decode).
-static bool print_png_info(const char* pInput_filename, const uint8_vec& file_data)
+static bool print_png_info(const char* pInput_filename, const readable_span<uint8_t>& file_data)
 {
 	pv_png::png_info info;
-	if (!pv_png::get_png_info(file_data.data(), file_data.size(), info))
+	if (!pv_png::get_png_info(file_data.get_ptr(), file_data.size(), info))
 	{
 		error_printf("Failed parsing PNG file \"%s\"\n", pInput_filename);
 		return false;
@@ -5461,7 +5591,7 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 	basis_data* pGlobal_codebook_data = nullptr;
 	if (opts.m_etc1s_use_global_codebooks_file.size())
 	{
-		pGlobal_codebook_data = load_basis_file(opts.m_etc1s_use_global_codebooks_file.c_str(), true);
+		pGlobal_codebook_data = load_global_codebooks(opts.m_etc1s_use_global_codebooks_file.c_str());
 		if (!pGlobal_codebook_data)
 		{
 			error_printf("Failed loading global codebook data from file \"%s\"\n", opts.m_etc1s_use_global_codebooks_file.c_str());
@@ -5506,8 +5636,23 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 		if (opts.m_output_path.size())
 			string_combine_path(base_filename, opts.m_output_path.c_str(), base_filename.c_str());
 
-		uint8_vec file_data;
-		if (!basisu::read_file_to_vec(pInput_filename, file_data))
+		// With -mmap the file is mapped read-only and the transcoders work directly on the mapping, so only the
+		// pages actually touched (headers/indices for -info, plus level data for -unpack/-validate) are read from disk.
+		uint8_vec file_buf;
+		memory_mapped_file mapped_file;
+		if (opts.m_use_mmap)
+		{
+			if (!mapped_file.open(pInput_filename))
+			{
+				error_printf("Failed memory mapping file \"%s\"\n", pInput_filename);
+				if (pCSV_file) fclose(pCSV_file);
+				delete pGlobal_codebook_data; pGlobal_codebook_data = nullptr;
+				return false;
+			}
+
+			mapped_file.advise((opts.m_mode == cInfo) ? memory_mapped_file::cHintRandom : memory_mapped_file::cHintSequential);
+		}
+		else if (!basisu::read_file_to_vec(pInput_filename, file_buf))
 		{
 			error_printf("Failed reading file \"%s\"\n", pInput_filename);
 			if (pCSV_file) fclose(pCSV_file);
@@ -5515,6 +5660,10 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 			return false;
 		}
 
+		const readable_span<uint8_t> file_data(opts.m_use_mmap ?
+			readable_span<uint8_t>(mapped_file.get_ptr(), (size_t)mapped_file.get_size()) :
+			readable_span<uint8_t>(file_buf.data(), file_buf.size()));
+
 		if (!file_data.size())
 		{
 			error_printf("File is empty!\n");
@@ -5533,17 +5682,17 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 		
 		bool is_ktx2 = false;
 		if (file_data.size() >= sizeof(basist::g_ktx2_file_identifier))
-			is_ktx2 = (memcmp(file_data.data(), basist::g_ktx2_file_identifier, sizeof(basist::g_ktx2_file_identifier)) == 0);
+			is_ktx2 = (memcmp(file_data.get_ptr(), basist::g_ktx2_file_identifier, sizeof(basist::g_ktx2_file_identifier)) == 0);
 
 		// Microsoft DDS magic ("DDS ", 0x20534444 little-endian).
 		bool is_dds = false;
 		if (file_data.size() >= 4)
-			is_dds = (memcmp(file_data.data(), "DDS ", 4) == 0);
+			is_dds = (memcmp(file_data.get_ptr(), "DDS ", 4) == 0);
 
 		// KTX1 (.ktx) 12-byte identifier. KTX1 holds already-compressed GPU data we can't transcode here,
 		// so we just print its header info (via print_ktx_info), regardless of mode.
 		static const uint8_t s_ktx1_identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
-		const bool is_ktx1 = (file_data.size() >= 12) && (memcmp(file_data.data(), s_ktx1_identifier, 12) == 0);
+		const bool is_ktx1 = (file_data.size() >= 12) && (memcmp(file_data.get_ptr(), s_ktx1_identifier, 12) == 0);
 
 		// .basis container 2-byte signature ("sB", i.e. cBASISSigValue stored little-endian).
 		bool is_basis = false;
@@ -5552,7 +5701,7 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 
 		// PNG 8-byte signature.
 		static const uint8_t s_png_identifier[8] = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
-		const bool is_png = (file_data.size() >= 8) && (memcmp(file_data.data(), s_png_identifier, 8) == 0);
+		const bool is_png = (file_data.size() >= 8) && (memcmp(file_data.get_ptr(), s_png_identifier, 8) == 0);
 
 		// Detect by magic, not extension, so each file in a mixed input list routes correctly. The fallback
 		// (else) path below still attempts a .basis parse for an unrecognized file, which fails with a clear error.
@@ -5570,7 +5719,8 @@ static bool unpack_and_validate_mode(command_line_params &opts)
 				pCSV_file,
 				pGlobal_codebook_data,
 				total_unpack_warnings,
-				total_pvrtc_nonpow2_warnings);
+				total_pvrtc_nonpow2_warnings,
+				opts.m_use_mmap ? &mapped_file : nullptr);
 		}
 		else if (is_dds)
 		{
@@ -9240,6 +9390,101 @@ static bool parse_export_dds_format(const std::string& s, basist::transcoder_tex
 
 // Writes a basic DX10 .dds file from source image(s). Uses basis_compressor in process_source_images()
 // mode to load/mipmap/lay-out the slices, then packs them to the requested format (see basisu_dds_export.*).
+// -train_global_codebooks: trains one shared ETC1S codebook over all the input images, and writes it as a codebook file for 
+// -use_global_codebooks. Directories are expanded to the image files under them.
+static bool train_global_codebooks_mode(command_line_params& opts)
+{
+	basisu::vector<std::string> filenames;
+
+	for (const std::string& input_filename : opts.m_input_filenames)
+	{
+		std::error_code ec;
+		const std::filesystem::path input_path(input_filename);
+
+		if (!std::filesystem::is_directory(input_path, ec))
+		{
+			filenames.push_back(input_filename);
+			continue;
+		}
+
+		// Sorted, so the codebooks don't depend on the directory enumeration order.
+		std::vector<std::string> dir_filenames;
+		for (std::filesystem::recursive_directory_iterator it(input_path, std::filesystem::directory_options::skip_permission_denied, ec), end; it != end; it.increment(ec))
+		{
+			if (ec) { ec.clear(); continue; }
+			std::error_code fec;
+			if (!it->is_regular_file(fec))
+				continue;
+
+			const std::string ext(string_tolower(string_get_extension(it->path().string())));
+			if ((ext == "png") || (ext == "tga") || (ext == "qoi") || (ext == "jpg") || (ext == "jpeg") || (ext == "jfif"))
+				dir_filenames.push_back(it->path().string());
+		}
+		std::sort(dir_filenames.begin(), dir_filenames.end());
+
+		for (const std::string& filename : dir_filenames)
+			filenames.push_back(filename);
+	}
+
+	if (!filenames.size())
+	{
+		error_printf("-train_global_codebooks: No input images to train on!\n");
+		return false;
+	}
+
+	if (!opts.m_comp_params.is_etc1s())
+	{
+		error_printf("-train_global_codebooks: Only ETC1S codebooks can be trained\n");
+		return false;
+	}
+
+	uint32_t num_threads = 1;
+	if (opts.m_comp_params.m_multithreading)
+	{
+		num_threads = get_num_hardware_threads();
+		if (num_threads < 1)
+			num_threads = 1;
+		if (num_threads > opts.m_max_threads)
+			num_threads = opts.m_max_threads;
+	}
+	job_pool jpool(num_threads);
+
+	basis_compressor_params params = opts.m_comp_params;
+	params.m_pJob_pool = &jpool;
+	params.m_read_source_images = true;
+	params.m_source_filenames = filenames;
+	params.m_source_alpha_filenames.clear();
+
+	printf("Training ETC1S global codebooks on %u image(s)\n", filenames.size_u32());
+
+	interval_timer tm;
+	tm.start();
+
+	uint8_vec codebook_file_data;
+	if (!basis_train_etc1s_global_codebooks(params, codebook_file_data))
+	{
+		error_printf("-train_global_codebooks: Training failed\n");
+		return false;
+	}
+
+	std::string output_filename(opts.m_output_filename.size() ? opts.m_output_filename : std::string("global_codebooks.basis_cb"));
+	if (opts.m_output_path.size())
+		string_combine_path(output_filename, opts.m_output_path.c_str(), output_filename.c_str());
+
+	if (!write_vec_to_file(output_filename.c_str(), codebook_file_data))
+	{
+		error_printf("Failed writing codebook file \"%s\"\n", output_filename.c_str());
+		return false;
+	}
+
+	const basist::basis_global_codebooks_header& hdr = *reinterpret_cast<const basist::basis_global_codebooks_header*>(codebook_file_data.data());
+
+	printf("Wrote codebook file \"%s\": %u endpoints, %u selectors, %u bytes, %3.3f secs\n", output_filename.c_str(),
+		(uint32_t)hdr.m_total_endpoints, (uint32_t)hdr.m_total_selectors, codebook_file_data.size_u32(), tm.get_elapsed_secs());
+
+	return true;
+}
+
 static bool dds_mode(command_line_params& opts)
 {
 	if (!opts.m_input_filenames.size())
@@ -9793,7 +10038,7 @@ static int main_internal(int argc, const char** argv)
 	}
 
 #if BASISU_SUPPORT_SSE
-	printf("Using SSE 4.1: %u, Multithreading: %u, Zstandard support: %u, OpenCL: %u\n", g_cpu_supports_sse41, (uint32_t)opts.m_comp_params.m_multithreading, basist::basisu_transcoder_supports_ktx2_zstd(), opencl_is_available());
+	printf("Using SSE 4.1: %u, AVX2: %u, Multithreading: %u, Zstandard support: %u, OpenCL: %u\n", g_cpu_supports_sse41, g_cpu_supports_avx2, (uint32_t)opts.m_comp_params.m_multithreading, basist::basisu_transcoder_supports_ktx2_zstd(), opencl_is_available());
 #else
 	printf("No SSE, Multithreading: %u, Zstandard support: %u, OpenCL: %u\n", (uint32_t)opts.m_comp_params.m_multithreading, basist::basisu_transcoder_supports_ktx2_zstd(), opencl_is_available());
 #endif
@@ -9912,6 +10157,9 @@ static int main_internal(int argc, const char** argv)
 	case cDDS:
 		status = dds_mode(opts);
 		break;
+	case cTrainGlobalCodebooks:
+		status = train_global_codebooks_mode(opts);
+		break;
 	case cExportDDS:
 		status = export_dds_mode(opts);
 		break;
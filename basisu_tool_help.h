@@ -36,6 +36,20 @@
 " -dds_bc7e_scalar_level <0-6>: bc7e_scalar quality: 0=ultrafast..6=slowest\n"
 "  (default 2); implies -dds_bc7e_scalar.\n"
 "\n"
+" -train_global_codebooks: Train one shared ETC1S endpoint/selector codebook over\n"
+"  all the input images (directories are expanded to the .PNG/.TGA/.QOI/.JPG\n"
+"  files under them) and write it to a codebook file, by default\n"
+"  global_codebooks.basis_cb (-output_file/-output_path override the name/dir).\n"
+"  -q or -max_endpoints/-max_selectors control the codebook sizes.\n"
+" -use_global_codebooks <file>: Encode ETC1S against a codebook file from\n"
+"  -train_global_codebooks (or the codebooks of any ETC1S .basis file) instead of\n"
+"  generating per-texture codebooks. Much faster, and .basis outputs don't contain\n"
+"  codebooks, so the same file must be given to transcode them (-unpack,\n"
+"  -validate, -info). .KTX2 outputs always contain their codebooks.\n"
+" -fast_global_codebooks: With -use_global_codebooks, only match each block\n"
+"  against the codebook endpoints near its own color instead of all of them.\n"
+"  Much faster with large trained codebooks, but approximate (output differs).\n"
+"\n"
 " -export_ktx <FORMAT>: Transcode each input .ktx2 to a compressed KTX1 (.ktx)\n"
 "  file (all mips, array layers, cubemap faces). FORMAT (compressed only): BC1\n"
 "  BC3 BC4 BC5 BC6H BC7 ETC1 ETC2 EAC_R11 EAC_RG11 PVRTC1 PVRTC2 ASTC ASTC_<WxH>\n"
@@ -257,6 +271,15 @@
 "  with -file), images converted to REC709 grayscale and used as input alpha\n"
 "\n"
 " -quiet or -no_status_output: Disable compressor's status output to stdout\n"
+" -deadline X: Abort the compression of each file if it takes longer than X seconds (0=no limit, the default)\n"
+" -target_time X: Automatically pick the effort level so each file compresses in about X seconds, overriding the\n"
+"  format's effort/level options. The encoder times trial encodes of a sample of blocks first (0=disabled, the default)\n"
+" -strip_height X: Read, encode and write the source image in strips of X texel rows, bounding peak memory by the strip\n"
+"  size (-ktx2 only, UASTC LDR/HDR 4x4, ASTC HDR 6x6 and ASTC LDR formats, single 2D image, no mipmaps or resampling)\n"
+" -low_memory: Free intermediate buffers as soon as they're no longer needed and reuse one scratch texture for all slices\n"
+"  (same output, lower peak memory)\n"
+" -trace filename.json: Write a per-stage/per-thread profile of the compression to a Chrome trace event JSON file\n"
+"  (open it in Perfetto or chrome://tracing)\n"
 "\n"
 " -output_file filename: Output .basis/.KTX2 filename\n"
 "\n"
@@ -301,8 +324,8 @@
 "  cubemap=array of faces. For 2darray/3d/cubemaps/video, each source image's\n"
 "  dimensions and # of mipmap levels must be the same. For video, the .basis\n"
 "  file will be written with the first frame being an I-Frame, and subsequent\n"
-"  frames being P-Frames (using conditional replenishment). Playback must always\n"
-"  occur in order from first to last image.\n"
+"  frames being P-Frames (using conditional replenishment). Playback must occur\n"
+"  in order from an I-Frame onwards (see -iframe_interval).\n"
 "\n"
 " -cubemap: same as -tex_type cubemap\n"
 "\n"
@@ -666,7 +689,9 @@
 " -resample_factor X: Resample all input textures by scale factor X using a box\n"
 "  filter\n"
 "\n"
-" -no_sse: Forbid all SSE instruction set usage\n"
+" -no_sse: Forbid all SSE instruction set usage (including AVX2)\n"
+"\n"
+" -no_avx2: Forbid AVX2 usage, use the SSE 4.1 kernels instead\n"
 "\n"
 " -validate_etc1s: Validate internal ETC1S compressor's data structures during\n"
 "  compression (slower, intended for development).\n"
@@ -682,6 +707,12 @@
 "\n"
 " -framerate X: Set framerate in .basis header to X/frames sec.\n"
 "\n"
+" -iframe_interval X: ETC1S video: emit an I-Frame every X frames (default is\n"
+"  0, only the first frame is an I-Frame). Each I-Frame starts an independent\n"
+"  group of frames, which can be seeked to and transcoded in parallel, at the\n"
+"  cost of a higher bitrate. Encoding time is mostly unaffected: the codebooks\n"
+"  are still built over all frames at once.\n"
+"\n"
 " -ktx2_no_zstandard: Don't compress UASTC texture data using Zstandard -- store\n"
 "  it uncompressed instead.\n"
 "\n"
@@ -751,6 +782,13 @@
 " -no_fast_xuastc_ldr_bc7_transcoding: Disable much faster, but slightly lower\n"
 "  quality, XUASTC LDR 4x4/6x6/8x6 direct BC7 transcoders\n"
 "\n"
+" -stream_zstd_transcoding: Stream decompress Zstd supercompressed KTX2 levels\n"
+"  one layer/face at a time, instead of decompressing each entire level first\n"
+"\n"
+" -mmap: Memory map input files for -info, -unpack and -validate instead of\n"
+"  reading them into memory. KTX2/.basis data is transcoded straight from the\n"
+"  mapping, so -info only pages in the header/index/DFD/KVD bytes\n"
+"\n"
 "--- Low-Level ETC1S backend endpoint/selector RDO codec options:\n"
 "\n"
 " -no_selector_rdo: Disable backend's selector rate distortion optimizations\n"
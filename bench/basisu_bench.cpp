@@ -0,0 +1,1487 @@
+// File: basisu_bench.cpp
+// Transcoder benchmark. Encodes a test image to every basis_tex_format the encoder supports (at each format's lowest effort level, since
+// only transcoding is timed), then times transcoding level 0 to every transcoder_texture_format the transcoder supports for that source,
+// at several resolutions and thread counts. Results are printed and can be written as JSON and/or CSV, so transcoder performance can be
+// tracked across versions on the same machine.
+//
+// Notes:
+// - Multithreaded transcodes use ktx2_transcoder::transcode_image_level_mt() with its built-in workers. Source formats which can't be split
+//   into bands (ETC1S, XUASTC LDR, XUBC7, UASTC HDR 6x6i) are transcoded on one thread regardless, so their numbers shouldn't scale.
+// - UASTC LDR/HDR 4x4 files are written without Zstd supercompression, so the timings are of the transcoder alone.
+// - Each timing includes everything transcode_image_level_mt() does for one call, but not init()/start_transcoding().
+// - -tsvq benchmarks ETC1S codebook generation (tree_vector_quant) instead, see bench_tsvq().
+// - -transcode_mt, -etc1s_huffman, -etc1s_sse, -bc7e and -transcode_cache benchmark a single component on the -file inputs instead, 
+//   and verify its output against the reference path.
+#include "../encoder/basisu_comp.h"
+#include "../encoder/basisu_bc7e_scalar.h"
+#include "../encoder/basisu_transcode_cache.h"
+#include "../transcoder/basisu_transcoder.h"
+#include "../transcoder/basisu_transcoder_internal.h"
+
+#include <algorithm>
+
+using namespace basisu;
+
+enum bench_mode
+{
+	cBenchModeTranscode,
+	cBenchModeTSVQ,
+	cBenchModeTranscodeMT,
+	cBenchModeETC1SHuffman,
+	cBenchModeETC1SSSE,
+	cBenchModeBC7E,
+	cBenchModeTranscodeCache
+};
+
+struct bench_options
+{
+	std::string m_ldr_filename = "../test_files/kodim01.png";
+	std::string m_hdr_filename = "../test_files/memorial.exr";
+
+	basisu::vector<uint32_t> m_resolutions;
+	basisu::vector<uint32_t> m_thread_counts;
+
+	uint32_t m_warmup_iters = 2;
+	uint32_t m_min_iters = 5;
+	uint32_t m_max_iters = 25;
+	double m_max_secs_per_case = .5f;
+
+	std::string m_src_filter, m_dst_filter;
+
+	std::string m_json_filename, m_csv_filename;
+
+	bench_mode m_mode = cBenchModeTranscode;
+
+	// Inputs of the single component modes (-file), .KTX2 files or for -bc7e images.
+	basisu::vector<std::string> m_input_filenames;
+
+	// -transcode_cache: the target format to use instead of BC7 and ASTC 4x4 (-1=both), and the cache file (it's cleared first).
+	int m_format_only = -1;
+	std::string m_transcode_cache_file = "basisu_transcode_cache.bin";
+
+	// -bc7e: perceptual error metrics (-linear disables).
+	bool m_perceptual = true;
+};
+
+struct bench_result
+{
+	basist::basis_tex_format m_src_fmt;
+	basist::transcoder_texture_format m_dst_fmt;
+	uint32_t m_width, m_height;
+	uint32_t m_threads;
+
+	uint32_t m_iters;
+	double m_median_secs, m_p99_secs;
+
+	uint64_t m_file_bytes, m_output_bytes;
+
+	double get_mpix_per_sec(double secs) const { return ((double)m_width * m_height) / (secs * 1000000.0f); }
+};
+
+static void print_usage()
+{
+	printf("Usage: basisu_bench [options]\n"
+		"Times transcoding of every supported source format (basis_tex_format) to every supported target format (transcoder_texture_format).\n"
+		"Options:\n"
+		" -ldr_file filename: LDR source image (default ../test_files/kodim01.png)\n"
+		" -hdr_file filename: HDR source image for the HDR formats (default ../test_files/memorial.exr)\n"
+		" -res X,Y,...: Square resolutions to resample the source images to (default 256,1024,2048)\n"
+		" -threads X,Y,...: Transcoder thread counts (default 1 and the number of hardware threads)\n"
+		" -warmup X: Untimed transcodes before timing each case (default 2)\n"
+		" -iters X: Maximum timed transcodes per case (default 25). At least 5 are always done, more until .5 secs have been spent.\n"
+		" -src substring: Only benchmark source formats whose name contains substring (case insensitive, e.g. \"XUASTC\")\n"
+		" -dst substring: Only benchmark target formats whose name contains substring (case insensitive, e.g. \"BC7\")\n"
+		" -json filename: Write the results to a JSON file\n"
+		" -csv filename: Write the results to a CSV file\n"
+		" -quick: Equivalent to -res 256 -iters 5 -warmup 1\n"
+		" -tsvq: Instead of transcoding, time ETC1S codebook generation (tree_vector_quant) at 1k/4k/16k clusters with the scalar,\n"
+		"  SSE 4.1 and AVX2 split code, and check they all produce the same codebooks\n"
+		"\n"
+		"Single component benchmarks, on the files given with -file:\n"
+		" -file filename: Input file for the modes below (may be repeated)\n"
+		" -transcode_mt: Time multithreaded KTX2 transcoding (transcode_image_level_mt) of each .KTX2 file's largest mipmap level\n"
+		"  using 1-32 threads, and verify the output matches serial transcoding\n"
+		" -etc1s_huffman: Time ETC1S Huffman symbol decoding (MSyms/sec on synthetic streams), and ETC1S->BC1/BC7/ASTC transcoding\n"
+		"  of each ETC1S .KTX2 file's largest mipmap level\n"
+		" -etc1s_sse: Compare the scalar and SSE 4.1 ETC1S block converters (MPix/sec) transcoding each ETC1S .KTX2 file's largest\n"
+		"  mipmap level to BC1-5/BC7/ETC2/EAC R11/ASTC/ATC/PVRTC2, and verify the outputs are identical\n"
+		" -bc7e: Time the bc7e_scalar BC7 encoder at each level (0-6) on each image (default is the -ldr_file image) with its\n"
+		"  scalar, SSE 4.1 and AVX2 code paths, verify the outputs are identical, and print each level's RGB(A) PSNR\n"
+		" -linear: Use linear (non-perceptual) error metrics in -bc7e\n"
+		" -transcode_cache: Transcode every image in the .KTX2 files to BC7 and ASTC 4x4 (or -format_only X) without the\n"
+		"  persistent transcode cache, through an empty cache, then through the cache reopened from disk, and verify the outputs match\n"
+		" -format_only X: transcoder_texture_format index used by -transcode_cache\n"
+		" -transcode_cache_file filename: Cache file used by -transcode_cache (it's cleared first), default is basisu_transcode_cache.bin\n");
+}
+
+static bool parse_uint_list(const char* pStr, basisu::vector<uint32_t>& vals)
+{
+	vals.resize(0);
+
+	std::string s(pStr);
+	size_t cur = 0;
+	while (cur < s.size())
+	{
+		size_t next = s.find(',', cur);
+		if (next == std::string::npos)
+			next = s.size();
+
+		const int v = atoi(s.substr(cur, next - cur).c_str());
+		if (v <= 0)
+			return false;
+
+		vals.push_back(v);
+		cur = next + 1;
+	}
+
+	return vals.size() > 0;
+}
+
+static bool name_matches_filter(const char* pName, const std::string& filter)
+{
+	if (filter.empty())
+		return true;
+
+	return string_tolower(pName).find(string_tolower(filter)) != std::string::npos;
+}
+
+static bool is_hdr_tex_format(basist::basis_tex_format fmt)
+{
+	return (fmt == basist::basis_tex_format::cUASTC_HDR_4x4) || (fmt == basist::basis_tex_format::cASTC_HDR_6x6) || (fmt == basist::basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE);
+}
+
+static bool encode_source(basist::basis_tex_format fmt, const image& ldr_img, const imagef& hdr_img, job_pool& jp, uint8_vec& ktx2_data)
+{
+	basis_compressor_params params;
+
+	// Lowest effort: only the transcoder is being benchmarked.
+	if (!params.set_format_mode_and_quality_effort(fmt, -1, 0))
+		return false;
+
+	// With quality -1 the ETC1S codebook sizes come from m_etc1s_max_endpoint/selector_clusters, which aren't set here, so use a mid quality level.
+	if (fmt == basist::basis_tex_format::cETC1S)
+		params.m_quality_level = 128;
+
+	if (is_hdr_tex_format(fmt))
+		params.m_source_images_hdr.push_back(hdr_img);
+	else
+		params.m_source_images.push_back(ldr_img);
+
+	params.m_create_ktx2_file = true;
+	params.m_ktx2_uastc_supercompression = basist::KTX2_SS_NONE;
+	params.m_write_output_basis_or_ktx2_files = false;
+	params.m_status_output = false;
+	params.m_compute_stats = false;
+	params.m_validate_output_data = false;
+	params.m_mip_gen = false;
+	params.m_pJob_pool = &jp;
+	params.m_multithreading = jp.get_total_threads() > 1;
+
+	basis_compressor comp;
+	if (!comp.init(params))
+		return false;
+
+	if (comp.process() != basis_compressor::cECSuccess)
+		return false;
+
+	comp.take_output_ktx2_file(ktx2_data);
+	return ktx2_data.size() > 0;
+}
+
+static bool bench_transcode(const uint8_vec& ktx2_data, basist::transcoder_texture_format dst_fmt, uint32_t num_threads, const bench_options& opts, bench_result& res)
+{
+	basist::ktx2_transcoder dec;
+	if (!dec.init(ktx2_data.data(), ktx2_data.size_u32()))
+		return false;
+
+	if (!dec.start_transcoding())
+		return false;
+
+	const uint32_t width = dec.get_width(), height = dec.get_height();
+
+	const uint32_t output_bytes = basist::basis_compute_transcoded_image_size_in_bytes(dst_fmt, width, height);
+	const uint32_t output_size_in_blocks_or_pixels = output_bytes / basist::basis_get_bytes_per_block_or_pixel(dst_fmt);
+
+	uint8_vec output_buf(output_bytes);
+
+	basist::basisu_transcoder_parallel_params mt_params;
+	mt_params.m_max_threads = num_threads;
+
+	basist::ktx2_transcoder_state state;
+
+	basisu::vector<double> times;
+	double total_secs = 0.0f;
+
+	for (uint32_t iter = 0; ; iter++)
+	{
+		const bool is_warmup = iter < opts.m_warmup_iters;
+		if (!is_warmup)
+		{
+			const uint32_t num_timed = times.size_u32();
+			if (num_timed >= opts.m_max_iters)
+				break;
+			if ((num_timed >= opts.m_min_iters) && (total_secs >= opts.m_max_secs_per_case))
+				break;
+		}
+
+		const timer_ticks start_ticks = interval_timer::get_ticks();
+
+		if (!dec.transcode_image_level_mt(0, 0, 0, output_buf.data(), output_size_in_blocks_or_pixels, dst_fmt, mt_params, 0, 0, 0, -1, -1, &state))
+			return false;
+
+		const double secs = interval_timer::ticks_to_secs(interval_timer::get_ticks() - start_ticks);
+
+		if (!is_warmup)
+		{
+			times.push_back(secs);
+			total_secs += secs;
+		}
+	}
+
+	std::sort(times.begin(), times.end());
+
+	res.m_width = width;
+	res.m_height = height;
+	res.m_threads = num_threads;
+	res.m_iters = times.size_u32();
+	res.m_median_secs = (times.size() & 1) ? times[times.size() / 2] : ((times[times.size() / 2 - 1] + times[times.size() / 2]) * .5f);
+
+	// Nearest rank
+	const size_t p99_rank = (size_t)ceil(.99f * (double)times.size());
+	res.m_p99_secs = times[clamp<size_t>(p99_rank, 1, times.size()) - 1];
+
+	res.m_file_bytes = ktx2_data.size();
+	res.m_output_bytes = output_bytes;
+
+	// Make sure the secs are never 0, so the rates are always finite.
+	res.m_median_secs = maximum(res.m_median_secs, 1e-9);
+	res.m_p99_secs = maximum(res.m_p99_secs, 1e-9);
+
+	return true;
+}
+
+static std::string json_escape(const std::string& s)
+{
+	std::string res;
+	for (char c : s)
+	{
+		if ((c == '\\') || (c == '"'))
+			res.push_back('\\');
+		res.push_back(c);
+	}
+	return res;
+}
+
+static bool write_json(const char* pFilename, const bench_options& opts, const basisu::vector<bench_result>& results)
+{
+	FILE* pFile = fopen_safe(pFilename, "w");
+	if (!pFile)
+	{
+		error_printf("Failed creating JSON file \"%s\"\n", pFilename);
+		return false;
+	}
+
+	fprintf(pFile, "{\n");
+	fprintf(pFile, "  \"lib_version\": \"%s\",\n", BASISU_LIB_VERSION_STRING);
+	fprintf(pFile, "  \"hardware_threads\": %i,\n", get_num_hardware_threads());
+	fprintf(pFile, "  \"ldr_file\": \"%s\",\n", json_escape(opts.m_ldr_filename).c_str());
+	fprintf(pFile, "  \"hdr_file\": \"%s\",\n", json_escape(opts.m_hdr_filename).c_str());
+	fprintf(pFile, "  \"results\": [\n");
+
+	for (uint32_t i = 0; i < results.size(); i++)
+	{
+		const bench_result& r = results[i];
+
+		fprintf(pFile, "    { \"src\": \"%s\", \"dst\": \"%s\", \"width\": %u, \"height\": %u, \"threads\": %u, \"iters\": %u, "
+			"\"median_ms\": %.4f, \"p99_ms\": %.4f, \"median_mpix_per_sec\": %.3f, \"p99_mpix_per_sec\": %.3f, "
+			"\"file_bytes\": %llu, \"output_bytes\": %llu, \"median_output_bytes_per_sec\": %.0f, \"p99_output_bytes_per_sec\": %.0f }%s\n",
+			basist::basis_get_tex_format_name(r.m_src_fmt), basist::basis_get_format_name(r.m_dst_fmt),
+			r.m_width, r.m_height, r.m_threads, r.m_iters,
+			r.m_median_secs * 1000.0f, r.m_p99_secs * 1000.0f, r.get_mpix_per_sec(r.m_median_secs), r.get_mpix_per_sec(r.m_p99_secs),
+			(unsigned long long)r.m_file_bytes, (unsigned long long)r.m_output_bytes, (double)r.m_output_bytes / r.m_median_secs, (double)r.m_output_bytes / r.m_p99_secs,
+			((i + 1) < results.size()) ? "," : "");
+	}
+
+	fprintf(pFile, "  ]\n}\n");
+
+	if (fclose(pFile) == EOF)
+	{
+		error_printf("Failed writing JSON file \"%s\"\n", pFilename);
+		return false;
+	}
+
+	return true;
+}
+
+static bool write_csv(const char* pFilename, const basisu::vector<bench_result>& results)
+{
+	FILE* pFile = fopen_safe(pFilename, "w");
+	if (!pFile)
+	{
+		error_printf("Failed creating CSV file \"%s\"\n", pFilename);
+		return false;
+	}
+
+	fprintf(pFile, "src,dst,width,height,threads,iters,median_ms,p99_ms,median_mpix_per_sec,p99_mpix_per_sec,file_bytes,output_bytes,median_output_bytes_per_sec,p99_output_bytes_per_sec\n");
+
+	for (uint32_t i = 0; i < results.size(); i++)
+	{
+		const bench_result& r = results[i];
+
+		fprintf(pFile, "%s,%s,%u,%u,%u,%u,%.4f,%.4f,%.3f,%.3f,%llu,%llu,%.0f,%.0f\n",
+			basist::basis_get_tex_format_name(r.m_src_fmt), basist::basis_get_format_name(r.m_dst_fmt),
+			r.m_width, r.m_height, r.m_threads, r.m_iters,
+			r.m_median_secs * 1000.0f, r.m_p99_secs * 1000.0f, r.get_mpix_per_sec(r.m_median_secs), r.get_mpix_per_sec(r.m_p99_secs),
+			(unsigned long long)r.m_file_bytes, (unsigned long long)r.m_output_bytes, (double)r.m_output_bytes / r.m_median_secs, (double)r.m_output_bytes / r.m_p99_secs);
+	}
+
+	if (fclose(pFile) == EOF)
+	{
+		error_printf("Failed writing CSV file \"%s\"\n", pFilename);
+		return false;
+	}
+
+	return true;
+}
+
+// Training vectors like the ETC1S frontend's, from the source image's 4x4 blocks: vec16F = each texel's luma, normalized to [0,1] within
+// the block (roughly what a block's selectors are), vec6F = the block's average color and color range. Weighted by the block's luma range.
+static void get_tsvq_training_vecs(const image& img, basisu::vector< std::pair<vec16F, uint64_t> >& vecs16, basisu::vector< std::pair<vec6F, uint64_t> >& vecs6)
+{
+	for (uint32_t by = 0; by < img.get_height() / 4; by++)
+	{
+		for (uint32_t bx = 0; bx < img.get_width() / 4; bx++)
+		{
+			color_rgba pixels[16];
+			img.extract_block_clamped(pixels, bx * 4, by * 4, 4, 4);
+
+			float lumas[16];
+			float lo_luma = 1e+9f, hi_luma = -1e+9f;
+			color_rgba lo(255, 255, 255, 255), hi(0, 0, 0, 0);
+			vec3F avg(0.0f);
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				lumas[i] = (float)pixels[i].get_709_luma();
+				lo_luma = minimum(lo_luma, lumas[i]);
+				hi_luma = maximum(hi_luma, lumas[i]);
+
+				for (uint32_t c = 0; c < 3; c++)
+				{
+					lo[c] = minimum(lo[c], pixels[i][c]);
+					hi[c] = maximum(hi[c], pixels[i][c]);
+					avg[c] += pixels[i][c] * (1.0f / 16.0f);
+				}
+			}
+
+			const float luma_range = hi_luma - lo_luma;
+			const uint64_t weight = 1 + (uint64_t)luma_range;
+
+			vec16F v16;
+			for (uint32_t i = 0; i < 16; i++)
+				v16[i] = (luma_range > 0.0f) ? ((lumas[i] - lo_luma) / luma_range) : 0.0f;
+			vecs16.push_back(std::make_pair(v16, weight));
+
+			vec6F v6;
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				v6[c] = avg[c] * (1.0f / 255.0f);
+				v6[3 + c] = (hi[c] - lo[c]) * (1.0f / 255.0f);
+			}
+			vecs6.push_back(std::make_pair(v6, weight));
+		}
+	}
+}
+
+// Times single threaded tree_vector_quant::generate() with the given training vectors, returning the fastest of iters runs and the codebook.
+template<typename VectorType>
+static double time_tsvq(const basisu::vector< std::pair<VectorType, uint64_t> >& vecs, uint32_t num_clusters, uint32_t iters, basisu::vector<uint_vec>& codebook)
+{
+	double best_secs = 1e+9f;
+
+	for (uint32_t iter = 0; iter < iters; iter++)
+	{
+		tree_vector_quant<VectorType> q;
+		for (uint32_t i = 0; i < vecs.size(); i++)
+			q.add_training_vec(vecs[i].first, vecs[i].second);
+
+		interval_timer tm;
+		tm.start();
+
+		q.generate(num_clusters);
+
+		best_secs = minimum(best_secs, tm.get_elapsed_secs());
+
+		codebook.resize(0);
+		q.retrieve(codebook);
+	}
+
+	return best_secs;
+}
+
+// Benchmarks tree_vector_quant, the TSVQ clusterizer behind the ETC1S endpoint (vec6F) and selector (vec16F) codebooks, with each split 
+// code path the CPU supports. The SIMD paths must produce exactly the same codebooks as the scalar path, otherwise this fails.
+template<typename VectorType>
+static bool bench_tsvq(const char* pName, const basisu::vector< std::pair<VectorType, uint64_t> >& vecs, uint32_t iters)
+{
+	const bool orig_sse41 = g_cpu_supports_sse41, orig_avx2 = g_cpu_supports_avx2;
+
+	const uint32_t cluster_counts[] = { 1024, 4096, 16384 };
+
+	bool success = true;
+
+	for (uint32_t c = 0; c < std::size(cluster_counts); c++)
+	{
+		const uint32_t num_clusters = minimum<uint32_t>(cluster_counts[c], vecs.size_u32());
+
+		basisu::vector<uint_vec> scalar_codebook;
+
+		g_cpu_supports_sse41 = false;
+		g_cpu_supports_avx2 = false;
+		const double scalar_secs = time_tsvq(vecs, num_clusters, iters, scalar_codebook);
+
+		printf("%-8s %8u %8u %-8s %10.2f\n", pName, vecs.size_u32(), num_clusters, "scalar", scalar_secs * 1000.0f);
+
+		for (uint32_t isa = 0; isa < 2; isa++)
+		{
+			if (!(isa ? orig_avx2 : orig_sse41))
+				continue;
+
+			g_cpu_supports_sse41 = true;
+			g_cpu_supports_avx2 = (isa == 1);
+
+			basisu::vector<uint_vec> codebook;
+			const double secs = time_tsvq(vecs, num_clusters, iters, codebook);
+
+			const bool matches = (codebook == scalar_codebook);
+			if (!matches)
+				success = false;
+
+			printf("%-8s %8u %8u %-8s %10.2f %6.2fx%s\n", pName, vecs.size_u32(), num_clusters, isa ? "AVX2" : "SSE4.1", secs * 1000.0f, scalar_secs / secs,
+				matches ? "" : " CODEBOOK MISMATCH");
+		}
+
+		fflush(stdout);
+	}
+
+	g_cpu_supports_sse41 = orig_sse41;
+	g_cpu_supports_avx2 = orig_avx2;
+
+	return success;
+}
+
+// Adapts basisu::job_pool to the transcoder's basisu_transcoder_parallel_for_func interface.
+static void job_pool_parallel_for(uint32_t num_jobs, basist::basisu_transcoder_job_func pJob_func, void* pJob_data, void* pUser_data)
+{
+	job_pool* pPool = static_cast<job_pool*>(pUser_data);
+
+	for (uint32_t i = 0; i < num_jobs; i++)
+		pPool->add_job([pJob_func, pJob_data, i] { pJob_func(i, pJob_data); });
+
+	pPool->wait_for_all();
+}
+
+// -transcode_mt: Times ktx2_transcoder::transcode_image_level_mt() on the largest mipmap level of each input KTX2 file, using 1-32 threads,
+// and verifies the output is identical to the serial transcode_image_level() output.
+static bool bench_transcode_mt(const bench_options& opts)
+{
+	if (!opts.m_input_filenames.size())
+	{
+		error_printf("-transcode_mt: No input .KTX2 files specified (see -file)\n");
+		return false;
+	}
+
+	static const uint32_t s_thread_counts[] = { 1, 2, 4, 8, 16, 32 };
+
+	static const basist::transcoder_texture_format s_ldr_fmts[] = 
+	{ 
+		basist::transcoder_texture_format::cTFBC1_RGB, basist::transcoder_texture_format::cTFBC7_RGBA, basist::transcoder_texture_format::cTFETC2_RGBA, 
+		basist::transcoder_texture_format::cTFASTC_LDR_4x4_RGBA, basist::transcoder_texture_format::cTFRGBA32 
+	};
+
+	static const basist::transcoder_texture_format s_hdr_fmts[] = 
+	{ 
+		basist::transcoder_texture_format::cTFBC6H, basist::transcoder_texture_format::cTFRGBA_HALF 
+	};
+
+	bool all_identical = true;
+
+	for (size_t file_index = 0; file_index < opts.m_input_filenames.size(); file_index++)
+	{
+		const char* pInput_filename = opts.m_input_filenames[file_index].c_str();
+
+		uint8_vec file_data;
+		if (!read_file_to_vec(pInput_filename, file_data))
+		{
+			error_printf("Failed reading file \"%s\"\n", pInput_filename);
+			return false;
+		}
+
+		basist::ktx2_transcoder dec;
+		if ((!dec.init(file_data.data(), (uint32_t)file_data.size())) || (!dec.start_transcoding()))
+		{
+			error_printf("Failed initializing KTX2 transcoder on file \"%s\"\n", pInput_filename);
+			return false;
+		}
+
+		basist::ktx2_image_level_info level_info;
+		if (!dec.get_image_level_info(level_info, 0, 0, 0))
+			return false;
+
+		printf("File: %s, format: %s, %ux%u\n", pInput_filename, basist::basis_get_tex_format_name(dec.get_basis_tex_format()), level_info.m_orig_width, level_info.m_orig_height);
+
+		const basist::transcoder_texture_format* pFmts = dec.is_hdr() ? s_hdr_fmts : s_ldr_fmts;
+		const uint32_t num_fmts = dec.is_hdr() ? (uint32_t)std::size(s_hdr_fmts) : (uint32_t)std::size(s_ldr_fmts);
+
+		const double total_mpix = (double)level_info.m_orig_width * level_info.m_orig_height / 1000000.0;
+
+		for (uint32_t fmt_index = 0; fmt_index < num_fmts; fmt_index++)
+		{
+			const basist::transcoder_texture_format tex_fmt = pFmts[fmt_index];
+			if (!basist::basis_is_format_supported(tex_fmt, dec.get_basis_tex_format()))
+				continue;
+
+			if ((basist::basis_is_transcoder_texture_format_astc(tex_fmt)) &&
+				((basist::basis_get_block_width(tex_fmt) != dec.get_block_width()) || (basist::basis_get_block_height(tex_fmt) != dec.get_block_height())))
+				continue;
+
+			const uint32_t bytes_per_block_or_pixel = basist::basis_get_bytes_per_block_or_pixel(tex_fmt);
+			const uint32_t output_size = basist::basis_compute_transcoded_image_size_in_bytes(tex_fmt, level_info.m_orig_width, level_info.m_orig_height);
+			const uint32_t output_size_in_blocks_or_pixels = output_size / bytes_per_block_or_pixel;
+
+			// Keeps the decompressed Zstd level data around, so it isn't included in the timings.
+			basist::ktx2_transcoder_state state;
+			state.clear();
+
+			uint8_vec ref_output(output_size), output(output_size);
+			if (!dec.transcode_image_level(0, 0, 0, ref_output.data(), output_size_in_blocks_or_pixels, tex_fmt, 0, 0, 0, -1, -1, &state))
+			{
+				error_printf("transcode_image_level() failed\n");
+				return false;
+			}
+
+			double base_time = 0.0f;
+
+			for (uint32_t thread_index = 0; thread_index < std::size(s_thread_counts); thread_index++)
+			{
+				const uint32_t num_threads = s_thread_counts[thread_index];
+
+				job_pool jpool(num_threads);
+
+				basist::basisu_transcoder_parallel_params mt_params;
+				mt_params.m_max_threads = num_threads;
+				mt_params.m_pParallel_for = job_pool_parallel_for;
+				mt_params.m_pParallel_for_data = &jpool;
+
+				// Warm up, and verify the output is identical to the serial path.
+				memset(output.data(), 0, output.size());
+				if (!dec.transcode_image_level_mt(0, 0, 0, output.data(), output_size_in_blocks_or_pixels, tex_fmt, mt_params, 0, 0, 0, -1, -1, &state))
+				{
+					error_printf("transcode_image_level_mt() failed\n");
+					return false;
+				}
+
+				const bool identical = (output == ref_output);
+				if (!identical)
+					all_identical = false;
+
+				interval_timer tm;
+				tm.start();
+
+				uint32_t num_iters = 0;
+				do
+				{
+					dec.transcode_image_level_mt(0, 0, 0, output.data(), output_size_in_blocks_or_pixels, tex_fmt, mt_params, 0, 0, 0, -1, -1, &state);
+					num_iters++;
+				} while ((num_iters < 3) || (tm.get_elapsed_secs() < .25f));
+
+				const double avg_time = tm.get_elapsed_secs() / num_iters;
+				if (!thread_index)
+					base_time = avg_time;
+
+				printf("%-20s %2u threads: %8.3f ms, %9.2f MPix/sec, %5.2fX speedup, %s\n",
+					basist::basis_get_format_name(tex_fmt), num_threads, avg_time * 1000.0f, total_mpix / avg_time, base_time / avg_time,
+					identical ? "identical" : "MISMATCH");
+			}
+		}
+	}
+
+	if (!all_identical)
+	{
+		error_printf("Multithreaded transcoding output differed from serial transcoding!\n");
+		return false;
+	}
+
+	return true;
+}
+
+// -etc1s_huffman: Measures basist::bitwise_decoder::decode_huffman() symbols/sec on synthetic streams shaped like the ETC1S slice streams,
+// then the end to end ETC1S->BC1/BC7/ASTC transcode throughput of the largest mipmap level of each input ETC1S KTX2 file.
+static bool bench_etc1s_huffman(const bench_options& opts)
+{
+	struct synthetic_stream_desc
+	{
+		const char* m_pName;
+		uint32_t m_num_syms;
+		float m_mean; // mean of the exponential distribution the symbols are drawn from
+		bool m_interleaved; // alternate between two tables, like the endpoint/selector streams
+	};
+
+	static const synthetic_stream_desc s_streams[] =
+	{
+		{ "RLE-like, 16 syms", 16, 1.5f, false },
+		{ "selector-like, 512 syms", 512, 12.0f, false },
+		{ "endpoint delta-like, 2048 syms", 2048, 200.0f, false },
+		{ "interleaved 16/512 syms", 512, 12.0f, true }
+	};
+
+	const uint32_t total_syms = 4 * 1024 * 1024;
+
+	for (uint32_t stream_index = 0; stream_index < std::size(s_streams); stream_index++)
+	{
+		const synthetic_stream_desc& desc = s_streams[stream_index];
+
+		basisu::rand rnd(stream_index + 1);
+
+		uint_vec syms(total_syms);
+		histogram hists[2] = { histogram(desc.m_num_syms), histogram(16) };
+
+		for (uint32_t i = 0; i < total_syms; i++)
+		{
+			const uint32_t table_index = (desc.m_interleaved && (i & 1)) ? 1 : 0;
+			const float mean = table_index ? 1.5f : desc.m_mean;
+			const uint32_t num_syms = table_index ? 16 : desc.m_num_syms;
+
+			const uint32_t s = minimum<uint32_t>((uint32_t)(-logf(1.0f - rnd.frand(0.0f, .999999f)) * mean), num_syms - 1);
+			syms[i] = s;
+			hists[table_index][s]++;
+		}
+
+		huffman_encoding_table enc_tables[2];
+		bitwise_coder coder;
+		coder.init(total_syms * 2);
+
+		for (uint32_t t = 0; t < (desc.m_interleaved ? 2U : 1U); t++)
+		{
+			if (!enc_tables[t].init(hists[t], 16))
+			{
+				error_printf("huffman_encoding_table::init() failed\n");
+				return false;
+			}
+			coder.emit_huffman_table(enc_tables[t]);
+		}
+
+		for (uint32_t i = 0; i < total_syms; i++)
+			coder.put_code(syms[i], enc_tables[(desc.m_interleaved && (i & 1)) ? 1 : 0]);
+
+		coder.flush();
+
+		basist::bitwise_decoder dec;
+		basist::huffman_decoding_table dec_tables[2];
+
+		dec.init(coder.get_bytes().data(), coder.get_bytes().size_u32());
+		for (uint32_t t = 0; t < (desc.m_interleaved ? 2U : 1U); t++)
+		{
+			if (!dec.read_huffman_table(dec_tables[t]))
+			{
+				error_printf("read_huffman_table() failed\n");
+				return false;
+			}
+		}
+
+		const basist::bitwise_decoder start_dec(dec);
+
+		// Verify
+		bool valid = true;
+		for (uint32_t i = 0; i < total_syms; i++)
+		{
+			if (dec.decode_huffman(dec_tables[(desc.m_interleaved && (i & 1)) ? 1 : 0]) != syms[i])
+			{
+				valid = false;
+				break;
+			}
+		}
+
+		if (!valid)
+		{
+			error_printf("Huffman decoding mismatch on stream \"%s\"\n", desc.m_pName);
+			return false;
+		}
+
+		double best_time = 1e+9f;
+		uint32_t sum = 0;
+
+		for (uint32_t iter = 0; iter < 5; iter++)
+		{
+			dec = start_dec;
+
+			interval_timer tm;
+			tm.start();
+
+			if (desc.m_interleaved)
+			{
+				for (uint32_t i = 0; i < total_syms; i += 2)
+				{
+					sum += dec.decode_huffman(dec_tables[0]);
+					sum += dec.decode_huffman(dec_tables[1]);
+				}
+			}
+			else
+			{
+				for (uint32_t i = 0; i < total_syms; i++)
+					sum += dec.decode_huffman(dec_tables[0]);
+			}
+
+			best_time = minimum<double>(best_time, tm.get_elapsed_secs());
+		}
+
+		printf("%-32s %6.2f bits/sym, %8.2f MSyms/sec (%u)\n", desc.m_pName, (double)coder.get_total_bits() / total_syms, total_syms / best_time / 1000000.0f, sum & 1);
+	}
+
+	static const basist::transcoder_texture_format s_fmts[] =
+	{
+		basist::transcoder_texture_format::cTFBC1_RGB, basist::transcoder_texture_format::cTFBC7_RGBA, basist::transcoder_texture_format::cTFASTC_LDR_4x4_RGBA
+	};
+
+	for (size_t file_index = 0; file_index < opts.m_input_filenames.size(); file_index++)
+	{
+		const char* pInput_filename = opts.m_input_filenames[file_index].c_str();
+
+		uint8_vec file_data;
+		if (!read_file_to_vec(pInput_filename, file_data))
+		{
+			error_printf("Failed reading file \"%s\"\n", pInput_filename);
+			return false;
+		}
+
+		basist::ktx2_transcoder dec;
+		if ((!dec.init(file_data.data(), (uint32_t)file_data.size())) || (!dec.start_transcoding()))
+		{
+			error_printf("Failed initializing KTX2 transcoder on file \"%s\"\n", pInput_filename);
+			return false;
+		}
+
+		if (!dec.is_etc1s())
+		{
+			printf("Skipping non-ETC1S file \"%s\"\n", pInput_filename);
+			continue;
+		}
+
+		basist::ktx2_image_level_info level_info;
+		if (!dec.get_image_level_info(level_info, 0, 0, 0))
+			return false;
+
+		printf("File: %s, %ux%u\n", pInput_filename, level_info.m_orig_width, level_info.m_orig_height);
+
+		const double total_mpix = (double)level_info.m_orig_width * level_info.m_orig_height / 1000000.0;
+
+		for (uint32_t fmt_index = 0; fmt_index < std::size(s_fmts); fmt_index++)
+		{
+			const basist::transcoder_texture_format tex_fmt = s_fmts[fmt_index];
+
+			const uint32_t bytes_per_block_or_pixel = basist::basis_get_bytes_per_block_or_pixel(tex_fmt);
+			const uint32_t output_size = basist::basis_compute_transcoded_image_size_in_bytes(tex_fmt, level_info.m_orig_width, level_info.m_orig_height);
+			const uint32_t output_size_in_blocks_or_pixels = output_size / bytes_per_block_or_pixel;
+
+			uint8_vec output(output_size);
+
+			double best_time = 1e+9f;
+			uint32_t num_iters = 0;
+
+			interval_timer total_tm;
+			total_tm.start();
+
+			do
+			{
+				interval_timer tm;
+				tm.start();
+
+				if (!dec.transcode_image_level(0, 0, 0, output.data(), output_size_in_blocks_or_pixels, tex_fmt))
+				{
+					error_printf("transcode_image_level() failed\n");
+					return false;
+				}
+
+				best_time = minimum<double>(best_time, tm.get_elapsed_secs());
+				num_iters++;
+			} while ((num_iters < 3) || (total_tm.get_elapsed_secs() < .5f));
+
+			printf("%-20s %8.3f ms, %9.2f MPix/sec\n", basist::basis_get_format_name(tex_fmt), best_time * 1000.0f, total_mpix / best_time);
+		}
+	}
+
+	return true;
+}
+
+// -etc1s_sse: Compares the scalar and SSE 4.1 ETC1S block converters, by transcoding the largest mipmap level of each input ETC1S KTX2 file 
+// to each LDR format both ways. Verifies the outputs are identical.
+static bool bench_etc1s_sse(const bench_options& opts)
+{
+	static const basist::transcoder_texture_format s_fmts[] =
+	{
+		basist::transcoder_texture_format::cTFBC1_RGB, basist::transcoder_texture_format::cTFBC3_RGBA, basist::transcoder_texture_format::cTFBC4_R,
+		basist::transcoder_texture_format::cTFBC5_RG, basist::transcoder_texture_format::cTFBC7_RGBA, basist::transcoder_texture_format::cTFETC2_RGBA,
+		basist::transcoder_texture_format::cTFETC2_EAC_R11, basist::transcoder_texture_format::cTFASTC_LDR_4x4_RGBA, basist::transcoder_texture_format::cTFATC_RGBA,
+		basist::transcoder_texture_format::cTFPVRTC2_4_RGBA
+	};
+
+	const bool sse41_supported = basist::basisu_transcoder_supports_sse41();
+	if (!sse41_supported)
+		printf("Transcoder SSE 4.1 support is unavailable (not compiled with BASISD_SUPPORT_SSE, or the CPU doesn't support SSE 4.1): only measuring the scalar code\n");
+
+	const bool orig_sse41_enabled = basist::basisu_transcoder_is_sse41_enabled();
+	bool status = true;
+
+	for (size_t file_index = 0; (file_index < opts.m_input_filenames.size()) && status; file_index++)
+	{
+		const char* pInput_filename = opts.m_input_filenames[file_index].c_str();
+
+		uint8_vec file_data;
+		if (!read_file_to_vec(pInput_filename, file_data))
+		{
+			error_printf("Failed reading file \"%s\"\n", pInput_filename);
+			status = false;
+			break;
+		}
+
+		basist::ktx2_transcoder dec;
+		if ((!dec.init(file_data.data(), (uint32_t)file_data.size())) || (!dec.start_transcoding()))
+		{
+			error_printf("Failed initializing KTX2 transcoder on file \"%s\"\n", pInput_filename);
+			status = false;
+			break;
+		}
+
+		if (!dec.is_etc1s())
+		{
+			printf("Skipping non-ETC1S file \"%s\"\n", pInput_filename);
+			continue;
+		}
+
+		basist::ktx2_image_level_info level_info;
+		if (!dec.get_image_level_info(level_info, 0, 0, 0))
+		{
+			status = false;
+			break;
+		}
+
+		printf("File: %s, %ux%u, alpha: %u\n", pInput_filename, level_info.m_orig_width, level_info.m_orig_height, dec.get_has_alpha());
+
+		const double total_mpix = (double)level_info.m_orig_width * level_info.m_orig_height / 1000000.0;
+
+		for (uint32_t fmt_index = 0; fmt_index < std::size(s_fmts); fmt_index++)
+		{
+			const basist::transcoder_texture_format tex_fmt = s_fmts[fmt_index];
+
+			const uint32_t bytes_per_block_or_pixel = basist::basis_get_bytes_per_block_or_pixel(tex_fmt);
+			const uint32_t output_size = basist::basis_compute_transcoded_image_size_in_bytes(tex_fmt, level_info.m_orig_width, level_info.m_orig_height);
+			const uint32_t output_size_in_blocks_or_pixels = output_size / bytes_per_block_or_pixel;
+
+			// [0]=scalar, [1]=SSE 4.1
+			uint8_vec outputs[2];
+			double best_times[2] = { 0.0f, 0.0f };
+
+			for (uint32_t pass = 0; pass < (sse41_supported ? 2U : 1U); pass++)
+			{
+				basist::basisu_transcoder_enable_sse41(pass == 1);
+
+				outputs[pass].resize(output_size);
+
+				double best_time = 1e+9f;
+				uint32_t num_iters = 0;
+
+				interval_timer total_tm;
+				total_tm.start();
+
+				do
+				{
+					interval_timer tm;
+					tm.start();
+
+					if (!dec.transcode_image_level(0, 0, 0, outputs[pass].data(), output_size_in_blocks_or_pixels, tex_fmt))
+					{
+						error_printf("transcode_image_level() failed\n");
+						status = false;
+						break;
+					}
+
+					best_time = minimum<double>(best_time, tm.get_elapsed_secs());
+					num_iters++;
+				} while ((num_iters < 3) || (total_tm.get_elapsed_secs() < .5f));
+
+				if (!status)
+					break;
+
+				best_times[pass] = best_time;
+			}
+
+			if (!status)
+				break;
+
+			if (!sse41_supported)
+			{
+				printf("%-20s scalar: %9.2f MPix/sec\n", basist::basis_get_format_name(tex_fmt), total_mpix / best_times[0]);
+				continue;
+			}
+
+			if (!(outputs[0] == outputs[1]))
+			{
+				error_printf("Scalar and SSE 4.1 outputs differ for format %s\n", basist::basis_get_format_name(tex_fmt));
+				status = false;
+				break;
+			}
+
+			printf("%-20s scalar: %9.2f MPix/sec, SSE 4.1: %9.2f MPix/sec, %1.3fX\n", basist::basis_get_format_name(tex_fmt), 
+				total_mpix / best_times[0], total_mpix / best_times[1], best_times[0] / best_times[1]);
+		}
+	}
+
+	basist::basisu_transcoder_enable_sse41(orig_sse41_enabled);
+
+	return status;
+}
+
+// -bc7e: Benchmarks the bc7e_scalar BC7 encoder at each of its levels (0=ultrafast .. 6=slowest) on each input image, 
+// with the scalar, SSE 4.1 and AVX2 code paths (the ones this build and CPU support). Verifies the outputs are identical, and 
+// prints the throughput and the RGB(A) PSNR of each level.
+static bool bench_bc7e(const bench_options& opts)
+{
+	typedef void (*bc7e_params_init_func)(bc7e_scalar::bc7e_compress_block_params*, bool);
+	static const struct
+	{
+		const char* m_pName;
+		bc7e_params_init_func m_pInit;
+	} s_levels[] =
+	{
+		{ "ultrafast", bc7e_scalar::bc7e_compress_block_params_init_ultrafast },
+		{ "veryfast", bc7e_scalar::bc7e_compress_block_params_init_veryfast },
+		{ "fast", bc7e_scalar::bc7e_compress_block_params_init_fast },
+		{ "basic", bc7e_scalar::bc7e_compress_block_params_init_basic },
+		{ "slow", bc7e_scalar::bc7e_compress_block_params_init_slow },
+		{ "veryslow", bc7e_scalar::bc7e_compress_block_params_init_veryslow },
+		{ "slowest", bc7e_scalar::bc7e_compress_block_params_init_slowest }
+	};
+
+	const uint32_t cNumPaths = 3;
+	static const char* s_path_names[cNumPaths] = { "scalar", "SSE 4.1", "AVX2" };
+
+	const bool orig_sse41 = g_cpu_supports_sse41, orig_avx2 = g_cpu_supports_avx2;
+	const bool path_supported[cNumPaths] = { true, orig_sse41, orig_avx2 };
+
+	if (!orig_sse41)
+		printf("SSE 4.1 support is unavailable (not compiled with BASISU_SUPPORT_SSE, disabled, or the CPU doesn't support SSE 4.1): only measuring the scalar code\n");
+
+	const bool perceptual = opts.m_perceptual;
+	printf("Perceptual: %u\n", perceptual);
+
+	bc7e_scalar::bc7e_compress_block_init();
+
+	bool status = true;
+
+	for (size_t file_index = 0; (file_index < opts.m_input_filenames.size()) && status; file_index++)
+	{
+		const char* pInput_filename = opts.m_input_filenames[file_index].c_str();
+
+		image img;
+		if (!load_image(pInput_filename, img))
+		{
+			error_printf("Failed loading image file \"%s\"\n", pInput_filename);
+			status = false;
+			break;
+		}
+
+		const uint32_t num_blocks_x = img.get_block_width(4), num_blocks_y = img.get_block_height(4);
+		const uint32_t total_blocks = num_blocks_x * num_blocks_y;
+		const bool has_alpha = img.has_alpha();
+
+		basisu::vector<color_rgba> block_pixels(total_blocks * 16);
+		for (uint32_t by = 0; by < num_blocks_y; by++)
+			for (uint32_t bx = 0; bx < num_blocks_x; bx++)
+				img.extract_block_clamped(&block_pixels[(bx + by * num_blocks_x) * 16], bx * 4, by * 4, 4, 4);
+
+		printf("File: %s, %ux%u, alpha: %u\n", pInput_filename, img.get_width(), img.get_height(), has_alpha);
+
+		const double total_mpix = (double)total_blocks * 16 / 1000000.0;
+
+		for (uint32_t level = 0; (level < std::size(s_levels)) && status; level++)
+		{
+			bc7e_scalar::bc7e_compress_block_params params;
+			s_levels[level].m_pInit(&params, perceptual);
+
+			basisu::vector<uint64_t> outputs[cNumPaths];
+			double times[cNumPaths] = { 0.0f, 0.0f, 0.0f };
+
+			for (uint32_t path = 0; path < cNumPaths; path++)
+			{
+				if (!path_supported[path])
+					continue;
+
+				g_cpu_supports_sse41 = (path >= 1);
+				g_cpu_supports_avx2 = (path == 2);
+
+				outputs[path].resize(total_blocks * 2);
+
+				interval_timer tm;
+				tm.start();
+
+				bc7e_scalar::bc7e_compress_blocks(total_blocks, outputs[path].data(), (const uint32_t*)block_pixels.data(), &params);
+
+				times[path] = tm.get_elapsed_secs();
+
+				if ((path) && (!(outputs[path] == outputs[0])))
+				{
+					error_printf("bc7e_scalar level %u: the scalar and %s outputs differ\n", level, s_path_names[path]);
+					status = false;
+					break;
+				}
+			}
+
+			g_cpu_supports_sse41 = orig_sse41;
+			g_cpu_supports_avx2 = orig_avx2;
+
+			if (!status)
+				break;
+
+			image unpacked_img(num_blocks_x * 4, num_blocks_y * 4);
+			for (uint32_t by = 0; by < num_blocks_y; by++)
+			{
+				for (uint32_t bx = 0; bx < num_blocks_x; bx++)
+				{
+					color_rgba unpacked_block[16];
+					if (!basist::bc7u::unpack_bc7(&outputs[0][(bx + by * num_blocks_x) * 2], (basist::color_rgba*)unpacked_block))
+					{
+						error_printf("bc7e_scalar level %u: unpack_bc7() failed\n", level);
+						status = false;
+						break;
+					}
+					unpacked_img.set_block_clipped(unpacked_block, bx * 4, by * 4, 4, 4);
+				}
+				if (!status)
+					break;
+			}
+
+			if (!status)
+				break;
+
+			unpacked_img.crop(img.get_width(), img.get_height());
+
+			image_metrics im;
+			im.calc(img, unpacked_img, 0, has_alpha ? 4 : 3);
+
+			printf("Level %u %-9s: PSNR %2.3f dB, scalar: %7.3f MPix/sec", level, s_levels[level].m_pName, im.m_psnr, total_mpix / times[0]);
+			for (uint32_t path = 1; path < cNumPaths; path++)
+			{
+				if (path_supported[path])
+					printf(", %s: %7.3f MPix/sec (%1.2fX)", s_path_names[path], total_mpix / times[path], times[0] / times[path]);
+			}
+			printf("\n");
+		}
+	}
+
+	g_cpu_supports_sse41 = orig_sse41;
+	g_cpu_supports_avx2 = orig_avx2;
+
+	return status;
+}
+
+// Transcodes every level/layer/face of each input KTX2 file through a ktx2_transcode_cache.
+static bool bench_transcode_cache_pass(const basisu::vector<std::string>& filenames, basisu::vector<uint8_vec>& file_data,
+	ktx2_transcode_cache& cache, const basisu::vector<basist::transcoder_texture_format>& fmts, basisu::vector<uint8_vec>& outputs, double& total_secs)
+{
+	outputs.resize(0);
+	total_secs = 0.0f;
+
+	for (uint32_t file_index = 0; file_index < file_data.size(); file_index++)
+	{
+		interval_timer tm;
+		tm.start();
+
+		basist::ktx2_transcoder dec;
+		if ((!dec.init(file_data[file_index].data(), file_data[file_index].size_u32())) || (!dec.start_transcoding()))
+		{
+			error_printf("Failed initializing KTX2 transcoder on file \"%s\"\n", filenames[file_index].c_str());
+			return false;
+		}
+
+		for (uint32_t fmt_index = 0; fmt_index < fmts.size(); fmt_index++)
+		{
+			const basist::transcoder_texture_format fmt = fmts[fmt_index];
+			if (!basis_is_format_supported(fmt, dec.get_basis_tex_format()))
+				continue;
+
+			for (uint32_t level_index = 0; level_index < dec.get_levels(); level_index++)
+			{
+				for (uint32_t layer_index = 0; layer_index < maximum<uint32_t>(dec.get_layers(), 1); layer_index++)
+				{
+					for (uint32_t face_index = 0; face_index < dec.get_faces(); face_index++)
+					{
+						basist::ktx2_image_level_info level_info;
+						if (!dec.get_image_level_info(level_info, level_index, layer_index, face_index))
+							return false;
+
+						if ((fmt == basist::transcoder_texture_format::cTFPVRTC1_4_RGB) || (fmt == basist::transcoder_texture_format::cTFPVRTC1_4_RGBA))
+						{
+							if (!is_pow2(level_info.m_width) || !is_pow2(level_info.m_height))
+								continue;
+						}
+
+						const uint32_t output_size = basist::basis_compute_transcoded_image_size_in_bytes(fmt, level_info.m_orig_width, level_info.m_orig_height);
+
+						uint8_vec& output = *outputs.enlarge(1);
+						output.resize(output_size);
+
+						if (!cache.transcode_image_level(dec, level_index, layer_index, face_index, output.data(), output_size / basist::basis_get_bytes_per_block_or_pixel(fmt), fmt))
+						{
+							error_printf("Failed transcoding file \"%s\" to %s\n", filenames[file_index].c_str(), basist::basis_get_format_name(fmt));
+							return false;
+						}
+					}
+				}
+			}
+		}
+
+		total_secs += tm.get_elapsed_secs();
+	}
+
+	return true;
+}
+
+// -transcode_cache: Transcodes each input KTX2 file to BC7 and ASTC 4x4 (or the -format_only format) with the transcode cache disabled,
+// then through an empty cache (all misses), then through the cache after reopening it from disk (all hits). Verifies the outputs are identical.
+static bool bench_transcode_cache(const bench_options& opts)
+{
+	basisu::vector<basist::transcoder_texture_format> fmts;
+	if (opts.m_format_only > -1)
+		fmts.push_back((basist::transcoder_texture_format)opts.m_format_only);
+	else
+	{
+		fmts.push_back(basist::transcoder_texture_format::cTFBC7_RGBA);
+		fmts.push_back(basist::transcoder_texture_format::cTFASTC_LDR_4x4_RGBA);
+	}
+
+	basisu::vector<uint8_vec> file_data(opts.m_input_filenames.size());
+	for (uint32_t i = 0; i < opts.m_input_filenames.size(); i++)
+	{
+		if (!read_file_to_vec(opts.m_input_filenames[i].c_str(), file_data[i]))
+		{
+			error_printf("Failed reading file \"%s\"\n", opts.m_input_filenames[i].c_str());
+			return false;
+		}
+	}
+
+	const char* pCache_filename = opts.m_transcode_cache_file.c_str();
+	const char* s_pass_names[3] = { "No cache", "Cold cache", "Warm cache (reopened)" };
+
+	basisu::vector<uint8_vec> outputs[3];
+
+	for (uint32_t pass = 0; pass < 3; pass++)
+	{
+		ktx2_transcode_cache cache;
+		if (pass)
+		{
+			cache.open(pCache_filename);
+			if (pass == 1)
+				cache.clear_entries();
+		}
+
+		double total_secs = 0.0f;
+		if (!bench_transcode_cache_pass(opts.m_input_filenames, file_data, cache, fmts, outputs[pass], total_secs))
+			return false;
+
+		const transcode_cache_stats stats(cache.get_stats());
+
+		if ((pass) && (!cache.close()))
+			return false;
+
+		printf("%-22s: %4.3f ms, hits: %llu, misses: %llu, insertions: %llu, evictions: %llu, cache entries: %llu, cache bytes: %llu\n", s_pass_names[pass], total_secs * 1000.0f,
+			(unsigned long long)stats.m_hits, (unsigned long long)stats.m_misses, (unsigned long long)stats.m_insertions, (unsigned long long)stats.m_evictions,
+			(unsigned long long)stats.m_total_entries, (unsigned long long)stats.m_total_bytes);
+
+		if ((pass) && (!(outputs[pass] == outputs[0])))
+		{
+			error_printf("Transcode cache output differs from the transcoder's output!\n");
+			return false;
+		}
+	}
+
+	printf("Wrote cache file \"%s\"\n", pCache_filename);
+
+	return true;
+}
+
+static bool parse_args(int argc, char** argv, bench_options& opts)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* pArg = argv[i];
+		const bool has_value = (i + 1) < argc;
+
+		if ((!strcmp(pArg, "-h")) || (!strcmp(pArg, "-help")) || (!strcmp(pArg, "--help")))
+		{
+			print_usage();
+			exit(EXIT_SUCCESS);
+		}
+		else if (!strcmp(pArg, "-tsvq"))
+			opts.m_mode = cBenchModeTSVQ;
+		else if (!strcmp(pArg, "-transcode_mt"))
+			opts.m_mode = cBenchModeTranscodeMT;
+		else if (!strcmp(pArg, "-etc1s_huffman"))
+			opts.m_mode = cBenchModeETC1SHuffman;
+		else if (!strcmp(pArg, "-etc1s_sse"))
+			opts.m_mode = cBenchModeETC1SSSE;
+		else if (!strcmp(pArg, "-bc7e"))
+			opts.m_mode = cBenchModeBC7E;
+		else if (!strcmp(pArg, "-transcode_cache"))
+			opts.m_mode = cBenchModeTranscodeCache;
+		else if (!strcmp(pArg, "-linear"))
+			opts.m_perceptual = false;
+		else if (!strcmp(pArg, "-quick"))
+		{
+			opts.m_resolutions.resize(0);
+			opts.m_resolutions.push_back(256);
+			opts.m_min_iters = 5;
+			opts.m_max_iters = 5;
+			opts.m_warmup_iters = 1;
+		}
+		else if (!has_value)
+		{
+			error_printf("Unrecognized option or missing value: \"%s\"\n", pArg);
+			return false;
+		}
+		else if (!strcmp(pArg, "-ldr_file"))
+			opts.m_ldr_filename = argv[++i];
+		else if (!strcmp(pArg, "-hdr_file"))
+			opts.m_hdr_filename = argv[++i];
+		else if (!strcmp(pArg, "-src"))
+			opts.m_src_filter = argv[++i];
+		else if (!strcmp(pArg, "-dst"))
+			opts.m_dst_filter = argv[++i];
+		else if (!strcmp(pArg, "-json"))
+			opts.m_json_filename = argv[++i];
+		else if (!strcmp(pArg, "-csv"))
+			opts.m_csv_filename = argv[++i];
+		else if (!strcmp(pArg, "-file"))
+			opts.m_input_filenames.push_back(argv[++i]);
+		else if (!strcmp(pArg, "-format_only"))
+			opts.m_format_only = atoi(argv[++i]);
+		else if (!strcmp(pArg, "-transcode_cache_file"))
+			opts.m_transcode_cache_file = argv[++i];
+		else if (!strcmp(pArg, "-warmup"))
+			opts.m_warmup_iters = atoi(argv[++i]);
+		else if (!strcmp(pArg, "-iters"))
+		{
+			opts.m_max_iters = maximum(1, atoi(argv[++i]));
+			opts.m_min_iters = minimum(opts.m_min_iters, opts.m_max_iters);
+		}
+		else if (!strcmp(pArg, "-res"))
+		{
+			if (!parse_uint_list(argv[++i], opts.m_resolutions))
+			{
+				error_printf("Invalid -res list\n");
+				return false;
+			}
+		}
+		else if (!strcmp(pArg, "-threads"))
+		{
+			if (!parse_uint_list(argv[++i], opts.m_thread_counts))
+			{
+				error_printf("Invalid -threads list\n");
+				return false;
+			}
+		}
+		else
+		{
+			error_printf("Unrecognized option: \"%s\"\n", pArg);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	bench_options opts;
+	opts.m_resolutions.push_back(256);
+	opts.m_resolutions.push_back(1024);
+	opts.m_resolutions.push_back(2048);
+
+	if (!parse_args(argc, argv, opts))
+	{
+		print_usage();
+		return EXIT_FAILURE;
+	}
+
+	if (!opts.m_thread_counts.size())
+	{
+		const uint32_t num_hw_threads = maximum(1, get_num_hardware_threads());
+
+		opts.m_thread_counts.push_back(1);
+		if (num_hw_threads > 1)
+			opts.m_thread_counts.push_back(num_hw_threads);
+	}
+
+	basisu_encoder_init();
+	basist::basisu_transcoder_init();
+
+	if (opts.m_mode >= cBenchModeTranscodeMT)
+	{
+		if ((opts.m_mode == cBenchModeBC7E) && (!opts.m_input_filenames.size()))
+			opts.m_input_filenames.push_back(opts.m_ldr_filename);
+
+		bool success = false;
+		switch (opts.m_mode)
+		{
+		case cBenchModeTranscodeMT:
+			success = bench_transcode_mt(opts);
+			break;
+		case cBenchModeETC1SHuffman:
+			success = bench_etc1s_huffman(opts);
+			break;
+		case cBenchModeETC1SSSE:
+			success = bench_etc1s_sse(opts);
+			break;
+		case cBenchModeBC7E:
+			success = bench_bc7e(opts);
+			break;
+		case cBenchModeTranscodeCache:
+			success = bench_transcode_cache(opts);
+			break;
+		default:
+			break;
+		}
+
+		basisu_encoder_deinit();
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	image ldr_src_img;
+	if (!load_image(opts.m_ldr_filename, ldr_src_img))
+	{
+		error_printf("Failed loading LDR source image \"%s\"\n", opts.m_ldr_filename.c_str());
+		return EXIT_FAILURE;
+	}
+
+	imagef hdr_src_img;
+	if (!load_image_hdr(opts.m_hdr_filename, hdr_src_img))
+	{
+		error_printf("Failed loading HDR source image \"%s\"\n", opts.m_hdr_filename.c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (opts.m_mode == cBenchModeTSVQ)
+	{
+		basisu::vector< std::pair<vec16F, uint64_t> > vecs16;
+		basisu::vector< std::pair<vec6F, uint64_t> > vecs6;
+		get_tsvq_training_vecs(ldr_src_img, vecs16, vecs6);
+
+		printf("%-8s %8s %8s %-8s %10s %7s\n", "Vectors", "Count", "Clusters", "Path", "Best ms", "Speedup");
+
+		bool success = bench_tsvq("vec16F", vecs16, opts.m_max_iters);
+		success = bench_tsvq("vec6F", vecs6, opts.m_max_iters) && success;
+
+		basisu_encoder_deinit();
+
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	job_pool encoder_jp(maximum(1, get_num_hardware_threads()));
+
+	basisu::vector<bench_result> results;
+	uint32_t total_failures = 0;
+
+	printf("%-24s %-24s %10s %7s %5s %10s %10s %10s %10s\n", "Source", "Target", "Res", "Threads", "Iters", "Median ms", "P99 ms", "MPix/s", "MB/s");
+
+	for (uint32_t res_index = 0; res_index < opts.m_resolutions.size(); res_index++)
+	{
+		const uint32_t res = opts.m_resolutions[res_index];
+
+		image ldr_img(res, res);
+		imagef hdr_img(res, res);
+		if ((!image_resample(ldr_src_img, ldr_img, true)) || (!image_resample(hdr_src_img, hdr_img)))
+		{
+			error_printf("Failed resampling the source images to %ux%u\n", res, res);
+			return EXIT_FAILURE;
+		}
+
+		for (uint32_t src_fmt_index = 0; src_fmt_index < (uint32_t)basist::basis_tex_format::cTotalFormats; src_fmt_index++)
+		{
+			const basist::basis_tex_format src_fmt = (basist::basis_tex_format)src_fmt_index;
+
+			if (!name_matches_filter(basist::basis_get_tex_format_name(src_fmt), opts.m_src_filter))
+				continue;
+
+			uint8_vec ktx2_data;
+			if (!encode_source(src_fmt, ldr_img, hdr_img, encoder_jp, ktx2_data))
+			{
+				error_printf("Failed encoding %ux%u %s source file\n", res, res, basist::basis_get_tex_format_name(src_fmt));
+				total_failures++;
+				continue;
+			}
+
+			for (uint32_t dst_fmt_index = 0; dst_fmt_index < (uint32_t)basist::transcoder_texture_format::cTFTotalTextureFormats; dst_fmt_index++)
+			{
+				const basist::transcoder_texture_format dst_fmt = (basist::transcoder_texture_format)dst_fmt_index;
+
+				// cTFBC7_ALT is an alias of cTFBC7_RGBA.
+				if (dst_fmt == basist::transcoder_texture_format::cTFBC7_ALT)
+					continue;
+
+				if (!basist::basis_is_format_supported(dst_fmt, src_fmt))
+					continue;
+
+				if (!name_matches_filter(basist::basis_get_format_name(dst_fmt), opts.m_dst_filter))
+					continue;
+
+				for (uint32_t thread_index = 0; thread_index < opts.m_thread_counts.size(); thread_index++)
+				{
+					bench_result r;
+					r.m_src_fmt = src_fmt;
+					r.m_dst_fmt = dst_fmt;
+
+					if (!bench_transcode(ktx2_data, dst_fmt, opts.m_thread_counts[thread_index], opts, r))
+					{
+						error_printf("Failed transcoding %ux%u %s to %s\n", res, res, basist::basis_get_tex_format_name(src_fmt), basist::basis_get_format_name(dst_fmt));
+						total_failures++;
+						continue;
+					}
+
+					char res_buf[32];
+					snprintf(res_buf, sizeof(res_buf), "%ux%u", r.m_width, r.m_height);
+
+					printf("%-24s %-24s %10s %7u %5u %10.3f %10.3f %10.2f %10.2f\n",
+						basist::basis_get_tex_format_name(src_fmt), basist::basis_get_format_name(dst_fmt), res_buf, r.m_threads, r.m_iters,
+						r.m_median_secs * 1000.0f, r.m_p99_secs * 1000.0f, r.get_mpix_per_sec(r.m_median_secs), ((double)r.m_output_bytes / r.m_median_secs) / (1024.0f * 1024.0f));
+					fflush(stdout);
+
+					results.push_back(r);
+				}
+			}
+		}
+	}
+
+	printf("Total cases: %u, failures: %u\n", results.size_u32(), total_failures);
+
+	bool success = (total_failures == 0);
+
+	if (opts.m_json_filename.size())
+	{
+		if (write_json(opts.m_json_filename.c_str(), opts, results))
+			printf("Wrote JSON file \"%s\"\n", opts.m_json_filename.c_str());
+		else
+			success = false;
+	}
+
+	if (opts.m_csv_filename.size())
+	{
+		if (write_csv(opts.m_csv_filename.c_str(), results))
+			printf("Wrote CSV file \"%s\"\n", opts.m_csv_filename.c_str());
+		else
+			success = false;
+	}
+
+	basisu_encoder_deinit();
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
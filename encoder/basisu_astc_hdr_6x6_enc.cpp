@@ -3385,6 +3385,8 @@ static bool unpack_physical_astc_block_google(const void* pBlock, uint32_t block
 
 static bool pack_bc6h_image(const imagef &src_img, vector2D<basist::bc6h_block> &bc6h_blocks, imagef *pPacked_bc6h_img, const fast_bc6h_params &enc_params)
 {
+	BASISU_TRACE_ZONE("astc_6x6_hdr::pack_bc6h_image");
+
 	const uint32_t width = src_img.get_width();
 	const uint32_t height = src_img.get_height();
 	
@@ -4218,6 +4220,8 @@ static bool compress_strip_task(
 {
 	BASISU_NOTE_UNUSED(num_blocks_y);
 	BASISU_NOTE_UNUSED(total_strips);
+
+	BASISU_TRACE_ZONE_ARG("astc_6x6_hdr::compress_strip_task", strip_index);
 	
 	vec3F prev_comp_pixels[BLOCK_H][BLOCK_W]; // [y][x]
 	basisu::clear_obj(prev_comp_pixels);
@@ -6533,6 +6537,9 @@ static bool compress_strip_task(
 
 		} // bx
 
+		if ((global_cfg.m_pProgress) && (!global_cfg.m_pProgress->update(num_blocks_x)))
+			return false;
+
 	} // by
 
 	if (prev_encoding.get_total_bits())
@@ -6578,6 +6585,8 @@ bool compress_photo(const basisu::imagef &orig_src_img, const astc_hdr_6x6_globa
 	
 	assert(pJob_pool);
 
+	BASISU_TRACE_ZONE("astc_6x6_hdr::compress_photo");
+
 	if (orig_global_cfg.m_debug_output)
 	{
 		fmt_debug_printf("------ astc_6x6_hdr::compress_photo:\n");
@@ -6720,6 +6729,9 @@ bool compress_photo(const basisu::imagef &orig_src_img, const astc_hdr_6x6_globa
 	std::atomic_bool any_failed_flag;
 	any_failed_flag.store(false);
 
+	if (global_cfg.m_pProgress)
+		global_cfg.m_pProgress->begin_stage(0.0f, 1.0f, total_blocks);
+
 	for (uint32_t strip_index = 0; strip_index < total_strips; strip_index++)
 	{
 		const uint32_t strip_first_by = strip_index * rows_per_strip;
@@ -6732,7 +6744,7 @@ bool compress_photo(const basisu::imagef &orig_src_img, const astc_hdr_6x6_globa
 			strip_index, total_strips, strip_first_by, strip_last_by,
 			num_blocks_x, num_blocks_y, total_blocks, width, height]
 		{
-			if (!any_failed_flag)
+			if ((!any_failed_flag) && ((!global_cfg.m_pProgress) || (!global_cfg.m_pProgress->is_stopped())))
 			{
 				bool status = compress_strip_task(
 					strip_index, total_strips, strip_first_by, strip_last_by,
@@ -6741,7 +6753,9 @@ bool compress_photo(const basisu::imagef &orig_src_img, const astc_hdr_6x6_globa
 
 				if (!status)
 				{
-					fmt_error_printf("compress_photo: compress_strip_task() failed\n");
+					if ((!global_cfg.m_pProgress) || (!global_cfg.m_pProgress->is_stopped()))
+						fmt_error_printf("compress_photo: compress_strip_task() failed\n");
+
 					any_failed_flag.store(true, std::memory_order_relaxed);
 				}
 			}
@@ -6754,6 +6768,9 @@ bool compress_photo(const basisu::imagef &orig_src_img, const astc_hdr_6x6_globa
 
 	pJob_pool->wait_for_all();
 
+	if ((global_cfg.m_pProgress) && (global_cfg.m_pProgress->is_stopped()))
+		return false;
+
 	if (any_failed_flag)
 	{
 		fmt_error_printf("One or more strips failed during compression\n");
@@ -84,6 +84,9 @@ namespace astc_6x6_hdr
 		// If this is false a v2.0 or later transcoder is required for UASTC HDR 6x6i.
 		bool m_write_basisu_1_6_compatible_files = true;
 
+		// Optional progress reporting/cancellation, updated once per encoded block row. If it's stopped compress_photo() returns false.
+		basisu::encode_progress* m_pProgress = nullptr;
+
 		void print() const
 		{
 			basisu::fmt_debug_printf("  m_master_comp_level: {}, m_highest_comp_level: {}\n", m_master_comp_level, m_highest_comp_level);
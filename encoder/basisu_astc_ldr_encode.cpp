@@ -6461,6 +6461,7 @@ struct ldr_astc_block_encode_image_high_level_config
 	std::string m_debug_file_prefix;
 
 	job_pool* m_pJob_pool;
+	encode_progress* m_pProgress = nullptr;
 		
 	astc_ldr::cem_encode_params m_cem_enc_params;
 };
@@ -7664,6 +7665,8 @@ static bool ldr_astc_block_encode_image(
 	if (enc_cfg.m_debug_output)
 		fmt_debug_printf("ldr_astc_block_encode_image:\n");
 
+	BASISU_TRACE_ZONE("astc_ldr::ldr_astc_block_encode_image");
+
 	const uint32_t block_width = enc_cfg.m_block_width, block_height = enc_cfg.m_block_height;
 	const uint32_t width = orig_img.get_width(), height = orig_img.get_height();
 	const uint32_t total_pixels = width * height;
@@ -7935,6 +7938,10 @@ static bool ldr_astc_block_encode_image(
 		total_superpasses = 2;
 		
 	uint32_t total_blocks_to_recompress = 0;
+
+	// Every superpass adds a job per block.
+	if (enc_cfg.m_pProgress)
+		enc_cfg.m_pProgress->set_stage_units((uint64_t)total_blocks * total_superpasses);
 		
 	//uint32_t max_candidates = 64;
 	//if (total_blocks >= (512 * 512))
@@ -7953,6 +7960,8 @@ static bool ldr_astc_block_encode_image(
 		if (enc_cfg.m_debug_output)
 			fmt_debug_printf("ASTC packing superpass: {}\n", 1 + superpass_index);
 
+		BASISU_TRACE_ZONE_ARG("astc_ldr::superpass", superpass_index);
+
 		uint32_t total_blocks_done = 0;
 		float last_printed_progress_val = -100.0f;
 
@@ -7981,6 +7990,9 @@ static bool ldr_astc_block_encode_image(
 						if (encoder_failed_flag)
 							return;
 
+						if ((enc_cfg.m_pProgress) && (!enc_cfg.m_pProgress->update(1)))
+							return;
+
 						//const uint32_t base_x = bx * block_width, base_y = by * block_height;
 
 						color_rgba block_pixels[astc_ldr::ASTC_LDR_MAX_BLOCK_PIXELS];
@@ -8836,6 +8848,9 @@ static bool ldr_astc_block_encode_image(
 
 		job_pool.wait_for_all();
 
+		if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+			return false;
+
 		if (encoder_failed_flag)
 		{
 			fmt_error_printf("Main compressor block loop failed!\n");
@@ -9629,6 +9644,8 @@ bool ldr_astc_block_encode_image_fast_4x4(
 {
 	BASISU_NOTE_UNUSED(max_candidate_limit);
 
+	BASISU_TRACE_ZONE("astc_ldr::ldr_astc_block_encode_image_fast_4x4");
+
 	if (enc_cfg.m_debug_output)
 		fmt_debug_printf("ldr_astc_block_encode_image_fast_4x4:\n");
 
@@ -9714,6 +9731,9 @@ bool ldr_astc_block_encode_image_fast_4x4(
 	std::atomic<bool> encoder_failed_flag;
 	encoder_failed_flag.store(false);
 
+	if (enc_cfg.m_pProgress)
+		enc_cfg.m_pProgress->set_stage_units(num_blocks_y);
+
 	for (uint32_t job_index = 0; job_index < num_threads; job_index++)
 	{
 		job_pool.add_job([job_index, num_threads, num_blocks_x, num_blocks_y, block_width, block_height, total_blocks, total_block_pixels, bc7f_override_flags,
@@ -9728,6 +9748,9 @@ bool ldr_astc_block_encode_image_fast_4x4(
 				if (encoder_failed_flag)
 					return;
 
+				if ((enc_cfg.m_pProgress) && (!enc_cfg.m_pProgress->update(1)))
+					return;
+
 				const uint32_t by = cur_row.fetch_add(1);
 				if (by >= num_blocks_y)
 					break;
@@ -9907,6 +9930,9 @@ bool ldr_astc_block_encode_image_fast_4x4(
 
 	job_pool.wait_for_all();
 
+	if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+		return false;
+
 	if (encoder_failed_flag)
 	{
 		fmt_error_printf("ldr_astc_block_encode_image_fast_4x4: Main compressor block loop failed!\n");
@@ -10088,6 +10114,8 @@ static bool ldr_astc_block_encode_image_astcenc(
 	if (enc_cfg.m_debug_output)
 		fmt_debug_printf("ldr_astc_block_encode_image_astcenc:\n");
 
+	BASISU_TRACE_ZONE("astc_ldr::ldr_astc_block_encode_image_astcenc");
+
 	const uint32_t block_width = enc_cfg.m_block_width, block_height = enc_cfg.m_block_height;
 
 	//const uint32_t width = orig_img.get_width(), height = orig_img.get_height();
@@ -10564,6 +10592,8 @@ static bool ldr_astc_block_encode_image_astcf(
 	if (enc_cfg.m_debug_output)
 		fmt_debug_printf("ldr_astc_block_encode_image_astcf:\n");
 
+	BASISU_TRACE_ZONE("astc_ldr::ldr_astc_block_encode_image_astcf");
+
 	const uint32_t block_width = enc_cfg.m_block_width, block_height = enc_cfg.m_block_height;
 
 	const int block_dim_index = astc_helpers::find_astc_block_size_index(block_width, block_height);
@@ -10725,6 +10755,9 @@ static bool ldr_astc_block_encode_image_astcf(
 			var_thresh_2subsets, dot_thresh_fract_index_2subsets, var_thresh_3subsets,
 			ctx.m_use_method1, ctx.m_use_method2, ctx.m_higher_effort_bc, ctx.m_try_base_ofs, ctx.m_max_subsets);
 	}
+
+	if (enc_cfg.m_pProgress)
+		enc_cfg.m_pProgress->set_stage_units(num_blocks_y);
 					
 	for (uint32_t job_index = 0; job_index < num_threads; job_index++)
 	{
@@ -10752,6 +10785,9 @@ static bool ldr_astc_block_encode_image_astcf(
 					if (encoder_failed_flag)
 						return;
 
+					if ((enc_cfg.m_pProgress) && (!enc_cfg.m_pProgress->update(1)))
+						return;
+
 					const uint32_t by = cur_row.fetch_add(1);
 					if (by >= num_blocks_y)
 						break;
@@ -10963,6 +10999,9 @@ static bool ldr_astc_block_encode_image_astcf(
 	} // job_index
 
 	job_pool.wait_for_all();
+
+	if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+		return false;
 		
 	if (encoder_failed_flag)
 	{
@@ -11710,6 +11749,8 @@ static void configure_encoder_effort_level(int level, ldr_astc_block_encode_imag
 #if BASISD_SUPPORT_KTX2_ZSTD
 static bool zstd_compress(const uint8_t* pData, size_t data_len, uint8_vec& comp_data, int zstd_level)
 {
+	BASISU_TRACE_ZONE("astc_ldr::zstd_compress");
+
 	if (!data_len)
 	{
 		comp_data.resize(0);
@@ -11848,6 +11889,8 @@ static bool compress_image_full_zstd(
 {
 	BASISU_NOTE_UNUSED(job_pool);
 
+	BASISU_TRACE_ZONE("astc_ldr::compress_image_full_zstd");
+
 	const uint32_t width = orig_img.get_width(), height = orig_img.get_height();
 
 	const uint32_t block_width = global_cfg.m_astc_block_width;
@@ -13652,6 +13695,9 @@ static bool mutate_candidates(
 
 				for (; ;)
 				{
+					if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+						return;
+
 					// Asynchronously fetch the next block index to process.
 					const uint32_t block_index = cur_block_index.fetch_add(1);
 					if (block_index >= total_blocks)
@@ -14136,6 +14182,9 @@ static bool mutate_candidates(
 
 	jp.wait_for_all();
 
+	if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+		return false;
+
 	if (encoder_failed_flag)
 	{
 		fmt_error_printf("refine_output_for_deblocking: Threaded deblocking pass failed! (2)\n");
@@ -14154,6 +14203,8 @@ static bool refine_output_for_deblocking(
 	if (global_cfg.m_debug_output)
 		fmt_debug_printf("------------------- refine_output_for_deblocking:\n");
 
+	BASISU_TRACE_ZONE("astc_ldr::refine_output_for_deblocking");
+
 	const uint32_t width = orig_img.get_width();
 	const uint32_t height = orig_img.get_height();
 	const uint32_t block_width = global_cfg.m_astc_block_width;
@@ -14426,10 +14477,17 @@ static bool refine_output_for_deblocking(
 	} // num_subsets
 #endif
 
+	if (enc_cfg.m_pProgress)
+		enc_cfg.m_pProgress->set_stage_units(num_passes);
+
 	for (uint32_t pass = 0; pass < num_passes; pass++)
 	{
 		const bool final_pass_flag = (pass == (num_passes - 1));
 
+		// Each pass is a full sweep over the (white or black) blocks, so this is fine grained enough.
+		if ((pass) && (enc_cfg.m_pProgress) && (!enc_cfg.m_pProgress->update(1)))
+			return false;
+
 		if (global_cfg.m_debug_output)
 			fmt_debug_printf("Pass: {}\n", pass);
 						
@@ -14471,6 +14529,9 @@ static bool refine_output_for_deblocking(
 							if (encoder_failed_flag)
 								return;
 
+							if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+								return;
+
 							const uint32_t block_list_index = cur_block_list_index.fetch_add(1);
 							if (block_list_index >= pJob_block_list->size_u32())
 								break;
@@ -14511,6 +14572,9 @@ static bool refine_output_for_deblocking(
 
 			job_pool.wait_for_all();
 
+			if ((enc_cfg.m_pProgress) && (enc_cfg.m_pProgress->is_stopped()))
+				return false;
+
 			if (encoder_failed_flag)
 			{
 				fmt_error_printf("refine_output_for_deblocking: Threaded deblocking pass failed!\n");
@@ -14871,6 +14935,8 @@ bool compress_image(
 {
 	assert(g_initialized);
 
+	BASISU_TRACE_ZONE("astc_ldr::compress_image");
+
 	astc_ldr_encode_config global_cfg(orig_global_cfg);
 
 	//global_cfg.m_debug_block_x = 17;
@@ -14946,6 +15012,7 @@ bool compress_image(
 	enc_cfg.m_block_width = block_width;
 	enc_cfg.m_block_height = block_height;
 	enc_cfg.m_pJob_pool = &job_pool;
+	enc_cfg.m_pProgress = global_cfg.m_pProgress;
 
 	enc_cfg.m_use_dct = global_cfg.m_use_dct;
 
@@ -15012,6 +15079,12 @@ bool compress_image(
 
 	bool encoded_flag = false; // has the input been encoded yet
 
+	// Progress: the block encoder(s) get [0,progress_encode_end] of this call, the optional SCD passes the range up to .9, and the
+	// entropy coding stage the rest. When basisu's output is merged in, the (much faster) alternative encoder gets the first quarter.
+	encode_progress* pProgress = global_cfg.m_pProgress;
+	const float progress_encode_end = global_cfg.m_scd_enabled ? .6f : .9f;
+	const float progress_alt_encode_end = progress_encode_end * (global_cfg.m_merge_basisu_into_output ? .25f : 1.0f);
+
 	// Candidates are expensive memory wise, so try to place sane limits on them (especially important for WASM).
 	// This is a per-encoder limit (not total after merging).
 	uint32_t max_candidate_limit = 16;
@@ -15044,6 +15117,9 @@ bool compress_image(
 #if BASISU_SUPPORT_ASTCENC
 	if (global_cfg.m_use_astcenc)
 	{
+		if (pProgress)
+			pProgress->begin_stage(0.0f, progress_alt_encode_end, 0);
+
 		// TODO: If this somehow fails, we could fall back to our encoder.
 		enc_status = ldr_astc_block_encode_image_astcenc(orig_img, enc_cfg, global_cfg, enc_out, max_candidate_limit);
 		if (!enc_status)
@@ -15078,7 +15154,13 @@ bool compress_image(
 
 	if ((!encoded_flag) && (global_cfg.m_use_astcf))
 	{
+		if (pProgress)
+			pProgress->begin_stage(0.0f, progress_alt_encode_end, 0);
+
 		enc_status = ldr_astc_block_encode_image_astcf(orig_img, enc_cfg, global_cfg, enc_out, max_candidate_limit);
+		if ((!enc_status) && (pProgress) && (pProgress->is_stopped()))
+			return false;
+
 		if (!enc_status)
 		{
 			fmt_error_printf("ldr_astc_block_encode_image_astcf() failed!\n");
@@ -15093,6 +15175,9 @@ bool compress_image(
 	{
 		std::unique_ptr<ldr_astc_block_encode_image_output> pEnc_out_basisu = std::make_unique<ldr_astc_block_encode_image_output>();
 
+		if (pProgress)
+			pProgress->begin_stage(progress_alt_encode_end, progress_encode_end, 0);
+
 		if ((global_cfg.m_effort_level == 0) && (global_cfg.m_astc_block_width == 4) && (global_cfg.m_astc_block_height == 4))
 			enc_status = ldr_astc_block_encode_image_fast_4x4(orig_img, enc_cfg, global_cfg, *pEnc_out_basisu, max_candidate_limit);
 		else
@@ -15101,6 +15186,9 @@ bool compress_image(
 		if (global_cfg.m_debug_output)
 			fmt_debug_printf("ldr_astc_block_encode_image: {}\n", enc_status);
 
+		if ((!enc_status) && (pProgress) && (pProgress->is_stopped()))
+			return false;
+
 		if (!enc_status)
 		{
 			fmt_error_printf("ldr_astc_block_encode_image_fast_4x4() or ldr_astc_block_encode_image() failed!\n");
@@ -15117,6 +15205,9 @@ bool compress_image(
 	}
 	else if (!encoded_flag)
 	{
+		if (pProgress)
+			pProgress->begin_stage(0.0f, progress_encode_end, 0);
+
 		if ((global_cfg.m_effort_level == 0) && (global_cfg.m_astc_block_width == 4) && (global_cfg.m_astc_block_height == 4))
 		{
 			enc_status = ldr_astc_block_encode_image_fast_4x4(orig_img, enc_cfg, global_cfg, enc_out, max_candidate_limit);
@@ -15129,6 +15220,9 @@ bool compress_image(
 		if (global_cfg.m_debug_output)
 			fmt_debug_printf("ldr_astc_block_encode_image: {}\n", enc_status);
 
+		if ((!enc_status) && (pProgress) && (pProgress->is_stopped()))
+			return false;
+
 		if (!enc_status)
 		{
 			fmt_error_printf("ldr_astc_block_encode_image_fast_4x4() or ldr_astc_block_encode_image() failed!\n");
@@ -15145,10 +15239,20 @@ bool compress_image(
 
 	if (global_cfg.m_scd_enabled)
 	{
+		if (pProgress)
+			pProgress->begin_stage(progress_encode_end, .9f, 0);
+
 		if (!refine_output_for_deblocking(orig_img, global_cfg, enc_cfg, enc_out))
 			return false;
 	}
 
+	if (pProgress)
+	{
+		pProgress->begin_stage(.9f, 1.0f, 0);
+		if (!pProgress->update())
+			return false;
+	}
+
 	// sanity check decoded weight grids
 	if (global_cfg.m_use_dct)
 	{
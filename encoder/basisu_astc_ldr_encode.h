@@ -99,6 +99,10 @@ namespace astc_ldr {
 
 		std::string m_debug_file_prefix;
 
+		// Optional progress reporting/cancellation, updated at block (or block row) granularity by every encoding pass.
+		// If it's stopped compress_image() returns false.
+		encode_progress* m_pProgress = nullptr;
+
 		void debug_print() const
 		{
 			fmt_debug_printf("ASTC block dimensions: {}x{}\n", m_astc_block_width, m_astc_block_height);
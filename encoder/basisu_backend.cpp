@@ -22,6 +22,12 @@
 #include "basisu_kernels_declares.h"
 #endif
 
+#if BASISU_SUPPORT_AVX2
+#undef CPPSPMD_NAME
+#define CPPSPMD_NAME(a) a##_avx2
+#include "basisu_kernels_declares.h"
+#endif
+
 #define BASISU_FASTER_SELECTOR_REORDERING 0
 #define BASISU_BACKEND_VERIFY(c) verify(c, __LINE__);
 
@@ -129,6 +135,8 @@ namespace basisu
 
 	void basisu_backend::reoptimize_and_sort_endpoints_codebook(uint32_t total_block_endpoints_remapped, uint_vec& all_endpoint_indices)
 	{
+		BASISU_TRACE_ZONE("basisu_backend::reoptimize_and_sort_endpoints_codebook");
+
 		basisu_frontend& r = *m_pFront_end;
 		//const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
 
@@ -161,6 +169,9 @@ namespace basisu
 				int_vec old_to_new_endpoint_indices;
 				r.reoptimize_remapped_endpoints(new_block_endpoints, old_to_new_endpoint_indices, true);
 
+				if (is_stopped())
+					return;
+
 				create_endpoint_palette();
 
 				for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
@@ -245,6 +256,8 @@ namespace basisu
 
 	void basisu_backend::sort_selector_codebook()
 	{
+		BASISU_TRACE_ZONE("basisu_backend::sort_selector_codebook");
+
 		basisu_frontend& r = *m_pFront_end;
 
 		m_selector_remap_table_new_to_old.resize(r.get_total_selector_clusters());
@@ -403,205 +416,305 @@ namespace basisu
 		BASISU_BACKEND_VERIFY(total_invalid_crs == 0);
 	}
 
-	void basisu_backend::create_encoder_blocks()
+	uint32_t basisu_backend::get_total_slice_jobs(bool allow_multithreading) const
 	{
-		debug_printf("basisu_backend::create_encoder_blocks\n");
+		if ((!allow_multithreading) || (!m_params.m_multithreaded) || (!m_params.m_pJob_pool) || (m_params.m_pJob_pool->get_total_threads() < 2) || (m_slices.size() < 2))
+			return 1;
 
-		interval_timer tm;
-		tm.start();
+		// A few jobs per thread, because the slices (mipmap levels in particular) can vary a lot in size.
+		return (uint32_t)minimum<size_t>(m_slices.size(), m_params.m_pJob_pool->get_total_threads() * 4);
+	}
 
-		basisu_frontend& r = *m_pFront_end;
-		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
+	// Calls func() once per job with a contiguous run of slices [first_slice_index, last_slice_index). With a single job it's
+	// called directly on this thread. If gop_aligned is true, each job boundary is moved forward to the next video GOP start, so
+	// every job gets whole GOPs.
+	void basisu_backend::run_slice_jobs(uint32_t num_jobs, const std::function<void(uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index)>& func, bool gop_aligned)
+	{
+		const uint32_t total_slices = (uint32_t)m_slices.size();
 
-		m_slice_encoder_blocks.resize(m_slices.size());
+		if (num_jobs <= 1)
+		{
+			func(0, 0, total_slices);
+			return;
+		}
 
-		uint32_t total_endpoint_pred_missed = 0, total_endpoint_pred_hits = 0, total_block_endpoints_remapped = 0;
+		const uint32_t slices_per_job = (total_slices + num_jobs - 1) / num_jobs;
 
-		uint_vec all_endpoint_indices;
-		all_endpoint_indices.reserve(get_total_blocks());
+		auto get_job_first_slice = [this, total_slices, slices_per_job, gop_aligned](uint32_t job_index) {
+			uint32_t slice_index = minimum(total_slices, job_index * slices_per_job);
+			if (gop_aligned)
+			{
+				while ((slice_index < total_slices) && (!is_video_gop_start(slice_index)))
+					slice_index++;
+			}
+			return slice_index;
+		};
 
-		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
+		for (uint32_t job_index = 0; job_index < num_jobs; job_index++)
 		{
-			const int prev_frame_slice_index = is_video ? find_video_frame(slice_index, -1) : -1;
-			const bool is_iframe = m_slices[slice_index].m_iframe;
-			const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
+			const uint32_t first_slice_index = get_job_first_slice(job_index);
+			const uint32_t last_slice_index = get_job_first_slice(job_index + 1);
+			if (first_slice_index == last_slice_index)
+				continue;
 
-			//const uint32_t width = m_slices[slice_index].m_width;
-			//const uint32_t height = m_slices[slice_index].m_height;
-			const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
-			const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
+			m_params.m_pJob_pool->add_job([&func, job_index, first_slice_index, last_slice_index] {
+				func(job_index, first_slice_index, last_slice_index);
+				});
+		}
 
-			m_slice_encoder_blocks[slice_index].resize(num_blocks_x, num_blocks_y);
+		m_params.m_pJob_pool->wait_for_all();
+	}
 
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+	// A video GOP starts at the first slice of each I-frame. P-frames only reference the previous frame, so GOPs are independent.
+	bool basisu_backend::is_video_gop_start(uint32_t slice_index) const
+	{
+		if (!m_slices[slice_index].m_iframe)
+			return false;
+
+		return (!slice_index) || (m_slices[slice_index - 1].m_source_file_index != m_slices[slice_index].m_source_file_index);
+	}
+
+	uint32_t basisu_backend::get_total_video_gops() const
+	{
+		uint32_t total_gops = 0;
+		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
+			total_gops += is_video_gop_start(slice_index);
+		return total_gops;
+	}
+
+	void basisu_backend::create_slice_encoder_blocks(uint32_t slice_index, encoder_blocks_state& state)
+	{
+		basisu_frontend& r = *m_pFront_end;
+		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
+
+		const int prev_frame_slice_index = is_video ? find_video_frame(slice_index, -1) : -1;
+		const bool is_iframe = m_slices[slice_index].m_iframe;
+		const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
+
+		//const uint32_t width = m_slices[slice_index].m_width;
+		//const uint32_t height = m_slices[slice_index].m_height;
+		const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
+		const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
+
+		m_slice_encoder_blocks[slice_index].resize(num_blocks_x, num_blocks_y);
+
+		for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		{
+			for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
 			{
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-				{
-					const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
+				const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
 
-					encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
+				encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
 
-					m.m_endpoint_index = r.get_subblock_endpoint_cluster_index(block_index, 0);
-					BASISU_BACKEND_VERIFY(r.get_subblock_endpoint_cluster_index(block_index, 0) == r.get_subblock_endpoint_cluster_index(block_index, 1));
+				m.m_endpoint_index = r.get_subblock_endpoint_cluster_index(block_index, 0);
+				BASISU_BACKEND_VERIFY(r.get_subblock_endpoint_cluster_index(block_index, 0) == r.get_subblock_endpoint_cluster_index(block_index, 1));
 
-					m.m_selector_index = r.get_block_selector_cluster_index(block_index);
+				m.m_selector_index = r.get_block_selector_cluster_index(block_index);
 
-					m.m_endpoint_predictor = basist::NO_ENDPOINT_PRED_INDEX;
+				m.m_endpoint_predictor = basist::NO_ENDPOINT_PRED_INDEX;
 
-					const uint32_t block_endpoint = m.m_endpoint_index;
+				const uint32_t block_endpoint = m.m_endpoint_index;
 
-					uint32_t best_endpoint_pred = UINT32_MAX;
+				uint32_t best_endpoint_pred = UINT32_MAX;
 
-					for (uint32_t endpoint_pred = 0; endpoint_pred < basist::NUM_ENDPOINT_PREDS; endpoint_pred++)
+				for (uint32_t endpoint_pred = 0; endpoint_pred < basist::NUM_ENDPOINT_PREDS; endpoint_pred++)
+				{
+					if ((is_video) && (endpoint_pred == basist::CR_ENDPOINT_PRED_INDEX))
 					{
-						if ((is_video) && (endpoint_pred == basist::CR_ENDPOINT_PRED_INDEX))
+						if ((prev_frame_slice_index != -1) && (!is_iframe))
 						{
-							if ((prev_frame_slice_index != -1) && (!is_iframe))
+							const uint32_t cur_endpoint = m_slice_encoder_blocks[slice_index](block_x, block_y).m_endpoint_index;
+							const uint32_t cur_selector = m_slice_encoder_blocks[slice_index](block_x, block_y).m_selector_index;
+							const uint32_t prev_endpoint = m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_endpoint_index;
+							const uint32_t prev_selector = m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_selector_index;
+							if ((cur_endpoint == prev_endpoint) && (cur_selector == prev_selector))
 							{
-								const uint32_t cur_endpoint = m_slice_encoder_blocks[slice_index](block_x, block_y).m_endpoint_index;
-								const uint32_t cur_selector = m_slice_encoder_blocks[slice_index](block_x, block_y).m_selector_index;
-								const uint32_t prev_endpoint = m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_endpoint_index;
-								const uint32_t prev_selector = m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_selector_index;
-								if ((cur_endpoint == prev_endpoint) && (cur_selector == prev_selector))
-								{
-									best_endpoint_pred = basist::CR_ENDPOINT_PRED_INDEX;
-									m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_is_cr_target = true;
-								}
+								best_endpoint_pred = basist::CR_ENDPOINT_PRED_INDEX;
+								m_slice_encoder_blocks[prev_frame_slice_index](block_x, block_y).m_is_cr_target = true;
 							}
 						}
-						else
-						{
-							int pred_block_x = block_x + g_endpoint_preds[endpoint_pred].m_dx;
-							if ((pred_block_x < 0) || (pred_block_x >= (int)num_blocks_x))
-								continue;
+					}
+					else
+					{
+						int pred_block_x = block_x + g_endpoint_preds[endpoint_pred].m_dx;
+						if ((pred_block_x < 0) || (pred_block_x >= (int)num_blocks_x))
+							continue;
 
-							int pred_block_y = block_y + g_endpoint_preds[endpoint_pred].m_dy;
-							if ((pred_block_y < 0) || (pred_block_y >= (int)num_blocks_y))
-								continue;
+						int pred_block_y = block_y + g_endpoint_preds[endpoint_pred].m_dy;
+						if ((pred_block_y < 0) || (pred_block_y >= (int)num_blocks_y))
+							continue;
 
-							uint32_t pred_endpoint = m_slice_encoder_blocks[slice_index](pred_block_x, pred_block_y).m_endpoint_index;
+						uint32_t pred_endpoint = m_slice_encoder_blocks[slice_index](pred_block_x, pred_block_y).m_endpoint_index;
 
-							if (pred_endpoint == block_endpoint)
+						if (pred_endpoint == block_endpoint)
+						{
+							if (endpoint_pred < best_endpoint_pred)
 							{
-								if (endpoint_pred < best_endpoint_pred)
-								{
-									best_endpoint_pred = endpoint_pred;
-								}
+								best_endpoint_pred = endpoint_pred;
 							}
 						}
+					}
 
-					} // endpoint_pred
+				} // endpoint_pred
 
-					if (best_endpoint_pred != UINT32_MAX)
-					{
-						m.m_endpoint_predictor = best_endpoint_pred;
+				if (best_endpoint_pred != UINT32_MAX)
+				{
+					m.m_endpoint_predictor = best_endpoint_pred;
 
-						total_endpoint_pred_hits++;
-					}
-					else if (m_params.m_endpoint_rdo_quality_thresh > 0.0f)
-					{
-						const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
+					state.m_total_endpoint_pred_hits++;
+				}
+				else if (m_params.m_endpoint_rdo_quality_thresh > 0.0f)
+				{
+					const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
 
-						etc_block etc_blk(r.get_output_block(block_index));
+					etc_block etc_blk(r.get_output_block(block_index));
 
-						uint64_t cur_err = etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
+					uint64_t cur_err = etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
 
-						if (cur_err)
-						{
-							const uint64_t thresh_err = (uint64_t)(cur_err * maximum(1.0f, m_params.m_endpoint_rdo_quality_thresh));
+					if (cur_err)
+					{
+						const uint64_t thresh_err = (uint64_t)(cur_err * maximum(1.0f, m_params.m_endpoint_rdo_quality_thresh));
 
-							etc_block trial_etc_block(etc_blk);
+						etc_block trial_etc_block(etc_blk);
 
-							uint64_t best_err = UINT64_MAX;
-							uint32_t best_endpoint_index = 0;
+						uint64_t best_err = UINT64_MAX;
+						uint32_t best_endpoint_index = 0;
 
-							best_endpoint_pred = UINT32_MAX;
+						best_endpoint_pred = UINT32_MAX;
 
-							for (uint32_t endpoint_pred = 0; endpoint_pred < basist::NUM_ENDPOINT_PREDS; endpoint_pred++)
-							{
-								if ((is_video) && (endpoint_pred == basist::CR_ENDPOINT_PRED_INDEX))
-									continue;
+						for (uint32_t endpoint_pred = 0; endpoint_pred < basist::NUM_ENDPOINT_PREDS; endpoint_pred++)
+						{
+							if ((is_video) && (endpoint_pred == basist::CR_ENDPOINT_PRED_INDEX))
+								continue;
 
-								int pred_block_x = block_x + g_endpoint_preds[endpoint_pred].m_dx;
-								if ((pred_block_x < 0) || (pred_block_x >= (int)num_blocks_x))
-									continue;
+							int pred_block_x = block_x + g_endpoint_preds[endpoint_pred].m_dx;
+							if ((pred_block_x < 0) || (pred_block_x >= (int)num_blocks_x))
+								continue;
 
-								int pred_block_y = block_y + g_endpoint_preds[endpoint_pred].m_dy;
-								if ((pred_block_y < 0) || (pred_block_y >= (int)num_blocks_y))
-									continue;
+							int pred_block_y = block_y + g_endpoint_preds[endpoint_pred].m_dy;
+							if ((pred_block_y < 0) || (pred_block_y >= (int)num_blocks_y))
+								continue;
 
-								uint32_t pred_endpoint_index = m_slice_encoder_blocks[slice_index](pred_block_x, pred_block_y).m_endpoint_index;
+							uint32_t pred_endpoint_index = m_slice_encoder_blocks[slice_index](pred_block_x, pred_block_y).m_endpoint_index;
 
-								uint32_t pred_inten = r.get_endpoint_cluster_inten_table(pred_endpoint_index, false);
-								color_rgba pred_color = r.get_endpoint_cluster_unscaled_color(pred_endpoint_index, false);
+							uint32_t pred_inten = r.get_endpoint_cluster_inten_table(pred_endpoint_index, false);
+							color_rgba pred_color = r.get_endpoint_cluster_unscaled_color(pred_endpoint_index, false);
 
-								trial_etc_block.set_block_color5(pred_color, pred_color);
-								trial_etc_block.set_inten_table(0, pred_inten);
-								trial_etc_block.set_inten_table(1, pred_inten);
+							trial_etc_block.set_block_color5(pred_color, pred_color);
+							trial_etc_block.set_inten_table(0, pred_inten);
+							trial_etc_block.set_inten_table(1, pred_inten);
 
-								color_rgba trial_colors[16];
-								unpack_etc1(trial_etc_block, trial_colors);
+							color_rgba trial_colors[16];
+							unpack_etc1(trial_etc_block, trial_colors);
 
-								uint64_t trial_err = 0;
-								if (r.get_params().m_perceptual)
+							uint64_t trial_err = 0;
+							if (r.get_params().m_perceptual)
+							{
+								for (uint32_t p = 0; p < 16; p++)
 								{
-									for (uint32_t p = 0; p < 16; p++)
-									{
-										trial_err += color_distance(true, src_pixels.get_ptr()[p], trial_colors[p], false);
-										if (trial_err > thresh_err)
-											break;
-									}
+									trial_err += color_distance(true, src_pixels.get_ptr()[p], trial_colors[p], false);
+									if (trial_err > thresh_err)
+										break;
 								}
-								else
+							}
+							else
+							{
+								for (uint32_t p = 0; p < 16; p++)
 								{
-									for (uint32_t p = 0; p < 16; p++)
-									{
-										trial_err += color_distance(false, src_pixels.get_ptr()[p], trial_colors[p], false);
-										if (trial_err > thresh_err)
-											break;
-									}
+									trial_err += color_distance(false, src_pixels.get_ptr()[p], trial_colors[p], false);
+									if (trial_err > thresh_err)
+										break;
 								}
+							}
 
-								if (trial_err <= thresh_err)
+							if (trial_err <= thresh_err)
+							{
+								if ((trial_err < best_err) || ((trial_err == best_err) && (endpoint_pred < best_endpoint_pred)))
 								{
-									if ((trial_err < best_err) || ((trial_err == best_err) && (endpoint_pred < best_endpoint_pred)))
-									{
-										best_endpoint_pred = endpoint_pred;
-										best_err = trial_err;
-										best_endpoint_index = pred_endpoint_index;
-									}
+									best_endpoint_pred = endpoint_pred;
+									best_err = trial_err;
+									best_endpoint_index = pred_endpoint_index;
 								}
-							} // endpoint_pred
+							}
+						} // endpoint_pred
 
-							if (best_endpoint_pred != UINT32_MAX)
-							{
-								m.m_endpoint_index = best_endpoint_index;
-								m.m_endpoint_predictor = best_endpoint_pred;
+						if (best_endpoint_pred != UINT32_MAX)
+						{
+							m.m_endpoint_index = best_endpoint_index;
+							m.m_endpoint_predictor = best_endpoint_pred;
 
-								total_endpoint_pred_hits++;
-								total_block_endpoints_remapped++;
-							}
-							else
-							{
-								total_endpoint_pred_missed++;
-							}
+							state.m_total_endpoint_pred_hits++;
+							state.m_total_block_endpoints_remapped++;
+						}
+						else
+						{
+							state.m_total_endpoint_pred_missed++;
 						}
 					}
-					else
-					{
-						total_endpoint_pred_missed++;
-					}
+				}
+				else
+				{
+					state.m_total_endpoint_pred_missed++;
+				}
 
-					if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
-					{
-						all_endpoint_indices.push_back(m.m_endpoint_index);
-					}
+				if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
+				{
+					state.m_endpoint_indices.push_back(m.m_endpoint_index);
+				}
 
-				} // block_x
+			} // block_x
 
-			} // block_y
+		} // block_y
+	}
 
-		} // slice
+	void basisu_backend::create_encoder_blocks()
+	{
+		debug_printf("basisu_backend::create_encoder_blocks\n");
+
+		BASISU_TRACE_ZONE("basisu_backend::create_encoder_blocks");
+
+		interval_timer tm;
+		tm.start();
+
+		basisu_frontend& r = *m_pFront_end;
+		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
+
+		m_slice_encoder_blocks.resize(m_slices.size());
+
+		// Video CR prediction reads (and marks) the previous frame's blocks, so video frames are processed in order within each GOP.
+		// GOPs are independent, so with periodic I-frames each job gets a run of whole GOPs. (This is the only pass that was serial for video,
+		// it's a small fraction of the total encode time.)
+		const uint32_t num_jobs = is_video ? maximum(1U, minimum(get_total_slice_jobs(true), get_total_video_gops())) : get_total_slice_jobs(true);
+		basisu::vector<encoder_blocks_state> job_states(num_jobs);
+
+		run_slice_jobs(num_jobs, [this, &job_states](uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index) {
+			for (uint32_t slice_index = first_slice_index; slice_index < last_slice_index; slice_index++)
+			{
+				create_slice_encoder_blocks(slice_index, job_states[job_index]);
+
+				if (!update_progress(1))
+					return;
+			}
+			}, is_video);
+
+		if (is_stopped())
+			return;
+
+		uint32_t total_endpoint_pred_missed = 0, total_endpoint_pred_hits = 0, total_block_endpoints_remapped = 0;
+
+		uint_vec all_endpoint_indices;
+		all_endpoint_indices.reserve(get_total_blocks());
+
+		for (uint32_t job_index = 0; job_index < num_jobs; job_index++)
+		{
+			const encoder_blocks_state& state = job_states[job_index];
+
+			total_endpoint_pred_missed += state.m_total_endpoint_pred_missed;
+			total_endpoint_pred_hits += state.m_total_endpoint_pred_hits;
+			total_block_endpoints_remapped += state.m_total_block_endpoints_remapped;
+
+			all_endpoint_indices.append(state.m_endpoint_indices);
+		}
 
 		debug_printf("total_endpoint_pred_missed: %u (%3.2f%%) total_endpoint_pred_hit: %u (%3.2f%%), total_block_endpoints_remapped: %u (%3.2f%%)\n",
 			total_endpoint_pred_missed, total_endpoint_pred_missed * 100.0f / get_total_blocks(),
@@ -616,651 +729,735 @@ namespace basisu
 		debug_printf("Elapsed time: %3.3f secs\n", tm.get_elapsed_secs());
 	}
 
-	void basisu_backend::compute_slice_crcs()
+	void basisu_backend::compute_slice_crc(uint32_t slice_index)
 	{
-		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
-		{
-			//const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
-			const uint32_t width = m_slices[slice_index].m_width;
-			const uint32_t height = m_slices[slice_index].m_height;
-			const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
-			const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
+		//const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
+		const uint32_t width = m_slices[slice_index].m_width;
+		const uint32_t height = m_slices[slice_index].m_height;
+		const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
+		const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
 
-			gpu_image gi;
-			gi.init(texture_format::cETC1, width, height);
+		gpu_image gi;
+		gi.init(texture_format::cETC1, width, height);
 
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		{
+			for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
 			{
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-				{
-					//const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
+				//const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
 
-					encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
+				encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
 
-					{
-						etc_block& output_block = *(etc_block*)gi.get_block_ptr(block_x, block_y);
+				{
+					etc_block& output_block = *(etc_block*)gi.get_block_ptr(block_x, block_y);
 
-						output_block.set_diff_bit(true);
-						// Setting the flip bit to false to be compatible with the Khronos KDFS.
-						//output_block.set_flip_bit(true);
-						output_block.set_flip_bit(false);
+					output_block.set_diff_bit(true);
+					// Setting the flip bit to false to be compatible with the Khronos KDFS.
+					//output_block.set_flip_bit(true);
+					output_block.set_flip_bit(false);
 
-						const uint32_t endpoint_index = m.m_endpoint_index;
+					const uint32_t endpoint_index = m.m_endpoint_index;
 
-						output_block.set_block_color5_etc1s(m_endpoint_palette[endpoint_index].m_color5);
-						output_block.set_inten_tables_etc1s(m_endpoint_palette[endpoint_index].m_inten5);
+					output_block.set_block_color5_etc1s(m_endpoint_palette[endpoint_index].m_color5);
+					output_block.set_inten_tables_etc1s(m_endpoint_palette[endpoint_index].m_inten5);
 
-						const uint32_t selector_idx = m.m_selector_index;
+					const uint32_t selector_idx = m.m_selector_index;
 
-						const etc1_selector_palette_entry& selectors = m_selector_palette[selector_idx];
-						for (uint32_t sy = 0; sy < 4; sy++)
-							for (uint32_t sx = 0; sx < 4; sx++)
-								output_block.set_selector(sx, sy, selectors(sx, sy));
-					}
+					const etc1_selector_palette_entry& selectors = m_selector_palette[selector_idx];
+					for (uint32_t sy = 0; sy < 4; sy++)
+						for (uint32_t sx = 0; sx < 4; sx++)
+							output_block.set_selector(sx, sy, selectors(sx, sy));
+				}
 
-				} // block_x
-			} // block_y
+			} // block_x
+		} // block_y
 
-			m_output.m_slice_image_crcs[slice_index] = basist::crc16(gi.get_ptr(), gi.get_size_in_bytes(), 0);
+		m_output.m_slice_image_crcs[slice_index] = basist::crc16(gi.get_ptr(), gi.get_size_in_bytes(), 0);
 
-			if (m_params.m_debug_images)
-			{
-				image gi_unpacked;
-				gi.unpack(gi_unpacked, false);
+		if (m_params.m_debug_images)
+		{
+			image gi_unpacked;
+			gi.unpack(gi_unpacked, false);
 
-				char buf[256];
+			char buf[256];
 #ifdef _WIN32				
-				sprintf_s(buf, sizeof(buf), "basisu_backend_slice_%u.png", slice_index);
+			sprintf_s(buf, sizeof(buf), "basisu_backend_slice_%u.png", slice_index);
 #else
-				snprintf(buf, sizeof(buf), "basisu_backend_slice_%u.png", slice_index);
+			snprintf(buf, sizeof(buf), "basisu_backend_slice_%u.png", slice_index);
 #endif				
-				save_png(buf, gi_unpacked);
-			}
+			save_png(buf, gi_unpacked);
+		}
+	}
 
-		} // slice_index
+	void basisu_backend::compute_slice_crcs()
+	{
+		run_slice_jobs(get_total_slice_jobs(true), [this](uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index) {
+			BASISU_NOTE_UNUSED(job_index);
+
+			for (uint32_t slice_index = first_slice_index; slice_index < last_slice_index; slice_index++)
+				compute_slice_crc(slice_index);
+			});
 	}
 
 	//uint32_t g_color_delta_hist[255 * 3 + 1];
 	//uint32_t g_color_delta_bad_hist[255 * 3 + 1];
 		
-	// TODO: Split this into multiple methods.
-	bool basisu_backend::encode_image()
+	void basisu_backend::encode_image_state::init(uint32_t total_endpoint_clusters, uint32_t total_selector_clusters)
 	{
-		basisu_frontend& r = *m_pFront_end;
-		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
-
-		uint32_t total_used_selector_history_buf = 0;
-		uint32_t total_selector_indices_remapped = 0;
+		m_selector_history_buf_histogram.init(basist::MAX_SELECTOR_HISTORY_BUF_SIZE);
+		m_selector_histogram.init(total_selector_clusters + basist::MAX_SELECTOR_HISTORY_BUF_SIZE + 1);
+		m_selector_history_buf_rle_histogram.init(1 << basist::SELECTOR_HISTORY_BUF_RLE_COUNT_BITS);
+		m_delta_endpoint_histogram.init(total_endpoint_clusters);
+		m_endpoint_pred_histogram.init(basist::ENDPOINT_PRED_TOTAL_SYMBOLS);
+
+		m_block_endpoint_indices.resize(0);
+		m_block_selector_indices.resize(0);
+
+		m_total_used_selector_history_buf = 0;
+		m_total_selector_indices_remapped = 0;
+		m_total_endpoint_indices_remapped = 0;
+	}
 
-		basist::approx_move_to_front selector_history_buf(basist::MAX_SELECTOR_HISTORY_BUF_SIZE);
-		histogram selector_history_buf_histogram(basist::MAX_SELECTOR_HISTORY_BUF_SIZE);
-		histogram selector_histogram(r.get_total_selector_clusters() + basist::MAX_SELECTOR_HISTORY_BUF_SIZE + 1);
-		histogram selector_history_buf_rle_histogram(1 << basist::SELECTOR_HISTORY_BUF_RLE_COUNT_BITS);
+	// The histograms are plain counts so their merge order doesn't matter, but the block indices must be merged in slice order.
+	void basisu_backend::encode_image_state::merge(const encode_image_state& other)
+	{
+		m_selector_history_buf_histogram.add(other.m_selector_history_buf_histogram);
+		m_selector_histogram.add(other.m_selector_histogram);
+		m_selector_history_buf_rle_histogram.add(other.m_selector_history_buf_rle_histogram);
+		m_delta_endpoint_histogram.add(other.m_delta_endpoint_histogram);
+		m_endpoint_pred_histogram.add(other.m_endpoint_pred_histogram);
+
+		m_block_endpoint_indices.append(other.m_block_endpoint_indices);
+		m_block_selector_indices.append(other.m_block_selector_indices);
+
+		m_total_used_selector_history_buf += other.m_total_used_selector_history_buf;
+		m_total_selector_indices_remapped += other.m_total_selector_indices_remapped;
+		m_total_endpoint_indices_remapped += other.m_total_endpoint_indices_remapped;
+	}
 
-		basisu::vector<uint_vec> selector_syms(m_slices.size());
+	// First pass over a slice: endpoint/selector RDO, then gathers the slice's symbols. Only touches the slice's own blocks
+	// (CR targets and blocks predicted from the previous frame are never changed here), so slices can be processed in parallel.
+	void basisu_backend::encode_slice_symbols(uint32_t slice_index, encode_image_state& state, uint_vec& endpoint_pred_syms, uint_vec& selector_syms)
+	{
+		basisu_frontend& r = *m_pFront_end;
+		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
 
 		const uint32_t SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX = r.get_total_selector_clusters();
 		const uint32_t SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + basist::MAX_SELECTOR_HISTORY_BUF_SIZE;
 
-		m_output.m_slice_image_crcs.resize(m_slices.size());
-
-		histogram delta_endpoint_histogram(r.get_total_endpoint_clusters());
-
-		histogram endpoint_pred_histogram(basist::ENDPOINT_PRED_TOTAL_SYMBOLS);
-		basisu::vector<uint_vec> endpoint_pred_syms(m_slices.size());
-
-		uint32_t total_endpoint_indices_remapped = 0;
-
-		uint_vec block_endpoint_indices, block_selector_indices;
-
-		interval_timer tm;
-		tm.start();
-
 		const int COLOR_DELTA_THRESH = 8;
 		const int SEL_DIFF_THRESHOLD = 11;
-		
-		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
-		{
-			//const int prev_frame_slice_index = is_video ? find_video_frame(slice_index, -1) : -1;
-			//const int next_frame_slice_index = is_video ? find_video_frame(slice_index, 1) : -1;
-			const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
-			//const uint32_t width = m_slices[slice_index].m_width;
-			//const uint32_t height = m_slices[slice_index].m_height;
-			const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
-			const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
 
-			selector_history_buf.reset();
+		basist::approx_move_to_front selector_history_buf(basist::MAX_SELECTOR_HISTORY_BUF_SIZE);
 
-			int selector_history_buf_rle_count = 0;
+		//const int prev_frame_slice_index = is_video ? find_video_frame(slice_index, -1) : -1;
+		//const int next_frame_slice_index = is_video ? find_video_frame(slice_index, 1) : -1;
+		const uint32_t first_block_index = m_slices[slice_index].m_first_block_index;
+		//const uint32_t width = m_slices[slice_index].m_width;
+		//const uint32_t height = m_slices[slice_index].m_height;
+		const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
+		const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
 
-			int prev_endpoint_pred_sym_bits = -1, endpoint_pred_repeat_count = 0;
+		int selector_history_buf_rle_count = 0;
 
-			uint32_t prev_endpoint_index = 0;
+		int prev_endpoint_pred_sym_bits = -1, endpoint_pred_repeat_count = 0;
 
-			vector2D<uint8_t> block_endpoints_are_referenced(num_blocks_x, num_blocks_y);
+		uint32_t prev_endpoint_index = 0;
 
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		vector2D<uint8_t> block_endpoints_are_referenced(num_blocks_x, num_blocks_y);
+
+		for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		{
+			for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
 			{
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-				{
-					//const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
+				//const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
 
-					encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
+				encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
 
-					if (m.m_endpoint_predictor == 0)
-						block_endpoints_are_referenced(block_x - 1, block_y) = true;
-					else if (m.m_endpoint_predictor == 1)
-						block_endpoints_are_referenced(block_x, block_y - 1) = true;
-					else if (m.m_endpoint_predictor == 2)
-					{
-						if (!is_video)
-							block_endpoints_are_referenced(block_x - 1, block_y - 1) = true;
-					}
-					if (is_video)
-					{
-						if (m.m_is_cr_target)
-							block_endpoints_are_referenced(block_x, block_y) = true;
-					}
+				if (m.m_endpoint_predictor == 0)
+					block_endpoints_are_referenced(block_x - 1, block_y) = true;
+				else if (m.m_endpoint_predictor == 1)
+					block_endpoints_are_referenced(block_x, block_y - 1) = true;
+				else if (m.m_endpoint_predictor == 2)
+				{
+					if (!is_video)
+						block_endpoints_are_referenced(block_x - 1, block_y - 1) = true;
+				}
+				if (is_video)
+				{
+					if (m.m_is_cr_target)
+						block_endpoints_are_referenced(block_x, block_y) = true;
+				}
 
-				}  // block_x
-			} // block_y
-						
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+			}  // block_x
+		} // block_y
+					
+		for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		{
+			for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
 			{
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-				{
-					const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
+				const uint32_t block_index = first_block_index + block_x + block_y * num_blocks_x;
 
-					encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
+				encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
 
-					if (((block_x & 1) == 0) && ((block_y & 1) == 0))
-					{
-						uint32_t endpoint_pred_cur_sym_bits = 0;
+				if (((block_x & 1) == 0) && ((block_y & 1) == 0))
+				{
+					uint32_t endpoint_pred_cur_sym_bits = 0;
 
-						for (uint32_t y = 0; y < 2; y++)
+					for (uint32_t y = 0; y < 2; y++)
+					{
+						for (uint32_t x = 0; x < 2; x++)
 						{
-							for (uint32_t x = 0; x < 2; x++)
-							{
-								const uint32_t bx = block_x + x;
-								const uint32_t by = block_y + y;
+							const uint32_t bx = block_x + x;
+							const uint32_t by = block_y + y;
 
-								uint32_t pred = basist::NO_ENDPOINT_PRED_INDEX;
-								if ((bx < num_blocks_x) && (by < num_blocks_y))
-									pred = m_slice_encoder_blocks[slice_index](bx, by).m_endpoint_predictor;
+							uint32_t pred = basist::NO_ENDPOINT_PRED_INDEX;
+							if ((bx < num_blocks_x) && (by < num_blocks_y))
+								pred = m_slice_encoder_blocks[slice_index](bx, by).m_endpoint_predictor;
 
-								endpoint_pred_cur_sym_bits |= (pred << (x * 2 + y * 4));
-							}
+							endpoint_pred_cur_sym_bits |= (pred << (x * 2 + y * 4));
 						}
+					}
 
-						if ((int)endpoint_pred_cur_sym_bits == prev_endpoint_pred_sym_bits)
-						{
-							endpoint_pred_repeat_count++;
-						}
-						else
+					if ((int)endpoint_pred_cur_sym_bits == prev_endpoint_pred_sym_bits)
+					{
+						endpoint_pred_repeat_count++;
+					}
+					else
+					{
+						if (endpoint_pred_repeat_count > 0)
 						{
-							if (endpoint_pred_repeat_count > 0)
+							if (endpoint_pred_repeat_count > (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT)
 							{
-								if (endpoint_pred_repeat_count > (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT)
-								{
-									endpoint_pred_histogram.inc(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
-									endpoint_pred_syms[slice_index].push_back(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
+								state.m_endpoint_pred_histogram.inc(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
+								endpoint_pred_syms.push_back(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
 
-									endpoint_pred_syms[slice_index].push_back(endpoint_pred_repeat_count);
-								}
-								else
+								endpoint_pred_syms.push_back(endpoint_pred_repeat_count);
+							}
+							else
+							{
+								for (int j = 0; j < endpoint_pred_repeat_count; j++)
 								{
-									for (int j = 0; j < endpoint_pred_repeat_count; j++)
-									{
-										endpoint_pred_histogram.inc(prev_endpoint_pred_sym_bits);
-										endpoint_pred_syms[slice_index].push_back(prev_endpoint_pred_sym_bits);
-									}
+									state.m_endpoint_pred_histogram.inc(prev_endpoint_pred_sym_bits);
+									endpoint_pred_syms.push_back(prev_endpoint_pred_sym_bits);
 								}
-
-								endpoint_pred_repeat_count = 0;
 							}
 
-							endpoint_pred_histogram.inc(endpoint_pred_cur_sym_bits);
-							endpoint_pred_syms[slice_index].push_back(endpoint_pred_cur_sym_bits);
-
-							prev_endpoint_pred_sym_bits = endpoint_pred_cur_sym_bits;
+							endpoint_pred_repeat_count = 0;
 						}
+
+						state.m_endpoint_pred_histogram.inc(endpoint_pred_cur_sym_bits);
+						endpoint_pred_syms.push_back(endpoint_pred_cur_sym_bits);
+
+						prev_endpoint_pred_sym_bits = endpoint_pred_cur_sym_bits;
 					}
+				}
 
-					int new_endpoint_index = m_endpoint_remap_table_old_to_new[m.m_endpoint_index];
+				int new_endpoint_index = m_endpoint_remap_table_old_to_new[m.m_endpoint_index];
 
-					if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
+				if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
+				{
+					int endpoint_delta = new_endpoint_index - prev_endpoint_index;
+
+					if ((m_params.m_endpoint_rdo_quality_thresh > 1.0f) && (iabs(endpoint_delta) > 1) && (!block_endpoints_are_referenced(block_x, block_y)))
 					{
-						int endpoint_delta = new_endpoint_index - prev_endpoint_index;
+						const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
 
-						if ((m_params.m_endpoint_rdo_quality_thresh > 1.0f) && (iabs(endpoint_delta) > 1) && (!block_endpoints_are_referenced(block_x, block_y)))
-						{
-							const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
+						etc_block etc_blk(r.get_output_block(block_index));
 
-							etc_block etc_blk(r.get_output_block(block_index));
+						const uint64_t cur_err = etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
+						const uint32_t cur_inten5 = etc_blk.get_inten_table(0);
 
-							const uint64_t cur_err = etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
-							const uint32_t cur_inten5 = etc_blk.get_inten_table(0);
+						const etc1_endpoint_palette_entry& cur_endpoints = m_endpoint_palette[m.m_endpoint_index];
+													
+						if (cur_err)
+						{
+							const float endpoint_remap_thresh = maximum(1.0f, m_params.m_endpoint_rdo_quality_thresh);
+							const uint64_t thresh_err = (uint64_t)(cur_err * endpoint_remap_thresh);
 
-							const etc1_endpoint_palette_entry& cur_endpoints = m_endpoint_palette[m.m_endpoint_index];
-														
-							if (cur_err)
+							//const int MAX_ENDPOINT_SEARCH_DIST = (m_params.m_compression_level >= 2) ? 64 : 32;
+							const int MAX_ENDPOINT_SEARCH_DIST = (m_params.m_compression_level >= 2) ? 64 : 16;
+
+							if (!g_cpu_supports_sse41)
 							{
-								const float endpoint_remap_thresh = maximum(1.0f, m_params.m_endpoint_rdo_quality_thresh);
-								const uint64_t thresh_err = (uint64_t)(cur_err * endpoint_remap_thresh);
+								const uint64_t initial_best_trial_err = UINT64_MAX;
+								uint64_t best_trial_err = initial_best_trial_err;
+								int best_trial_idx = 0;
+
+								etc_block trial_etc_blk(etc_blk);
+																	
+								const int search_dist = minimum<int>(iabs(endpoint_delta) - 1, MAX_ENDPOINT_SEARCH_DIST);
+								for (int d = -search_dist; d < search_dist; d++)
+								{
+									int trial_idx = prev_endpoint_index + d;
+									if (trial_idx < 0)
+										trial_idx += (int)r.get_total_endpoint_clusters();
+									else if (trial_idx >= (int)r.get_total_endpoint_clusters())
+										trial_idx -= (int)r.get_total_endpoint_clusters();
 
-								//const int MAX_ENDPOINT_SEARCH_DIST = (m_params.m_compression_level >= 2) ? 64 : 32;
-								const int MAX_ENDPOINT_SEARCH_DIST = (m_params.m_compression_level >= 2) ? 64 : 16;
+									if (trial_idx == new_endpoint_index)
+										continue;
 
-								if (!g_cpu_supports_sse41)
-								{
-									const uint64_t initial_best_trial_err = UINT64_MAX;
-									uint64_t best_trial_err = initial_best_trial_err;
-									int best_trial_idx = 0;
-
-									etc_block trial_etc_blk(etc_blk);
-																		
-									const int search_dist = minimum<int>(iabs(endpoint_delta) - 1, MAX_ENDPOINT_SEARCH_DIST);
-									for (int d = -search_dist; d < search_dist; d++)
-									{
-										int trial_idx = prev_endpoint_index + d;
-										if (trial_idx < 0)
-											trial_idx += (int)r.get_total_endpoint_clusters();
-										else if (trial_idx >= (int)r.get_total_endpoint_clusters())
-											trial_idx -= (int)r.get_total_endpoint_clusters();
+									// Skip it if this new endpoint palette entry is actually never used.
+									if (!m_new_endpoint_was_used[trial_idx])
+										continue;
 
-										if (trial_idx == new_endpoint_index)
+									const etc1_endpoint_palette_entry& p = m_endpoint_palette[m_endpoint_remap_table_new_to_old[trial_idx]];
+																			
+									if (m_params.m_compression_level <= 1)
+									{
+										if (p.m_inten5 > cur_inten5)
 											continue;
 
-										// Skip it if this new endpoint palette entry is actually never used.
-										if (!m_new_endpoint_was_used[trial_idx])
+										int delta_r = iabs(cur_endpoints.m_color5.r - p.m_color5.r);
+										int delta_g = iabs(cur_endpoints.m_color5.g - p.m_color5.g);
+										int delta_b = iabs(cur_endpoints.m_color5.b - p.m_color5.b);
+										int color_delta = delta_r + delta_g + delta_b;
+																					
+										if (color_delta > COLOR_DELTA_THRESH)
 											continue;
-
-										const etc1_endpoint_palette_entry& p = m_endpoint_palette[m_endpoint_remap_table_new_to_old[trial_idx]];
-																				
-										if (m_params.m_compression_level <= 1)
-										{
-											if (p.m_inten5 > cur_inten5)
-												continue;
-
-											int delta_r = iabs(cur_endpoints.m_color5.r - p.m_color5.r);
-											int delta_g = iabs(cur_endpoints.m_color5.g - p.m_color5.g);
-											int delta_b = iabs(cur_endpoints.m_color5.b - p.m_color5.b);
-											int color_delta = delta_r + delta_g + delta_b;
-																						
-											if (color_delta > COLOR_DELTA_THRESH)
-												continue;
-										}
-
-										trial_etc_blk.set_block_color5_etc1s(p.m_color5);
-										trial_etc_blk.set_inten_tables_etc1s(p.m_inten5);
-
-										uint64_t trial_err = trial_etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
-
-										if ((trial_err < best_trial_err) && (trial_err <= thresh_err))
-										{
-											best_trial_err = trial_err;
-											best_trial_idx = trial_idx;
-										}
 									}
 
-									if (best_trial_err != initial_best_trial_err)
-									{
-										m.m_endpoint_index = m_endpoint_remap_table_new_to_old[best_trial_idx];
-
-										new_endpoint_index = best_trial_idx;
+									trial_etc_blk.set_block_color5_etc1s(p.m_color5);
+									trial_etc_blk.set_inten_tables_etc1s(p.m_inten5);
 
-										endpoint_delta = new_endpoint_index - prev_endpoint_index;
+									uint64_t trial_err = trial_etc_blk.evaluate_etc1_error(src_pixels.get_ptr(), r.get_params().m_perceptual);
 
-										total_endpoint_indices_remapped++;
+									if ((trial_err < best_trial_err) && (trial_err <= thresh_err))
+									{
+										best_trial_err = trial_err;
+										best_trial_idx = trial_idx;
 									}
 								}
-								else
+
+								if (best_trial_err != initial_best_trial_err)
 								{
+									m.m_endpoint_index = m_endpoint_remap_table_new_to_old[best_trial_idx];
+
+									new_endpoint_index = best_trial_idx;
+
+									endpoint_delta = new_endpoint_index - prev_endpoint_index;
+
+									state.m_total_endpoint_indices_remapped++;
+								}
+							}
+							else
+							{
 #if BASISU_SUPPORT_SSE
-									uint8_t block_selectors[16];
-									for (uint32_t i = 0; i < 16; i++)
-										block_selectors[i] = (uint8_t)etc_blk.get_selector(i & 3, i >> 2);
-
-									const int64_t initial_best_trial_err = INT64_MAX;
-									int64_t best_trial_err = initial_best_trial_err;
-									int best_trial_idx = 0;
-																																				
-									const int search_dist = minimum<int>(iabs(endpoint_delta) - 1, MAX_ENDPOINT_SEARCH_DIST);
-									for (int d = -search_dist; d < search_dist; d++)
-									{
-										int trial_idx = prev_endpoint_index + d;
-										if (trial_idx < 0)
-											trial_idx += (int)r.get_total_endpoint_clusters();
-										else if (trial_idx >= (int)r.get_total_endpoint_clusters())
-											trial_idx -= (int)r.get_total_endpoint_clusters();
+								uint8_t block_selectors[16];
+								for (uint32_t i = 0; i < 16; i++)
+									block_selectors[i] = (uint8_t)etc_blk.get_selector(i & 3, i >> 2);
+
+								const int64_t initial_best_trial_err = INT64_MAX;
+								int64_t best_trial_err = initial_best_trial_err;
+								int best_trial_idx = 0;
+																																			
+								const int search_dist = minimum<int>(iabs(endpoint_delta) - 1, MAX_ENDPOINT_SEARCH_DIST);
+								for (int d = -search_dist; d < search_dist; d++)
+								{
+									int trial_idx = prev_endpoint_index + d;
+									if (trial_idx < 0)
+										trial_idx += (int)r.get_total_endpoint_clusters();
+									else if (trial_idx >= (int)r.get_total_endpoint_clusters())
+										trial_idx -= (int)r.get_total_endpoint_clusters();
 
-										if (trial_idx == new_endpoint_index)
-											continue;
+									if (trial_idx == new_endpoint_index)
+										continue;
 
-										// Skip it if this new endpoint palette entry is actually never used.
-										if (!m_new_endpoint_was_used[trial_idx])
+									// Skip it if this new endpoint palette entry is actually never used.
+									if (!m_new_endpoint_was_used[trial_idx])
+										continue;
+
+									const etc1_endpoint_palette_entry& p = m_endpoint_palette[m_endpoint_remap_table_new_to_old[trial_idx]];
+																			
+									if (m_params.m_compression_level <= 1)
+									{
+										if (p.m_inten5 > cur_inten5)
 											continue;
 
-										const etc1_endpoint_palette_entry& p = m_endpoint_palette[m_endpoint_remap_table_new_to_old[trial_idx]];
-																				
-										if (m_params.m_compression_level <= 1)
-										{
-											if (p.m_inten5 > cur_inten5)
-												continue;
-
-											int delta_r = iabs(cur_endpoints.m_color5.r - p.m_color5.r);
-											int delta_g = iabs(cur_endpoints.m_color5.g - p.m_color5.g);
-											int delta_b = iabs(cur_endpoints.m_color5.b - p.m_color5.b);
-											int color_delta = delta_r + delta_g + delta_b;
-											
-											if (color_delta > COLOR_DELTA_THRESH)
-												continue;
-										}
+										int delta_r = iabs(cur_endpoints.m_color5.r - p.m_color5.r);
+										int delta_g = iabs(cur_endpoints.m_color5.g - p.m_color5.g);
+										int delta_b = iabs(cur_endpoints.m_color5.b - p.m_color5.b);
+										int color_delta = delta_r + delta_g + delta_b;
+										
+										if (color_delta > COLOR_DELTA_THRESH)
+											continue;
+									}
 
-										color_rgba block_colors[4];
-										etc_block::get_block_colors_etc1s(block_colors, p.m_color5, p.m_inten5);
+									color_rgba block_colors[4];
+									etc_block::get_block_colors_etc1s(block_colors, p.m_color5, p.m_inten5);
 
-										int64_t trial_err;
-										if (r.get_params().m_perceptual)
-										{
+									int64_t trial_err;
+									if (r.get_params().m_perceptual)
+									{
+#if BASISU_SUPPORT_AVX2
+										if (g_cpu_supports_avx2)
+											perceptual_distance_rgb_4_N_avx2(&trial_err, block_selectors, block_colors, src_pixels.get_ptr(), 16, best_trial_err);
+										else
+#endif
 											perceptual_distance_rgb_4_N_sse41(&trial_err, block_selectors, block_colors, src_pixels.get_ptr(), 16, best_trial_err);
-										}
+									}
+									else
+									{
+#if BASISU_SUPPORT_AVX2
+										if (g_cpu_supports_avx2)
+											linear_distance_rgb_4_N_avx2(&trial_err, block_selectors, block_colors, src_pixels.get_ptr(), 16, best_trial_err);
 										else
-										{
+#endif
 											linear_distance_rgb_4_N_sse41(&trial_err, block_selectors, block_colors, src_pixels.get_ptr(), 16, best_trial_err);
-										}
+									}
 
-										//if (trial_err > thresh_err)
-										//	g_color_delta_bad_hist[color_delta]++;
+									//if (trial_err > thresh_err)
+									//	g_color_delta_bad_hist[color_delta]++;
 
-										if ((trial_err < best_trial_err) && (trial_err <= (int64_t)thresh_err))
-										{
-											best_trial_err = trial_err;
-											best_trial_idx = trial_idx;
-										}
+									if ((trial_err < best_trial_err) && (trial_err <= (int64_t)thresh_err))
+									{
+										best_trial_err = trial_err;
+										best_trial_idx = trial_idx;
 									}
+								}
 
-									if (best_trial_err != initial_best_trial_err)
-									{
-										m.m_endpoint_index = m_endpoint_remap_table_new_to_old[best_trial_idx];
+								if (best_trial_err != initial_best_trial_err)
+								{
+									m.m_endpoint_index = m_endpoint_remap_table_new_to_old[best_trial_idx];
 
-										new_endpoint_index = best_trial_idx;
+									new_endpoint_index = best_trial_idx;
 
-										endpoint_delta = new_endpoint_index - prev_endpoint_index;
+									endpoint_delta = new_endpoint_index - prev_endpoint_index;
 
-										total_endpoint_indices_remapped++;
-									}
+									state.m_total_endpoint_indices_remapped++;
+								}
 #endif // BASISU_SUPPORT_SSE
-								} // if (!g_cpu_supports_sse41)
-															
-							} // if (cur_err)
+							} // if (!g_cpu_supports_sse41)
+														
+						} // if (cur_err)
 
-						} // if ((m_params.m_endpoint_rdo_quality_thresh > 1.0f) && (iabs(endpoint_delta) > 1) && (!block_endpoints_are_referenced(block_x, block_y)))
+					} // if ((m_params.m_endpoint_rdo_quality_thresh > 1.0f) && (iabs(endpoint_delta) > 1) && (!block_endpoints_are_referenced(block_x, block_y)))
 
-						if (endpoint_delta < 0)
-							endpoint_delta += (int)r.get_total_endpoint_clusters();
+					if (endpoint_delta < 0)
+						endpoint_delta += (int)r.get_total_endpoint_clusters();
 
-						delta_endpoint_histogram.inc(endpoint_delta);
+					state.m_delta_endpoint_histogram.inc(endpoint_delta);
 
-					} // if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
+				} // if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
 
-					block_endpoint_indices.push_back(m_endpoint_remap_table_new_to_old[new_endpoint_index]);
+				state.m_block_endpoint_indices.push_back(m_endpoint_remap_table_new_to_old[new_endpoint_index]);
 
-					prev_endpoint_index = new_endpoint_index;
+				prev_endpoint_index = new_endpoint_index;
 
-					if ((!is_video) || (m.m_endpoint_predictor != basist::CR_ENDPOINT_PRED_INDEX))
-					{
-						int new_selector_index = m_selector_remap_table_old_to_new[m.m_selector_index];
-												
-						const float selector_remap_thresh = maximum(1.0f, m_params.m_selector_rdo_quality_thresh); //2.5f;
+				if ((!is_video) || (m.m_endpoint_predictor != basist::CR_ENDPOINT_PRED_INDEX))
+				{
+					int new_selector_index = m_selector_remap_table_old_to_new[m.m_selector_index];
+											
+					const float selector_remap_thresh = maximum(1.0f, m_params.m_selector_rdo_quality_thresh); //2.5f;
 
-						int selector_history_buf_index = -1;
+					int selector_history_buf_index = -1;
 
-						// At low comp levels this hurts compression a tiny amount, but is significantly faster so it's a good tradeoff.
-						if ((m.m_is_cr_target) || (m_params.m_compression_level <= 1))
+					// At low comp levels this hurts compression a tiny amount, but is significantly faster so it's a good tradeoff.
+					if ((m.m_is_cr_target) || (m_params.m_compression_level <= 1))
+					{
+						for (uint32_t j = 0; j < selector_history_buf.size(); j++)
 						{
-							for (uint32_t j = 0; j < selector_history_buf.size(); j++)
+							const int trial_idx = selector_history_buf[j];
+							if (trial_idx == new_selector_index)
 							{
-								const int trial_idx = selector_history_buf[j];
-								if (trial_idx == new_selector_index)
-								{
-									total_used_selector_history_buf++;
-									selector_history_buf_index = j;
-									selector_history_buf_histogram.inc(j);
-									break;
-								}
+								state.m_total_used_selector_history_buf++;
+								selector_history_buf_index = j;
+								state.m_selector_history_buf_histogram.inc(j);
+								break;
 							}
 						}
+					}
 
-						// If the block is a CR target we can't override its selectors.
-						if ((!m.m_is_cr_target) && (selector_history_buf_index == -1))
-						{
-							const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
+					// If the block is a CR target we can't override its selectors.
+					if ((!m.m_is_cr_target) && (selector_history_buf_index == -1))
+					{
+						const pixel_block& src_pixels = r.get_source_pixel_block(block_index);
 
-							etc_block etc_blk = r.get_output_block(block_index);
+						etc_block etc_blk = r.get_output_block(block_index);
 
-							// This is new code - the initial release just used the endpoints from the frontend, which isn't correct/accurate.
-							const etc1_endpoint_palette_entry& q = m_endpoint_palette[m_endpoint_remap_table_new_to_old[new_endpoint_index]];
-							etc_blk.set_block_color5_etc1s(q.m_color5);
-							etc_blk.set_inten_tables_etc1s(q.m_inten5);
+						// This is new code - the initial release just used the endpoints from the frontend, which isn't correct/accurate.
+						const etc1_endpoint_palette_entry& q = m_endpoint_palette[m_endpoint_remap_table_new_to_old[new_endpoint_index]];
+						etc_blk.set_block_color5_etc1s(q.m_color5);
+						etc_blk.set_inten_tables_etc1s(q.m_inten5);
 
-							color_rgba block_colors[4];
-							etc_blk.get_block_colors(block_colors, 0);
+						color_rgba block_colors[4];
+						etc_blk.get_block_colors(block_colors, 0);
 
-							const uint8_t* pCur_selectors = &m_selector_palette[m.m_selector_index][0];
+						const uint8_t* pCur_selectors = &m_selector_palette[m.m_selector_index][0];
 
-							uint64_t cur_err = 0;
-							if (r.get_params().m_perceptual)
-							{
-								for (uint32_t p = 0; p < 16; p++)
-									cur_err += color_distance(true, src_pixels.get_ptr()[p], block_colors[pCur_selectors[p]], false);
-							}
-							else
-							{
-								for (uint32_t p = 0; p < 16; p++)
-									cur_err += color_distance(false, src_pixels.get_ptr()[p], block_colors[pCur_selectors[p]], false);
-							}
-							
-							const uint64_t limit_err = (uint64_t)ceilf(cur_err * selector_remap_thresh);
+						uint64_t cur_err = 0;
+						if (r.get_params().m_perceptual)
+						{
+							for (uint32_t p = 0; p < 16; p++)
+								cur_err += color_distance(true, src_pixels.get_ptr()[p], block_colors[pCur_selectors[p]], false);
+						}
+						else
+						{
+							for (uint32_t p = 0; p < 16; p++)
+								cur_err += color_distance(false, src_pixels.get_ptr()[p], block_colors[pCur_selectors[p]], false);
+						}
+						
+						const uint64_t limit_err = (uint64_t)ceilf(cur_err * selector_remap_thresh);
 
-							// Even if cur_err==limit_err, we still want to scan the history buffer because there may be equivalent entries that are cheaper to code.
+						// Even if cur_err==limit_err, we still want to scan the history buffer because there may be equivalent entries that are cheaper to code.
 
-							uint64_t best_trial_err = UINT64_MAX;
-							int best_trial_idx = 0;
-							uint32_t best_trial_history_buf_idx = 0;
+						uint64_t best_trial_err = UINT64_MAX;
+						int best_trial_idx = 0;
+						uint32_t best_trial_history_buf_idx = 0;
 
-							for (uint32_t j = 0; j < selector_history_buf.size(); j++)
-							{
-								const int trial_idx = selector_history_buf[j];
+						for (uint32_t j = 0; j < selector_history_buf.size(); j++)
+						{
+							const int trial_idx = selector_history_buf[j];
 
-								const uint8_t* pSelectors = &m_selector_palette[m_selector_remap_table_new_to_old[trial_idx]][0];
+							const uint8_t* pSelectors = &m_selector_palette[m_selector_remap_table_new_to_old[trial_idx]][0];
 
-								if (m_params.m_compression_level <= 1)
+							if (m_params.m_compression_level <= 1)
+							{
+								// Predict if evaluating the full color error would cause an early out, by summing the abs err of the selector indices.
+								int sel_diff = 0;
+								for (uint32_t p = 0; p < 16; p += 4)
 								{
-									// Predict if evaluating the full color error would cause an early out, by summing the abs err of the selector indices.
-									int sel_diff = 0;
-									for (uint32_t p = 0; p < 16; p += 4)
-									{
-										sel_diff += iabs(pCur_selectors[p + 0] - pSelectors[p + 0]);
-										sel_diff += iabs(pCur_selectors[p + 1] - pSelectors[p + 1]);
-										sel_diff += iabs(pCur_selectors[p + 2] - pSelectors[p + 2]);
-										sel_diff += iabs(pCur_selectors[p + 3] - pSelectors[p + 3]);
-										if (sel_diff >= SEL_DIFF_THRESHOLD)
-											break;
-									}
+									sel_diff += iabs(pCur_selectors[p + 0] - pSelectors[p + 0]);
+									sel_diff += iabs(pCur_selectors[p + 1] - pSelectors[p + 1]);
+									sel_diff += iabs(pCur_selectors[p + 2] - pSelectors[p + 2]);
+									sel_diff += iabs(pCur_selectors[p + 3] - pSelectors[p + 3]);
 									if (sel_diff >= SEL_DIFF_THRESHOLD)
-										continue;
+										break;
 								}
-									
-								const uint64_t thresh_err = minimum(limit_err, best_trial_err);
-								uint64_t trial_err = 0;
+								if (sel_diff >= SEL_DIFF_THRESHOLD)
+									continue;
+							}
+								
+							const uint64_t thresh_err = minimum(limit_err, best_trial_err);
+							uint64_t trial_err = 0;
 
-								// This tends to early out quickly, so SSE has a hard time competing.
-								if (r.get_params().m_perceptual)
+							// This tends to early out quickly, so SSE has a hard time competing.
+							if (r.get_params().m_perceptual)
+							{
+								for (uint32_t p = 0; p < 16; p++)
 								{
-									for (uint32_t p = 0; p < 16; p++)
-									{
-										uint32_t sel = pSelectors[p];
-										trial_err += color_distance(true, src_pixels.get_ptr()[p], block_colors[sel], false);
-										if (trial_err > thresh_err)
-											break;
-									}
+									uint32_t sel = pSelectors[p];
+									trial_err += color_distance(true, src_pixels.get_ptr()[p], block_colors[sel], false);
+									if (trial_err > thresh_err)
+										break;
 								}
-								else
+							}
+							else
+							{
+								for (uint32_t p = 0; p < 16; p++)
 								{
-									for (uint32_t p = 0; p < 16; p++)
-									{
-										uint32_t sel = pSelectors[p];
-										trial_err += color_distance(false, src_pixels.get_ptr()[p], block_colors[sel], false);
-										if (trial_err > thresh_err)
-											break;
-									}
+									uint32_t sel = pSelectors[p];
+									trial_err += color_distance(false, src_pixels.get_ptr()[p], block_colors[sel], false);
+									if (trial_err > thresh_err)
+										break;
 								}
+							}
 
-								if ((trial_err < best_trial_err) && (trial_err <= thresh_err))
-								{
-									assert(trial_err <= limit_err);
+							if ((trial_err < best_trial_err) && (trial_err <= thresh_err))
+							{
+								assert(trial_err <= limit_err);
 
-									best_trial_err = trial_err;
-									best_trial_idx = trial_idx;
-									best_trial_history_buf_idx = j;
-								}
+								best_trial_err = trial_err;
+								best_trial_idx = trial_idx;
+								best_trial_history_buf_idx = j;
 							}
+						}
 
-							if (best_trial_err != UINT64_MAX)
-							{
-								if (new_selector_index != best_trial_idx)
-									total_selector_indices_remapped++;
+						if (best_trial_err != UINT64_MAX)
+						{
+							if (new_selector_index != best_trial_idx)
+								state.m_total_selector_indices_remapped++;
 
-								new_selector_index = best_trial_idx;
+							new_selector_index = best_trial_idx;
 
-								total_used_selector_history_buf++;
+							state.m_total_used_selector_history_buf++;
 
-								selector_history_buf_index = best_trial_history_buf_idx;
+							selector_history_buf_index = best_trial_history_buf_idx;
 
-								selector_history_buf_histogram.inc(best_trial_history_buf_idx);
-							}
+							state.m_selector_history_buf_histogram.inc(best_trial_history_buf_idx);
+						}
 
-						} // if (m_params.m_selector_rdo_quality_thresh > 0.0f)
+					} // if (m_params.m_selector_rdo_quality_thresh > 0.0f)
 
-						m.m_selector_index = m_selector_remap_table_new_to_old[new_selector_index];
+					m.m_selector_index = m_selector_remap_table_new_to_old[new_selector_index];
 
 
-						if ((selector_history_buf_rle_count) && (selector_history_buf_index != 0))
+					if ((selector_history_buf_rle_count) && (selector_history_buf_index != 0))
+					{
+						if (selector_history_buf_rle_count >= (int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH)
 						{
-							if (selector_history_buf_rle_count >= (int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH)
-							{
-								selector_syms[slice_index].push_back(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
-								selector_syms[slice_index].push_back(selector_history_buf_rle_count);
-
-								int run_sym = selector_history_buf_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
-								if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
-									selector_history_buf_rle_histogram.inc(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1);
-								else
-									selector_history_buf_rle_histogram.inc(run_sym);
+							selector_syms.push_back(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
+							selector_syms.push_back(selector_history_buf_rle_count);
 
-								selector_histogram.inc(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
-							}
+							int run_sym = selector_history_buf_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
+							if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
+								state.m_selector_history_buf_rle_histogram.inc(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1);
 							else
-							{
-								for (int k = 0; k < selector_history_buf_rle_count; k++)
-								{
-									uint32_t sym_index = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + 0;
+								state.m_selector_history_buf_rle_histogram.inc(run_sym);
 
-									selector_syms[slice_index].push_back(sym_index);
-
-									selector_histogram.inc(sym_index);
-								}
-							}
-
-							selector_history_buf_rle_count = 0;
+							state.m_selector_histogram.inc(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
 						}
-
-						if (selector_history_buf_index >= 0)
+						else
 						{
-							if (selector_history_buf_index == 0)
-								selector_history_buf_rle_count++;
-							else
+							for (int k = 0; k < selector_history_buf_rle_count; k++)
 							{
-								uint32_t history_buf_sym = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + selector_history_buf_index;
+								uint32_t sym_index = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + 0;
 
-								selector_syms[slice_index].push_back(history_buf_sym);
+								selector_syms.push_back(sym_index);
 
-								selector_histogram.inc(history_buf_sym);
+								state.m_selector_histogram.inc(sym_index);
 							}
 						}
+
+						selector_history_buf_rle_count = 0;
+					}
+
+					if (selector_history_buf_index >= 0)
+					{
+						if (selector_history_buf_index == 0)
+							selector_history_buf_rle_count++;
 						else
 						{
-							selector_syms[slice_index].push_back(new_selector_index);
+							uint32_t history_buf_sym = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + selector_history_buf_index;
 
-							selector_histogram.inc(new_selector_index);
-						}
+							selector_syms.push_back(history_buf_sym);
 
-						m.m_selector_history_buf_index = selector_history_buf_index;
+							state.m_selector_histogram.inc(history_buf_sym);
+						}
+					}
+					else
+					{
+						selector_syms.push_back(new_selector_index);
 
-						if (selector_history_buf_index < 0)
-							selector_history_buf.add(new_selector_index);
-						else if (selector_history_buf.size())
-							selector_history_buf.use(selector_history_buf_index);
+						state.m_selector_histogram.inc(new_selector_index);
 					}
-					block_selector_indices.push_back(m.m_selector_index);
 
-				} // block_x
+					m.m_selector_history_buf_index = selector_history_buf_index;
 
-			} // block_y
+					if (selector_history_buf_index < 0)
+						selector_history_buf.add(new_selector_index);
+					else if (selector_history_buf.size())
+						selector_history_buf.use(selector_history_buf_index);
+				}
+				state.m_block_selector_indices.push_back(m.m_selector_index);
+
+			} // block_x
 
-			if (endpoint_pred_repeat_count > 0)
+		} // block_y
+
+		if (endpoint_pred_repeat_count > 0)
+		{
+			if (endpoint_pred_repeat_count > (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT)
 			{
-				if (endpoint_pred_repeat_count > (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT)
-				{
-					endpoint_pred_histogram.inc(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
-					endpoint_pred_syms[slice_index].push_back(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
+				state.m_endpoint_pred_histogram.inc(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
+				endpoint_pred_syms.push_back(basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL);
 
-					endpoint_pred_syms[slice_index].push_back(endpoint_pred_repeat_count);
-				}
-				else
+				endpoint_pred_syms.push_back(endpoint_pred_repeat_count);
+			}
+			else
+			{
+				for (int j = 0; j < endpoint_pred_repeat_count; j++)
 				{
-					for (int j = 0; j < endpoint_pred_repeat_count; j++)
-					{
-						endpoint_pred_histogram.inc(prev_endpoint_pred_sym_bits);
-						endpoint_pred_syms[slice_index].push_back(prev_endpoint_pred_sym_bits);
-					}
+					state.m_endpoint_pred_histogram.inc(prev_endpoint_pred_sym_bits);
+					endpoint_pred_syms.push_back(prev_endpoint_pred_sym_bits);
 				}
-
-				endpoint_pred_repeat_count = 0;
 			}
 
-			if (selector_history_buf_rle_count)
-			{
-				if (selector_history_buf_rle_count >= (int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH)
-				{
-					selector_syms[slice_index].push_back(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
-					selector_syms[slice_index].push_back(selector_history_buf_rle_count);
+			endpoint_pred_repeat_count = 0;
+		}
 
-					int run_sym = selector_history_buf_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
-					if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
-						selector_history_buf_rle_histogram.inc(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1);
-					else
-						selector_history_buf_rle_histogram.inc(run_sym);
+		if (selector_history_buf_rle_count)
+		{
+			if (selector_history_buf_rle_count >= (int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH)
+			{
+				selector_syms.push_back(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
+				selector_syms.push_back(selector_history_buf_rle_count);
 
-					selector_histogram.inc(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
-				}
+				int run_sym = selector_history_buf_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
+				if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
+					state.m_selector_history_buf_rle_histogram.inc(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1);
 				else
+					state.m_selector_history_buf_rle_histogram.inc(run_sym);
+
+				state.m_selector_histogram.inc(SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX);
+			}
+			else
+			{
+				for (int i = 0; i < selector_history_buf_rle_count; i++)
 				{
-					for (int i = 0; i < selector_history_buf_rle_count; i++)
-					{
-						uint32_t sym_index = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + 0;
+					uint32_t sym_index = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + 0;
 
-						selector_syms[slice_index].push_back(sym_index);
+					selector_syms.push_back(sym_index);
 
-						selector_histogram.inc(sym_index);
-					}
+					state.m_selector_histogram.inc(sym_index);
 				}
+			}
+
+			selector_history_buf_rle_count = 0;
+		}
+	}
 
-				selector_history_buf_rle_count = 0;
+	// TODO: Split this into multiple methods.
+	bool basisu_backend::encode_image()
+	{
+		BASISU_TRACE_ZONE("basisu_backend::encode_image");
+
+		basisu_frontend& r = *m_pFront_end;
+		const bool is_video = r.get_params().m_tex_type == basist::cBASISTexTypeVideoFrames;
+
+		basisu::vector<uint_vec> selector_syms(m_slices.size());
+		basisu::vector<uint_vec> endpoint_pred_syms(m_slices.size());
+
+		const uint32_t SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX = r.get_total_selector_clusters();
+		const uint32_t SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX = SELECTOR_HISTORY_BUF_FIRST_SYMBOL_INDEX + basist::MAX_SELECTOR_HISTORY_BUF_SIZE;
+
+		m_output.m_slice_image_crcs.resize(m_slices.size());
+
+		interval_timer tm;
+		tm.start();
+
+		const uint32_t num_jobs = get_total_slice_jobs(true);
+		basisu::vector<encode_image_state> job_states(num_jobs);
+
+		run_slice_jobs(num_jobs, [this, &r, &job_states, &endpoint_pred_syms, &selector_syms](uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index) {
+			encode_image_state& state = job_states[job_index];
+			state.init(r.get_total_endpoint_clusters(), r.get_total_selector_clusters());
+
+			for (uint32_t slice_index = first_slice_index; slice_index < last_slice_index; slice_index++)
+			{
+				encode_slice_symbols(slice_index, state, endpoint_pred_syms[slice_index], selector_syms[slice_index]);
+
+				if (!update_progress(1))
+					return;
 			}
+			});
 
-		} // slice_index
+		if (is_stopped())
+			return false;
+
+		encode_image_state totals;
+		totals.init(r.get_total_endpoint_clusters(), r.get_total_selector_clusters());
+
+		totals.m_block_endpoint_indices.reserve(get_total_blocks());
+		totals.m_block_selector_indices.reserve(get_total_blocks());
+
+		for (uint32_t job_index = 0; job_index < num_jobs; job_index++)
+			totals.merge(job_states[job_index]);
+
+		job_states.clear();
+
+		const uint32_t total_used_selector_history_buf = totals.m_total_used_selector_history_buf;
+		const uint32_t total_selector_indices_remapped = totals.m_total_selector_indices_remapped;
+		const uint32_t total_endpoint_indices_remapped = totals.m_total_endpoint_indices_remapped;
+
+		histogram& selector_histogram = totals.m_selector_histogram;
+		histogram& selector_history_buf_rle_histogram = totals.m_selector_history_buf_rle_histogram;
+		histogram& delta_endpoint_histogram = totals.m_delta_endpoint_histogram;
+		histogram& endpoint_pred_histogram = totals.m_endpoint_pred_histogram;
+
+		uint_vec& block_endpoint_indices = totals.m_block_endpoint_indices;
+		uint_vec& block_selector_indices = totals.m_block_selector_indices;
 
 		//for (int i = 0; i <= 255 * 3; i++)
 		//{
@@ -1283,6 +1480,9 @@ namespace basisu
 			int_vec unused;
 			r.reoptimize_remapped_endpoints(block_endpoint_indices, unused, false, &block_selector_indices);
 
+			if (is_stopped())
+				return false;
+
 			create_endpoint_palette();
 		}
 
@@ -1358,118 +1558,133 @@ namespace basisu
 
 		m_output.m_slice_image_data.resize(m_slices.size());
 
-		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
-		{
-			//const uint32_t width = m_slices[slice_index].m_width;
-			//const uint32_t height = m_slices[slice_index].m_height;
-			const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
-			const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
-
-			coder.init(1024 * 1024 * 4);
-
-			uint32_t cur_selector_sym_ofs = 0;
-			uint32_t selector_rle_count = 0;
+		// Second pass: the models are fixed now, so each slice's bitstream can be written independently.
+		uint_vec slice_endpoint_pred_bits(m_slices.size()), slice_delta_endpoint_bits(m_slices.size()), slice_selector_bits(m_slices.size());
 
-			int endpoint_pred_repeat_count = 0;
-			uint32_t cur_endpoint_pred_sym_ofs = 0;
-//			uint32_t prev_endpoint_pred_sym = 0;
-			uint32_t prev_endpoint_index = 0;
+		run_slice_jobs(get_total_slice_jobs(true), [&](uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index) {
+			BASISU_NOTE_UNUSED(job_index);
 
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+			for (uint32_t slice_index = first_slice_index; slice_index < last_slice_index; slice_index++)
 			{
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-				{
-					const encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
+				//const uint32_t width = m_slices[slice_index].m_width;
+				//const uint32_t height = m_slices[slice_index].m_height;
+				const uint32_t num_blocks_x = m_slices[slice_index].m_num_blocks_x;
+				const uint32_t num_blocks_y = m_slices[slice_index].m_num_blocks_y;
 
-					if (((block_x & 1) == 0) && ((block_y & 1) == 0))
-					{
-						if (endpoint_pred_repeat_count > 0)
-						{
-							endpoint_pred_repeat_count--;
-						}
-						else
-						{
-							uint32_t sym = endpoint_pred_syms[slice_index][cur_endpoint_pred_sym_ofs++];
+				bitwise_coder coder;
+				coder.init(1024 * 1024 * 4);
 
-							if (sym == basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL)
-							{
-								total_endpoint_pred_bits += coder.put_code(sym, endpoint_pred_model);
+				uint32_t cur_selector_sym_ofs = 0;
+				uint32_t selector_rle_count = 0;
 
-								endpoint_pred_repeat_count = endpoint_pred_syms[slice_index][cur_endpoint_pred_sym_ofs++];
-								assert(endpoint_pred_repeat_count >= (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT);
+				int endpoint_pred_repeat_count = 0;
+				uint32_t cur_endpoint_pred_sym_ofs = 0;
+				//uint32_t prev_endpoint_pred_sym = 0;
+				uint32_t prev_endpoint_index = 0;
 
-								total_endpoint_pred_bits += coder.put_vlc(endpoint_pred_repeat_count - basist::ENDPOINT_PRED_MIN_REPEAT_COUNT, basist::ENDPOINT_PRED_COUNT_VLC_BITS);
+				for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+				{
+					for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+					{
+						const encoder_block& m = m_slice_encoder_blocks[slice_index](block_x, block_y);
 
+						if (((block_x & 1) == 0) && ((block_y & 1) == 0))
+						{
+							if (endpoint_pred_repeat_count > 0)
+							{
 								endpoint_pred_repeat_count--;
 							}
 							else
 							{
-								total_endpoint_pred_bits += coder.put_code(sym, endpoint_pred_model);
+								uint32_t sym = endpoint_pred_syms[slice_index][cur_endpoint_pred_sym_ofs++];
+
+								if (sym == basist::ENDPOINT_PRED_REPEAT_LAST_SYMBOL)
+								{
+									slice_endpoint_pred_bits[slice_index] += coder.put_code(sym, endpoint_pred_model);
+
+									endpoint_pred_repeat_count = endpoint_pred_syms[slice_index][cur_endpoint_pred_sym_ofs++];
+									assert(endpoint_pred_repeat_count >= (int)basist::ENDPOINT_PRED_MIN_REPEAT_COUNT);
+
+									slice_endpoint_pred_bits[slice_index] += coder.put_vlc(endpoint_pred_repeat_count - basist::ENDPOINT_PRED_MIN_REPEAT_COUNT, basist::ENDPOINT_PRED_COUNT_VLC_BITS);
+
+									endpoint_pred_repeat_count--;
+								}
+								else
+								{
+									slice_endpoint_pred_bits[slice_index] += coder.put_code(sym, endpoint_pred_model);
 
-								//prev_endpoint_pred_sym = sym;
+									//prev_endpoint_pred_sym = sym;
+								}
 							}
 						}
-					}
 
-					const int new_endpoint_index = m_endpoint_remap_table_old_to_new[m.m_endpoint_index];
+						const int new_endpoint_index = m_endpoint_remap_table_old_to_new[m.m_endpoint_index];
 
-					if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
-					{
-						int endpoint_delta = new_endpoint_index - prev_endpoint_index;
-						if (endpoint_delta < 0)
-							endpoint_delta += (int)r.get_total_endpoint_clusters();
+						if (m.m_endpoint_predictor == basist::NO_ENDPOINT_PRED_INDEX)
+						{
+							int endpoint_delta = new_endpoint_index - prev_endpoint_index;
+							if (endpoint_delta < 0)
+								endpoint_delta += (int)r.get_total_endpoint_clusters();
 
-						total_delta_endpoint_bits += coder.put_code(endpoint_delta, delta_endpoint_model);
-					}
+							slice_delta_endpoint_bits[slice_index] += coder.put_code(endpoint_delta, delta_endpoint_model);
+						}
 
-					prev_endpoint_index = new_endpoint_index;
+						prev_endpoint_index = new_endpoint_index;
 
-					if ((!is_video) || (m.m_endpoint_predictor != basist::CR_ENDPOINT_PRED_INDEX))
-					{
-						if (!selector_rle_count)
+						if ((!is_video) || (m.m_endpoint_predictor != basist::CR_ENDPOINT_PRED_INDEX))
 						{
-							uint32_t selector_sym_index = selector_syms[slice_index][cur_selector_sym_ofs++];
+							if (!selector_rle_count)
+							{
+								uint32_t selector_sym_index = selector_syms[slice_index][cur_selector_sym_ofs++];
 
-							if (selector_sym_index == SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX)
-								selector_rle_count = selector_syms[slice_index][cur_selector_sym_ofs++];
+								if (selector_sym_index == SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX)
+									selector_rle_count = selector_syms[slice_index][cur_selector_sym_ofs++];
 
-							total_selector_bits += coder.put_code(selector_sym_index, selector_model);
+								slice_selector_bits[slice_index] += coder.put_code(selector_sym_index, selector_model);
 
-							if (selector_sym_index == SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX)
-							{
-								int run_sym = selector_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
-								if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
+								if (selector_sym_index == SELECTOR_HISTORY_BUF_RLE_SYMBOL_INDEX)
 								{
-									total_selector_bits += coder.put_code(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1, selector_history_buf_rle_model);
+									int run_sym = selector_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
+									if (run_sym >= ((int)basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1))
+									{
+										slice_selector_bits[slice_index] += coder.put_code(basist::SELECTOR_HISTORY_BUF_RLE_COUNT_TOTAL - 1, selector_history_buf_rle_model);
 
-									uint32_t n = selector_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
-									total_selector_bits += coder.put_vlc(n, 7);
+										uint32_t n = selector_rle_count - basist::SELECTOR_HISTORY_BUF_RLE_COUNT_THRESH;
+										slice_selector_bits[slice_index] += coder.put_vlc(n, 7);
+									}
+									else
+										slice_selector_bits[slice_index] += coder.put_code(run_sym, selector_history_buf_rle_model);
 								}
-								else
-									total_selector_bits += coder.put_code(run_sym, selector_history_buf_rle_model);
 							}
+
+							if (selector_rle_count)
+								selector_rle_count--;
 						}
 
-						if (selector_rle_count)
-							selector_rle_count--;
-					}
+					} // block_x
 
-				} // block_x
+				} // block_y
 
-			} // block_y
+				BASISU_BACKEND_VERIFY(cur_endpoint_pred_sym_ofs == endpoint_pred_syms[slice_index].size());
+				BASISU_BACKEND_VERIFY(cur_selector_sym_ofs == selector_syms[slice_index].size());
 
-			BASISU_BACKEND_VERIFY(cur_endpoint_pred_sym_ofs == endpoint_pred_syms[slice_index].size());
-			BASISU_BACKEND_VERIFY(cur_selector_sym_ofs == selector_syms[slice_index].size());
+				coder.flush();
 
-			coder.flush();
+				m_output.m_slice_image_data[slice_index] = coder.get_bytes();
 
-			m_output.m_slice_image_data[slice_index] = coder.get_bytes();
+			} // slice_index
+			});
 
-			total_image_bytes += (uint32_t)coder.get_bytes().size();
+		for (uint32_t slice_index = 0; slice_index < m_slices.size(); slice_index++)
+		{
+			total_endpoint_pred_bits += slice_endpoint_pred_bits[slice_index];
+			total_delta_endpoint_bits += slice_delta_endpoint_bits[slice_index];
+			total_selector_bits += slice_selector_bits[slice_index];
 
-			debug_printf("Slice %u compressed size: %u bytes, %3.3f bits per slice texel\n", slice_index, m_output.m_slice_image_data[slice_index].size(), m_output.m_slice_image_data[slice_index].size() * 8.0f / (m_slices[slice_index].m_orig_width * m_slices[slice_index].m_orig_height));
+			total_image_bytes += (uint32_t)m_output.m_slice_image_data[slice_index].size();
 
-		} // slice_index
+			debug_printf("Slice %u compressed size: %u bytes, %3.3f bits per slice texel\n", slice_index, m_output.m_slice_image_data[slice_index].size(), m_output.m_slice_image_data[slice_index].size() * 8.0f / (m_slices[slice_index].m_orig_width * m_slices[slice_index].m_orig_height));
+		}
 
 		const double total_texels = static_cast<double>(get_total_input_texels());
 		const double total_blocks = static_cast<double>(get_total_blocks());
@@ -1486,6 +1701,8 @@ namespace basisu
 
 	bool basisu_backend::encode_endpoint_palette()
 	{
+		BASISU_TRACE_ZONE("basisu_backend::encode_endpoint_palette");
+
 		const basisu_frontend& r = *m_pFront_end;
 
 		// The endpoint indices may have been changed by the backend's RDO step, so go and figure out which ones are actually used again.
@@ -1659,6 +1876,8 @@ namespace basisu
 
 	bool basisu_backend::encode_selector_palette()
 	{
+		BASISU_TRACE_ZONE("basisu_backend::encode_selector_palette");
+
 		const basisu_frontend& r = *m_pFront_end;
 		
 		histogram delta_selector_pal_histogram(256);
@@ -1755,8 +1974,17 @@ namespace basisu
 		create_endpoint_palette();
 		create_selector_palette();
 
+		if (m_params.m_pProgress)
+			m_params.m_pProgress->begin_stage(0.0f, .5f, m_slices.size());
+
 		create_encoder_blocks();
 
+		if (is_stopped())
+			return 0;
+
+		if (m_params.m_pProgress)
+			m_params.m_pProgress->begin_stage(.5f, 1.0f, m_slices.size());
+
 		if (!encode_image())
 			return 0;
 
@@ -158,6 +158,13 @@ namespace basisu
 
 		bool m_validate;
 
+		// Optional, receives progress updates and is polled for cancellation/deadline expiry.
+		encode_progress* m_pProgress;
+
+		// If true (and m_pJob_pool is set), the per-slice passes are spread across the job pool. The output is identical either way.
+		bool m_multithreaded;
+		job_pool* m_pJob_pool;
+
 		basisu_backend_params()
 		{
 			clear();
@@ -173,6 +180,9 @@ namespace basisu
 			m_compression_level = 0;
 			m_used_global_codebooks = false;
 			m_validate = true;
+			m_pProgress = nullptr;
+			m_multithreaded = false;
+			m_pJob_pool = nullptr;
 		}
 	};
 
@@ -289,6 +299,9 @@ namespace basisu
 		etc1_endpoint_palette_entry_vec m_endpoint_palette;
 		etc1_selector_palette_entry_vec m_selector_palette;
 
+		bool is_stopped() const { return m_params.m_pProgress && m_params.m_pProgress->is_stopped(); }
+		bool update_progress(uint64_t num_units = 0) { return !m_params.m_pProgress || m_params.m_pProgress->update(num_units); }
+
 		struct etc1_global_selector_cb_entry_desc
 		{
 			uint32_t m_pal_index;
@@ -394,10 +407,49 @@ namespace basisu
 		//      Alternately, if no template applies, we can send 4 ETC1S bits followed by 4-8 endpoint indices
 		//  4 selector indices
 
+		// Per-job state of the slice passes. Each job handles a contiguous run of slices, and the jobs' states are merged
+		// in slice order afterwards, so the output doesn't depend on the number of threads.
+		struct encoder_blocks_state
+		{
+			uint_vec m_endpoint_indices;
+			uint32_t m_total_endpoint_pred_missed;
+			uint32_t m_total_endpoint_pred_hits;
+			uint32_t m_total_block_endpoints_remapped;
+
+			encoder_blocks_state() : m_total_endpoint_pred_missed(0), m_total_endpoint_pred_hits(0), m_total_block_endpoints_remapped(0) { }
+		};
+
+		struct encode_image_state
+		{
+			histogram m_selector_history_buf_histogram;
+			histogram m_selector_histogram;
+			histogram m_selector_history_buf_rle_histogram;
+			histogram m_delta_endpoint_histogram;
+			histogram m_endpoint_pred_histogram;
+
+			uint_vec m_block_endpoint_indices;
+			uint_vec m_block_selector_indices;
+
+			uint32_t m_total_used_selector_history_buf;
+			uint32_t m_total_selector_indices_remapped;
+			uint32_t m_total_endpoint_indices_remapped;
+
+			void init(uint32_t total_endpoint_clusters, uint32_t total_selector_clusters);
+			void merge(const encode_image_state& other);
+		};
+
+		uint32_t get_total_slice_jobs(bool allow_multithreading) const;
+		void run_slice_jobs(uint32_t num_jobs, const std::function<void(uint32_t job_index, uint32_t first_slice_index, uint32_t last_slice_index)>& func, bool gop_aligned = false);
+		bool is_video_gop_start(uint32_t slice_index) const;
+		uint32_t get_total_video_gops() const;
+
 		void reoptimize_and_sort_endpoints_codebook(uint32_t total_block_endpoints_remapped, uint_vec &all_endpoint_indices);
 		void sort_selector_codebook();
+		void create_slice_encoder_blocks(uint32_t slice_index, encoder_blocks_state& state);
 		void create_encoder_blocks();
+		void compute_slice_crc(uint32_t slice_index);
 		void compute_slice_crcs();
+		void encode_slice_symbols(uint32_t slice_index, encode_image_state& state, uint_vec& endpoint_pred_syms, uint_vec& selector_syms);
 		bool encode_image();
 		bool encode_endpoint_palette();
 		bool encode_selector_palette();
@@ -53,6 +53,9 @@ namespace basisu
 
 		const uint8_vec &get_compressed_data() const { return m_comp_data; }
 
+		// Moves the compressed data into dst, leaving get_compressed_data() empty.
+		void take_compressed_data(uint8_vec &dst) { dst.clear(); dst.swap(m_comp_data); }
+
 	private:
 		basist::basis_file_header m_header;
 		basisu::vector<basist::basis_slice_desc> m_images_descs;
@@ -1,8 +1,9 @@
 // basisu_bc15_spmd.cpp -- standalone opaque 4-color BC1 encoder (see basisu_bc15_spmd.h).
 //
-// This TU holds the public API, the solid-color omatch tables, and the scalar reference encoder. The SSE4.1
-// cppspmd kernel lives in basisu_bc15_spmd_kernels.inl, compiled by basisu_bc15_spmd_sse.cpp; we only declare +
-// call its wrapper here (gated on g_cpu_supports_sse41), with the scalar path as the fallback.
+// This TU holds the public API, the solid-color omatch tables, and the scalar reference encoder. The cppspmd
+// kernels live in basisu_bc15_spmd_kernels.inl, compiled by basisu_bc15_spmd_sse.cpp (SSE4.1) and
+// basisu_bc15_spmd_avx2.cpp (AVX2); we only declare + call their wrappers here (gated on g_cpu_supports_avx2 and
+// g_cpu_supports_sse41), with the scalar path as the fallback.
 
 #include "basisu_bc15_spmd.h"
 #include "basisu_enc.h"
@@ -11,6 +12,7 @@
 namespace basisu
 {
 	extern bool g_cpu_supports_sse41; // set by detect_sse41() in basisu_encoder_init()
+	extern bool g_cpu_supports_avx2;
 
 	namespace bc_spmd
 	{
@@ -21,13 +23,29 @@ namespace basisu
 #if BASISU_SUPPORT_SSE
 		// Defined in basisu_bc15_spmd_kernels.inl (the SSE4.1 TU). Encodes up to 4 blocks at once, writing num_write
 		// of them directly at pOut + j*out_stride (no temp buffer).
-		void encode_bc1_blocks_4_sse41(const color_rgba* pBlocks, uint8_t* pOut,
+		void encode_bc1_blocks_sse41(const color_rgba* pBlocks, uint8_t* pOut,
 			int* om5lo, int* om5hi, int* om6lo, int* om6hi, int ls_rounds, int avgvar,
 			uint32_t out_stride, uint32_t num_write);
 
 		// BC4: encodes up to 4 single-channel blocks at once, writing num_write of them at pOut + j*out_stride.
 		// do_ls!=0 adds the 1-D least-squares refit. src_stride = byte stride between texel values in pBlocks (1 or 4).
-		void encode_bc4_blocks_4_sse41(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride);
+		void encode_bc4_blocks_sse41(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride);
+
+		typedef void (*encode_bc1_blocks_func)(const color_rgba* pBlocks, uint8_t* pOut,
+			int* om5lo, int* om5hi, int* om6lo, int* om6hi, int ls_rounds, int avgvar,
+			uint32_t out_stride, uint32_t num_write);
+		typedef void (*encode_bc4_blocks_func)(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride);
+
+		// Max. number of blocks encoded per kernel call.
+		const uint32_t cMaxGroupBlocks = 8;
+#endif
+
+#if BASISU_SUPPORT_AVX2
+		// Same as the above, but 8 blocks at once (the AVX2 TU).
+		void encode_bc1_blocks_avx2(const color_rgba* pBlocks, uint8_t* pOut,
+			int* om5lo, int* om5hi, int* om6lo, int* om6hi, int ls_rounds, int avgvar,
+			uint32_t out_stride, uint32_t num_write);
+		void encode_bc4_blocks_avx2(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride);
 #endif
 
 		// ---- solid-color omatch tables (stb_dxt/basisu 3% span penalty), as int[256] for the kernel's gather ----
@@ -244,19 +262,30 @@ namespace basisu
 #if BASISU_SUPPORT_SSE
 			if (g_cpu_supports_sse41)
 			{
-				// Full groups of 4: the kernel writes all 4 blocks directly at the (possibly strided) output.
+				// The group size is the kernel's lane count: 8 blocks for AVX2, 4 for SSE4.1.
+				encode_bc1_blocks_func pEncode_blocks = encode_bc1_blocks_sse41;
+				uint32_t group_size = 4;
+#if BASISU_SUPPORT_AVX2
+				if (g_cpu_supports_avx2)
+				{
+					pEncode_blocks = encode_bc1_blocks_avx2;
+					group_size = 8;
+				}
+#endif
+
+				// Full groups: the kernel writes all group_size blocks directly at the (possibly strided) output.
 				uint32_t base = 0;
-				for (; base + 4 <= num_blocks; base += 4)
-					encode_bc1_blocks_4_sse41(pSrc_pixels + base * 16, pOut + base * out_stride, s_om5_lo, s_om5_hi, s_om6_lo, s_om6_hi, kLsRounds, kAvgVar, out_stride, 4);
+				for (; base + group_size <= num_blocks; base += group_size)
+					pEncode_blocks(pSrc_pixels + base * 16, pOut + base * out_stride, s_om5_lo, s_om5_hi, s_om6_lo, s_om6_hi, kLsRounds, kAvgVar, out_stride, group_size);
 
-				// Final partial group: pad the input to 4, but write only the n valid blocks (still direct, no temp).
-				const uint32_t n = num_blocks - base; // 0..3
+				// Final partial group: pad the input to a full group, but write only the n valid blocks (still direct, no temp).
+				const uint32_t n = num_blocks - base; // 0..group_size-1
 				if (n)
 				{
-					color_rgba grp[64];
-					for (uint32_t gi = 0; gi < 4; gi++)
+					color_rgba grp[cMaxGroupBlocks * 16];
+					for (uint32_t gi = 0; gi < cMaxGroupBlocks; gi++)
 						memcpy(grp + gi * 16, pSrc_pixels + (base + ((gi < n) ? gi : (n - 1))) * 16, 16 * sizeof(color_rgba));
-					encode_bc1_blocks_4_sse41(grp, pOut + base * out_stride, s_om5_lo, s_om5_hi, s_om6_lo, s_om6_hi, kLsRounds, kAvgVar, out_stride, n);
+					pEncode_blocks(grp, pOut + base * out_stride, s_om5_lo, s_om5_hi, s_om6_lo, s_om6_hi, kLsRounds, kAvgVar, out_stride, n);
 				}
 				return;
 			}
@@ -361,23 +390,35 @@ namespace basisu
 			if (g_cpu_supports_sse41)
 			{
 				const uint32_t do_ls = high_quality ? 1 : 0;
+
+				// The group size is the kernel's lane count: 8 blocks for AVX2, 4 for SSE4.1.
+				encode_bc4_blocks_func pEncode_blocks = encode_bc4_blocks_sse41;
+				uint32_t group_size = 4;
+#if BASISU_SUPPORT_AVX2
+				if (g_cpu_supports_avx2)
+				{
+					pEncode_blocks = encode_bc4_blocks_avx2;
+					group_size = 8;
+				}
+#endif
+
 				// Full groups read straight from the (possibly strided) source -- no copy.
 				uint32_t base = 0;
-				for (; base + 4 <= num_blocks; base += 4)
-					encode_bc4_blocks_4_sse41(pSrc_pixels + (size_t)base * in_block, pOut + base * out_stride, out_stride, 4, do_ls, src_stride);
+				for (; base + group_size <= num_blocks; base += group_size)
+					pEncode_blocks(pSrc_pixels + (size_t)base * in_block, pOut + base * out_stride, out_stride, group_size, do_ls, src_stride);
 
-				// Tail (<4): gather the channel into a tightly-packed 64-byte stack buffer (pad with last block), then
+				// Tail (<group_size): gather the channel into a tightly-packed stack buffer (pad the whole buffer with the last block), then
 				// encode with src_stride=1. Only the tail copies; the bulk above is zero-copy.
-				const uint32_t n = num_blocks - base; // 0..3
+				const uint32_t n = num_blocks - base; // 0..group_size-1
 				if (n)
 				{
-					uint8_t grp[64];
-					for (uint32_t gi = 0; gi < 4; gi++)
+					uint8_t grp[cMaxGroupBlocks * 16];
+					for (uint32_t gi = 0; gi < cMaxGroupBlocks; gi++)
 					{
 						const uint8_t* sp = pSrc_pixels + (size_t)(base + ((gi < n) ? gi : (n - 1))) * in_block;
 						for (uint32_t t = 0; t < 16; t++) grp[gi * 16 + t] = sp[t * src_stride];
 					}
-					encode_bc4_blocks_4_sse41(grp, pOut + base * out_stride, out_stride, n, do_ls, 1);
+					pEncode_blocks(grp, pOut + base * out_stride, out_stride, n, do_ls, 1);
 				}
 				return;
 			}
@@ -387,7 +428,7 @@ namespace basisu
 
 		// ================================ High-level RGBA format helpers ================================
 		// NO allocations, NO channel-extraction copies: the BC4 path reads the requested channel straight out of the
-		// RGBA pixels via src_stride=4 (the channel pointer is &pPixels->r/g/b/a). encode_bc4_* handles the <4 tail
+		// RGBA pixels via src_stride=4 (the channel pointer is &pPixels->r/g/b/a). encode_bc4_* handles the partial tail group
 		// without overrunning the (possibly strided) output.
 
 		void encode_bc1(void* pBlocks, const color_rgba* pPixels, uint32_t num_blocks, bool use_spmd)
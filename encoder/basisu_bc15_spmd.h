@@ -4,8 +4,8 @@
 // Two entry points share the SAME algorithm (omatch-solid fast path -> PCA endpoint seed -> 2x integer-threshold
 // least-squares -> low-variance avg-solid 2nd seed (keep-better) -> integer-threshold selectors):
 //   - encode_bc1_scalar : portable scalar reference ("oracle"), no SIMD.
-//   - encode_bc1_spmd   : SSE4.1 cppspmd kernel, 4 blocks per vector; falls back to the scalar path when SSE4.1
-//                         is unavailable (e.g. WASM without SIMD).
+//   - encode_bc1_spmd   : cppspmd kernel, 8 blocks per vector with AVX2 or 4 with SSE4.1; falls back to the scalar
+//                         path when SSE4.1 is unavailable (e.g. WASM without SIMD).
 // Benchmarked (vs basist::encode_bc1): ~3.4-4.7x faster on photos, ~+0.06 dB average, and it beats encode_bc1
 // on low-dynamic-range / gradient blocks. Opaque 4-color only (no 3-color / punchthrough).
 #pragma once
@@ -40,7 +40,7 @@ namespace basisu
 		//   pSrc_pixels  : num_blocks * 16 uint8_t, block-contiguous; texel index within a block = y*4 + x. The
 		//                  caller extracts the 16 single-channel values per block itself (e.g. one channel of RGBA).
 		//   pBlocks      : output; BC4 block b is written at (uint8_t*)pBlocks + b * 8 * block_stride.
-		//   num_blocks   : any count; the <4 tail is handled internally.
+		//   num_blocks   : any count; the partial tail group is handled internally.
 		//   block_stride : output spacing in units of 8-byte BC4 blocks. 1 = contiguous BC4. 2 = write into every
 		//                  other 8-byte slot, e.g. the alpha half of a 16-byte BC3 block or one half of a BC5 pair.
 		//   high_quality : false (default) = fast bbox encoder, matches encode_bc4 quality, ~1.4x faster. true = add a
@@ -54,8 +54,8 @@ namespace basisu
 		// ---------------- High-level format helpers (RGBA in -> complete GPU blocks out) ----------------
 		// Convenience wrappers over the low-level encoders. Each takes pPixels = num_blocks * 16 color_rgba,
 		// block-contiguous (texel index = y*4 + x), and writes complete blocks. num_blocks may be ANY count >= 1
-		// (not necessarily a multiple of 4); the <4 tail is handled internally with NO output overrun.
-		//   use_spmd     : true = SSE4.1 SPMD path (auto-falls back to scalar when SSE4.1 is unavailable); false = scalar.
+		// (not necessarily a multiple of 4); the partial tail group is handled internally with NO output overrun.
+		//   use_spmd     : true = SPMD path (AVX2 or SSE4.1; auto-falls back to scalar when SSE4.1 is unavailable); false = scalar.
 		//   high_quality : enables the BC4 channel least-squares refit for the alpha/red/green block(s) (BC3/BC4/BC5).
 		// Output block sizes / layout (matches the transcoder's bcu unpackers):
 		//   BC1: 8 bytes/block  -- RGB, opaque 4-color.
@@ -1,13 +1,14 @@
 // basisu_bc15_spmd_kernels.inl -- Do NOT directly include.
 //
-// SSE4.1 cppspmd kernel for the standalone BC1 encoder. Included by basisu_bc15_spmd_sse.cpp from file scope after
-// cppspmd_sse.h + "using namespace CPPSPMD;". LANES = BLOCKS: 4 independent BC1 blocks per vector, one per lane;
-// each lane runs the same scalar-looking program on its block's 16 texels. Mirrors encoder/basisu_kernels_imp.h.
+// cppspmd kernels for the standalone BC1/BC4 encoders. Included by basisu_bc15_spmd_sse.cpp (SSE4.1, 4 lanes) and
+// basisu_bc15_spmd_avx2.cpp (AVX2, 8 lanes) from file scope after cppspmd_sse.h/cppspmd_avx2.h + "using namespace CPPSPMD;".
+// LANES = BLOCKS: PROGRAM_COUNT independent blocks per vector, one per lane; each lane runs the same scalar-looking
+// program on its block's 16 texels. Mirrors encoder/basisu_kernels_imp.h.
 
-namespace bc_spmd_kern
+namespace CPPSPMD_NAME(bc_spmd_kern)
 {
-	// Opaque 4-color BC1 encode of 4 blocks at once (one block per lane). pBlocks = 4 blocks x 16 texels,
-	// block-contiguous; pOut = 4*8 bytes. om5*/om6* = solid-color omatch tables (int[256]); ls_rounds, avgvar tune.
+	// Opaque 4-color BC1 encode of PROGRAM_COUNT blocks at once (one block per lane). pBlocks = PROGRAM_COUNT blocks x 16
+	// texels, block-contiguous; pOut = PROGRAM_COUNT*8 bytes. om5*/om6* = solid-color omatch tables (int[256]); ls_rounds, avgvar tune.
 	struct encode_bc1_4color_blocks : spmd_kernel
 	{
 		inline vint div3(const vint& x) { return VUINT_SHIFT_RIGHT(x * vint(43691), 17); } // exact floor(x/3), x small
@@ -24,10 +25,10 @@ namespace bc_spmd_kern
 			return VINT_SHIFT_LEFT(r5, 11) | VINT_SHIFT_LEFT(g6, 5) | b5;
 		}
 
-		// Load texel i of all 4 blocks into per-channel vints (lane j = block j's texel i).
+		// Load texel i of all PROGRAM_COUNT blocks into per-channel vints (lane j = block j's texel i).
 		inline void load_texel(const int32_t* p, int i, vint& r, vint& g, vint& b)
 		{
-			vint rgba; rgba.m_value = _mm_setr_epi32(p[i], p[16 + i], p[32 + i], p[48 + i]);
+			const vint rgba = load_all_strided(p + i, 16);
 			r = rgba & vint(0xFF);
 			g = VINT_SHIFT_RIGHT(rgba, 8) & vint(0xFF);
 			b = VINT_SHIFT_RIGHT(rgba, 16) & vint(0xFF);
@@ -121,7 +122,7 @@ namespace bc_spmd_kern
 		{
 			const int32_t* p = (const int32_t*)pBlocks;
 
-			// Stage source pixels to SoA ONCE (lane = block): R[i]/G[i]/B[i] hold texel i of all 4 blocks.
+			// Stage source pixels to SoA ONCE (lane = block): R[i]/G[i]/B[i] hold texel i of all PROGRAM_COUNT blocks.
 			vint R[16], G[16], B[16];
 			for (int i = 0; i < 16; i++) load_texel(p, i, R[i], G[i], B[i]);
 
@@ -262,9 +263,9 @@ namespace bc_spmd_kern
 			}
 			SPMD_SENDIF
 
-			// Emit one BC1 block per lane directly to the (possibly strided) output -- no temp buffer. num_write < 4
+			// Emit one BC1 block per lane directly to the (possibly strided) output -- no temp buffer. num_write < PROGRAM_COUNT
 			// for the final partial group so the padded lanes aren't written; out_stride lets BC3/BC5 interleave.
-			CPPSPMD_DECL(int, c0a[4]); CPPSPMD_DECL(int, c1a[4]); CPPSPMD_DECL(int, swa[4]);
+			CPPSPMD_DECL(int, c0a[PROGRAM_COUNT]); CPPSPMD_DECL(int, c1a[PROGRAM_COUNT]); CPPSPMD_DECL(int, swa[PROGRAM_COUNT]);
 			storeu_linear_all(c0a, color0);
 			storeu_linear_all(c1a, color1);
 			storeu_linear_all(swa, sel_word);
@@ -280,9 +281,9 @@ namespace bc_spmd_kern
 	};
 } // namespace bc_spmd_kern
 
-namespace bc_spmd_kern
+namespace CPPSPMD_NAME(bc_spmd_kern)
 {
-	// BC4 (RGTC1) -- one single-channel block per lane, 4 blocks/call. Clone of basist::encode_bc4: raw bbox
+	// BC4 (RGTC1) -- one single-channel block per lane, PROGRAM_COUNT blocks/call. Clone of basist::encode_bc4: raw bbox
 	// min/max, exact nearest-of-8 integer-threshold selector, ALWAYS 8-value mode (solid forced to red0>red1).
 	// All-integer, GATHER-FREE: texels via manual load; rank->index by arithmetic (no s_tran gather); the 48-bit
 	// selector packed via uniform shifts into two vints (texels 0-9 in lo, 10-15 in hi), combined with <<30 in scalar.
@@ -317,12 +318,19 @@ namespace bc_spmd_kern
 
 		void _call(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride)
 		{
-			// Stage 16 channel values to SoA: A[i] = texel i of the 4 lane-blocks. Source values are src_stride bytes
-			// apart (1 = packed channel, 4 = one channel of RGBA); blocks are 16*src_stride bytes apart.
+			// Stage 16 channel values to SoA: A[i] = texel i of the PROGRAM_COUNT lane-blocks. Source values are src_stride
+			// bytes apart (1 = packed channel, 4 = one channel of RGBA); blocks are 16*src_stride bytes apart.
 			const uint32_t S = src_stride;
 			vint A[16];
 			for (int i = 0; i < 16; i++)
+			{
+#if CPPSPMD_AVX2
+				A[i].m_value = _mm256_setr_epi32(pBlocks[i * S], pBlocks[(16 + i) * S], pBlocks[(32 + i) * S], pBlocks[(48 + i) * S],
+					pBlocks[(64 + i) * S], pBlocks[(80 + i) * S], pBlocks[(96 + i) * S], pBlocks[(112 + i) * S]);
+#else
 				A[i].m_value = _mm_setr_epi32(pBlocks[i * S], pBlocks[(16 + i) * S], pBlocks[(32 + i) * S], pBlocks[(48 + i) * S]);
+#endif
+			}
 
 			vint mn = A[0], mx = A[0];
 			for (int i = 1; i < 16; i++) { mn = min(mn, A[i]); mx = max(mx, A[i]); }
@@ -385,7 +393,7 @@ namespace bc_spmd_kern
 			}
 			SPMD_SENDIF
 
-			CPPSPMD_DECL(int, c0a[4]); CPPSPMD_DECL(int, c1a[4]); CPPSPMD_DECL(int, sloa[4]); CPPSPMD_DECL(int, shia[4]);
+			CPPSPMD_DECL(int, c0a[PROGRAM_COUNT]); CPPSPMD_DECL(int, c1a[PROGRAM_COUNT]); CPPSPMD_DECL(int, sloa[PROGRAM_COUNT]); CPPSPMD_DECL(int, shia[PROGRAM_COUNT]);
 			storeu_linear_all(c0a, color0);
 			storeu_linear_all(c1a, color1);
 			storeu_linear_all(sloa, sel_lo);
@@ -402,27 +410,22 @@ namespace bc_spmd_kern
 	};
 } // namespace bc_spmd_kern
 
+// ISA wrappers -- encode PROGRAM_COUNT blocks at once. Defined here (once per ISA TU, e.g. encode_bc1_blocks_sse41 and
+// encode_bc1_blocks_avx2), declared in basisu_bc15_spmd.cpp.
 namespace basisu
 {
 	namespace bc_spmd
 	{
-		void encode_bc4_blocks_4_sse41(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride)
+		void CPPSPMD_NAME(encode_bc4_blocks)(const uint8_t* pBlocks, uint8_t* pOut, uint32_t out_stride, uint32_t num_write, uint32_t do_ls, uint32_t src_stride)
 		{
-			spmd_call<bc_spmd_kern::encode_bc4_blocks>(pBlocks, pOut, out_stride, num_write, do_ls, src_stride);
+			spmd_call<CPPSPMD_NAME(bc_spmd_kern)::encode_bc4_blocks>(pBlocks, pOut, out_stride, num_write, do_ls, src_stride);
 		}
-	}
-}
 
-// ISA wrapper -- encode 4 blocks at once. Defined here (inside the SSE4.1 TU), declared in basisu_bc15_spmd.cpp.
-namespace basisu
-{
-	namespace bc_spmd
-	{
-		void encode_bc1_blocks_4_sse41(const color_rgba* pBlocks, uint8_t* pOut,
+		void CPPSPMD_NAME(encode_bc1_blocks)(const color_rgba* pBlocks, uint8_t* pOut,
 			int* om5lo, int* om5hi, int* om6lo, int* om6hi, int ls_rounds, int avgvar,
 			uint32_t out_stride, uint32_t num_write)
 		{
-			spmd_call<bc_spmd_kern::encode_bc1_4color_blocks>(pBlocks, pOut, om5lo, om5hi, om6lo, om6hi, ls_rounds, avgvar, out_stride, num_write);
+			spmd_call<CPPSPMD_NAME(bc_spmd_kern)::encode_bc1_4color_blocks>(pBlocks, pOut, om5lo, om5hi, om6lo, om6hi, ls_rounds, avgvar, out_stride, num_write);
 		}
 	}
 }
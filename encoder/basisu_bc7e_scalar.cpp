@@ -10,6 +10,14 @@
 #include <cmath>
 #include <cstdio>
 
+#if BASISU_SUPPORT_SSE
+namespace basisu
+{
+	extern bool g_cpu_supports_sse41; // set by detect_sse41() in basisu_encoder_init()
+	extern bool g_cpu_supports_avx2;
+}
+#endif
+
 // --- ISPC compatibility shim (formerly ispc_compat.h, inlined here so this .cpp
 // --- plus basisu_bc7e_scalar.h are fully self-contained). Supplies the small ISPC
 // --- stdlib surface the de-SIMD'd code uses, the base integer type aliases, and
@@ -63,6 +71,7 @@ namespace bc7e_scalar {
 // sanitize it; in scalar code an unguarded 0/0 NaN can become an INT_MIN array
 // index. Biasing keeps the divisor finite and nonzero with negligible effect on
 // the result (denominators are otherwise >= 1 in these spots).
+// (Duplicated in basisu_bc7e_spmd_kernels.inl.)
 static const float BC7E_DENOM_BIAS = 0.0000125f;
 
 // bc7e.ispc - Fast high quality SIMD BC7 encoder
@@ -2606,7 +2615,9 @@ static uint64_t color_cell_compression_est_mode7( uint32_t mode, const  color_ce
 	return total_err;
 }
 
-static uint32_t estimate_partition( uint32_t mode, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params)
+// pPart_errs (optional): the per-partition estimated errors precomputed by the SIMD kernels (see estimate_group_partitions()),
+// bit-identical to what the loop below would compute.
+static uint32_t estimate_partition( uint32_t mode, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params, const uint64_t * pPart_errs = nullptr)
 {
 	const  uint32_t total_subsets = g_bc7_num_subsets[mode];
 	 uint32_t total_partitions = minimumu(pComp_params->m_max_partitions_mode[mode], 1U << g_bc7_partition_bits[mode]);
@@ -2637,35 +2648,40 @@ static uint32_t estimate_partition( uint32_t mode, const  color_quad_i * pPixels
 
 	for ( uint32_t partition = 0; partition < total_partitions; partition++)
 	{
-		const int * pPartition = (total_subsets == 3) ? &g_bc7_partition3[partition * 16] : &g_bc7_partition2[partition * 16];
+		uint64_t total_subset_err = 0;
 
-		 color_quad_i subset_colors[3][16];
-		 uint32_t subset_total_colors[3];
-		subset_total_colors[0] = 0;
-		subset_total_colors[1] = 0;
-		subset_total_colors[2] = 0;
-		
-		for ( uint32_t index = 0; index < 16; index++)
+		if (pPart_errs)
+			total_subset_err = pPart_errs[partition];
+		else
 		{
-			const  uint32_t p = pPartition[index];
+			const int * pPartition = (total_subsets == 3) ? &g_bc7_partition3[partition * 16] : &g_bc7_partition2[partition * 16];
 
-			subset_colors[p][subset_total_colors[p]] = pPixels[index];
-			subset_total_colors[p]++;
-		}
+			 color_quad_i subset_colors[3][16];
+			 uint32_t subset_total_colors[3];
+			subset_total_colors[0] = 0;
+			subset_total_colors[1] = 0;
+			subset_total_colors[2] = 0;
+		
+			for ( uint32_t index = 0; index < 16; index++)
+			{
+				const  uint32_t p = pPartition[index];
 
-		uint64_t total_subset_err = 0;
+				subset_colors[p][subset_total_colors[p]] = pPixels[index];
+				subset_total_colors[p]++;
+			}
 
-		for ( uint32_t subset = 0; subset < total_subsets; subset++)
-		{
-			uint64_t err;
-			if (mode == 7)
-				err = color_cell_compression_est_mode7(mode, &params, best_err, subset_total_colors[subset], &subset_colors[subset][0]);
-			else
-				err = color_cell_compression_est(mode, &params, best_err, subset_total_colors[subset], &subset_colors[subset][0]);
+			for ( uint32_t subset = 0; subset < total_subsets; subset++)
+			{
+				uint64_t err;
+				if (mode == 7)
+					err = color_cell_compression_est_mode7(mode, &params, best_err, subset_total_colors[subset], &subset_colors[subset][0]);
+				else
+					err = color_cell_compression_est(mode, &params, best_err, subset_total_colors[subset], &subset_colors[subset][0]);
 
-			total_subset_err += err;
+				total_subset_err += err;
 
-		} // subset
+			} // subset
+		}
 
 		if (total_subset_err < best_err)
 		{
@@ -2692,8 +2708,15 @@ struct solution
 	uint64_t m_err;
 };
 
+// Per-block partition estimates precomputed by the SIMD kernels for a whole group of blocks (see estimate_group_partitions()).
+// m_pErrs[mode] is nullptr if that mode's estimates weren't precomputed, in which case the scalar estimator runs.
+struct partition_estimates
+{
+	const uint64_t * m_pErrs[8];
+};
+
 static  uint32_t estimate_partition_list( uint32_t mode, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params, 
-	 solution * pSolutions,  int32_t max_solutions)
+	 solution * pSolutions,  int32_t max_solutions, const uint64_t * pPart_errs = nullptr)
 {
 	const  int32_t orig_max_solutions = max_solutions;
 
@@ -2745,35 +2768,40 @@ static  uint32_t estimate_partition_list( uint32_t mode, const  color_quad_i * p
 
 	for ( uint32_t partition = 0; partition < total_partitions; partition++)
 	{
-		const int * pPartition = (total_subsets == 3) ? &g_bc7_partition3[partition * 16] : &g_bc7_partition2[partition * 16];
-
-		 color_quad_i subset_colors[3][16];
-		 uint32_t subset_total_colors[3];
-		subset_total_colors[0] = 0;
-		subset_total_colors[1] = 0;
-		subset_total_colors[2] = 0;
+		uint64_t total_subset_err = 0;
 
-		for ( uint32_t index = 0; index < 16; index++)
+		if (pPart_errs)
+			total_subset_err = pPart_errs[partition];
+		else
 		{
-			const  uint32_t p = pPartition[index];
+			const int * pPartition = (total_subsets == 3) ? &g_bc7_partition3[partition * 16] : &g_bc7_partition2[partition * 16];
 
-			subset_colors[p][subset_total_colors[p]] = pPixels[index];
-			subset_total_colors[p]++;
-		}
-				
-		uint64_t total_subset_err = 0;
+			 color_quad_i subset_colors[3][16];
+			 uint32_t subset_total_colors[3];
+			subset_total_colors[0] = 0;
+			subset_total_colors[1] = 0;
+			subset_total_colors[2] = 0;
 
-		for ( uint32_t subset = 0; subset < total_subsets; subset++)
-		{
-			uint64_t err;
-			if (mode == 7)
-				err = color_cell_compression_est_mode7(mode, &params, UINT64_MAX, subset_total_colors[subset], &subset_colors[subset][0]);
-			else
-				err = color_cell_compression_est(mode, &params, UINT64_MAX, subset_total_colors[subset], &subset_colors[subset][0]);
+			for ( uint32_t index = 0; index < 16; index++)
+			{
+				const  uint32_t p = pPartition[index];
 
-			total_subset_err += err;
+				subset_colors[p][subset_total_colors[p]] = pPixels[index];
+				subset_total_colors[p]++;
+			}
 
-		} // subset
+			for ( uint32_t subset = 0; subset < total_subsets; subset++)
+			{
+				uint64_t err;
+				if (mode == 7)
+					err = color_cell_compression_est_mode7(mode, &params, UINT64_MAX, subset_total_colors[subset], &subset_colors[subset][0]);
+				else
+					err = color_cell_compression_est(mode, &params, UINT64_MAX, subset_total_colors[subset], &subset_colors[subset][0]);
+
+				total_subset_err += err;
+
+			} // subset
+		}
 
 		int32_t i;
 		for (i = 0; i < num_solutions; i++)
@@ -3511,7 +3539,7 @@ static void handle_alpha_block_mode5(const  color_quad_i * pPixels, const  bc7e_
 	pOpt_results5->m_used_lut = results5.m_used_lut;
 }
 
-static void handle_alpha_block(void * pBlock, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params,  color_cell_compressor_params * pParams, uint32_t lo_a, uint32_t hi_a, int forced_partition = -1, uint64_t* pBest_err = nullptr, bool* pUsed_lut = nullptr)
+static void handle_alpha_block(void * pBlock, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params,  color_cell_compressor_params * pParams, uint32_t lo_a, uint32_t hi_a, int forced_partition = -1, uint64_t* pBest_err = nullptr, bool* pUsed_lut = nullptr, const partition_estimates* pEst = nullptr)
 {
 	pParams->m_perceptual = pComp_params->m_perceptual;
 
@@ -3697,7 +3725,7 @@ static void handle_alpha_block(void * pBlock, const  color_quad_i * pPixels, con
 			num_solutions = 1;
 		}
 		else
-			num_solutions = estimate_partition_list(7, pPixels, pComp_params, solutions, pComp_params->m_alpha_settings.m_max_mode7_partitions_to_try);
+			num_solutions = estimate_partition_list(7, pPixels, pComp_params, solutions, pComp_params->m_alpha_settings.m_max_mode7_partitions_to_try, pEst ? pEst->m_pErrs[7] : nullptr);
 
 		 color_cell_compressor_params params7 = *pParams;
 		
@@ -3864,7 +3892,7 @@ static void handle_alpha_block(void * pBlock, const  color_quad_i * pPixels, con
 	encode_bc7_block(pBlock, &opt_results);
 }
 
-static void handle_opaque_block(void * pBlock, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params,  color_cell_compressor_params * pParams, int forced_partition = -1, uint64_t* pBest_err = nullptr, bool* pUsed_lut = nullptr)
+static void handle_opaque_block(void * pBlock, const  color_quad_i * pPixels, const  bc7e_compress_block_params * pComp_params,  color_cell_compressor_params * pParams, int forced_partition = -1, uint64_t* pBest_err = nullptr, bool* pUsed_lut = nullptr, const partition_estimates* pEst = nullptr)
 {
 	int selectors_temp[16];
 		
@@ -3915,12 +3943,12 @@ static void handle_opaque_block(void * pBlock, const  color_quad_i * pPixels, co
 		}
 		else if (pComp_params->m_opaque_settings.m_max_mode13_partitions_to_try == 1)
 		{
-			solutions2[0].m_index = estimate_partition(1, pPixels, pComp_params);
+			solutions2[0].m_index = estimate_partition(1, pPixels, pComp_params, pEst ? pEst->m_pErrs[1] : nullptr);
 			num_solutions2 = 1;
 		}
 		else
 		{
-			num_solutions2 = estimate_partition_list(1, pPixels, pComp_params, solutions2, pComp_params->m_opaque_settings.m_max_mode13_partitions_to_try);
+			num_solutions2 = estimate_partition_list(1, pPixels, pComp_params, solutions2, pComp_params->m_opaque_settings.m_max_mode13_partitions_to_try, pEst ? pEst->m_pErrs[1] : nullptr);
 		}
 	}
 		
@@ -4088,12 +4116,12 @@ static void handle_opaque_block(void * pBlock, const  color_quad_i * pPixels, co
 		}
 		else if (pComp_params->m_opaque_settings.m_max_mode0_partitions_to_try == 1)
 		{
-			solutions3[0].m_index = estimate_partition(0, pPixels, pComp_params);
+			solutions3[0].m_index = estimate_partition(0, pPixels, pComp_params, pEst ? pEst->m_pErrs[0] : nullptr);
 			num_solutions3 = 1;
 		}
 		else
 		{
-			num_solutions3 = estimate_partition_list(0, pPixels, pComp_params, solutions3, pComp_params->m_opaque_settings.m_max_mode0_partitions_to_try);
+			num_solutions3 = estimate_partition_list(0, pPixels, pComp_params, solutions3, pComp_params->m_opaque_settings.m_max_mode0_partitions_to_try, pEst ? pEst->m_pErrs[0] : nullptr);
 		}
 
 		pParams->m_pSelector_weights = g_bc7_weights3;
@@ -4397,12 +4425,12 @@ static void handle_opaque_block(void * pBlock, const  color_quad_i * pPixels, co
 		}
 		else if (pComp_params->m_opaque_settings.m_max_mode2_partitions_to_try == 1)
 		{
-			solutions3[0].m_index = estimate_partition(2, pPixels, pComp_params);
+			solutions3[0].m_index = estimate_partition(2, pPixels, pComp_params, pEst ? pEst->m_pErrs[2] : nullptr);
 			num_solutions3 = 1;
 		}
 		else
 		{
-			num_solutions3 = estimate_partition_list(2, pPixels, pComp_params, solutions3, pComp_params->m_opaque_settings.m_max_mode2_partitions_to_try);
+			num_solutions3 = estimate_partition_list(2, pPixels, pComp_params, solutions3, pComp_params->m_opaque_settings.m_max_mode2_partitions_to_try, pEst ? pEst->m_pErrs[2] : nullptr);
 		}
 
 		pParams->m_pSelector_weights = g_bc7_weights2;
@@ -4724,6 +4752,149 @@ uint64_t bc7e_compress_block_single_mode(uint64_t* pBlock, const uint32_t* pPixe
 	return best_err;
 }
 
+#if BASISU_SUPPORT_SSE
+// Defined in basisu_bc7e_spmd_kernels.inl (the SSE4.1 and AVX2 TUs): the estimate_partition()/estimate_partition_list()
+// inner loop over all of a mode's partitions, for 4 (SSE4.1) or 8 (AVX2) blocks per call, one block per lane.
+void estimate_partition_errors_sse41(const uint32_t* pPixels, uint32_t total_partitions, const int* pPartitions, uint32_t total_subsets, uint32_t num_selectors,
+	bool has_alpha, const float* pWeights, uint64_t* pErrs, uint32_t errs_stride);
+#if BASISU_SUPPORT_AVX2
+void estimate_partition_errors_avx2(const uint32_t* pPixels, uint32_t total_partitions, const int* pPartitions, uint32_t total_subsets, uint32_t num_selectors,
+	bool has_alpha, const float* pWeights, uint64_t* pErrs, uint32_t errs_stride);
+#endif
+#endif
+
+typedef void (*estimate_partition_errors_func)(const uint32_t* pPixels, uint32_t total_partitions, const int* pPartitions, uint32_t total_subsets, uint32_t num_selectors,
+	bool has_alpha, const float* pWeights, uint64_t* pErrs, uint32_t errs_stride);
+
+// Max. number of blocks the SIMD partition estimators process per call (the AVX2 lane count).
+#define BC7E_MAX_GROUP_BLOCKS (8)
+
+// The modes with partition estimates: 0, 1 (also used by mode 3), 2 and 7.
+#define BC7E_NUM_ESTIMATED_MODES (4)
+static const uint32_t g_bc7e_estimated_modes[BC7E_NUM_ESTIMATED_MODES] = { 0, 1, 2, 7 };
+
+// Returns true if handle_opaque_block() (modes 0-2) or handle_alpha_block() (mode 7) will call estimate_partition() or
+// estimate_partition_list() for this mode, and they'll actually evaluate its partitions (the list version returns
+// early if it's asked for all of them).
+static bool partition_estimates_needed( uint32_t mode, const  bc7e_compress_block_params * pComp_params)
+{
+	bool used;
+	 uint32_t max_partitions_to_try;
+	if (mode == 7)
+	{
+		used = pComp_params->m_alpha_settings.m_use_mode7;
+		max_partitions_to_try = pComp_params->m_alpha_settings.m_max_mode7_partitions_to_try;
+	}
+	else if (mode == 1)
+	{
+		used = !pComp_params->m_mode6_only && (pComp_params->m_opaque_settings.m_use_mode[1] || pComp_params->m_opaque_settings.m_use_mode[3]);
+		max_partitions_to_try = pComp_params->m_opaque_settings.m_max_mode13_partitions_to_try;
+	}
+	else if (mode == 0)
+	{
+		used = !pComp_params->m_mode6_only && pComp_params->m_opaque_settings.m_use_mode[0];
+		max_partitions_to_try = pComp_params->m_opaque_settings.m_max_mode0_partitions_to_try;
+	}
+	else
+	{
+		assert(mode == 2);
+		used = !pComp_params->m_mode6_only && pComp_params->m_opaque_settings.m_use_mode[2];
+		max_partitions_to_try = pComp_params->m_opaque_settings.m_max_mode2_partitions_to_try;
+	}
+
+	const  uint32_t total_partitions = minimumu(pComp_params->m_max_partitions_mode[mode], 1U << g_bc7_partition_bits[mode]);
+	if ((!used) || (total_partitions <= 1))
+		return false;
+
+	return (max_partitions_to_try == 1) || ((int32_t)max_partitions_to_try < (int32_t)total_partitions);
+}
+
+// Precomputes the partition estimates handle_opaque_block()/handle_alpha_block() will need for a group of num_blocks
+// (<= group_size) blocks with the SIMD kernel, so all the blocks are estimated at once. pEst[i] receives block i's
+// estimates (pointing into pGroup_errs). The results are bit-identical to the scalar estimators.
+static void estimate_group_partitions(estimate_partition_errors_func pEstimate_func,  uint32_t group_size, const  uint32_t * pPixelsRGBA,  uint32_t num_blocks,
+	const  bc7e_compress_block_params * pComp_params, uint64_t pGroup_errs[BC7E_NUM_ESTIMATED_MODES][BC7E_MAX_GROUP_BLOCKS][BC7E_MAX_PARTITIONS1],  partition_estimates * pEst)
+{
+	assert((num_blocks >= 1) && (num_blocks <= group_size) && (group_size <= BC7E_MAX_GROUP_BLOCKS));
+
+	// Classify the blocks the same way bc7e_compress_blocks() does: solid blocks aren't estimated at all, blocks with
+	// alpha only use mode 7's estimates, opaque blocks modes 0-2's (none if they're mode 6 only).
+	bool is_alpha[BC7E_MAX_GROUP_BLOCKS], is_opaque[BC7E_MAX_GROUP_BLOCKS];
+	bool any_alpha = false, any_opaque = false;
+
+	for ( uint32_t block_index = 0; block_index < num_blocks; block_index++)
+	{
+		const  uint32_t * pSrc = &pPixelsRGBA[block_index * 16];
+
+		bool all_same = true;
+		 uint32_t lo_a = 255;
+		for ( uint32_t i = 0; i < 16; i++)
+		{
+			all_same = all_same && (pSrc[i] == pSrc[0]);
+			lo_a = minimumu(lo_a, ((const  color_quad_u8 *)pSrc)[i].m_c[3]);
+		}
+
+		is_alpha[block_index] = !all_same && (lo_a < 255);
+		is_opaque[block_index] = !all_same && (lo_a == 255) && !pComp_params->m_mode6_only;
+
+		any_alpha = any_alpha || is_alpha[block_index];
+		any_opaque = any_opaque || is_opaque[block_index];
+
+		for ( uint32_t m = 0; m < 8; m++)
+			pEst[block_index].m_pErrs[m] = nullptr;
+	}
+
+	// The kernel always processes a full group, so pad a partial one with copies of its last block.
+	 uint32_t padded_pixels[BC7E_MAX_GROUP_BLOCKS * 16];
+	if (num_blocks < group_size)
+	{
+		memcpy(padded_pixels, pPixelsRGBA, num_blocks * 16 * sizeof(uint32_t));
+		for ( uint32_t block_index = num_blocks; block_index < group_size; block_index++)
+			memcpy(&padded_pixels[block_index * 16], &pPixelsRGBA[(num_blocks - 1) * 16], 16 * sizeof(uint32_t));
+		pPixelsRGBA = padded_pixels;
+	}
+
+	for ( uint32_t mode_index = 0; mode_index < BC7E_NUM_ESTIMATED_MODES; mode_index++)
+	{
+		const  uint32_t mode = g_bc7e_estimated_modes[mode_index];
+
+		if (!((mode == 7) ? any_alpha : any_opaque) || !partition_estimates_needed(mode, pComp_params))
+			continue;
+
+		// The error weights estimate_partition*() set up, and then whether color_cell_compression_est*() takes its
+		// weighted or unweighted path. The kernel always weights; weights of 1.0 give identical results.
+		 uint32_t weights[4];
+		memcpy(weights, pComp_params->m_weights, sizeof(weights));
+		if (mode >= 6)
+		{
+			for ( uint32_t c = 0; c < 4; c++)
+				weights[c] *= pComp_params->m_alpha_settings.m_mode67_error_weight_mul[c];
+		}
+
+		bool weighted;
+		if (mode == 7)
+			weighted = (!pComp_params->m_perceptual) && ((weights[0] != 1) || (weights[1] != 1) || (weights[2] != 1) || (weights[3] != 1));
+		else
+			weighted = (weights[0] != 1) || (weights[1] != 1) || (weights[2] != 1);
+
+		float fweights[4];
+		for ( uint32_t c = 0; c < 4; c++)
+			fweights[c] = weighted ? (float)(weights[c]) : 1.0f;
+
+		const  uint32_t total_subsets = g_bc7_num_subsets[mode];
+		const  uint32_t total_partitions = minimumu(pComp_params->m_max_partitions_mode[mode], 1U << g_bc7_partition_bits[mode]);
+
+		pEstimate_func(pPixelsRGBA, total_partitions, (total_subsets == 3) ? g_bc7_partition3 : g_bc7_partition2, total_subsets, 1 << g_bc7_color_index_bitcount[mode],
+			mode == 7, fweights, &pGroup_errs[mode_index][0][0], BC7E_MAX_PARTITIONS1);
+
+		for ( uint32_t block_index = 0; block_index < num_blocks; block_index++)
+		{
+			if ((mode == 7) ? is_alpha[block_index] : is_opaque[block_index])
+				pEst[block_index].m_pErrs[mode] = pGroup_errs[mode_index][block_index];
+		}
+	}
+}
+
  void bc7e_compress_blocks( uint32_t num_blocks,  uint64_t *  pBlocks, const  uint32_t *  pPixelsRGBA, const  bc7e_compress_block_params *  pComp_params, uint8_t * pUsed_lut)
 {
 	if (!g_codec_initialized)
@@ -4745,9 +4916,47 @@ uint64_t bc7e_compress_block_single_mode(uint64_t* pBlock, const uint32_t* pPixe
 	assert(pComp_params->m_mode4_index_mask != 0);
 	assert(pComp_params->m_mode5_rotation_mask != 0);
 	assert(pComp_params->m_uber1_mask != 0);
+
+	// With SSE4.1/AVX2 the partition estimates (the bulk of the work at the lower levels) are computed 4 or 8 blocks at a
+	// time up front, then each block is finished one at a time below exactly like the scalar path.
+	estimate_partition_errors_func pEstimate_func = nullptr;
+	 uint32_t group_size = 1;
+#if BASISU_SUPPORT_SSE
+	if (basisu::g_cpu_supports_sse41)
+	{
+		pEstimate_func = estimate_partition_errors_sse41;
+		group_size = 4;
+	}
+#if BASISU_SUPPORT_AVX2
+	if (basisu::g_cpu_supports_avx2)
+	{
+		pEstimate_func = estimate_partition_errors_avx2;
+		group_size = 8;
+	}
+#endif
+#endif
+
+	// Nothing to precompute if these params never estimate partitions (e.g. ultrafast).
+	bool any_estimates = false;
+	for ( uint32_t mode_index = 0; mode_index < BC7E_NUM_ESTIMATED_MODES; mode_index++)
+		any_estimates = any_estimates || partition_estimates_needed(g_bc7e_estimated_modes[mode_index], pComp_params);
+	if (!any_estimates)
+	{
+		pEstimate_func = nullptr;
+		group_size = 1;
+	}
+
+	uint64_t group_errs[BC7E_NUM_ESTIMATED_MODES][BC7E_MAX_GROUP_BLOCKS][BC7E_MAX_PARTITIONS1];
+	 partition_estimates group_est[BC7E_MAX_GROUP_BLOCKS];
 	
 	for (int32_t block_index = 0; block_index < (int32_t)num_blocks; block_index++)
 	{
+		const  uint32_t group_index = (uint32_t)block_index % group_size;
+		if ((pEstimate_func) && (!group_index))
+			estimate_group_partitions(pEstimate_func, group_size, &pPixelsRGBA[block_index * 16], minimumu(group_size, num_blocks - block_index), pComp_params, group_errs, group_est);
+
+		const  partition_estimates * pEst = pEstimate_func ? &group_est[group_index] : nullptr;
+
 		const  color_quad_u8 * pSrcPixels = &((const  color_quad_u8 *)(pPixelsRGBA))[block_index * 16];
 
 		 color_quad_i temp_pixels[16];
@@ -4794,13 +5003,13 @@ uint64_t bc7e_compress_block_single_mode(uint64_t* pBlock, const uint32_t* pPixe
 			const bool has_alpha = (lo_a < 255);
 			// TODO: alpha block mode 6 only
 			cif (has_alpha)
-				handle_alpha_block(pBlock, temp_pixels, pComp_params, &params, (int)lo_a, (int)hi_a, -1, nullptr, &block_used_lut);
+				handle_alpha_block(pBlock, temp_pixels, pComp_params, &params, (int)lo_a, (int)hi_a, -1, nullptr, &block_used_lut, pEst);
 			else
 			{
 				if (pComp_params->m_mode6_only)
 					handle_opaque_block_mode6(pBlock, temp_pixels, pComp_params, &params, &block_used_lut);
 				else
-					handle_opaque_block(pBlock, temp_pixels, pComp_params, &params, -1, nullptr, &block_used_lut);
+					handle_opaque_block(pBlock, temp_pixels, pComp_params, &params, -1, nullptr, &block_used_lut, pEst);
 			}
 		}
 
@@ -0,0 +1,24 @@
+// basisu_bc7e_spmd_avx2.cpp -- AVX2 ISA translation unit for the bc7e_scalar BC7 encoder's SIMD kernels.
+//
+// Same as basisu_bc7e_spmd_sse.cpp, but with the 8-wide cppspmd_avx2.h framework: the kernels process 8 blocks per
+// call. Must be compiled with AVX2 and FMA enabled; only called when g_cpu_supports_avx2 is true.
+
+#include "basisu_enc.h" // BASISU_SUPPORT_AVX2
+
+#if BASISU_SUPPORT_AVX2
+
+#if !defined(__AVX2__)
+#error basisu_bc7e_spmd_avx2.cpp must be compiled with AVX2 enabled (-mavx2 -mfma, or /arch:AVX2)
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "cppspmd_avx2.h"
+#include "cppspmd_type_aliases.h"
+
+using namespace CPPSPMD;
+
+#include "basisu_bc7e_spmd_kernels.inl"
+
+#endif // BASISU_SUPPORT_AVX2
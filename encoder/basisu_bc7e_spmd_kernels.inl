@@ -0,0 +1,136 @@
+// basisu_bc7e_spmd_kernels.inl -- Do NOT directly include.
+//
+// cppspmd kernels for the bc7e_scalar BC7 encoder. Included by basisu_bc7e_spmd_sse.cpp (SSE4.1, 4 lanes) and
+// basisu_bc7e_spmd_avx2.cpp (AVX2, 8 lanes) from file scope after cppspmd_sse.h/cppspmd_avx2.h + "using namespace CPPSPMD;".
+// LANES = BLOCKS: PROGRAM_COUNT independent blocks per vector, one per lane. The partition tables are uniform, so every
+// lane walks the same subsets/pixels in the same order as the scalar code.
+//
+// These kernels MUST stay bit-exact with their scalar counterparts in basisu_bc7e_scalar.cpp: same float operations
+// in the same order, no FMA (the AVX2 TU is built with -ffp-contract=off and we never call vfma here).
+
+namespace CPPSPMD_NAME(bc7e_spmd_kern)
+{
+	// Must match BC7E_DENOM_BIAS in basisu_bc7e_scalar.cpp.
+	const float cDenomBias = 0.0000125f;
+
+	// Vectorized color_cell_compression_est()/color_cell_compression_est_mode7(), evaluated for every partition of one
+	// mode (the inner loop of estimate_partition() and estimate_partition_list()). pPixels = PROGRAM_COUNT blocks x 16
+	// RGBA8 pixels, block-contiguous. pPartitions = total_partitions x 16 subset indices. pWeights = the effective
+	// RGBA error weights (all 1.0 where the scalar code takes its unweighted path - identical results). has_alpha
+	// selects the mode 7 estimator (alpha is part of the line fit). Writes pErrs[lane * errs_stride + partition] =
+	// the sum of the subsets' (int64) estimated errors, exactly as the scalar code computes total_subset_err.
+	struct estimate_partition_errors : spmd_kernel
+	{
+		void _call(const int32_t* pPixels, uint32_t total_partitions, const int* pPartitions, uint32_t total_subsets, uint32_t num_selectors,
+			bool has_alpha, const float* pWeights, uint64_t* pErrs, uint32_t errs_stride)
+		{
+			vfloat R[16], G[16], B[16], A[16];
+			for (int i = 0; i < 16; i++)
+			{
+				const vint c = load_all_strided(pPixels + i, 16);
+				R[i] = (vfloat)(c & vint(0xFF));
+				G[i] = (vfloat)(VINT_SHIFT_RIGHT(c, 8) & vint(0xFF));
+				B[i] = (vfloat)(VINT_SHIFT_RIGHT(c, 16) & vint(0xFF));
+				A[i] = (vfloat)VUINT_SHIFT_RIGHT(c, 24);
+			}
+
+			const float n1 = (float)num_selectors - 1;
+			const vfloat scale_num(n1);
+			const vfloat inv_n(1.0f / n1);
+			const vfloat wr(pWeights[0]), wg(pWeights[1]), wb(pWeights[2]), wa(pWeights[3]);
+			const vfloat zero(0.0f), one(1.0f), half(.5f), denom_bias(cDenomBias);
+
+			CPPSPMD_DECL(float, subset_errs[PROGRAM_COUNT]);
+
+			for (uint32_t partition = 0; partition < total_partitions; partition++)
+			{
+				const int* pPartition = &pPartitions[partition * 16];
+
+				uint64_t total_errs[PROGRAM_COUNT];
+				for (int l = 0; l < PROGRAM_COUNT; l++)
+					total_errs[l] = 0;
+
+				for (uint32_t subset = 0; subset < total_subsets; subset++)
+				{
+					vfloat lr(255.0f), lg(255.0f), lb(255.0f), la(255.0f);
+					vfloat hr(0.0f), hg(0.0f), hb(0.0f), ha(0.0f);
+
+					for (int i = 0; i < 16; i++)
+					{
+						if (pPartition[i] != (int)subset)
+							continue;
+
+						lr = min(lr, R[i]); lg = min(lg, G[i]); lb = min(lb, B[i]);
+						hr = max(hr, R[i]); hg = max(hg, G[i]); hb = max(hb, B[i]);
+						if (has_alpha)
+						{
+							la = min(la, A[i]);
+							ha = max(ha, A[i]);
+						}
+					}
+
+					const vfloat dir = hr - lr, dig = hg - lg, dib = hb - lb;
+					const vfloat dia = ha - la;
+
+					vfloat low = dir * lr + dig * lg + dib * lb;
+					vfloat high = dir * hr + dig * hg + dib * hb;
+					if (has_alpha)
+					{
+						low = low + dia * la;
+						high = high + dia * ha;
+					}
+
+					const vfloat scale = scale_num / ((high - low) + denom_bias);
+
+					vfloat total_errf(0.0f);
+
+					for (int i = 0; i < 16; i++)
+					{
+						if (pPartition[i] != (int)subset)
+							continue;
+
+						vfloat d = dir * R[i] + dig * G[i] + dib * B[i];
+						if (has_alpha)
+							d = d + dia * A[i];
+
+						const vfloat s = min(max(floor((d - low) * scale + half) * inv_n, zero), one);
+
+						const vfloat dr = (lr + dir * s) - R[i];
+						const vfloat dg = (lg + dig * s) - G[i];
+						const vfloat db = (lb + dib * s) - B[i];
+
+						vfloat e = wr * dr * dr + wg * dg * dg + wb * db * db;
+						if (has_alpha)
+						{
+							const vfloat da = (la + dia * s) - A[i];
+							e = e + wa * da * da;
+						}
+
+						total_errf = total_errf + e;
+					}
+
+					storeu_linear_all(subset_errs, total_errf);
+
+					for (int l = 0; l < PROGRAM_COUNT; l++)
+						total_errs[l] += (uint64_t)(int64_t)subset_errs[l];
+
+				} // subset
+
+				for (int l = 0; l < PROGRAM_COUNT; l++)
+					pErrs[l * errs_stride + partition] = total_errs[l];
+
+			} // partition
+		}
+	};
+} // namespace bc7e_spmd_kern
+
+// ISA wrapper (estimate_partition_errors_sse41/_avx2), declared in basisu_bc7e_scalar.cpp.
+namespace bc7e_scalar
+{
+	void CPPSPMD_NAME(estimate_partition_errors)(const uint32_t* pPixels, uint32_t total_partitions, const int* pPartitions, uint32_t total_subsets, uint32_t num_selectors,
+		bool has_alpha, const float* pWeights, uint64_t* pErrs, uint32_t errs_stride)
+	{
+		spmd_call<CPPSPMD_NAME(bc7e_spmd_kern)::estimate_partition_errors>((const int32_t*)pPixels, total_partitions, pPartitions, total_subsets, num_selectors,
+			has_alpha, pWeights, pErrs, errs_stride);
+	}
+}
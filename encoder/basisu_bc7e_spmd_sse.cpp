@@ -0,0 +1,20 @@
+// basisu_bc7e_spmd_sse.cpp -- SSE4.1 ISA translation unit for the bc7e_scalar BC7 encoder's SIMD kernels.
+//
+// Mirrors basisu_bc15_spmd_sse.cpp: select the ISA, include the cppspmd framework, then pull in the kernel .inl.
+
+#include "basisu_enc.h" // BASISU_SUPPORT_SSE
+
+#if BASISU_SUPPORT_SSE
+
+#define CPPSPMD_SSE2 0
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "cppspmd_sse.h"
+#include "cppspmd_type_aliases.h"
+
+using namespace CPPSPMD;
+
+#include "basisu_bc7e_spmd_kernels.inl"
+
+#endif // BASISU_SUPPORT_SSE
@@ -289,12 +289,15 @@ namespace basisu
 		m_ktx2_file_size(0),
 		m_ktx2_bits_per_texel(0.0f),
 		m_total_blocks(0),
+		m_peak_buffer_bytes(0),
 		m_hdr_image_scale(1.0f),
 		m_ldr_to_hdr_upconversion_nit_multiplier(1.0f),
 		m_upconverted_any_ldr_images(false),
 		m_any_source_image_has_alpha(false),
 		m_opencl_failed(false),
-		m_has_been_processed(false)
+		m_has_been_processed(false),
+		m_process_start_time(0.0f),
+		m_calibrated_effort_level(-1)
 	{
 		debug_printf("basis_compressor::basis_compressor\n");
 		
@@ -385,6 +388,15 @@ namespace basisu
 				return false;
 			}
 		}
+		else if ((m_params.m_strip_height > 0) && (m_params.m_pStrip_source_callback))
+		{
+			// Strip encoding reads the source rows through the callback.
+			if (m_params.m_source_images.size() || m_params.m_source_images_hdr.size() || m_params.m_source_mipmap_images.size() || m_params.m_source_mipmap_images_hdr.size())
+			{
+				assert(0);
+				return false;
+			}
+		}
 		else
 		{
 			// They didn't tell us to read any source files, so check for no LDR/HDR source images.
@@ -458,6 +470,7 @@ namespace basisu
 		m_basis_bits_per_texel = 0.0f;
 		m_ktx2_file_size = 0;
 		m_ktx2_bits_per_texel = 0.0f;
+		m_peak_buffer_bytes = 0;
 
 		check_for_hdr_inputs();
 
@@ -573,6 +586,7 @@ namespace basisu
 			debug_printf("m_tex_type: %u\n", m_params.m_tex_type);
 			debug_printf("m_userdata0: 0x%X, m_userdata1: 0x%X\n", m_params.m_userdata0, m_params.m_userdata1);
 			debug_printf("m_us_per_frame: %i (%f fps)\n", m_params.m_us_per_frame, m_params.m_us_per_frame ? 1.0f / (m_params.m_us_per_frame / 1000000.0f) : 0);
+			debug_printf("m_etc1s_video_iframe_interval: %u\n", m_params.m_etc1s_video_iframe_interval);
 			debug_printf("m_pack_uastc_ldr_4x4_flags: 0x%X\n", m_params.m_pack_uastc_ldr_4x4_flags);
 			
 			PRINT_BOOL_VALUE(m_rdo_uastc_ldr_4x4);
@@ -593,6 +607,7 @@ namespace basisu
 			if (m_params.m_pGlobal_codebooks)
 			{
 				debug_printf("Global codebook endpoints: %u selectors: %u\n", m_params.m_pGlobal_codebooks->get_endpoints().size(), m_params.m_pGlobal_codebooks->get_selectors().size());
+				PRINT_BOOL_VALUE(m_fast_global_codebook_search);
 			}
 
 			PRINT_BOOL_VALUE(m_create_ktx2_file);
@@ -825,6 +840,11 @@ namespace basisu
 		return true;
 	}
 		
+	// Overall progress percentages (see basis_compressor_params::m_pProgress_callback) at the end of each process() stage.
+	const float PROGRESS_SOURCE_IMAGES_END = 5.0f;
+	const float PROGRESS_ETC1S_FRONTEND_END = 70.0f;
+	const float PROGRESS_ENCODE_END = 90.0f;
+
 	basis_compressor::error_code basis_compressor::process()
 	{
 		debug_printf("basis_compressor::process\n");
@@ -836,6 +856,511 @@ namespace basisu
 		}
 		m_has_been_processed = true;
 
+		m_progress.init(m_params.m_pProgress_callback, m_params.m_pProgress_callback_data, m_params.m_encode_deadline_secs);
+
+		m_process_start_time = get_interval_timer();
+		m_calibrated_effort_level = -1;
+		m_effort_controller.clear();
+
+		if (m_params.m_trace)
+			trace_recorder::begin_session();
+
+		error_code ec;
+		{
+			BASISU_TRACE_ZONE("basis_compressor::process");
+			ec = process_impl();
+		}
+
+		if (m_params.m_trace)
+			trace_recorder::end_session();
+
+		const float encode_time_secs = (float)(get_interval_timer() - m_process_start_time);
+		const uint64_t peak_rss_bytes = get_peak_rss_bytes();
+		for (uint32_t i = 0; i < m_stats.size(); i++)
+		{
+			m_stats[i].m_encode_time_secs = encode_time_secs;
+			m_stats[i].m_peak_rss_bytes = peak_rss_bytes;
+		}
+
+		// A stopped encode fails wherever it happened to notice, so report why it stopped instead.
+		if ((ec != cECSuccess) && (m_progress.is_stopped()))
+		{
+			if (m_progress.get_status() == encode_progress::status::cDeadlineExceeded)
+			{
+				if (m_params.m_status_output)
+					fmt_printf("basis_compressor::process: Deadline of {} secs exceeded\n", (float)m_params.m_encode_deadline_secs);
+
+				ec = cECDeadlineExceeded;
+			}
+			else
+			{
+				if (m_params.m_status_output)
+					fmt_printf("basis_compressor::process: Cancelled\n");
+
+				ec = cECCancelled;
+			}
+		}
+
+		return ec;
+	}
+
+	// Maps encoding slice slice_index to its share (by block count) of the encoding stage's overall progress range.
+	void basis_compressor::set_progress_range_for_slice(uint32_t slice_index)
+	{
+		uint64_t total_blocks = 0, first_block = 0;
+		for (uint32_t i = 0; i < m_slice_descs.size(); i++)
+		{
+			const uint64_t num_blocks = (uint64_t)m_slice_descs[i].m_num_blocks_x * m_slice_descs[i].m_num_blocks_y;
+			if (i < slice_index)
+				first_block += num_blocks;
+			total_blocks += num_blocks;
+		}
+
+		const uint64_t last_block = first_block + (uint64_t)m_slice_descs[slice_index].m_num_blocks_x * m_slice_descs[slice_index].m_num_blocks_y;
+		
+		const float scale = (PROGRESS_ENCODE_END - PROGRESS_SOURCE_IMAGES_END) / (float)maximum<uint64_t>(total_blocks, 1);
+		m_progress.set_range(PROGRESS_SOURCE_IMAGES_END + (float)first_block * scale, PROGRESS_SOURCE_IMAGES_END + (float)last_block * scale);
+	}
+
+	effort_controller::effort_controller()
+	{
+		clear();
+	}
+
+	void effort_controller::clear()
+	{
+		m_enabled = false;
+		m_min_level = 0;
+		m_max_level = 0;
+		m_level_secs.clear();
+		m_deadline = 0.0f;
+		m_total_units = 0;
+		m_min_units_per_decision = 0;
+		m_level.store(0);
+		m_units_done.store(0);
+		m_used_levels.store(0);
+		m_level_start_time = 0.0f;
+		m_level_start_units = 0;
+	}
+
+	void effort_controller::init(int level, int min_level, int max_level, const basisu::vector<double>& level_secs, double deadline, uint64_t total_units)
+	{
+		assert((min_level <= level) && (level <= max_level) && ((max_level - min_level) < 32));
+
+		m_enabled = true;
+		m_min_level = min_level;
+		m_max_level = max_level;
+		m_level_secs = level_secs;
+		m_deadline = deadline;
+		m_total_units = total_units;
+		
+		// Don't judge a level's speed from less than ~3% of the work.
+		m_min_units_per_decision = maximum<uint64_t>(1, total_units / 32);
+
+		m_level.store(level);
+		m_units_done.store(0);
+		m_used_levels.store(0);
+		m_level_start_time = get_interval_timer();
+		m_level_start_units = 0;
+	}
+
+	int effort_controller::acquire_level()
+	{
+		const int level = m_level.load(std::memory_order_relaxed);
+		m_used_levels.fetch_or(1U << (level - m_min_level), std::memory_order_relaxed);
+		return level;
+	}
+
+	void effort_controller::update(uint64_t num_units)
+	{
+		if (!m_enabled)
+			return;
+
+		const uint64_t units_done = m_units_done.fetch_add(num_units) + num_units;
+
+		// Whoever holds the lock decides for everyone, the other workers get back to work.
+		std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return;
+
+		if (units_done >= m_total_units)
+			return;
+
+		const uint64_t units_at_level = units_done - m_level_start_units;
+		if (units_at_level < m_min_units_per_decision)
+			return;
+
+		const double cur_time = get_interval_timer();
+		const double projected_secs = ((cur_time - m_level_start_time) / (double)units_at_level) * (double)(m_total_units - units_done);
+		const double remaining_secs = m_deadline - cur_time;
+
+		const int level = m_level.load();
+		int new_level = level;
+
+		if (projected_secs > remaining_secs)
+		{
+			if (level > m_min_level)
+				new_level = level - 1;
+		}
+		else if (level < m_max_level)
+		{
+			// Only go up if calibration timed both levels, and the slower one is predicted to fit with some headroom to spare.
+			const double cur_level_secs = m_level_secs[level - m_min_level], next_level_secs = m_level_secs[level + 1 - m_min_level];
+			
+			const double HEADROOM = .8f;
+			if ((cur_level_secs > 0.0f) && (next_level_secs > 0.0f) && ((projected_secs * (next_level_secs / cur_level_secs)) < (remaining_secs * HEADROOM)))
+				new_level = level + 1;
+		}
+
+		if (new_level != level)
+		{
+			m_level.store(new_level);
+			m_level_start_time = cur_time;
+			m_level_start_units = units_done;
+		}
+	}
+
+	int effort_controller::get_min_used_level() const
+	{
+		const uint32_t used_levels = m_used_levels.load();
+		if (!used_levels)
+			return -1;
+
+		for (int i = 0; i < 32; i++)
+			if (used_levels & (1U << i))
+				return m_min_level + i;
+
+		return -1;
+	}
+
+	int effort_controller::get_max_used_level() const
+	{
+		const uint32_t used_levels = m_used_levels.load();
+		if (!used_levels)
+			return -1;
+
+		for (int i = 31; i >= 0; i--)
+			if (used_levels & (1U << i))
+				return m_min_level + i;
+
+		return -1;
+	}
+
+	// Time-budgeted effort: the native effort level range of each format (see basis_compressor_params::m_target_encode_time_secs).
+	static void get_format_effort_level_range(basist::basis_tex_format fmt, int& min_level, int& max_level)
+	{
+		if (fmt == basist::basis_tex_format::cETC1S)
+		{
+			min_level = 0;
+			max_level = BASISU_MAX_ETC1S_COMPRESSION_LEVEL;
+		}
+		else if (fmt == basist::basis_tex_format::cUASTC_LDR_4x4)
+		{
+			min_level = cPackUASTCLevelFastest;
+			max_level = cPackUASTCLevelVerySlow;
+		}
+		else if (fmt == basist::basis_tex_format::cUASTC_HDR_4x4)
+		{
+			min_level = uastc_hdr_4x4_codec_options::cMinLevel;
+			max_level = uastc_hdr_4x4_codec_options::cMaxLevel;
+		}
+		else if ((fmt == basist::basis_tex_format::cASTC_HDR_6x6) || (fmt == basist::basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE))
+		{
+			min_level = 0;
+			max_level = astc_6x6_hdr::ASTC_HDR_6X6_MAX_USER_COMP_LEVEL;
+		}
+		else if (fmt == basist::basis_tex_format::cXUBC7)
+		{
+			min_level = 0;
+			max_level = 10;
+		}
+		else
+		{
+			assert(basis_tex_format_is_xuastc_ldr(fmt) || basis_tex_format_is_astc_ldr(fmt));
+			min_level = astc_ldr::EFFORT_LEVEL_MIN;
+			max_level = astc_ldr::EFFORT_LEVEL_MAX;
+		}
+	}
+
+	static void set_format_effort_level(basis_compressor_params& params, basist::basis_tex_format fmt, int level)
+	{
+		if (fmt == basist::basis_tex_format::cETC1S)
+			params.m_etc1s_compression_level = level;
+		else if (fmt == basist::basis_tex_format::cUASTC_LDR_4x4)
+			params.m_pack_uastc_ldr_4x4_flags = (params.m_pack_uastc_ldr_4x4_flags & ~cPackUASTCLevelMask) | level;
+		else if (fmt == basist::basis_tex_format::cUASTC_HDR_4x4)
+			params.m_uastc_hdr_4x4_options.set_quality_level(level);
+		else if ((fmt == basist::basis_tex_format::cASTC_HDR_6x6) || (fmt == basist::basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE))
+			params.m_astc_hdr_6x6_options.set_user_level(level);
+		else if (fmt == basist::basis_tex_format::cXUBC7)
+			params.m_xubc7_effort_level = level;
+		else
+			params.m_xuastc_ldr_effort_level = level;
+	}
+
+	// Picks the highest effort level whose encode, extrapolated from timed trial encodes of a block sample cropped from the
+	// first slice, is predicted to fit in what's left of m_target_encode_time_secs. Returns false if the encode was stopped.
+	bool basis_compressor::calibrate_effort_level()
+	{
+		BASISU_TRACE_ZONE("calibrate_effort_level");
+
+		interval_timer tm;
+		tm.start();
+
+		int min_level = 0, max_level = 0;
+		get_format_effort_level_range(m_fmt_mode, min_level, max_level);
+
+		m_effort_level_secs.resize(0);
+		m_effort_level_secs.resize(max_level - min_level + 1);
+
+		const double target_end_time = m_process_start_time + m_params.m_target_encode_time_secs;
+		
+		// Trial encodes may use at most this much of the budget, the rest is for the real encode.
+		const double MAX_CALIBRATION_FRACTION = .2f;
+		const double calibration_end_time = get_interval_timer() + m_params.m_target_encode_time_secs * MAX_CALIBRATION_FRACTION;
+
+		// Sample at least one 256 block batch per thread, so the trial encodes see the same parallelism as the real one. The sample is
+		// a grid of tiles spread over the first slice (which is already padded to whole blocks), so it sees most of the image's content.
+		const uint32_t block_width = get_block_width(), block_height = get_block_height();
+		const uint32_t slice_width = m_params.m_hdr ? m_slice_images_hdr[0].get_width() : m_slice_images[0].get_width();
+		const uint32_t slice_height = m_params.m_hdr ? m_slice_images_hdr[0].get_height() : m_slice_images[0].get_height();
+		const uint32_t slice_blocks_x = slice_width / block_width, slice_blocks_y = slice_height / block_height;
+
+		const uint32_t target_sample_blocks = maximum<uint32_t>(1024, 256 * (uint32_t)m_params.m_pJob_pool->get_total_threads());
+		
+		const uint32_t MAX_SAMPLE_TILES_PER_AXIS = 4;
+		uint32_t sample_blocks_x = minimum<uint32_t>(slice_blocks_x, (uint32_t)ceilf(sqrtf((float)target_sample_blocks)));
+		uint32_t sample_blocks_y = minimum<uint32_t>(slice_blocks_y, (target_sample_blocks + sample_blocks_x - 1) / sample_blocks_x);
+		
+		const uint32_t num_tiles_x = minimum(MAX_SAMPLE_TILES_PER_AXIS, sample_blocks_x), num_tiles_y = minimum(MAX_SAMPLE_TILES_PER_AXIS, sample_blocks_y);
+		const uint32_t tile_blocks_x = sample_blocks_x / num_tiles_x, tile_blocks_y = sample_blocks_y / num_tiles_y;
+		sample_blocks_x = tile_blocks_x * num_tiles_x;
+		sample_blocks_y = tile_blocks_y * num_tiles_y;
+
+		const uint32_t sample_width = sample_blocks_x * block_width, sample_height = sample_blocks_y * block_height;
+
+		// The trial encodes run the whole pipeline (minus source image processing and output files) on the sample image.
+		basis_compressor_params trial_params;
+		{
+			// Don't deep copy the source images, which may be large.
+			basisu::vector<image> source_images;
+			basisu::vector<imagef> source_images_hdr;
+			basisu::vector< basisu::vector<image> > source_mipmap_images;
+			basisu::vector< basisu::vector<imagef> > source_mipmap_images_hdr;
+			source_images.swap(m_params.m_source_images);
+			source_images_hdr.swap(m_params.m_source_images_hdr);
+			source_mipmap_images.swap(m_params.m_source_mipmap_images);
+			source_mipmap_images_hdr.swap(m_params.m_source_mipmap_images_hdr);
+
+			trial_params = m_params;
+
+			source_images.swap(m_params.m_source_images);
+			source_images_hdr.swap(m_params.m_source_images_hdr);
+			source_mipmap_images.swap(m_params.m_source_mipmap_images);
+			source_mipmap_images_hdr.swap(m_params.m_source_mipmap_images_hdr);
+		}
+
+		trial_params.m_read_source_images = false;
+		trial_params.m_source_filenames.clear();
+		trial_params.m_source_alpha_filenames.clear();
+		trial_params.m_out_filename.clear();
+		trial_params.m_write_output_basis_or_ktx2_files = false;
+		trial_params.m_status_output = false;
+		trial_params.m_debug = false;
+		trial_params.m_debug_images = false;
+		trial_params.m_print_stats = false;
+		// Stats and validation would skew the trial timings. The trials don't start their own trace session (with m_trace set they
+		// already show up under the calibrate_effort_level zone).
+		trial_params.m_compute_stats = false;
+		trial_params.m_validate_output_data = false;
+		trial_params.m_trace = false;
+		trial_params.m_tex_type = basist::cBASISTexType2D;
+		trial_params.m_mip_gen = false;
+		trial_params.m_y_flip = false;
+		trial_params.m_renormalize = false;
+		for (uint32_t i = 0; i < 4; i++)
+			trial_params.m_swizzle[i] = (uint8_t)i;
+		trial_params.m_pProgress_callback = nullptr;
+		trial_params.m_pProgress_callback_data = nullptr;
+		trial_params.m_target_encode_time_secs = 0.0f;
+
+		if (m_params.m_hdr)
+		{
+			trial_params.m_source_images_hdr.resize(1);
+			trial_params.m_source_images_hdr[0].resize(sample_width, sample_height);
+		}
+		else
+		{
+			trial_params.m_source_images.resize(1);
+			trial_params.m_source_images[0].resize(sample_width, sample_height);
+		}
+
+		for (uint32_t tile_y = 0; tile_y < num_tiles_y; tile_y++)
+		{
+			for (uint32_t tile_x = 0; tile_x < num_tiles_x; tile_x++)
+			{
+				const uint32_t src_block_x = (num_tiles_x > 1) ? (((slice_blocks_x - tile_blocks_x) * tile_x) / (num_tiles_x - 1)) : ((slice_blocks_x - tile_blocks_x) / 2);
+				const uint32_t src_block_y = (num_tiles_y > 1) ? (((slice_blocks_y - tile_blocks_y) * tile_y) / (num_tiles_y - 1)) : ((slice_blocks_y - tile_blocks_y) / 2);
+
+				const int src_x = src_block_x * block_width, src_y = src_block_y * block_height;
+				const int dst_x = tile_x * tile_blocks_x * block_width, dst_y = tile_y * tile_blocks_y * block_height;
+				const int w = tile_blocks_x * block_width, h = tile_blocks_y * block_height;
+
+				if (m_params.m_hdr)
+					trial_params.m_source_images_hdr[0].blit(m_slice_images_hdr[0], src_x, src_y, w, h, dst_x, dst_y);
+				else
+					trial_params.m_source_images[0].blit(m_slice_images[0], src_x, src_y, w, h, dst_x, dst_y);
+			}
+		}
+
+		// Returns the time of a trial encode at this level, or -1 if it failed or ran past max_secs.
+		auto time_trial = [&](const basis_compressor_params& params, int level, double max_secs) -> double
+		{
+			if (max_secs <= 0.0f)
+				return -1.0f;
+
+			basis_compressor_params level_params(params);
+			set_format_effort_level(level_params, m_fmt_mode, level);
+			level_params.m_encode_deadline_secs = (float)max_secs;
+
+			basis_compressor trial_comp;
+			if (!trial_comp.init(level_params))
+				return -1.0f;
+
+			interval_timer trial_tm;
+			trial_tm.start();
+
+			if (trial_comp.process() != cECSuccess)
+				return -1.0f;
+
+			return trial_tm.get_elapsed_secs();
+		};
+
+		// Encode time isn't linear in the number of blocks (there's fixed overhead, and ETC1S's codebooks grow with the image),
+		// and how far off it is depends on the level. So each level is timed on the sample and on a quarter of it, and the
+		// full encode is extrapolated with the resulting exponent.
+		const uint32_t total_sample_blocks = sample_blocks_x * sample_blocks_y;
+		const uint32_t quarter_blocks_x = maximum(1U, sample_blocks_x / 2), quarter_blocks_y = maximum(1U, sample_blocks_y / 2);
+		const uint32_t quarter_sample_blocks = quarter_blocks_x * quarter_blocks_y;
+
+		basis_compressor_params quarter_params(trial_params);
+		if (m_params.m_hdr)
+			quarter_params.m_source_images_hdr[0].crop(quarter_blocks_x * block_width, quarter_blocks_y * block_height);
+		else
+			quarter_params.m_source_images[0].crop(quarter_blocks_x * block_width, quarter_blocks_y * block_height);
+
+		const double MIN_BLOCKS_EXPONENT = .75f, MAX_BLOCKS_EXPONENT = 1.5f;
+		const double total_blocks_scale = (double)m_total_blocks / (double)total_sample_blocks;
+
+		double blocks_exponent = 1.0f;
+
+		// Returns true if the full encode at this level is predicted to fit.
+		auto trial_fits = [&](int level) -> bool
+		{
+			double cur_time = get_interval_timer();
+
+			// The trials get deadlines (assuming linear scaling), so a level that's way too slow doesn't eat the budget just to find that out.
+			double quarter_secs = -1.0f;
+			if (quarter_sample_blocks < total_sample_blocks)
+			{
+				quarter_secs = time_trial(quarter_params, level, minimum((target_end_time - cur_time) / (total_blocks_scale + 1.0f), calibration_end_time - cur_time));
+				if (quarter_secs < 0.0f)
+					return false;
+			}
+
+			cur_time = get_interval_timer();
+			const double trial_secs = time_trial(trial_params, level, minimum((target_end_time - cur_time) / (total_blocks_scale + 1.0f), calibration_end_time - cur_time));
+			if (trial_secs < 0.0f)
+				return false;
+
+			double level_exponent = 1.0f;
+			if (quarter_secs > 0.0f)
+				level_exponent = clamp(log(trial_secs / quarter_secs) / log((double)total_sample_blocks / quarter_sample_blocks), MIN_BLOCKS_EXPONENT, MAX_BLOCKS_EXPONENT);
+
+			const double predicted_secs = trial_secs * pow(total_blocks_scale, level_exponent);
+
+			m_effort_level_secs[level - min_level] = predicted_secs;
+
+			if (m_params.m_debug)
+				fmt_debug_printf("basis_compressor::calibrate_effort_level: level {}: sample {} secs, exponent {}, predicted {} secs\n", level, trial_secs, level_exponent, predicted_secs);
+
+			// Assume calibration will use all of its share of the budget.
+			if (predicted_secs > (target_end_time - maximum(get_interval_timer(), calibration_end_time)))
+				return false;
+
+			blocks_exponent = level_exponent;
+			return true;
+		};
+
+		// Effort is (roughly) monotonic in encode time, so binary search for the highest level that fits. The lowest level is 
+		// used even if it won't fit.
+		int lo = min_level, hi = max_level;
+		while (lo < hi)
+		{
+			const int mid = (lo + hi + 1) / 2;
+
+			if (trial_fits(mid))
+				lo = mid;
+			else
+				hi = mid - 1;
+
+			if (!m_progress.update())
+				return false;
+		}
+
+		m_calibrated_effort_level = lo;
+		set_format_effort_level(m_params, m_fmt_mode, m_calibrated_effort_level);
+
+		m_slice_min_effort_levels.assign(m_slice_descs.size(), m_calibrated_effort_level);
+		m_slice_max_effort_levels.assign(m_slice_descs.size(), m_calibrated_effort_level);
+
+		if (m_params.m_status_output)
+		{
+			fmt_printf("Time budget: {} secs, calibrated effort level: {} ({}-{}), sample: {}x{} blocks, blocks exponent: {3.2}, calibration time: {3.3} secs\n",
+				(float)m_params.m_target_encode_time_secs, m_calibrated_effort_level, min_level, max_level,
+				sample_blocks_x, sample_blocks_y, blocks_exponent, tm.get_elapsed_secs());
+		}
+
+		return true;
+	}
+
+	// Starts steering the effort level of the remaining block batches, if this is a time-budgeted encode. The encode being 
+	// started gets budget_fraction of the remaining time (a little is held back for creating the output file).
+	void basis_compressor::init_effort_controller(float budget_fraction)
+	{
+		m_effort_controller.clear();
+
+		if (m_calibrated_effort_level < 0)
+			return;
+
+		int min_level = 0, max_level = 0;
+		get_format_effort_level_range(m_fmt_mode, min_level, max_level);
+
+		const float OUTPUT_FILE_RESERVE_FRACTION = .05f;
+		const double cur_time = get_interval_timer();
+		const double deadline = cur_time + maximum(0.0, m_process_start_time + m_params.m_target_encode_time_secs - cur_time) * (1.0f - OUTPUT_FILE_RESERVE_FRACTION) * budget_fraction;
+
+		m_effort_controller.init(m_calibrated_effort_level, min_level, max_level, m_effort_level_secs, deadline, m_total_blocks);
+	}
+
+	// Records the effort level range slice_index was encoded at by the effort controller (see image_stats::m_min_effort_level).
+	void basis_compressor::record_slice_effort_levels(uint32_t slice_index)
+	{
+		if ((!m_effort_controller.is_enabled()) || (slice_index >= m_slice_min_effort_levels.size()))
+			return;
+
+		const int min_used_level = m_effort_controller.get_min_used_level(), max_used_level = m_effort_controller.get_max_used_level();
+		if (min_used_level < 0)
+			return;
+
+		m_slice_min_effort_levels[slice_index] = min_used_level;
+		m_slice_max_effort_levels[slice_index] = max_used_level;
+	}
+
+	basis_compressor::error_code basis_compressor::process_impl()
+	{
+		m_progress.set_range(0.0f, PROGRESS_SOURCE_IMAGES_END);
+
 		if (!read_dds_source_images())
 			return cECFailedReadingSourceImages;
 
@@ -843,6 +1368,10 @@ namespace basisu
 		if (!pick_format_mode())
 			return cECFailedInvalidParameters;
 
+		// Strip encoding reads, encodes and writes the source image itself, a strip at a time.
+		if (m_params.m_strip_height > 0)
+			return encode_strips_to_ktx2_file();
+
 		if (!read_source_images())
 			return cECFailedReadingSourceImages;
 
@@ -862,6 +1391,20 @@ namespace basisu
 		if (!extract_source_blocks())
 			return cECFailedFrontEnd;
 
+		update_peak_buffer_bytes();
+
+		BASISU_TRACE_COUNTER("total_blocks", m_total_blocks);
+
+		m_progress.set_range(PROGRESS_SOURCE_IMAGES_END, PROGRESS_SOURCE_IMAGES_END);
+		if (!m_progress.update())
+			return cECCancelled;
+
+		if (m_params.m_target_encode_time_secs > 0.0f)
+		{
+			if (!calibrate_effort_level())
+				return cECCancelled;
+		}
+
 		if (m_params.m_hdr)
 		{
 			if (m_params.m_hdr_mode == hdr_modes::cUASTC_HDR_4X4)
@@ -969,16 +1512,30 @@ namespace basisu
 			if (m_params.m_status_output)
 				printf("Mode: ETC1S Quality (0-255): %i, Comp Level (Effort, 0-6): %i\n", m_params.m_quality_level, (int)m_params.m_etc1s_compression_level);
 			
+			m_progress.set_range(PROGRESS_SOURCE_IMAGES_END, PROGRESS_ETC1S_FRONTEND_END);
+
 			if (!process_frontend())
 				return cECFailedFrontEnd;
 
 			if (!extract_frontend_texture_data())
 				return cECFailedFrontendExtract;
 
+			m_progress.set_range(PROGRESS_ETC1S_FRONTEND_END, PROGRESS_ENCODE_END);
+
 			if (!process_backend())
 				return cECFailedBackend;
 		}
 
+		update_peak_buffer_bytes();
+
+		if (m_params.m_low_memory)
+			free_encode_buffers();
+
+		// Past here there's no more block encoding, just file creation, validation and stats - so only check between the steps.
+		m_progress.set_range(PROGRESS_ENCODE_END, 100.0f);
+		if (!m_progress.update())
+			return cECCancelled;
+
 		if (!create_basis_file_and_transcode())
 			return cECFailedCreateBasisFile;
 
@@ -986,11 +1543,33 @@ namespace basisu
 		{
 			if (!create_ktx2_file())
 				return cECFailedCreateKTX2File;
+
+			update_peak_buffer_bytes();
+
+			// The .KTX2 file was built from the .basis file's slice data, which isn't needed anymore.
+			if (m_params.m_low_memory)
+			{
+				m_output_basis_file.clear();
+				m_uastc_backend_output.m_slice_image_data.clear();
+			}
 		}
 
+		BASISU_TRACE_COUNTER("output_file_bytes", m_params.m_create_ktx2_file ? m_output_ktx2_file.size() : m_output_basis_file.size());
+
+		if (!m_progress.update())
+			return cECCancelled;
+
 		if (!write_output_files_and_compute_stats())
 			return cECFailedWritingOutput;
 
+		update_peak_buffer_bytes();
+
+		if (m_params.m_low_memory)
+			free_decoded_textures();
+
+		m_progress.set_range(100.0f, 100.0f);
+		m_progress.update();
+
 		if (m_params.m_status_output)
 			fmt_printf("basis_compressor::process: Success\n");
 
@@ -1036,17 +1615,46 @@ namespace basisu
 		return cECSuccess;
 	}
 
+	// Allocates the textures the UASTC/ASTC/XUBC7 encoders write each slice's blocks into before they're copied to m_uastc_backend_output. 
+	// In low memory mode there's a single scratch texture, which get_uastc_slice_texture() re-initializes for each slice.
+	void basis_compressor::init_uastc_slice_textures(texture_format fmt)
+	{
+		if (m_params.m_low_memory)
+		{
+			m_uastc_slice_textures.resize(1);
+			m_uastc_slice_textures[0].init(fmt, 0, 0);
+			return;
+		}
+
+		m_uastc_slice_textures.resize(m_slice_descs.size());
+		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
+			m_uastc_slice_textures[slice_index].init(fmt, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
+	}
+
+	gpu_image& basis_compressor::get_uastc_slice_texture(uint32_t slice_index)
+	{
+		update_peak_buffer_bytes();
+
+		if (!m_params.m_low_memory)
+			return m_uastc_slice_textures[slice_index];
+
+		// The slices are in largest first (mipmap) order, so this usually doesn't reallocate.
+		gpu_image& tex = m_uastc_slice_textures[0];
+		tex.init(tex.get_format(), m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
+		return tex;
+	}
+
 	// This is both ASTC HDR 6x6 and UASTC HDR 6x6i.
 	basis_compressor::error_code basis_compressor::encode_slices_to_astc_6x6_hdr()
 	{
 		debug_printf("basis_compressor::encode_slices_to_astc_6x6_hdr\n");
 
+		BASISU_TRACE_ZONE("encode_slices_to_astc_6x6_hdr");
+
 		interval_timer tm;
 		tm.start();
 
-		m_uastc_slice_textures.resize(m_slice_descs.size());
-		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
-			m_uastc_slice_textures[slice_index].init(texture_format::cASTC_HDR_6x6, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
+		init_uastc_slice_textures(texture_format::cASTC_HDR_6x6);
 
 		if (m_params.m_hdr_mode == hdr_modes::cASTC_HDR_6X6)
 			m_uastc_backend_output.m_tex_format = basist::basis_tex_format::cASTC_HDR_6x6;
@@ -1071,13 +1679,18 @@ namespace basisu
 		global_cfg.m_output_images = m_params.m_debug_images;
 		global_cfg.m_debug_output = m_params.m_debug;
 		global_cfg.m_status_output = m_params.m_status_output || m_params.m_debug;
+		global_cfg.m_pProgress = &m_progress;
+
+		init_effort_controller(1.0f);
 				
 		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
 		{
+			BASISU_TRACE_ZONE_ARG("slice", slice_index);
+
 			if (m_params.m_status_output)
 				fmt_printf("Encoding slice {}\n", slice_index);
 
-			gpu_image& dst_tex = m_uastc_slice_textures[slice_index];
+			gpu_image& dst_tex = get_uastc_slice_texture(slice_index);
 			uint8_vec &dst_buf = m_uastc_backend_output.m_slice_image_data[slice_index];
 
 			basisu_backend_slice_desc& slice_desc = m_slice_descs[slice_index];
@@ -1097,11 +1710,24 @@ namespace basisu
 			if (m_params.m_debug)
 				fmt_debug_printf("----------------------------------------------------------------------------\n");
 
+			set_progress_range_for_slice(slice_index);
+
+			// Time-budgeted encodes: each slice is encoded at the effort controller's current level.
+			astc_6x6_hdr::astc_hdr_6x6_global_config slice_cfg(global_cfg);
+			if (m_effort_controller.is_enabled())
+			{
+				m_effort_controller.reset_used_range();
+				slice_cfg.set_user_level(m_effort_controller.acquire_level());
+			}
+
 			astc_6x6_hdr::result_metrics metrics;
-			bool status = astc_6x6_hdr::compress_photo(source_image, global_cfg, m_params.m_pJob_pool, intermediate_tex_data, astc_tex_data, metrics);
+			bool status = astc_6x6_hdr::compress_photo(source_image, slice_cfg, m_params.m_pJob_pool, intermediate_tex_data, astc_tex_data, metrics);
 			if (!status)
 				return cECFailedEncodeUASTC;
 
+			m_effort_controller.update((uint64_t)slice_desc.m_num_blocks_x * slice_desc.m_num_blocks_y);
+			record_slice_effort_levels(slice_index);
+
 			if (m_params.m_debug)
 				fmt_debug_printf("----------------------------------------------------------------------------\n");
 
@@ -1132,38 +1758,109 @@ namespace basisu
 		return cECSuccess;
 	}
 
-	basis_compressor::error_code basis_compressor::encode_slices_to_uastc_4x4_hdr()
+	// Applies m_perceptual and m_hdr_favor_astc to the UASTC HDR 4x4 codec options' error weights.
+	static void set_uastc_hdr_4x4_error_weights(basis_compressor_params& params)
 	{
-		debug_printf("basis_compressor::encode_slices_to_uastc_4x4_hdr\n");
-
-		interval_timer tm;
-		tm.start();
-
-		m_uastc_slice_textures.resize(m_slice_descs.size());
-		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
-			m_uastc_slice_textures[slice_index].init(texture_format::cUASTC_HDR_4x4, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
-
-		m_uastc_backend_output.m_tex_format = basist::basis_tex_format::cUASTC_HDR_4x4;
-		m_uastc_backend_output.m_etc1s = false;
-		m_uastc_backend_output.m_srgb = false;
-		m_uastc_backend_output.m_slice_desc = m_slice_descs;
-		m_uastc_backend_output.m_slice_image_data.resize(m_slice_descs.size());
-		m_uastc_backend_output.m_slice_image_crcs.resize(m_slice_descs.size());
-
-		if (!m_params.m_perceptual)
+		if (!params.m_perceptual)
 		{
-			m_params.m_uastc_hdr_4x4_options.m_r_err_scale = 1.0f;
-			m_params.m_uastc_hdr_4x4_options.m_g_err_scale = 1.0f;
+			params.m_uastc_hdr_4x4_options.m_r_err_scale = 1.0f;
+			params.m_uastc_hdr_4x4_options.m_g_err_scale = 1.0f;
 		}
 		
 		const float DEFAULT_BC6H_ERROR_WEIGHT = .65f;// .85f;
 		const float LOWEST_BC6H_ERROR_WEIGHT = .1f;
-		m_params.m_uastc_hdr_4x4_options.m_bc6h_err_weight = m_params.m_hdr_favor_astc ? LOWEST_BC6H_ERROR_WEIGHT : DEFAULT_BC6H_ERROR_WEIGHT;
+		params.m_uastc_hdr_4x4_options.m_bc6h_err_weight = params.m_hdr_favor_astc ? LOWEST_BC6H_ERROR_WEIGHT : DEFAULT_BC6H_ERROR_WEIGHT;
+	}
 
-		std::atomic<bool> any_failures;
-		any_failures.store(false);
+	// Encodes one 4x4 block of texels to UASTC HDR 4x4, picking the candidate with the lowest blend of ASTC and BC6H error (see m_bc6h_err_weight).
+	// Returns the index of the chosen candidate in all_results, or -1 on failure.
+	static int encode_uastc_hdr_4x4_block(const vec4F* pBlock_pixels, const uastc_hdr_4x4_codec_options& options, basisu::vector<astc_hdr_4x4_pack_results>& all_results, basist::astc_blk& dest_block)
+	{
+		float rgb_pixels[16 * 3];
+		basist::half_float rgb_pixels_half[16 * 3];
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			rgb_pixels[i * 3 + 0] = pBlock_pixels[i][0];
+			rgb_pixels_half[i * 3 + 0] = float_to_half_non_neg_no_nan_inf(pBlock_pixels[i][0]);
 
-		astc_hdr_4x4_block_stats enc_stats;
+			rgb_pixels[i * 3 + 1] = pBlock_pixels[i][1];
+			rgb_pixels_half[i * 3 + 1] = float_to_half_non_neg_no_nan_inf(pBlock_pixels[i][1]);
+
+			rgb_pixels[i * 3 + 2] = pBlock_pixels[i][2];
+			rgb_pixels_half[i * 3 + 2] = float_to_half_non_neg_no_nan_inf(pBlock_pixels[i][2]);
+		}
+
+		if (!astc_hdr_4x4_enc_block(&rgb_pixels[0], rgb_pixels_half, options, all_results))
+			return -1;
+
+		double best_err = 1e+30f;
+		int best_result_index = -1;
+
+		const double bc6h_err_weight = options.m_bc6h_err_weight;
+		const double astc_err_weight = (1.0f - bc6h_err_weight);
+
+		for (uint32_t i = 0; i < all_results.size(); i++)
+		{
+			basist::half_float unpacked_bc6h_block[4 * 4 * 3];
+			unpack_bc6h(&all_results[i].m_bc6h_block, unpacked_bc6h_block, false);
+
+			all_results[i].m_bc6h_block_error = compute_block_error(16, rgb_pixels_half, unpacked_bc6h_block, options);
+
+			double overall_err = (all_results[i].m_bc6h_block_error * bc6h_err_weight) + (all_results[i].m_best_block_error * astc_err_weight);
+
+			if ((!i) || (overall_err < best_err))
+			{
+				best_err = overall_err;
+				best_result_index = i;
+			}
+		}
+
+		if (best_result_index < 0)
+			return -1;
+
+		astc_hdr_4x4_pack_results_to_block(dest_block, all_results[best_result_index]);
+
+		// Verify that this block is valid UASTC HDR and we can successfully transcode it to BC6H.
+		// (Well, except in fastest mode.)
+		if (options.m_level > 0)
+		{
+			basist::bc6h_block transcoded_bc6h_blk;
+			bool transcode_results = astc_hdr_transcode_to_bc6h(dest_block, transcoded_bc6h_blk);
+			assert(transcode_results);
+			if (!transcode_results)
+			{
+				error_printf("encode_uastc_hdr_4x4_block: UASTC HDR block transcode check failed!\n");
+				return -1;
+			}
+		}
+
+		return best_result_index;
+	}
+
+	basis_compressor::error_code basis_compressor::encode_slices_to_uastc_4x4_hdr()
+	{
+		debug_printf("basis_compressor::encode_slices_to_uastc_4x4_hdr\n");
+
+		BASISU_TRACE_ZONE("encode_slices_to_uastc_4x4_hdr");
+
+		interval_timer tm;
+		tm.start();
+
+		init_uastc_slice_textures(texture_format::cUASTC_HDR_4x4);
+
+		m_uastc_backend_output.m_tex_format = basist::basis_tex_format::cUASTC_HDR_4x4;
+		m_uastc_backend_output.m_etc1s = false;
+		m_uastc_backend_output.m_srgb = false;
+		m_uastc_backend_output.m_slice_desc = m_slice_descs;
+		m_uastc_backend_output.m_slice_image_data.resize(m_slice_descs.size());
+		m_uastc_backend_output.m_slice_image_crcs.resize(m_slice_descs.size());
+
+		set_uastc_hdr_4x4_error_weights(m_params);
+
+		std::atomic<bool> any_failures;
+		any_failures.store(false);
+
+		astc_hdr_4x4_block_stats enc_stats;
 				
 		struct uastc_blk_desc
 		{
@@ -1220,12 +1917,28 @@ namespace basisu
 		uint32_t total_blocks_processed = 0;
 		float last_percentage_printed = 0;
 
+		// Time-budgeted encodes: the options for every effort level, so each block batch can use the effort controller's current level.
+		basisu::vector<uastc_hdr_4x4_codec_options> level_options;
+
+		init_effort_controller(1.0f);
+		if (m_effort_controller.is_enabled())
+		{
+			level_options.resize(uastc_hdr_4x4_codec_options::cMaxLevel + 1);
+			for (int level = uastc_hdr_4x4_codec_options::cMinLevel; level <= uastc_hdr_4x4_codec_options::cMaxLevel; level++)
+			{
+				level_options[level] = m_params.m_uastc_hdr_4x4_options;
+				level_options[level].set_quality_level(level);
+			}
+		}
+
 		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
 		{
+			BASISU_TRACE_ZONE_ARG("slice", slice_index);
+
 			if (m_params.m_status_output)
 				fmt_printf("Encoding slice {}\n", slice_index);
 
-			gpu_image& tex = m_uastc_slice_textures[slice_index];
+			gpu_image& tex = get_uastc_slice_texture(slice_index);
 			basisu_backend_slice_desc& slice_desc = m_slice_descs[slice_index];
 			(void)slice_desc;
 
@@ -1233,6 +1946,11 @@ namespace basisu
 			const uint32_t num_blocks_y = tex.get_blocks_y();
 			const uint32_t total_blocks = tex.get_total_blocks();
 			const imagef& source_image = m_slice_images_hdr[slice_index];
+
+			set_progress_range_for_slice(slice_index);
+			m_progress.begin_stage(0.0f, 1.0f, total_blocks);
+
+			m_effort_controller.reset_used_range();
 						
 			const uint32_t N = 256;
 			for (uint32_t block_index_iter = 0; block_index_iter < total_blocks; block_index_iter += N)
@@ -1242,10 +1960,15 @@ namespace basisu
 							
 				m_params.m_pJob_pool->add_job([this, first_index, last_index, num_blocks_x, num_blocks_y, total_blocks, &source_image, 
 					&tex, &any_failures, &enc_stats, &unique_block_descs, &unique_block_desc_mutex, 
-					&status_output_mutex, &total_blocks_processed, &last_percentage_printed]
+					&status_output_mutex, &total_blocks_processed, &last_percentage_printed, &level_options]
 					{
 						BASISU_NOTE_UNUSED(num_blocks_y);
 
+						if (m_progress.is_stopped())
+							return;
+
+						const uastc_hdr_4x4_codec_options& options = m_effort_controller.is_enabled() ? level_options[m_effort_controller.acquire_level()] : m_params.m_uastc_hdr_4x4_options;
+
 						basisu::vector<astc_hdr_4x4_pack_results> all_results;
 						all_results.reserve(256);
 
@@ -1262,69 +1985,15 @@ namespace basisu
 							source_image.extract_block_clamped(&block_pixels[0], block_x * 4, block_y * 4, 4, 4);
 
 							basist::astc_blk& dest_block = *(basist::astc_blk*)tex.get_block_ptr(block_x, block_y);
-														
-							float rgb_pixels[16 * 3];
-							basist::half_float rgb_pixels_half[16 * 3];
-							for (uint32_t i = 0; i < 16; i++)
-							{
-								rgb_pixels[i * 3 + 0] = block_pixels[i][0];
-								rgb_pixels_half[i * 3 + 0] = float_to_half_non_neg_no_nan_inf(block_pixels[i][0]);
-
-								rgb_pixels[i * 3 + 1] = block_pixels[i][1];
-								rgb_pixels_half[i * 3 + 1] = float_to_half_non_neg_no_nan_inf(block_pixels[i][1]);
 
-								rgb_pixels[i * 3 + 2] = block_pixels[i][2];
-								rgb_pixels_half[i * 3 + 2] = float_to_half_non_neg_no_nan_inf(block_pixels[i][2]);
-							}
-														
-							bool status = astc_hdr_4x4_enc_block(&rgb_pixels[0], rgb_pixels_half, m_params.m_uastc_hdr_4x4_options, all_results);
-							if (!status)
+							const int best_result_index = encode_uastc_hdr_4x4_block(block_pixels, options, all_results, dest_block);
+							if (best_result_index < 0)
 							{
 								any_failures.store(true);
 								continue;
 							}
 
-							double best_err = 1e+30f;
-							int best_result_index = -1;
-											
-							const double bc6h_err_weight = m_params.m_uastc_hdr_4x4_options.m_bc6h_err_weight;
-							const double astc_err_weight = (1.0f - bc6h_err_weight);
-										
-							for (uint32_t i = 0; i < all_results.size(); i++)
-							{
-								basist::half_float unpacked_bc6h_block[4 * 4 * 3];
-								unpack_bc6h(&all_results[i].m_bc6h_block, unpacked_bc6h_block, false);
-
-								all_results[i].m_bc6h_block_error = compute_block_error(16, rgb_pixels_half, unpacked_bc6h_block, m_params.m_uastc_hdr_4x4_options);
-
-								double overall_err = (all_results[i].m_bc6h_block_error * bc6h_err_weight) + (all_results[i].m_best_block_error * astc_err_weight);
-
-								if ((!i) || (overall_err < best_err))
-								{
-									best_err = overall_err;
-									best_result_index = i;
-								}
-							}
-
 							const astc_hdr_4x4_pack_results& best_results = all_results[best_result_index];
-							
-							astc_hdr_4x4_pack_results_to_block(dest_block, best_results);
-								
-							// Verify that this block is valid UASTC HDR and we can successfully transcode it to BC6H.
-							// (Well, except in fastest mode.)
-							if (m_params.m_uastc_hdr_4x4_options.m_level > 0)
-							{
-								basist::bc6h_block transcoded_bc6h_blk;
-								bool transcode_results = astc_hdr_transcode_to_bc6h(dest_block, transcoded_bc6h_blk);
-								assert(transcode_results);
-								if ((!transcode_results) && (!any_failures))
-								{
-									error_printf("basis_compressor::encode_slices_to_uastc_4x4_hdr: UASTC HDR block transcode check failed!\n");
-
-									any_failures.store(true);
-									continue;
-								}
-							}
 
 							if (m_params.m_debug)
 							{
@@ -1356,6 +2025,11 @@ namespace basisu
 							}
 
 						} // block_index
+
+						m_effort_controller.update(last_index - first_index);
+
+						if (!m_progress.update(last_index - first_index))
+							return;
 						
 						if (m_params.m_status_output)
 						{
@@ -1388,9 +2062,14 @@ namespace basisu
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (m_progress.is_stopped())
+				return cECCancelled;
+
 			if (any_failures)
 				return cECFailedEncodeUASTC;
 
+			record_slice_effort_levels(slice_index);
+
 			m_uastc_backend_output.m_slice_image_data[slice_index].resize(tex.get_size_in_bytes());
 			memcpy(&m_uastc_backend_output.m_slice_image_data[slice_index][0], tex.get_ptr(), tex.get_size_in_bytes());
 
@@ -1455,44 +2134,17 @@ namespace basisu
 		return cECSuccess;
 	}
 
-	// XUASTC 4x4-12x12 or ASTC 4x4-12x12
-	basis_compressor::error_code basis_compressor::encode_slices_to_xuastc_or_astc_ldr()
+	// The XUASTC/ASTC LDR 4x4-12x12 encoder config for the current params and format mode. If the config uses deblocking post-filtering,
+	// this also adds the deblocking filter ID key value to m_params.m_key_values.
+	bool basis_compressor::get_astc_ldr_encode_config(astc_ldr::astc_ldr_encode_config& cfg)
 	{
-		if (m_params.m_debug)
-			debug_printf("basis_compressor::encode_slices_to_xuastc_or_astc_ldr\n");
-
-		m_uastc_slice_textures.resize(m_slice_descs.size());
-
-		const texture_format tex_fmt = basist::basis_get_texture_format_from_xuastc_or_astc_ldr_basis_tex_format(m_fmt_mode);
 		const basist::transcoder_texture_format transcoder_tex_fmt = basist::basis_get_transcoder_texture_format_from_xuastc_or_astc_ldr_basis_tex_format(m_fmt_mode);
 
-		uint32_t block_width = 0, block_height = 0;
-		block_width = basist::basis_get_block_width(transcoder_tex_fmt);
-		block_height = basist::basis_get_block_height(transcoder_tex_fmt);
+		const uint32_t block_width = basist::basis_get_block_width(transcoder_tex_fmt);
+		const uint32_t block_height = basist::basis_get_block_height(transcoder_tex_fmt);
 
 		const bool very_large_blocks_flag = (block_width * block_height) >= basist::BASISU_DEBLOCKING_BLOCK_SIZE_THRESHOLD;
-				
-#if defined(_DEBUG) || defined(DEBUG)
-		// sanity checking
-		{
-			uint32_t alt_block_width = 0, alt_block_height = 0;
-			get_basis_tex_format_block_size(m_fmt_mode, alt_block_width, alt_block_height);
-			assert((block_width == alt_block_width) && (block_height == alt_block_height));
-		}
-#endif
-
-		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
-			m_uastc_slice_textures[slice_index].init(tex_fmt, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
-
-		m_uastc_backend_output.m_tex_format = m_fmt_mode;
-
-		m_uastc_backend_output.m_etc1s = false;
-		m_uastc_backend_output.m_srgb = m_params.m_ktx2_and_basis_srgb_transfer_function;
-		m_uastc_backend_output.m_slice_desc = m_slice_descs;
-		m_uastc_backend_output.m_slice_image_data.resize(m_slice_descs.size());
-		m_uastc_backend_output.m_slice_image_crcs.resize(m_slice_descs.size());
 
-		astc_ldr::astc_ldr_encode_config cfg;
 		cfg.m_astc_block_width = block_width;
 		cfg.m_astc_block_height = block_height;
 		cfg.m_block_blurring_p1 = m_params.m_xuastc_ldr_blurring;
@@ -1591,7 +2243,7 @@ namespace basisu
 		default:
 		{
 			fmt_error_printf("Invalid m_xuastc_ldr_astc_comp_selection\n");
-			return cECFailedInvalidParameters;
+			return false;
 		}
 		}
 
@@ -1609,8 +2261,8 @@ namespace basisu
 		cfg.m_compressed_syntax = (basist::astc_ldr_t::xuastc_ldr_syntax)(int)m_params.m_xuastc_ldr_syntax;
 		if (cfg.m_compressed_syntax >= basist::astc_ldr_t::xuastc_ldr_syntax::cTotal)
 		{
-			error_printf("basis_compressor::encode_slices_to_xuastc_or_astc_ldr: Invalid XUASTC LDR syntax\n");
-			return cECFailedInvalidParameters;
+			error_printf("basis_compressor::get_astc_ldr_encode_config: Invalid XUASTC LDR syntax\n");
+			return false;
 		}
 
 		if (basist::basis_tex_format_is_xuastc_ldr(m_fmt_mode))
@@ -1731,6 +2383,7 @@ namespace basisu
 		}
 
 		cfg.m_try_simplified_latent_configs = m_params.m_xuastc_ldr_heavy_subset_usage;
+		cfg.m_pProgress = &m_progress;
 
 		if (m_params.m_status_output)
 		{
@@ -1740,13 +2393,58 @@ namespace basisu
 				cfg.m_try_simplified_latent_configs,
 				m_params.m_xuastc_ldr_astc_comp_selection);
 		}
+
+		return true;
+	}
+
+	// XUASTC 4x4-12x12 or ASTC 4x4-12x12
+	basis_compressor::error_code basis_compressor::encode_slices_to_xuastc_or_astc_ldr()
+	{
+		BASISU_TRACE_ZONE("encode_slices_to_xuastc_or_astc_ldr");
+
+		if (m_params.m_debug)
+			debug_printf("basis_compressor::encode_slices_to_xuastc_or_astc_ldr\n");
+
+		const texture_format tex_fmt = basist::basis_get_texture_format_from_xuastc_or_astc_ldr_basis_tex_format(m_fmt_mode);
+		const basist::transcoder_texture_format transcoder_tex_fmt = basist::basis_get_transcoder_texture_format_from_xuastc_or_astc_ldr_basis_tex_format(m_fmt_mode);
+
+		uint32_t block_width = 0, block_height = 0;
+		block_width = basist::basis_get_block_width(transcoder_tex_fmt);
+		block_height = basist::basis_get_block_height(transcoder_tex_fmt);
+
+#if defined(_DEBUG) || defined(DEBUG)
+		// sanity checking
+		{
+			uint32_t alt_block_width = 0, alt_block_height = 0;
+			get_basis_tex_format_block_size(m_fmt_mode, alt_block_width, alt_block_height);
+			assert((block_width == alt_block_width) && (block_height == alt_block_height));
+		}
+#endif
+		BASISU_NOTE_UNUSED(block_width);
+		BASISU_NOTE_UNUSED(block_height);
+
+		init_uastc_slice_textures(tex_fmt);
+
+		m_uastc_backend_output.m_tex_format = m_fmt_mode;
+
+		m_uastc_backend_output.m_etc1s = false;
+		m_uastc_backend_output.m_srgb = m_params.m_ktx2_and_basis_srgb_transfer_function;
+		m_uastc_backend_output.m_slice_desc = m_slice_descs;
+		m_uastc_backend_output.m_slice_image_data.resize(m_slice_descs.size());
+		m_uastc_backend_output.m_slice_image_crcs.resize(m_slice_descs.size());
+
+		astc_ldr::astc_ldr_encode_config cfg;
+		if (!get_astc_ldr_encode_config(cfg))
+			return cECFailedInvalidParameters;
 								
 		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
 		{
+			BASISU_TRACE_ZONE_ARG("slice", slice_index);
+
 			if (m_params.m_status_output)
 				fmt_printf("Encoding slice {}\n", slice_index);
 
-			gpu_image& dst_tex = m_uastc_slice_textures[slice_index];
+			gpu_image& dst_tex = get_uastc_slice_texture(slice_index);
 						
 			basisu_backend_slice_desc& slice_desc = m_slice_descs[slice_index];
 			(void)slice_desc;
@@ -1770,6 +2468,8 @@ namespace basisu
 
 			uint8_vec intermediate_tex_data;
 			vector2D<astc_helpers::log_astc_block> coded_log_blocks;
+
+			set_progress_range_for_slice(slice_index);
 						
 			bool comp_status = astc_ldr::compress_image(*pSource_image, intermediate_tex_data, coded_log_blocks, cfg, *m_params.m_pJob_pool);
 			if (!comp_status)
@@ -1826,19 +2526,18 @@ namespace basisu
 
 	basis_compressor::error_code basis_compressor::encode_slices_to_xubc7()
 	{
+		BASISU_TRACE_ZONE("encode_slices_to_xubc7");
+
 		if (m_params.m_debug)
 			debug_printf("basis_compressor::encode_slices_to_xubc7\n");
 
-		m_uastc_slice_textures.resize(m_slice_descs.size());
-
 		const texture_format tex_fmt = texture_format::cBC7;
 		//const basist::transcoder_texture_format transcoder_tex_fmt = basist::transcoder_texture_format::cTFBC7_RGBA;
 		//BASISU_NOTE_UNUSED(transcoder_tex_fmt);
 
 		//const uint32_t block_width = 4, block_height = 4;
 		
-		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
-			m_uastc_slice_textures[slice_index].init(tex_fmt, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
+		init_uastc_slice_textures(tex_fmt);
 
 		m_uastc_backend_output.m_tex_format = m_fmt_mode;
 
@@ -1882,6 +2581,7 @@ namespace basisu
 		options.m_debug_images = m_params.m_debug_images;
 
 		options.m_pJob_pool = m_params.m_pJob_pool;
+		options.m_pProgress = &m_progress;
 		
 		const uint32_t desired_num_stripes = m_params.m_xubc7_num_stripes; // [1,16]; set_num_stripes_for_image() re-clamps per image
 		
@@ -1897,10 +2597,12 @@ namespace basisu
 
 		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
 		{
+			BASISU_TRACE_ZONE_ARG("slice", slice_index);
+
 			if (m_params.m_status_output)
 				fmt_printf("Encoding slice {}\n", slice_index);
 
-			gpu_image& dst_tex = m_uastc_slice_textures[slice_index];
+			gpu_image& dst_tex = get_uastc_slice_texture(slice_index);
 
 			basisu_backend_slice_desc& slice_desc = m_slice_descs[slice_index];
 			(void)slice_desc;
@@ -1921,6 +2623,8 @@ namespace basisu
 			
 			options.set_num_stripes_for_image(*pSource_image, desired_num_stripes);
 
+			set_progress_range_for_slice(slice_index);
+
 			if (m_params.m_debug)
 				fmt_debug_printf("----------------------------------------------------------------------------\n");
 						
@@ -1974,22 +2678,27 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::encode_slices_to_uastc_4x4_ldr\n");
 
-		m_uastc_slice_textures.resize(m_slice_descs.size());
-		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
-			m_uastc_slice_textures[slice_index].init(texture_format::cUASTC4x4, m_slice_descs[slice_index].m_orig_width, m_slice_descs[slice_index].m_orig_height);
+		BASISU_TRACE_ZONE("encode_slices_to_uastc_4x4_ldr");
+
+		init_uastc_slice_textures(texture_format::cUASTC4x4);
 
 		m_uastc_backend_output.m_tex_format = basist::basis_tex_format::cUASTC_LDR_4x4;
 		m_uastc_backend_output.m_etc1s = false;
 		m_uastc_backend_output.m_slice_desc = m_slice_descs;
 		m_uastc_backend_output.m_slice_image_data.resize(m_slice_descs.size());
 		m_uastc_backend_output.m_slice_image_crcs.resize(m_slice_descs.size());
+
+		// The RDO post-process (if any) runs at the calibrated level.
+		init_effort_controller(m_params.m_rdo_uastc_ldr_4x4 ? .5f : 1.0f);
 				
 		for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
 		{
+			BASISU_TRACE_ZONE_ARG("slice", slice_index);
+
 			if (m_params.m_status_output)
 				fmt_printf("Encoding slice {}\n", slice_index);
 
-			gpu_image& tex = m_uastc_slice_textures[slice_index];
+			gpu_image& tex = get_uastc_slice_texture(slice_index);
 			basisu_backend_slice_desc& slice_desc = m_slice_descs[slice_index];
 			(void)slice_desc;
 
@@ -2001,6 +2710,12 @@ namespace basisu
 			std::mutex status_output_mutex;
 			uint32_t total_blocks_processed = 0;
 			float last_percentage_printed = 0;
+
+			// The RDO post-process is roughly as expensive as the initial encode.
+			set_progress_range_for_slice(slice_index);
+			m_progress.begin_stage(0.0f, m_params.m_rdo_uastc_ldr_4x4 ? .5f : 1.0f, total_blocks);
+
+			m_effort_controller.reset_used_range();
 						
 			const uint32_t N = 256;
 			for (uint32_t block_index_iter = 0; block_index_iter < total_blocks; block_index_iter += N)
@@ -2012,11 +2727,17 @@ namespace basisu
 					&status_output_mutex, &total_blocks_processed, &last_percentage_printed]
 					{
 						BASISU_NOTE_UNUSED(num_blocks_y);
+
+						if (m_progress.is_stopped())
+							return;
 						
 						uint32_t uastc_flags = m_params.m_pack_uastc_ldr_4x4_flags;
 						if ((m_params.m_rdo_uastc_ldr_4x4) && (m_params.m_rdo_uastc_ldr_4x4_favor_simpler_modes_in_rdo_mode))
 							uastc_flags |= cPackUASTCFavorSimplerModes;
 
+						if (m_effort_controller.is_enabled())
+							uastc_flags = (uastc_flags & ~cPackUASTCLevelMask) | m_effort_controller.acquire_level();
+
 						for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 						{
 							const uint32_t block_x = block_index % num_blocks_x;
@@ -2032,6 +2753,11 @@ namespace basisu
 
 						} // block_index
 
+						m_effort_controller.update(last_index - first_index);
+
+						if (!m_progress.update(last_index - first_index))
+							return;
+
 						if (m_params.m_status_output)
 						{
 							float percent_done = 0;
@@ -2063,9 +2789,17 @@ namespace basisu
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (m_progress.is_stopped())
+				return cECCancelled;
+
+			record_slice_effort_levels(slice_index);
+
 			if (m_params.m_rdo_uastc_ldr_4x4)
 			{
+				m_progress.begin_stage(.5f, 1.0f, tex.get_total_blocks());
+
 				uastc_rdo_params rdo_params;
+				rdo_params.m_pProgress = &m_progress;
 				rdo_params.m_lambda = m_params.m_rdo_uastc_ldr_4x4_quality_scalar;
 				rdo_params.m_max_allowed_rms_increase_ratio = m_params.m_rdo_uastc_ldr_4x4_max_allowed_rms_increase_ratio;
 				rdo_params.m_skip_block_rms_thresh = m_params.m_rdo_uastc_ldr_4x4_skip_block_rms_thresh;
@@ -2092,77 +2826,811 @@ namespace basisu
 		return cECSuccess;
 	}
 
-	bool basis_compressor::generate_mipmaps(const imagef& img, basisu::vector<imagef>& mips, bool has_alpha)
+	// Strip encoding (see basis_compressor_params::m_strip_height): reads, encodes and writes the source image one strip of block rows
+	// at a time, appending each strip's blocks (optionally through a Zstd stream) to the output .KTX2 file. The header, level index and
+	// DFD are written up front and patched once the final level size and alpha usage are known.
+	basis_compressor::error_code basis_compressor::encode_strips_to_ktx2_file()
 	{
-		debug_printf("basis_compressor::generate_mipmaps\n");
+		debug_printf("basis_compressor::encode_strips_to_ktx2_file\n");
 
-		interval_timer tm;
-		tm.start();
+		BASISU_TRACE_ZONE("encode_strips_to_ktx2_file");
 
-		uint32_t total_levels = 1;
-		uint32_t w = img.get_width(), h = img.get_height();
-		while (maximum<uint32_t>(w, h) > (uint32_t)m_params.m_mip_smallest_dimension)
+		const bool is_uastc_ldr_4x4 = (m_fmt_mode == basist::basis_tex_format::cUASTC_LDR_4x4);
+		const bool is_uastc_hdr_4x4 = (m_fmt_mode == basist::basis_tex_format::cUASTC_HDR_4x4);
+		const bool is_astc_hdr_6x6 = (m_fmt_mode == basist::basis_tex_format::cASTC_HDR_6x6);
+		const bool is_astc_ldr = basis_tex_format_is_astc_ldr(m_fmt_mode);
+
+		if ((!is_uastc_ldr_4x4) && (!is_uastc_hdr_4x4) && (!is_astc_hdr_6x6) && (!is_astc_ldr))
 		{
-			w = maximum(w >> 1U, 1U);
-			h = maximum(h >> 1U, 1U);
-			total_levels++;
+			error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding only supports UASTC LDR 4x4, UASTC HDR 4x4, ASTC HDR 6x6 and ASTC LDR 4x4-12x12\n");
+			return cECFailedInvalidParameters;
 		}
 
-		for (uint32_t level = 1; level < total_levels; level++)
+		if ((!m_params.m_create_ktx2_file) || (!m_params.m_write_output_basis_or_ktx2_files) || (m_params.m_out_filename.empty()))
 		{
-			const uint32_t level_width = maximum<uint32_t>(1, img.get_width() >> level);
-			const uint32_t level_height = maximum<uint32_t>(1, img.get_height() >> level);
-
-			imagef& level_img = *enlarge_vector(mips, 1);
-			level_img.resize(level_width, level_height);
+			error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding requires m_create_ktx2_file, m_write_output_basis_or_ktx2_files and m_out_filename\n");
+			return cECFailedInvalidParameters;
+		}
 
-			const imagef* pSource_image = &img;
+		if ((m_params.m_tex_type != basist::cBASISTexType2D) || (m_params.m_mip_gen) ||
+			(m_params.m_source_mipmap_images.size()) || (m_params.m_source_mipmap_images_hdr.size()) ||
+			((m_params.m_resample_width > 0) && (m_params.m_resample_height > 0)) || (m_params.m_resample_factor > 0.0f))
+		{
+			error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding only supports a single 2D image without mipmaps or resampling\n");
+			return cECFailedInvalidParameters;
+		}
 
-			if (m_params.m_mip_fast)
+		for (uint32_t i = 0; i < m_params.m_source_alpha_filenames.size(); i++)
+		{
+			if (m_params.m_source_alpha_filenames[i].size())
 			{
-				if (level > 1)
-					pSource_image = &mips[level - 1];
+				error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding doesn't support alpha source images\n");
+				return cECFailedInvalidParameters;
 			}
+		}
 
-			bool status = image_resample(*pSource_image, level_img, 
-				//m_params.m_mip_filter.c_str(), 
-				"box", // TODO: negative lobes in the filter are causing negative colors, try Mitchell
-				m_params.m_mip_scale, m_params.m_mip_wrapping, 0, has_alpha ? 4 : 3);
-			if (!status)
+		if ((m_params.m_ktx2_uastc_supercompression != basist::KTX2_SS_NONE) && (m_params.m_ktx2_uastc_supercompression != basist::KTX2_SS_ZSTANDARD))
+		{
+			error_printf("basis_compressor::encode_strips_to_ktx2_file: Invalid m_ktx2_uastc_supercompression\n");
+			return cECFailedInvalidParameters;
+		}
+
+		const bool use_callback = (m_params.m_pStrip_source_callback != nullptr);
+		const bool hdr = m_params.m_hdr;
+
+		m_any_source_image_has_alpha = false;
+		m_ktx2_file_size = 0;
+		m_output_ktx2_file.clear();
+
+		// Get the source image, unless the caller's supplying it a strip at a time.
+		image file_image;
+		imagef file_image_hdr;
+		const image* pSource_image = nullptr;
+		const imagef* pSource_image_hdr = nullptr;
+		std::string source_filename;
+		uint32_t width = 0, height = 0;
+
+		if (use_callback)
+		{
+			if (m_params.m_y_flip)
 			{
-				error_printf("basis_compressor::generate_mipmaps: image_resample() failed!\n");
-				return false;
+				error_printf("basis_compressor::encode_strips_to_ktx2_file: m_y_flip isn't supported with m_pStrip_source_callback\n");
+				return cECFailedInvalidParameters;
 			}
 
-			clean_hdr_image(level_img);
+			width = m_params.m_strip_source_width;
+			height = m_params.m_strip_source_height;
 		}
+		else if (m_params.m_read_source_images)
+		{
+			if (m_params.m_source_filenames.size() != 1)
+			{
+				error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding requires exactly one source image\n");
+				return cECFailedInvalidParameters;
+			}
 
-		if (m_params.m_debug)
-			debug_printf("Total mipmap generation time: %3.3f secs\n", tm.get_elapsed_secs());
+			source_filename = m_params.m_source_filenames[0];
 
-		return true;
-	}
+			if (hdr)
+			{
+				float upconversion_nit_multiplier = m_params.m_ldr_hdr_upconversion_nit_multiplier;
+				if (upconversion_nit_multiplier == 0.0f)
+					upconversion_nit_multiplier = LDR_TO_HDR_NITS;
 
-	bool basis_compressor::generate_mipmaps(const image &img, basisu::vector<image> &mips, bool has_alpha)
-	{
-		debug_printf("basis_compressor::generate_mipmaps\n");
+				m_ldr_to_hdr_upconversion_nit_multiplier = upconversion_nit_multiplier;
+				if (!is_image_filename_hdr(source_filename.c_str()))
+					m_upconverted_any_ldr_images = true;
 
-		interval_timer tm;
-		tm.start();
+				if (!load_image_hdr(source_filename.c_str(), file_image_hdr, m_params.m_ldr_hdr_upconversion_srgb_to_linear, upconversion_nit_multiplier, m_params.m_ldr_hdr_upconversion_black_bias))
+				{
+					error_printf("Failed reading source image: %s\n", source_filename.c_str());
+					return cECFailedReadingSourceImages;
+				}
 
-		uint32_t total_levels = 1;
-		uint32_t w = img.get_width(), h = img.get_height();
-		while (maximum<uint32_t>(w, h) > (uint32_t)m_params.m_mip_smallest_dimension)
-		{
-			w = maximum(w >> 1U, 1U);
-			h = maximum(h >> 1U, 1U);
-			total_levels++;
-		}
+				pSource_image_hdr = &file_image_hdr;
+			}
+			else
+			{
+				if (!load_image(source_filename.c_str(), file_image))
+				{
+					error_printf("Failed reading source image: %s\n", source_filename.c_str());
+					return cECFailedReadingSourceImages;
+				}
 
-#if BASISU_USE_STB_IMAGE_RESIZE_FOR_MIPMAP_GEN
-		// Requires stb_image_resize
-		stbir_filter filter = STBIR_FILTER_DEFAULT;
-		if (m_params.m_mip_filter == "box")
+				pSource_image = &file_image;
+			}
+		}
+		else
+		{
+			if ((hdr ? m_params.m_source_images_hdr.size() : m_params.m_source_images.size()) != 1)
+			{
+				error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip encoding requires exactly one source image\n");
+				return cECFailedInvalidParameters;
+			}
+
+			if (hdr)
+				pSource_image_hdr = &m_params.m_source_images_hdr[0];
+			else
+				pSource_image = &m_params.m_source_images[0];
+		}
+
+		if (pSource_image)
+		{
+			width = pSource_image->get_width();
+			height = pSource_image->get_height();
+		}
+		else if (pSource_image_hdr)
+		{
+			width = pSource_image_hdr->get_width();
+			height = pSource_image_hdr->get_height();
+		}
+
+		if ((!width) || (!height) || (width > basist::BASISU_MAX_SUPPORTED_TEXTURE_DIMENSION) || (height > basist::BASISU_MAX_SUPPORTED_TEXTURE_DIMENSION))
+		{
+			error_printf("basis_compressor::encode_strips_to_ktx2_file: Invalid source image dimensions %ux%u\n", width, height);
+			return cECFailedReadingSourceImages;
+		}
+
+		if ((m_params.m_status_output) && (source_filename.size()))
+			printf("Read source image \"%s\", %ux%u\n", source_filename.c_str(), width, height);
+
+		const uint32_t block_width = get_block_width(), block_height = get_block_height();
+		const uint32_t strip_height = ((m_params.m_strip_height + block_height - 1) / block_height) * block_height;
+		const uint32_t num_blocks_x = (width + block_width - 1) / block_width;
+		const uint32_t num_blocks_y = (height + block_height - 1) / block_height;
+
+		const texture_format tex_fmt = is_uastc_ldr_4x4 ? texture_format::cUASTC4x4 :
+			(is_uastc_hdr_4x4 ? texture_format::cUASTC_HDR_4x4 :
+			(is_astc_hdr_6x6 ? texture_format::cASTC_HDR_6x6 : basist::basis_get_texture_format_from_xuastc_or_astc_ldr_basis_tex_format(m_fmt_mode)));
+
+		const bool alpha_swizzled = (!hdr) && (m_params.m_swizzle[3] != 3);
+		const bool any_swizzle = (m_params.m_swizzle[0] != 0) || (m_params.m_swizzle[1] != 1) || (m_params.m_swizzle[2] != 2) || (m_params.m_swizzle[3] != 3);
+
+		// Determine alpha usage up front if we can (the ASTC LDR encoder config depends on it), otherwise it's detected strip by strip.
+		if (!hdr)
+		{
+			if ((m_params.m_force_alpha) || (alpha_swizzled))
+				m_any_source_image_has_alpha = true;
+			else if ((m_params.m_check_for_alpha) && (pSource_image))
+				m_any_source_image_has_alpha = pSource_image->has_alpha(m_params.m_swizzle[3]);
+			else if ((m_params.m_check_for_alpha) && (use_callback))
+				m_any_source_image_has_alpha = (m_params.m_strip_source_alpha == 1);
+		}
+
+		const bool callback_alpha_unknown = (!hdr) && (use_callback) && (m_params.m_check_for_alpha) && (!m_params.m_force_alpha) && (!alpha_swizzled) && 
+			(m_params.m_strip_source_alpha < 0);
+
+		astc_ldr::astc_ldr_encode_config astc_ldr_cfg;
+		astc_6x6_hdr::astc_hdr_6x6_global_config astc_hdr_6x6_cfg(m_params.m_astc_hdr_6x6_options);
+
+		if (is_astc_ldr)
+		{
+			// The config depends on alpha usage. If the callback's is unknown, configure for alpha, as any source with alpha would be.
+			const bool any_source_image_has_alpha = m_any_source_image_has_alpha;
+			if (callback_alpha_unknown)
+				m_any_source_image_has_alpha = true;
+
+			const bool cfg_status = get_astc_ldr_encode_config(astc_ldr_cfg);
+
+			m_any_source_image_has_alpha = any_source_image_has_alpha;
+
+			if (!cfg_status)
+				return cECFailedInvalidParameters;
+		}
+		else if (is_astc_hdr_6x6)
+		{
+			astc_hdr_6x6_cfg.m_image_stats = false;
+			astc_hdr_6x6_cfg.m_debug_images = false;
+			astc_hdr_6x6_cfg.m_output_images = false;
+			astc_hdr_6x6_cfg.m_debug_output = m_params.m_debug;
+			astc_hdr_6x6_cfg.m_status_output = m_params.m_debug;
+			astc_hdr_6x6_cfg.m_pProgress = &m_progress;
+		}
+		else if (is_uastc_hdr_4x4)
+		{
+			set_uastc_hdr_4x4_error_weights(m_params);
+		}
+
+		if (m_params.m_status_output)
+		{
+			fmt_printf("Mode: {} strip encoding, {}x{}, {} rows per strip\n", basist::basis_get_tex_format_name(m_fmt_mode), width, height, strip_height);
+		}
+
+		basist::ktx2_header header;
+		memset((void*)&header, 0, sizeof(header));
+
+		memcpy(header.m_identifier, basist::g_ktx2_file_identifier, sizeof(basist::g_ktx2_file_identifier));
+		header.m_pixel_width = width;
+		header.m_pixel_height = height;
+		header.m_face_count = 1;
+
+		uint32_t vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
+		if (!get_ktx2_vk_format(vk_format))
+			return cECFailedCreateKTX2File;
+
+		header.m_vk_format = vk_format;
+		header.m_type_size = 1;
+		header.m_level_count = 1;
+		header.m_layer_count = 0;
+		header.m_supercompression_scheme = basist::KTX2_SS_NONE;
+
+#if BASISD_SUPPORT_KTX2_ZSTD
+		if (m_params.m_ktx2_uastc_supercompression == basist::KTX2_SS_ZSTANDARD)
+			header.m_supercompression_scheme = basist::KTX2_SS_ZSTANDARD;
+#endif
+
+		uint8_vec dfd;
+		if (!get_dfd(dfd, header))
+			return cECFailedCreateKTX2File;
+
+		uint8_vec key_value_data;
+		if (!get_ktx2_key_value_data(header, 1, (uint32_t)dfd.size(), key_value_data))
+			return cECFailedCreateKTX2File;
+
+		// Header, level index and DFD - rewritten once the level's size and alpha usage are known.
+		uint8_vec file_prefix(sizeof(header) + sizeof(basist::ktx2_level_index));
+
+		header.m_dfd_byte_offset = file_prefix.size();
+		header.m_dfd_byte_length = (uint32_t)dfd.size();
+		append_vector(file_prefix, dfd);
+
+		if (key_value_data.size())
+		{
+			header.m_kvd_byte_offset = file_prefix.size();
+			header.m_kvd_byte_length = key_value_data.size();
+			append_vector(file_prefix, key_value_data);
+		}
+
+		// Write mipPadding
+		if (header.m_supercompression_scheme == basist::KTX2_SS_NONE)
+		{
+			const uint32_t padding = (16 - (file_prefix.size() & 15)) & 15;
+			for (uint32_t i = 0; i < padding; i++)
+				file_prefix.push_back(0);
+		}
+
+		const uint64_t level_data_ofs = file_prefix.size();
+
+		FILE* pFile = fopen_safe(m_params.m_out_filename.c_str(), "wb");
+		if (!pFile)
+		{
+			error_printf("Failed creating output file \"%s\"\n", m_params.m_out_filename.c_str());
+			return cECFailedWritingOutput;
+		}
+
+#if BASISD_SUPPORT_KTX2_ZSTD
+		ZSTD_CCtx* pZstd_ctx = nullptr;
+		uint8_vec zstd_out_buf;
+#endif
+
+		// Closes and deletes the partially written output file.
+		auto fail = [&](error_code ec) -> error_code
+		{
+#if BASISD_SUPPORT_KTX2_ZSTD
+			if (pZstd_ctx)
+				ZSTD_freeCCtx(pZstd_ctx);
+#endif
+			fclose(pFile);
+			remove(m_params.m_out_filename.c_str());
+			return ec;
+		};
+
+		if (fwrite(file_prefix.data(), file_prefix.size(), 1, pFile) != 1)
+			return fail(cECFailedWritingOutput);
+
+		uint64_t level_data_size = 0, uncompressed_level_data_size = 0;
+
+#if BASISD_SUPPORT_KTX2_ZSTD
+		if (header.m_supercompression_scheme == basist::KTX2_SS_ZSTANDARD)
+		{
+			pZstd_ctx = ZSTD_createCCtx();
+			if (!pZstd_ctx)
+				return fail(cECFailedCreateKTX2File);
+
+			ZSTD_CCtx_setParameter(pZstd_ctx, ZSTD_c_compressionLevel, m_params.m_ktx2_zstd_supercompression_level);
+			ZSTD_CCtx_setPledgedSrcSize(pZstd_ctx, (unsigned long long)num_blocks_x * num_blocks_y * get_qwords_per_block(tex_fmt) * sizeof(uint64_t));
+
+			zstd_out_buf.resize(ZSTD_CStreamOutSize());
+		}
+#endif
+
+		// Appends level data to the output file, through the Zstd stream if any. last=true flushes the stream.
+		auto write_level_data = [&](const void* pData, size_t data_size, bool last) -> bool
+		{
+			uncompressed_level_data_size += data_size;
+
+#if BASISD_SUPPORT_KTX2_ZSTD
+			if (pZstd_ctx)
+			{
+				ZSTD_inBuffer in_buf = { pData, data_size, 0 };
+
+				for ( ; ; )
+				{
+					ZSTD_outBuffer out_buf = { zstd_out_buf.data(), zstd_out_buf.size(), 0 };
+
+					const size_t remaining = ZSTD_compressStream2(pZstd_ctx, &out_buf, &in_buf, last ? ZSTD_e_end : ZSTD_e_continue);
+					if (ZSTD_isError(remaining))
+						return false;
+
+					if ((out_buf.pos) && (fwrite(zstd_out_buf.data(), out_buf.pos, 1, pFile) != 1))
+						return false;
+
+					level_data_size += out_buf.pos;
+
+					if (last ? (!remaining) : (in_buf.pos == in_buf.size))
+						break;
+				}
+
+				return true;
+			}
+#endif
+			BASISU_NOTE_UNUSED(last);
+
+			if ((data_size) && (fwrite(pData, data_size, 1, pFile) != 1))
+				return false;
+
+			level_data_size += data_size;
+			return true;
+		};
+
+		m_stats.resize(0);
+		m_stats.resize(1);
+
+		fused_image_metrics total_metrics;
+		const bool compute_stats = m_params.m_compute_stats && (!hdr);
+
+		image strip_image, unpacked_strip_image;
+		imagef strip_image_hdr;
+		gpu_image strip_tex;
+		basisu::vector<color_rgba> strip_block_pixels;
+
+		std::atomic<bool> any_failures;
+		any_failures.store(false);
+
+		// The strip buffers aren't the members update_peak_buffer_bytes() adds up, so count them here. extra_bytes is the current strip's encoder output.
+		auto update_strip_peak_buffer_bytes = [&](uint64_t extra_bytes)
+		{
+			uint64_t total = file_image.get_pixels().size_in_bytes() + file_image_hdr.get_pixels().size_in_bytes();
+
+			total += strip_image.get_pixels().size_in_bytes() + strip_image_hdr.get_pixels().size_in_bytes() + unpacked_strip_image.get_pixels().size_in_bytes();
+			total += strip_tex.get_size_in_bytes() + strip_block_pixels.size_in_bytes() + file_prefix.size();
+#if BASISD_SUPPORT_KTX2_ZSTD
+			total += zstd_out_buf.size();
+#endif
+			total += extra_bytes;
+
+			m_peak_buffer_bytes = maximum(m_peak_buffer_bytes, total);
+		};
+
+		uint32_t strip_index = 0;
+		for (uint32_t first_row = 0; first_row < height; first_row += strip_height, strip_index++)
+		{
+			BASISU_TRACE_ZONE_ARG("strip", strip_index);
+
+			const uint32_t num_rows = minimum<uint32_t>(strip_height, height - first_row);
+
+			m_progress.set_range(lerp(PROGRESS_SOURCE_IMAGES_END, 100.0f, (float)first_row / height), lerp(PROGRESS_SOURCE_IMAGES_END, 100.0f, (float)(first_row + num_rows) / height));
+			if (!m_progress.update())
+				return fail(cECCancelled);
+
+			if (m_params.m_status_output)
+				fmt_printf("Encoding strip {}, rows {}-{}\n", strip_index, first_row, first_row + num_rows - 1);
+
+			// Read the strip's source rows
+			if (hdr)
+			{
+				strip_image_hdr.resize(width, num_rows);
+
+				if (use_callback)
+				{
+					if (!m_params.m_pStrip_source_callback(first_row, num_rows, nullptr, &strip_image_hdr, m_params.m_pStrip_source_callback_data))
+						return fail(cECFailedReadingSourceImages);
+				}
+				else
+				{
+					for (uint32_t y = 0; y < num_rows; y++)
+					{
+						const uint32_t src_y = m_params.m_y_flip ? (height - 1 - (first_row + y)) : (first_row + y);
+						memcpy((void*)&strip_image_hdr(0, y), &(*pSource_image_hdr)(0, src_y), width * sizeof(vec4F));
+					}
+				}
+
+				// For now, alpha is always 1.0f in UASTC HDR.
+				for (uint32_t y = 0; y < num_rows; y++)
+				{
+					for (uint32_t x = 0; x < width; x++)
+					{
+						const vec4F c(strip_image_hdr(x, y));
+						strip_image_hdr(x, y).set(c[m_params.m_swizzle[0]], c[m_params.m_swizzle[1]], c[m_params.m_swizzle[2]], 1.0f);
+					}
+				}
+
+				// Each strip is encoded independently, so unlike clean_hdr_image() we can't rescale the image to fit, just clamp.
+				if (!strip_image_hdr.clean_astc_hdr_pixels(basist::ASTC_HDR_MAX_VAL))
+					printf("Warning: clean_astc_hdr_pixels() had to modify strip %u to encode to ASTC HDR - see previous warning(s).\n", strip_index);
+			}
+			else
+			{
+				strip_image.resize(width, num_rows);
+
+				if (use_callback)
+				{
+					if (!m_params.m_pStrip_source_callback(first_row, num_rows, &strip_image, nullptr, m_params.m_pStrip_source_callback_data))
+						return fail(cECFailedReadingSourceImages);
+				}
+				else
+				{
+					for (uint32_t y = 0; y < num_rows; y++)
+					{
+						const uint32_t src_y = m_params.m_y_flip ? (height - 1 - (first_row + y)) : (first_row + y);
+						memcpy((void*)&strip_image(0, y), &(*pSource_image)(0, src_y), width * sizeof(color_rgba));
+					}
+				}
+
+				if (m_params.m_renormalize)
+					strip_image.renormalize_normal_map();
+
+				if (any_swizzle)
+				{
+					for (uint32_t y = 0; y < num_rows; y++)
+					{
+						for (uint32_t x = 0; x < width; x++)
+						{
+							const color_rgba& c = strip_image(x, y);
+							strip_image(x, y).set_noclamp_rgba(c[m_params.m_swizzle[0]], c[m_params.m_swizzle[1]], c[m_params.m_swizzle[2]], c[m_params.m_swizzle[3]]);
+						}
+					}
+				}
+
+				if ((!m_params.m_force_alpha) && (!alpha_swizzled))
+				{
+					if (!m_params.m_check_for_alpha)
+						strip_image.set_alpha(255);
+					else if ((use_callback) && (!m_any_source_image_has_alpha) && (strip_image.has_alpha()))
+					{
+						if (!callback_alpha_unknown)
+						{
+							error_printf("basis_compressor::encode_strips_to_ktx2_file: Strip %u has alpha, but m_strip_source_alpha is 0\n", strip_index);
+							return fail(cECFailedReadingSourceImages);
+						}
+
+						m_any_source_image_has_alpha = true;
+					}
+				}
+			}
+
+			// Encode the strip
+			strip_tex.init(tex_fmt, width, num_rows);
+
+			const uint32_t strip_blocks_x = strip_tex.get_blocks_x();
+			const uint32_t strip_total_blocks = strip_tex.get_total_blocks();
+
+			if ((is_uastc_ldr_4x4) || (is_uastc_hdr_4x4))
+			{
+				m_progress.begin_stage(0.0f, (is_uastc_ldr_4x4 && m_params.m_rdo_uastc_ldr_4x4) ? .5f : 1.0f, strip_total_blocks);
+
+				if (is_uastc_ldr_4x4)
+					strip_block_pixels.resize(strip_total_blocks * 16);
+
+				const uint32_t N = 256;
+				for (uint32_t block_index_iter = 0; block_index_iter < strip_total_blocks; block_index_iter += N)
+				{
+					const uint32_t first_index = block_index_iter;
+					const uint32_t last_index = minimum<uint32_t>(strip_total_blocks, block_index_iter + N);
+
+					m_params.m_pJob_pool->add_job([this, first_index, last_index, strip_blocks_x, is_uastc_ldr_4x4, &strip_image, &strip_image_hdr, &strip_tex, &strip_block_pixels, &any_failures]
+						{
+							if (m_progress.is_stopped())
+								return;
+
+							if (is_uastc_ldr_4x4)
+							{
+								uint32_t uastc_flags = m_params.m_pack_uastc_ldr_4x4_flags;
+								if ((m_params.m_rdo_uastc_ldr_4x4) && (m_params.m_rdo_uastc_ldr_4x4_favor_simpler_modes_in_rdo_mode))
+									uastc_flags |= cPackUASTCFavorSimplerModes;
+
+								for (uint32_t block_index = first_index; block_index < last_index; block_index++)
+								{
+									const uint32_t block_x = block_index % strip_blocks_x;
+									const uint32_t block_y = block_index / strip_blocks_x;
+
+									color_rgba* pBlock_pixels = &strip_block_pixels[block_index * 16];
+
+									strip_image.extract_block_clamped(pBlock_pixels, block_x * 4, block_y * 4, 4, 4);
+
+									encode_uastc(&pBlock_pixels->r, *(basist::uastc_block*)strip_tex.get_block_ptr(block_x, block_y), uastc_flags);
+								}
+							}
+							else
+							{
+								basisu::vector<astc_hdr_4x4_pack_results> all_results;
+								all_results.reserve(256);
+
+								for (uint32_t block_index = first_index; block_index < last_index; block_index++)
+								{
+									const uint32_t block_x = block_index % strip_blocks_x;
+									const uint32_t block_y = block_index / strip_blocks_x;
+
+									vec4F block_pixels[16];
+									strip_image_hdr.extract_block_clamped(&block_pixels[0], block_x * 4, block_y * 4, 4, 4);
+
+									if (encode_uastc_hdr_4x4_block(block_pixels, m_params.m_uastc_hdr_4x4_options, all_results, *(basist::astc_blk*)strip_tex.get_block_ptr(block_x, block_y)) < 0)
+										any_failures.store(true);
+								}
+							}
+
+							m_progress.update(last_index - first_index);
+						});
+
+				} // block_index_iter
+
+				m_params.m_pJob_pool->wait_for_all();
+
+				if (m_progress.is_stopped())
+					return fail(cECCancelled);
+
+				if (any_failures)
+					return fail(cECFailedEncodeUASTC);
+
+				if ((is_uastc_ldr_4x4) && (m_params.m_rdo_uastc_ldr_4x4))
+				{
+					m_progress.begin_stage(.5f, 1.0f, strip_total_blocks);
+
+					uastc_rdo_params rdo_params;
+					rdo_params.m_pProgress = &m_progress;
+					rdo_params.m_lambda = m_params.m_rdo_uastc_ldr_4x4_quality_scalar;
+					rdo_params.m_max_allowed_rms_increase_ratio = m_params.m_rdo_uastc_ldr_4x4_max_allowed_rms_increase_ratio;
+					rdo_params.m_skip_block_rms_thresh = m_params.m_rdo_uastc_ldr_4x4_skip_block_rms_thresh;
+					rdo_params.m_lz_dict_size = m_params.m_rdo_uastc_ldr_4x4_dict_size;
+					rdo_params.m_smooth_block_max_error_scale = m_params.m_rdo_uastc_ldr_4x4_max_smooth_block_error_scale;
+					rdo_params.m_max_smooth_block_std_dev = m_params.m_rdo_uastc_ldr_4x4_smooth_block_max_std_dev;
+
+					bool status = uastc_rdo(strip_total_blocks, (basist::uastc_block*)strip_tex.get_ptr(),
+						strip_block_pixels.data(), rdo_params, m_params.m_pack_uastc_ldr_4x4_flags, m_params.m_rdo_uastc_ldr_4x4_multithreading ? m_params.m_pJob_pool : nullptr,
+						(m_params.m_rdo_uastc_ldr_4x4_multithreading && m_params.m_pJob_pool) ? basisu::minimum<uint32_t>(4, (uint32_t)m_params.m_pJob_pool->get_total_threads()) : 0);
+					if (!status)
+						return fail(cECFailedUASTCRDOPostProcess);
+				}
+			}
+			else if (is_astc_hdr_6x6)
+			{
+				uint8_vec intermediate_tex_data, astc_tex_data;
+				astc_6x6_hdr::result_metrics metrics;
+
+				if (!astc_6x6_hdr::compress_photo(strip_image_hdr, astc_hdr_6x6_cfg, m_params.m_pJob_pool, intermediate_tex_data, astc_tex_data, metrics))
+					return fail(m_progress.is_stopped() ? cECCancelled : cECFailedEncodeUASTC);
+
+				assert(strip_tex.get_size_in_bytes() == astc_tex_data.size_in_bytes());
+				if (strip_tex.get_size_in_bytes() != astc_tex_data.size_in_bytes())
+					return fail(cECFailedEncodeUASTC);
+
+				memcpy(strip_tex.get_ptr(), astc_tex_data.data(), astc_tex_data.size_in_bytes());
+
+				update_strip_peak_buffer_bytes(intermediate_tex_data.size_in_bytes() + astc_tex_data.size_in_bytes());
+			}
+			else
+			{
+				assert(is_astc_ldr);
+
+				uint8_vec intermediate_tex_data;
+				vector2D<astc_helpers::log_astc_block> coded_log_blocks;
+
+				astc_ldr_cfg.m_debug_file_prefix = fmt_string("strip_{}_", strip_index);
+
+				if (!astc_ldr::compress_image(strip_image, intermediate_tex_data, coded_log_blocks, astc_ldr_cfg, *m_params.m_pJob_pool))
+					return fail(m_progress.is_stopped() ? cECCancelled : cECFailedEncodeUASTC);
+
+				assert((coded_log_blocks.get_width() == strip_tex.get_blocks_x()) && (coded_log_blocks.get_height() == strip_tex.get_blocks_y()));
+
+				for (uint32_t by = 0; by < strip_tex.get_blocks_y(); by++)
+				{
+					for (uint32_t bx = 0; bx < strip_tex.get_blocks_x(); bx++)
+					{
+						if (!astc_helpers::pack_astc_block(*static_cast<astc_helpers::astc_block*>(strip_tex.get_block_ptr(bx, by)), coded_log_blocks(bx, by)))
+						{
+							error_printf("basis_compressor::encode_strips_to_ktx2_file: pack_astc_block() failed!\n");
+							return fail(cECFailedEncodeUASTC);
+						}
+					}
+				}
+
+				update_strip_peak_buffer_bytes(intermediate_tex_data.size_in_bytes() + (uint64_t)coded_log_blocks.get_width() * coded_log_blocks.get_height() * sizeof(astc_helpers::log_astc_block));
+			}
+
+			if (!write_level_data(strip_tex.get_ptr(), strip_tex.get_size_in_bytes(), false))
+			{
+				error_printf("Failed writing output data to file \"%s\"\n", m_params.m_out_filename.c_str());
+				return fail(cECFailedWritingOutput);
+			}
+
+			if (compute_stats)
+			{
+				BASISU_TRACE_ZONE_ARG("stats", strip_index);
+
+				if (!strip_tex.unpack(unpacked_strip_image, is_astc_ldr && m_params.m_ktx2_and_basis_srgb_transfer_function))
+					return fail(cECFailedValidating);
+
+				fused_image_metrics strip_metrics;
+				strip_metrics.calc(strip_image, unpacked_strip_image, m_params.m_pJob_pool);
+				total_metrics.add(strip_metrics);
+			}
+
+			update_strip_peak_buffer_bytes(0);
+
+		} // first_row
+
+		if (!write_level_data(nullptr, 0, true))
+		{
+			error_printf("Failed writing output data to file \"%s\"\n", m_params.m_out_filename.c_str());
+			return fail(cECFailedWritingOutput);
+		}
+
+#if BASISD_SUPPORT_KTX2_ZSTD
+		if (pZstd_ctx)
+		{
+			ZSTD_freeCCtx(pZstd_ctx);
+			pZstd_ctx = nullptr;
+		}
+#endif
+
+		// Now patch the header, level index, and DFD (whose channel type depends on whether any strip had alpha).
+		basist::ktx2_level_index level_index;
+		level_index.m_byte_offset = level_data_ofs;
+		level_index.m_byte_length = level_data_size;
+		level_index.m_uncompressed_byte_length = uncompressed_level_data_size;
+
+		uint8_vec final_dfd;
+		if ((!get_dfd(final_dfd, header)) || (final_dfd.size() != dfd.size()))
+			return fail(cECFailedCreateKTX2File);
+
+		memcpy(file_prefix.data(), &header, sizeof(header));
+		memcpy(file_prefix.data() + sizeof(header), &level_index, sizeof(level_index));
+		memcpy(file_prefix.data() + header.m_dfd_byte_offset, final_dfd.data(), final_dfd.size());
+
+		if ((fseek(pFile, 0, SEEK_SET) != 0) || (fwrite(file_prefix.data(), (size_t)header.m_dfd_byte_offset + final_dfd.size(), 1, pFile) != 1))
+			return fail(cECFailedWritingOutput);
+
+		if (fclose(pFile) == EOF)
+		{
+			remove(m_params.m_out_filename.c_str());
+			return cECFailedWritingOutput;
+		}
+
+		if (m_params.m_status_output)
+			printf("Wrote compressed output file \"%s\"\n", m_params.m_out_filename.c_str());
+
+		m_ktx2_file_size = level_data_ofs + level_data_size;
+		m_ktx2_bits_per_texel = (m_ktx2_file_size * 8.0f) / ((double)width * height);
+
+		BASISU_TRACE_COUNTER("output_file_bytes", m_ktx2_file_size);
+
+		fmt_debug_printf("Total .ktx2 output file size: {}, {3.3} bits/texel\n", m_ktx2_file_size, m_ktx2_bits_per_texel);
+
+		image_stats& s = m_stats[0];
+		s.m_filename = source_filename;
+		s.m_width = width;
+		s.m_height = height;
+
+		if (compute_stats)
+		{
+			s.m_tex_format = tex_fmt;
+
+			image_metrics em;
+
+			if (m_params.m_print_stats)
+				fmt_printf("Quality stats vs. {} texture:\n", get_texture_format_name(tex_fmt));
+
+			total_metrics.get(em, 0, 3);
+			if (m_params.m_print_stats)
+				em.print("RGB Avg:          ");
+			s.m_basis_rgb_avg_psnr = (float)em.m_psnr;
+
+			total_metrics.get(em, 0, 4);
+			if (m_params.m_print_stats)
+				em.print("RGBA Avg:         ");
+			s.m_basis_rgba_avg_psnr = (float)em.m_psnr;
+
+			total_metrics.get(em, 3, 1);
+			if (m_params.m_print_stats)
+				em.print("A   Avg:          ");
+			s.m_basis_a_avg_psnr = (float)em.m_psnr;
+
+			total_metrics.get(em, 0, 0);
+			if (m_params.m_print_stats)
+				em.print("709 Luma:         ");
+			s.m_basis_luma_709_psnr = static_cast<float>(em.m_psnr);
+			s.m_basis_luma_709_ssim = static_cast<float>(em.m_ssim);
+
+			total_metrics.get(em, 0, 0, true, true);
+			if (m_params.m_print_stats)
+				em.print("601 Luma:         ");
+			s.m_basis_luma_601_psnr = static_cast<float>(em.m_psnr);
+		}
+
+		m_progress.set_range(100.0f, 100.0f);
+		m_progress.update();
+
+		if (m_params.m_status_output)
+			fmt_printf("basis_compressor::process: Success\n");
+
+		return cECSuccess;
+	}
+
+	bool basis_compressor::generate_mipmaps(const imagef& img, basisu::vector<imagef>& mips, bool has_alpha)
+	{
+		debug_printf("basis_compressor::generate_mipmaps\n");
+
+		BASISU_TRACE_ZONE("mipgen");
+
+		interval_timer tm;
+		tm.start();
+
+		uint32_t total_levels = 1;
+		uint32_t w = img.get_width(), h = img.get_height();
+		while (maximum<uint32_t>(w, h) > (uint32_t)m_params.m_mip_smallest_dimension)
+		{
+			w = maximum(w >> 1U, 1U);
+			h = maximum(h >> 1U, 1U);
+			total_levels++;
+		}
+
+		for (uint32_t level = 1; level < total_levels; level++)
+		{
+			const uint32_t level_width = maximum<uint32_t>(1, img.get_width() >> level);
+			const uint32_t level_height = maximum<uint32_t>(1, img.get_height() >> level);
+
+			imagef& level_img = *enlarge_vector(mips, 1);
+			level_img.resize(level_width, level_height);
+
+			const imagef* pSource_image = &img;
+
+			if (m_params.m_mip_fast)
+			{
+				if (level > 1)
+					pSource_image = &mips[level - 1];
+			}
+
+			bool status = image_resample(*pSource_image, level_img, 
+				//m_params.m_mip_filter.c_str(), 
+				"box", // TODO: negative lobes in the filter are causing negative colors, try Mitchell
+				m_params.m_mip_scale, m_params.m_mip_wrapping, 0, has_alpha ? 4 : 3);
+			if (!status)
+			{
+				error_printf("basis_compressor::generate_mipmaps: image_resample() failed!\n");
+				return false;
+			}
+
+			clean_hdr_image(level_img);
+		}
+
+		if (m_params.m_debug)
+			debug_printf("Total mipmap generation time: %3.3f secs\n", tm.get_elapsed_secs());
+
+		return true;
+	}
+
+	bool basis_compressor::generate_mipmaps(const image &img, basisu::vector<image> &mips, bool has_alpha)
+	{
+		debug_printf("basis_compressor::generate_mipmaps\n");
+
+		BASISU_TRACE_ZONE("mipgen");
+
+		interval_timer tm;
+		tm.start();
+
+		uint32_t total_levels = 1;
+		uint32_t w = img.get_width(), h = img.get_height();
+		while (maximum<uint32_t>(w, h) > (uint32_t)m_params.m_mip_smallest_dimension)
+		{
+			w = maximum(w >> 1U, 1U);
+			h = maximum(h >> 1U, 1U);
+			total_levels++;
+		}
+
+#if BASISU_USE_STB_IMAGE_RESIZE_FOR_MIPMAP_GEN
+		// Requires stb_image_resize
+		stbir_filter filter = STBIR_FILTER_DEFAULT;
+		if (m_params.m_mip_filter == "box")
 			filter = STBIR_FILTER_BOX;
 		else if (m_params.m_mip_filter == "triangle")
 			filter = STBIR_FILTER_TRIANGLE;
@@ -2311,6 +3779,8 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::read_dds_source_images\n");
 
+		BASISU_TRACE_ZONE("read_dds_source_images");
+
 		// Nothing to do if the caller doesn't want us reading source images.
 		if ((!m_params.m_read_source_images) || (!m_params.m_source_filenames.size()))
 			return true;
@@ -2442,6 +3912,8 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::read_source_images\n");
 
+		BASISU_TRACE_ZONE("read_source_images");
+
 		const uint32_t total_source_files = m_params.m_read_source_images ? (uint32_t)m_params.m_source_filenames.size() : 
 			(m_params.m_hdr ? (uint32_t)m_params.m_source_images_hdr.size() : (uint32_t)m_params.m_source_images.size());
 
@@ -3024,8 +4496,9 @@ namespace basisu
 					}
 					else
 					{
-						// ETC1S: only the first frame is currently an iframe. (TODO: We can easily fix this so ETC1S has periodic i-frames.)
-						slice_desc.m_iframe = (source_file_index == 0);
+						// ETC1S: the first frame is always an iframe, then one every m_etc1s_video_iframe_interval frames (if not 0).
+						const uint32_t iframe_interval = m_params.m_etc1s_video_iframe_interval;
+						slice_desc.m_iframe = iframe_interval ? ((source_file_index % iframe_interval) == 0) : (source_file_index == 0);
 					}
 				}
 
@@ -3208,6 +4681,8 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::extract_source_blocks\n");
 
+		BASISU_TRACE_ZONE("extract_source_blocks");
+
 		// No need to extract blocks in 6x6 mode, but the 4x4 compressors want 4x4 blocks.
 		if ((m_fmt_mode == basist::basis_tex_format::cASTC_HDR_6x6) || (m_fmt_mode == basist::basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE))
 			return true;
@@ -3271,6 +4746,8 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::process_frontend\n");
 						
+		BASISU_TRACE_ZONE("frontend");
+
 #if 0
 		// TODO
 		basis_etc1_pack_params pack_params;
@@ -3434,6 +4911,8 @@ namespace basisu
 		p.m_validate = m_params.m_validate_etc1s;
 		p.m_pJob_pool = m_params.m_pJob_pool;
 		p.m_pGlobal_codebooks = m_params.m_pGlobal_codebooks;
+		p.m_fast_global_codebook_search = m_params.m_fast_global_codebook_search;
+		p.m_pProgress = &m_progress;
 		
 		// Don't keep trying to use OpenCL if it ever fails.
 		p.m_pOpenCL_context = !m_opencl_failed ? m_pOpenCL_context : nullptr;
@@ -3443,12 +4922,20 @@ namespace basisu
 			error_printf("basisu_frontend::init() failed!\n");
 			return false;
 		}
+
+		// The frontend keeps its own copy of the source blocks.
+		if (m_params.m_low_memory)
+			m_source_blocks.clear();
 				
-		m_frontend.compress();
+		const bool frontend_succeeded = m_frontend.compress();
 
 		if (m_frontend.get_opencl_failed())
 			m_opencl_failed = true;
 
+		// A validation failure is only reported by the frontend, we just have to stop here if the encode was cancelled.
+		if ((!frontend_succeeded) && (m_progress.is_stopped()))
+			return false;
+
 		if (m_params.m_debug_images)
 		{
 			for (uint32_t i = 0; i < m_slice_descs.size(); i++)
@@ -3475,12 +4962,15 @@ namespace basisu
 
 	bool basis_compressor::extract_frontend_texture_data()
 	{
+		BASISU_TRACE_ZONE("extract_frontend_texture_data");
+
 		if (!m_params.m_compute_stats)
 			return true;
 
 		debug_printf("basis_compressor::extract_frontend_texture_data\n");
 
-		m_frontend_output_textures.resize(m_slice_descs.size());
+		// m_frontend_output_textures is only used for debugging, so skip it in low memory mode.
+		m_frontend_output_textures.resize(m_params.m_low_memory ? 0 : m_slice_descs.size());
 		m_best_etc1s_images.resize(m_slice_descs.size());
 		m_best_etc1s_images_unpacked.resize(m_slice_descs.size());
 
@@ -3497,11 +4987,14 @@ namespace basisu
 			const uint32_t width = num_blocks_x * 4;
 			const uint32_t height = num_blocks_y * 4;
 
-			m_frontend_output_textures[i].init(texture_format::cETC1, width, height);
+			if (!m_params.m_low_memory)
+			{
+				m_frontend_output_textures[i].init(texture_format::cETC1, width, height);
 
-			for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
-				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
-					memcpy(m_frontend_output_textures[i].get_block_ptr(block_x, block_y, 0), &m_frontend.get_output_block(slice_desc.m_first_block_index + block_x + block_y * num_blocks_x), sizeof(etc_block));
+				for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+					for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+						memcpy(m_frontend_output_textures[i].get_block_ptr(block_x, block_y, 0), &m_frontend.get_output_block(slice_desc.m_first_block_index + block_x + block_y * num_blocks_x), sizeof(etc_block));
+			}
 
 #if 0
 			if (m_params.m_debug_images)
@@ -3518,15 +5011,88 @@ namespace basisu
 					memcpy(m_best_etc1s_images[i].get_block_ptr(block_x, block_y, 0), &m_frontend.get_etc1s_block(slice_desc.m_first_block_index + block_x + block_y * num_blocks_x), sizeof(etc_block));
 
 			m_best_etc1s_images[i].unpack(m_best_etc1s_images_unpacked[i], false);
+
+			// The packed texture is only needed again for the debug images.
+			if ((m_params.m_low_memory) && (!m_params.m_debug_images))
+				m_best_etc1s_images[i].clear();
 		}
 
 		return true;
 	}
 
+	// Low memory mode: frees the buffers only the encoders need. The source slice images are kept if the stats or debug images use them.
+	void basis_compressor::free_encode_buffers()
+	{
+		m_source_blocks.clear();
+		m_source_blocks_hdr.clear();
+		m_uastc_slice_textures.clear();
+
+		if ((!m_params.m_validate_output_data) || ((!m_params.m_compute_stats) && (!m_params.m_debug_images)))
+		{
+			m_slice_images.clear();
+			m_slice_images_hdr.clear();
+		}
+	}
+
+	void basis_compressor::free_decoded_textures()
+	{
+		m_frontend_output_textures.clear();
+		m_best_etc1s_images.clear();
+		m_best_etc1s_images_unpacked.clear();
+
+		m_decoded_output_textures.clear();
+		m_decoded_output_textures_unpacked.clear();
+		m_decoded_output_textures_bc7.clear();
+		m_decoded_output_textures_unpacked_bc7.clear();
+		m_decoded_output_textures_bc6h_hdr_unpacked.clear();
+		m_decoded_output_textures_astc_hdr.clear();
+		m_decoded_output_textures_astc_hdr_unpacked.clear();
+	}
+
+	template<typename T> static uint64_t get_total_image_bytes(const basisu::vector<T>& images)
+	{
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < images.size(); i++)
+			total += images[i].get_pixels().size_in_bytes();
+		return total;
+	}
+
+	static uint64_t get_total_texture_bytes(const basisu::vector<gpu_image>& textures)
+	{
+		uint64_t total = 0;
+		for (uint32_t i = 0; i < textures.size(); i++)
+			total += textures[i].get_size_in_bytes();
+		return total;
+	}
+
+	// Adds up the buffers the compressor currently holds, see get_peak_buffer_bytes().
+	void basis_compressor::update_peak_buffer_bytes()
+	{
+		uint64_t total = get_total_image_bytes(m_slice_images) + get_total_image_bytes(m_slice_images_hdr);
+
+		total += m_source_blocks.size_in_bytes() + m_source_blocks_hdr.size_in_bytes();
+
+		total += get_total_texture_bytes(m_uastc_slice_textures);
+		for (uint32_t i = 0; i < m_uastc_backend_output.m_slice_image_data.size(); i++)
+			total += m_uastc_backend_output.m_slice_image_data[i].size();
+
+		total += get_total_texture_bytes(m_frontend_output_textures) + get_total_texture_bytes(m_best_etc1s_images) + get_total_image_bytes(m_best_etc1s_images_unpacked);
+
+		total += get_total_texture_bytes(m_decoded_output_textures) + get_total_texture_bytes(m_decoded_output_textures_bc7) + get_total_texture_bytes(m_decoded_output_textures_astc_hdr);
+		total += get_total_image_bytes(m_decoded_output_textures_unpacked) + get_total_image_bytes(m_decoded_output_textures_unpacked_bc7);
+		total += get_total_image_bytes(m_decoded_output_textures_bc6h_hdr_unpacked) + get_total_image_bytes(m_decoded_output_textures_astc_hdr_unpacked);
+
+		total += m_basis_file.get_compressed_data().size() + m_output_basis_file.size() + m_output_ktx2_file.size();
+
+		m_peak_buffer_bytes = maximum(m_peak_buffer_bytes, total);
+	}
+
 	bool basis_compressor::process_backend()
 	{
 		debug_printf("basis_compressor::process_backend\n");
 
+		BASISU_TRACE_ZONE("backend");
+
 		basisu_backend_params backend_params;
 		backend_params.m_debug = m_params.m_debug;
 		backend_params.m_debug_images = m_params.m_debug_images;
@@ -3541,13 +5107,17 @@ namespace basisu
 
 		backend_params.m_used_global_codebooks = m_frontend.get_params().m_pGlobal_codebooks != nullptr;
 		backend_params.m_validate = m_params.m_validate_output_data;
+		backend_params.m_pProgress = &m_progress;
+		backend_params.m_multithreaded = m_params.m_multithreading;
+		backend_params.m_pJob_pool = m_params.m_pJob_pool;
 
 		m_backend.init(&m_frontend, backend_params, m_slice_descs);
 		uint32_t total_packed_bytes = m_backend.encode();
 
 		if (!total_packed_bytes)
 		{
-			error_printf("basis_compressor::encode() failed!\n");
+			if (!m_progress.is_stopped())
+				error_printf("basis_compressor::encode() failed!\n");
 			return false;
 		}
 
@@ -3560,6 +5130,8 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::create_basis_file_and_transcode\n");
 
+		BASISU_TRACE_ZONE("create_basis_file_and_transcode");
+
 		basist::key_value_vec key_values(m_params.m_key_values);
 
 		if (find_key_value(key_values, BASISU_LIB_VERSION_KEY_NAME) != nullptr)
@@ -3612,9 +5184,9 @@ namespace basisu
 			return false;
 		}
 
-		const uint8_vec& comp_data = m_basis_file.get_compressed_data();
+		m_basis_file.take_compressed_data(m_output_basis_file);
 
-		m_output_basis_file = comp_data;
+		const uint8_vec& comp_data = m_output_basis_file;
 
 		uint32_t total_orig_pixels = 0;
 		
@@ -3905,6 +5477,12 @@ namespace basisu
 				}
 			}
 
+			update_peak_buffer_bytes();
+
+			// Only the stats and debug images look at the decoded textures again.
+			if ((m_params.m_low_memory) && (!m_params.m_compute_stats) && (!m_params.m_debug) && (!m_params.m_debug_images))
+				free_decoded_textures();
+
 		} // if (m_params.m_validate_output_data)
 				
 		return true;
@@ -3980,7 +5558,9 @@ namespace basisu
 	{
 		debug_printf("basis_compressor::write_output_files_and_compute_stats\n");
 
-		const uint8_vec& comp_data = m_params.m_create_ktx2_file ? m_output_ktx2_file : m_basis_file.get_compressed_data();
+		BASISU_TRACE_ZONE("write_output_files_and_compute_stats");
+
+		const uint8_vec& comp_data = m_params.m_create_ktx2_file ? m_output_ktx2_file : m_output_basis_file;
 		if (m_params.m_write_output_basis_or_ktx2_files)
 		{
 			const std::string& output_filename = m_params.m_out_filename;
@@ -4024,6 +5604,16 @@ namespace basisu
 		}
 
 		m_stats.resize(m_slice_descs.size());
+
+		if (m_calibrated_effort_level >= 0)
+		{
+			for (uint32_t slice_index = 0; slice_index < m_slice_descs.size(); slice_index++)
+			{
+				m_stats[slice_index].m_effort_level = m_calibrated_effort_level;
+				m_stats[slice_index].m_min_effort_level = m_slice_min_effort_levels[slice_index];
+				m_stats[slice_index].m_max_effort_level = m_slice_max_effort_levels[slice_index];
+			}
+		}
 		
 		if (m_params.m_validate_output_data)
 		{
@@ -4040,6 +5630,8 @@ namespace basisu
 
 					if (m_params.m_compute_stats)
 					{
+						BASISU_TRACE_ZONE_ARG("stats", slice_index);
+
 						image_stats& s = m_stats[slice_index];
 
 						// The m_basis_* stats are computed against the transcoded ASTC HDR texture (same format printed below).
@@ -4198,6 +5790,8 @@ namespace basisu
 
 					if (m_params.m_compute_stats)
 					{
+						BASISU_TRACE_ZONE_ARG("stats", slice_index);
+
 						if (m_params.m_print_stats)
 							printf("Slice: %u\n", slice_index);
 
@@ -4206,48 +5800,51 @@ namespace basisu
 						// The m_basis_* stats are computed against the transcoded LDR texture (same format printed below).
 						s.m_tex_format = m_decoded_output_textures[slice_index].get_format();
 
+						// All the per channel and luma metrics of each image pair are gathered in a single (multithreaded) pass.
 						image_metrics em;
+						fused_image_metrics fm;
+						fm.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], m_params.m_pJob_pool);
 
 						if (m_params.m_print_stats)
 							fmt_printf("Quality stats vs. transcoded {} texture:\n", get_texture_format_name(m_decoded_output_textures[slice_index].get_format()));
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 0, 3);
+						fm.get(em, 0, 3);
 						if (m_params.m_print_stats)
 							em.print("RGB Avg:          ");
 						s.m_basis_rgb_avg_psnr = (float)em.m_psnr;
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 0, 4);
+						fm.get(em, 0, 4);
 						if (m_params.m_print_stats)
 							em.print("RGBA Avg:         ");
 						s.m_basis_rgba_avg_psnr = (float)em.m_psnr;
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 0, 1);
+						fm.get(em, 0, 1);
 						if (m_params.m_print_stats)
 							em.print("R   Avg:          ");
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 1, 1);
+						fm.get(em, 1, 1);
 						if (m_params.m_print_stats)
 							em.print("G   Avg:          ");
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 2, 1);
+						fm.get(em, 2, 1);
 						if (m_params.m_print_stats)
 							em.print("B   Avg:          ");
 
 						//if (m_params.m_uastc)
 						{
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 3, 1);
+							fm.get(em, 3, 1);
 							if (m_params.m_print_stats)
 								em.print("A   Avg:          ");
 
 							s.m_basis_a_avg_psnr = (float)em.m_psnr;
 						}
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 0, 0);
+						fm.get(em, 0, 0);
 						if (m_params.m_print_stats)
 							em.print("709 Luma:         ");
 						s.m_basis_luma_709_psnr = static_cast<float>(em.m_psnr);
 						s.m_basis_luma_709_ssim = static_cast<float>(em.m_ssim);
 
-						em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked[slice_index], 0, 0, true, true);
+						fm.get(em, 0, 0, true, true);
 						if (m_params.m_print_stats)
 							em.print("601 Luma:         ");
 						s.m_basis_luma_601_psnr = static_cast<float>(em.m_psnr);
@@ -4278,46 +5875,48 @@ namespace basisu
 						if (m_decoded_output_textures_unpacked_bc7[slice_index].get_width())
 						{
 							// ---- BC7 stats
+							fm.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], m_params.m_pJob_pool);
+
 							if (m_params.m_print_stats)
 								fmt_printf("Quality stats vs. transcoded {} texture:\n", get_texture_format_name(m_decoded_output_textures_bc7[slice_index].get_format()));
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 0, 3);
+							fm.get(em, 0, 3);
 							if (m_params.m_print_stats)
 								em.print("BC7 RGB Avg:             ");
 							s.m_bc7_rgb_avg_psnr = (float)em.m_psnr;
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 0, 4);
+							fm.get(em, 0, 4);
 							if (m_params.m_print_stats)
 								em.print("BC7 RGBA Avg:            ");
 							s.m_bc7_rgba_avg_psnr = (float)em.m_psnr;
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 0, 1);
+							fm.get(em, 0, 1);
 							if (m_params.m_print_stats)
 								em.print("BC7 R   Avg:             ");
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 1, 1);
+							fm.get(em, 1, 1);
 							if (m_params.m_print_stats)
 								em.print("BC7 G   Avg:             ");
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 2, 1);
+							fm.get(em, 2, 1);
 							if (m_params.m_print_stats)
 								em.print("BC7 B   Avg:             ");
 
 							//if (m_params.m_uastc)
 							{
-								em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 3, 1);
+								fm.get(em, 3, 1);
 								if (m_params.m_print_stats)
 									em.print("BC7 A   Avg:             ");
 
 								s.m_bc7_a_avg_psnr = (float)em.m_psnr;
 							}
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 0, 0);
+							fm.get(em, 0, 0);
 							if (m_params.m_print_stats)
 								em.print("BC7 709 Luma:            ");
 							s.m_bc7_luma_709_psnr = static_cast<float>(em.m_psnr);
 							s.m_bc7_luma_709_ssim = static_cast<float>(em.m_ssim);
 
-							em.calc(m_slice_images[slice_index], m_decoded_output_textures_unpacked_bc7[slice_index], 0, 0, true, true);
+							fm.get(em, 0, 0, true, true);
 							if (m_params.m_print_stats)
 								em.print("BC7 601 Luma:            ");
 							s.m_bc7_luma_601_psnr = static_cast<float>(em.m_psnr);
@@ -4339,18 +5938,20 @@ namespace basisu
 						if (!m_params.m_uastc)
 						{
 							// ---- Nearly best possible ETC1S stats
-							em.calc(m_slice_images[slice_index], m_best_etc1s_images_unpacked[slice_index], 0, 3);
+							fm.calc(m_slice_images[slice_index], m_best_etc1s_images_unpacked[slice_index], m_params.m_pJob_pool);
+
+							fm.get(em, 0, 3);
 							//if (m_params.m_print_stats)
 							//	em.print("Unquantized ETC1S RGB Avg:     ");
 							s.m_best_etc1s_rgb_avg_psnr = static_cast<float>(em.m_psnr);
 
-							em.calc(m_slice_images[slice_index], m_best_etc1s_images_unpacked[slice_index], 0, 0);
+							fm.get(em, 0, 0);
 							//if (m_params.m_print_stats)
 							//	em.print("Unquantized ETC1S 709 Luma:    ");
 							s.m_best_etc1s_luma_709_psnr = static_cast<float>(em.m_psnr);
 							s.m_best_etc1s_luma_709_ssim = static_cast<float>(em.m_ssim);
 
-							em.calc(m_slice_images[slice_index], m_best_etc1s_images_unpacked[slice_index], 0, 0, true, true);
+							fm.get(em, 0, 0, true, true);
 							//if (m_params.m_print_stats)
 							//	em.print("Unquantized ETC1S 601 Luma:    ");
 							s.m_best_etc1s_luma_601_psnr = static_cast<float>(em.m_psnr);
@@ -4804,24 +6405,231 @@ namespace basisu
 			{
 				dfd_chan0 |= (basist::KTX2_DF_CHANNEL_UASTC_RGBA << 24);
 			}
-			else
+			else
+			{
+				// basist::KTX2_DF_CHANNEL_UASTC_RGB==0
+				dfd_chan0 |= (basist::KTX2_DF_CHANNEL_UASTC_RGB << 24);
+			}
+		}
+
+		basisu::write_le_dword(dfd.data() + 7 * sizeof(uint32_t), dfd_chan0);
+
+		if ((is_xuastc_ldr) || (is_astc_ldr))
+		{
+			// Write XUASTC/ASTC LDR block dimensions
+			uint32_t texelBlockDimensions = basisu::read_le_dword(dfd.data() + 4 * sizeof(uint32_t));
+
+			texelBlockDimensions &= ~0xFFFF;
+			texelBlockDimensions |= ((m_fmt_mode_block_width - 1) | ((m_fmt_mode_block_height - 1) << 8));
+
+			basisu::write_le_dword(dfd.data() + 4 * sizeof(uint32_t), texelBlockDimensions);
+		}
+
+		return true;
+	}
+
+	// The KTX2 header's vkFormat for the current format mode.
+	bool basis_compressor::get_ktx2_vk_format(uint32_t& vk_format) const
+	{
+		const bool is_xuastc_ldr = basis_tex_format_is_xuastc_ldr(m_fmt_mode);
+		const bool is_astc_ldr = basis_tex_format_is_astc_ldr(m_fmt_mode);
+		const bool is_xubc7 = basis_tex_format_is_xubc7(m_fmt_mode);
+		BASISU_NOTE_UNUSED(is_xuastc_ldr);
+		BASISU_NOTE_UNUSED(is_xubc7);
+
+		vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
+
+		if (m_params.m_hdr)
+		{
+			if (m_params.m_hdr_mode == hdr_modes::cUASTC_HDR_4X4)
+				vk_format = basist::KTX2_FORMAT_ASTC_4x4_SFLOAT_BLOCK;
+			else if (m_params.m_hdr_mode == hdr_modes::cASTC_HDR_6X6)
+				vk_format = basist::KTX2_FORMAT_ASTC_6x6_SFLOAT_BLOCK;
+			else
+			{
+				assert(m_params.m_hdr_mode == hdr_modes::cUASTC_HDR_6X6_INTERMEDIATE);
+
+				vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
+			}
+		}
+		else
+		{
+			// Either ETC1S, UASTC LDR 4x4, or XUASTC/ASTC LDR 4x4-12x12.
+			assert((m_fmt_mode == basist::basis_tex_format::cETC1S) || (m_fmt_mode == basist::basis_tex_format::cUASTC_LDR_4x4) || is_xuastc_ldr || is_astc_ldr || is_xubc7);
+
+			if (is_astc_ldr)
+			{
+				// Get the correct Vulkan format (UNORM or sRGB).
+				uint32_t fmt = 0;
+				
+				assert((basist::KTX2_FORMAT_ASTC_4x4_UNORM_BLOCK + 1) == basist::KTX2_FORMAT_ASTC_4x4_SRGB_BLOCK);
+
+				switch (m_fmt_mode)
+				{
+				case basist::basis_tex_format::cASTC_LDR_4x4: fmt = basist::KTX2_FORMAT_ASTC_4x4_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_5x4: fmt = basist::KTX2_FORMAT_ASTC_5x4_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_5x5: fmt = basist::KTX2_FORMAT_ASTC_5x5_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_6x5: fmt = basist::KTX2_FORMAT_ASTC_6x5_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_6x6: fmt = basist::KTX2_FORMAT_ASTC_6x6_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_8x5: fmt = basist::KTX2_FORMAT_ASTC_8x5_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_8x6: fmt = basist::KTX2_FORMAT_ASTC_8x6_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_10x5: fmt = basist::KTX2_FORMAT_ASTC_10x5_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_10x6: fmt = basist::KTX2_FORMAT_ASTC_10x6_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_8x8: fmt = basist::KTX2_FORMAT_ASTC_8x8_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_10x8: fmt = basist::KTX2_FORMAT_ASTC_10x8_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_10x10: fmt = basist::KTX2_FORMAT_ASTC_10x10_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_12x10: fmt = basist::KTX2_FORMAT_ASTC_12x10_UNORM_BLOCK; break;
+				case basist::basis_tex_format::cASTC_LDR_12x12: fmt = basist::KTX2_FORMAT_ASTC_12x12_UNORM_BLOCK; break;
+				default:
+					assert(0);
+					return false;
+				}
+				assert(fmt);
+
+				vk_format = fmt + (m_params.m_ktx2_and_basis_srgb_transfer_function ? 1 : 0);
+			}
+			else
+			{
+				// A supercompressed format, i.e. not a standard format.
+				vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
+			}
+		}
+
+		return true;
+	}
+
+	// Builds the KTX2 key/value data block, padded (with a dummy key if needed) so the level data after it will be 16-byte aligned.
+	// dfd_len is the size of the DFD, which precedes the key/value data.
+	bool basis_compressor::get_ktx2_key_value_data(const basist::ktx2_header& header, uint32_t total_levels, uint32_t dfd_len, uint8_vec& key_value_data)
+	{
+		// Key values
+		basist::key_value_vec key_values(m_params.m_key_values);
+		
+		basist::add_key_value(key_values, "KTXwriter", fmt_string("Basis Universal {}", BASISU_LIB_VERSION_STRING));
+
+		if (m_params.m_hdr)
+		{
+			if (m_upconverted_any_ldr_images)
+			{
+				basist::add_key_value(key_values, "LDRUpconversionMultiplier", fmt_string("{}", m_ldr_to_hdr_upconversion_nit_multiplier));
+
+				if (m_params.m_ldr_hdr_upconversion_srgb_to_linear)
+					basist::add_key_value(key_values, "LDRUpconversionSRGBToLinear", "1");
+			}
+						
+			// Always write the scale to simplify testing.
+			//if (m_hdr_image_scale != 1.0f)
+			{
+				// add "KTXmapRange" key value
+				struct ktx_map_range 
+				{
+					packed_uint<4> m_scale;
+					packed_uint<4> m_offset;
+				};
+
+				ktx_map_range val;
+				val.m_scale = *reinterpret_cast<const uint32_t *>(&m_hdr_image_scale);
+				val.m_offset = 0;
+								
+				auto* pNew_key = key_values.enlarge(1);
+				
+				const char* pKey_name = "KTXmapRange";
+				size_t key_name_len = strlen(pKey_name) + 1;
+
+				pNew_key->m_key.resize(key_name_len);
+				memcpy(pNew_key->m_key.data(), pKey_name, key_name_len);
+
+				pNew_key->m_value.resize(sizeof(val));
+				memcpy(pNew_key->m_value.data(), &val, sizeof(val));
+			}
+		}
+
+		key_values.sort();
+
+#if BASISU_DISABLE_KTX2_KEY_VALUES
+		// HACK HACK - Clear the key values array, which causes no key values to be written (triggering the ktx2check validator bug).
+		key_values.clear();
+#endif
+
+		key_value_data.resize(0);
+
+		const uint32_t kvd_file_offset = sizeof(header) + sizeof(basist::ktx2_level_index) * total_levels + dfd_len;
+
+		for (uint32_t pass = 0; pass < 2; pass++)
+		{
+			for (uint32_t i = 0; i < key_values.size(); i++)
+			{
+				if (key_values[i].m_key.size() < 2)
+				{
+					return false;
+				}
+
+				if (key_values[i].m_key.back() != 0)
+				{
+					return false;
+				}
+
+				const uint64_t total_len = (uint64_t)key_values[i].m_key.size() + (uint64_t)key_values[i].m_value.size();
+				if (total_len >= UINT32_MAX)
+				{
+					return false;
+				}
+
+				packed_uint<4> le_len((uint32_t)total_len);
+				append_vector(key_value_data, (const uint8_t*)&le_len, sizeof(le_len));
+
+				append_vector(key_value_data, key_values[i].m_key);
+				append_vector(key_value_data, key_values[i].m_value);
+
+				const uint32_t ofs = key_value_data.size() & 3;
+				const uint32_t padding = (4 - ofs) & 3;
+				for (uint32_t p = 0; p < padding; p++)
+					key_value_data.push_back(0);
+			}
+
+			if (header.m_supercompression_scheme != basist::KTX2_SS_NONE)
+				break;
+
+#if BASISU_DISABLE_KTX2_ALIGNMENT_WORKAROUND
+			break;
+#endif
+			
+			// Hack to ensure the KVD block ends on a 16 byte boundary, because we have no other official way of aligning the data.
+			uint32_t kvd_end_file_offset = kvd_file_offset + (uint32_t)key_value_data.size();
+			uint32_t bytes_needed_to_pad = (16 - (kvd_end_file_offset & 15)) & 15;
+			if (!bytes_needed_to_pad)
+			{
+				// We're good. No need to add a dummy key.
+				break;
+			}
+
+			assert(!pass);
+			if (pass)
 			{
-				// basist::KTX2_DF_CHANNEL_UASTC_RGB==0
-				dfd_chan0 |= (basist::KTX2_DF_CHANNEL_UASTC_RGB << 24);
+				return false;
 			}
-		}
 
-		basisu::write_le_dword(dfd.data() + 7 * sizeof(uint32_t), dfd_chan0);
+			if (bytes_needed_to_pad < 6)
+				bytes_needed_to_pad += 16;
 
-		if ((is_xuastc_ldr) || (is_astc_ldr))
-		{
-			// Write XUASTC/ASTC LDR block dimensions
-			uint32_t texelBlockDimensions = basisu::read_le_dword(dfd.data() + 4 * sizeof(uint32_t));
+			// Just add the padding. It's likely not necessary anymore, but can't really hurt other than a tiny increase in file size.
+			//printf("WARNING: Due to a KTX2 validator bug related to mipPadding, we must insert a dummy key into the KTX2 file of %u bytes\n", bytes_needed_to_pad);
+			
+			// We're not good - need to add a dummy key large enough to force file alignment so the mip level array gets aligned. 
+			// We can't just add some bytes before the mip level array because ktx2check will see that as extra data in the file that shouldn't be there in ktxValidator::validateDataSize().
+			key_values.enlarge(1);
+			for (uint32_t i = 0; i < (bytes_needed_to_pad - 4 - 1 - 1); i++)
+				key_values.back().m_key.push_back(127);
+			
+			key_values.back().m_key.push_back(0);
 
-			texelBlockDimensions &= ~0xFFFF;
-			texelBlockDimensions |= ((m_fmt_mode_block_width - 1) | ((m_fmt_mode_block_height - 1) << 8));
+			key_values.back().m_value.push_back(0);
 
-			basisu::write_le_dword(dfd.data() + 4 * sizeof(uint32_t), texelBlockDimensions);
+			key_values.sort();
+
+			key_value_data.resize(0);
+			
+			// Try again
 		}
 
 		return true;
@@ -4829,11 +6637,12 @@ namespace basisu
 
 	bool basis_compressor::create_ktx2_file()
 	{
+		BASISU_TRACE_ZONE("create_ktx2_file");
+
 		//bool needs_global_data = false;
 		bool can_use_zstd = false;
 
 		bool is_xuastc_ldr = false;
-		bool is_astc_ldr = false;
 		bool is_hdr_6x6i = false;
 		bool is_xubc7 = false;
 
@@ -4900,7 +6709,6 @@ namespace basisu
 		case basist::basis_tex_format::cASTC_LDR_12x12:
 		{
 			// plain ASTC LDR 4x4-12x12 - can use Zstd
-			is_astc_ldr = true;
 			can_use_zstd = true;
 			break;
 		}
@@ -4962,61 +6770,11 @@ namespace basisu
 		header.m_pixel_height = base_height;
 		header.m_face_count = total_faces;
 
-		if (m_params.m_hdr)
-		{
-			if (m_params.m_hdr_mode == hdr_modes::cUASTC_HDR_4X4)
-				header.m_vk_format = basist::KTX2_FORMAT_ASTC_4x4_SFLOAT_BLOCK;
-			else if (m_params.m_hdr_mode == hdr_modes::cASTC_HDR_6X6)
-				header.m_vk_format = basist::KTX2_FORMAT_ASTC_6x6_SFLOAT_BLOCK;
-			else
-			{
-				assert(m_params.m_hdr_mode == hdr_modes::cUASTC_HDR_6X6_INTERMEDIATE);
-
-				header.m_vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
-			}
-		}
-		else
-		{
-			// Either ETC1S, UASTC LDR 4x4, or XUASTC/ASTC LDR 4x4-12x12.
-			assert((m_fmt_mode == basist::basis_tex_format::cETC1S) || (m_fmt_mode == basist::basis_tex_format::cUASTC_LDR_4x4) || is_xuastc_ldr || is_astc_ldr || is_xubc7);
-
-			if (is_astc_ldr)
-			{
-				// Get the correct Vulkan format (UNORM or sRGB).
-				uint32_t fmt = 0;
-				
-				assert((basist::KTX2_FORMAT_ASTC_4x4_UNORM_BLOCK + 1) == basist::KTX2_FORMAT_ASTC_4x4_SRGB_BLOCK);
-
-				switch (m_fmt_mode)
-				{
-				case basist::basis_tex_format::cASTC_LDR_4x4: fmt = basist::KTX2_FORMAT_ASTC_4x4_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_5x4: fmt = basist::KTX2_FORMAT_ASTC_5x4_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_5x5: fmt = basist::KTX2_FORMAT_ASTC_5x5_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_6x5: fmt = basist::KTX2_FORMAT_ASTC_6x5_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_6x6: fmt = basist::KTX2_FORMAT_ASTC_6x6_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_8x5: fmt = basist::KTX2_FORMAT_ASTC_8x5_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_8x6: fmt = basist::KTX2_FORMAT_ASTC_8x6_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_10x5: fmt = basist::KTX2_FORMAT_ASTC_10x5_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_10x6: fmt = basist::KTX2_FORMAT_ASTC_10x6_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_8x8: fmt = basist::KTX2_FORMAT_ASTC_8x8_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_10x8: fmt = basist::KTX2_FORMAT_ASTC_10x8_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_10x10: fmt = basist::KTX2_FORMAT_ASTC_10x10_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_12x10: fmt = basist::KTX2_FORMAT_ASTC_12x10_UNORM_BLOCK; break;
-				case basist::basis_tex_format::cASTC_LDR_12x12: fmt = basist::KTX2_FORMAT_ASTC_12x12_UNORM_BLOCK; break;
-				default:
-					assert(0);
-					return false;
-				}
-				assert(fmt);
+		uint32_t vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
+		if (!get_ktx2_vk_format(vk_format))
+			return false;
 
-				header.m_vk_format = fmt + (m_params.m_ktx2_and_basis_srgb_transfer_function ? 1 : 0);
-			}
-			else
-			{
-				// A supercompressed format, i.e. not a standard format.
-				header.m_vk_format = basist::KTX2_VK_FORMAT_UNDEFINED;
-			}
-		}
+		header.m_vk_format = vk_format;
 
 		header.m_type_size = 1;
 		header.m_level_count = total_levels;
@@ -5074,6 +6832,8 @@ namespace basisu
 #if BASISD_SUPPORT_KTX2_ZSTD
 			for (uint32_t level_index = 0; level_index < total_levels; level_index++)
 			{
+				BASISU_TRACE_ZONE_ARG("zstd", level_index);
+
 				compressed_level_data_bytes[level_index].resize(ZSTD_compressBound(level_data_bytes[level_index].size()));
 
 				size_t result = ZSTD_compress(compressed_level_data_bytes[level_index].data(), compressed_level_data_bytes[level_index].size(),
@@ -5087,6 +6847,8 @@ namespace basisu
 				}
 
 				compressed_level_data_bytes[level_index].resize(result);
+
+				BASISU_TRACE_COUNTER("zstd_level_bytes", result);
 			}
 #else
 			// Can't get here
@@ -5230,57 +6992,6 @@ namespace basisu
 			header.m_supercompression_scheme = is_hdr_6x6i ? basist::KTX2_SS_UASTC_HDR_6x6I : (is_xubc7 ? basist::KTX2_SS_XUBC7 : basist::KTX2_SS_XUASTC_LDR);
 		}
 		
-		// Key values
-		basist::key_value_vec key_values(m_params.m_key_values);
-		
-		basist::add_key_value(key_values, "KTXwriter", fmt_string("Basis Universal {}", BASISU_LIB_VERSION_STRING));
-
-		if (m_params.m_hdr)
-		{
-			if (m_upconverted_any_ldr_images)
-			{
-				basist::add_key_value(key_values, "LDRUpconversionMultiplier", fmt_string("{}", m_ldr_to_hdr_upconversion_nit_multiplier));
-
-				if (m_params.m_ldr_hdr_upconversion_srgb_to_linear)
-					basist::add_key_value(key_values, "LDRUpconversionSRGBToLinear", "1");
-			}
-						
-			// Always write the scale to simplify testing.
-			//if (m_hdr_image_scale != 1.0f)
-			{
-				// add "KTXmapRange" key value
-				struct ktx_map_range 
-				{
-					packed_uint<4> m_scale;
-					packed_uint<4> m_offset;
-				};
-
-				ktx_map_range val;
-				val.m_scale = *reinterpret_cast<const uint32_t *>(&m_hdr_image_scale);
-				val.m_offset = 0;
-								
-				auto* pNew_key = key_values.enlarge(1);
-				
-				const char* pKey_name = "KTXmapRange";
-				size_t key_name_len = strlen(pKey_name) + 1;
-
-				pNew_key->m_key.resize(key_name_len);
-				memcpy(pNew_key->m_key.data(), pKey_name, key_name_len);
-
-				pNew_key->m_value.resize(sizeof(val));
-				memcpy(pNew_key->m_value.data(), &val, sizeof(val));
-			}
-		}
-
-		key_values.sort();
-
-#if BASISU_DISABLE_KTX2_KEY_VALUES
-		// HACK HACK - Clear the key values array, which causes no key values to be written (triggering the ktx2check validator bug).
-		key_values.clear();
-#endif
-
-		uint8_vec key_value_data;
-
 		// DFD (Data Format Descriptor)
 		uint8_vec dfd;
 		if (!get_dfd(dfd, header))
@@ -5288,85 +6999,16 @@ namespace basisu
 			return false;
 		}
 
-		const uint32_t kvd_file_offset = sizeof(header) + sizeof(basist::ktx2_level_index) * total_levels + (uint32_t)dfd.size();
-
-		for (uint32_t pass = 0; pass < 2; pass++)
+		// Key values
+		uint8_vec key_value_data;
+		if (!get_ktx2_key_value_data(header, total_levels, (uint32_t)dfd.size(), key_value_data))
 		{
-			for (uint32_t i = 0; i < key_values.size(); i++)
-			{
-				if (key_values[i].m_key.size() < 2)
-				{
-					return false;
-				}
-
-				if (key_values[i].m_key.back() != 0)
-				{
-					return false;
-				}
-
-				const uint64_t total_len = (uint64_t)key_values[i].m_key.size() + (uint64_t)key_values[i].m_value.size();
-				if (total_len >= UINT32_MAX)
-				{
-					return false;
-				}
-
-				packed_uint<4> le_len((uint32_t)total_len);
-				append_vector(key_value_data, (const uint8_t*)&le_len, sizeof(le_len));
-
-				append_vector(key_value_data, key_values[i].m_key);
-				append_vector(key_value_data, key_values[i].m_value);
-
-				const uint32_t ofs = key_value_data.size() & 3;
-				const uint32_t padding = (4 - ofs) & 3;
-				for (uint32_t p = 0; p < padding; p++)
-					key_value_data.push_back(0);
-			}
-
-			if (header.m_supercompression_scheme != basist::KTX2_SS_NONE)
-				break;
-
-#if BASISU_DISABLE_KTX2_ALIGNMENT_WORKAROUND
-			break;
-#endif
-			
-			// Hack to ensure the KVD block ends on a 16 byte boundary, because we have no other official way of aligning the data.
-			uint32_t kvd_end_file_offset = kvd_file_offset + (uint32_t)key_value_data.size();
-			uint32_t bytes_needed_to_pad = (16 - (kvd_end_file_offset & 15)) & 15;
-			if (!bytes_needed_to_pad)
-			{
-				// We're good. No need to add a dummy key.
-				break;
-			}
-
-			assert(!pass);
-			if (pass)
-			{
-				return false;
-			}
-
-			if (bytes_needed_to_pad < 6)
-				bytes_needed_to_pad += 16;
-
-			// Just add the padding. It's likely not necessary anymore, but can't really hurt other than a tiny increase in file size.
-			//printf("WARNING: Due to a KTX2 validator bug related to mipPadding, we must insert a dummy key into the KTX2 file of %u bytes\n", bytes_needed_to_pad);
-			
-			// We're not good - need to add a dummy key large enough to force file alignment so the mip level array gets aligned. 
-			// We can't just add some bytes before the mip level array because ktx2check will see that as extra data in the file that shouldn't be there in ktxValidator::validateDataSize().
-			key_values.enlarge(1);
-			for (uint32_t i = 0; i < (bytes_needed_to_pad - 4 - 1 - 1); i++)
-				key_values.back().m_key.push_back(127);
-			
-			key_values.back().m_key.push_back(0);
-
-			key_values.back().m_value.push_back(0);
-
-			key_values.sort();
-
-			key_value_data.resize(0);
-			
-			// Try again
+			return false;
 		}
 
+		const uint32_t kvd_file_offset = sizeof(header) + sizeof(basist::ktx2_level_index) * total_levels + (uint32_t)dfd.size();
+		BASISU_NOTE_UNUSED(kvd_file_offset);
+
 		basisu::vector<basist::ktx2_level_index> level_index_array(total_levels);
 		memset((void *)level_index_array.data(), 0, level_index_array.size_in_bytes());
 				
@@ -5491,7 +7133,7 @@ namespace basisu
 
 		for (uint32_t pindex = 0; pindex < params_vec.size(); pindex++)
 		{
-			jpool.add_job([pindex, &params_vec, &results_vec, &result, &opencl_failed] {
+			jpool.add_job([pindex, &params_vec, &results_vec, &result, &opencl_failed, &jpool] {
 
 				basis_compressor_params params = params_vec[pindex];
 				parallel_results& results = results_vec[pindex];
@@ -5501,9 +7143,9 @@ namespace basisu
 
 				basis_compressor c;
 				
-				// Dummy job pool
-				job_pool task_jpool(1);
-				params.m_pJob_pool = &task_jpool;
+				// All the compressors share the batch's job pool. Each compressor's jobs are nested inside this job, so while a few large
+				// textures are still compressing, their block level jobs soak up the threads which would otherwise be idle.
+				params.m_pJob_pool = &jpool;
 				// TODO: Remove this flag entirely
 				params.m_multithreading = true; 
 				
@@ -5527,8 +7169,8 @@ namespace basisu
 
 					if (ec == basis_compressor::cECSuccess)
 					{
-						results.m_basis_file = c.get_output_basis_file();
-						results.m_ktx2_file = c.get_output_ktx2_file();
+						c.take_output_basis_file(results.m_basis_file);
+						c.take_output_ktx2_file(results.m_ktx2_file);
 						results.m_stats = c.get_stats();
 						results.m_basis_bits_per_texel = c.get_basis_bits_per_texel();
 						results.m_any_source_image_has_alpha = c.get_any_source_image_has_alpha();
@@ -5558,6 +7200,80 @@ namespace basisu
 		return result;
 	}
 
+	bool basis_train_etc1s_global_codebooks(const basis_compressor_params& params, uint8_vec& codebook_file_data)
+	{
+		codebook_file_data.clear();
+
+		assert(g_library_initialized);
+		if (!g_library_initialized)
+		{
+			error_printf("basis_train_etc1s_global_codebooks: basisu_encoder_init() MUST be called before using any encoder functionality!\n");
+			return false;
+		}
+
+		if (!params.is_etc1s())
+		{
+			error_printf("basis_train_etc1s_global_codebooks: params must be set up for ETC1S\n");
+			return false;
+		}
+
+		// Compress every training image into one .basis file, and keep its codebooks.
+		basis_compressor_params train_params(params);
+		train_params.m_tex_type = basist::cBASISTexType2D;
+		train_params.m_create_ktx2_file = false;
+		train_params.m_write_output_basis_or_ktx2_files = false;
+		train_params.m_compute_stats = false;
+		train_params.m_pGlobal_codebooks = nullptr;
+
+		basis_compressor c;
+		if (!c.init(train_params))
+		{
+			error_printf("basis_train_etc1s_global_codebooks: basis_compressor::init() failed\n");
+			return false;
+		}
+
+		const basis_compressor::error_code ec = c.process();
+		if (ec != basis_compressor::cECSuccess)
+		{
+			error_printf("basis_train_etc1s_global_codebooks: basis_compressor::process() failed with error %u\n", (uint32_t)ec);
+			return false;
+		}
+
+		const basisu_backend_output& output = c.get_etc1s_backend_output();
+
+		const uint32_t header_size = sizeof(basist::basis_global_codebooks_header);
+		const uint32_t file_size = header_size + output.m_endpoint_palette.size_u32() + output.m_selector_palette.size_u32();
+
+		codebook_file_data.resize(file_size);
+
+		basist::basis_global_codebooks_header* pHeader = reinterpret_cast<basist::basis_global_codebooks_header*>(codebook_file_data.data());
+		clear_obj(*pHeader);
+
+		pHeader->m_sig = basist::basis_global_codebooks_header::cSigValue;
+		pHeader->m_ver = basist::basis_global_codebooks_header::cFirstVersion;
+		pHeader->m_header_size = header_size;
+		pHeader->m_data_size = file_size - header_size;
+		pHeader->m_flags = output.m_srgb ? basist::cBASISHeaderFlagSRGB : 0;
+
+		pHeader->m_total_endpoints = output.m_num_endpoints;
+		pHeader->m_endpoint_cb_file_ofs = header_size;
+		pHeader->m_endpoint_cb_file_size = output.m_endpoint_palette.size_u32();
+
+		pHeader->m_total_selectors = output.m_num_selectors;
+		pHeader->m_selector_cb_file_ofs = header_size + output.m_endpoint_palette.size_u32();
+		pHeader->m_selector_cb_file_size = output.m_selector_palette.size_u32();
+
+		memcpy(codebook_file_data.data() + pHeader->m_endpoint_cb_file_ofs, output.m_endpoint_palette.data(), output.m_endpoint_palette.size());
+		memcpy(codebook_file_data.data() + pHeader->m_selector_cb_file_ofs, output.m_selector_palette.data(), output.m_selector_palette.size());
+
+		pHeader->m_data_crc16 = basist::crc16(codebook_file_data.data() + header_size, file_size - header_size, 0);
+		pHeader->m_header_crc16 = basist::crc16(&pHeader->m_data_size, header_size - BASISU_OFFSETOF(basist::basis_global_codebooks_header, m_data_size), 0);
+
+		debug_printf("basis_train_etc1s_global_codebooks: %u endpoints, %u selectors, %u bytes\n", output.m_num_endpoints, output.m_num_selectors, file_size);
+
+		return true;
+	}
+
 	void* basis_compress_internal(
 		basist::basis_tex_format mode,
 		const basisu::vector<image>* pSource_images,
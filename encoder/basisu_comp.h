@@ -113,6 +113,12 @@ namespace basisu
 			m_hvs_metrics.clear();
 			m_hvs_metrics_bc7.clear();
 
+			m_effort_level = -1;
+			m_min_effort_level = -1;
+			m_max_effort_level = -1;
+			m_encode_time_secs = 0.0f;
+			m_peak_rss_bytes = 0;
+
 			m_opencl_failed = false;
 		}
 
@@ -159,6 +165,19 @@ namespace basisu
 		float m_best_etc1s_luma_601_psnr;
 		float m_best_etc1s_luma_709_ssim;
 
+		// Time-budgeted encodes only (m_target_encode_time_secs > 0), otherwise -1: the effort level picked by calibration, in the
+		// format's native scale (see m_target_encode_time_secs), and the range of levels this slice's blocks were actually encoded at.
+		int m_effort_level;
+		int m_min_effort_level;
+		int m_max_effort_level;
+
+		// Wall clock time of the whole process() call (all slices).
+		float m_encode_time_secs;
+
+		// The process's peak resident set size in bytes at the end of process() (see get_peak_rss_bytes()), 0 if unavailable.
+		// This is process-wide, so it includes anything else the process did before or during the encode.
+		uint64_t m_peak_rss_bytes;
+
 		// true if OpenCL failed during compression
 		bool m_opencl_failed;
 	};
@@ -293,6 +312,11 @@ namespace basisu
 		bool m_changed;
 	};
 
+	// Strip encoding source callback (see basis_compressor_params::m_pStrip_source_callback). Fills rows [first_row, first_row + num_rows) of 
+	// the source image into *pLDR_rows (LDR formats) or *pHDR_rows (HDR formats, the other is nullptr), which are already m_strip_source_width 
+	// by num_rows texels. Rows are requested top to bottom, each once. Return false to fail the encode.
+	typedef bool (*strip_source_callback_func)(uint32_t first_row, uint32_t num_rows, image* pLDR_rows, imagef* pHDR_rows, void* pUser_data);
+
 	// Low-level direct compressor parameters. 
 	// Also see basis_compress() below for a simplified C-style interface.
 	struct basis_compressor_params
@@ -341,6 +365,16 @@ namespace basisu
 			m_xubc7_num_stripes(8, 1, 16),
 			m_xubc7_encoder((int)xbc7::bc7_encoder_type::cBC7F, (int)xbc7::bc7_encoder_type::cBC7F, (int)xbc7::bc7_encoder_type::cBC7E_Scalar),
 			m_xubc7_bc7e_scalar_level(xbc7::DEFAULT_BC7E_SCALAR_LEVEL, xbc7::BC7E_SCALAR_MIN_LEVEL, xbc7::BC7E_SCALAR_MAX_LEVEL),
+			m_pProgress_callback(nullptr),
+			m_pProgress_callback_data(nullptr),
+			m_encode_deadline_secs(0.0f, 0.0f, 1e+9f),
+			m_target_encode_time_secs(0.0f, 0.0f, 1e+9f),
+			m_strip_height(0, 0, basist::BASISU_MAX_SUPPORTED_TEXTURE_DIMENSION),
+			m_pStrip_source_callback(nullptr),
+			m_pStrip_source_callback_data(nullptr),
+			m_strip_source_width(0, 0, basist::BASISU_MAX_SUPPORTED_TEXTURE_DIMENSION),
+			m_strip_source_height(0, 0, basist::BASISU_MAX_SUPPORTED_TEXTURE_DIMENSION),
+			m_strip_source_alpha(-1, -1, 1),
 			m_pJob_pool(nullptr)
 		{
 			clear();
@@ -411,6 +445,7 @@ namespace basisu
 			m_userdata0 = 0;
 			m_userdata1 = 0;
 			m_us_per_frame = 0;
+			m_etc1s_video_iframe_interval = 0;
 
 			m_pack_uastc_ldr_4x4_flags = cPackUASTCLevelDefault;
 			m_rdo_uastc_ldr_4x4.clear();
@@ -427,6 +462,7 @@ namespace basisu
 			m_resample_factor.clear();
 
 			m_pGlobal_codebooks = nullptr;
+			m_fast_global_codebook_search.clear();
 
 			m_create_ktx2_file.clear();
 			m_ktx2_uastc_supercompression = basist::KTX2_SS_NONE;
@@ -482,6 +518,21 @@ namespace basisu
 			m_xubc7_num_stripes.clear();
 			m_xubc7_encoder.clear();
 			m_xubc7_bc7e_scalar_level.clear();
+
+			m_pProgress_callback = nullptr;
+			m_pProgress_callback_data = nullptr;
+			m_encode_deadline_secs.clear();
+			m_target_encode_time_secs.clear();
+			m_trace.clear();
+
+			m_strip_height.clear();
+			m_pStrip_source_callback = nullptr;
+			m_pStrip_source_callback_data = nullptr;
+			m_strip_source_width.clear();
+			m_strip_source_height.clear();
+			m_strip_source_alpha.clear();
+
+			m_low_memory.clear();
 									
 			m_pJob_pool = nullptr;
 		}
@@ -775,6 +826,12 @@ namespace basisu
 		uint32_t m_userdata1;
 		uint32_t m_us_per_frame;
 
+		// ETC1S video: emit an I-frame every m_etc1s_video_iframe_interval frames. 0 (the default) means only the first frame is an I-frame.
+		// Each I-frame starts an independent GOP, which the transcoder can seek to and decode in parallel, at the cost of a higher bitrate (I-frames can't 
+		// use conditional replenishment). On the encoder side only the backend's conditional replenishment pass is split per GOP. The frontend still 
+		// builds one codebook over all the frames (a file only holds one), so this doesn't noticeably speed up encoding.
+		uint32_t m_etc1s_video_iframe_interval;
+
 		// UASTC LDR 4x4 parameters
 		// cPackUASTCLevelDefault, etc.
 		uint32_t m_pack_uastc_ldr_4x4_flags;
@@ -794,8 +851,16 @@ namespace basisu
 		param<float> m_resample_factor;
 
 		// ETC1S global codebook control
+		// If not nullptr, ETC1S textures are quantized against these fixed codebooks (e.g. a codebook file trained by 
+		// basis_train_etc1s_global_codebooks() and loaded with basisu_lowlevel_etc1s_transcoder::decode_global_codebooks()) instead of 
+		// generating their own, which skips the most expensive frontend stage. .basis files then don't contain codebooks and can only be 
+		// transcoded with the same codebooks (basisu_transcoder::set_global_codebooks()). .KTX2 files always carry their codebooks.
 		const basist::basisu_lowlevel_etc1s_transcoder *m_pGlobal_codebooks;
 
+		// If true, each block is only matched against the global codebook endpoints whose base color is near its own, instead of all of them.
+		// Much faster with large trained codebooks, but approximate, so the output differs from the default exhaustive search.
+		bool_param<false> m_fast_global_codebook_search;
+
 		// .basis or .KTX2 key value fields.
 		basist::key_value_vec m_key_values;
 
@@ -932,6 +997,55 @@ namespace basisu
 		param<int> m_xubc7_num_stripes; // [1,16], desired # of encode stripes (decode parallelism vs size)
 		param<int> m_xubc7_encoder; // xbc7::bc7_encoder_type: 0=bc7f (default), 1=bc7e_scalar
 		param<int> m_xubc7_bc7e_scalar_level; // bc7e_scalar quality level, clamped to [BC7E_SCALAR_MIN_LEVEL, BC7E_SCALAR_MAX_LEVEL]
+
+		// Optional progress/cancellation callback, nullptr=none. Called periodically (never concurrently) from the encoding threads while
+		// process() runs, see encode_progress_callback_func. Returning false cancels the encode, and process() returns cECCancelled.
+		encode_progress_callback_func m_pProgress_callback;
+		void* m_pProgress_callback_data;
+
+		// Optional wall clock deadline for process() in seconds, 0=none. When exceeded, process() returns cECDeadlineExceeded.
+		param<float> m_encode_deadline_secs;
+
+		// Optional time budget for process() in seconds, 0=disabled. When set, the compressor ignores the format's effort level
+		// param and picks one itself: it times trial encodes of a small sample of blocks and uses the highest level predicted to
+		// fit. UASTC LDR/HDR 4x4 (per block batch) and ASTC HDR 6x6 (per slice) keep adjusting the level as the encode runs.
+		// Native levels used: m_etc1s_compression_level, the UASTC LDR 4x4 pack level in m_pack_uastc_ldr_4x4_flags,
+		// m_uastc_hdr_4x4_options.set_quality_level(), m_astc_hdr_6x6_options.set_user_level(), m_xuastc_ldr_effort_level and
+		// m_xubc7_effort_level. This is a target, not a limit (see m_encode_deadline_secs): the lowest level is used even if it won't fit.
+		param<float> m_target_encode_time_secs;
+
+		// Records per-stage trace zones and counters while process() runs (see trace_recorder), for export with 
+		// basis_compressor::write_trace(). Tracing is process-wide: other encodes running at the same time are recorded too.
+		bool_param<false> m_trace;
+
+		// Strip encoding, 0=disabled. Otherwise process() reads, encodes and writes the source image in horizontal strips of this many
+		// texel rows (rounded up to a multiple of the block height), appending each strip's blocks to the output .KTX2 file as it goes.
+		// Peak memory is then bounded by the strip size instead of the image size, except for the source image itself, which is still 
+		// loaded whole unless it's supplied by m_pStrip_source_callback.
+		// Only block-independent formats are supported: UASTC LDR 4x4, UASTC HDR 4x4, ASTC HDR 6x6 and ASTC LDR 4x4-12x12 (XUASTC LDR, XUBC7,
+		// ETC1S and UASTC HDR 6x6i entropy code across the whole slice). RDO and ASTC LDR deblocking only see one strip at a time.
+		// Requires a single 2D source image, no mipmaps or resampling, m_create_ktx2_file and m_write_output_basis_or_ktx2_files.
+		// The .KTX2 data goes straight to m_out_filename, so get_output_ktx2_file() is empty. HDR values too large for ASTC HDR are
+		// clamped instead of rescaling the image, and m_target_encode_time_secs and m_validate_output_data are ignored. With m_compute_stats,
+		// LDR PSNR statistics are accumulated strip by strip (HDR statistics aren't computed).
+		param<int> m_strip_height;
+
+		// Optional strip encoding source, nullptr=none: if set, source rows are read through this callback instead of from m_source_images,
+		// m_source_images_hdr or m_source_filenames, so the whole source image is never in memory. m_strip_source_width/height must be set.
+		// m_strip_source_alpha tells the encoder whether the LDR rows will have alpha (with m_check_for_alpha), because the ASTC LDR encoder 
+		// is configured before the first strip is read: 1=yes, 0=no (a strip with alpha then fails the encode), -1=unknown, which is detected 
+		// strip by strip and makes ASTC LDR encode as if there's alpha. Set it to get the same ASTC LDR output as passing the image in memory.
+		strip_source_callback_func m_pStrip_source_callback;
+		void* m_pStrip_source_callback_data;
+		param<int> m_strip_source_width;
+		param<int> m_strip_source_height;
+		param<int> m_strip_source_alpha;
+
+		// Low memory mode: process() frees each intermediate buffer (source blocks, encoded slice textures, the source slice images
+		// unless they're needed for stats, decoded validation textures) as soon as it's done with it, and encodes every slice through 
+		// one reused scratch texture instead of one texture per slice. The output is identical. In .KTX2 mode get_output_basis_file() 
+		// is empty afterwards, and get_slice_images()/get_slice_images_hdr() may be empty.
+		bool_param<false> m_low_memory;
 																		
 		// Job pool, MUST not be nullptr;
 		job_pool *m_pJob_pool;
@@ -945,6 +1059,53 @@ namespace basisu
 		basist::basis_tex_format m_format_mode;
 	};
 
+	// Time-budgeted effort (see m_target_encode_time_secs): steers the effort level used by the not yet started block
+	// batches (or slices) of an encode toward a deadline, by measuring how fast the already finished ones went.
+	class effort_controller
+	{
+		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(effort_controller);
+
+	public:
+		effort_controller();
+
+		void clear();
+
+		// level_secs[i] is the calibrated time of the whole encode at level min_level+i, 0 if unknown (used to decide if it's safe to
+		// go up a level). deadline is a get_interval_timer() time, total_units the total amount of work update() will be called with.
+		void init(int level, int min_level, int max_level, const basisu::vector<double>& level_secs, double deadline, uint64_t total_units);
+
+		bool is_enabled() const { return m_enabled; }
+
+		// Thread safe. Returns the level the next batch should be encoded at.
+		int acquire_level();
+
+		// Thread safe. Reports num_units of finished work, may change the level returned by acquire_level().
+		void update(uint64_t num_units);
+
+		// Range of the levels returned by acquire_level() since the last reset_used_range(). Not thread safe.
+		void reset_used_range() { m_used_levels.store(0); }
+		int get_min_used_level() const;
+		int get_max_used_level() const;
+
+	private:
+		bool m_enabled;
+
+		int m_min_level, m_max_level;
+		basisu::vector<double> m_level_secs;
+
+		double m_deadline;
+		uint64_t m_total_units;
+		uint64_t m_min_units_per_decision;
+
+		std::atomic<int> m_level;
+		std::atomic<uint64_t> m_units_done;
+		std::atomic<uint32_t> m_used_levels; // bitmask, bit 0=m_min_level
+
+		std::mutex m_mutex;
+		double m_level_start_time;
+		uint64_t m_level_start_units;
+	};
+
 	// Important: basisu_encoder_init() MUST be called first before using this class.
 	class basis_compressor
 	{
@@ -971,7 +1132,9 @@ namespace basisu
 			cECFailedWritingOutput,
 			cECFailedUASTCRDOPostProcess,
 			cECFailedCreateKTX2File,
-			cECFailedInvalidParameters
+			cECFailedInvalidParameters,
+			cECCancelled,				// the progress callback returned false
+			cECDeadlineExceeded			// m_encode_deadline_secs was exceeded
 		};
 
 		error_code process();
@@ -995,6 +1158,18 @@ namespace basisu
 		// The output .ktx2 file will only be valid if m_create_ktx2_file was true and process() succeeded.
 		const uint8_vec& get_output_ktx2_file() const { return m_output_ktx2_file; }
 
+		// ETC1S only: the backend's output (the compressed codebooks and slice data) after process() succeeded.
+		const basisu_backend_output& get_etc1s_backend_output() const { return m_backend.get_output(); }
+
+		// Moves the output .basis/.ktx2 file into dst without copying it, leaving the compressor's copy empty.
+		void take_output_basis_file(uint8_vec& dst) { dst.clear(); dst.swap(m_output_basis_file); }
+		void take_output_ktx2_file(uint8_vec& dst) { dst.clear(); dst.swap(m_output_ktx2_file); }
+
+		// Peak total size of the compressor's own image, block, encoded texture and output file buffers during process(). 
+		// Codec internal memory (the ETC1S frontend/backend, job pool, etc.) isn't counted, so this is a lower bound on the real peak.
+		// With m_strip_height it's the source image the compressor loaded (if any) plus the largest strip's buffers.
+		uint64_t get_peak_buffer_bytes() const { return m_peak_buffer_bytes; }
+
 		const basisu::vector<image_stats> &get_stats() const { return m_stats; }
 
 		// Sum of all slice orig pixels. Intended for statistics display.
@@ -1010,6 +1185,11 @@ namespace basisu
 
 		bool get_opencl_failed() const { return m_opencl_failed; }
 
+		// Trace export, valid after process() with m_trace set. The trace is process-wide (see trace_recorder), so it also holds 
+		// any other encodes that ran at the same time, and it's cleared when the next trace session starts.
+		void get_trace_json(std::string& json) const { trace_recorder::get_json(json); }
+		bool write_trace(const char* pFilename) const { return trace_recorder::write_json(pFilename); }
+
 		// Accessors for the prepared source image data. These are valid after a successful process_source_images()
 		// (or process()) call, and remain valid for the lifetime of this object. The slice images are expanded if
 		// necessary (duplicating cols/rows) to account for block dimensions.
@@ -1094,6 +1274,8 @@ namespace basisu
 		basisu::vector<gpu_image> m_uastc_slice_textures;
 		basisu_backend_output m_uastc_backend_output;
 
+		uint64_t m_peak_buffer_bytes;
+
 		// The amount the HDR input has to be scaled up in case it had to be rescaled to fit into half floats.
 		float m_hdr_image_scale; 
 		
@@ -1112,6 +1294,22 @@ namespace basisu
 		// Reset by init().
 		bool m_has_been_processed;
 
+		// Progress/cancellation/deadline state for the current process() call, shared with the codec encoders.
+		encode_progress m_progress;
+
+		// Time-budgeted effort (m_target_encode_time_secs) state. m_effort_level_secs[i] is the predicted time of the whole
+		// encode at level min+i from calibration (0=not measured), m_slice_min/max_effort_levels the levels each slice actually used.
+		double m_process_start_time;
+		int m_calibrated_effort_level;
+		basisu::vector<double> m_effort_level_secs;
+		int_vec m_slice_min_effort_levels, m_slice_max_effort_levels;
+		effort_controller m_effort_controller;
+
+		error_code process_impl();
+		bool calibrate_effort_level();
+		void init_effort_controller(float budget_fraction);
+		void record_slice_effort_levels(uint32_t slice_index);
+		void set_progress_range_for_slice(uint32_t slice_index);
 		void check_for_hdr_inputs();
 		bool sanity_check_input_params();
 		void clean_hdr_image(imagef& src_img);
@@ -1120,6 +1318,11 @@ namespace basisu
 		bool extract_source_blocks();
 		bool process_frontend();
 		bool extract_frontend_texture_data();
+		void init_uastc_slice_textures(texture_format fmt);
+		gpu_image& get_uastc_slice_texture(uint32_t slice_index);
+		void free_encode_buffers();
+		void free_decoded_textures();
+		void update_peak_buffer_bytes();
 		bool process_backend();
 		bool create_basis_file_and_transcode();
 		bool write_hdr_debug_images(const char* pBasename, const imagef& img, uint32_t width, uint32_t height);
@@ -1129,11 +1332,15 @@ namespace basisu
 		error_code encode_slices_to_xubc7();
 		error_code encode_slices_to_uastc_4x4_ldr();
 		error_code encode_slices_to_xuastc_or_astc_ldr();
+		bool get_astc_ldr_encode_config(astc_ldr::astc_ldr_encode_config& cfg);
+		error_code encode_strips_to_ktx2_file();
 		bool generate_mipmaps(const imagef& img, basisu::vector<imagef>& mips, bool has_alpha);
 		bool generate_mipmaps(const image &img, basisu::vector<image> &mips, bool has_alpha);
 		bool validate_texture_type_constraints();
 		bool validate_ktx2_constraints();
 		bool get_dfd(uint8_vec& dfd, const basist::ktx2_header& hdr);
+		bool get_ktx2_vk_format(uint32_t& vk_format) const;
+		bool get_ktx2_key_value_data(const basist::ktx2_header& header, uint32_t total_levels, uint32_t dfd_len, uint8_vec& key_value_data);
 		bool create_ktx2_file();
 		bool pick_format_mode();
 
@@ -1326,11 +1533,20 @@ namespace basisu
 		
 	// Compresses an array of input textures across total_threads threads using the basis_compressor class.
 	// Compressing multiple textures at a time is substantially more efficient than just compressing one at a time.
+	// All the compressors share one job pool, so the threads left idle once only a few textures remain help compress those textures.
 	// total_threads must be >= 1.
 	bool basis_parallel_compress(
 		uint32_t total_threads,
 		const basisu::vector<basis_compressor_params> &params_vec,
 		basisu::vector< parallel_results > &results_vec);
+
+	// ETC1S global codebooks
+	// Trains one shared ETC1S endpoint/selector codebook over all of params' source images (which can have any dimensions) and
+	// serializes it as a standalone codebook file (see basist::basis_global_codebooks_header). params must be set up for ETC1S, and 
+	// its quality level (or max endpoint/selector clusters) controls the codebook sizes. Its texture type and output file settings are 
+	// ignored. Decode the file once with basisu_lowlevel_etc1s_transcoder::decode_global_codebooks(), then encode any number of textures 
+	// against it with basis_compressor_params::m_pGlobal_codebooks.
+	bool basis_train_etc1s_global_codebooks(const basis_compressor_params& params, uint8_vec& codebook_file_data);
 		
 } // namespace basisu
 
@@ -199,12 +199,32 @@ namespace basisu
 			const uint32_t blocks_x = (orig_width + 3) / 4;
 			const uint32_t blocks_y = (orig_height + 3) / 4;
 
+			// bc7e_scalar packs a whole row of blocks per call, so its SIMD partition estimators can work on several
+			// blocks at once (identical results to packing them one at a time).
+			const bool bc7e_rows = (fmt == cDDSFmtBC7) && (bc7ctx.m_encoder == cDDSBC7Encoder_BC7E_Scalar);
+			basisu::vector<color_rgba> row_pixels;
+			basisu::vector<uint64_t> row_blocks;
+			if (bc7e_rows)
+			{
+				row_pixels.resize(blocks_x * 16);
+				row_blocks.resize(blocks_x * 2);
+			}
+
 			for (uint32_t by = 0; by < blocks_y; by++)
 			{
+				if (bc7e_rows)
+				{
+					for (uint32_t bx = 0; bx < blocks_x; bx++)
+						img.extract_block_clamped(&row_pixels[bx * 16], bx * 4, by * 4, 4, 4);
+
+					bc7e_scalar::bc7e_compress_blocks(blocks_x, row_blocks.data(), reinterpret_cast<const uint32_t*>(row_pixels.data()), &bc7ctx.m_bc7e_params, nullptr);
+				}
+
 				for (uint32_t bx = 0; bx < blocks_x; bx++)
 				{
 					color_rgba blk[16];
-					img.extract_block_clamped(blk, bx * 4, by * 4, 4, 4);
+					if (!bc7e_rows)
+						img.extract_block_clamped(blk, bx * 4, by * 4, 4, 4);
 
 					uint8_t dst[16];
 					switch (fmt)
@@ -238,11 +258,9 @@ namespace basisu
 						break;
 					case cDDSFmtBC7:
 						// basist::color_rgba and basisu::color_rgba have identical layout (r,g,b,a uint8_t).
-						if (bc7ctx.m_encoder == cDDSBC7Encoder_BC7E_Scalar)
+						if (bc7e_rows)
 						{
-							uint64_t blk64[2];
-							bc7e_scalar::bc7e_compress_blocks(1, blk64, reinterpret_cast<const uint32_t*>(blk), &bc7ctx.m_bc7e_params, nullptr);
-							memcpy(dst, blk64, 16);
+							memcpy(dst, &row_blocks[bx * 2], 16);
 						}
 						else
 						{
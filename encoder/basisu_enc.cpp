@@ -46,6 +46,22 @@
 // For QueryPerformanceCounter/QueryPerformanceFrequency
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+// For GetProcessMemoryInfo (in kernel32 with PSAPI_VERSION 2, the default since Windows 7)
+#include <psapi.h>
+#elif !defined(__EMSCRIPTEN__) && !defined(__wasi__)
+// For getrusage
+#include <sys/resource.h>
+#endif
+
+#if defined(_WIN32) || defined(__EMSCRIPTEN__) || defined(__wasi__)
+	#define BASISU_USE_MMAP 0
+#else
+	// For memory_mapped_file
+	#define BASISU_USE_MMAP 1
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
 #endif
 
 namespace basisu
@@ -54,6 +70,7 @@ namespace basisu
 	double interval_timer::g_timer_freq;
 
 	bool g_cpu_supports_sse41 = false;
+	bool g_cpu_supports_avx2 = false;
 
 	fast_linear_to_srgb g_fast_linear_to_srgb;
 		
@@ -200,7 +217,8 @@ namespace basisu
 
 		detect_sse41();
 				
-		basist::basisu_transcoder_init();
+		// The encoder calls the transcoder's low-level block conversion functions directly, so build all of its lookup tables now.
+		basist::basisu_transcoder_init(nullptr, 0);
 		pack_etc1_solid_color_init();
 		//uastc_init();
 		bc7enc_compress_block_init(); // must be after uastc_init()
@@ -390,6 +408,175 @@ namespace basisu
 		return ticks * g_timer_freq;
 	}
 
+	std::atomic<uint32_t> trace_recorder::g_num_sessions(0);
+
+	struct trace_event
+	{
+		const char* m_pName;
+		timer_ticks m_start_ticks, m_end_ticks;	// m_end_ticks is unused by counters
+		int64_t m_arg;
+		double m_value;
+		uint32_t m_thread_index;
+		bool m_is_counter;
+	};
+
+	static std::mutex g_trace_mutex;
+	static basisu::vector<trace_event> g_trace_events;
+	static std::atomic<uint32_t> g_trace_next_thread_index(0);
+
+	void trace_recorder::begin_session()
+	{
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+		
+		if (!g_num_sessions.load())
+			g_trace_events.clear();
+
+		g_num_sessions.fetch_add(1);
+	}
+
+	void trace_recorder::end_session()
+	{
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+
+		assert(g_num_sessions.load());
+		if (g_num_sessions.load())
+			g_num_sessions.fetch_sub(1);
+	}
+
+	uint32_t trace_recorder::get_thread_index()
+	{
+		static thread_local uint32_t s_thread_index = UINT32_MAX;
+		if (s_thread_index == UINT32_MAX)
+			s_thread_index = g_trace_next_thread_index.fetch_add(1);
+		return s_thread_index;
+	}
+
+	void trace_recorder::add_zone(const char* pName, timer_ticks start_ticks, timer_ticks end_ticks, int64_t arg)
+	{
+		const trace_event e = { pName, start_ticks, end_ticks, arg, 0.0f, get_thread_index(), false };
+
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+		g_trace_events.push_back(e);
+	}
+
+	void trace_recorder::add_counter(const char* pName, double value)
+	{
+		const timer_ticks t = interval_timer::get_ticks();
+		const trace_event e = { pName, t, t, -1, value, get_thread_index(), true };
+
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+		g_trace_events.push_back(e);
+	}
+
+	size_t trace_recorder::get_total_events()
+	{
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+		return g_trace_events.size();
+	}
+
+	void trace_recorder::clear()
+	{
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+		g_trace_events.clear();
+	}
+
+	static void append_trace_json_string(std::string& json, const char* pStr)
+	{
+		json.push_back('"');
+		for ( ; *pStr; ++pStr)
+		{
+			const char c = *pStr;
+			if ((c == '"') || (c == '\\'))
+				json.push_back('\\');
+
+			if ((uint8_t)c < 32)
+				json.push_back(' ');
+			else
+				json.push_back(c);
+		}
+		json.push_back('"');
+	}
+
+	// Chrome trace event format: complete ("X") events for zones, "C" events for counters, timestamps in microseconds.
+	void trace_recorder::get_json(std::string& json)
+	{
+		json.clear();
+
+		std::lock_guard<std::mutex> lock(g_trace_mutex);
+
+		json.reserve(g_trace_events.size() * 128 + 256);
+		json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		uint32_t max_thread_index = 0;
+		for (size_t i = 0; i < g_trace_events.size(); i++)
+			max_thread_index = maximum(max_thread_index, g_trace_events[i].m_thread_index + 1);
+
+		char buf[256];
+
+		// Name the thread tracks and keep them in thread index order (thread 0 is usually the one that started the encode).
+		for (uint32_t i = 0; i < max_thread_index; i++)
+		{
+			snprintf(buf, sizeof(buf), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"basisu thread %u\"}},\n"
+				"{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}",
+				i, i, i, i);
+			if (i)
+				json += ",\n";
+			json += buf;
+		}
+
+		for (size_t i = 0; i < g_trace_events.size(); i++)
+		{
+			const trace_event& e = g_trace_events[i];
+
+			if (i || max_thread_index)
+				json += ",\n";
+
+			json += "{\"name\":";
+			append_trace_json_string(json, e.m_pName);
+
+			const double ts = interval_timer::ticks_to_secs(e.m_start_ticks) * 1000000.0f;
+
+			if (e.m_is_counter)
+			{
+				snprintf(buf, sizeof(buf), ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%.17g}}",
+					ts, e.m_thread_index, e.m_value);
+			}
+			else
+			{
+				const double dur = interval_timer::ticks_to_secs(e.m_end_ticks - e.m_start_ticks) * 1000000.0f;
+
+				if (e.m_arg >= 0)
+				{
+					snprintf(buf, sizeof(buf), ",\"cat\":\"basisu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"index\":%lli}}",
+						ts, dur, e.m_thread_index, (long long)e.m_arg);
+				}
+				else
+				{
+					snprintf(buf, sizeof(buf), ",\"cat\":\"basisu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+						ts, dur, e.m_thread_index);
+				}
+			}
+
+			json += buf;
+		}
+
+		json += "\n]}\n";
+	}
+
+	bool trace_recorder::write_json(const char* pFilename)
+	{
+		std::string json;
+		get_json(json);
+
+		if (!write_data_to_file(pFilename, json.data(), json.size()))
+		{
+			error_printf("trace_recorder::write_json: Failed writing trace file \"%s\"\n", pFilename);
+			return false;
+		}
+
+		return true;
+	}
+
 	// Note this is linear<->sRGB, NOT REC709 which uses slightly different equations/transfer functions. 
 	// However the gamuts/white points of REC709 and sRGB are the same.
 	float linear_to_srgb(float l)
@@ -1018,6 +1205,202 @@ namespace basisu
 
 		return fclose(pFile) != EOF;
 	}
+
+	bool write_data_to_file_atomic(const char* pFilename, const void* pData, size_t len)
+	{
+		// Write to a temp file next to the destination (so it's on the same volume), then rename it over the destination.
+#if defined(_WIN32)
+		std::string temp_filename(string_format("%s.%u.tmp", pFilename, (uint32_t)GetCurrentProcessId()));
+#elif BASISU_USE_MMAP
+		std::string temp_filename(string_format("%s.%u.tmp", pFilename, (uint32_t)getpid()));
+#else
+		std::string temp_filename(std::string(pFilename) + ".tmp");
+#endif
+
+		FILE* pFile = nullptr;
+#ifdef _WIN32
+		fopen_s(&pFile, temp_filename.c_str(), "wb");
+#else
+		pFile = fopen(temp_filename.c_str(), "wb");
+#endif
+		if (!pFile)
+			return false;
+
+		bool success = true;
+		if (len)
+			success = (fwrite(pData, 1, len, pFile) == len);
+
+		if (success)
+			success = (fflush(pFile) == 0);
+
+#if BASISU_USE_MMAP
+		// Make sure the data is on disk before the rename is, otherwise a crash could leave a truncated file behind under the final name.
+		if (success)
+			success = (fsync(fileno(pFile)) == 0);
+#endif
+
+		if (fclose(pFile) == EOF)
+			success = false;
+
+		if (success)
+		{
+#if defined(_WIN32)
+			success = MoveFileExA(temp_filename.c_str(), pFilename, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+			success = (rename(temp_filename.c_str(), pFilename) == 0);
+#endif
+		}
+
+		if (!success)
+			remove(temp_filename.c_str());
+
+		return success;
+	}
+
+	memory_mapped_file::memory_mapped_file() :
+		m_pData(nullptr),
+		m_size(0),
+#if defined(_WIN32)
+		m_hFile(INVALID_HANDLE_VALUE),
+		m_hMapping(nullptr),
+#endif
+		m_mapped(false)
+	{
+	}
+
+	memory_mapped_file::~memory_mapped_file()
+	{
+		close();
+	}
+
+	bool memory_mapped_file::open(const char* pFilename)
+	{
+		close();
+
+#if defined(_WIN32)
+		HANDLE hFile = CreateFileA(pFilename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (hFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER file_size;
+		if ((!GetFileSizeEx(hFile, &file_size)) || (file_size.QuadPart <= 0) || ((uint64_t)file_size.QuadPart > SIZE_MAX))
+		{
+			CloseHandle(hFile);
+			return false;
+		}
+
+		HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!hMapping)
+		{
+			CloseHandle(hFile);
+			return false;
+		}
+
+		const void* pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		if (!pView)
+		{
+			CloseHandle(hMapping);
+			CloseHandle(hFile);
+			return false;
+		}
+
+		m_hFile = hFile;
+		m_hMapping = hMapping;
+		m_pData = static_cast<const uint8_t*>(pView);
+		m_size = (size_t)file_size.QuadPart;
+		m_mapped = true;
+#elif BASISU_USE_MMAP
+		const int fd = ::open(pFilename, O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if ((fstat(fd, &st) != 0) || (st.st_size <= 0) || ((uint64_t)st.st_size > SIZE_MAX))
+		{
+			::close(fd);
+			return false;
+		}
+
+		void* pMap = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		
+		// The mapping holds its own reference to the file.
+		::close(fd);
+
+		if (pMap == MAP_FAILED)
+			return false;
+
+		m_pData = static_cast<const uint8_t*>(pMap);
+		m_size = (size_t)st.st_size;
+		m_mapped = true;
+#else
+		if ((!read_file_to_vec(pFilename, m_fallback_buf)) || (!m_fallback_buf.size()))
+		{
+			m_fallback_buf.clear();
+			return false;
+		}
+
+		m_pData = m_fallback_buf.data();
+		m_size = m_fallback_buf.size();
+#endif
+
+		return true;
+	}
+
+	void memory_mapped_file::close()
+	{
+		if (m_mapped)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(m_pData);
+			CloseHandle(m_hMapping);
+			CloseHandle(m_hFile);
+			m_hMapping = nullptr;
+			m_hFile = INVALID_HANDLE_VALUE;
+#elif BASISU_USE_MMAP
+			munmap(const_cast<uint8_t*>(m_pData), m_size);
+#endif
+		}
+
+		m_fallback_buf.clear();
+		m_pData = nullptr;
+		m_size = 0;
+		m_mapped = false;
+	}
+
+	void memory_mapped_file::advise(access_hint hint)
+	{
+		advise(0, m_size, hint);
+	}
+
+	void memory_mapped_file::advise(uint64_t ofs, uint64_t size, access_hint hint)
+	{
+#if BASISU_USE_MMAP
+		if ((!m_mapped) || (ofs >= m_size) || (!size))
+			return;
+
+		size = minimum<uint64_t>(size, m_size - ofs);
+
+		// madvise() requires a page aligned start address.
+		const uint64_t page_size = (uint64_t)sysconf(_SC_PAGESIZE);
+		const uint64_t aligned_ofs = ofs & ~(page_size - 1);
+		
+		int advice = MADV_NORMAL;
+		switch (hint)
+		{
+		case cHintSequential: advice = MADV_SEQUENTIAL; break;
+		case cHintRandom: advice = MADV_RANDOM; break;
+		case cHintWillNeed: advice = MADV_WILLNEED; break;
+		case cHintDontNeed: advice = MADV_DONTNEED; break;
+		default: break;
+		}
+
+		madvise(const_cast<uint8_t*>(m_pData) + aligned_ofs, (size_t)(size + (ofs - aligned_ofs)), advice);
+#else
+		BASISU_NOTE_UNUSED(ofs);
+		BASISU_NOTE_UNUSED(size);
+		BASISU_NOTE_UNUSED(hint);
+#endif
+	}
 		
 	bool image_resample(const image &src, image &dst, bool srgb,
 		const char *pFilter, float filter_scale, 
@@ -2159,10 +2542,7 @@ namespace basisu
 		const uint32_t width = basisu::minimum(a.get_width(), b.get_width());
 		const uint32_t height = basisu::minimum(a.get_height(), b.get_height());
 
-		m_width = width;
-		m_height = height;
-
-		double hist[256];
+		uint64_t hist[256];
 		clear_obj(hist);
 
 		m_has_neg = false;
@@ -2202,14 +2582,22 @@ namespace basisu
 			}
 		}
 
+		calc_from_histogram(hist, width, height, total_chans, avg_comp_error);
+	}
+
+	void image_metrics::calc_from_histogram(const uint64_t* pHist, uint32_t width, uint32_t height, uint32_t total_chans, bool avg_comp_error)
+	{
+		m_width = width;
+		m_height = height;
+
 		m_max = 0;
 		double sum = 0.0f, sum2 = 0.0f;
 		for (uint32_t i = 0; i < 256; i++)
 		{
-			if (hist[i])
+			if (pHist[i])
 			{
 				m_max = basisu::maximum<double>(m_max, (double)i);
-				double v = i * hist[i];
+				double v = i * (double)pHist[i];
 				sum += v;
 				sum2 += i * v;
 			}
@@ -2225,6 +2613,164 @@ namespace basisu
 		m_psnr = m_rms ? (float)clamp<double>(log10(255.0 / m_rms) * 20.0f, 0.0f, 100.0f) : 100.0f;
 	}
 
+	void fused_image_metrics::clear()
+	{
+		m_width = 0;
+		m_height = 0;
+		clear_obj(m_hist);
+		clear_obj(m_sum_a);
+		clear_obj(m_sum_b);
+	}
+
+	// Histograms and sums of one row band.
+	struct fused_image_metrics_band
+	{
+		uint32_t m_hist[6][256];
+		uint64_t m_sum_a[4], m_sum_b[4];
+	};
+
+	static void calc_fused_image_metrics_band(const image& a, const image& b, uint32_t width, uint32_t y_start, uint32_t y_end, fused_image_metrics_band& band)
+	{
+		clear_obj(band);
+
+		for (uint32_t y = y_start; y < y_end; y++)
+		{
+			const color_rgba* pA = &a(0, y);
+			const color_rgba* pB = &b(0, y);
+
+			for (uint32_t x = 0; x < width; x++)
+			{
+				const color_rgba& ca = pA[x], & cb = pB[x];
+
+				for (uint32_t c = 0; c < 4; c++)
+				{
+					band.m_hist[c][iabs(ca[c] - cb[c])]++;
+					band.m_sum_a[c] += ca[c];
+					band.m_sum_b[c] += cb[c];
+				}
+
+				band.m_hist[4][iabs(ca.get_709_luma() - cb.get_709_luma())]++;
+				band.m_hist[5][iabs(ca.get_601_luma() - cb.get_601_luma())]++;
+			}
+		}
+	}
+
+	void fused_image_metrics::calc(const image& a, const image& b, job_pool* pJob_pool)
+	{
+		static_assert(cTotalHists == 6, "fused_image_metrics_band must match");
+
+		clear();
+
+		m_width = basisu::minimum(a.get_width(), b.get_width());
+		m_height = basisu::minimum(a.get_height(), b.get_height());
+
+		if ((!m_width) || (!m_height))
+			return;
+
+		// Bands of at least 32 rows (and at most 2^32/width rows, so the per band 32-bit histograms can't overflow).
+		const uint32_t max_band_rows = basisu::maximum<uint32_t>(1U, UINT32_MAX / m_width);
+		uint32_t num_bands = 1;
+		if (pJob_pool && (pJob_pool->get_total_threads() > 1))
+			num_bands = basisu::minimum<uint32_t>((uint32_t)pJob_pool->get_total_threads() * 2, (m_height + 31) / 32);
+		num_bands = basisu::maximum<uint32_t>(num_bands, (m_height + max_band_rows - 1) / max_band_rows);
+		num_bands = basisu::clamp<uint32_t>(num_bands, 1, m_height);
+
+		basisu::vector<fused_image_metrics_band> bands(num_bands);
+
+		const uint32_t rows_per_band = (m_height + num_bands - 1) / num_bands;
+		const uint32_t width = m_width, height = m_height;
+
+		if (num_bands == 1)
+			calc_fused_image_metrics_band(a, b, width, 0, height, bands[0]);
+		else
+		{
+			for (uint32_t band_index = 0; band_index < num_bands; band_index++)
+			{
+				pJob_pool->add_job([&a, &b, &bands, band_index, rows_per_band, width, height] {
+					const uint32_t y_start = basisu::minimum(band_index * rows_per_band, height);
+					const uint32_t y_end = basisu::minimum(y_start + rows_per_band, height);
+					calc_fused_image_metrics_band(a, b, width, y_start, y_end, bands[band_index]);
+					});
+			}
+
+			pJob_pool->wait_for_all();
+		}
+
+		for (uint32_t band_index = 0; band_index < num_bands; band_index++)
+		{
+			const fused_image_metrics_band& band = bands[band_index];
+
+			for (uint32_t h = 0; h < cTotalHists; h++)
+				for (uint32_t i = 0; i < 256; i++)
+					m_hist[h][i] += band.m_hist[h][i];
+
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				m_sum_a[c] += band.m_sum_a[c];
+				m_sum_b[c] += band.m_sum_b[c];
+			}
+		}
+	}
+
+	void fused_image_metrics::add(const fused_image_metrics& other)
+	{
+		if (!other.m_height)
+			return;
+
+		assert((!m_height) || (m_width == other.m_width));
+
+		m_width = other.m_width;
+		m_height += other.m_height;
+
+		for (uint32_t h = 0; h < cTotalHists; h++)
+			for (uint32_t i = 0; i < 256; i++)
+				m_hist[h][i] += other.m_hist[h][i];
+
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			m_sum_a[c] += other.m_sum_a[c];
+			m_sum_b[c] += other.m_sum_b[c];
+		}
+	}
+
+	void fused_image_metrics::get(image_metrics& m, uint32_t first_chan, uint32_t total_chans, bool avg_comp_error, bool use_601_luma) const
+	{
+		assert((first_chan < 4U) && (first_chan + total_chans <= 4U));
+
+		m.m_has_neg = false;
+		m.m_any_abnormal = false;
+		m.m_hf_mag_overflow = false;
+		m.m_sum_a = 0;
+		m.m_sum_b = 0;
+
+		uint64_t hist[256];
+		clear_obj(hist);
+
+		if (total_chans)
+		{
+			for (uint32_t c = first_chan; c < first_chan + total_chans; c++)
+			{
+				for (uint32_t i = 0; i < 256; i++)
+					hist[i] += m_hist[c][i];
+
+				m.m_sum_a += m_sum_a[c];
+				m.m_sum_b += m_sum_b[c];
+			}
+		}
+		else
+		{
+			memcpy(hist, m_hist[use_601_luma ? cHist601 : cHist709], sizeof(hist));
+
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				m.m_sum_a += m_sum_a[c];
+				m.m_sum_b += m_sum_b[c];
+			}
+		}
+
+		m.calc_from_histogram(hist, m_width, m_height, total_chans, avg_comp_error);
+	}
+
 	void print_image_metrics(const image& a, const image& b)
 	{
 		image_metrics im;
@@ -2720,16 +3266,43 @@ namespace basisu
 		return out;
 	}
 
+	// Per-thread job pool state. A thread can be a worker of at most one pool, but it can run (or wait on) jobs of any number of pools.
+	struct job_pool_thread_context
+	{
+		const job_pool* m_pWorker_pool;		// pool this thread is a worker of, or nullptr
+		uint32_t m_worker_index;
+
+		const job_pool* m_pJob_pool;		// pool of the job this thread is currently running, or nullptr
+		job_pool::task_group* m_pJob_group;	// the running job's implicit task group
+		uint32_t m_job_depth;
+	};
+
+	static thread_local job_pool_thread_context g_job_pool_thread_context = { nullptr, 0, nullptr, nullptr, 0 };
+
+#ifdef __EMSCRIPTEN__
+	// Avoid infinite blocking
+	static const std::chrono::milliseconds g_job_pool_max_wait(50);
+#else
+	// For more safety vs. buggy RTL's. Worse case we stall for a second vs. locking up forever if something goes wrong.
+	static const std::chrono::milliseconds g_job_pool_max_wait(1000);
+#endif
+
 	job_pool::job_pool(uint32_t num_threads) : 
-		m_num_active_jobs(0)
+		m_num_queues(0)
 	{
 		m_kill_flag.store(false);
 		m_num_active_workers.store(0);
+		m_num_queued.store(0);
+		m_num_adds.store(0);
+		m_num_waiters.store(0);
 
 		assert(num_threads >= 1U);
 
 		debug_printf("job_pool::job_pool: %u total threads\n", num_threads);
 
+		m_num_queues = num_threads;
+		m_queues.reset(new job_queue[m_num_queues]);
+
 		if (num_threads > 1)
 		{
 			m_threads.resize(num_threads - 1);
@@ -2750,6 +3323,7 @@ namespace basisu
 		}
 		
 		m_has_work.notify_all();
+		m_job_done.notify_all();
 
 #ifdef __EMSCRIPTEN__
 		// Without this wait the join()'s aren't reliable, and I have no idea why. WASM threading in the browser is sometimes mysterious.
@@ -2779,123 +3353,331 @@ namespace basisu
 
 		debug_printf("job_pool::~job_pool: joined OK\n");
 	}
-				
-	void job_pool::add_job(const std::function<void()>& job)
+
+	uint32_t job_pool::get_queue_index() const
 	{
-		std::unique_lock<std::mutex> lock(m_mutex);
+		const job_pool_thread_context& ctx = g_job_pool_thread_context;
+		return (ctx.m_pWorker_pool == this) ? ctx.m_worker_index : (m_num_queues - 1);
+	}
 
-		m_queue.emplace_back(job);
+	job_pool::task_group& job_pool::get_current_group()
+	{
+		const job_pool_thread_context& ctx = g_job_pool_thread_context;
+		return ((ctx.m_pJob_pool == this) && (ctx.m_pJob_group)) ? *ctx.m_pJob_group : m_root_group;
+	}
 
-		const size_t queue_size = m_queue.size();
+	void job_pool::push_job(task_group& group, std::function<void()>&& job)
+	{
+		const job_pool_thread_context& ctx = g_job_pool_thread_context;
+
+		job_entry entry;
+		entry.m_func = std::move(job);
+		entry.m_pGroup = &group;
+		entry.m_depth = (ctx.m_pJob_pool == this) ? (ctx.m_job_depth + 1) : 1;
+
+		group.m_num_pending.fetch_add(1);
+
+		job_queue& q = m_queues[get_queue_index()];
+		{
+			std::lock_guard<std::mutex> lock(q.m_mutex);
+			q.m_jobs.push_back(std::move(entry));
+		}
 
-		lock.unlock();
+		m_num_queued.fetch_add(1);
+		m_num_adds.fetch_add(1);
 
-		if (queue_size > 1)
-			m_has_work.notify_one();
+		// Taking the lock guarantees a thread which has just decided to sleep is actually waiting before we notify it.
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_has_work.notify_one();
+
+		if (m_num_waiters.load())
+			m_job_done.notify_all();
+	}
+				
+	void job_pool::add_job(const std::function<void()>& job)
+	{
+		push_job(get_current_group(), std::function<void()>(job));
 	}
 
 	void job_pool::add_job(std::function<void()>&& job)
 	{
-		std::unique_lock<std::mutex> lock(m_mutex);
+		push_job(get_current_group(), std::move(job));
+	}
 
-		m_queue.emplace_back(std::move(job));
-						
-		const size_t queue_size = m_queue.size();
+	void job_pool::add_job(task_group& group, const std::function<void()>& job)
+	{
+		push_job(group, std::function<void()>(job));
+	}
 
-		lock.unlock();
+	void job_pool::add_job(task_group& group, std::function<void()>&& job)
+	{
+		push_job(group, std::move(job));
+	}
 
-		if (queue_size > 1)
+	// Runs one job deeper than min_depth: the newest one in this thread's deque, otherwise the oldest one in any other deque.
+	bool job_pool::try_run_job(uint32_t min_depth)
+	{
+		const uint32_t own_queue_index = get_queue_index();
+
+		job_entry job;
+		bool found = false;
+
+		for (uint32_t i = 0; (i < m_num_queues) && (!found); i++)
 		{
-			m_has_work.notify_one();
+			job_queue& q = m_queues[(own_queue_index + i) % m_num_queues];
+
+			std::lock_guard<std::mutex> lock(q.m_mutex);
+
+			if (q.m_jobs.empty())
+				continue;
+
+			if (!i)
+			{
+				for (size_t j = q.m_jobs.size(); j > 0; j--)
+				{
+					if (q.m_jobs[j - 1].m_depth > min_depth)
+					{
+						job = std::move(q.m_jobs[j - 1]);
+						q.m_jobs.erase(q.m_jobs.begin() + (j - 1));
+						found = true;
+						break;
+					}
+				}
+			}
+			else
+			{
+				for (size_t j = 0; j < q.m_jobs.size(); j++)
+				{
+					if (q.m_jobs[j].m_depth > min_depth)
+					{
+						job = std::move(q.m_jobs[j]);
+						q.m_jobs.erase(q.m_jobs.begin() + j);
+						found = true;
+						break;
+					}
+				}
+			}
 		}
+
+		if (!found)
+			return false;
+
+		m_num_queued.fetch_sub(1);
+
+		run_job(job);
+
+		return true;
 	}
 
-	void job_pool::wait_for_all()
+	void job_pool::run_job(job_entry& job)
 	{
-		std::unique_lock<std::mutex> lock(m_mutex);
+		job_pool_thread_context& ctx = g_job_pool_thread_context;
+		const job_pool_thread_context prev_ctx(ctx);
+
+		// Jobs added by this job (without an explicit group) go into this implicit group.
+		task_group implicit_group;
+
+		ctx.m_pJob_pool = this;
+		ctx.m_pJob_group = &implicit_group;
+		ctx.m_job_depth = job.m_depth;
 
-		// Drain the job queue on the calling thread.
-		while (!m_queue.empty())
 		{
-			std::function<void()> job(m_queue.back());
-			m_queue.pop_back();
+			// Every job is a zone (the arg is its nesting depth), so the trace shows the pool's utilization.
+			BASISU_TRACE_ZONE_ARG("job", job.m_depth);
+			job.m_func();
+		}
 
-			lock.unlock();
+		// A job isn't done until the jobs it added are done, so waiting on the outer group covers them too.
+		wait_for_group(implicit_group);
 
-			job();
+		ctx = prev_ctx;
 
-			lock.lock();
-		}
+		// Release the job's captures before signaling anybody waiting on it.
+		job.m_func = nullptr;
 
-		// The queue is empty, now wait for all active jobs to finish up.
-#ifndef __EMSCRIPTEN__
-		m_no_more_jobs.wait(lock, [this]{ return !m_num_active_jobs; } );
-#else
-		// Avoid infinite blocking
-		for (; ; )
+		task_group* pGroup = job.m_pGroup;
+		if (pGroup->m_num_pending.fetch_sub(1) == 1)
 		{
-			if (m_no_more_jobs.wait_for(lock, std::chrono::milliseconds(50), [this] { return !m_num_active_jobs; }))
+			if (m_num_waiters.load())
 			{
-				break;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_job_done.notify_all();
 			}
 		}
-#endif
+	}
+
+	void job_pool::wait_for_all()
+	{
+		wait_for_group(get_current_group());
+	}
+
+	void job_pool::wait_for_group(task_group& group)
+	{
+		const job_pool_thread_context& ctx = g_job_pool_thread_context;
+		const uint32_t min_depth = (ctx.m_pJob_pool == this) ? ctx.m_job_depth : 0;
+
+		while (group.m_num_pending.load())
+		{
+			const uint32_t num_adds = m_num_adds.load();
+
+			// Help out while we wait.
+			if (try_run_job(min_depth))
+				continue;
+
+			// Nothing we can run, so sleep until the group is done or more jobs are added.
+			std::unique_lock<std::mutex> lock(m_mutex);
+
+			m_num_waiters.fetch_add(1);
+
+			m_job_done.wait_for(lock, g_job_pool_max_wait, [this, &group, num_adds] { 
+				return m_kill_flag || !group.m_num_pending.load() || (m_num_adds.load() != num_adds);
+				});
+
+			m_num_waiters.fetch_sub(1);
+
+			if (m_kill_flag)
+				break;
+		}
 	}
 
 	void job_pool::job_thread(uint32_t index)
 	{
-		BASISU_NOTE_UNUSED(index);
 		//debug_printf("job_pool::job_thread: starting %u\n", index);
 
+		job_pool_thread_context& ctx = g_job_pool_thread_context;
+		ctx.m_pWorker_pool = this;
+		ctx.m_worker_index = index;
+
 		m_num_active_workers.fetch_add(1);
 		
 		while (!m_kill_flag)
 		{
+			if (try_run_job(0))
+				continue;
+
 			std::unique_lock<std::mutex> lock(m_mutex);
 
 			// Wait for any jobs to be issued.
-#if 0
-			m_has_work.wait(lock, [this] { return m_kill_flag || m_queue.size(); } );
-#else
-			// For more safety vs. buggy RTL's. Worse case we stall for a second vs. locking up forever if something goes wrong.
-			m_has_work.wait_for(lock, std::chrono::milliseconds(1000), [this] {
-				return m_kill_flag || !m_queue.empty();
+			m_has_work.wait_for(lock, g_job_pool_max_wait, [this] {
+				return m_kill_flag || m_num_queued.load();
 				});
-#endif
+		}
 
-			// Check to see if we're supposed to exit.
-			if (m_kill_flag)
-				break;
+		m_num_active_workers.fetch_add(-1);
 
-			if (m_queue.empty())
-				continue;
+		ctx.m_pWorker_pool = nullptr;
 
-			// Get the job and execute it.
-			std::function<void()> job(m_queue.back());
-			m_queue.pop_back();
+		//debug_printf("job_pool::job_thread: exiting\n");
+	}
 
-			++m_num_active_jobs;
+	encode_progress::encode_progress() :
+		m_pCallback(nullptr),
+		m_pCallback_data(nullptr),
+		m_deadline(0.0f),
+		m_range_start(0.0f), m_range_end(100.0f),
+		m_stage_start(0.0f), m_stage_end(1.0f),
+		m_stage_total_units(0),
+		m_last_reported_percentage(0.0f),
+		m_last_callback_time(0.0f)
+	{
+		m_stage_units_done.store(0);
+		m_status.store((int)status::cRunning);
+	}
 
-			lock.unlock();
+	void encode_progress::init(encode_progress_callback_func pCallback, void* pCallback_data, double max_secs)
+	{
+		m_pCallback = pCallback;
+		m_pCallback_data = pCallback_data;
 
-			job();
+		const double cur_time = get_interval_timer();
+		m_deadline = (max_secs > 0.0f) ? (cur_time + max_secs) : 0.0f;
 
-			lock.lock();
+		m_range_start = 0.0f;
+		m_range_end = 100.0f;
+		m_stage_start = 0.0f;
+		m_stage_end = 1.0f;
+		m_stage_total_units = 0;
+		m_stage_units_done.store(0);
 
-			--m_num_active_jobs;
+		m_last_reported_percentage = 0.0f;
+		m_last_callback_time = cur_time;
 
-			// Now check if there are no more jobs remaining. 
-			const bool all_done = m_queue.empty() && !m_num_active_jobs;
-			
-			lock.unlock();
+		m_status.store((int)status::cRunning);
+	}
+
+	void encode_progress::set_range(float start_percentage, float end_percentage)
+	{
+		m_range_start = clamp(start_percentage, 0.0f, 100.0f);
+		m_range_end = clamp(end_percentage, m_range_start, 100.0f);
+
+		begin_stage(0.0f, 1.0f, 0);
+	}
+
+	void encode_progress::begin_stage(float start_frac, float end_frac, uint64_t total_units)
+	{
+		m_stage_start = saturate(start_frac);
+		m_stage_end = clamp(end_frac, m_stage_start, 1.0f);
+		m_stage_total_units = total_units;
+		m_stage_units_done.store(0);
+	}
+
+	void encode_progress::stop(status s)
+	{
+		int expected = (int)status::cRunning;
+		m_status.compare_exchange_strong(expected, (int)s);
+	}
+
+	bool encode_progress::update(uint64_t num_units)
+	{
+		if (is_stopped())
+			return false;
+
+		uint64_t units_done = num_units ? (m_stage_units_done.fetch_add(num_units) + num_units) : m_stage_units_done.load();
+
+		if ((!m_pCallback) && (m_deadline == 0.0f))
+			return true;
 
-			if (all_done)
-				m_no_more_jobs.notify_all();
+		const double cur_time = get_interval_timer();
+
+		if ((m_deadline != 0.0f) && (cur_time >= m_deadline))
+		{
+			stop(status::cDeadlineExceeded);
+			return false;
 		}
 
-		m_num_active_workers.fetch_add(-1);
+		if (!m_pCallback)
+			return true;
 
-		//debug_printf("job_pool::job_thread: exiting\n");
+		// Don't stall the other workers on a slow callback - whoever holds the lock reports for everyone.
+		std::unique_lock<std::mutex> lock(m_callback_mutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return !is_stopped();
+
+		// A stage without units only reports its start, the next stage/range (or the final 100%) moves it along.
+		float stage_frac = 0.0f;
+		if (m_stage_total_units)
+			stage_frac = (float)minimum<uint64_t>(units_done, m_stage_total_units) / (float)m_stage_total_units;
+
+		const float frac = lerp(m_stage_start, m_stage_end, stage_frac);
+		const float percentage = maximum(m_last_reported_percentage, lerp(m_range_start, m_range_end, frac));
+
+		// Call back on every 1% of progress, and at least 10 times a second so cancellation stays responsive during slow stages.
+		const float MIN_PERCENTAGE_DELTA = 1.0f;
+		const double MAX_CALLBACK_INTERVAL = .1f;
+		if ((percentage < (m_last_reported_percentage + MIN_PERCENTAGE_DELTA)) && ((cur_time - m_last_callback_time) < MAX_CALLBACK_INTERVAL))
+			return !is_stopped();
+
+		m_last_reported_percentage = percentage;
+		m_last_callback_time = cur_time;
+
+		if (!(*m_pCallback)(percentage, m_pCallback_data))
+		{
+			stop(status::cCancelled);
+			return false;
+		}
+
+		return !is_stopped();
 	}
 
 	// .TGA image loading
@@ -5356,6 +6138,28 @@ namespace basisu
 				
 		return num_threads;
 	}
+
+	uint64_t get_peak_rss_bytes()
+	{
+#if defined(_WIN32)
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+		return counters.PeakWorkingSetSize;
+#elif defined(__EMSCRIPTEN__) || defined(__wasi__)
+		return 0;
+#else
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+#if defined(__APPLE__)
+		// ru_maxrss is in bytes on macOS, KiB elsewhere.
+		return (uint64_t)usage.ru_maxrss;
+#else
+		return (uint64_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+	}
 		
 	bool display_astc_statistics(
 		const vector2D<astc_helpers::astc_block>& blocks,
@@ -21,6 +21,8 @@
 #include <condition_variable>
 #include <functional>
 #include <thread>
+#include <deque>
+#include <memory>
 #include <unordered_map>
 #include <map>
 #include <ostream>
@@ -34,6 +36,15 @@
 #if BASISU_SUPPORT_SSE
 // Declared in basisu_kernels_imp.h, but we can't include that here otherwise it would lead to circular type errors.
 extern void update_covar_matrix_16x16_sse41(uint32_t num_vecs, const void* pWeighted_vecs, const void* pOrigin, const uint32_t *pVec_indices, void* pMatrix16x16);
+extern void tsvq_split_side_sse41(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pOrigin, const float* pAxis, uint8_t* pFlags);
+extern void tsvq_nearest_child_sse41(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pL, const float* pR, uint8_t* pFlags);
+#endif
+
+#if BASISU_SUPPORT_AVX2
+// Declared in basisu_kernels_imp.h (compiled by basisu_kernels_avx2.cpp).
+extern void update_covar_matrix_16x16_avx2(uint32_t num_vecs, const void* pWeighted_vecs, const void* pOrigin, const uint32_t *pVec_indices, void* pMatrix16x16);
+extern void tsvq_split_side_avx2(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pOrigin, const float* pAxis, uint8_t* pFlags);
+extern void tsvq_nearest_child_avx2(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pL, const float* pR, uint8_t* pFlags);
 #endif
 
 namespace basisu
@@ -54,6 +65,11 @@ namespace basisu
 	// basisu_kernels_sse.cpp - will be a no-op and g_cpu_supports_sse41 will always be false unless compiled with BASISU_SUPPORT_SSE=1
 	extern bool g_cpu_supports_sse41;
 
+	// basisu_kernels_avx2.cpp - g_cpu_supports_avx2 will always be false unless compiled with BASISU_SUPPORT_AVX2=1. Also requires FMA and OS support for the YMM registers.
+	// When true, the cppspmd kernels use their 8-wide AVX2 versions instead of the 4-wide SSE 4.1 versions.
+	extern bool g_cpu_supports_avx2;
+
+	// Sets both g_cpu_supports_sse41 and g_cpu_supports_avx2.
 	extern void detect_sse41();
 		
 	void error_vprintf(const char* pFmt, va_list args);
@@ -818,38 +834,157 @@ namespace basisu
 
 #undef BASISU_GET_KEY
 	
-	// Very simple job pool with no dependencies.
+	// Work stealing job pool with no dependencies. Each worker thread has its own job deque: a worker runs the newest job in its own deque first, 
+	// and when that's empty it steals the oldest job from another thread's deque. Jobs added by threads which aren't workers of this pool go into a shared deque.
+	// Jobs may add jobs and wait for them (nested parallelism): jobs are counted in task groups, and a thread waiting on a group helps run jobs until the group is done.
+	// A waiting thread only runs jobs nested deeper than its own, so waiting can't pull an unrelated outer job onto the waiting thread's stack.
 	class job_pool
 	{
 		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(job_pool);
 
 	public:
+		// A set of jobs which can be waited on independently of the other jobs in the pool. Must outlive its jobs.
+		class task_group
+		{
+			BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(task_group);
+
+		public:
+			task_group() { m_num_pending.store(0); }
+
+			uint32_t get_num_pending() const { return m_num_pending.load(); }
+
+		private:
+			friend class job_pool;
+			std::atomic<uint32_t> m_num_pending;
+		};
+
 		// num_threads is the TOTAL number of job pool threads, including the calling thread! So 2=1 new thread, 3=2 new threads, etc.
 		job_pool(uint32_t num_threads);
 		~job_pool();
 				
+		// Adds a job to the current task group: the implicit group of the calling job when called from inside one of this pool's jobs, 
+		// otherwise the pool's root group.
 		void add_job(const std::function<void()>& job);
 		void add_job(std::function<void()>&& job);
 
+		void add_job(task_group& group, const std::function<void()>& job);
+		void add_job(task_group& group, std::function<void()>&& job);
+
+		// Waits for all the jobs in the current task group (see add_job()) to finish. The calling thread helps run jobs while it waits.
+		// Any jobs a job adds to its implicit group are always finished before the job itself is considered finished.
 		void wait_for_all();
 
+		void wait_for_group(task_group& group);
+
 		size_t get_total_threads() const { return 1 + m_threads.size(); }
 		
 	private:
+		struct job_entry
+		{
+			std::function<void()> m_func;
+			task_group* m_pGroup;
+			uint32_t m_depth;	// 1 for jobs added from outside of this pool's jobs, 2 for jobs added by those jobs, etc.
+		};
+
+		struct job_queue
+		{
+			std::mutex m_mutex;
+			std::deque<job_entry> m_jobs;
+		};
+
 		std::vector<std::thread> m_threads;
-		std::vector<std::function<void()> > m_queue;
+
+		// One deque per worker thread, plus one shared deque (the last one) for every other thread.
+		std::unique_ptr<job_queue[]> m_queues;
+		uint32_t m_num_queues;
+
+		task_group m_root_group;
+
+		std::atomic<uint32_t> m_num_queued;
+		std::atomic<uint32_t> m_num_adds;		// bumped on every add_job(), so waiting threads can tell when new jobs have arrived
+		std::atomic<uint32_t> m_num_waiters;
 		
 		std::mutex m_mutex;
 		std::condition_variable m_has_work;
-		std::condition_variable m_no_more_jobs;
-		
-		uint32_t m_num_active_jobs;
+		std::condition_variable m_job_done;
 		
 		std::atomic<bool> m_kill_flag;
 
 		std::atomic<int> m_num_active_workers;
 
 		void job_thread(uint32_t index);
+		uint32_t get_queue_index() const;
+		task_group& get_current_group();
+		void push_job(task_group& group, std::function<void()>&& job);
+		bool try_run_job(uint32_t min_depth);
+		void run_job(job_entry& job);
+	};
+
+	// Progress/cancellation callback. percentage_complete is [0,100] and never decreases. Return false to cancel the encode.
+	// Called from whichever encoder thread reports progress, but never concurrently.
+	typedef bool (*encode_progress_callback_func)(float percentage_complete, void* pUser_data);
+
+	// Progress reporting, cancellation and wall clock deadline state for one encode. basis_compressor owns one and hands a pointer
+	// to the codec encoders (frontend/backend, UASTC, XUASTC/ASTC LDR, XUBC7, ASTC HDR), which call update() at block batch
+	// granularity from their jobs. Once update() returns false the encode has been stopped: jobs should return immediately without
+	// doing any more work, and the encoder should return false as soon as its pending jobs have drained.
+	class encode_progress
+	{
+		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(encode_progress);
+
+	public:
+		enum class status
+		{
+			cRunning,
+			cCancelled,
+			cDeadlineExceeded
+		};
+
+		encode_progress();
+
+		// pCallback may be nullptr. max_secs <= 0 disables the deadline, otherwise the clock starts now.
+		void init(encode_progress_callback_func pCallback, void* pCallback_data, double max_secs);
+
+		// Sets the range of the overall [0,100] percentage the next encoder call maps to. Not thread safe: call between parallel sections.
+		void set_range(float start_percentage, float end_percentage);
+
+		// Encoders: starts a stage covering [start_frac, end_frac] of the current range, which is done after total_units update()'s.
+		// Not thread safe: call between parallel sections.
+		void begin_stage(float start_frac, float end_frac, uint64_t total_units);
+
+		// Encoders: (re)sets the current stage's total_units, for when only the callee knows how much work it's going to do.
+		void set_stage_units(uint64_t total_units) { m_stage_total_units = total_units; m_stage_units_done.store(0); }
+
+		// Thread safe. Reports num_units more units of completed work in the current stage, checks the deadline, and periodically
+		// calls the callback. Returns false once the encode has been stopped (cancelled or past its deadline).
+		bool update(uint64_t num_units = 0);
+
+		// Thread safe and cheap (no clock reads or callbacks) - for checking at the top of jobs.
+		bool is_stopped() const { return m_status.load(std::memory_order_relaxed) != (int)status::cRunning; }
+
+		status get_status() const { return (status)m_status.load(); }
+
+		// Thread safe. Stops the encode as if the callback had returned false.
+		void cancel() { stop(status::cCancelled); }
+
+	private:
+		encode_progress_callback_func m_pCallback;
+		void* m_pCallback_data;
+
+		double m_deadline;	// get_interval_timer() time, 0=none
+
+		float m_range_start, m_range_end;
+		float m_stage_start, m_stage_end;
+		uint64_t m_stage_total_units;
+		std::atomic<uint64_t> m_stage_units_done;
+
+		std::atomic<int> m_status;
+
+		std::mutex m_callback_mutex;
+		float m_last_reported_percentage;
+		double m_last_callback_time;
+
+		void stop(status s);
 	};
 
 	// Simple 64-bit color class
@@ -1552,7 +1687,8 @@ namespace basisu
 		typedef basisu::vector< training_vec_with_weight > array_of_weighted_training_vecs;
 
 		tree_vector_quant() :
-			m_next_codebook_index(0)
+			m_next_codebook_index(0),
+			m_node_vecs_stride(0)
 		{
 		}
 
@@ -1560,6 +1696,9 @@ namespace basisu
 		{
 			clear_vector(m_training_vecs);
 			clear_vector(m_nodes);
+			clear_vector(m_weighted_norms);
+			clear_vector(m_node_vecs);
+			clear_vector(m_node_flags);
 			m_next_codebook_index = 0;
 		}
 
@@ -1639,6 +1778,11 @@ namespace basisu
 
 			m_nodes.push_back(prepare_root());
 
+			// weight * v.dot(v) of each training vector, which refine_split() needs on every iteration.
+			m_weighted_norms.resize(m_training_vecs.size());
+			for (uint32_t i = 0; i < m_training_vecs.size(); i++)
+				m_weighted_norms[i] = m_training_vecs[i].second * m_training_vecs[i].first.dot(m_training_vecs[i].first);
+
 			priority_queue var_heap;
 			var_heap.init(max_size, 0, m_nodes[0].m_var);
 
@@ -1704,6 +1848,14 @@ namespace basisu
 
 		uint32_t m_next_codebook_index;
 
+		basisu::vector<float> m_weighted_norms;
+
+		// SIMD split evaluation: the training vectors of the node being split in structure of arrays form (see gather_node_vecs()), and
+		// the per vector results of the last split kernel. m_node_vecs is empty if the node is split with the scalar code.
+		basisu::vector<float> m_node_vecs;
+		uint32_t m_node_vecs_stride;
+		basisu::vector<uint8_t> m_node_flags;
+
 		tsvq_node prepare_root() const
 		{
 			double ttsum = 0.0f;
@@ -1738,6 +1890,8 @@ namespace basisu
 			uint64_t l_weight = 0, r_weight = 0;
 			float l_var = 0.0f, r_var = 0.0f;
 
+			gather_node_vecs(m_nodes[node_index]);
+
 			// Compute initial left/right child origins
 			if (!prep_split(m_nodes[node_index], l_child_org, r_child_org))
 				return false;
@@ -1799,6 +1953,74 @@ namespace basisu
 			return true;
 		}
 
+		// Gathers the node's training vectors into m_node_vecs (element i of vector k at [i * m_node_vecs_stride + k]) for the SIMD split 
+		// kernels, which classify all of them at once instead of one vector at a time. Small nodes aren't worth it and use the scalar code.
+		void gather_node_vecs(const tsvq_node &node)
+		{
+			m_node_vecs.resize(0);
+
+#if BASISU_SUPPORT_SSE
+			const uint32_t cMinSIMDVecs = 16;
+			if ((!g_cpu_supports_sse41) || (node.m_training_vecs.size() < cMinSIMDVecs))
+				return;
+
+			const uint32_t N = TrainingVectorType::num_elements;
+			const uint32_t num_vecs = node.m_training_vecs.size_u32();
+			
+			// The kernels process up to 8 vectors at a time, so the padding is zeroed.
+			m_node_vecs_stride = (num_vecs + 7) & ~7;
+			m_node_vecs.resize(N * m_node_vecs_stride);
+			m_node_flags.resize(m_node_vecs_stride);
+
+			for (uint32_t k = 0; k < num_vecs; k++)
+			{
+				const TrainingVectorType &v = m_training_vecs[node.m_training_vecs[k]].first;
+				for (uint32_t i = 0; i < N; i++)
+					m_node_vecs[i * m_node_vecs_stride + k] = v[i];
+			}
+
+			for (uint32_t k = num_vecs; k < m_node_vecs_stride; k++)
+				for (uint32_t i = 0; i < N; i++)
+					m_node_vecs[i * m_node_vecs_stride + k] = 0.0f;
+#else
+			BASISU_NOTE_UNUSED(node);
+#endif
+		}
+
+		// m_node_flags[k] = 1 if (v[k] - origin).dot(axis) >= 0. Requires gather_node_vecs().
+		void simd_split_side(const TrainingVectorType &origin, const TrainingVectorType &axis)
+		{
+#if BASISU_SUPPORT_SSE
+			const uint32_t num_vecs = m_node_flags.size_u32();
+#if BASISU_SUPPORT_AVX2
+			if (g_cpu_supports_avx2)
+				tsvq_split_side_avx2(num_vecs, TrainingVectorType::num_elements, m_node_vecs.data(), m_node_vecs_stride, origin.get_ptr(), axis.get_ptr(), m_node_flags.data());
+			else
+#endif
+				tsvq_split_side_sse41(num_vecs, TrainingVectorType::num_elements, m_node_vecs.data(), m_node_vecs_stride, origin.get_ptr(), axis.get_ptr(), m_node_flags.data());
+#else
+			BASISU_NOTE_UNUSED(origin);
+			BASISU_NOTE_UNUSED(axis);
+#endif
+		}
+
+		// m_node_flags[k] = 1 if v[k] is at least as far from l as from r (squared_distance_d()). Requires gather_node_vecs().
+		void simd_nearest_child(const TrainingVectorType &l, const TrainingVectorType &r)
+		{
+#if BASISU_SUPPORT_SSE
+			const uint32_t num_vecs = m_node_flags.size_u32();
+#if BASISU_SUPPORT_AVX2
+			if (g_cpu_supports_avx2)
+				tsvq_nearest_child_avx2(num_vecs, TrainingVectorType::num_elements, m_node_vecs.data(), m_node_vecs_stride, l.get_ptr(), r.get_ptr(), m_node_flags.data());
+			else
+#endif
+				tsvq_nearest_child_sse41(num_vecs, TrainingVectorType::num_elements, m_node_vecs.data(), m_node_vecs_stride, l.get_ptr(), r.get_ptr(), m_node_flags.data());
+#else
+			BASISU_NOTE_UNUSED(l);
+			BASISU_NOTE_UNUSED(r);
+#endif
+		}
+
 		TrainingVectorType compute_split_axis(const tsvq_node &node) const
 		{
 			const uint32_t N = TrainingVectorType::num_elements;
@@ -1827,7 +2049,12 @@ namespace basisu
 				// This SSE function takes pointers to void types, so do some sanity checks.
 				assert(sizeof(TrainingVectorType) == sizeof(float) * 16);
 				assert(sizeof(training_vec_with_weight) == sizeof(std::pair<vec16F, uint64_t>));
-				update_covar_matrix_16x16_sse41(node.m_training_vecs.size_u32(), m_training_vecs.data(), &node.m_origin, node.m_training_vecs.data(), &cmatrix);
+#if BASISU_SUPPORT_AVX2
+				if (g_cpu_supports_avx2)
+					update_covar_matrix_16x16_avx2(node.m_training_vecs.size_u32(), m_training_vecs.data(), &node.m_origin, node.m_training_vecs.data(), &cmatrix);
+				else
+#endif
+					update_covar_matrix_16x16_sse41(node.m_training_vecs.size_u32(), m_training_vecs.data(), &node.m_origin, node.m_training_vecs.data(), &cmatrix);
 #endif
 			}
 
@@ -1845,7 +2072,7 @@ namespace basisu
 			return compute_pca_from_covar<N, TrainingVectorType>(cmatrix);
 		}
 
-		bool prep_split(const tsvq_node &node, TrainingVectorType &l_child_result, TrainingVectorType &r_child_result) const
+		bool prep_split(const tsvq_node &node, TrainingVectorType &l_child_result, TrainingVectorType &r_child_result)
 		{
 			//const uint32_t N = TrainingVectorType::num_elements;
 
@@ -1859,6 +2086,10 @@ namespace basisu
 			TrainingVectorType axis(compute_split_axis(node)), l_child(0.0f), r_child(0.0f);
 			double l_weight = 0.0f, r_weight = 0.0f;
 
+			const bool use_simd = m_node_vecs.size() != 0;
+			if (use_simd)
+				simd_split_side(node.m_origin, axis);
+
 			// Compute initial left/right children
 			for (uint32_t i = 0; i < node.m_training_vecs.size(); i++)
 			{
@@ -1866,8 +2097,16 @@ namespace basisu
 
 				const TrainingVectorType &v = m_training_vecs[node.m_training_vecs[i]].first;
 
-				double t = (v - node.m_origin).dot(axis);
-				if (t >= 0.0f)
+				bool is_right;
+				if (use_simd)
+					is_right = m_node_flags[i] != 0;
+				else
+				{
+					double t = (v - node.m_origin).dot(axis);
+					is_right = (t >= 0.0f);
+				}
+
+				if (is_right)
 				{
 					r_child += v * weight;
 					r_weight += weight;
@@ -1961,13 +2200,15 @@ namespace basisu
 
 		bool refine_split(const tsvq_node &node,
 			TrainingVectorType &l_child, uint64_t &l_weight, float &l_var, basisu::vector<uint32_t> &l_children,
-			TrainingVectorType &r_child, uint64_t &r_weight, float &r_var, basisu::vector<uint32_t> &r_children) const
+			TrainingVectorType &r_child, uint64_t &r_weight, float &r_var, basisu::vector<uint32_t> &r_children)
 		{
 			l_children.reserve(node.m_training_vecs.size());
 			r_children.reserve(node.m_training_vecs.size());
 
 			float prev_total_variance = 1e+10f;
 
+			const bool use_simd = m_node_vecs.size() != 0;
+
 			// Refine left/right children locations using k-means iterations
 			const uint32_t cMaxIters = 6;
 			for (uint32_t iter = 0; iter < cMaxIters; iter++)
@@ -1982,28 +2223,39 @@ namespace basisu
 				l_weight = 0;
 				r_weight = 0;
 
+				if (use_simd)
+					simd_nearest_child(l_child, r_child);
+
 				for (uint32_t i = 0; i < node.m_training_vecs.size(); i++)
 				{
-					const TrainingVectorType &v = m_training_vecs[node.m_training_vecs[i]].first;
-					const uint64_t weight = m_training_vecs[node.m_training_vecs[i]].second;
+					const uint32_t vec_index = node.m_training_vecs[i];
+					const TrainingVectorType &v = m_training_vecs[vec_index].first;
+					const uint64_t weight = m_training_vecs[vec_index].second;
 
-					double left_dist2 = l_child.squared_distance_d(v), right_dist2 = r_child.squared_distance_d(v);
+					bool is_right;
+					if (use_simd)
+						is_right = m_node_flags[i] != 0;
+					else
+					{
+						double left_dist2 = l_child.squared_distance_d(v), right_dist2 = r_child.squared_distance_d(v);
+						is_right = (left_dist2 >= right_dist2);
+					}
 
-					if (left_dist2 >= right_dist2)
+					if (is_right)
 					{
 						new_r_child += (v * static_cast<float>(weight));
 						r_weight += weight;
 
-						r_ttsum += weight * v.dot(v);
-						r_children.push_back(node.m_training_vecs[i]);
+						r_ttsum += m_weighted_norms[vec_index];
+						r_children.push_back(vec_index);
 					}
 					else
 					{
 						new_l_child += (v * static_cast<float>(weight));
 						l_weight += weight;
 
-						l_ttsum += weight * v.dot(v);
-						l_children.push_back(node.m_training_vecs[i]);
+						l_ttsum += m_weighted_norms[vec_index];
+						l_children.push_back(vec_index);
 					}
 				}
 
@@ -2390,6 +2642,14 @@ namespace basisu
 			m_hist[index]++;
 		}
 
+		// Adds another histogram's counts to this one, both must be the same size.
+		void add(const histogram& other)
+		{
+			assert(other.size() == size());
+			for (uint32_t i = 0; i < m_hist.size(); ++i)
+				m_hist[i] += other.m_hist[i];
+		}
+
 		uint64_t get_total() const
 		{
 			uint64_t total = 0;
@@ -3893,6 +4153,39 @@ namespace basisu
 		void calc_half(const imagef& a, const imagef& b, uint32_t first_chan, uint32_t total_chans, bool avg_comp_error);
 		void calc_half2(const imagef& a, const imagef& b, uint32_t first_chan, uint32_t total_chans, bool avg_comp_error);
 		void calc(const image &a, const image &b, uint32_t first_chan = 0, uint32_t total_chans = 0, bool avg_comp_error = true, bool use_601_luma = false);
+
+		// Sets m_max/m_mean/m_mean_squared/m_rms/m_psnr from a histogram of absolute 8-bit differences (the last step of calc(const image&, ...)).
+		void calc_from_histogram(const uint64_t* pHist, uint32_t width, uint32_t height, uint32_t total_chans, bool avg_comp_error);
+	};
+
+	// Computes everything image_metrics::calc(const image&, const image&, ...) can return for an image pair (R, G, B, A, RGB, RGBA, 709 and 601 luma)
+	// in a single pass over the images, optionally split into row bands across a job pool. get() then fills in an image_metrics exactly like calc() would have.
+	class fused_image_metrics
+	{
+	public:
+		fused_image_metrics() { clear(); }
+
+		void clear();
+
+		void calc(const image& a, const image& b, job_pool* pJob_pool = nullptr);
+
+		// Accumulates other's histograms, as if its rows were appended to this image (the widths must match). For images processed in strips.
+		void add(const fused_image_metrics& other);
+
+		// Same parameters as image_metrics::calc().
+		void get(image_metrics& m, uint32_t first_chan = 0, uint32_t total_chans = 0, bool avg_comp_error = true, bool use_601_luma = false) const;
+
+	private:
+		enum
+		{
+			cHist709 = 4,	// histograms 0-3 are R, G, B, A
+			cHist601,
+			cTotalHists
+		};
+
+		uint32_t m_width, m_height;
+		uint64_t m_hist[cTotalHists][256];
+		uint64_t m_sum_a[4], m_sum_b[4];
 	};
 
 	void print_image_metrics(const image& a, const image& b);
@@ -4068,6 +4361,53 @@ namespace basisu
 	bool write_data_to_file(const char* pFilename, const void* pData, size_t len);
 	
 	inline bool write_vec_to_file(const char* pFilename, const uint8_vec& v) {	return v.size() ? write_data_to_file(pFilename, &v[0], v.size()) : write_data_to_file(pFilename, "", 0); }
+
+	// Writes the data to a temporary file, then renames it over pFilename, so readers see either the old or the new file but never a partially written one.
+	bool write_data_to_file_atomic(const char* pFilename, const void* pData, size_t len);
+
+	// Read-only memory mapped file: mmap() on POSIX, a file mapping on Windows (falls back to reading the whole file elsewhere, e.g. Emscripten/WASI).
+	// Pages are only read from disk the first time they're touched, so the mapping can be handed directly to ktx2_transcoder::init() or
+	// basisu_transcoder::start_transcoding() without reading the levels that are never transcoded, or keeping a second copy of the file in memory.
+	class memory_mapped_file
+	{
+		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(memory_mapped_file);
+
+	public:
+		enum access_hint
+		{
+			cHintNormal,
+			cHintSequential,	// read ahead aggressively
+			cHintRandom,		// don't read ahead
+			cHintWillNeed,		// start reading the range in now
+			cHintDontNeed		// the range's pages can be dropped (they'll be reread from the file if touched again)
+		};
+
+		memory_mapped_file();
+		~memory_mapped_file();
+
+		bool open(const char* pFilename);
+		void close();
+
+		bool is_open() const { return m_pData != nullptr; }
+
+		const uint8_t* get_ptr() const { return m_pData; }
+		size_t get_size() const { return m_size; }
+
+		// Page cache hints (madvise()). The range is expanded to page boundaries. These are only hints: they're ignored on platforms without madvise().
+		void advise(access_hint hint);
+		void advise(uint64_t ofs, uint64_t size, access_hint hint);
+
+	private:
+		const uint8_t* m_pData;
+		size_t m_size;
+
+#if defined(_WIN32)
+		void* m_hFile;
+		void* m_hMapping;
+#endif
+		uint8_vec m_fallback_buf;
+		bool m_mapped;
+	};
 		
 	bool image_resample(const image &src, image &dst, bool srgb = false,
 		const char *pFilter = "lanczos4", float filter_scale = 1.0f, 
@@ -4111,6 +4451,79 @@ namespace basisu
 
 	inline double get_interval_timer() { return interval_timer::ticks_to_secs(interval_timer::get_ticks()); }
 
+	// Encoder instrumentation: scoped zones (BASISU_TRACE_ZONE) and counters (BASISU_TRACE_COUNTER), recorded process-wide with 
+	// the thread that ran them, and exportable as Chrome trace event JSON (load it in Perfetto or chrome://tracing). Nothing is 
+	// recorded outside of a session. Disabled zones cost one relaxed atomic load; building with BASISU_SUPPORT_TRACE=0 compiles 
+	// them out entirely.
+	class trace_recorder
+	{
+	public:
+		// Sessions nest, and every thread's zones are recorded while any session is active (basis_compressor::process() starts one 
+		// when m_trace is set). The outermost begin_session() clears the previously recorded events.
+		static void begin_session();
+		static void end_session();
+
+		static inline bool is_enabled() { return g_num_sessions.load(std::memory_order_relaxed) != 0; }
+
+		// pName must outlive the recorder (use string literals). arg, if >= 0, is exported as the zone's "index" arg (pass numbers, 
+		// slice indices, etc.)
+		static void add_zone(const char* pName, timer_ticks start_ticks, timer_ticks end_ticks, int64_t arg = -1);
+		static void add_counter(const char* pName, double value);
+
+		// Small sequential ID of the calling thread (0 is the first thread to record anything), used as the exported "tid".
+		static uint32_t get_thread_index();
+
+		static size_t get_total_events();
+		static void clear();
+
+		static void get_json(std::string& json);
+		static bool write_json(const char* pFilename);
+
+	private:
+		static std::atomic<uint32_t> g_num_sessions;
+	};
+
+	class trace_zone
+	{
+		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(trace_zone);
+
+	public:
+		inline trace_zone(const char* pName, int64_t arg = -1) : 
+			m_pName(trace_recorder::is_enabled() ? pName : nullptr), 
+			m_start_ticks(m_pName ? interval_timer::get_ticks() : 0), 
+			m_arg(arg)
+		{
+		}
+
+		inline ~trace_zone()
+		{
+			if (m_pName)
+				trace_recorder::add_zone(m_pName, m_start_ticks, interval_timer::get_ticks(), m_arg);
+		}
+
+	private:
+		const char* m_pName;
+		timer_ticks m_start_ticks;
+		int64_t m_arg;
+	};
+
+#ifndef BASISU_SUPPORT_TRACE
+	#define BASISU_SUPPORT_TRACE 1
+#endif
+
+#define BASISU_TRACE_JOIN_(a, b) a##b
+#define BASISU_TRACE_JOIN(a, b) BASISU_TRACE_JOIN_(a, b)
+
+#if BASISU_SUPPORT_TRACE
+	#define BASISU_TRACE_ZONE(name) basisu::trace_zone BASISU_TRACE_JOIN(basisu_trace_zone_, __LINE__)(name)
+	#define BASISU_TRACE_ZONE_ARG(name, arg) basisu::trace_zone BASISU_TRACE_JOIN(basisu_trace_zone_, __LINE__)(name, (int64_t)(arg))
+	#define BASISU_TRACE_COUNTER(name, value) do { if (basisu::trace_recorder::is_enabled()) basisu::trace_recorder::add_counter(name, (double)(value)); } while (0)
+#else
+	#define BASISU_TRACE_ZONE(name) do { } while (0)
+	#define BASISU_TRACE_ZONE_ARG(name, arg) do { } while (0)
+	#define BASISU_TRACE_COUNTER(name, value) do { } while (0)
+#endif
+
 	inline FILE *fopen_safe(const char *pFilename, const char *pMode)
 	{
 #ifdef _WIN32
@@ -4583,6 +4996,9 @@ namespace basisu
 	void set_num_wasi_threads(uint32_t num_threads);
 	int get_num_hardware_threads();
 
+	// The process's peak resident set size (the peak working set on Windows) in bytes so far, or 0 where this isn't available (WASM).
+	uint64_t get_peak_rss_bytes();
+
 	bool display_astc_statistics(
 		const vector2D<astc_helpers::astc_block>& blocks,
 		uint32_t block_width, uint32_t block_height, uint32_t image_width, uint32_t image_height, bool verbose);
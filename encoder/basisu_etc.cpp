@@ -19,6 +19,12 @@
 #include "basisu_kernels_declares.h"
 #endif
 
+#if BASISU_SUPPORT_AVX2
+#undef CPPSPMD_NAME
+#define CPPSPMD_NAME(a) a##_avx2
+#include "basisu_kernels_declares.h"
+#endif
+
 #define BASISU_DEBUG_ETC_ENCODER 0
 #define BASISU_DEBUG_ETC_ENCODER_DEEPER 0
 
@@ -1232,9 +1238,23 @@ namespace basisu
 				if (pSelectors_to_use)
 				{
 					if (m_pParams->m_perceptual)
-						perceptual_distance_rgb_4_N_sse41((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+					{
+#if BASISU_SUPPORT_AVX2
+						if (g_cpu_supports_avx2)
+							perceptual_distance_rgb_4_N_avx2((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+						else
+#endif
+							perceptual_distance_rgb_4_N_sse41((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+					}
 					else
-						linear_distance_rgb_4_N_sse41((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+					{
+#if BASISU_SUPPORT_AVX2
+						if (g_cpu_supports_avx2)
+							linear_distance_rgb_4_N_avx2((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+						else
+#endif
+							linear_distance_rgb_4_N_sse41((int64_t*)&total_error, pSelectors_to_use, block_colors, pSrc_pixels, n, trial_solution.m_error);
+					}
 					
 					for (uint32_t i = 0; i < n; i++)
 						m_temp_selectors[i] = pSelectors_to_use[i];
@@ -1242,9 +1262,23 @@ namespace basisu
 				else
 				{
 					if (m_pParams->m_perceptual)
-						find_selectors_perceptual_rgb_4_N_sse41((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+					{
+#if BASISU_SUPPORT_AVX2
+						if (g_cpu_supports_avx2)
+							find_selectors_perceptual_rgb_4_N_avx2((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+						else
+#endif
+							find_selectors_perceptual_rgb_4_N_sse41((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+					}
 					else
-						find_selectors_linear_rgb_4_N_sse41((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+					{
+#if BASISU_SUPPORT_AVX2
+						if (g_cpu_supports_avx2)
+							find_selectors_linear_rgb_4_N_avx2((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+						else
+#endif
+							find_selectors_linear_rgb_4_N_sse41((int64_t*)&total_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, trial_solution.m_error);
+					}
 				}
 #endif
 			}
@@ -1415,7 +1449,12 @@ namespace basisu
 						}
 
 						int64_t block_error;
-						perceptual_distance_rgb_4_N_sse41(&block_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, INT64_MAX);
+#if BASISU_SUPPORT_AVX2
+						if (g_cpu_supports_avx2)
+							perceptual_distance_rgb_4_N_avx2(&block_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, INT64_MAX);
+						else
+#endif
+							perceptual_distance_rgb_4_N_sse41(&block_error, &m_temp_selectors[0], block_colors, pSrc_pixels, n, INT64_MAX);
 						total_error += block_error;
 #endif
 					}
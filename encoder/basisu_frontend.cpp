@@ -28,6 +28,12 @@
 #include "basisu_kernels_declares.h"
 #endif
 
+#if BASISU_SUPPORT_AVX2
+#undef CPPSPMD_NAME
+#define CPPSPMD_NAME(a) a##_avx2
+#include "basisu_kernels_declares.h"
+#endif
+
 #define BASISU_FRONTEND_VERIFY(c) do { if (!(c)) handle_verify_failure(__LINE__); } while(0)
 
 namespace basisu
@@ -165,20 +171,33 @@ namespace basisu
 
 		// Encode the initial high quality ETC1S texture
 
+		begin_progress_stage(0.0f, .3f, m_total_blocks);
+
 		init_etc1_images();
 
+		if (is_stopped())
+			return false;
+
 		// First quantize the ETC1S endpoints
 
 		if (m_params.m_pGlobal_codebooks)
 		{
 			init_global_codebooks();
+
+			if (!update_progress())
+				return false;
 		}
 		else
 		{
+			begin_progress_stage(.3f, .6f, 1 + m_num_endpoint_codebook_iterations);
+
 			init_endpoint_training_vectors();
 
 			generate_endpoint_clusters();
 
+			if (!update_progress(1))
+				return false;
+
 			for (uint32_t refine_endpoint_step = 0; refine_endpoint_step < m_num_endpoint_codebook_iterations; refine_endpoint_step++)
 			{
 				if (m_params.m_validate)
@@ -191,6 +210,9 @@ namespace basisu
 				if (refine_endpoint_step)
 				{
 					introduce_new_endpoint_clusters();
+
+					if (is_stopped())
+						return false;
 				}
 
 				if (m_params.m_validate)
@@ -200,6 +222,9 @@ namespace basisu
 
 				generate_endpoint_codebook(refine_endpoint_step);
 
+				if (is_stopped())
+					return false;
+
 				if ((m_params.m_debug_images) && (m_params.m_dump_endpoint_clusterization))
 				{
 					char buf[256];
@@ -216,6 +241,9 @@ namespace basisu
 					if (!refine_endpoint_clusterization())
 						early_out = true;
 
+					if (is_stopped())
+						return false;
+
 					if ((m_params.m_tex_type == basist::cBASISTexTypeVideoFrames) && (!refine_endpoint_step) && (m_num_endpoint_codebook_iterations == 1))
 					{
 						eliminate_redundant_or_empty_endpoint_clusters();
@@ -249,6 +277,9 @@ namespace basisu
 				if (m_params.m_debug_stats)
 					debug_printf("Total endpoint clusters: %u\n", (uint32_t)m_endpoint_clusters.size());
 
+				if (!update_progress(1))
+					return false;
+
 				if (early_out)
 					break;
 			}
@@ -262,10 +293,18 @@ namespace basisu
 
 			create_initial_packed_texture();
 
+			if (is_stopped())
+				return false;
+
 			// Now quantize the ETC1S selectors
 
+			begin_progress_stage(.6f, .95f, 1 + ((m_params.m_compression_level == 0) ? 1 : m_num_selector_codebook_iterations));
+
 			generate_selector_clusters();
 
+			if (!update_progress(1))
+				return false;
+
 			if (m_use_hierarchical_selector_codebooks)
 				compute_selector_clusters_within_each_parent_cluster();
 				
@@ -274,8 +313,14 @@ namespace basisu
 				create_optimized_selector_codebook(0);
 
 				find_optimal_selector_clusters_for_each_block();
+
+				if (is_stopped())
+					return false;
 							
 				introduce_special_selector_clusters();
+
+				if (!update_progress(1))
+					return false;
 			}
 			else
 			{
@@ -286,12 +331,21 @@ namespace basisu
 
 					find_optimal_selector_clusters_for_each_block();
 
+					if (is_stopped())
+						return false;
+
 					introduce_special_selector_clusters();
 
+					if (!update_progress(1))
+						return false;
+
 					if ((m_params.m_compression_level >= 4) || (m_params.m_tex_type == basist::cBASISTexTypeVideoFrames))
 					{
 						if (!refine_block_endpoints_given_selectors())
 							break;
+
+						if (is_stopped())
+							return false;
 					}
 				}
 			}
@@ -302,8 +356,13 @@ namespace basisu
 				debug_printf("Total selector clusters: %u\n", (uint32_t)m_selector_cluster_block_indices.size());
 		}
 
+		begin_progress_stage(.95f, 1.0f, 1);
+
 		finalize();
 
+		if (!update_progress(1))
+			return false;
+
 		if (m_params.m_validate)
 		{
 			if (!validate_output())
@@ -317,6 +376,8 @@ namespace basisu
 
 	bool basisu_frontend::init_global_codebooks()
 	{
+		BASISU_TRACE_ZONE("basisu_frontend::init_global_codebooks");
+
 		const basist::basisu_lowlevel_etc1s_transcoder* pTranscoder = m_params.m_pGlobal_codebooks;
 
 		const basist::basisu_lowlevel_etc1s_transcoder::endpoint_vec& endpoints = pTranscoder->get_endpoints();
@@ -354,6 +415,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 			m_params.m_pJob_pool->add_job([this, first_index, last_index] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 				{
@@ -392,6 +455,9 @@ namespace basisu
 
 		m_params.m_pJob_pool->wait_for_all();
 
+		if (is_stopped())
+			return false;
+
 		m_encoded_blocks.resize(m_total_blocks);
 		for (uint32_t block_index = 0; block_index < m_total_blocks; block_index++)
 		{
@@ -407,7 +473,81 @@ namespace basisu
 		}
 #endif
 
-		// HACK HACK
+		// Matching each block against the global codebooks is O(blocks*codebook_size) ETC1S evaluations per pass. Precompute each endpoint's block colors 
+		// so each evaluation is cheap. With m_fast_global_codebook_search the endpoints are also bucketed by their 5-bit base color, so each block only 
+		// considers the codebook entries whose base color is close to its own ETC1S endpoint. That's much faster on the codebook sizes training produces, 
+		// but approximate: the default search still tries every endpoint.
+		const uint32_t total_endpoints = (uint32_t)endpoints.size();
+		const uint32_t total_selectors = (uint32_t)selectors.size();
+
+		basisu::vector<color_rgba> endpoint_block_colors(total_endpoints * 4);
+		for (uint32_t i = 0; i < total_endpoints; i++)
+			etc_block::get_block_colors_etc1s(&endpoint_block_colors[i * 4], m_endpoint_cluster_etc_params[i].m_color_unscaled[0], m_endpoint_cluster_etc_params[i].m_inten_table[0]);
+
+		uint_vec endpoint_grid_ofs, endpoint_grid;
+		if (m_params.m_fast_global_codebook_search)
+		{
+			endpoint_grid_ofs.resize(32 * 32 * 32 + 1);
+			endpoint_grid.resize(total_endpoints);
+
+			for (uint32_t i = 0; i < total_endpoints; i++)
+			{
+				const color_rgba& c = m_endpoint_cluster_etc_params[i].m_color_unscaled[0];
+				endpoint_grid_ofs[((c.r << 10) | (c.g << 5) | c.b) + 1]++;
+			}
+
+			for (uint32_t i = 0; i < 32 * 32 * 32; i++)
+				endpoint_grid_ofs[i + 1] += endpoint_grid_ofs[i];
+
+			uint_vec cell_cursor(endpoint_grid_ofs);
+			for (uint32_t i = 0; i < total_endpoints; i++)
+			{
+				const color_rgba& c = m_endpoint_cluster_etc_params[i].m_color_unscaled[0];
+				endpoint_grid[cell_cursor[(c.r << 10) | (c.g << 5) | c.b]++] = i;
+			}
+		}
+
+		// Sort the selector codebook by its rows of 2-bit selectors, row 0 first, so the per-block search below can reject whole groups of entries 
+		// that share the same leading rows using the error of those rows alone. 
+		uint_vec selector_keys(total_selectors), selector_key_indices(total_selectors), selector_key_ranks(total_selectors);
+		uint_vec selector_group_ends[3];
+		{
+			basisu::vector<uint64_t> sorted_keys(total_selectors);
+			for (uint32_t i = 0; i < total_selectors; i++)
+			{
+				uint32_t key = 0;
+				for (uint32_t y = 0; y < 4; y++)
+					for (uint32_t x = 0; x < 4; x++)
+						key |= selectors[i].get_selector(x, y) << ((3 - y) * 8 + x * 2);
+				sorted_keys[i] = ((uint64_t)key << 32) | i;
+			}
+			std::sort(sorted_keys.begin(), sorted_keys.end());
+
+			for (uint32_t i = 0; i < total_selectors; i++)
+			{
+				selector_keys[i] = (uint32_t)(sorted_keys[i] >> 32);
+				selector_key_indices[i] = (uint32_t)sorted_keys[i];
+				selector_key_ranks[selector_key_indices[i]] = i;
+			}
+
+			// selector_group_ends[l][i] is one past the last sorted entry sharing rows 0-l with entry i.
+			for (uint32_t l = 0; l < 3; l++)
+			{
+				const uint32_t mask = 0xFFFFFFFFU << ((2 - l) * 8 + 8);
+				selector_group_ends[l].resize(total_selectors);
+				for (int i = total_selectors - 1; i >= 0; i--)
+				{
+					if (((uint32_t)i + 1 < total_selectors) && (((selector_keys[i] ^ selector_keys[i + 1]) & mask) == 0))
+						selector_group_ends[l][i] = selector_group_ends[l][i + 1];
+					else
+						selector_group_ends[l][i] = i + 1;
+				}
+			}
+		}
+
+		// With m_fast_global_codebook_search, the neighborhood around each block's base color is grown until at least this many codebook endpoints have been tried.
+		const uint32_t MIN_ENDPOINT_CANDIDATES = 64;
+
 		const uint32_t NUM_PASSES = 3;
 		for (uint32_t pass = 0; pass < NUM_PASSES; pass++)
 		{
@@ -419,47 +559,115 @@ namespace basisu
 				const uint32_t first_index = block_index_iter;
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
-				m_params.m_pJob_pool->add_job([this, first_index, last_index, pass] {
-										
+				m_params.m_pJob_pool->add_job([this, first_index, last_index, pass, total_endpoints, &endpoint_block_colors, &endpoint_grid_ofs, &endpoint_grid] {
+					if (is_stopped())
+						return;
+					
+					const bool perceptual = m_params.m_perceptual;
+
 					for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 					{
-						const etc_block& blk = pass ? m_encoded_blocks[block_index] : m_etc1_blocks_etc1s[block_index];
-						const uint32_t blk_raw_selector_bits = blk.get_raw_selector_bits();
-
-						etc_block trial_blk(blk);
-						trial_blk.set_raw_selector_bits(blk_raw_selector_bits);
-						trial_blk.set_flip_bit(true);
+						const color_rgba* pSource_pixels = get_source_pixel_block(block_index).get_ptr();
+						
+						// On the first pass each endpoint is scored with its best selectors, after that with the block's current selectors.
+						uint8_t cur_sels[16];
+						if (pass)
+						{
+							for (uint32_t i = 0; i < 16; i++)
+								cur_sels[i] = (uint8_t)m_encoded_blocks[block_index].get_selector(i & 3, i >> 2);
+						}
 
 						uint64_t best_err = UINT64_MAX;
 						uint32_t best_index = 0;
-						etc_block best_block(trial_blk);
-												
-						for (uint32_t i = 0; i < m_endpoint_cluster_etc_params.size(); i++)
+
+						auto eval_endpoint = [&](uint32_t endpoint_index) 
 						{
-							if (m_endpoint_cluster_etc_params[i].m_inten_table[0] > blk.get_inten_table(0))
-								continue;
+							const color_rgba* pColors = &endpoint_block_colors[endpoint_index * 4];
+							
+							uint64_t err = 0;
+							for (uint32_t i = 0; i < 16; i++)
+							{
+								if (pass)
+									err += color_distance(perceptual, pSource_pixels[i], pColors[cur_sels[i]], false);
+								else
+								{
+									err += basisu::minimum(
+										color_distance(perceptual, pSource_pixels[i], pColors[0], false), color_distance(perceptual, pSource_pixels[i], pColors[1], false), 
+										color_distance(perceptual, pSource_pixels[i], pColors[2], false), color_distance(perceptual, pSource_pixels[i], pColors[3], false));
+								}
+								
+								if (err >= best_err)
+									return;
+							}
 
-							trial_blk.set_block_color5_etc1s(m_endpoint_cluster_etc_params[i].m_color_unscaled[0]);
-							trial_blk.set_inten_tables_etc1s(m_endpoint_cluster_etc_params[i].m_inten_table[0]);
+							best_err = err;
+							best_index = endpoint_index;
+						};
 
-							const color_rgba* pSource_pixels = get_source_pixel_block(block_index).get_ptr();
-							uint64_t cur_err;
-							if (!pass)
-								cur_err = trial_blk.determine_selectors(pSource_pixels, m_params.m_perceptual);
-							else
-								cur_err = trial_blk.evaluate_etc1_error(pSource_pixels, m_params.m_perceptual);
+						if (!m_params.m_fast_global_codebook_search)
+						{
+							// Try every endpoint whose intensity table isn't larger than the block's own, in codebook order.
+							const uint32_t blk_inten_table = (pass ? m_encoded_blocks[block_index] : m_etc1_blocks_etc1s[block_index]).get_inten_table(0);
 
-							if (cur_err < best_err)
+							for (uint32_t i = 0; (i < total_endpoints) && (best_err); i++)
 							{
-								best_err = cur_err;
-								best_index = i;
-								best_block = trial_blk;
+								if (m_endpoint_cluster_etc_params[i].m_inten_table[0] > blk_inten_table)
+									continue;
+
+								eval_endpoint(i);
+							}
+						}
+						else
+						{
+							if (pass)
+								eval_endpoint(m_block_endpoint_clusters_indices[block_index][0]);
+
+							const color_rgba center(etc_block::unpack_color5(m_etc1_blocks_etc1s[block_index].get_base5_color(), false));
+
+							uint32_t total_tried = 0;
+							int prev_radius = -1;
+							for (int radius = 1; (radius <= 32) && (best_err); radius *= 2)
+							{
+								const int r_lo = maximum<int>(0, center.r - radius), r_hi = minimum<int>(31, center.r + radius);
+								const int g_lo = maximum<int>(0, center.g - radius), g_hi = minimum<int>(31, center.g + radius);
+								const int b_lo = maximum<int>(0, center.b - radius), b_hi = minimum<int>(31, center.b + radius);
+
+								for (int r = r_lo; r <= r_hi; r++)
+								{
+									for (int g = g_lo; g <= g_hi; g++)
+									{
+										for (int b = b_lo; b <= b_hi; b++)
+										{
+											// Skip the cells already visited at the previous radius.
+											if (((int)iabs(r - center.r) <= prev_radius) && ((int)iabs(g - center.g) <= prev_radius) && ((int)iabs(b - center.b) <= prev_radius))
+												continue;
+
+											const uint32_t cell = (r << 10) | (g << 5) | b;
+											for (uint32_t j = endpoint_grid_ofs[cell]; j < endpoint_grid_ofs[cell + 1]; j++)
+												eval_endpoint(endpoint_grid[j]);
 
-								if (!cur_err)
+											total_tried += endpoint_grid_ofs[cell + 1] - endpoint_grid_ofs[cell];
+										}
+									}
+								}
+
+								if (total_tried >= minimum(MIN_ENDPOINT_CANDIDATES, total_endpoints))
 									break;
+
+								prev_radius = radius;
 							}
 						}
 
+						etc_block best_block;
+						clear_obj(best_block);
+						best_block.set_flip_bit(true);
+						best_block.set_block_color5_etc1s(m_endpoint_cluster_etc_params[best_index].m_color_unscaled[0]);
+						best_block.set_inten_tables_etc1s(m_endpoint_cluster_etc_params[best_index].m_inten_table[0]);
+						if (!pass)
+							best_block.determine_selectors(pSource_pixels, perceptual);
+						else
+							best_block.set_raw_selector_bits(m_encoded_blocks[block_index].get_raw_selector_bits());
+
 						m_block_endpoint_clusters_indices[block_index][0] = best_index;
 						m_block_endpoint_clusters_indices[block_index][1] = best_index;
 
@@ -473,6 +681,9 @@ namespace basisu
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (is_stopped())
+				return false;
+
 			m_endpoint_clusters.resize(0);
 			m_endpoint_clusters.resize(endpoints.size());
 			for (uint32_t block_index = 0; block_index < m_total_blocks; block_index++)
@@ -489,35 +700,79 @@ namespace basisu
 				const uint32_t first_index = block_index_iter;
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
-				m_params.m_pJob_pool->add_job([this, first_index, last_index] {
+				m_params.m_pJob_pool->add_job([this, first_index, last_index, pass, total_selectors, &endpoint_block_colors, &selector_keys, &selector_key_indices, &selector_key_ranks, &selector_group_ends] {
+					if (is_stopped())
+						return;
 
 					for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 					{
 						const uint32_t block_endpoint_index = m_block_endpoint_clusters_indices[block_index][0];
+						const color_rgba* pBlock_pixels = get_source_pixel_block(block_index).get_ptr();
+						const color_rgba* pBlock_colors = &endpoint_block_colors[block_endpoint_index * 4];
 
-						etc_block trial_blk;
-						clear_obj(trial_blk);
-						trial_blk.set_block_color5_etc1s(m_endpoint_cluster_etc_params[block_endpoint_index].m_color_unscaled[0]);
-						trial_blk.set_inten_tables_etc1s(m_endpoint_cluster_etc_params[block_endpoint_index].m_inten_table[0]);
-						trial_blk.set_flip_bit(true);
+						// Exact search, like find_optimal_selector_clusters_for_each_block(), but over the sorted codebook so entries sharing 
+						// leading rows are rejected together when the error of those rows plus the lower bound of the rest can't beat the best so far.
+						// Ties go to the lowest codebook index, so the result is the same as a linear scan's.
+						uint32_t trial_errors[4][16];
+						for (uint32_t sel = 0; sel < 4; ++sel)
+							for (uint32_t i = 0; i < 16; ++i)
+								trial_errors[sel][i] = color_distance(m_params.m_perceptual, pBlock_pixels[i], pBlock_colors[sel], false);
+
+						// min_possible_error[k] is the lowest error rows k-3 can have given any selectors.
+						uint64_t min_possible_error[4] = { 0, 0, 0, 0 };
+						for (uint32_t i = 0; i < 16; i++)
+						{
+							const uint32_t e = basisu::minimum(trial_errors[0][i], trial_errors[1][i], trial_errors[2][i], trial_errors[3][i]);
+							for (uint32_t k = 0; k <= (i >> 2); k++)
+								min_possible_error[k] += e;
+						}
+
+						uint32_t row_errors[4][256];
+						for (uint32_t y = 0; y < 4; y++)
+							for (uint32_t v = 0; v < 256; v++)
+								row_errors[y][v] = trial_errors[v & 3][y * 4 + 0] + trial_errors[(v >> 2) & 3][y * 4 + 1] + trial_errors[(v >> 4) & 3][y * 4 + 2] + trial_errors[(v >> 6) & 3][y * 4 + 3];
 
 						uint64_t best_err = UINT64_MAX;
 						uint32_t best_index = 0;
 
-						for (uint32_t i = 0; i < m_optimized_cluster_selectors.size(); i++)
+						// Start from the previous pass's choice, which is usually close to the best and makes the rejections much more effective.
+						if (pass)
 						{
-							trial_blk.set_raw_selector_bits(m_optimized_cluster_selectors[i].get_raw_selector_bits());
+							best_index = m_block_selector_cluster_index[block_index];
+							const uint32_t key = selector_keys[selector_key_ranks[best_index]];
+							best_err = (uint64_t)row_errors[0][key >> 24] + row_errors[1][(key >> 16) & 0xFF] + row_errors[2][(key >> 8) & 0xFF] + row_errors[3][key & 0xFF];
+						}
 
-							const uint64_t cur_err = trial_blk.evaluate_etc1_error(get_source_pixel_block(block_index).get_ptr(), m_params.m_perceptual);
-							if (cur_err < best_err)
+						for (uint32_t i0 = 0; i0 < total_selectors; i0 = selector_group_ends[0][i0])
+						{
+							const uint64_t e0 = row_errors[0][selector_keys[i0] >> 24];
+							if ((e0 + min_possible_error[1]) > best_err)
+								continue;
+
+							for (uint32_t i1 = i0; i1 < selector_group_ends[0][i0]; i1 = selector_group_ends[1][i1])
 							{
-								best_err = cur_err;
-								best_index = i;
-								if (!cur_err)
-									break;
-							}
+								const uint64_t e1 = e0 + row_errors[1][(selector_keys[i1] >> 16) & 0xFF];
+								if ((e1 + min_possible_error[2]) > best_err)
+									continue;
+
+								for (uint32_t i2 = i1; i2 < selector_group_ends[1][i1]; i2 = selector_group_ends[2][i2])
+								{
+									const uint64_t e2 = e1 + row_errors[2][(selector_keys[i2] >> 8) & 0xFF];
+									if ((e2 + min_possible_error[3]) > best_err)
+										continue;
 
-						} // block_index
+									for (uint32_t i3 = i2; i3 < selector_group_ends[2][i2]; i3++)
+									{
+										const uint64_t e3 = e2 + row_errors[3][selector_keys[i3] & 0xFF];
+										if ((e3 < best_err) || ((e3 == best_err) && (selector_key_indices[i3] < best_index)))
+										{
+											best_err = e3;
+											best_index = selector_key_indices[i3];
+										}
+									}
+								}
+							}
+						}
 
 						m_block_selector_cluster_index[block_index] = best_index;
 					}
@@ -528,6 +783,9 @@ namespace basisu
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (is_stopped())
+				return false;
+
 			m_encoded_blocks.resize(m_total_blocks);
 			for (uint32_t block_index = 0; block_index < m_total_blocks; block_index++)
 			{
@@ -555,6 +813,8 @@ namespace basisu
 	{
 		debug_printf("introduce_special_selector_clusters\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::introduce_special_selector_clusters");
+
 		uint32_t total_blocks_relocated = 0;
 		const uint32_t initial_selector_clusters = m_selector_cluster_block_indices.size_u32();
 
@@ -658,6 +918,8 @@ namespace basisu
 	{
 		debug_printf("optimize_selector_codebook\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::optimize_selector_codebook");
+
 		const uint32_t orig_total_selector_clusters = m_optimized_cluster_selectors.size_u32();
 
 		bool_vec selector_cluster_was_used(m_optimized_cluster_selectors.size());
@@ -734,6 +996,8 @@ namespace basisu
 	{
 		debug_printf("basisu_frontend::init_etc1_images\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::init_etc1_images");
+
 		interval_timer tm;
 		tm.start();
 				
@@ -771,6 +1035,8 @@ namespace basisu
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 				m_params.m_pJob_pool->add_job([this, first_index, last_index] {
+					if (is_stopped())
+						return;
 
 					for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 					{
@@ -811,12 +1077,17 @@ namespace basisu
 								blk.set_selector(x, y, selectors[x + y * 4]);
 					}
 
+					update_progress(last_index - first_index);
+
 					});
 
 			}
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (is_stopped())
+				return;
+
 		} // use_cpu
 		 
 		debug_printf("init_etc1_images: Elapsed time: %3.3f secs\n", tm.get_elapsed_secs());
@@ -826,6 +1097,8 @@ namespace basisu
 	{
 		debug_printf("init_endpoint_training_vectors\n");
 								
+		BASISU_TRACE_ZONE("basisu_frontend::init_endpoint_training_vectors");
+
 		vec6F_quantizer::array_of_weighted_training_vecs &training_vecs = m_endpoint_clusterizer.get_training_vecs();
 		
 		training_vecs.resize(m_total_blocks * 2);
@@ -837,6 +1110,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 			m_params.m_pJob_pool->add_job( [this, first_index, last_index, &training_vecs] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 				{			
@@ -863,12 +1138,18 @@ namespace basisu
 		} // block_index_iter
 
 		m_params.m_pJob_pool->wait_for_all();
+
+		if (is_stopped())
+			return;
+
 	}
 
 	void basisu_frontend::generate_endpoint_clusters()
 	{
 		debug_printf("Begin endpoint quantization\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::generate_endpoint_clusters");
+
 		const uint32_t parent_codebook_size = (m_params.m_max_endpoint_clusters >= 256) ? BASISU_ENDPOINT_PARENT_CODEBOOK_SIZE : 0;
 		uint32_t max_threads = 0;
 		max_threads = m_params.m_multithreaded ? minimum<int>(get_num_hardware_threads(), cMaxCodebookCreationThreads) : 0;
@@ -947,6 +1228,8 @@ namespace basisu
 	// Iterate through each array of endpoint cluster block indices and set the m_block_endpoint_clusters_indices[][] array to indicaste which cluster index each block uses.
 	void basisu_frontend::generate_block_endpoint_clusters()
 	{
+		BASISU_TRACE_ZONE("basisu_frontend::generate_block_endpoint_clusters");
+
 		m_block_endpoint_clusters_indices.resize(m_total_blocks);
 
 		for (int cluster_index = 0; cluster_index < static_cast<int>(m_endpoint_clusters.size()); cluster_index++)
@@ -1014,6 +1297,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>(m_endpoint_clusters.size_u32(), cluster_index_iter + N);   
 
 			m_params.m_pJob_pool->add_job( [this, first_index, last_index] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t cluster_index = first_index; cluster_index < last_index; cluster_index++)
 				{
@@ -1087,6 +1372,9 @@ namespace basisu
 
 		m_params.m_pJob_pool->wait_for_all();
 
+		if (is_stopped())
+			return;
+
 		vector_sort(m_subblock_endpoint_quant_err_vec);
 	}
 		
@@ -1094,6 +1382,8 @@ namespace basisu
 	{
 		debug_printf("introduce_new_endpoint_clusters\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::introduce_new_endpoint_clusters");
+
 		generate_block_endpoint_clusters();
 
 		int num_new_endpoint_clusters = m_params.m_max_endpoint_clusters - m_endpoint_clusters.size_u32();
@@ -1215,6 +1505,8 @@ namespace basisu
 	{
 		debug_printf("generate_endpoint_codebook\n");
 		
+		BASISU_TRACE_ZONE_ARG("basisu_frontend::generate_endpoint_codebook", step);
+
 		interval_timer tm;
 		tm.start();
 
@@ -1488,6 +1780,8 @@ namespace basisu
 				const uint32_t last_index = minimum<uint32_t>((uint32_t)m_endpoint_clusters.size(), cluster_index_iter + N);
 
 				m_params.m_pJob_pool->add_job([this, first_index, last_index, step] {
+					if (is_stopped())
+						return;
 
 					for (uint32_t cluster_index = first_index; cluster_index < last_index; cluster_index++)
 					{
@@ -1611,6 +1905,10 @@ namespace basisu
 			} // cluster_index_iter
 
 			m_params.m_pJob_pool->wait_for_all();
+
+			if (is_stopped())
+				return;
+
 		}
 
 		debug_printf("Elapsed time: %3.3f secs\n", tm.get_elapsed_secs());
@@ -1649,6 +1947,8 @@ namespace basisu
 	{
 		debug_printf("refine_endpoint_clusterization\n");
 		
+		BASISU_TRACE_ZONE("basisu_frontend::refine_endpoint_clusterization");
+
 		if (m_use_hierarchical_endpoint_codebooks)
 			compute_endpoint_clusters_within_each_parent_cluster();
 
@@ -1778,6 +2078,8 @@ namespace basisu
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 				m_params.m_pJob_pool->add_job([this, first_index, last_index, &best_cluster_indices, &block_clusters] {
+					if (is_stopped())
+						return;
 
 					for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 					{
@@ -1858,7 +2160,12 @@ namespace basisu
 								else
 								{
 #if BASISU_SUPPORT_SSE
-									find_lowest_error_perceptual_rgb_4_N_sse41((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
+#if BASISU_SUPPORT_AVX2
+									if (g_cpu_supports_avx2)
+										find_lowest_error_perceptual_rgb_4_N_avx2((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
+									else
+#endif
+										find_lowest_error_perceptual_rgb_4_N_sse41((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
 #endif
 								}
 							}
@@ -1886,7 +2193,12 @@ namespace basisu
 								else
 								{
 #if BASISU_SUPPORT_SSE
-									find_lowest_error_linear_rgb_4_N_sse41((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
+#if BASISU_SUPPORT_AVX2
+									if (g_cpu_supports_avx2)
+										find_lowest_error_linear_rgb_4_N_avx2((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
+									else
+#endif
+										find_lowest_error_linear_rgb_4_N_sse41((int64_t*)&total_err, subblock_colors, pSubblock_pixels, num_subblock_pixels, best_cluster_err);
 #endif
 								}
 							}
@@ -1913,6 +2225,9 @@ namespace basisu
 			} // block_index_iter
 
 			m_params.m_pJob_pool->wait_for_all();
+
+			if (is_stopped())
+				return 0;
 		
 		} // use_cpu
 						
@@ -1948,6 +2263,8 @@ namespace basisu
 	{
 		debug_printf("eliminate_redundant_or_empty_endpoint_clusters\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::eliminate_redundant_or_empty_endpoint_clusters");
+
 		// Step 1: Sort endpoint clusters by the base colors/intens
 
 		uint_vec sorted_endpoint_cluster_indices(m_endpoint_clusters.size());
@@ -2015,6 +2332,8 @@ namespace basisu
 	{
 		debug_printf("create_initial_packed_texture\n");
 		
+		BASISU_TRACE_ZONE("basisu_frontend::create_initial_packed_texture");
+
 		interval_timer tm;
 		tm.start();
 
@@ -2058,6 +2377,8 @@ namespace basisu
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 				m_params.m_pJob_pool->add_job([this, first_index, last_index] {
+					if (is_stopped())
+						return;
 
 					for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 					{
@@ -2088,6 +2409,9 @@ namespace basisu
 
 			m_params.m_pJob_pool->wait_for_all();
 
+			if (is_stopped())
+				return;
+
 		} // use_cpu
 				
 		m_orig_encoded_blocks = m_encoded_blocks;
@@ -2141,6 +2465,8 @@ namespace basisu
 	{
 		debug_printf("generate_selector_clusters\n");
 				
+		BASISU_TRACE_ZONE("basisu_frontend::generate_selector_clusters");
+
 		typedef tree_vector_quant<vec16F> vec16F_clusterizer;
 				
 		vec16F_clusterizer::array_of_weighted_training_vecs training_vecs(m_total_blocks);
@@ -2152,6 +2478,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 			m_params.m_pJob_pool->add_job( [this, first_index, last_index, &training_vecs] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 				{
@@ -2184,6 +2512,9 @@ namespace basisu
 
 		m_params.m_pJob_pool->wait_for_all();
 
+		if (is_stopped())
+			return;
+
 		vec16F_clusterizer selector_clusterizer;
 		for (uint32_t i = 0; i < m_total_blocks; i++)
 			selector_clusterizer.add_training_vec(training_vecs[i].first, training_vecs[i].second);
@@ -2260,6 +2591,8 @@ namespace basisu
 	{
 		debug_printf("create_optimized_selector_codebook\n");
 
+		BASISU_TRACE_ZONE_ARG("basisu_frontend::create_optimized_selector_codebook", iter);
+
 		interval_timer tm;
 		tm.start();
 
@@ -2277,6 +2610,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>((uint32_t)total_selector_clusters, cluster_index_iter + N);
 
 			m_params.m_pJob_pool->add_job([this, first_index, last_index] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t cluster_index = first_index; cluster_index < last_index; cluster_index++)
 				{
@@ -2351,6 +2686,9 @@ namespace basisu
 
 		m_params.m_pJob_pool->wait_for_all();
 
+		if (is_stopped())
+			return;
+
 		debug_printf("Elapsed time: %3.3f secs\n", tm.get_elapsed_secs());
 				
 		if (m_params.m_debug_images)
@@ -2398,6 +2736,8 @@ namespace basisu
 	{
 		debug_printf("find_optimal_selector_clusters_for_each_block\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::find_optimal_selector_clusters_for_each_block");
+
 		interval_timer tm;
 		tm.start();
 		
@@ -2551,6 +2891,8 @@ namespace basisu
 				const uint32_t last_index = minimum<uint32_t>(m_total_blocks, first_index + N);
 
 				m_params.m_pJob_pool->add_job( [this, first_index, last_index, &unpacked_optimized_cluster_selectors] {
+				if (is_stopped())
+					return;
 	
 				int prev_best_cluster_index = 0;
 
@@ -2694,6 +3036,9 @@ namespace basisu
 			} // block_index_iter
 
 			m_params.m_pJob_pool->wait_for_all();
+
+			if (is_stopped())
+				return;
 						
 			for (uint32_t i = 0; i < m_selector_cluster_block_indices.size(); i++)
 			{
@@ -2719,6 +3064,8 @@ namespace basisu
 	{
 		debug_printf("refine_block_endpoints_given_selectors\n");
 				
+		BASISU_TRACE_ZONE("basisu_frontend::refine_block_endpoints_given_selectors");
+
 		for (int block_index = 0; block_index < static_cast<int>(m_total_blocks); block_index++)
 		{
 			//uint32_t selector_cluster = m_block_selector_cluster_index(block_x, block_y);
@@ -2979,6 +3326,8 @@ namespace basisu
 
 	void basisu_frontend::finalize()
 	{
+		BASISU_TRACE_ZONE("basisu_frontend::finalize");
+
 		for (uint32_t block_index = 0; block_index < m_total_blocks; block_index++)
 		{
 			for (uint32_t subblock_index = 0; subblock_index < 2; subblock_index++)
@@ -2988,6 +3337,9 @@ namespace basisu
 				m_endpoint_cluster_etc_params[endpoint_cluster_index].m_color_used[0] = true;
 			}
 		}
+
+		BASISU_TRACE_COUNTER("etc1s_endpoint_clusters", m_endpoint_clusters.size());
+		BASISU_TRACE_COUNTER("etc1s_selector_clusters", m_optimized_cluster_selectors.size());
 	}
 
 	// The backend has remapped the block endpoints while optimizing the output symbols for better rate distortion performance, so let's go and reoptimize the endpoint codebook.
@@ -2997,6 +3349,8 @@ namespace basisu
 	{
 		debug_printf("reoptimize_remapped_endpoints\n");
 
+		BASISU_TRACE_ZONE("basisu_frontend::reoptimize_remapped_endpoints");
+
 		basisu::vector<uint_vec> new_endpoint_cluster_block_indices(m_endpoint_clusters.size());
 		for (uint32_t i = 0; i < new_block_endpoints.size(); i++)
 			new_endpoint_cluster_block_indices[new_block_endpoints[i]].push_back(i);
@@ -3011,6 +3365,8 @@ namespace basisu
 			const uint32_t last_index = minimum<uint32_t>((uint32_t)new_endpoint_cluster_block_indices.size(), cluster_index_iter + N);   
 
 			m_params.m_pJob_pool->add_job( [this, first_index, last_index, &cluster_improved, &cluster_valid, &new_endpoint_cluster_block_indices, &pBlock_selector_indices ] {
+				if (is_stopped())
+					return;
 
 				for (uint32_t cluster_index = first_index; cluster_index < last_index; cluster_index++)
 				{
@@ -3105,6 +3461,9 @@ namespace basisu
 		} // cluster_index_iter
 
 		m_params.m_pJob_pool->wait_for_all();
+
+		if (is_stopped())
+			return;
 				
 		uint32_t total_unused_clusters = 0;
 		uint32_t total_improved_clusters = 0;
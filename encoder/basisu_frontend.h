@@ -82,9 +82,11 @@ namespace basisu
 				m_validate(false),
 				m_multithreaded(false),
 				m_disable_hierarchical_endpoint_codebooks(false),
+				m_fast_global_codebook_search(false),
 				m_tex_type(basist::cBASISTexType2D),
 				m_pOpenCL_context(nullptr),
-				m_pJob_pool(nullptr)
+				m_pJob_pool(nullptr),
+				m_pProgress(nullptr)
 			{
 			}
 
@@ -103,6 +105,7 @@ namespace basisu
 			bool m_validate;
 			bool m_multithreaded;
 			bool m_disable_hierarchical_endpoint_codebooks;
+			bool m_fast_global_codebook_search;
 			
 			basist::basis_texture_type m_tex_type;
 			const basist::basisu_lowlevel_etc1s_transcoder *m_pGlobal_codebooks;
@@ -110,6 +113,9 @@ namespace basisu
 			opencl_context_ptr m_pOpenCL_context;
 			
 			job_pool *m_pJob_pool;
+
+			// Optional, receives progress updates and is polled for cancellation/deadline expiry.
+			encode_progress *m_pProgress;
 		};
 
 		bool init(const params &p);
@@ -155,8 +161,16 @@ namespace basisu
 
 		bool get_opencl_failed() const { return m_opencl_failed; }
 
+		bool is_stopped() const { return m_params.m_pProgress && m_params.m_pProgress->is_stopped(); }
+
+		// Reports progress in the current stage, returns false if the encode has been stopped.
+		bool update_progress(uint64_t num_units = 0) { return !m_params.m_pProgress || m_params.m_pProgress->update(num_units); }
+
 	private:
 		params m_params;
+
+		void begin_progress_stage(float start_frac, float end_frac, uint64_t total_units) { if (m_params.m_pProgress) m_params.m_pProgress->begin_stage(start_frac, end_frac, total_units); }
+
 		uint32_t m_total_blocks;
 		uint32_t m_total_pixels;
 
@@ -2804,6 +2804,40 @@ namespace basisu
 		return true;
 	}
 
+	bool open_mapped_ktx2_file(const char* pFilename, memory_mapped_file& file, basist::ktx2_transcoder& transcoder)
+	{
+		if (!file.open(pFilename))
+			return false;
+
+		if (file.get_size() > UINT32_MAX)
+		{
+			file.close();
+			return false;
+		}
+
+		file.advise(memory_mapped_file::cHintRandom);
+
+		if (!transcoder.init(file.get_ptr(), (uint32_t)file.get_size()))
+		{
+			file.close();
+			return false;
+		}
+
+		return true;
+	}
+
+	bool advise_mapped_ktx2_level(memory_mapped_file& file, const basist::ktx2_transcoder& transcoder, uint32_t level_index, memory_mapped_file::access_hint hint)
+	{
+		if ((!file.is_open()) || (transcoder.get_data() != file.get_ptr()) || (level_index >= transcoder.get_levels()))
+			return false;
+
+		// init() has already validated the level's byte range against the file's size.
+		const basist::ktx2_level_index& level = transcoder.get_level_index()[level_index];
+		file.advise(level.m_byte_offset.get_uint64(), level.m_byte_length.get_uint64(), hint);
+
+		return true;
+	}
+
 	// Returns a friendly name for the common DDS formats we care about (BC1-7 and
 	// the usual LDR/HDR uncompressed variants); returns nullptr for anything else so
 	// the caller can fall back to printing the raw hex value. For --tinydds_info.
@@ -195,6 +195,18 @@ namespace basisu
 	// on any error.
 	bool transcode_ktx2_to_ktx(basist::ktx2_transcoder& transcoder, basist::transcoder_texture_format fmt, uint8_vec& ktx_data, int srgb_mode = -1, uint32_t decode_flags = 0);
 
+	// Memory maps a KTX2 file and init()'s transcoder directly on the mapping, without copying the file. Only the
+	// header, level index, DFD and key/value data are read here: each level's bytes are paged in by
+	// transcode_image_level() when it's transcoded (ETC1S files also read their global codebooks in start_transcoding()).
+	// Read ahead is disabled (cHintRandom), see advise_mapped_ktx2_level(). file must outlive transcoder.
+	// Files must be smaller than 4GB, the transcoder's limit.
+	bool open_mapped_ktx2_file(const char* pFilename, memory_mapped_file& file, basist::ktx2_transcoder& transcoder);
+
+	// Applies a page cache hint to the bytes of one mipmap level (all of its layers and faces) of a file opened by
+	// open_mapped_ktx2_file(). For example cHintWillNeed before transcoding the level (starts reading it in the
+	// background), then cHintDontNeed once the level has been transcoded.
+	bool advise_mapped_ktx2_level(memory_mapped_file& file, const basist::ktx2_transcoder& transcoder, uint32_t level_index, memory_mapped_file::access_hint hint);
+
 	// Currently reads 2D 32bpp RGBA, 16-bit HALF RGBA, or 32-bit FLOAT RGBA, with or without mipmaps. No tex arrays or cubemaps, yet.
 	bool read_uncompressed_dds_file(const char* pFilename, basisu::vector<image>& ldr_mips, basisu::vector<imagef>& hdr_mips);
 
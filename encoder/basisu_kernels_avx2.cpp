@@ -0,0 +1,39 @@
+// basisu_kernels_avx2.cpp
+// Copyright (C) 2019-2025 Binomial LLC. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// 8-wide AVX2 versions of the kernels in basisu_kernels_imp.h. This file must be compiled with AVX2 and FMA enabled
+// (-mavx2 -mfma, or /arch:AVX2), and is only called into when g_cpu_supports_avx2 is true (see detect_sse41()).
+#include "basisu_enc.h"
+
+#if BASISU_SUPPORT_AVX2
+
+#if !defined(__AVX2__)
+#error basisu_kernels_avx2.cpp must be compiled with AVX2 enabled (-mavx2 -mfma, or /arch:AVX2)
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include "cppspmd_avx2.h"
+
+#include "cppspmd_type_aliases.h"
+
+using namespace basisu;
+
+#include "basisu_kernels_declares.h"
+#include "basisu_kernels_imp.h"
+
+#endif // #if BASISU_SUPPORT_AVX2
@@ -24,4 +24,7 @@ void CPPSPMD_NAME(find_lowest_error_perceptual_rgb_4_N)(int64_t* pDistance, cons
 void CPPSPMD_NAME(find_lowest_error_linear_rgb_4_N)(int64_t* pDistance, const basisu::color_rgba* pBlock_colors, const basisu::color_rgba* pSrc_pixels, uint32_t n, int64_t early_out_error);
 
 void CPPSPMD_NAME(update_covar_matrix_16x16)(uint32_t num_vecs, const void* pWeighted_vecs, const void *pOrigin, const uint32_t* pVec_indices, void *pMatrix16x16);
+
+void CPPSPMD_NAME(tsvq_split_side)(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pOrigin, const float* pAxis, uint8_t* pFlags);
+void CPPSPMD_NAME(tsvq_nearest_child)(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pL, const float* pR, uint8_t* pFlags);
 #endif
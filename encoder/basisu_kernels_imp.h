@@ -17,11 +17,61 @@ using namespace CPPSPMD;
 
 namespace CPPSPMD_NAME(basisu_kernels_namespace)
 {
+#if CPPSPMD_AVX2
+    static inline int64_t reduce_add64(const vint &x)
+    {
+        __m256i s = _mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(x.m_value)), _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x.m_value, 1)));
+        __m128i t = _mm_add_epi64(_mm256_castsi256_si128(s), _mm256_extracti128_si256(s, 1));
+
+        CPPSPMD_ALIGN(16) int64_t sums[2];
+        _mm_store_si128((__m128i*)sums, t);
+        return sums[0] + sums[1];
+    }
+
+    // Splits 8 packed RGBA pixels into R, G and B lanes.
+    static inline void split_rgb(const __m256i& c, vint& r, vint& g, vint& b)
+    {
+        const __m256i m = _mm256_set1_epi32(0xFF);
+        r.m_value = _mm256_and_si256(c, m);
+        g.m_value = _mm256_and_si256(_mm256_srli_epi32(c, 8), m);
+        b.m_value = _mm256_and_si256(_mm256_srli_epi32(c, 16), m);
+    }
+
+    static inline void load_rgb(const color_rgba* pPixels, vint& r, vint& g, vint& b)
+    {
+        split_rgb(_mm256_loadu_si256((const __m256i*)pPixels), r, g, b);
+    }
+
+    // Writes the low byte of each lane of sels to pDst[0..7].
+    static inline void store_selectors(uint8_t* pDst, const vint& sels)
+    {
+        const __m256i shuf = broadcast_si128(_mm_set_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 12, 8, 4, 0));
+        __m256i t = _mm256_permutevar8x32_epi32(shuffle_epi8(sels.m_value, shuf), _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+        _mm_storel_epi64((__m128i*)pDst, _mm256_castsi256_si128(t));
+    }
+#else
     static inline int64_t reduce_add64(const vint &x)
     {
         return (int64_t)VINT_EXTRACT(x, 0) + (int64_t)VINT_EXTRACT(x, 1) +
             (int64_t)VINT_EXTRACT(x, 2) + (int64_t)VINT_EXTRACT(x, 3);
     }
+
+    static inline void load_rgb(const color_rgba* pPixels, vint& r, vint& g, vint& b)
+    {
+        __m128i c0 = load_rgba32(&pPixels[0]), c1 = load_rgba32(&pPixels[1]), c2 = load_rgba32(&pPixels[2]), c3 = load_rgba32(&pPixels[3]);
+
+        vint a;
+        transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
+    }
+
+    static inline void store_selectors(uint8_t* pDst, const vint& sels)
+    {
+        const __m128i shuf = _mm_set_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 12, 8, 4, 0);
+        __m128i vsels = shuffle_epi8(sels.m_value, shuf);
+        storeu_si32((void *)pDst, vsels);
+    }
+#endif
+
    struct perceptual_distance_rgb_4_N : spmd_kernel
    {
       void _call(int64_t* pDistance,
@@ -34,24 +84,34 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
          *pDistance = 0;
 
+#if CPPSPMD_AVX2
+         // The 4 block colors in lanes 0-3, for _mm256_permutevar8x32_epi32().
+         const __m256i block_colors = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pBlock_colors));
+#else
          __m128i block_colors[4];
+#endif
          vint block_colors_r[4], block_colors_g[4], block_colors_b[4];
          for (uint32_t i = 0; i < 4; i++)
          {
+#if !CPPSPMD_AVX2
             block_colors[i] = load_rgba32(&pBlock_colors[i]);
+#endif
             store_all(block_colors_r[i], (int)pBlock_colors[i].r);
             store_all(block_colors_g[i], (int)pBlock_colors[i].g);
             store_all(block_colors_b[i], (int)pBlock_colors[i].b);
          }
 
          uint32_t i;
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
-
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
+
+#if CPPSPMD_AVX2
+            vint base_r, base_g, base_b;
+            const __m256i sels = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pSelectors + i)));
+            split_rgb(_mm256_permutevar8x32_epi32(block_colors, sels), base_r, base_g, base_b);
+#else
             int s0 = pSelectors[i], s1 = pSelectors[i + 1], s2 = pSelectors[i + 2], s3 = pSelectors[i + 3];
 
             vint base_r, base_g, base_b, base_a;
@@ -66,6 +126,7 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
                __m128i k0 = block_colors[s0], k1 = block_colors[s1], k2 = block_colors[s2], k3 = block_colors[s3];
                transpose4x4(base_r.m_value, base_g.m_value, base_b.m_value, base_a.m_value, k0, k1, k2, k3);
             }
+#endif
 
             vint dr = base_r - r;
             vint dg = base_g - g;
@@ -122,24 +183,34 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
          *pDistance = 0;
 
+#if CPPSPMD_AVX2
+         // The 4 block colors in lanes 0-3, for _mm256_permutevar8x32_epi32().
+         const __m256i block_colors = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)pBlock_colors));
+#else
          __m128i block_colors[4];
+#endif
          vint block_colors_r[4], block_colors_g[4], block_colors_b[4];
          for (uint32_t i = 0; i < 4; i++)
          {
+#if !CPPSPMD_AVX2
             block_colors[i] = load_rgba32(&pBlock_colors[i]);
+#endif
             store_all(block_colors_r[i], (int)pBlock_colors[i].r);
             store_all(block_colors_g[i], (int)pBlock_colors[i].g);
             store_all(block_colors_b[i], (int)pBlock_colors[i].b);
          }
 
          uint32_t i;
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
-
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
+
+#if CPPSPMD_AVX2
+            vint base_r, base_g, base_b;
+            const __m256i sels = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(pSelectors + i)));
+            split_rgb(_mm256_permutevar8x32_epi32(block_colors, sels), base_r, base_g, base_b);
+#else
             int s0 = pSelectors[i], s1 = pSelectors[i + 1], s2 = pSelectors[i + 2], s3 = pSelectors[i + 3];
 
             vint base_r, base_g, base_b, base_a;
@@ -154,6 +225,7 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
                __m128i k0 = block_colors[s0], k1 = block_colors[s1], k2 = block_colors[s2], k3 = block_colors[s3];
                transpose4x4(base_r.m_value, base_g.m_value, base_b.m_value, base_a.m_value, k0, k1, k2, k3);
             }
+#endif
 
             vint dr = base_r - r;
             vint dg = base_g - g;
@@ -225,16 +297,12 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
             store_all(block_colors_b[i], (int)pBlock_colors[i].b);
          }
 
-         const __m128i shuf = _mm_set_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 12, 8, 4, 0);
-
          uint32_t i;
 
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
 
             vint dist0 = compute_dist(block_colors_r[0], block_colors_g[0], block_colors_b[0], r, g, b);
             vint dist1 = compute_dist(block_colors_r[1], block_colors_g[1], block_colors_b[1], r, g, b);
@@ -245,8 +313,7 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
             vint sels = spmd_ternaryi(min_dist == dist0, 0, spmd_ternaryi(min_dist == dist1, 1, spmd_ternaryi(min_dist == dist2, 2, 3)));
 
-            __m128i vsels = shuffle_epi8(sels.m_value, shuf);
-            storeu_si32((void *)(pSelectors + i), vsels);
+            store_selectors(pSelectors + i, sels);
 
             *pDistance += reduce_add64(min_dist);
             if (*pDistance >= early_out_err)
@@ -321,16 +388,12 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
             store_all(block_colors_b[i], (int)pBlock_colors[i].b);
          }
 
-         const __m128i shuf = _mm_set_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 12, 8, 4, 0);
-
          uint32_t i;
 
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
 
             vint dist0 = compute_dist(block_colors_r[0], block_colors_g[0], block_colors_b[0], r, g, b);
             vint dist1 = compute_dist(block_colors_r[1], block_colors_g[1], block_colors_b[1], r, g, b);
@@ -341,8 +404,7 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
             vint sels = spmd_ternaryi(min_dist == dist0, 0, spmd_ternaryi(min_dist == dist1, 1, spmd_ternaryi(min_dist == dist2, 2, 3)));
 
-            __m128i vsels = shuffle_epi8(sels.m_value, shuf);
-            storeu_si32((void *)(pSelectors + i), vsels);
+            store_selectors(pSelectors + i, sels);
 
             *pDistance += reduce_add64(min_dist);
             if (*pDistance >= early_out_err)
@@ -419,12 +481,10 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
          uint32_t i;
 
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
 
             vint dist0 = compute_dist(block_colors_r[0], block_colors_g[0], block_colors_b[0], r, g, b);
             vint dist1 = compute_dist(block_colors_r[1], block_colors_g[1], block_colors_b[1], r, g, b);
@@ -506,12 +566,10 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
 
          uint32_t i;
 
-         for (i = 0; (i + 4) <= n; i += 4)
+         for (i = 0; (i + PROGRAM_COUNT) <= n; i += PROGRAM_COUNT)
          {
-            __m128i c0 = load_rgba32(&pSrc_pixels[i + 0]), c1 = load_rgba32(&pSrc_pixels[i + 1]), c2 = load_rgba32(&pSrc_pixels[i + 2]), c3 = load_rgba32(&pSrc_pixels[i + 3]);
-
-            vint r, g, b, a;
-            transpose4x4(r.m_value, g.m_value, b.m_value, a.m_value, c0, c1, c2, c3);
+            vint r, g, b;
+            load_rgb(&pSrc_pixels[i], r, g, b);
 
             vint dist0 = compute_dist(block_colors_r[0], block_colors_g[0], block_colors_b[0], r, g, b);
             vint dist1 = compute_dist(block_colors_r[1], block_colors_g[1], block_colors_b[1], r, g, b);
@@ -561,18 +619,19 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
          const std::pair<vec16F, uint64_t>* pWeighted_vecs = static_cast< const std::pair<vec16F, uint64_t> *>(pWeighted_vecs_void);
 
          const float* pOrigin = static_cast<const float*>(pOrigin_void);
-         vfloat org0 = loadu_linear_all(pOrigin), org1 = loadu_linear_all(pOrigin + 4), org2 = loadu_linear_all(pOrigin + 8), org3 = loadu_linear_all(pOrigin + 12);
+         // Each 16 float row of the matrix is held in cRow_vecs vectors.
+         const uint32_t cRow_vecs = 16 / PROGRAM_COUNT;
 
-         vfloat mat[16][4];
+         vfloat org[cRow_vecs];
+         for (uint32_t c = 0; c < cRow_vecs; c++)
+            store_all(org[c], loadu_linear_all(pOrigin + c * PROGRAM_COUNT));
+
+         vfloat mat[16][cRow_vecs];
          vfloat vzero(zero_vfloat());
 
          for (uint32_t i = 0; i < 16; i++)
-         {
-            store_all(mat[i][0], vzero);
-            store_all(mat[i][1], vzero);
-            store_all(mat[i][2], vzero);
-            store_all(mat[i][3], vzero);
-         }
+            for (uint32_t c = 0; c < cRow_vecs; c++)
+               store_all(mat[i][c], vzero);
 
          for (uint32_t k = 0; k < num_vecs; k++)
          {
@@ -581,18 +640,19 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
             const float* pW = pWeighted_vecs[vec_index].first.get_ptr();
             vfloat weight((float)pWeighted_vecs[vec_index].second);
 
-            vfloat vec[4] = { loadu_linear_all(pW) - org0, loadu_linear_all(pW + 4) - org1, loadu_linear_all(pW + 8) - org2, loadu_linear_all(pW + 12) - org3 };
-
-            vfloat wvec0 = vec[0] * weight, wvec1 = vec[1] * weight, wvec2 = vec[2] * weight, wvec3 = vec[3] * weight;
+            vfloat vec[cRow_vecs], wvec[cRow_vecs];
+            for (uint32_t c = 0; c < cRow_vecs; c++)
+            {
+               store_all(vec[c], loadu_linear_all(pW + c * PROGRAM_COUNT) - org[c]);
+               store_all(wvec[c], vec[c] * weight);
+            }
 
             for (uint32_t j = 0; j < 16; j++)
             {
                vfloat vx = ((const float*)vec)[j];
 
-               store_all(mat[j][0], mat[j][0] + vx * wvec0);
-               store_all(mat[j][1], mat[j][1] + vx * wvec1);
-               store_all(mat[j][2], mat[j][2] + vx * wvec2);
-               store_all(mat[j][3], mat[j][3] + vx * wvec3);
+               for (uint32_t c = 0; c < cRow_vecs; c++)
+                  store_all(mat[j][c], mat[j][c] + vx * wvec[c]);
 
             } // j
 
@@ -603,15 +663,87 @@ namespace CPPSPMD_NAME(basisu_kernels_namespace)
          float* pDst = pMatrix;
          for (uint32_t i = 0; i < 16; i++)
          {
-            storeu_linear_all(pDst, mat[i][0]);
-            storeu_linear_all(pDst + 4, mat[i][1]);
-            storeu_linear_all(pDst + 8, mat[i][2]);
-            storeu_linear_all(pDst + 12, mat[i][3]);
+            for (uint32_t c = 0; c < cRow_vecs; c++)
+               storeu_linear_all(pDst + c * PROGRAM_COUNT, mat[i][c]);
             pDst += 16;
          }
       }
    };
 
+   // The tree_vector_quant split kernels (see basisu_enc.h). pVecs holds num_vecs training vectors in structure of arrays form: element i of
+   // vector k is pVecs[i * stride + k]. stride is a multiple of 8 and the padding past num_vecs must be readable. One vector per lane, with
+   // the same float/double operations in the same order as the scalar code, so the results are identical.
+
+   // pFlags[k] = 1 if (v[k] - origin).dot(axis) >= 0, otherwise 0.
+   struct tsvq_split_side : spmd_kernel
+   {
+      void _call(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pOrigin, const float* pAxis, uint8_t* pFlags)
+      {
+         CPPSPMD_DECL(float, t_vals[PROGRAM_COUNT]);
+
+         for (uint32_t k = 0; k < num_vecs; k += PROGRAM_COUNT)
+         {
+            vfloat t = (loadu_linear_all(pVecs + k) - vfloat(pOrigin[0])) * vfloat(pAxis[0]);
+            for (uint32_t i = 1; i < num_dims; i++)
+               t = t + (loadu_linear_all(pVecs + i * stride + k) - vfloat(pOrigin[i])) * vfloat(pAxis[i]);
+
+            storeu_linear_all(t_vals, t);
+
+            const uint32_t n = minimum<uint32_t>(PROGRAM_COUNT, num_vecs - k);
+            for (uint32_t l = 0; l < n; l++)
+               pFlags[k + l] = t_vals[l] >= 0.0f;
+         }
+      }
+   };
+
+   // pFlags[k] = 1 if v[k] is at least as far from pL as from pR, otherwise 0. The squared distances are summed in double precision,
+   // like vec::squared_distance_d(). cppspmd has no double lanes, so this uses 2 (SSE) or 4 (AVX) wide intrinsics directly.
+   static void tsvq_nearest_child(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pL, const float* pR, uint8_t* pFlags)
+   {
+#if CPPSPMD_AVX2
+      const uint32_t cLanes = 4;
+#else
+      const uint32_t cLanes = 2;
+#endif
+
+      for (uint32_t k = 0; k < num_vecs; k += cLanes)
+      {
+#if CPPSPMD_AVX2
+         __m256d l_dist2 = _mm256_setzero_pd(), r_dist2 = _mm256_setzero_pd();
+
+         for (uint32_t i = 0; i < num_dims; i++)
+         {
+            const __m256d v = _mm256_cvtps_pd(_mm_loadu_ps(pVecs + i * stride + k));
+            const __m256d ld = _mm256_sub_pd(_mm256_set1_pd((double)pL[i]), v);
+            const __m256d rd = _mm256_sub_pd(_mm256_set1_pd((double)pR[i]), v);
+
+            l_dist2 = _mm256_add_pd(l_dist2, _mm256_mul_pd(ld, ld));
+            r_dist2 = _mm256_add_pd(r_dist2, _mm256_mul_pd(rd, rd));
+         }
+
+         const uint32_t mask = _mm256_movemask_pd(_mm256_cmp_pd(l_dist2, r_dist2, _CMP_GE_OQ));
+#else
+         __m128d l_dist2 = _mm_setzero_pd(), r_dist2 = _mm_setzero_pd();
+
+         for (uint32_t i = 0; i < num_dims; i++)
+         {
+            const __m128d v = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*)(pVecs + i * stride + k))));
+            const __m128d ld = _mm_sub_pd(_mm_set1_pd((double)pL[i]), v);
+            const __m128d rd = _mm_sub_pd(_mm_set1_pd((double)pR[i]), v);
+
+            l_dist2 = _mm_add_pd(l_dist2, _mm_mul_pd(ld, ld));
+            r_dist2 = _mm_add_pd(r_dist2, _mm_mul_pd(rd, rd));
+         }
+
+         const uint32_t mask = _mm_movemask_pd(_mm_cmpge_pd(l_dist2, r_dist2));
+#endif
+
+         const uint32_t n = minimum<uint32_t>(cLanes, num_vecs - k);
+         for (uint32_t l = 0; l < n; l++)
+            pFlags[k + l] = (mask >> l) & 1;
+      }
+   }
+
 } // namespace
 
 using namespace CPPSPMD_NAME(basisu_kernels_namespace);
@@ -650,3 +782,13 @@ void CPPSPMD_NAME(update_covar_matrix_16x16)(uint32_t num_vecs, const void* pWei
 {
    spmd_call < update_covar_matrix_16x16 >(num_vecs, pWeighted_vecs, pOrigin, pVec_indices, pMatrix16x16);
 }
+
+void CPPSPMD_NAME(tsvq_split_side)(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pOrigin, const float* pAxis, uint8_t* pFlags)
+{
+   spmd_call < tsvq_split_side >(num_vecs, num_dims, pVecs, stride, pOrigin, pAxis, pFlags);
+}
+
+void CPPSPMD_NAME(tsvq_nearest_child)(uint32_t num_vecs, uint32_t num_dims, const float* pVecs, uint32_t stride, const float* pL, const float* pR, uint8_t* pFlags)
+{
+   tsvq_nearest_child(num_vecs, num_dims, pVecs, stride, pL, pR, pFlags);
+}
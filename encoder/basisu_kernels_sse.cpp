@@ -48,6 +48,8 @@ struct cpu_info
 	bool m_has_sse42;
 	bool m_has_avx;
 	bool m_has_avx2;
+	bool m_has_fma;
+	bool m_has_osxsave;
 	bool m_has_pclmulqdq;
 };
 
@@ -62,6 +64,8 @@ static void extract_x86_flags(cpu_info &info, uint32_t ecx, uint32_t edx)
 	info.m_has_sse41 = (ecx & (1 << 19)) != 0;
 	info.m_has_sse42 = (ecx & (1 << 20)) != 0;
 	info.m_has_pclmulqdq = (ecx & (1 << 1)) != 0;
+	info.m_has_fma = (ecx & (1 << 12)) != 0;
+	info.m_has_osxsave = (ecx & (1 << 27)) != 0;
 	info.m_has_avx = (ecx & (1 << 28)) != 0;
 }
 
@@ -88,6 +92,20 @@ static void do_cpuid(uint32_t eax, uint32_t ecx, uint32_t* regs)
 }
 #endif
 
+#if BASISU_SUPPORT_AVX2
+// Returns the OS enabled XSAVE state components (XCR0). Only call if OSXSAVE is set.
+static uint64_t read_xcr0()
+{
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	uint32_t eax = 0, edx = 0;
+	__asm__("xgetbv;" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
 static void get_cpuinfo(cpu_info &info)
 {
 	int regs[4];
@@ -129,6 +147,13 @@ void detect_sse41()
 
 	// Check for everything from SSE to SSE 4.1
 	g_cpu_supports_sse41 = info.m_has_sse && info.m_has_sse2 && info.m_has_sse3 && info.m_has_ssse3 && info.m_has_sse41;
+
+	g_cpu_supports_avx2 = false;
+#if BASISU_SUPPORT_AVX2
+	// AVX2 and FMA, and the OS must save/restore the XMM and YMM registers (XCR0 bits 1 and 2).
+	if (g_cpu_supports_sse41 && info.m_has_avx && info.m_has_avx2 && info.m_has_fma && info.m_has_osxsave)
+		g_cpu_supports_avx2 = (read_xcr0() & 6) == 6;
+#endif
 }
 
 } // namespace basisu
@@ -0,0 +1,581 @@
+// basisu_transcode_cache.cpp
+// Copyright (C) 2019-2025 Binomial LLC. All Rights Reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "basisu_transcode_cache.h"
+
+namespace basisu
+{
+	// ---- hash64
+
+	static const uint64_t HASH64_PRIME1 = 0x9E3779B185EBCA87ULL;
+	static const uint64_t HASH64_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+	static const uint64_t HASH64_PRIME3 = 0x165667B19E3779F9ULL;
+	static const uint64_t HASH64_PRIME4 = 0x85EBCA77C2B2AE63ULL;
+	static const uint64_t HASH64_PRIME5 = 0x27D4EB2F165667C5ULL;
+
+	static inline uint64_t hash64_rotl(uint64_t x, uint32_t r) { return (x << r) | (x >> (64 - r)); }
+
+	static inline uint64_t hash64_read64(const uint8_t* p) { uint64_t v; memcpy(&v, p, sizeof(v)); return v; }
+	static inline uint32_t hash64_read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, sizeof(v)); return v; }
+
+	static inline uint64_t hash64_round(uint64_t acc, uint64_t input)
+	{
+		acc += input * HASH64_PRIME2;
+		acc = hash64_rotl(acc, 31);
+		return acc * HASH64_PRIME1;
+	}
+
+	static inline uint64_t hash64_merge_round(uint64_t acc, uint64_t val)
+	{
+		acc ^= hash64_round(0, val);
+		return acc * HASH64_PRIME1 + HASH64_PRIME4;
+	}
+
+	// Note the words are read in native byte order, so the hashes (and the cache files) are only portable between machines with the same endianness.
+	uint64_t hash64(const void* pData, size_t size, uint64_t seed)
+	{
+		const uint8_t* p = static_cast<const uint8_t*>(pData);
+		const uint8_t* pEnd = p + size;
+
+		uint64_t h;
+
+		if (size >= 32)
+		{
+			uint64_t v1 = seed + HASH64_PRIME1 + HASH64_PRIME2, v2 = seed + HASH64_PRIME2, v3 = seed, v4 = seed - HASH64_PRIME1;
+
+			const uint8_t* pLimit = pEnd - 32;
+			do
+			{
+				v1 = hash64_round(v1, hash64_read64(p));
+				v2 = hash64_round(v2, hash64_read64(p + 8));
+				v3 = hash64_round(v3, hash64_read64(p + 16));
+				v4 = hash64_round(v4, hash64_read64(p + 24));
+				p += 32;
+			} while (p <= pLimit);
+
+			h = hash64_rotl(v1, 1) + hash64_rotl(v2, 7) + hash64_rotl(v3, 12) + hash64_rotl(v4, 18);
+			h = hash64_merge_round(h, v1);
+			h = hash64_merge_round(h, v2);
+			h = hash64_merge_round(h, v3);
+			h = hash64_merge_round(h, v4);
+		}
+		else
+		{
+			h = seed + HASH64_PRIME5;
+		}
+
+		h += (uint64_t)size;
+
+		while ((p + 8) <= pEnd)
+		{
+			h ^= hash64_round(0, hash64_read64(p));
+			h = hash64_rotl(h, 27) * HASH64_PRIME1 + HASH64_PRIME4;
+			p += 8;
+		}
+
+		if ((p + 4) <= pEnd)
+		{
+			h ^= (uint64_t)hash64_read32(p) * HASH64_PRIME1;
+			h = hash64_rotl(h, 23) * HASH64_PRIME2 + HASH64_PRIME3;
+			p += 4;
+		}
+
+		while (p < pEnd)
+		{
+			h ^= (*p++) * HASH64_PRIME5;
+			h = hash64_rotl(h, 11) * HASH64_PRIME1;
+		}
+
+		h ^= h >> 33;
+		h *= HASH64_PRIME2;
+		h ^= h >> 29;
+		h *= HASH64_PRIME3;
+		h ^= h >> 32;
+
+		return h;
+	}
+
+	// ---- Cache file format
+	// transcode_cache_file_header, followed by m_total_entries transcode_cache_file_entry's, followed by the transcoded data.
+	// All fields are little endian.
+
+#pragma pack(push)
+#pragma pack(1)
+	struct transcode_cache_file_header
+	{
+		enum { cSig = 0x43544B42 /* "BKTC" */, cVersion = 1 };
+
+		basisu::packed_uint<4> m_sig;
+		basisu::packed_uint<4> m_version;
+		basisu::packed_uint<4> m_total_entries;
+		basisu::packed_uint<4> m_reserved;
+		basisu::packed_uint<8> m_lru_tick;
+		basisu::packed_uint<8> m_total_file_size;
+		basisu::packed_uint<8> m_entries_hash;		// hash64() of the entry array
+	};
+
+	struct transcode_cache_file_entry
+	{
+		basisu::packed_uint<8> m_content_hash;
+		basisu::packed_uint<4> m_level_index;
+		basisu::packed_uint<4> m_layer_index;
+		basisu::packed_uint<4> m_face_index;
+		basisu::packed_uint<4> m_fmt;
+		basisu::packed_uint<4> m_decode_flags;
+		basisu::packed_uint<4> m_channel0;
+		basisu::packed_uint<4> m_channel1;
+		basisu::packed_uint<4> m_size;
+		basisu::packed_uint<8> m_last_used;
+		basisu::packed_uint<8> m_file_ofs;
+	};
+#pragma pack(pop)
+
+	uint64_t get_ktx2_level_content_hash(const basist::ktx2_transcoder& transcoder, uint32_t level_index)
+	{
+		const uint8_t* pData = transcoder.get_data();
+		const basist::ktx2_header& hdr = transcoder.get_header();
+
+		// init() has already validated all of these ranges.
+		uint64_t h = hash64(&hdr, sizeof(hdr));
+		h = hash64(transcoder.get_level_index().data(), transcoder.get_level_index().size_in_bytes(), h);
+		h = hash64(transcoder.get_dfd().data(), transcoder.get_dfd().size(), h);
+
+		if (hdr.m_kvd_byte_length)
+			h = hash64(pData + hdr.m_kvd_byte_offset, hdr.m_kvd_byte_length, h);
+
+		if (hdr.m_sgd_byte_length.get_uint64())
+			h = hash64(pData + hdr.m_sgd_byte_offset.get_uint64(), (size_t)hdr.m_sgd_byte_length.get_uint64(), h);
+
+		const basist::ktx2_level_index& level = transcoder.get_level_index()[level_index];
+		return hash64(pData + level.m_byte_offset.get_uint64(), (size_t)level.m_byte_length.get_uint64(), h);
+	}
+
+	// ---- ktx2_transcode_cache
+
+	ktx2_transcode_cache::cache_key::operator size_t() const
+	{
+		return static_cast<size_t>(hash64(this, sizeof(*this)));
+	}
+
+	ktx2_transcode_cache::ktx2_transcode_cache() :
+		m_max_size(cDefaultMaxSize),
+		m_is_open(false),
+		m_dirty(false),
+		m_total_bytes(0),
+		m_lru_tick(0)
+	{
+		static_assert(sizeof(cache_key) == 40, "cache_key must not have any padding");
+		m_stats.clear();
+	}
+
+	ktx2_transcode_cache::~ktx2_transcode_cache()
+	{
+		close();
+	}
+
+	bool ktx2_transcode_cache::open(const char* pFilename, uint64_t max_size)
+	{
+		close();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_filename = pFilename;
+		m_max_size = max_size;
+		m_is_open = true;
+		m_dirty = false;
+		m_stats.clear();
+
+		if (!load_file())
+		{
+			// Start over with an empty cache. The bad file will be replaced on the next flush().
+			debug_printf("ktx2_transcode_cache::open: Ignoring invalid cache file \"%s\"\n", pFilename);
+
+			m_file.close();
+			m_entries.clear();
+			m_entry_map.clear();
+			m_total_bytes = 0;
+			m_lru_tick = 0;
+			m_dirty = true;
+		}
+
+		// The max size may have been lowered since the file was written.
+		evict(0);
+
+		return true;
+	}
+
+	bool ktx2_transcode_cache::load_file()
+	{
+		FILE* pFile = fopen_safe(m_filename.c_str(), "rb");
+		if (!pFile)
+			return true;
+		fclose(pFile);
+
+		if (!m_file.open(m_filename.c_str()))
+			return false;
+
+		const uint8_t* pData = m_file.get_ptr();
+		const uint64_t file_size = m_file.get_size();
+
+		if (file_size < sizeof(transcode_cache_file_header))
+			return false;
+
+		const transcode_cache_file_header& hdr = *reinterpret_cast<const transcode_cache_file_header*>(pData);
+		if ((hdr.m_sig != (uint32_t)transcode_cache_file_header::cSig) || (hdr.m_version != (uint32_t)transcode_cache_file_header::cVersion))
+			return false;
+
+		if (hdr.m_total_file_size.get_uint64() != file_size)
+			return false;
+
+		const uint32_t total_entries = hdr.m_total_entries;
+		const uint64_t data_ofs = sizeof(transcode_cache_file_header) + (uint64_t)total_entries * sizeof(transcode_cache_file_entry);
+		if (data_ofs > file_size)
+			return false;
+
+		const transcode_cache_file_entry* pEntries = reinterpret_cast<const transcode_cache_file_entry*>(pData + sizeof(transcode_cache_file_header));
+		if (hash64(pEntries, (size_t)total_entries * sizeof(transcode_cache_file_entry)) != hdr.m_entries_hash.get_uint64())
+			return false;
+
+		m_lru_tick = hdr.m_lru_tick.get_uint64();
+
+		m_entries.resize(total_entries);
+		m_entry_map.reserve(total_entries);
+
+		for (uint32_t i = 0; i < total_entries; i++)
+		{
+			const transcode_cache_file_entry& fe = pEntries[i];
+			cache_entry& e = m_entries[i];
+
+			clear_obj(e.m_key);
+			e.m_key.m_content_hash = fe.m_content_hash.get_uint64();
+			e.m_key.m_level_index = fe.m_level_index;
+			e.m_key.m_layer_index = fe.m_layer_index;
+			e.m_key.m_face_index = fe.m_face_index;
+			e.m_key.m_fmt = fe.m_fmt;
+			e.m_key.m_decode_flags = fe.m_decode_flags;
+			e.m_key.m_channel0 = (int32_t)fe.m_channel0.get_uint32();
+			e.m_key.m_channel1 = (int32_t)fe.m_channel1.get_uint32();
+
+			e.m_last_used = fe.m_last_used.get_uint64();
+			e.m_file_ofs = fe.m_file_ofs.get_uint64();
+			e.m_size = fe.m_size;
+
+			if ((e.m_file_ofs < data_ofs) || (e.m_file_ofs > file_size) || (e.m_size > (file_size - e.m_file_ofs)))
+				return false;
+
+			if (!m_entry_map.insert(e.m_key, i).second)
+				return false;
+
+			m_total_bytes += e.m_size;
+		}
+
+		// Cache hits are scattered around the file.
+		m_file.advise(memory_mapped_file::cHintRandom);
+
+		return true;
+	}
+
+	bool ktx2_transcode_cache::close()
+	{
+		bool status = true;
+
+		if (m_is_open)
+			status = flush();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_file.close();
+		m_entries.clear();
+		m_entry_map.clear();
+		m_total_bytes = 0;
+		m_lru_tick = 0;
+		m_filename.clear();
+		m_is_open = false;
+		m_dirty = false;
+
+		return status;
+	}
+
+	bool ktx2_transcode_cache::flush()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if ((!m_is_open) || (!m_dirty))
+			return true;
+
+		const uint32_t total_entries = m_entries.size_u32();
+		const uint64_t data_ofs = sizeof(transcode_cache_file_header) + (uint64_t)total_entries * sizeof(transcode_cache_file_entry);
+		const uint64_t total_file_size = data_ofs + m_total_bytes;
+
+		if (total_file_size > SIZE_MAX)
+			return false;
+
+		// The new file is built in memory, because on some platforms the old file can't be replaced while it's still mapped.
+		uint8_vec buf;
+		if (!buf.try_resize((size_t)total_file_size))
+			return false;
+
+		transcode_cache_file_entry* pEntries = reinterpret_cast<transcode_cache_file_entry*>(buf.data() + sizeof(transcode_cache_file_header));
+
+		uint64_t cur_ofs = data_ofs;
+		for (uint32_t i = 0; i < total_entries; i++)
+		{
+			const cache_entry& e = m_entries[i];
+			transcode_cache_file_entry& fe = pEntries[i];
+
+			fe.m_content_hash = e.m_key.m_content_hash;
+			fe.m_level_index = e.m_key.m_level_index;
+			fe.m_layer_index = e.m_key.m_layer_index;
+			fe.m_face_index = e.m_key.m_face_index;
+			fe.m_fmt = e.m_key.m_fmt;
+			fe.m_decode_flags = e.m_key.m_decode_flags;
+			fe.m_channel0 = (uint32_t)e.m_key.m_channel0;
+			fe.m_channel1 = (uint32_t)e.m_key.m_channel1;
+			fe.m_size = e.m_size;
+			fe.m_last_used = e.m_last_used;
+			fe.m_file_ofs = cur_ofs;
+
+			if (e.m_size)
+				memcpy(buf.data() + cur_ofs, get_entry_data(e), e.m_size);
+
+			cur_ofs += e.m_size;
+		}
+
+		assert(cur_ofs == total_file_size);
+
+		transcode_cache_file_header& hdr = *reinterpret_cast<transcode_cache_file_header*>(buf.data());
+		hdr.m_sig = (uint32_t)transcode_cache_file_header::cSig;
+		hdr.m_version = (uint32_t)transcode_cache_file_header::cVersion;
+		hdr.m_total_entries = total_entries;
+		hdr.m_reserved = 0;
+		hdr.m_lru_tick = m_lru_tick;
+		hdr.m_total_file_size = total_file_size;
+		hdr.m_entries_hash = hash64(pEntries, (size_t)total_entries * sizeof(transcode_cache_file_entry));
+
+		m_file.close();
+
+		const bool write_status = write_data_to_file_atomic(m_filename.c_str(), buf.data(), buf.size());
+
+		// Switch the entries over to the new file. If the write or the remap failed, keep serving hits out of buf instead.
+		const bool remapped = write_status && m_file.open(m_filename.c_str()) && (m_file.get_size() == total_file_size);
+		if (remapped)
+			m_file.advise(memory_mapped_file::cHintRandom);
+		else
+			m_file.close();
+
+		for (uint32_t i = 0; i < total_entries; i++)
+		{
+			cache_entry& e = m_entries[i];
+			e.m_file_ofs = pEntries[i].m_file_ofs.get_uint64();
+
+			if (remapped)
+				e.m_data.clear();
+			else if (e.m_size)
+				e.m_data.assign(buf.data() + e.m_file_ofs, buf.data() + e.m_file_ofs + e.m_size);
+		}
+
+		if (!write_status)
+		{
+			error_printf("ktx2_transcode_cache::flush: Failed writing cache file \"%s\"\n", m_filename.c_str());
+			return false;
+		}
+
+		m_dirty = false;
+		return true;
+	}
+
+	void ktx2_transcode_cache::clear_entries()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		for (uint32_t i = 0; i < m_entries.size(); i++)
+		{
+			m_stats.m_evictions++;
+			m_stats.m_bytes_evicted += m_entries[i].m_size;
+		}
+
+		m_entries.clear();
+		m_entry_map.clear();
+		m_total_bytes = 0;
+		m_dirty = true;
+	}
+
+	const uint8_t* ktx2_transcode_cache::get_entry_data(const cache_entry& e) const
+	{
+		if (e.m_data.size())
+			return e.m_data.data();
+
+		assert(m_file.is_open() && ((e.m_file_ofs + e.m_size) <= m_file.get_size()));
+		return m_file.get_ptr() + e.m_file_ofs;
+	}
+
+	void ktx2_transcode_cache::remove_entry(uint32_t entry_index)
+	{
+		cache_entry& e = m_entries[entry_index];
+
+		m_entry_map.erase(e.m_key);
+		m_total_bytes -= e.m_size;
+
+		// Move the last entry into the hole.
+		const uint32_t last_index = m_entries.size_u32() - 1;
+		if (entry_index != last_index)
+		{
+			std::swap(e, m_entries[last_index]);
+
+			auto it = m_entry_map.find(e.m_key);
+			assert(it != m_entry_map.end());
+			it->second = entry_index;
+		}
+
+		m_entries.resize(last_index);
+		m_dirty = true;
+	}
+
+	void ktx2_transcode_cache::evict(uint64_t bytes_needed)
+	{
+		// Linear scan for the least recently used entry. Caches typically hold at most a few thousand images, and this only happens on misses.
+		while (m_entries.size() && ((m_total_bytes + bytes_needed) > m_max_size))
+		{
+			uint32_t lru_index = 0;
+			for (uint32_t i = 1; i < m_entries.size(); i++)
+				if (m_entries[i].m_last_used < m_entries[lru_index].m_last_used)
+					lru_index = i;
+
+			m_stats.m_evictions++;
+			m_stats.m_bytes_evicted += m_entries[lru_index].m_size;
+
+			remove_entry(lru_index);
+		}
+	}
+
+	bool ktx2_transcode_cache::transcode_image_level(basist::ktx2_transcoder& transcoder,
+		uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+		void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+		basist::transcoder_texture_format fmt,
+		uint32_t decode_flags, int channel0, int channel1,
+		basist::ktx2_transcoder_state* pState)
+	{
+		if (!transcoder.get_data())
+		{
+			error_printf("ktx2_transcode_cache::transcode_image_level: transcoder hasn't been initialized\n");
+			return false;
+		}
+
+		basist::ktx2_image_level_info level_info;
+		if (!transcoder.get_image_level_info(level_info, level_index, layer_index, face_index))
+			return false;
+
+		const uint32_t output_size = basist::basis_compute_transcoded_image_size_in_bytes(fmt, level_info.m_orig_width, level_info.m_orig_height);
+		if ((uint64_t)output_blocks_buf_size_in_blocks_or_pixels * basist::basis_get_bytes_per_block_or_pixel(fmt) < output_size)
+		{
+			error_printf("ktx2_transcode_cache::transcode_image_level: output buffer is too small\n");
+			return false;
+		}
+
+		if ((!m_is_open) || (transcoder.is_video()))
+		{
+			return transcoder.transcode_image_level(level_index, layer_index, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+				fmt, decode_flags, 0, 0, channel0, channel1, pState);
+		}
+
+		// Hashing the level's data on every call is much cheaper than transcoding it, and unlike remembering hashes by data pointer it can't
+		// be fooled by another file being loaded at the same address.
+		cache_key key;
+		clear_obj(key);
+		key.m_content_hash = get_ktx2_level_content_hash(transcoder, level_index);
+		key.m_level_index = level_index;
+		key.m_layer_index = layer_index;
+		key.m_face_index = face_index;
+		key.m_fmt = (uint32_t)fmt;
+		key.m_decode_flags = decode_flags;
+		key.m_channel0 = channel0;
+		key.m_channel1 = channel1;
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto it = m_entry_map.find(key);
+			if (it != m_entry_map.end())
+			{
+				cache_entry& e = m_entries[it->second];
+				if (e.m_size == output_size)
+				{
+					memcpy(pOutput_blocks, get_entry_data(e), output_size);
+
+					e.m_last_used = ++m_lru_tick;
+
+					m_stats.m_hits++;
+					return true;
+				}
+
+				// Shouldn't happen unless the hash collided.
+				remove_entry(it->second);
+			}
+
+			m_stats.m_misses++;
+		}
+
+		// Transcode outside of the lock, so other threads can hit the cache in the meantime.
+		if (!transcoder.transcode_image_level(level_index, layer_index, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+			fmt, decode_flags, 0, 0, channel0, channel1, pState))
+		{
+			return false;
+		}
+
+		if (output_size > m_max_size)
+			return true;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// Another thread may have transcoded the same image in the meantime.
+		if (m_entry_map.find(key) != m_entry_map.end())
+			return true;
+
+		evict(output_size);
+
+		cache_entry* pEntry = m_entries.try_enlarge(1);
+		if (!pEntry)
+			return true;
+
+		pEntry->m_key = key;
+		pEntry->m_last_used = ++m_lru_tick;
+		pEntry->m_file_ofs = 0;
+		pEntry->m_size = output_size;
+		pEntry->m_data.assign(static_cast<const uint8_t*>(pOutput_blocks), static_cast<const uint8_t*>(pOutput_blocks) + output_size);
+
+		m_entry_map.insert(key, m_entries.size_u32() - 1);
+		m_total_bytes += output_size;
+		m_dirty = true;
+
+		m_stats.m_insertions++;
+
+		return true;
+	}
+
+	transcode_cache_stats ktx2_transcode_cache::get_stats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		transcode_cache_stats stats(m_stats);
+		stats.m_total_entries = m_entries.size();
+		stats.m_total_bytes = m_total_bytes;
+		return stats;
+	}
+
+	void ktx2_transcode_cache::reset_stats()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats.clear();
+	}
+
+} // namespace basisu
@@ -0,0 +1,159 @@
+// basisu_transcode_cache.h
+// Copyright (C) 2019-2025 Binomial LLC. All Rights Reserved.
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Persistent on-disk cache of transcoded KTX2 images. Apps which transcode the same KTX2 assets to the same
+// GPU format on every launch can route ktx2_transcoder::transcode_image_level() calls through a
+// ktx2_transcode_cache: a hit copies the previously transcoded image straight out of the (memory mapped) cache
+// file, skipping Zstd decompression and transcoding entirely.
+//
+// Entries are keyed by a 64-bit hash of the source file's header, DFD, key/value data, ETC1S global codebooks
+// (SGD) and the level's data, plus the level/layer/face, target format, decode flags and channels.
+// The cache is bounded: when it grows beyond its max size the least recently used entries are evicted.
+//
+// The cache file is only written by flush() (or close()), which writes a new file and renames it over the old
+// one, so a crash or a concurrent reader never sees a partially written cache. If several processes share a
+// cache file the last one to flush wins.
+#pragma once
+
+#include "basisu_enc.h"
+#include "../transcoder/basisu_transcoder.h"
+#include <mutex>
+
+namespace basisu
+{
+	// Counters for telemetry. Cumulative since open() or the last reset_stats().
+	struct transcode_cache_stats
+	{
+		uint64_t m_hits;
+		uint64_t m_misses;
+		uint64_t m_insertions;
+		uint64_t m_evictions;
+		uint64_t m_bytes_evicted;
+
+		// Current contents of the cache.
+		uint64_t m_total_entries;
+		uint64_t m_total_bytes;
+
+		void clear() { clear_obj(*this); }
+	};
+
+	class ktx2_transcode_cache
+	{
+		BASISU_NO_EQUALS_OR_COPY_CONSTRUCT(ktx2_transcode_cache);
+
+	public:
+		enum
+		{
+			cDefaultMaxSize = 256U * 1024U * 1024U
+		};
+
+		ktx2_transcode_cache();
+		~ktx2_transcode_cache();
+
+		// Opens (and memory maps) the cache file. A missing file isn't an error: the cache starts out empty and the file is
+		// created on the first flush(). An invalid or corrupted cache file is ignored (and replaced on the next flush()).
+		// max_size is the max total size in bytes of the transcoded images held in the cache.
+		bool open(const char* pFilename, uint64_t max_size = cDefaultMaxSize);
+
+		// Writes the cache file if anything changed since it was opened, then releases everything.
+		bool close();
+
+		bool is_open() const { return m_is_open; }
+
+		// Atomically replaces the cache file with the current contents of the cache, if any entries were inserted or evicted.
+		// (Hits only update the LRU order, which is written along with the next insertion/eviction.)
+		bool flush();
+
+		// Evicts every entry.
+		void clear_entries();
+
+		// Same as ktx2_transcoder::transcode_image_level(), except the output is always tightly packed (there's no row pitch or rows parameter):
+		// pOutput_blocks must be at least basis_compute_transcoded_image_size_in_bytes(fmt, orig_width, orig_height) bytes.
+		// On a hit transcoder is only used to find the source data, so start_transcoding() doesn't need to have been called yet. On a miss the
+		// image is transcoded and inserted into the cache. ETC1S video frames depend on the previous frame, so they always bypass the cache
+		// (call start_transcoding() first, so is_video() is valid). Thread safe, as long as each thread passes its own pState.
+		bool transcode_image_level(basist::ktx2_transcoder& transcoder,
+			uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+			basist::transcoder_texture_format fmt,
+			uint32_t decode_flags = 0, int channel0 = -1, int channel1 = -1,
+			basist::ktx2_transcoder_state* pState = nullptr);
+
+		transcode_cache_stats get_stats() const;
+		void reset_stats();
+
+		uint64_t get_max_size() const { return m_max_size; }
+		const std::string& get_filename() const { return m_filename; }
+
+	private:
+		struct cache_key
+		{
+			// All members are hashed, so this struct must not have any padding.
+			uint64_t m_content_hash;
+			uint32_t m_level_index;
+			uint32_t m_layer_index;
+			uint32_t m_face_index;
+			uint32_t m_fmt;
+			uint32_t m_decode_flags;
+			int32_t m_channel0;
+			int32_t m_channel1;
+			uint32_t m_unused;
+
+			operator size_t() const;
+			bool operator== (const cache_key& rhs) const { return memcmp(this, &rhs, sizeof(*this)) == 0; }
+		};
+
+		struct cache_entry
+		{
+			cache_key m_key;
+			uint64_t m_last_used;
+
+			// The transcoded data is either in the memory mapped cache file (at m_file_ofs), or in m_data if it was inserted since the file was last written.
+			uint64_t m_file_ofs;
+			uint32_t m_size;
+			uint8_vec m_data;
+		};
+
+		typedef basisu::hash_map<cache_key, uint32_t> cache_key_hash_map;
+
+		mutable std::mutex m_mutex;
+
+		std::string m_filename;
+		uint64_t m_max_size;
+		bool m_is_open;
+		bool m_dirty;	// true if entries were inserted or evicted since the file was last written
+
+		memory_mapped_file m_file;
+
+		basisu::vector<cache_entry> m_entries;
+		cache_key_hash_map m_entry_map;
+		uint64_t m_total_bytes;
+		uint64_t m_lru_tick;
+
+		transcode_cache_stats m_stats;
+
+		bool load_file();
+		const uint8_t* get_entry_data(const cache_entry& e) const;
+		void remove_entry(uint32_t entry_index);
+		void evict(uint64_t bytes_needed);
+	};
+
+	// Returns a 64-bit hash of everything in the KTX2 file which the transcoded output of the level can depend on:
+	// the header, level index, DFD, key/value data, ETC1S global codebooks, and the level's (possibly supercompressed) data.
+	uint64_t get_ktx2_level_content_hash(const basist::ktx2_transcoder& transcoder, uint32_t level_index);
+
+	// 64-bit non-cryptographic hash (based on xxHash64). Used for the cache keys.
+	uint64_t hash64(const void* pData, size_t size, uint64_t seed = 0);
+
+} // namespace basisu
@@ -3831,8 +3831,16 @@ namespace basisu
 
 		std::unordered_map<selector_bitsequence, uint32_t, selector_bitsequence_hash> selector_history;
 						
+		const uint32_t PROGRESS_BLOCKS = 256;
+						
 		for (uint32_t block_index = first_index; block_index < last_index; block_index++)
 		{
+			if ((params.m_pProgress) && (block_index != first_index) && (((block_index - first_index) % PROGRESS_BLOCKS) == 0))
+			{
+				if (!params.m_pProgress->update(PROGRESS_BLOCKS))
+					return false;
+			}
+
 			const basist::uastc_block& blk = pBlocks[block_index];
 			const color_rgba* pPixels = &pBlock_pixels[16 * block_index];
 
@@ -4111,6 +4119,8 @@ namespace basisu
 		assert(params.m_lz_dict_size > 0);
 		assert(params.m_lambda > 0.0f);
 
+		BASISU_TRACE_ZONE("uastc_rdo");
+
 		uint32_t total_skipped = 0, total_modified = 0, total_refined = 0, total_smooth = 0;
 
 		uint32_t blocks_per_job = total_jobs ? (num_blocks / total_jobs) : 0;
@@ -4158,6 +4168,8 @@ namespace basisu
 			status = all_succeeded;
 		}
 
+		BASISU_TRACE_COUNTER("uastc_rdo_modified_blocks", total_modified);
+
 		debug_printf("uastc_rdo: Total modified: %3.2f%%, total skipped: %3.2f%%, total refined: %3.2f%%, total smooth: %3.2f%%\n", total_modified * 100.0f / num_blocks, total_skipped * 100.0f / num_blocks, total_refined * 100.0f / num_blocks, total_smooth * 100.0f / num_blocks);
 				
 		return status;
@@ -109,6 +109,8 @@ namespace basisu
 
 			m_max_smooth_block_std_dev = UASTC_RDO_DEFAULT_MAX_SMOOTH_BLOCK_STD_DEV;
 			m_smooth_block_max_error_scale = UASTC_RDO_DEFAULT_SMOOTH_BLOCK_MAX_ERROR_SCALE;
+
+			m_pProgress = nullptr;
 		}
 
 		// m_lz_dict_size: Size of LZ dictionary to simulate in bytes. The larger this value, the slower the encoder but the higher the quality per LZ compressed bit.
@@ -131,6 +133,9 @@ namespace basisu
 		float m_smooth_block_max_error_scale;
 
 		uint32_t m_lz_literal_cost;
+
+		// Optional progress reporting/cancellation. If it's stopped uastc_rdo() returns false.
+		encode_progress* m_pProgress;
 	};
 
 	// num_blocks, pBlocks: Number of blocks and pointer to UASTC blocks to process.
@@ -167,3 +167,4 @@ typedef uint32_t wasm_bool_t;
 #define DECODE_FLAGS_NO_DEBLOCK_FILTERING 128
 #define DECODE_FLAGS_FORCE_DEBLOCK_FILTERING 512
 #define DECODE_FLAGS_XUASTC_LDR_DISABLE_FAST_BC7_TRANSCODING 1024
+#define DECODE_FLAGS_STREAM_ZSTD_LEVEL_DATA 2048
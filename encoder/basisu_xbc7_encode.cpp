@@ -2750,6 +2750,9 @@ struct xbc7_dct_stats
 
 			} // bx
 
+			if ((opts.m_pProgress) && (!opts.m_pProgress->update(1)))
+				return false;
+
 		} // by
 
 		return true;
@@ -2965,15 +2968,38 @@ struct xbc7_dct_stats
 				&cur_row, &pack_failed_flag, &alt_changed_blocks, &lut_block_count, &lut_block_count_nonsolid,
 				&orig_img, &log_blks, &raw_bc7_debug_image, &bc7e_params, &base_used_lut]()
 				{
+					// bc7e_scalar: pack a whole row in one call, so its SIMD partition estimators can work on
+					// several blocks at once (the results are identical to packing the blocks one at a time).
+					const bool use_bc7e_rows = (opts.m_bc7_encoder == bc7_encoder_type::cBC7E_Scalar);
+
+					basisu::vector<color_rgba> row_pixels;
+					basisu::vector<uint64_t> row_bc7e_blocks;
+					uint8_vec row_lut_flags;
+
 					for ( ; ; )
 					{
 						if (pack_failed_flag)
 							return;
 
+						if ((opts.m_pProgress) && (opts.m_pProgress->is_stopped()))
+							return;
+
 						const uint32_t by = cur_row.fetch_add(1);
 						if (by >= num_blocks_y)
 							break;
 
+						if (use_bc7e_rows)
+						{
+							row_pixels.resize(num_blocks_x * 16);
+							row_bc7e_blocks.resize(num_blocks_x * 2);
+							row_lut_flags.resize(num_blocks_x);
+
+							for (uint32_t bx = 0; bx < num_blocks_x; bx++)
+								orig_img.extract_block_clamped(&row_pixels[bx * 16], bx * 4, by * 4, 4, 4);
+
+							bc7e_scalar::bc7e_compress_blocks(num_blocks_x, row_bc7e_blocks.data(), (const uint32_t*)row_pixels.data(), &bc7e_params, row_lut_flags.data());
+						}
+
 						for (uint32_t bx = 0; bx < num_blocks_x; bx++)
 						{
 							color_rgba orig_block[16];
@@ -2981,7 +3007,13 @@ struct xbc7_dct_stats
 
 							basist::bc7u::phys_bc7_block phys_blk;
 							bool used_lut = false;
-							xbc7_pack_bc7_base_block(phys_blk, orig_block, opts, bc7e_params, used_lut);
+							if (use_bc7e_rows)
+							{
+								memcpy(phys_blk.m_bytes, &row_bc7e_blocks[bx * 2], sizeof(phys_blk.m_bytes));
+								used_lut = (row_lut_flags[bx] != 0);
+							}
+							else
+								xbc7_pack_bc7_base_block(phys_blk, orig_block, opts, bc7e_params, used_lut);
 							base_used_lut(bx, by) = used_lut ? (uint8_t)1 : (uint8_t)0;
 							if (used_lut)
 							{
@@ -3090,9 +3122,16 @@ struct xbc7_dct_stats
 							}
 
 						} // bx
+
+						if ((opts.m_pProgress) && (!opts.m_pProgress->update(1)))
+							return;
 					}
 				};
 
+			// The base pack is the bulk of the work, the main coding pass (per stripe) does the rest.
+			if (opts.m_pProgress)
+				opts.m_pProgress->begin_stage(0.0f, .6f, num_blocks_y);
+
 			if ((use_threading) && (num_blocks_y > 1))
 			{
 				const uint32_t num_threads = (uint32_t)opts.m_pJob_pool->get_total_threads();
@@ -3111,6 +3150,9 @@ struct xbc7_dct_stats
 			if (pack_failed_flag)
 				return false;
 
+			if ((opts.m_pProgress) && (opts.m_pProgress->is_stopped()))
+				return false;
+
 			if (opts.m_debug_output && opts.m_bc7_alt_pack_enabled)
 			{
 				const uint32_t n = alt_changed_blocks.load();
@@ -3245,6 +3287,14 @@ struct xbc7_dct_stats
 		std::atomic<bool> stripe_failed_flag;
 		stripe_failed_flag.store(false);
 
+		if (opts.m_pProgress)
+		{
+			if (opts.m_pProgress->is_stopped())
+				return false;
+
+			opts.m_pProgress->begin_stage(.6f, 1.0f, num_blocks_y);
+		}
+
 		if (opts.m_debug_output)
 			fmt_debug_printf("XBC7 progress: main coding pass ({} stripe{}, {})...\n",
 				num_stripes, (num_stripes == 1) ? "" : "s", ((use_threading) && (num_stripes > 1)) ? "threaded" : "serial");
@@ -159,6 +159,11 @@ namespace xbc7 {
 		// bytes (the stripe count is independent of it).
 		job_pool* m_pJob_pool = nullptr;
 
+		// Optional progress reporting/cancellation, updated once per block row
+		// by the base pack and main coding passes. If it's stopped, pack_image()
+		// returns false as soon as the pool's in-flight rows drain.
+		encode_progress* m_pProgress = nullptr;
+
 		// Stripe count for the main coding pass: 0 == auto (derived from image
 		// dimensions); else force exactly this many, clamped to
 		// [1, min(block_rows, XBC7_MAX_ENCODER_STRIPES)]. 1 == single-stripe (max
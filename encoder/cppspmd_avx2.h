@@ -0,0 +1,1535 @@
+// cppspmd_avx2.h
+// Copyright 2020-2025 Binomial LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Notes for Basis Universal:
+// All of the "cppspmd" code and headers are OPTIONAL to Basis Universal. if BASISU_SUPPORT_AVX2 is 0, it will never be included and does not impact compilation.
+// This is the 8-wide AVX2 (+FMA) version of cppspmd_sse.h, with the same interface. Only include it from translation units compiled with AVX2 and FMA
+// enabled (-mavx2 -mfma, or /arch:AVX2), and only call into those translation units after checking g_cpu_supports_avx2.
+// The byte/word "lane" helpers (shuffle_epi8, unpacks, packs, etc.) operate within each 128-bit half, like the underlying AVX2 instructions.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <assert.h>
+#include <math.h>
+#include <utility>
+#include <algorithm>
+
+#include <immintrin.h>		// AVX, AVX2, FMA
+
+#undef CPPSPMD_SSE
+#undef CPPSPMD_AVX1
+#undef CPPSPMD_AVX2
+#undef CPPSPMD_AVX
+#undef CPPSPMD_FLOAT4
+#undef CPPSPMD_INT16
+
+#define CPPSPMD_SSE 0
+#define CPPSPMD_AVX 1
+#define CPPSPMD_AVX1 0
+#define CPPSPMD_AVX2 1
+#define CPPSPMD_FLOAT4 0
+#define CPPSPMD_INT16 0
+
+#ifdef _MSC_VER
+	#ifndef CPPSPMD_DECL
+	#define CPPSPMD_DECL(type, name) __declspec(align(32)) type name
+	#endif
+
+	#ifndef CPPSPMD_ALIGN
+	#define CPPSPMD_ALIGN(v) __declspec(align(v))
+	#endif
+
+	#define _mm256_undefined_si256 _mm256_setzero_si256
+	#define _mm256_undefined_ps _mm256_setzero_ps
+#else
+	#ifndef CPPSPMD_DECL
+	#define CPPSPMD_DECL(type, name) type name __attribute__((aligned(32)))
+	#endif
+
+	#ifndef CPPSPMD_ALIGN
+	#define CPPSPMD_ALIGN(v) __attribute__((aligned(v)))
+	#endif
+#endif
+
+#ifndef CPPSPMD_FORCE_INLINE
+#ifdef _DEBUG
+#define CPPSPMD_FORCE_INLINE inline
+#else
+	#ifdef _MSC_VER
+		#define CPPSPMD_FORCE_INLINE __forceinline
+	#else
+		#define CPPSPMD_FORCE_INLINE inline
+	#endif
+#endif
+#endif
+
+#undef CPPSPMD
+#undef CPPSPMD_ARCH
+
+#define CPPSPMD_SSE2 0
+#define CPPSPMD_SSE41 0
+#define CPPSPMD cppspmd_avx2
+#define CPPSPMD_ARCH _avx2
+
+#ifndef CPPSPMD_GLUER
+	#define CPPSPMD_GLUER(a, b) a##b
+#endif
+
+#ifndef CPPSPMD_GLUER2
+	#define CPPSPMD_GLUER2(a, b) CPPSPMD_GLUER(a, b)
+#endif
+
+#ifndef CPPSPMD_NAME
+#define CPPSPMD_NAME(a) CPPSPMD_GLUER2(a, CPPSPMD_ARCH)
+#endif
+
+#undef VASSERT
+#define VCOND(cond) ((exec_mask(vbool(cond)) & m_exec).get_movemask() == m_exec.get_movemask())
+#define VASSERT(cond) assert( VCOND(cond) )
+
+#define CPPSPMD_ALIGNMENT (32)
+
+namespace CPPSPMD
+{
+
+const int PROGRAM_COUNT_SHIFT = 3;
+const int PROGRAM_COUNT = 1 << PROGRAM_COUNT_SHIFT;
+
+template <typename N> inline N* aligned_new() { void* p = _mm_malloc(sizeof(N), 64); new (p) N;	return static_cast<N*>(p); }
+template <typename N> void aligned_delete(N* p) { if (p) { p->~N(); _mm_free(p); } }
+
+CPPSPMD_DECL(const uint32_t, g_allones_256[8]) = { UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX, UINT32_MAX };
+CPPSPMD_DECL(const float, g_onef_256[8]) = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+CPPSPMD_DECL(const uint32_t, g_lane_masks_256[8][8]) =
+{
+	{ UINT32_MAX, 0, 0, 0, 0, 0, 0, 0 },
+	{ 0, UINT32_MAX, 0, 0, 0, 0, 0, 0 },
+	{ 0, 0, UINT32_MAX, 0, 0, 0, 0, 0 },
+	{ 0, 0, 0, UINT32_MAX, 0, 0, 0, 0 },
+	{ 0, 0, 0, 0, UINT32_MAX, 0, 0, 0 },
+	{ 0, 0, 0, 0, 0, UINT32_MAX, 0, 0 },
+	{ 0, 0, 0, 0, 0, 0, UINT32_MAX, 0 },
+	{ 0, 0, 0, 0, 0, 0, 0, UINT32_MAX },
+};
+
+// Replicates a 128-bit value into both 128-bit halves.
+CPPSPMD_FORCE_INLINE __m256i broadcast_si128(const __m128i& a) { return _mm256_inserti128_si256(_mm256_castsi128_si256(a), a, 1); }
+
+CPPSPMD_FORCE_INLINE __m256i blendv_epi8(__m256i a, __m256i b, __m256i mask) { return _mm256_blendv_epi8(a, b, mask); }
+
+CPPSPMD_FORCE_INLINE __m256 blendv_mask_ps(__m256 a, __m256 b, __m256 mask) { return _mm256_blendv_ps(a, b, mask); }
+CPPSPMD_FORCE_INLINE __m256 blendv_ps(__m256 a, __m256 b, __m256 mask) { return _mm256_blendv_ps(a, b, mask); }
+
+CPPSPMD_FORCE_INLINE __m256i blendv_mask_epi32(__m256i a, __m256i b, __m256i mask)
+{
+	return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _mm256_castsi256_ps(mask)));
+}
+
+CPPSPMD_FORCE_INLINE __m256i blendv_epi32(__m256i a, __m256i b, __m256i mask)
+{
+	return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _mm256_castsi256_ps(mask)));
+}
+
+CPPSPMD_FORCE_INLINE int extract_x(const __m256i& vec) { return _mm_cvtsi128_si32(_mm256_castsi256_si128(vec)); }
+
+CPPSPMD_FORCE_INLINE __m256i shuffle_epi8(const __m256i& a, const __m256i& b) { return _mm256_shuffle_epi8(a, b); }
+
+CPPSPMD_FORCE_INLINE __m256i min_epi32(__m256i a, __m256i b) { return _mm256_min_epi32(a, b); }
+CPPSPMD_FORCE_INLINE __m256i max_epi32(__m256i a, __m256i b) { return _mm256_max_epi32(a, b); }
+CPPSPMD_FORCE_INLINE __m256i min_epu32(__m256i a, __m256i b) { return _mm256_min_epu32(a, b); }
+CPPSPMD_FORCE_INLINE __m256i max_epu32(__m256i a, __m256i b) { return _mm256_max_epu32(a, b); }
+
+CPPSPMD_FORCE_INLINE __m256i abs_epi32(__m256i a) { return _mm256_abs_epi32(a); }
+
+CPPSPMD_FORCE_INLINE __m256i mullo_epi32(__m256i a, __m256i b) { return _mm256_mullo_epi32(a, b); }
+
+CPPSPMD_FORCE_INLINE __m256i mulhi_epu32(__m256i a, __m256i b)
+{
+	// Even lanes: high halves of the 64-bit products, odd lanes: products of the shifted down odd lanes.
+	__m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, b), 32);
+	__m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+	return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+const uint32_t ALL_ON_MOVEMASK = 0xFF;
+
+struct spmd_kernel
+{
+	struct vint;
+	struct lint;
+	struct vbool;
+	struct vfloat;
+
+	typedef int int_t;
+	typedef vint vint_t;
+	typedef lint lint_t;
+
+	// Exec mask
+	struct exec_mask
+	{
+		__m256i m_mask;
+
+		exec_mask() = default;
+
+		CPPSPMD_FORCE_INLINE explicit exec_mask(const vbool& b);
+		CPPSPMD_FORCE_INLINE explicit exec_mask(const __m256i& mask) : m_mask(mask) { }
+
+		CPPSPMD_FORCE_INLINE void enable_lane(uint32_t lane) { m_mask = _mm256_load_si256((const __m256i *)&g_lane_masks_256[lane][0]); }
+
+		static CPPSPMD_FORCE_INLINE exec_mask all_on()	{ return exec_mask{ _mm256_load_si256((const __m256i*)g_allones_256) };	}
+		static CPPSPMD_FORCE_INLINE exec_mask all_off() { return exec_mask{ _mm256_setzero_si256() }; }
+
+		CPPSPMD_FORCE_INLINE uint32_t get_movemask() const { return _mm256_movemask_ps(_mm256_castsi256_ps(m_mask)); }
+	};
+
+	friend CPPSPMD_FORCE_INLINE bool all(const exec_mask& e);
+	friend CPPSPMD_FORCE_INLINE bool any(const exec_mask& e);
+
+	CPPSPMD_FORCE_INLINE bool spmd_all() const { return all(m_exec); }
+	CPPSPMD_FORCE_INLINE bool spmd_any() const { return any(m_exec); }
+	CPPSPMD_FORCE_INLINE bool spmd_none() { return !any(m_exec); }
+
+	// true if cond is true for all active lanes - false if no active lanes
+	CPPSPMD_FORCE_INLINE bool spmd_all(const vbool& e) { uint32_t m = m_exec.get_movemask(); return (m != 0) && ((exec_mask(e) & m_exec).get_movemask() == m); }
+	// true if cond is true for any active lanes
+	CPPSPMD_FORCE_INLINE bool spmd_any(const vbool& e) { return (exec_mask(e) & m_exec).get_movemask() != 0; }
+	CPPSPMD_FORCE_INLINE bool spmd_none(const vbool& e) { return !spmd_any(e); }
+
+	friend CPPSPMD_FORCE_INLINE exec_mask operator^ (const exec_mask& a, const exec_mask& b);
+	friend CPPSPMD_FORCE_INLINE exec_mask operator& (const exec_mask& a, const exec_mask& b);
+	friend CPPSPMD_FORCE_INLINE exec_mask operator| (const exec_mask& a, const exec_mask& b);
+
+	exec_mask m_exec;
+	exec_mask m_kernel_exec;
+	exec_mask m_continue_mask;
+#ifdef _DEBUG
+	bool m_in_loop;
+#endif
+
+	CPPSPMD_FORCE_INLINE uint32_t get_movemask() const { return m_exec.get_movemask(); }
+
+	void init(const exec_mask& kernel_exec);
+
+	// Varying bool
+
+	struct vbool
+	{
+		__m256i m_value;
+
+		vbool() = default;
+
+		CPPSPMD_FORCE_INLINE vbool(bool value) : m_value(_mm256_set1_epi32(value ? UINT32_MAX : 0)) { }
+
+		CPPSPMD_FORCE_INLINE explicit vbool(const __m256i& value) : m_value(value) { }
+
+		CPPSPMD_FORCE_INLINE explicit operator vfloat() const;
+		CPPSPMD_FORCE_INLINE explicit operator vint() const;
+
+	private:
+		//vbool& operator=(const vbool&);
+	};
+
+	friend vbool operator!(const vbool& v);
+
+	CPPSPMD_FORCE_INLINE vbool& store(vbool& dst, const vbool& src)
+	{
+		dst.m_value = blendv_mask_epi32(dst.m_value, src.m_value, m_exec.m_mask);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vbool& store_all(vbool& dst, const vbool& src)
+	{
+		dst.m_value = src.m_value;
+		return dst;
+	}
+
+	// Varying float
+	struct vfloat
+	{
+		__m256 m_value;
+
+		vfloat() = default;
+
+		CPPSPMD_FORCE_INLINE explicit vfloat(const __m256& v) : m_value(v) { }
+
+		CPPSPMD_FORCE_INLINE vfloat(float value) : m_value(_mm256_set1_ps(value)) { }
+
+		CPPSPMD_FORCE_INLINE explicit vfloat(int value) : m_value(_mm256_set1_ps((float)value)) { }
+
+	private:
+		//vfloat& operator=(const vfloat&);
+	};
+
+	CPPSPMD_FORCE_INLINE vfloat& store(vfloat& dst, const vfloat& src)
+	{
+		dst.m_value = blendv_mask_ps(dst.m_value, src.m_value, _mm256_castsi256_ps(m_exec.m_mask));
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat& store(vfloat&& dst, const vfloat& src)
+	{
+		dst.m_value = blendv_mask_ps(dst.m_value, src.m_value, _mm256_castsi256_ps(m_exec.m_mask));
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat& store_all(vfloat& dst, const vfloat& src)
+	{
+		dst.m_value = src.m_value;
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat& store_all(vfloat&& dst, const vfloat& src)
+	{
+		dst.m_value = src.m_value;
+		return dst;
+	}
+
+	// Linear ref to floats
+	struct float_lref
+	{
+		float* m_pValue;
+
+	private:
+		//float_lref& operator=(const float_lref&);
+	};
+
+	CPPSPMD_FORCE_INLINE const float_lref& store(const float_lref& dst, const vfloat& src)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		if (mask == ALL_ON_MOVEMASK)
+			_mm256_storeu_ps(dst.m_pValue, src.m_value);
+		else
+			_mm256_maskstore_ps(dst.m_pValue, m_exec.m_mask, src.m_value);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE const float_lref& store(const float_lref&& dst, const vfloat& src)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		if (mask == ALL_ON_MOVEMASK)
+			_mm256_storeu_ps(dst.m_pValue, src.m_value);
+		else
+			_mm256_maskstore_ps(dst.m_pValue, m_exec.m_mask, src.m_value);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE const float_lref& store_all(const float_lref& dst, const vfloat& src)
+	{
+		_mm256_storeu_ps(dst.m_pValue, src.m_value);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE const float_lref& store_all(const float_lref&& dst, const vfloat& src)
+	{
+		_mm256_storeu_ps(dst.m_pValue, src.m_value);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load(const float_lref& src)
+	{
+		return vfloat{ _mm256_maskload_ps(src.m_pValue, m_exec.m_mask) };
+	}
+
+	// Varying ref to floats
+	struct float_vref
+	{
+		__m256i m_vindex;
+		float* m_pValue;
+
+	private:
+		//float_vref& operator=(const float_vref&);
+	};
+
+	// Varying ref to varying float
+	struct vfloat_vref
+	{
+		__m256i m_vindex;
+		vfloat* m_pValue;
+
+	private:
+		//vfloat_vref& operator=(const vfloat_vref&);
+	};
+
+	// Varying ref to varying int
+	struct vint_vref
+	{
+		__m256i m_vindex;
+		vint* m_pValue;
+
+	private:
+		//vint_vref& operator=(const vint_vref&);
+	};
+
+	CPPSPMD_FORCE_INLINE const float_vref& store(const float_vref& dst, const vfloat& src);
+	CPPSPMD_FORCE_INLINE const float_vref& store(const float_vref&& dst, const vfloat& src);
+
+	CPPSPMD_FORCE_INLINE const float_vref& store_all(const float_vref& dst, const vfloat& src);
+	CPPSPMD_FORCE_INLINE const float_vref& store_all(const float_vref&& dst, const vfloat& src);
+
+	CPPSPMD_FORCE_INLINE vfloat load(const float_vref& src)
+	{
+		return vfloat{ _mm256_mask_i32gather_ps(_mm256_setzero_ps(), src.m_pValue, src.m_vindex, _mm256_castsi256_ps(m_exec.m_mask), 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load_all(const float_vref& src)
+	{
+		return vfloat{ _mm256_i32gather_ps(src.m_pValue, src.m_vindex, 4) };
+	}
+
+	// Linear ref to ints
+	struct int_lref
+	{
+		int* m_pValue;
+
+	private:
+		//int_lref& operator=(const int_lref&);
+	};
+
+	CPPSPMD_FORCE_INLINE const int_lref& store(const int_lref& dst, const vint& src)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		if (mask == ALL_ON_MOVEMASK)
+			_mm256_storeu_si256((__m256i *)dst.m_pValue, src.m_value);
+		else
+			_mm256_maskstore_epi32(dst.m_pValue, m_exec.m_mask, src.m_value);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vint load(const int_lref& src)
+	{
+		return vint{ _mm256_maskload_epi32(src.m_pValue, m_exec.m_mask) };
+	}
+
+	// Linear ref to int16's
+	struct int16_lref
+	{
+		int16_t* m_pValue;
+
+	private:
+		//int16_lref& operator=(const int16_lref&);
+	};
+
+	CPPSPMD_FORCE_INLINE const int16_lref& store(const int16_lref& dst, const vint& src)
+	{
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i *)stored, src.m_value);
+
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				dst.m_pValue[i] = static_cast<int16_t>(stored[i]);
+		}
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE const int16_lref& store_all(const int16_lref& dst, const vint& src)
+	{
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i *)stored, src.m_value);
+
+		for (int i = 0; i < 8; i++)
+			dst.m_pValue[i] = static_cast<int16_t>(stored[i]);
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vint load(const int16_lref& src)
+	{
+		__m256i t = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src.m_pValue));
+
+		return vint{ _mm256_and_si256(t, m_exec.m_mask) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all(const int16_lref& src)
+	{
+		return vint{ _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)src.m_pValue)) };
+	}
+
+	// Linear ref to constant ints
+	struct cint_lref
+	{
+		const int* m_pValue;
+
+	private:
+		//cint_lref& operator=(const cint_lref&);
+	};
+
+	CPPSPMD_FORCE_INLINE vint load(const cint_lref& src)
+	{
+		return vint{ _mm256_maskload_epi32(src.m_pValue, m_exec.m_mask) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all(const cint_lref& src)
+	{
+		return vint{ _mm256_loadu_si256((const __m256i *)src.m_pValue) };
+	}
+
+	// Varying ref to ints
+	struct int_vref
+	{
+		__m256i m_vindex;
+		int* m_pValue;
+
+	private:
+		//int_vref& operator=(const int_vref&);
+	};
+
+	// Varying ref to constant ints
+	struct cint_vref
+	{
+		__m256i m_vindex;
+		const int* m_pValue;
+
+	private:
+		//cint_vref& operator=(const cint_vref&);
+	};
+
+	// Varying int
+	struct vint
+	{
+		__m256i m_value;
+
+		vint() = default;
+
+		CPPSPMD_FORCE_INLINE explicit vint(const __m256i& value) : m_value(value)	{ }
+
+		CPPSPMD_FORCE_INLINE explicit vint(const lint &other) : m_value(other.m_value) { }
+
+		CPPSPMD_FORCE_INLINE vint& operator=(const lint& other) { m_value = other.m_value; return *this; }
+
+		CPPSPMD_FORCE_INLINE vint(int value) : m_value(_mm256_set1_epi32(value)) { }
+
+		CPPSPMD_FORCE_INLINE explicit vint(float value) : m_value(_mm256_set1_epi32((int)value))	{ }
+
+		CPPSPMD_FORCE_INLINE explicit vint(const vfloat& other) : m_value(_mm256_cvttps_epi32(other.m_value)) { }
+
+		CPPSPMD_FORCE_INLINE explicit operator vbool() const
+		{
+			return vbool{ _mm256_xor_si256( _mm256_load_si256((const __m256i*)g_allones_256), _mm256_cmpeq_epi32(m_value, _mm256_setzero_si256())) };
+		}
+
+		CPPSPMD_FORCE_INLINE explicit operator vfloat() const
+		{
+			return vfloat{ _mm256_cvtepi32_ps(m_value) };
+		}
+
+		CPPSPMD_FORCE_INLINE int_vref operator[](int* ptr) const
+		{
+			return int_vref{ m_value, ptr };
+		}
+
+		CPPSPMD_FORCE_INLINE cint_vref operator[](const int* ptr) const
+		{
+			return cint_vref{ m_value, ptr };
+		}
+
+		CPPSPMD_FORCE_INLINE float_vref operator[](float* ptr) const
+		{
+			return float_vref{ m_value, ptr };
+		}
+
+		CPPSPMD_FORCE_INLINE vfloat_vref operator[](vfloat* ptr) const
+		{
+			return vfloat_vref{ m_value, ptr };
+		}
+
+		CPPSPMD_FORCE_INLINE vint_vref operator[](vint* ptr) const
+		{
+			return vint_vref{ m_value, ptr };
+		}
+
+	private:
+		//vint& operator=(const vint&);
+	};
+
+	// Load/store linear int
+	CPPSPMD_FORCE_INLINE void storeu_linear(int *pDst, const vint& src)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		if (mask == ALL_ON_MOVEMASK)
+			_mm256_storeu_si256((__m256i *)pDst, src.m_value);
+		else
+			_mm256_maskstore_epi32(pDst, m_exec.m_mask, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE void storeu_linear_all(int *pDst, const vint& src)
+	{
+		_mm256_storeu_si256((__m256i*)pDst, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE void store_linear_all(int *pDst, const vint& src)
+	{
+		_mm256_store_si256((__m256i*)pDst, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE vint loadu_linear(const int *pSrc)
+	{
+		return vint{ _mm256_maskload_epi32(pSrc, m_exec.m_mask) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint loadu_linear_all(const int *pSrc)
+	{
+		return vint{ _mm256_loadu_si256((const __m256i*)pSrc) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_linear_all(const int *pSrc)
+	{
+		return vint{ _mm256_load_si256((const __m256i*)pSrc) };
+	}
+
+	// Load/store linear float
+	CPPSPMD_FORCE_INLINE void storeu_linear(float *pDst, const vfloat& src)
+	{
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		if (mask == ALL_ON_MOVEMASK)
+			_mm256_storeu_ps(pDst, src.m_value);
+		else
+			_mm256_maskstore_ps(pDst, m_exec.m_mask, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE void storeu_linear_all(float *pDst, const vfloat& src)
+	{
+		_mm256_storeu_ps(pDst, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE void store_linear_all(float *pDst, const vfloat& src)
+	{
+		_mm256_store_ps(pDst, src.m_value);
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat loadu_linear(const float *pSrc)
+	{
+		return vfloat{ _mm256_maskload_ps(pSrc, m_exec.m_mask) };
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat loadu_linear_all(const float *pSrc)
+	{
+		return vfloat{ _mm256_loadu_ps(pSrc) };
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load_linear_all(const float *pSrc)
+	{
+		return vfloat{ _mm256_load_ps(pSrc) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint& store(vint& dst, const vint& src)
+	{
+		dst.m_value = blendv_mask_epi32(dst.m_value, src.m_value, m_exec.m_mask);
+		return dst;
+	}
+
+	// AVX2 has gathers but no scatters, so the scattering stores go through memory.
+	CPPSPMD_FORCE_INLINE const int_vref& store(const int_vref& dst, const vint& src)
+	{
+		CPPSPMD_ALIGN(32) int vindex[8];
+		_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i*)stored, src.m_value);
+
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				dst.m_pValue[vindex[i]] = stored[i];
+		}
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vint& store_all(vint& dst, const vint& src)
+	{
+		dst.m_value = src.m_value;
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE const int_vref& store_all(const int_vref& dst, const vint& src)
+	{
+		CPPSPMD_ALIGN(32) int vindex[8];
+		_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i*)stored, src.m_value);
+
+		for (int i = 0; i < 8; i++)
+			dst.m_pValue[vindex[i]] = stored[i];
+
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vint load(const int_vref& src)
+	{
+		return vint{ _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), src.m_pValue, src.m_vindex, m_exec.m_mask, 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all(const int_vref& src)
+	{
+		return vint{ _mm256_i32gather_epi32(src.m_pValue, src.m_vindex, 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load(const cint_vref& src)
+	{
+		return vint{ _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), src.m_pValue, src.m_vindex, m_exec.m_mask, 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all(const cint_vref& src)
+	{
+		return vint{ _mm256_i32gather_epi32(src.m_pValue, src.m_vindex, 4) };
+	}
+
+	// The indices are byte offsets: loads the (unaligned) int at each offset.
+	CPPSPMD_FORCE_INLINE vint load_bytes_all(const cint_vref& src)
+	{
+		return vint{ _mm256_i32gather_epi32(src.m_pValue, src.m_vindex, 1) };
+	}
+
+	// The indices are int16 offsets: loads and sign extends the int16 at each offset.
+	CPPSPMD_FORCE_INLINE vint load_words_all(const cint_vref& src)
+	{
+		CPPSPMD_ALIGN(32) int indices[8];
+		_mm256_store_si256((__m256i *)indices, src.m_vindex);
+
+		const int16_t* pSrc = (const int16_t*)src.m_pValue;
+
+		CPPSPMD_ALIGN(32) int values[8];
+		for (int i = 0; i < 8; i++)
+			values[i] = pSrc[indices[i]];
+
+		return vint{ _mm256_load_si256((const __m256i*)values) };
+	}
+
+	CPPSPMD_FORCE_INLINE void store_strided(int *pDst, uint32_t stride, const vint &v)
+	{
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i*)stored, v.m_value);
+
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				pDst[stride * i] = stored[i];
+		}
+	}
+
+	CPPSPMD_FORCE_INLINE void store_strided(float *pDstF, uint32_t stride, const vfloat &v)
+	{
+		CPPSPMD_ALIGN(32) float stored[8];
+		_mm256_store_ps(stored, v.m_value);
+
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				pDstF[stride * i] = stored[i];
+		}
+	}
+
+	CPPSPMD_FORCE_INLINE void store_all_strided(int *pDst, uint32_t stride, const vint &v)
+	{
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i*)stored, v.m_value);
+
+		for (int i = 0; i < 8; i++)
+			pDst[stride * i] = stored[i];
+	}
+
+	CPPSPMD_FORCE_INLINE void store_all_strided(float *pDstF, uint32_t stride, const vfloat &v)
+	{
+		CPPSPMD_ALIGN(32) float stored[8];
+		_mm256_store_ps(stored, v.m_value);
+
+		for (int i = 0; i < 8; i++)
+			pDstF[stride * i] = stored[i];
+	}
+
+	CPPSPMD_FORCE_INLINE __m256i strided_indices(uint32_t stride) const
+	{
+		return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)stride));
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_strided(const int *pSrc, uint32_t stride)
+	{
+		return vint{ _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), pSrc, strided_indices(stride), m_exec.m_mask, 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load_strided(const float *pSrc, uint32_t stride)
+	{
+		return vfloat{ _mm256_mask_i32gather_ps(_mm256_setzero_ps(), pSrc, strided_indices(stride), _mm256_castsi256_ps(m_exec.m_mask), 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all_strided(const int *pSrc, uint32_t stride)
+	{
+		return vint{ _mm256_i32gather_epi32(pSrc, strided_indices(stride), 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load_all_strided(const float *pSrc, uint32_t stride)
+	{
+		return vfloat{ _mm256_i32gather_ps(pSrc, strided_indices(stride), 4) };
+	}
+
+	// Lane i of a vfloat_vref/vint_vref lives at element (vindex[i] * 8 + i) of the array.
+	CPPSPMD_FORCE_INLINE __m256i varying_vref_indices(const __m256i &vindex) const
+	{
+		return _mm256_add_epi32(_mm256_slli_epi32(vindex, 3), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	}
+
+	CPPSPMD_FORCE_INLINE const vfloat_vref& store(const vfloat_vref& dst, const vfloat& src)
+	{
+		CPPSPMD_ALIGN(32) int vindex[8];
+		_mm256_store_si256((__m256i*)vindex, varying_vref_indices(dst.m_vindex));
+
+		CPPSPMD_ALIGN(32) float stored[8];
+		_mm256_store_ps(stored, src.m_value);
+
+		float* pDst = (float*)dst.m_pValue;
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				pDst[vindex[i]] = stored[i];
+		}
+
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vfloat load(const vfloat_vref& src)
+	{
+		return vfloat{ _mm256_mask_i32gather_ps(_mm256_setzero_ps(), (const float*)src.m_pValue, varying_vref_indices(src.m_vindex), _mm256_castsi256_ps(m_exec.m_mask), 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE const vint_vref& store(const vint_vref& dst, const vint& src)
+	{
+		CPPSPMD_ALIGN(32) int vindex[8];
+		_mm256_store_si256((__m256i*)vindex, varying_vref_indices(dst.m_vindex));
+
+		CPPSPMD_ALIGN(32) int stored[8];
+		_mm256_store_si256((__m256i*)stored, src.m_value);
+
+		int* pDst = (int*)dst.m_pValue;
+		int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+		for (int i = 0; i < 8; i++)
+		{
+			if (mask & (1 << i))
+				pDst[vindex[i]] = stored[i];
+		}
+
+		return dst;
+	}
+
+	CPPSPMD_FORCE_INLINE vint load(const vint_vref& src)
+	{
+		return vint{ _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int*)src.m_pValue, varying_vref_indices(src.m_vindex), m_exec.m_mask, 4) };
+	}
+
+	CPPSPMD_FORCE_INLINE vint load_all(const vint_vref& src)
+	{
+		return vint{ _mm256_i32gather_epi32((const int*)src.m_pValue, varying_vref_indices(src.m_vindex), 4) };
+	}
+
+	// Linear integer
+	struct lint
+	{
+		__m256i m_value;
+
+		CPPSPMD_FORCE_INLINE explicit lint(__m256i value)
+			: m_value(value)
+		{ }
+
+		CPPSPMD_FORCE_INLINE explicit operator vfloat() const
+		{
+			return vfloat{ _mm256_cvtepi32_ps(m_value) };
+		}
+
+		CPPSPMD_FORCE_INLINE explicit operator vint() const
+		{
+			return vint{ m_value };
+		}
+
+		CPPSPMD_FORCE_INLINE int get_first_value() const
+		{
+			return extract_x(m_value);
+		}
+
+		CPPSPMD_FORCE_INLINE float_lref operator[](float* ptr) const
+		{
+			return float_lref{ ptr + get_first_value() };
+		}
+
+		CPPSPMD_FORCE_INLINE int_lref operator[](int* ptr) const
+		{
+			return int_lref{ ptr + get_first_value() };
+		}
+
+		CPPSPMD_FORCE_INLINE int16_lref operator[](int16_t* ptr) const
+		{
+			return int16_lref{ ptr + get_first_value() };
+		}
+
+		CPPSPMD_FORCE_INLINE cint_lref operator[](const int* ptr) const
+		{
+			return cint_lref{ ptr + get_first_value() };
+		}
+
+	private:
+		//lint& operator=(const lint&);
+	};
+
+	CPPSPMD_FORCE_INLINE lint& store_all(lint& dst, const lint& src)
+	{
+		dst.m_value = src.m_value;
+		return dst;
+	}
+
+	const lint program_index = lint{ _mm256_set_epi32( 7, 6, 5, 4, 3, 2, 1, 0 ) };
+
+	// SPMD condition helpers
+
+	template<typename IfBody>
+	CPPSPMD_FORCE_INLINE void spmd_if(const vbool& cond, const IfBody& ifBody);
+
+	CPPSPMD_FORCE_INLINE void spmd_if_break(const vbool& cond);
+
+	// No breaks, continues, etc. allowed
+	template<typename IfBody>
+	CPPSPMD_FORCE_INLINE void spmd_sif(const vbool& cond, const IfBody& ifBody);
+
+	// No breaks, continues, etc. allowed
+	template<typename IfBody, typename ElseBody>
+	CPPSPMD_FORCE_INLINE void spmd_sifelse(const vbool& cond, const IfBody& ifBody, const ElseBody &elseBody);
+
+	template<typename IfBody, typename ElseBody>
+	CPPSPMD_FORCE_INLINE void spmd_ifelse(const vbool& cond, const IfBody& ifBody, const ElseBody& elseBody);
+
+	template<typename WhileCondBody, typename WhileBody>
+	CPPSPMD_FORCE_INLINE void spmd_while(const WhileCondBody& whileCondBody, const WhileBody& whileBody);
+
+	template<typename ForInitBody, typename ForCondBody, typename ForIncrBody, typename ForBody>
+	CPPSPMD_FORCE_INLINE void spmd_for(const ForInitBody& forInitBody, const ForCondBody& forCondBody, const ForIncrBody& forIncrBody, const ForBody& forBody);
+
+	template<typename ForeachBody>
+	CPPSPMD_FORCE_INLINE void spmd_foreach(int begin, int end, const ForeachBody& foreachBody);
+
+#ifdef _DEBUG
+	CPPSPMD_FORCE_INLINE void check_masks();
+#else
+	CPPSPMD_FORCE_INLINE void check_masks() { }
+#endif
+
+	CPPSPMD_FORCE_INLINE void spmd_break();
+	CPPSPMD_FORCE_INLINE void spmd_continue();
+
+	CPPSPMD_FORCE_INLINE void spmd_return();
+
+	template<typename UnmaskedBody>
+	CPPSPMD_FORCE_INLINE void spmd_unmasked(const UnmaskedBody& unmaskedBody);
+
+	template<typename SPMDKernel, typename... Args>
+	//CPPSPMD_FORCE_INLINE decltype(auto) spmd_call(Args&&... args);
+	CPPSPMD_FORCE_INLINE void spmd_call(Args&&... args);
+
+	CPPSPMD_FORCE_INLINE void swap(vint &a, vint &b) { vint temp = a; store(a, b); store(b, temp); }
+	CPPSPMD_FORCE_INLINE void swap(vfloat &a, vfloat &b) { vfloat temp = a; store(a, b); store(b, temp); }
+	CPPSPMD_FORCE_INLINE void swap(vbool &a, vbool &b) { vbool temp = a; store(a, b); store(b, temp); }
+
+	CPPSPMD_FORCE_INLINE float reduce_add(vfloat v)
+	{
+		__m256 k = blendv_mask_ps(_mm256_setzero_ps(), v.m_value, _mm256_castsi256_ps(m_exec.m_mask));
+		__m128 temp = _mm_add_ps(_mm256_castps256_ps128(k), _mm256_extractf128_ps(k, 1));
+		temp = _mm_add_ps(_mm_shuffle_ps(temp, temp, _MM_SHUFFLE(0, 1, 2, 3)), temp);
+		return _mm_cvtss_f32(_mm_add_ss(_mm_movehl_ps(temp, temp), temp));
+	}
+
+	CPPSPMD_FORCE_INLINE int reduce_add(vint v)
+	{
+		__m256i k = blendv_mask_epi32(_mm256_setzero_si256(), v.m_value, m_exec.m_mask);
+		__m128i temp = _mm_add_epi32(_mm256_castsi256_si128(k), _mm256_extracti128_si256(k, 1));
+		temp = _mm_add_epi32(_mm_shuffle_epi32(temp, _MM_SHUFFLE(0, 1, 2, 3)), temp);
+		return _mm_cvtsi128_si32(_mm_add_epi32(_mm_unpackhi_epi64(temp, temp), temp));
+	}
+
+	#include "cppspmd_math_declares.h"
+
+}; // struct spmd_kernel
+
+using exec_mask = spmd_kernel::exec_mask;
+using vint = spmd_kernel::vint;
+using int_lref = spmd_kernel::int_lref;
+using cint_vref = spmd_kernel::cint_vref;
+using cint_lref = spmd_kernel::cint_lref;
+using int_vref = spmd_kernel::int_vref;
+using lint = spmd_kernel::lint;
+using vbool = spmd_kernel::vbool;
+using vfloat = spmd_kernel::vfloat;
+using float_lref = spmd_kernel::float_lref;
+using float_vref = spmd_kernel::float_vref;
+using vfloat_vref = spmd_kernel::vfloat_vref;
+using vint_vref = spmd_kernel::vint_vref;
+
+CPPSPMD_FORCE_INLINE spmd_kernel::vbool::operator vfloat() const
+{
+	return vfloat { _mm256_and_ps( _mm256_castsi256_ps(m_value), _mm256_load_ps(g_onef_256) ) };
+}
+
+// Returns UINT32_MAX's for true, 0 for false. (Should it return 1's?)
+CPPSPMD_FORCE_INLINE spmd_kernel::vbool::operator vint() const
+{
+	return vint { m_value };
+}
+
+CPPSPMD_FORCE_INLINE vbool operator!(const vbool& v)
+{
+	return vbool{ _mm256_xor_si256(_mm256_load_si256((const __m256i*)g_allones_256), v.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE exec_mask::exec_mask(const vbool& b) { m_mask = b.m_value; }
+
+CPPSPMD_FORCE_INLINE exec_mask operator^(const exec_mask& a, const exec_mask& b) { return exec_mask{ _mm256_xor_si256(a.m_mask, b.m_mask) }; }
+CPPSPMD_FORCE_INLINE exec_mask operator&(const exec_mask& a, const exec_mask& b) {	return exec_mask{ _mm256_and_si256(a.m_mask, b.m_mask) }; }
+CPPSPMD_FORCE_INLINE exec_mask operator|(const exec_mask& a, const exec_mask& b) { return exec_mask{ _mm256_or_si256(a.m_mask, b.m_mask) }; }
+
+CPPSPMD_FORCE_INLINE bool all(const exec_mask& e) { return _mm256_movemask_ps(_mm256_castsi256_ps(e.m_mask)) == ALL_ON_MOVEMASK; }
+CPPSPMD_FORCE_INLINE bool any(const exec_mask& e) { return _mm256_movemask_ps(_mm256_castsi256_ps(e.m_mask)) != 0; }
+
+// Bad pattern - doesn't factor in the current exec mask. Prefer spmd_any() instead.
+CPPSPMD_FORCE_INLINE bool all(const vbool& e) { return _mm256_movemask_ps(_mm256_castsi256_ps(e.m_value)) == ALL_ON_MOVEMASK; }
+CPPSPMD_FORCE_INLINE bool any(const vbool& e) { return _mm256_movemask_ps(_mm256_castsi256_ps(e.m_value)) != 0; }
+
+CPPSPMD_FORCE_INLINE exec_mask andnot(const exec_mask& a, const exec_mask& b) { return exec_mask{ _mm256_andnot_si256(a.m_mask, b.m_mask) }; }
+CPPSPMD_FORCE_INLINE vbool operator||(const vbool& a, const vbool& b) { return vbool{ _mm256_or_si256(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator&&(const vbool& a, const vbool& b) { return vbool{ _mm256_and_si256(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vfloat operator+(const vfloat& a, const vfloat& b) { return vfloat{ _mm256_add_ps(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vfloat& a, const vfloat& b) {	return vfloat{ _mm256_sub_ps(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat operator+(float a, const vfloat& b) { return vfloat(a) + b; }
+CPPSPMD_FORCE_INLINE vfloat operator+(const vfloat& a, float b) { return a + vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vfloat& a, const vint& b) { return a - vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vint& a, const vfloat& b) { return vfloat(a) - b; }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vfloat& a, int b) { return a - vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator-(int a, const vfloat& b) { return vfloat(a) - b; }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vfloat& a, float b) { return a - vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator-(float a, const vfloat& b) { return vfloat(a) - b; }
+
+CPPSPMD_FORCE_INLINE vfloat operator*(const vfloat& a, const vfloat& b) { return vfloat{ _mm256_mul_ps(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat operator*(const vfloat& a, float b) { return a * vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator*(float a, const vfloat& b) { return vfloat(a) * b; }
+CPPSPMD_FORCE_INLINE vfloat operator*(const vfloat& a, int b) { return a * vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator*(int a, const vfloat& b) { return vfloat(a) * b; }
+
+CPPSPMD_FORCE_INLINE vfloat operator/(const vfloat& a, const vfloat& b) {	return vfloat{ _mm256_div_ps(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat operator/(const vfloat& a, int b) { return a / vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator/(int a, const vfloat& b) { return vfloat(a) / b; }
+CPPSPMD_FORCE_INLINE vfloat operator/(const vfloat& a, float b) { return a / vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator/(float a, const vfloat& b) { return vfloat(a) / b; }
+CPPSPMD_FORCE_INLINE vfloat operator-(const vfloat& v) { return vfloat{ _mm256_sub_ps(_mm256_xor_ps(v.m_value, v.m_value), v.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vbool operator==(const vfloat& a, const vfloat& b) { return vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_EQ_OQ)) }; }
+CPPSPMD_FORCE_INLINE vbool operator==(const vfloat& a, float b) { return a == vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vbool operator!=(const vfloat& a, const vfloat& b) { return !vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_EQ_OQ)) }; }
+CPPSPMD_FORCE_INLINE vbool operator!=(const vfloat& a, float b) { return a != vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vbool operator<(const vfloat& a, const vfloat& b) { return vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_LT_OS)) }; }
+CPPSPMD_FORCE_INLINE vbool operator<(const vfloat& a, float b) { return a < vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vbool operator>(const vfloat& a, const vfloat& b) { return vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_GT_OS)) }; }
+CPPSPMD_FORCE_INLINE vbool operator>(const vfloat& a, float b) { return a > vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vbool operator<=(const vfloat& a, const vfloat& b) { return vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_LE_OS)) }; }
+CPPSPMD_FORCE_INLINE vbool operator<=(const vfloat& a, float b) { return a <= vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vbool operator>=(const vfloat& a, const vfloat& b) { return vbool{ _mm256_castps_si256(_mm256_cmp_ps(a.m_value, b.m_value, _CMP_GE_OS)) }; }
+CPPSPMD_FORCE_INLINE vbool operator>=(const vfloat& a, float b) { return a >= vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vfloat spmd_ternaryf(const vbool& cond, const vfloat& a, const vfloat& b) { return vfloat{ blendv_mask_ps(b.m_value, a.m_value, _mm256_castsi256_ps(cond.m_value)) }; }
+CPPSPMD_FORCE_INLINE vint spmd_ternaryi(const vbool& cond, const vint& a, const vint& b) { return vint{ blendv_mask_epi32(b.m_value, a.m_value, cond.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vfloat sqrt(const vfloat& v) { return vfloat{ _mm256_sqrt_ps(v.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat abs(const vfloat& v) { return vfloat{ _mm256_andnot_ps(_mm256_set1_ps(-0.0f), v.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat max(const vfloat& a, const vfloat& b) { return vfloat{ _mm256_max_ps(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat min(const vfloat& a, const vfloat& b) {	return vfloat{ _mm256_min_ps(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vfloat floor(const vfloat& v) { return vfloat{ _mm256_floor_ps(v.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat ceil(const vfloat& a) { return vfloat{ _mm256_ceil_ps(a.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat round_nearest(const vfloat &a) { return vfloat{ _mm256_round_ps(a.m_value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) }; }
+CPPSPMD_FORCE_INLINE vfloat round_truncate(const vfloat &a) { return vfloat{ _mm256_round_ps(a.m_value, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC ) }; }
+
+CPPSPMD_FORCE_INLINE vfloat frac(const vfloat& a) { return a - floor(a); }
+CPPSPMD_FORCE_INLINE vfloat fmod(vfloat a, vfloat b) { vfloat c = frac(abs(a / b)) * abs(b); return spmd_ternaryf(a < 0, -c, c); }
+CPPSPMD_FORCE_INLINE vfloat sign(const vfloat& a) { return spmd_ternaryf(a < 0.0f, 1.0f, 1.0f); }
+
+CPPSPMD_FORCE_INLINE vint max(const vint& a, const vint& b) { return vint{ max_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint min(const vint& a, const vint& b) {	return vint{ min_epi32(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint maxu(const vint& a, const vint& b) { return vint{ max_epu32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint minu(const vint& a, const vint& b) { return vint{ min_epu32(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint abs(const vint& v) { return vint{ abs_epi32(v.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint byteswap(const vint& v) {	return vint{ shuffle_epi8(v.m_value, broadcast_si128(_mm_set_epi8(12, 13, 14, 15,  8,  9, 10, 11,  4,  5,  6,  7,  0,  1,  2,  3))) }; }
+
+CPPSPMD_FORCE_INLINE vint cast_vfloat_to_vint(const vfloat& v) { return vint{ _mm256_castps_si256(v.m_value) }; }
+CPPSPMD_FORCE_INLINE vfloat cast_vint_to_vfloat(const vint& v) { return vfloat{ _mm256_castsi256_ps(v.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vfloat clamp(const vfloat& v, const vfloat& a, const vfloat& b)
+{
+	return vfloat{ _mm256_min_ps(b.m_value, _mm256_max_ps(v.m_value, a.m_value) ) };
+}
+
+CPPSPMD_FORCE_INLINE vint clamp(const vint& v, const vint& a, const vint& b)
+{
+	return vint{ min_epi32(b.m_value, max_epi32(v.m_value, a.m_value) ) };
+}
+
+// These are true fused multiply-adds (single rounding), unlike the SSE versions.
+CPPSPMD_FORCE_INLINE vfloat vfma(const vfloat& a, const vfloat& b, const vfloat& c)
+{
+	return vfloat{ _mm256_fmadd_ps(a.m_value, b.m_value, c.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vfloat vfms(const vfloat& a, const vfloat& b, const vfloat& c)
+{
+	return vfloat{ _mm256_fmsub_ps(a.m_value, b.m_value, c.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vfloat vfnma(const vfloat& a, const vfloat& b, const vfloat& c)
+{
+	return vfloat{ _mm256_fnmadd_ps(a.m_value, b.m_value, c.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vfloat vfnms(const vfloat& a, const vfloat& b, const vfloat& c)
+{
+	return vfloat{ _mm256_fnmsub_ps(a.m_value, b.m_value, c.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vfloat lerp(const vfloat &x, const vfloat &y, const vfloat &s) { return vfma(y - x, s, x); }
+
+CPPSPMD_FORCE_INLINE lint operator+(int a, const lint& b) { return lint{ _mm256_add_epi32(_mm256_set1_epi32(a), b.m_value) }; }
+CPPSPMD_FORCE_INLINE lint operator+(const lint& a, int b) { return lint{ _mm256_add_epi32(a.m_value, _mm256_set1_epi32(b)) }; }
+CPPSPMD_FORCE_INLINE vfloat operator+(float a, const lint& b) { return vfloat(a) + vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator+(const lint& a, float b) { return vfloat(a) + vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator*(const lint& a, float b) { return vfloat(a) * vfloat(b); }
+CPPSPMD_FORCE_INLINE vfloat operator*(float b, const lint& a) { return vfloat(a) * vfloat(b); }
+
+CPPSPMD_FORCE_INLINE vint operator&(const vint& a, const vint& b) { return vint{ _mm256_and_si256(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator&(const vint& a, int b) { return a & vint(b); }
+CPPSPMD_FORCE_INLINE vint andnot(const vint& a, const vint& b) { return vint{ _mm256_andnot_si256(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator|(const vint& a, const vint& b) { return vint{ _mm256_or_si256(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator|(const vint& a, int b) { return a | vint(b); }
+CPPSPMD_FORCE_INLINE vint operator^(const vint& a, const vint& b) { return vint{ _mm256_xor_si256(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator^(const vint& a, int b) { return a ^ vint(b); }
+CPPSPMD_FORCE_INLINE vbool operator==(const vint& a, const vint& b) { return vbool{ _mm256_cmpeq_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator!=(const vint& a, const vint& b) { return !vbool{ _mm256_cmpeq_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator<(const vint& a, const vint& b) { return vbool{ _mm256_cmpgt_epi32(b.m_value, a.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator<=(const vint& a, const vint& b) { return !vbool{ _mm256_cmpgt_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator>=(const vint& a, const vint& b) { return !vbool{ _mm256_cmpgt_epi32(b.m_value, a.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator>(const vint& a, const vint& b) { return vbool{ _mm256_cmpgt_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator+(const vint& a, const vint& b) { return vint{ _mm256_add_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator-(const vint& a, const vint& b) { return vint{ _mm256_sub_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator+(const vint& a, int b) { return a + vint(b); }
+CPPSPMD_FORCE_INLINE vint operator-(const vint& a, int b) { return a - vint(b); }
+CPPSPMD_FORCE_INLINE vint operator+(int a, const vint& b) { return vint(a) + b; }
+CPPSPMD_FORCE_INLINE vint operator-(int a, const vint& b) { return vint(a) - b; }
+CPPSPMD_FORCE_INLINE vint operator*(const vint& a, const vint& b) { return vint{ mullo_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint operator*(const vint& a, int b) { return a * vint(b); }
+CPPSPMD_FORCE_INLINE vint operator*(int a, const vint& b) { return vint(a) * b; }
+
+CPPSPMD_FORCE_INLINE vint mulhiu(const vint& a, const vint& b) { return vint{ mulhi_epu32(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint operator-(const vint& v) { return vint{ _mm256_sub_epi32(_mm256_setzero_si256(), v.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint operator~(const vint& a) { return vint{ -a - 1 }; }
+
+// A few of these break the lane-based abstraction model. They are supported in SSE2, so it makes sense to support them and let the user figure it out.
+CPPSPMD_FORCE_INLINE vint adds_epu8(const vint& a, const vint& b) {	return vint{ _mm256_adds_epu8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint subs_epu8(const vint& a, const vint& b) { return vint{ _mm256_subs_epu8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint avg_epu8(const vint & a, const vint & b) { return vint{ _mm256_avg_epu8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint max_epu8(const vint& a, const vint& b) { return vint{ _mm256_max_epu8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint min_epu8(const vint& a, const vint& b) { return vint{ _mm256_min_epu8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint sad_epu8(const vint& a, const vint& b) { return vint{ _mm256_sad_epu8(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint add_epi8(const vint& a, const vint& b) { return vint{ _mm256_add_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint adds_epi8(const vint& a, const vint& b) { return vint{ _mm256_adds_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint sub_epi8(const vint& a, const vint& b) { return vint{ _mm256_sub_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint subs_epi8(const vint& a, const vint& b) { return vint{ _mm256_subs_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmpeq_epi8(const vint& a, const vint& b) { return vint{ _mm256_cmpeq_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmpgt_epi8(const vint& a, const vint& b) { return vint{ _mm256_cmpgt_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmplt_epi8(const vint& a, const vint& b) { return vint{ _mm256_cmpgt_epi8(b.m_value, a.m_value) }; }
+CPPSPMD_FORCE_INLINE vint unpacklo_epi8(const vint& a, const vint& b) { return vint{ _mm256_unpacklo_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint unpackhi_epi8(const vint& a, const vint& b) { return vint{ _mm256_unpackhi_epi8(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE int movemask_epi8(const vint& a) { return _mm256_movemask_epi8(a.m_value); }
+CPPSPMD_FORCE_INLINE int movemask_epi32(const vint& a) { return _mm256_movemask_ps(_mm256_castsi256_ps(a.m_value)); }
+
+CPPSPMD_FORCE_INLINE vint cmple_epu8(const vint& a, const vint& b) { return vint{ _mm256_cmpeq_epi8(_mm256_min_epu8(a.m_value, b.m_value), a.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmpge_epu8(const vint& a, const vint& b) { return vint{ cmple_epu8(b, a) }; }
+CPPSPMD_FORCE_INLINE vint cmpgt_epu8(const vint& a, const vint& b) { return vint{ _mm256_andnot_si256(_mm256_cmpeq_epi8(a.m_value, b.m_value), _mm256_cmpeq_epi8(_mm256_max_epu8(a.m_value, b.m_value), a.m_value)) }; }
+CPPSPMD_FORCE_INLINE vint cmplt_epu8(const vint& a, const vint& b) { return vint{ cmpgt_epu8(b, a) }; }
+CPPSPMD_FORCE_INLINE vint absdiff_epu8(const vint& a, const vint& b) { return vint{ _mm256_or_si256(_mm256_subs_epu8(a.m_value, b.m_value), _mm256_subs_epu8(b.m_value, a.m_value)) }; }
+
+CPPSPMD_FORCE_INLINE vint blendv_epi8(const vint& a, const vint& b, const vint &mask) { return vint{ blendv_epi8(a.m_value, b.m_value, mask.m_value) }; }
+CPPSPMD_FORCE_INLINE vint blendv_epi32(const vint& a, const vint& b, const vint &mask) { return vint{ blendv_epi32(a.m_value, b.m_value, mask.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint add_epi16(const vint& a, const vint& b) { return vint{ _mm256_add_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint adds_epi16(const vint& a, const vint& b) { return vint{ _mm256_adds_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint adds_epu16(const vint& a, const vint& b) { return vint{ _mm256_adds_epu16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint avg_epu16(const vint& a, const vint& b) { return vint{ _mm256_avg_epu16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint sub_epi16(const vint& a, const vint& b) { return vint{ _mm256_sub_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint subs_epi16(const vint& a, const vint& b) { return vint{ _mm256_subs_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint subs_epu16(const vint& a, const vint& b) { return vint{ _mm256_subs_epu16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint mullo_epi16(const vint& a, const vint& b) { return vint{ _mm256_mullo_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint mulhi_epi16(const vint& a, const vint& b) { return vint{ _mm256_mulhi_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint mulhi_epu16(const vint& a, const vint& b) { return vint{ _mm256_mulhi_epu16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint min_epi16(const vint& a, const vint& b) { return vint{ _mm256_min_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint max_epi16(const vint& a, const vint& b) { return vint{ _mm256_max_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint madd_epi16(const vint& a, const vint& b) { return vint{ _mm256_madd_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmpeq_epi16(const vint& a, const vint& b) { return vint{ _mm256_cmpeq_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmpgt_epi16(const vint& a, const vint& b) { return vint{ _mm256_cmpgt_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint cmplt_epi16(const vint& a, const vint& b) { return vint{ _mm256_cmpgt_epi16(b.m_value, a.m_value) }; }
+CPPSPMD_FORCE_INLINE vint packs_epi16(const vint& a, const vint& b) { return vint{ _mm256_packs_epi16(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vint packus_epi16(const vint& a, const vint& b) { return vint{ _mm256_packus_epi16(a.m_value, b.m_value) }; }
+
+CPPSPMD_FORCE_INLINE vint uniform_shift_left_epi16(const vint& a, const vint& b) { return vint{ _mm256_sll_epi16(a.m_value, _mm256_castsi256_si128(b.m_value)) }; }
+CPPSPMD_FORCE_INLINE vint uniform_arith_shift_right_epi16(const vint& a, const vint& b) { return vint{ _mm256_sra_epi16(a.m_value, _mm256_castsi256_si128(b.m_value)) }; }
+CPPSPMD_FORCE_INLINE vint uniform_shift_right_epi16(const vint& a, const vint& b) { return vint{ _mm256_srl_epi16(a.m_value, _mm256_castsi256_si128(b.m_value)) }; }
+
+#define VINT_SHIFT_LEFT_EPI16(a, b) vint(_mm256_slli_epi16((a).m_value, b))
+#define VINT_SHIFT_RIGHT_EPI16(a, b) vint(_mm256_srai_epi16((a).m_value, b))
+#define VUINT_SHIFT_RIGHT_EPI16(a, b) vint(_mm256_srli_epi16((a).m_value, b))
+
+CPPSPMD_FORCE_INLINE vint undefined_vint() { return vint{ _mm256_undefined_si256() }; }
+CPPSPMD_FORCE_INLINE vfloat undefined_vfloat() { return vfloat{ _mm256_undefined_ps() }; }
+
+CPPSPMD_FORCE_INLINE vint zero_vint() { return vint{ _mm256_setzero_si256() }; }
+CPPSPMD_FORCE_INLINE vfloat zero_vfloat() { return vfloat{ _mm256_setzero_ps() }; }
+
+CPPSPMD_FORCE_INLINE vint vint_lane_set(int v0, int v1, int v2, int v3, int v4, int v5, int v6, int v7) { return vint{ _mm256_set_epi32(v7, v6, v5, v4, v3, v2, v1, v0) }; }
+CPPSPMD_FORCE_INLINE vfloat vfloat_lane_set(float v0, float v1, float v2, float v3, float v4, float v5, float v6, float v7) { return vfloat{ _mm256_set_ps(v7, v6, v5, v4, v3, v2, v1, v0) }; }
+CPPSPMD_FORCE_INLINE vint vint_lane_set_r(int v7, int v6, int v5, int v4, int v3, int v2, int v1, int v0) { return vint{ _mm256_set_epi32(v7, v6, v5, v4, v3, v2, v1, v0) }; }
+CPPSPMD_FORCE_INLINE vfloat vfloat_lane_set_r(float v7, float v6, float v5, float v4, float v3, float v2, float v1, float v0) { return vfloat{ _mm256_set_ps(v7, v6, v5, v4, v3, v2, v1, v0) }; }
+// control is an 8-bit immediate value containing 4 2-bit indices which shuffles the int32's in each 128-bit lane.
+#define VINT_LANE_SHUFFLE_EPI32(a, control) vint(_mm256_shuffle_epi32((a).m_value, control))
+#define VFLOAT_LANE_SHUFFLE_PS(a, b, control) vfloat(_mm256_shuffle_ps((a).m_value, (b).m_value, control))
+
+// control is an 8-bit immediate value containing 4 2-bit indices which shuffles the int16's in either the high or low 64-bit lane.
+#define VINT_LANE_SHUFFLELO_EPI16(a, control) vint(_mm256_shufflelo_epi16((a).m_value, control))
+#define VINT_LANE_SHUFFLEHI_EPI16(a, control) vint(_mm256_shufflehi_epi16((a).m_value, control))
+
+#define VINT_LANE_SHUFFLE_MASK(a, b, c, d) ((a) | ((b) << 2) | ((c) << 4) | ((d) << 6))
+#define VINT_LANE_SHUFFLE_MASK_R(d, c, b, a) ((a) | ((b) << 2) | ((c) << 4) | ((d) << 6))
+
+#define VINT_LANE_SHIFT_LEFT_BYTES(a, l) vint(_mm256_slli_si256((a).m_value, l))
+#define VINT_LANE_SHIFT_RIGHT_BYTES(a, l) vint(_mm256_srli_si256((a).m_value, l))
+
+// Unpack and interleave 8-bit integers from the low or high half of a and b
+CPPSPMD_FORCE_INLINE vint vint_lane_unpacklo_epi8(const vint& a, const vint& b) { return vint(_mm256_unpacklo_epi8(a.m_value, b.m_value)); }
+CPPSPMD_FORCE_INLINE vint vint_lane_unpackhi_epi8(const vint& a, const vint& b) { return vint(_mm256_unpackhi_epi8(a.m_value, b.m_value)); }
+
+// Unpack and interleave 16-bit integers from the low or high half of a and b
+CPPSPMD_FORCE_INLINE vint vint_lane_unpacklo_epi16(const vint& a, const vint& b) { return vint(_mm256_unpacklo_epi16(a.m_value, b.m_value)); }
+CPPSPMD_FORCE_INLINE vint vint_lane_unpackhi_epi16(const vint& a, const vint& b) { return vint(_mm256_unpackhi_epi16(a.m_value, b.m_value)); }
+
+// Unpack and interleave 32-bit integers from the low or high half of a and b
+CPPSPMD_FORCE_INLINE vint vint_lane_unpacklo_epi32(const vint& a, const vint& b) { return vint(_mm256_unpacklo_epi32(a.m_value, b.m_value)); }
+CPPSPMD_FORCE_INLINE vint vint_lane_unpackhi_epi32(const vint& a, const vint& b) { return vint(_mm256_unpackhi_epi32(a.m_value, b.m_value)); }
+
+// Unpack and interleave 64-bit integers from the low or high half of a and b
+CPPSPMD_FORCE_INLINE vint vint_lane_unpacklo_epi64(const vint& a, const vint& b) { return vint(_mm256_unpacklo_epi64(a.m_value, b.m_value)); }
+CPPSPMD_FORCE_INLINE vint vint_lane_unpackhi_epi64(const vint& a, const vint& b) { return vint(_mm256_unpackhi_epi64(a.m_value, b.m_value)); }
+
+CPPSPMD_FORCE_INLINE vint vint_set1_epi8(int8_t a) { return vint(_mm256_set1_epi8(a)); }
+CPPSPMD_FORCE_INLINE vint vint_set1_epi16(int16_t a) { return vint(_mm256_set1_epi16(a)); }
+CPPSPMD_FORCE_INLINE vint vint_set1_epi32(int32_t a) { return vint(_mm256_set1_epi32(a)); }
+CPPSPMD_FORCE_INLINE vint vint_set1_epi64(int64_t a) { return vint(_mm256_set1_epi64x(a)); }
+
+CPPSPMD_FORCE_INLINE vint mul_epu32(const vint &a, const vint& b) { return vint(_mm256_mul_epu32(a.m_value, b.m_value)); }
+
+CPPSPMD_FORCE_INLINE vint div_epi32(const vint &a, const vint& b)
+{
+	__m256d al = _mm256_cvtepi32_pd(_mm256_castsi256_si128(a.m_value));
+	__m256d ah = _mm256_cvtepi32_pd(_mm256_extracti128_si256(a.m_value, 1));
+
+	__m256d bl = _mm256_cvtepi32_pd(_mm256_castsi256_si128(b.m_value));
+	__m256d bh = _mm256_cvtepi32_pd(_mm256_extracti128_si256(b.m_value, 1));
+
+	__m128i rli = _mm256_cvttpd_epi32(_mm256_div_pd(al, bl));
+	__m128i rhi = _mm256_cvttpd_epi32(_mm256_div_pd(ah, bh));
+
+	return vint(_mm256_inserti128_si256(_mm256_castsi128_si256(rli), rhi, 1));
+}
+
+CPPSPMD_FORCE_INLINE vint mod_epi32(const vint &a, const vint& b)
+{
+	vint aa = abs(a), ab = abs(b);
+	vint q = div_epi32(aa, ab);
+	vint r = aa - q * ab;
+	return spmd_ternaryi(a < 0, -r, r);
+}
+
+CPPSPMD_FORCE_INLINE vint operator/ (const vint& a, const vint& b)
+{
+	return div_epi32(a, b);
+}
+
+CPPSPMD_FORCE_INLINE vint operator/ (const vint& a, int b)
+{
+	return div_epi32(a, vint(b));
+}
+
+CPPSPMD_FORCE_INLINE vint operator% (const vint& a, const vint& b)
+{
+	return mod_epi32(a, b);
+}
+
+CPPSPMD_FORCE_INLINE vint operator% (const vint& a, int b)
+{
+	return mod_epi32(a, vint(b));
+}
+
+// AVX2 has native per-lane variable shifts.
+CPPSPMD_FORCE_INLINE vint operator<< (const vint& a, const vint& b)
+{
+	return vint{ _mm256_sllv_epi32(a.m_value, b.m_value) };
+}
+
+// uniform shift left
+CPPSPMD_FORCE_INLINE vint operator<< (const vint& a, int b)
+{
+	return vint{ _mm256_sll_epi32(a.m_value, _mm_cvtsi32_si128(b)) };
+}
+
+// uniform arithmetic shift right
+CPPSPMD_FORCE_INLINE vint operator>> (const vint& a, int b)
+{
+	return vint{ _mm256_sra_epi32(a.m_value, _mm_cvtsi32_si128(b)) };
+}
+
+// uniform shift right
+CPPSPMD_FORCE_INLINE vint vuint_shift_right(const vint& a, int b)
+{
+	return vint{ _mm256_srl_epi32(a.m_value, _mm_cvtsi32_si128(b)) };
+}
+
+CPPSPMD_FORCE_INLINE vint vuint_shift_right(const vint& a, const vint& b)
+{
+	return vint{ _mm256_srlv_epi32(a.m_value, b.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vint vuint_shift_right_not_zero(const vint& a, const vint& b)
+{
+	return vint{ _mm256_srlv_epi32(a.m_value, b.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE vint operator>> (const vint& a, const vint& b)
+{
+	return vint{ _mm256_srav_epi32(a.m_value, b.m_value) };
+}
+
+#undef VINT_SHIFT_LEFT
+#undef VINT_SHIFT_RIGHT
+#undef VUINT_SHIFT_RIGHT
+
+// Shift left/right by a uniform immediate constant
+#define VINT_SHIFT_LEFT(a, b) vint(_mm256_slli_epi32( (a).m_value, (b) ) )
+#define VINT_SHIFT_RIGHT(a, b) vint( _mm256_srai_epi32( (a).m_value, (b) ) )
+#define VUINT_SHIFT_RIGHT(a, b) vint( _mm256_srli_epi32( (a).m_value, (b) ) )
+#define VINT_ROT(x, k) (VINT_SHIFT_LEFT((x), (k)) | VUINT_SHIFT_RIGHT((x), 32 - (k)))
+
+CPPSPMD_FORCE_INLINE vbool operator==(const lint& a, const lint& b) { return vbool{ _mm256_cmpeq_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator==(const lint& a, int b) { return vint(a) == vint(b); }
+CPPSPMD_FORCE_INLINE vbool operator==(int a, const lint& b) { return vint(a) == vint(b); }
+CPPSPMD_FORCE_INLINE vbool operator<(const lint& a, const lint& b) { return vbool{ _mm256_cmpgt_epi32(b.m_value, a.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator>(const lint& a, const lint& b) { return vbool{ _mm256_cmpgt_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator<=(const lint& a, const lint& b) { return !vbool{ _mm256_cmpgt_epi32(a.m_value, b.m_value) }; }
+CPPSPMD_FORCE_INLINE vbool operator>=(const lint& a, const lint& b) { return !vbool{ _mm256_cmpgt_epi32(b.m_value, a.m_value) }; }
+
+CPPSPMD_FORCE_INLINE float extract(const vfloat& v, int instance) { assert(instance < 8); CPPSPMD_ALIGN(32) float values[8]; _mm256_store_ps(values, v.m_value); return values[instance]; }
+CPPSPMD_FORCE_INLINE int extract(const vint& v, int instance) { assert(instance < 8); CPPSPMD_ALIGN(32) int values[8]; _mm256_store_si256((__m256i*)values, v.m_value); return values[instance]; }
+CPPSPMD_FORCE_INLINE int extract(const lint& v, int instance) { assert(instance < 8); CPPSPMD_ALIGN(32) int values[8]; _mm256_store_si256((__m256i*)values, v.m_value); return values[instance]; }
+CPPSPMD_FORCE_INLINE bool extract(const vbool& v, int instance) { assert(instance < 8); CPPSPMD_ALIGN(32) int values[8]; _mm256_store_si256((__m256i*)values, v.m_value); return values[instance] != 0; }
+
+#undef VINT_EXTRACT
+#undef VBOOL_EXTRACT
+#undef VFLOAT_EXTRACT
+
+CPPSPMD_FORCE_INLINE float cast_int_bits_as_float(int v) { return *(const float*)&v; }
+
+// Pass in an immediate constant.
+#define VINT_EXTRACT(v, instance) _mm256_extract_epi32((v).m_value, instance)
+#define VBOOL_EXTRACT(v, instance) _mm256_extract_epi32((v).m_value, instance)
+#define VFLOAT_EXTRACT(v, instance) cast_int_bits_as_float(_mm256_extract_epi32(_mm256_castps_si256((v).m_value), instance))
+
+CPPSPMD_FORCE_INLINE vfloat &insert(vfloat& v, int instance, float f)
+{
+	assert(instance < 8);
+	CPPSPMD_ALIGN(32) float values[8];
+	_mm256_store_ps(values, v.m_value);
+	values[instance] = f;
+	v.m_value = _mm256_load_ps(values);
+	return v;
+}
+
+CPPSPMD_FORCE_INLINE vint &insert(vint& v, int instance, int i)
+{
+	assert(instance < 8);
+	CPPSPMD_ALIGN(32) int values[8];
+	_mm256_store_si256((__m256i *)values, v.m_value);
+	values[instance] = i;
+	v.m_value = _mm256_load_si256((__m256i *)values);
+	return v;
+}
+
+// The 16-byte tables are replicated into both 128-bit halves, because _mm256_shuffle_epi8() can't cross them.
+CPPSPMD_FORCE_INLINE vint init_lookup4(const uint8_t pTab[16])
+{
+	return vint{ broadcast_si128(_mm_loadu_si128((const __m128i*)pTab)) };
+}
+
+CPPSPMD_FORCE_INLINE vint table_lookup4_8(const vint& a, const vint& table)
+{
+	return vint{ shuffle_epi8(table.m_value, a.m_value) };
+}
+
+CPPSPMD_FORCE_INLINE void init_lookup5(const uint8_t pTab[32], vint& table_0, vint& table_1)
+{
+	table_0.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)pTab));
+	table_1.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)(pTab + 16)));
+}
+
+CPPSPMD_FORCE_INLINE vint table_lookup5_8(const vint& a, const vint& table_0, const vint& table_1)
+{
+	__m256i l_0 = shuffle_epi8(table_0.m_value, a.m_value);
+	__m256i h_0 = shuffle_epi8(table_1.m_value, a.m_value);
+
+	__m256i m_0 = _mm256_slli_epi32(a.m_value, 31 - 4);
+
+	__m256 v_0 = blendv_ps(_mm256_castsi256_ps(l_0), _mm256_castsi256_ps(h_0), _mm256_castsi256_ps(m_0));
+
+	return vint{ _mm256_castps_si256(v_0) };
+}
+
+CPPSPMD_FORCE_INLINE void init_lookup6(const uint8_t pTab[64], vint& table_0, vint& table_1, vint& table_2, vint& table_3)
+{
+	table_0.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)pTab));
+	table_1.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)(pTab + 16)));
+	table_2.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)(pTab + 32)));
+	table_3.m_value = broadcast_si128(_mm_loadu_si128((const __m128i*)(pTab + 48)));
+}
+
+CPPSPMD_FORCE_INLINE vint table_lookup6_8(const vint& a, const vint& table_0, const vint& table_1, const vint& table_2, const vint& table_3)
+{
+	__m256i m_0 = _mm256_slli_epi32(a.m_value, 31 - 4);
+
+	__m256 av_0;
+	{
+		__m256i al_0 = shuffle_epi8(table_0.m_value, a.m_value);
+		__m256i ah_0 = shuffle_epi8(table_1.m_value, a.m_value);
+		av_0 = blendv_ps(_mm256_castsi256_ps(al_0), _mm256_castsi256_ps(ah_0), _mm256_castsi256_ps(m_0));
+	}
+
+	__m256 bv_0;
+	{
+		__m256i bl_0 = shuffle_epi8(table_2.m_value, a.m_value);
+		__m256i bh_0 = shuffle_epi8(table_3.m_value, a.m_value);
+		bv_0 = blendv_ps(_mm256_castsi256_ps(bl_0), _mm256_castsi256_ps(bh_0), _mm256_castsi256_ps(m_0));
+	}
+
+	__m256i m2_0 = _mm256_slli_epi32(a.m_value, 31 - 5);
+	__m256 v2_0 = blendv_ps(av_0, bv_0, _mm256_castsi256_ps(m2_0));
+
+	return vint{ _mm256_castps_si256(v2_0) };
+}
+
+template<typename SPMDKernel, typename... Args>
+CPPSPMD_FORCE_INLINE void spmd_call(Args&&... args)
+{
+	SPMDKernel kernel;
+	kernel.init(exec_mask::all_on());
+	kernel._call(std::forward<Args>(args)...);
+}
+
+CPPSPMD_FORCE_INLINE void spmd_kernel::init(const spmd_kernel::exec_mask& kernel_exec)
+{
+	m_exec = kernel_exec;
+	m_kernel_exec = kernel_exec;
+	m_continue_mask = exec_mask::all_off();
+
+#ifdef _DEBUG
+	m_in_loop = false;
+#endif
+}
+
+CPPSPMD_FORCE_INLINE const float_vref& spmd_kernel::store(const float_vref& dst, const vfloat& src)
+{
+	CPPSPMD_ALIGN(32) int vindex[8];
+	_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+	CPPSPMD_ALIGN(32) float stored[8];
+	_mm256_store_ps(stored, src.m_value);
+
+	int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+	for (int i = 0; i < 8; i++)
+	{
+		if (mask & (1 << i))
+			dst.m_pValue[vindex[i]] = stored[i];
+	}
+	return dst;
+}
+
+CPPSPMD_FORCE_INLINE const float_vref& spmd_kernel::store_all(const float_vref& dst, const vfloat& src)
+{
+	CPPSPMD_ALIGN(32) int vindex[8];
+	_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+	CPPSPMD_ALIGN(32) float stored[8];
+	_mm256_store_ps(stored, src.m_value);
+
+	for (int i = 0; i < 8; i++)
+		dst.m_pValue[vindex[i]] = stored[i];
+	return dst;
+}
+
+CPPSPMD_FORCE_INLINE const float_vref& spmd_kernel::store(const float_vref&& dst, const vfloat& src)
+{
+	CPPSPMD_ALIGN(32) int vindex[8];
+	_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+	CPPSPMD_ALIGN(32) float stored[8];
+	_mm256_store_ps(stored, src.m_value);
+
+	int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m_exec.m_mask));
+	for (int i = 0; i < 8; i++)
+	{
+		if (mask & (1 << i))
+			dst.m_pValue[vindex[i]] = stored[i];
+	}
+	return dst;
+}
+
+CPPSPMD_FORCE_INLINE const float_vref& spmd_kernel::store_all(const float_vref&& dst, const vfloat& src)
+{
+	CPPSPMD_ALIGN(32) int vindex[8];
+	_mm256_store_si256((__m256i*)vindex, dst.m_vindex);
+
+	CPPSPMD_ALIGN(32) float stored[8];
+	_mm256_store_ps(stored, src.m_value);
+
+	for (int i = 0; i < 8; i++)
+		dst.m_pValue[vindex[i]] = stored[i];
+	return dst;
+}
+
+#include "cppspmd_flow.h"
+#include "cppspmd_math.h"
+
+} // namespace cppspmd_avx2
@@ -383,6 +383,11 @@ namespace basisu
 		return (pBytes[3] << 24U) | (pBytes[2] << 16U) | (pBytes[1] << 8U) | (pBytes[0]);
 	}
 
+	static inline uint64_t read_le_qword(const uint8_t* pBytes)
+	{
+		return (uint64_t)read_le_dword(pBytes) | ((uint64_t)read_le_dword(pBytes + 4) << 32U);
+	}
+
 	static inline void write_le_dword(uint8_t* pBytes, uint32_t val)
 	{
 		pBytes[0] = (uint8_t)val;
@@ -251,6 +251,36 @@ namespace basist
 		basisu::packed_uint<4>      m_extended_file_size;		// The file size in bytes of the "extended" header and compressed data, for future use
 	};
 
+	// Standalone ETC1S global codebook file: a shared endpoint/selector codebook trained once over a set of textures (see 
+	// basisu::basis_train_etc1s_global_codebooks()), which .basis files encoded against it reference instead of carrying their own 
+	// (cBASISHeaderFlagUsesGlobalCodebook). The compressed codebooks use the same format as the ones in .basis files.
+	struct basis_global_codebooks_header
+	{
+		enum
+		{
+			cSigValue = ('B' << 8) | 'c',
+			cFirstVersion = 0x10
+		};
+
+		basisu::packed_uint<2>      m_sig;				// 2 byte file signature
+		basisu::packed_uint<2>      m_ver;				// File version
+		basisu::packed_uint<2>      m_header_size;	// Header size in bytes, sizeof(basis_global_codebooks_header)
+		basisu::packed_uint<2>      m_header_crc16;	// CRC16 of the remaining header data
+
+		basisu::packed_uint<4>      m_data_size;		// The total size of all data after the header
+		basisu::packed_uint<2>      m_data_crc16;		// The CRC16 of all data after the header
+
+		basisu::packed_uint<2>      m_flags;			// cBASISHeaderFlagSRGB if the codebooks were trained with perceptual metrics
+
+		basisu::packed_uint<2>      m_total_endpoints;			// The number of endpoints in the endpoint codebook 
+		basisu::packed_uint<4>      m_endpoint_cb_file_ofs;	// The compressed endpoint codebook's file offset relative to the start of the file
+		basisu::packed_uint<3>      m_endpoint_cb_file_size;	// The compressed endpoint codebook's size in bytes
+
+		basisu::packed_uint<2>      m_total_selectors;			// The number of selectors in the selector codebook 
+		basisu::packed_uint<4>      m_selector_cb_file_ofs;	// The compressed selectors codebook's file offset relative to the start of the file
+		basisu::packed_uint<3>      m_selector_cb_file_size;	// The compressed selector codebook's size in bytes
+	};
+
 	const uint32_t cBASISKVDataSig = 0x564B;
 
 	struct basis_key_value_data_header
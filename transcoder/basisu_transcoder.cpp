@@ -159,12 +159,63 @@
 	#define BASISD_SUPPORT_UASTC_HDR 1
 #endif
 
+// Set BASISD_SUPPORT_THREADS to 0 to disable the built-in std::thread workers used by basisu_transcoder_parallel_for(), and the locking used by on-demand lookup table initialization.
+// Caller supplied job systems (basisu_transcoder_parallel_params::m_pParallel_for) still work, but the first transcode to each format must then happen on a single thread (or call basisu_transcoder_init() with a format list first).
+#ifndef BASISD_SUPPORT_THREADS
+	#if (defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)) || (defined(__wasi__) && !BASISU_WASI_THREADS)
+		#define BASISD_SUPPORT_THREADS 0
+	#else
+		#define BASISD_SUPPORT_THREADS 1
+	#endif
+#endif
+
+#if BASISD_SUPPORT_THREADS
+	#include <thread>
+	#include <atomic>
+	#include <mutex>
+	#include <vector>
+#endif
+
+// Set BASISD_SUPPORT_SSE to 1 to compile in SSE 4.1 versions of the ETC1S->BC1/BC3/BC4/BC5/BC7/ETC2 EAC/ASTC/ATC/PVRTC2 block conversion inner loops.
+// They're only used if the CPU supports SSE 4.1 (checked at runtime), and their output is bit-identical to the scalar code. Defaults to the encoder's BASISU_SUPPORT_SSE setting on x86/x64.
+#ifndef BASISD_SUPPORT_SSE
+	#if defined(BASISU_SUPPORT_SSE) && BASISU_SUPPORT_SSE && (defined(_M_AMD64) || defined(_M_IX86) || defined(__i386__) || defined(__x86_64__))
+		#define BASISD_SUPPORT_SSE 1
+	#else
+		#define BASISD_SUPPORT_SSE 0
+	#endif
+#endif
+
+#if BASISD_SUPPORT_SSE
+	#include <smmintrin.h>
+	#if defined(_MSC_VER)
+		#define BASISD_SSE41_FUNC
+	#else
+		#include <cpuid.h>
+		// Lets the SSE 4.1 kernels compile even if the rest of the transcoder isn't compiled with -msse4.1.
+		#define BASISD_SSE41_FUNC __attribute__((target("sse4.1")))
+	#endif
+#endif
+
 #define BASISD_WRITE_NEW_BC7_MODE5_TABLES			0
 #define BASISD_WRITE_NEW_DXT1_TABLES				0
 #define BASISD_WRITE_NEW_ETC2_EAC_A8_TABLES			0
 #define BASISD_WRITE_NEW_ASTC_TABLES				0
 #define BASISD_WRITE_NEW_ATC_TABLES					0
 #define BASISD_WRITE_NEW_ETC2_EAC_R11_TABLES		0
+#define BASISD_WRITE_NEW_PRECOMPUTED_TABLES			0
+
+#if BASISD_USE_PRECOMPUTED_TABLES
+	#if BASISD_WRITE_NEW_PRECOMPUTED_TABLES
+		#error BASISD_USE_PRECOMPUTED_TABLES must be 0 if BASISD_WRITE_NEW_PRECOMPUTED_TABLES is 1
+	#endif
+
+	// Defines the initializers of the computed lookup tables, see create_precomputed_tables().
+	#include "basisu_transcoder_tables_precomputed.inc"
+	#define BASISD_PRECOMPUTED_TABLE(name) = BASISD_PRECOMPUTED_##name
+#else
+	#define BASISD_PRECOMPUTED_TABLE(name)
+#endif
 
 #ifndef BASISD_ENABLE_DEBUG_FLAGS
 	// DO NOT CHECK IN
@@ -174,7 +225,7 @@
 // Zstd is used both for KTX2 supercompressed UASTC files and for Zstd-compressed data in other codecs (independent of KTX2 support), so include the header whenever Zstd usage is enabled -- not just when KTX2 is enabled.
 // If BASISD_SUPPORT_KTX2_ZSTD is 0, data compressed with Zstd cannot be loaded.
 #if BASISD_SUPPORT_KTX2_ZSTD
-	// We only use these Zstd API's: ZSTD_decompress(), ZSTD_isError() and ZSTD_getFrameContentSize()
+	// We only use these Zstd API's: ZSTD_decompress(), ZSTD_isError() and ZSTD_getFrameContentSize(), and for streaming KTX2 level decompression ZSTD_createDCtx(), ZSTD_freeDCtx(), ZSTD_DCtx_reset() and ZSTD_decompressStream()
 	#include "../zstd/zstd.h"
 #endif
 
@@ -1187,7 +1238,7 @@ namespace basist
 
 	const uint32_t NUM_ETC1_TO_DXT1_SELECTOR_RANGES = sizeof(g_etc1_to_dxt1_selector_ranges) / sizeof(g_etc1_to_dxt1_selector_ranges[0]);
 
-	static uint32_t g_etc1_to_dxt1_selector_range_index[4][4];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_etc1_to_dxt1_selector_range_index[4][4] BASISD_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_range_index);
 
 	const uint32_t NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS = 10;
 	static const uint8_t g_etc1_to_dxt1_selector_mappings[NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS][4] =
@@ -1204,8 +1255,8 @@ namespace basist
 		{ 1, 2, 3, 3 },
 	};
 	
-	static uint8_t g_etc1_to_dxt1_selector_mappings_raw_dxt1_256[NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS][256];
-	static uint8_t g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256[NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS][256];
+	static BASISD_PRECOMPUTED_CONST uint8_t g_etc1_to_dxt1_selector_mappings_raw_dxt1_256[NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS][256] BASISD_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_mappings_raw_dxt1_256);
+	static BASISD_PRECOMPUTED_CONST uint8_t g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256[NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS][256] BASISD_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256);
 
 	static const etc1_to_dxt1_56_solution g_etc1_to_dxt_6[32 * 8 * NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS * NUM_ETC1_TO_DXT1_SELECTOR_RANGES] = {
 #include "basisu_transcoder_tables_dxt1_6.inc"
@@ -1223,9 +1274,14 @@ namespace basist
 		uint8_t m_hi;
 		uint8_t m_lo;
 	};
-	static bc1_match_entry g_bc1_match5_equals_1[256], g_bc1_match6_equals_1[256]; // selector 1, allow equals hi/lo
-	static bc1_match_entry g_bc1_match5_equals_0[256], g_bc1_match6_equals_0[256]; // selector 0, allow equals hi/lo
-
+	// selector 1, allow equals hi/lo
+	static BASISD_PRECOMPUTED_CONST bc1_match_entry g_bc1_match5_equals_1[256] BASISD_PRECOMPUTED_TABLE(g_bc1_match5_equals_1);
+	static BASISD_PRECOMPUTED_CONST bc1_match_entry g_bc1_match6_equals_1[256] BASISD_PRECOMPUTED_TABLE(g_bc1_match6_equals_1);
+	// selector 0, allow equals hi/lo
+	static BASISD_PRECOMPUTED_CONST bc1_match_entry g_bc1_match5_equals_0[256] BASISD_PRECOMPUTED_TABLE(g_bc1_match5_equals_0);
+	static BASISD_PRECOMPUTED_CONST bc1_match_entry g_bc1_match6_equals_0[256] BASISD_PRECOMPUTED_TABLE(g_bc1_match6_equals_0);
+
+#if !BASISD_USE_PRECOMPUTED_TABLES
 	static void prepare_bc1_single_color_table(bc1_match_entry* pTable, const uint8_t* pExpand, int size0, int size1, int sel)
 	{
 		for (int i = 0; i < 256; i++)
@@ -1264,6 +1320,7 @@ namespace basist
 			} // lo
 		}
 	}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 #endif
 
 #if BASISD_WRITE_NEW_DXT1_TABLES
@@ -2056,7 +2113,7 @@ namespace basist
 	static void create_etc1_to_astc_conversion_table_0_255();
 #endif
 
-#if BASISD_SUPPORT_ASTC
+#if BASISD_SUPPORT_ASTC && !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_astc();
 #endif
 
@@ -2065,7 +2122,7 @@ namespace basist
 	static void create_etc1_to_bc7_m5_alpha_conversion_table();
 #endif
 
-#if BASISD_SUPPORT_BC7_MODE5
+#if BASISD_SUPPORT_BC7_MODE5 && !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_bc7_mode5();
 #endif
 
@@ -2073,11 +2130,11 @@ namespace basist
 	static void create_etc1s_to_atc_conversion_tables();
 #endif
 
-#if BASISD_SUPPORT_ATC
+#if BASISD_SUPPORT_ATC && !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_atc();
 #endif
 
-#if BASISD_SUPPORT_PVRTC2
+#if BASISD_SUPPORT_PVRTC2 && !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_pvrtc2();
 #endif
 
@@ -2088,11 +2145,17 @@ namespace basist
 #if BASISD_SUPPORT_UASTC_HDR	
 	namespace astc_6x6_hdr
 	{
+#if !BASISD_USE_PRECOMPUTED_TABLES
 		static void init_quantize_tables();
+#endif
 		static void fast_encode_bc6h_init();
 	}
 #endif
 
+#if BASISD_WRITE_NEW_PRECOMPUTED_TABLES
+	static void create_precomputed_tables();
+#endif
+
 #if BASISD_SUPPORT_BC7_MODE5
 	namespace bc7_mode_5_encoder
 	{
@@ -2106,35 +2169,327 @@ namespace basist
 	}
 
 	static bool g_transcoder_initialized;
-		
-	// Library global initialization. Requires ~9 milliseconds when compiled and executed natively on a Core i7 2.2 GHz.
-	// If this is too slow, these computed tables can easilky be moved to be compiled in.
-	void basisu_transcoder_init()
+
+	// The transcoder's computed lookup tables are split into families, which are only built the first time a source/target format combination needs them.
+	// If BASISD_USE_PRECOMPUTED_TABLES is 1 the BC1, ETC1SToBC7, ATC, PVRTC2, ETC1SToASTC and UASTC families (and the ASTC requantization tables) are compiled in, so there's nothing to build.
+	enum
+	{
+		cTableFamilyBC1 = 1,				// BC1 single color tables, ETC1S->BC1 selector mappings
+		cTableFamilyETC1SToBC7 = 2,			// ETC1S->BC7 mode 5 and the BC7 mode 5 encoder used by chroma filtering
+		cTableFamilyATC = 4,				// ATC and PVRTC2 single color tables
+		cTableFamilyPVRTC2 = 8,
+		cTableFamilyETC1SToASTC = 16,
+		cTableFamilyUASTC = 32,				// ASTC unquant tables and BC7 mode 5/6 optimal endpoints
+		cTableFamilyASTC = 64,				// astc_helpers dequant/partition tables, ASTC requantization tables
+		cTableFamilyBC6H = 128,
+		cTableFamilyXUASTC = 256,			// XUASTC/ASTC LDR decoding and transcoding tables
+		cTableFamilyLDREncoders = 512,		// Realtime BC7/ETC1 encoders used when transcoding XUASTC/ASTC LDR/XUBC7
+		cTableFamilyArith = 1024,
+
+		cTableFamilyAll = 2047
+	};
+
+#if BASISD_SUPPORT_THREADS
+	static std::atomic<uint32_t> g_initialized_table_families;
+	static std::mutex g_table_families_mutex;
+#else
+	static uint32_t g_initialized_table_families;
+#endif
+
+	static void init_table_family(uint32_t family)
 	{
-		if (g_transcoder_initialized)
+		switch (family)
 		{
-			BASISU_DEVEL_ERROR("basisu_transcoder::basisu_transcoder_init: Called more than once\n");      
-			return;
-		}
-         
-		BASISU_DEVEL_ERROR("basisu_transcoder::basisu_transcoder_init: Initializing (this is not an error)\n");      
+		case cTableFamilyBC1:
+		{
+#if !BASISD_USE_PRECOMPUTED_TABLES
+#if BASISD_SUPPORT_DXT1 || BASISD_SUPPORT_UASTC
+			uint8_t bc1_expand5[32];
+			for (int i = 0; i < 32; i++)
+				bc1_expand5[i] = static_cast<uint8_t>((i << 3) | (i >> 2));
+			prepare_bc1_single_color_table(g_bc1_match5_equals_1, bc1_expand5, 32, 32, 1);
+			prepare_bc1_single_color_table(g_bc1_match5_equals_0, bc1_expand5, 1, 32, 0);
+
+			uint8_t bc1_expand6[64];
+			for (int i = 0; i < 64; i++)
+				bc1_expand6[i] = static_cast<uint8_t>((i << 2) | (i >> 4));
+			prepare_bc1_single_color_table(g_bc1_match6_equals_1, bc1_expand6, 64, 64, 1);
+			prepare_bc1_single_color_table(g_bc1_match6_equals_0, bc1_expand6, 1, 64, 0);
+
+#if 0
+			for (uint32_t i = 0; i < 256; i++)
+			{
+				printf("%u %u %u\n", i, (i * 63 + 127) / 255, g_bc1_match6_equals_0[i].m_hi);
+			}
+			exit(0);
+#endif
 
-#if BASISD_SUPPORT_UASTC
-		uastc_init();
 #endif
 
+#if BASISD_SUPPORT_DXT1
+			for (uint32_t i = 0; i < NUM_ETC1_TO_DXT1_SELECTOR_RANGES; i++)
+			{
+				uint32_t l = g_etc1_to_dxt1_selector_ranges[i].m_low;
+				uint32_t h = g_etc1_to_dxt1_selector_ranges[i].m_high;
+				g_etc1_to_dxt1_selector_range_index[l][h] = i;
+			}
+
+			for (uint32_t sm = 0; sm < NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS; sm++)
+			{
+				uint8_t etc1_to_dxt1_selector_mappings_raw_dxt1[4];
+				uint8_t etc1_to_dxt1_selector_mappings_raw_dxt1_inv[4];
+
+				for (uint32_t j = 0; j < 4; j++)
+				{
+					static const uint8_t s_linear_dxt1_to_dxt1[4] = { 0, 2, 3, 1 };
+					static const uint8_t s_dxt1_inverted_xlat[4] = { 1, 0, 3, 2 };
+
+					etc1_to_dxt1_selector_mappings_raw_dxt1[j] = (uint8_t)s_linear_dxt1_to_dxt1[g_etc1_to_dxt1_selector_mappings[sm][j]];
+					etc1_to_dxt1_selector_mappings_raw_dxt1_inv[j] = (uint8_t)s_dxt1_inverted_xlat[etc1_to_dxt1_selector_mappings_raw_dxt1[j]];
+				}
+
+				for (uint32_t i = 0; i < 256; i++)
+				{
+					uint32_t k = 0, k_inv = 0;
+					for (uint32_t s = 0; s < 4; s++)
+					{
+						k |= (etc1_to_dxt1_selector_mappings_raw_dxt1[(i >> (s * 2)) & 3] << (s * 2));
+						k_inv |= (etc1_to_dxt1_selector_mappings_raw_dxt1_inv[(i >> (s * 2)) & 3] << (s * 2));
+					}
+					g_etc1_to_dxt1_selector_mappings_raw_dxt1_256[sm][i] = (uint8_t)k;
+					g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256[sm][i] = (uint8_t)k_inv;
+				}
+			}
+#endif
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
+			break;
+		}
+		case cTableFamilyETC1SToBC7:
+		{
+#if BASISD_SUPPORT_BC7_MODE5 && !BASISD_USE_PRECOMPUTED_TABLES
+			transcoder_init_bc7_mode5();
+			bc7_mode_5_encoder::encode_bc7_mode5_init();
+#endif
+			break;
+		}
+		case cTableFamilyATC:
+		{
+#if BASISD_SUPPORT_ATC && !BASISD_USE_PRECOMPUTED_TABLES
+			transcoder_init_atc();
+#endif
+			break;
+		}
+		case cTableFamilyPVRTC2:
+		{
+#if BASISD_SUPPORT_PVRTC2 && !BASISD_USE_PRECOMPUTED_TABLES
+			transcoder_init_pvrtc2();
+#endif
+			break;
+		}
+		case cTableFamilyETC1SToASTC:
+		{
+#if BASISD_SUPPORT_ASTC && !BASISD_USE_PRECOMPUTED_TABLES
+			transcoder_init_astc();
+#endif
+			break;
+		}
+		case cTableFamilyUASTC:
+		{
+#if BASISD_SUPPORT_UASTC && !BASISD_USE_PRECOMPUTED_TABLES
+			uastc_init();
+#endif
+			break;
+		}
+		case cTableFamilyASTC:
+		{
 #if BASISD_SUPPORT_UASTC_HDR
-		// TODO: Examine this, optimize for startup time/mem utilization.
-		// XUASTC LDR decompressors need the rank tables
-		astc_helpers::init_tables();
+			// XUASTC LDR decompressors need the rank tables
+			astc_helpers::init_tables();
+
+#if !BASISD_USE_PRECOMPUTED_TABLES
+			// Requires astc_helpers::g_dequant_tables
+			astc_6x6_hdr::init_quantize_tables();
+#endif
+#endif
+			break;
+		}
+		case cTableFamilyBC6H:
+		{
+#if BASISD_SUPPORT_UASTC_HDR
+			astc_hdr_core_init();
+			bc6h_enc_init();
+			fast_encode_bc6h_init();
+#endif
+			break;
+		}
+		case cTableFamilyXUASTC:
+		{
+#if BASISD_SUPPORT_XUASTC
+			astc_ldr_t::init();
+			astc_ldr_t::init_transcoding_tables();
+#endif
+			break;
+		}
+		case cTableFamilyLDREncoders:
+		{
+#if BASISD_SUPPORT_XUASTC
+			// Used by astc ldr transcoding
+			bc7f::init();
+			bc7u::init_weight_quant();
+			etc1f::init();
+#endif
+			break;
+		}
+		case cTableFamilyArith:
+		{
+#if BASISD_SUPPORT_XUASTC
+			// Used by arith encoder/decoder
+			arith_fastbits_f32::init();
+#endif
+			break;
+		}
+		default:
+			assert(0);
+			break;
+		}
+	}
+
+	// Thread safe. Builds any of the specified table families that haven't been built yet.
+	static void init_table_families(uint32_t families)
+	{
+		// Some families are built from others.
+		if (families & (cTableFamilyXUASTC | cTableFamilyLDREncoders))
+			families |= cTableFamilyASTC;
+		if (families & cTableFamilyPVRTC2)
+			families |= cTableFamilyATC;
+
+#if BASISD_SUPPORT_THREADS
+		if ((g_initialized_table_families.load(std::memory_order_acquire) & families) == families)
+			return;
 
-		astc_hdr_core_init();
+		std::lock_guard<std::mutex> lock(g_table_families_mutex);
+
+		uint32_t initialized_families = g_initialized_table_families.load(std::memory_order_relaxed);
+#else
+		uint32_t initialized_families = g_initialized_table_families;
 #endif
 
-#if BASISD_SUPPORT_ASTC
-		transcoder_init_astc();
+		// Lowest bit first, so prerequisites (cTableFamilyASTC, cTableFamilyATC) are built before the families that use them.
+		for (uint32_t family = 1; family <= cTableFamilyAll; family <<= 1)
+		{
+			if ((families & family) && !(initialized_families & family))
+			{
+				init_table_family(family);
+				initialized_families |= family;
+			}
+		}
+
+#if BASISD_SUPPORT_THREADS
+		g_initialized_table_families.store(initialized_families, std::memory_order_release);
+#else
+		g_initialized_table_families = initialized_families;
 #endif
-				
+	}
+
+	// Returns the table families needed to transcode src_fmt texture data to fmt blocks.
+	static uint32_t get_table_families(basis_tex_format src_fmt, block_format fmt)
+	{
+		uint32_t families = 0;
+
+		switch (src_fmt)
+		{
+		case basis_tex_format::cETC1S:
+		{
+			switch (fmt)
+			{
+			case block_format::cBC1:
+			case block_format::cBC3:
+			case block_format::cFXT1_RGB:
+				families = cTableFamilyBC1;
+				break;
+			case block_format::cBC7:
+			case block_format::cBC7_M5_COLOR:
+			case block_format::cBC7_M5_ALPHA:
+				families = cTableFamilyETC1SToBC7;
+				break;
+			case block_format::cATC_RGB:
+			case block_format::cATC_RGBA_INTERPOLATED_ALPHA:
+				families = cTableFamilyATC;
+				break;
+			case block_format::cPVRTC2_4_RGB:
+			case block_format::cPVRTC2_4_RGBA:
+				families = cTableFamilyPVRTC2;
+				break;
+			case block_format::cASTC_LDR_4x4:
+				families = cTableFamilyETC1SToASTC;
+				break;
+			default:
+				break;
+			}
+			break;
+		}
+		case basis_tex_format::cUASTC_LDR_4x4:
+		{
+			families = cTableFamilyUASTC;
+			if ((fmt == block_format::cBC1) || (fmt == block_format::cBC3))
+				families |= cTableFamilyBC1;
+			break;
+		}
+		case basis_tex_format::cUASTC_HDR_4x4:
+		case basis_tex_format::cASTC_HDR_6x6:
+		case basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE:
+		{
+			families = cTableFamilyASTC;
+			if (fmt == block_format::cBC6H)
+				families |= cTableFamilyBC6H;
+			break;
+		}
+		default:
+		{
+			// XUASTC LDR, ASTC LDR and XUBC7
+			families = cTableFamilyASTC | cTableFamilyXUASTC | cTableFamilyLDREncoders | cTableFamilyArith;
+			if ((fmt == block_format::cBC1) || (fmt == block_format::cBC3))
+				families |= cTableFamilyBC1;
+			
+			// BC7 mode 5 optimal endpoints, for solid blocks
+			if ((src_fmt == basis_tex_format::cXUBC7) || (fmt == block_format::cBC7))
+				families |= cTableFamilyUASTC;
+			break;
+		}
+		}
+
+		return families;
+	}
+
+	// Returns the table families needed to transcode src_fmt texture data to the fmt texture format, which may be written using several different block formats.
+	static uint32_t get_table_families(basis_tex_format src_fmt, transcoder_texture_format fmt)
+	{
+		block_format block_fmts[3] = { block_format::cRGBA32, block_format::cRGBA32, block_format::cRGBA32 };
+
+		switch (fmt)
+		{
+		case transcoder_texture_format::cTFBC1_RGB: block_fmts[0] = block_format::cBC1; break;
+		case transcoder_texture_format::cTFBC3_RGBA: block_fmts[0] = block_format::cBC3; block_fmts[1] = block_format::cBC1; break;
+		case transcoder_texture_format::cTFBC6H: block_fmts[0] = block_format::cBC6H; break;
+		case transcoder_texture_format::cTFBC7_RGBA: block_fmts[0] = block_format::cBC7; block_fmts[1] = block_format::cBC7_M5_COLOR; block_fmts[2] = block_format::cBC7_M5_ALPHA; break;
+		case transcoder_texture_format::cTFATC_RGB: block_fmts[0] = block_format::cATC_RGB; break;
+		case transcoder_texture_format::cTFATC_RGBA: block_fmts[0] = block_format::cATC_RGBA_INTERPOLATED_ALPHA; break;
+		case transcoder_texture_format::cTFFXT1_RGB: block_fmts[0] = block_format::cFXT1_RGB; break;
+		case transcoder_texture_format::cTFPVRTC2_4_RGB: block_fmts[0] = block_format::cPVRTC2_4_RGB; break;
+		case transcoder_texture_format::cTFPVRTC2_4_RGBA: block_fmts[0] = block_format::cPVRTC2_4_RGBA; break;
+		case transcoder_texture_format::cTFASTC_LDR_4x4_RGBA: block_fmts[0] = block_format::cASTC_LDR_4x4; break;
+		default: break;
+		}
+
+		uint32_t families = 0;
+		for (uint32_t i = 0; i < 3; i++)
+			families |= get_table_families(src_fmt, block_fmts[i]);
+
+		return families;
+	}
+
+	static void transcoder_init_core()
+	{
 #if BASISD_WRITE_NEW_ASTC_TABLES
 		create_etc1_to_astc_conversion_table_0_47();
 		create_etc1_to_astc_conversion_table_0_255();
@@ -2168,104 +2523,252 @@ namespace basist
 		exit(0);
 #endif
 
-#if BASISD_SUPPORT_DXT1 || BASISD_SUPPORT_UASTC
-		uint8_t bc1_expand5[32];
-		for (int i = 0; i < 32; i++)
-			bc1_expand5[i] = static_cast<uint8_t>((i << 3) | (i >> 2));
-		prepare_bc1_single_color_table(g_bc1_match5_equals_1, bc1_expand5, 32, 32, 1);
-		prepare_bc1_single_color_table(g_bc1_match5_equals_0, bc1_expand5, 1, 32, 0);
-
-		uint8_t bc1_expand6[64];
-		for (int i = 0; i < 64; i++)
-			bc1_expand6[i] = static_cast<uint8_t>((i << 2) | (i >> 4));
-		prepare_bc1_single_color_table(g_bc1_match6_equals_1, bc1_expand6, 64, 64, 1);
-		prepare_bc1_single_color_table(g_bc1_match6_equals_0, bc1_expand6, 1, 64, 0);
+#if BASISD_WRITE_NEW_PRECOMPUTED_TABLES
+		init_table_families(cTableFamilyAll);
+		create_precomputed_tables();
+		exit(0);
+#endif
 
-#if 0
-		for (uint32_t i = 0; i < 256; i++)
+		g_transcoder_initialized = true;
+	}
+		
+	// Library global initialization. Only marks the transcoder as initialized: the lookup tables are built on demand (~75ms total natively on a Core i7 if all are needed, roughly half that with BASISD_USE_PRECOMPUTED_TABLES).
+	void basisu_transcoder_init()
+	{
+		if (g_transcoder_initialized)
 		{
-			printf("%u %u %u\n", i, (i * 63 + 127) / 255, g_bc1_match6_equals_0[i].m_hi);
+			BASISU_DEVEL_ERROR("basisu_transcoder::basisu_transcoder_init: Called more than once\n");      
+			return;
 		}
-		exit(0);
-#endif
+         
+		BASISU_DEVEL_ERROR("basisu_transcoder::basisu_transcoder_init: Initializing (this is not an error)\n");      
 
-#endif
+		transcoder_init_core();
+	}
 
-#if BASISD_SUPPORT_DXT1
-		for (uint32_t i = 0; i < NUM_ETC1_TO_DXT1_SELECTOR_RANGES; i++)
+	void basisu_transcoder_init(const transcoder_texture_format* pFormats, uint32_t n, const basis_tex_format* pSource_formats, uint32_t num_source_formats)
+	{
+		if (!g_transcoder_initialized)
+			transcoder_init_core();
+
+		if (!pFormats)
 		{
-			uint32_t l = g_etc1_to_dxt1_selector_ranges[i].m_low;
-			uint32_t h = g_etc1_to_dxt1_selector_ranges[i].m_high;
-			g_etc1_to_dxt1_selector_range_index[l][h] = i;
+			init_table_families(cTableFamilyAll);
+			return;
 		}
 
-		for (uint32_t sm = 0; sm < NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS; sm++)
-		{
-			uint8_t etc1_to_dxt1_selector_mappings_raw_dxt1[4];
-			uint8_t etc1_to_dxt1_selector_mappings_raw_dxt1_inv[4];
+		uint32_t families = 0;
 
-			for (uint32_t j = 0; j < 4; j++)
+		for (uint32_t i = 0; i < n; i++)
+		{
+			if (pSource_formats)
 			{
-				static const uint8_t s_linear_dxt1_to_dxt1[4] = { 0, 2, 3, 1 };
-				static const uint8_t s_dxt1_inverted_xlat[4] = { 1, 0, 3, 2 };
-
-				etc1_to_dxt1_selector_mappings_raw_dxt1[j] = (uint8_t)s_linear_dxt1_to_dxt1[g_etc1_to_dxt1_selector_mappings[sm][j]];
-				etc1_to_dxt1_selector_mappings_raw_dxt1_inv[j] = (uint8_t)s_dxt1_inverted_xlat[etc1_to_dxt1_selector_mappings_raw_dxt1[j]];
+				for (uint32_t j = 0; j < num_source_formats; j++)
+					families |= get_table_families(pSource_formats[j], pFormats[i]);
 			}
-
-			for (uint32_t i = 0; i < 256; i++)
+			else
 			{
-				uint32_t k = 0, k_inv = 0;
-				for (uint32_t s = 0; s < 4; s++)
-				{
-					k |= (etc1_to_dxt1_selector_mappings_raw_dxt1[(i >> (s * 2)) & 3] << (s * 2));
-					k_inv |= (etc1_to_dxt1_selector_mappings_raw_dxt1_inv[(i >> (s * 2)) & 3] << (s * 2));
-				}
-				g_etc1_to_dxt1_selector_mappings_raw_dxt1_256[sm][i] = (uint8_t)k;
-				g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256[sm][i] = (uint8_t)k_inv;
+				for (uint32_t j = 0; j < (uint32_t)basis_tex_format::cTotalFormats; j++)
+					families |= get_table_families((basis_tex_format)j, pFormats[i]);
 			}
 		}
-#endif
 
-#if BASISD_SUPPORT_BC7_MODE5
-		transcoder_init_bc7_mode5();
+		init_table_families(families);
+	}
+
+#if BASISD_SUPPORT_SSE
+	static bool transcoder_detect_sse41()
+	{
+		uint32_t ecx = 0, edx = 0;
+#if defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, 0);
+		if (regs[0] < 1)
+			return false;
+		__cpuid(regs, 1);
+		ecx = (uint32_t)regs[2];
+		edx = (uint32_t)regs[3];
+#else
+		uint32_t eax = 0, ebx = 0;
+		if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+			return false;
 #endif
+		// SSE, SSE2, SSE3, SSSE3, SSE 4.1
+		return ((edx >> 25) & 1) && ((edx >> 26) & 1) && (ecx & 1) && ((ecx >> 9) & 1) && ((ecx >> 19) & 1);
+	}
 
-#if BASISD_SUPPORT_ATC
-		transcoder_init_atc();
+	static bool g_transcoder_use_sse41 = transcoder_detect_sse41();
 #endif
 
-#if BASISD_SUPPORT_PVRTC2
-		transcoder_init_pvrtc2();
+	bool basisu_transcoder_supports_sse41()
+	{
+#if BASISD_SUPPORT_SSE
+		return transcoder_detect_sse41();
+#else
+		return false;
 #endif
+	}
 
-#if BASISD_SUPPORT_UASTC_HDR
-		bc6h_enc_init();
-		astc_6x6_hdr::init_quantize_tables();
-		fast_encode_bc6h_init();
+	void basisu_transcoder_enable_sse41(bool enabled)
+	{
+#if BASISD_SUPPORT_SSE
+		g_transcoder_use_sse41 = enabled && transcoder_detect_sse41();
+#else
+		BASISU_NOTE_UNUSED(enabled);
 #endif
-		
-#if BASISD_SUPPORT_BC7_MODE5
-		bc7_mode_5_encoder::encode_bc7_mode5_init();
+	}
+
+	bool basisu_transcoder_is_sse41_enabled()
+	{
+#if BASISD_SUPPORT_SSE
+		return g_transcoder_use_sse41;
+#else
+		return false;
 #endif
+	}
 
-#if BASISD_SUPPORT_XUASTC
-		// TODO: XUASTC support macro
-		astc_ldr_t::init();
-		
-		astc_ldr_t::init_transcoding_tables();
+#if BASISD_SUPPORT_SSE
+	// SSE 4.1 versions of the inner loops shared by the ETC1S block converters. Each one must exactly match the scalar code it replaces.
 
-		// Used by arith encoder/decoder
-		arith_fastbits_f32::init();
-								
-		// Used by astc ldr transcoding
-		bc7f::init();
-		bc7u::init_weight_quant();
-		etc1f::init();
+	// Returns the index of the first of the 10 selector mappings with the lowest total R+G+B error, like the scalar DO_ITER() loops.
+	// All of the ETC1S->LDR conversion tables use 4 byte { m_lo, m_hi, m_err } solutions, so the error is the upper 16 bits of each dword.
+	template<typename T>
+	BASISD_SSE41_FUNC static uint32_t etc1s_find_best_mapping_sse41(const T* pTable_r, const T* pTable_g, const T* pTable_b)
+	{
+		static_assert(sizeof(T) == 4, "etc1s_find_best_mapping_sse41: unexpected solution size");
+
+		const __m128i e0 = _mm_add_epi32(_mm_add_epi32(
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_r)), 16),
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_g)), 16)),
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_b)), 16));
+
+		const __m128i e1 = _mm_add_epi32(_mm_add_epi32(
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_r + 4)), 16),
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_g + 4)), 16)),
+			_mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pTable_b + 4)), 16));
+
+		// Only load mappings 8 and 9, the tables may end right after them. Pad the unused lanes with an error that can't be the minimum.
+		__m128i e2 = _mm_add_epi32(_mm_add_epi32(
+			_mm_srli_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pTable_r + 8)), 16),
+			_mm_srli_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pTable_g + 8)), 16)),
+			_mm_srli_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pTable_b + 8)), 16));
+		e2 = _mm_or_si128(e2, _mm_setr_epi32(0, 0, -1, -1));
+
+		__m128i m = _mm_min_epu32(_mm_min_epu32(e0, e1), e2);
+		m = _mm_min_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+		m = _mm_min_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		const uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(e0, m))) |
+			((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(e1, m))) << 4) |
+			((uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(e2, m))) << 8);
+		assert(mask);
+
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanForward(&idx, mask);
+		return (uint32_t)idx;
+#else
+		return (uint32_t)__builtin_ctz(mask);
 #endif
+	}
 
-		g_transcoder_initialized = true;
+	// Returns the block's 16 ETC1S selectors translated through the 4 entry byte table in xlat (entry i in bits i*8 to i*8+7), in raster order (byte x + y * 4 is pixel (x, y)).
+	BASISD_SSE41_FUNC static inline __m128i etc1s_xlat_selectors_sse41(const selector* pSelector, uint32_t xlat)
+	{
+		uint32_t sel_bits;
+		memcpy(&sel_bits, pSelector->m_selectors, sizeof(sel_bits));
+
+		// Broadcast each row's byte to its 4 lanes, then isolate the nibble holding each lane's selector (x=0,1 use the low nibble, x=2,3 the high nibble).
+		const __m128i rows = _mm_shuffle_epi8(_mm_cvtsi32_si128((int)sel_bits), _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3));
+
+		const __m128i nibble_mask = _mm_set1_epi8(15);
+		const __m128i nibbles = _mm_blend_epi16(_mm_and_si128(rows, nibble_mask), _mm_and_si128(_mm_srli_epi16(rows, 4), nibble_mask), 0xAA);
+
+		// Even x lanes use bits 0-1 of their nibble, odd x lanes bits 2-3.
+		const __m128i sels = _mm_and_si128(_mm_blendv_epi8(nibbles, _mm_srli_epi16(nibbles, 2), _mm_set1_epi16((short)0xFF00)), _mm_set1_epi8(3));
+
+		return _mm_shuffle_epi8(_mm_cvtsi32_si128((int)xlat), sels);
+	}
+
+	// Packs 16 2-bit values, LSB first.
+	BASISD_SSE41_FUNC static inline uint32_t etc1s_pack_2bit_sse41(__m128i v)
+	{
+		__m128i t = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0401));
+		t = _mm_madd_epi16(t, _mm_set1_epi32(0x00100001));
+		t = _mm_shuffle_epi8(t, _mm_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1));
+		return (uint32_t)_mm_cvtsi128_si32(t);
+	}
+
+	// Packs 16 3-bit values into 48 bits, LSB first.
+	BASISD_SSE41_FUNC static inline uint64_t etc1s_pack_3bit_sse41(__m128i v)
+	{
+		__m128i t = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0801));
+		t = _mm_madd_epi16(t, _mm_set1_epi32(0x00400001));
+		t = _mm_or_si128(t, _mm_srli_epi64(t, 20));
+
+		const uint64_t lo = (uint32_t)_mm_cvtsi128_si32(t) & 0xFFFFFF;
+		const uint64_t hi = (uint32_t)_mm_extract_epi32(t, 2) & 0xFFFFFF;
+		return lo | (hi << 24);
+	}
+
+	// Translated 2-bit selectors in raster order, LSB first (BC1/ATC/PVRTC2/BC7 style).
+	BASISD_SSE41_FUNC static uint32_t etc1s_xlat_2bit_selectors_sse41(const selector* pSelector, uint32_t xlat)
+	{
+		return etc1s_pack_2bit_sse41(etc1s_xlat_selectors_sse41(pSelector, xlat));
+	}
+
+	// Translated 3-bit selectors in raster order, LSB first (BC4/DXT5A).
+	BASISD_SSE41_FUNC static uint64_t etc1s_xlat_3bit_selectors_sse41(const selector* pSelector, uint32_t xlat)
+	{
+		return etc1s_pack_3bit_sse41(etc1s_xlat_selectors_sse41(pSelector, xlat));
+	}
+
+	// Translated 3-bit selectors in ETC2 EAC order: column major, MSB first.
+	BASISD_SSE41_FUNC static uint64_t etc1s_xlat_eac_selectors_sse41(const selector* pSelector, uint32_t xlat)
+	{
+		// Transpose and reverse the raster order selectors, then pack them LSB first.
+		return etc1s_pack_3bit_sse41(_mm_shuffle_epi8(etc1s_xlat_selectors_sse41(pSelector, xlat), _mm_setr_epi8(15, 11, 7, 3, 14, 10, 6, 2, 13, 9, 5, 1, 12, 8, 4, 0)));
+	}
+
+	// Writes the 16 translated selectors to a single plane ASTC weight array.
+	BASISD_SSE41_FUNC static void etc1s_xlat_astc_weights_sse41(const selector* pSelector, uint32_t xlat, uint8_t* pWeights)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pWeights), etc1s_xlat_selectors_sse41(pSelector, xlat));
+	}
+
+	// Writes the 16 translated selectors to one plane of a 32 byte dual plane ASTC weight array. 
+	// Plane 0 writes (the even bytes) keep the plane 1 weights, plane 1 writes zero the plane 0 weights (so plane 1 must be written first).
+	BASISD_SSE41_FUNC static void etc1s_xlat_astc_dual_plane_weights_sse41(const selector* pSelector, uint32_t xlat, uint8_t* pWeights, uint32_t plane)
+	{
+		const __m128i w = etc1s_xlat_selectors_sse41(pSelector, xlat);
+		__m128i* pDst = reinterpret_cast<__m128i*>(pWeights);
+
+		if (plane)
+		{
+			_mm_storeu_si128(pDst, _mm_unpacklo_epi8(_mm_setzero_si128(), w));
+			_mm_storeu_si128(pDst + 1, _mm_unpackhi_epi8(_mm_setzero_si128(), w));
+		}
+		else
+		{
+			const __m128i plane0_mask = _mm_set1_epi16(0x00FF);
+			_mm_storeu_si128(pDst, _mm_blendv_epi8(_mm_loadu_si128(pDst), _mm_unpacklo_epi8(w, w), plane0_mask));
+			_mm_storeu_si128(pDst + 1, _mm_blendv_epi8(_mm_loadu_si128(pDst + 1), _mm_unpackhi_epi8(w, w), plane0_mask));
+		}
+	}
+
+	// Packs a 4 entry byte translation table into a uint32_t, for the functions above.
+	static inline uint32_t etc1s_xlat_table(const uint8_t* pXlat)
+	{
+		return pXlat[0] | (pXlat[1] << 8) | (pXlat[2] << 16) | (pXlat[3] << 24);
+	}
+
+	// Same, from a table of packed bit fields (the BC4/EAC/BC7 alpha conversion tables' m_trans).
+	static inline uint32_t etc1s_xlat_table_from_bits(uint32_t trans, uint32_t bits_per_entry)
+	{
+		const uint32_t mask = (1U << bits_per_entry) - 1;
+		return (trans & mask) | (((trans >> bits_per_entry) & mask) << 8) | (((trans >> (bits_per_entry * 2)) & mask) << 16) | (((trans >> (bits_per_entry * 3)) & mask) << 24);
 	}
+#endif // BASISD_SUPPORT_SSE
 
 #if BASISD_SUPPORT_DXT1
 	static void convert_etc1s_to_dxt1(dxt1_block* pDst_block, const endpoint *pEndpoints, const selector* pSelector, bool use_threecolor_blocks)
@@ -2400,10 +2903,17 @@ namespace basist
 		uint32_t best_mapping = 0;
 
 		assert(NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+			best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+		else
+#endif
+		{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-		DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-		DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+		}
 
 		uint32_t l = dxt1_block::pack_unscaled_color(pTable_r[best_mapping].m_lo, pTable_g[best_mapping].m_lo, pTable_b[best_mapping].m_lo);
 		uint32_t h = dxt1_block::pack_unscaled_color(pTable_r[best_mapping].m_hi, pTable_g[best_mapping].m_hi, pTable_b[best_mapping].m_hi);
@@ -2954,6 +3464,16 @@ namespace basist
 			pDst_block->set_low_alpha(r0);
 			pDst_block->set_high_alpha(r1);
 
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
+			{
+				const uint64_t selector_bits = etc1s_xlat_3bit_selectors_sse41(pSelector, 1U << (high_selector * 8));
+				for (uint32_t i = 0; i < 6; i++)
+					pDst_block->m_selectors[i] = (uint8_t)(selector_bits >> (i * 8));
+				return;
+			}
+#endif
+
 			// TODO: Optimize this
 			for (uint32_t y = 0; y < 4; y++)
 			{
@@ -2979,6 +3499,16 @@ namespace basist
 		pDst_block->set_low_alpha(pTable_entry->m_lo);
 		pDst_block->set_high_alpha(pTable_entry->m_hi);
 
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+		{
+			const uint64_t selector_bits = etc1s_xlat_3bit_selectors_sse41(pSelector, etc1s_xlat_table_from_bits(pTable_entry->m_trans, 3));
+			for (uint32_t i = 0; i < 6; i++)
+				pDst_block->m_selectors[i] = (uint8_t)(selector_bits >> (i * 8));
+			return;
+		}
+#endif
+
 		// TODO: Optimize this (like ETC1->BC1)
 		for (uint32_t y = 0; y < 4; y++)
 		{
@@ -3990,7 +4520,7 @@ namespace basist
 
 	const uint32_t NUM_ETC1_TO_BC7_M5_SELECTOR_RANGES = sizeof(g_etc1_to_bc7_m5_selector_ranges) / sizeof(g_etc1_to_bc7_m5_selector_ranges[0]);
 
-	static uint32_t g_etc1_to_bc7_m5_selector_range_index[4][4];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_etc1_to_bc7_m5_selector_range_index[4][4] BASISD_PRECOMPUTED_TABLE(g_etc1_to_bc7_m5_selector_range_index);
 	
 	const uint32_t NUM_ETC1_TO_BC7_M5_SELECTOR_MAPPINGS = 10;
 	static const uint8_t g_etc1_to_bc7_m5_selector_mappings[NUM_ETC1_TO_BC7_M5_SELECTOR_MAPPINGS][4] =
@@ -4030,7 +4560,7 @@ namespace basist
 
 	const uint32_t NUM_ETC1_TO_BC7_M5A_SELECTOR_RANGES = sizeof(g_etc1_to_bc7_m5a_selector_ranges) / sizeof(g_etc1_to_bc7_m5a_selector_ranges[0]);
 
-	static uint32_t g_etc1_to_bc7_m5a_selector_range_index[4][4];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_etc1_to_bc7_m5a_selector_range_index[4][4] BASISD_PRECOMPUTED_TABLE(g_etc1_to_bc7_m5a_selector_range_index);
 
 	struct etc1_g_to_bc7_m5a_conversion
 	{
@@ -4257,6 +4787,7 @@ namespace basist
 		{126,116},{126,117},{127,117},{127,118},{126,119},{126,120},{127,120},{127,121},{126,122},{126,123},{127,123},{127,124},{126,125},{126,126},{127,126},{127,127}
 	};
 	
+#if !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_bc7_mode5()
 	{
 #if 0
@@ -4306,6 +4837,7 @@ namespace basist
 			g_etc1_to_bc7_m5a_selector_range_index[l][h] = i;
 		}
 	}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 
 	static void convert_etc1s_to_bc7_m5_color(void* pDst, const endpoint* pEndpoints, const selector* pSelector)
 	{
@@ -4419,10 +4951,17 @@ namespace basist
 		uint32_t best_mapping = 0;
 
 		assert(NUM_ETC1_TO_BC7_M5_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+			best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+		else
+#endif
+		{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-		DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-		DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+		}
 
 		const uint8_t* pSelectors_xlat = &g_etc1_to_bc7_m5_selector_mappings[best_mapping][0];
 
@@ -4450,6 +4989,16 @@ namespace basist
 			pDst_block->m_lo.m_b1 = pTable_b[best_mapping].m_hi;
 		}
 
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+		{
+			// The first selector's MSB is always 0, and is left out.
+			const uint32_t p = etc1s_xlat_2bit_selectors_sse41(pSelector, etc1s_xlat_table(pSelectors_xlat) ^ (s_inv * 0x01010101));
+			set_block_bits((uint8_t*)pDst, (p & 1) | ((p >> 2) << 1), 31, 66);
+			return;
+		}
+#endif
+
 		uint32_t output_bits = 0, output_bit_ofs = 0;
 
 		for (uint32_t y = 0; y < 4; y++)
@@ -4544,6 +5093,27 @@ namespace basist
 		pDst_block->m_lo.m_a1_0 = pTable->m_hi & 63;
 		pDst_block->m_hi.m_a1_1 = pTable->m_hi >> 6;
 
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+		{
+			uint32_t trans = pTable->m_trans;
+
+			if ((trans >> (pSelector->get_selector(0, 0) * 2)) & 2)
+			{
+				pDst_block->m_lo.m_a0 = pTable->m_hi;
+				pDst_block->m_lo.m_a1_0 = pTable->m_lo & 63;
+				pDst_block->m_hi.m_a1_1 = pTable->m_lo >> 6;
+
+				trans ^= 0xFF;
+			}
+
+			// The first selector's MSB is always 0, and is left out.
+			const uint32_t p = etc1s_xlat_2bit_selectors_sse41(pSelector, etc1s_xlat_table_from_bits(trans, 2));
+			set_block_bits((uint8_t*)pDst, (p & 1) | ((p >> 2) << 1), 31, 97);
+			return;
+		}
+#endif
+
 		uint32_t output_bit_offset = 0, output_bits = 0, selector_trans = pTable->m_trans;
 
 		for (uint32_t y = 0; y < 4; y++)
@@ -4638,7 +5208,9 @@ namespace basist
 		return color5_to_cocg(pEndpoints[endpoint_index]);
 	}
 
-	static void chroma_filter_bc7_mode5(const basisu::vector2D<uint16_t>& decoded_endpoints, void* pDst_blocks, uint32_t num_blocks_x, uint32_t num_blocks_y, uint32_t output_row_pitch_in_blocks_or_pixels, const endpoint *pEndpoints)
+	// Filters the blocks inside the rectangle at (rect_x, rect_y), which is at the top left of the output. decoded_endpoints must be valid for the rectangle and its 8 neighbors.
+	static void chroma_filter_bc7_mode5(const basisu::vector2D<uint16_t>& decoded_endpoints, void* pDst_blocks, uint32_t num_blocks_x, uint32_t num_blocks_y, uint32_t output_row_pitch_in_blocks_or_pixels, const endpoint *pEndpoints,
+		uint32_t rect_x, uint32_t rect_y, uint32_t rect_num_blocks_x, uint32_t rect_num_blocks_y)
 	{
 		const bool hq_bc7_mode_5_encoder_mode = false;
 
@@ -4647,9 +5219,9 @@ namespace basist
 		uint32_t total_filtered_blocks = 0;
 		BASISU_NOTE_UNUSED(total_filtered_blocks);
 
-		for (int by = 0; by < (int)num_blocks_y; by++)
+		for (int by = (int)rect_y; by < (int)(rect_y + rect_num_blocks_y); by++)
 		{
-			for (int bx = 0; bx < (int)num_blocks_x; bx++)
+			for (int bx = (int)rect_x; bx < (int)(rect_x + rect_num_blocks_x); bx++)
 			{
 				vec2F center_cocg(color5_to_cocg(pEndpoints[decoded_endpoints(bx, by)]));
 		
@@ -4689,7 +5261,7 @@ namespace basist
 
 				total_filtered_blocks++;
 
-				bc7_mode_5* pDst_block = (bc7_mode_5*)(static_cast<uint8_t*>(pDst_blocks) + (bx + by * output_row_pitch_in_blocks_or_pixels) * sizeof(bc7_mode_5));
+				bc7_mode_5* pDst_block = (bc7_mode_5*)(static_cast<uint8_t*>(pDst_blocks) + ((bx - rect_x) + (by - rect_y) * output_row_pitch_in_blocks_or_pixels) * sizeof(bc7_mode_5));
 				
 				//memset(pDst_block, 0x80, 16);
 
@@ -4821,6 +5393,14 @@ namespace basist
 		pDst_block->m_table = pTable_entry->m_table_mul >> 4;
 		pDst_block->m_multiplier = pTable_entry->m_table_mul & 15;
 
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+		{
+			pDst_block->set_selector_bits(etc1s_xlat_eac_selectors_sse41(pSelector, etc1s_xlat_table_from_bits(pTable_entry->m_trans, 3)));
+			return;
+		}
+#endif
+
 		uint64_t selector_bits = 0;
 
 		for (uint32_t y = 0; y < 4; y++)
@@ -5140,6 +5720,14 @@ namespace basist
 		pDst_block->m_table = pTable_entry->m_table_mul >> 4;
 		pDst_block->m_multiplier = pTable_entry->m_table_mul & 15;
 
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+		{
+			pDst_block->set_selector_bits(etc1s_xlat_eac_selectors_sse41(pSelector, etc1s_xlat_table_from_bits(pTable_entry->m_trans, 3)));
+			return;
+		}
+#endif
+
 		uint64_t selector_bits = 0;
 
 		for (uint32_t y = 0; y < 4; y++)
@@ -5183,7 +5771,7 @@ namespace basist
 
 	const uint32_t NUM_ETC1_TO_ASTC_SELECTOR_RANGES = sizeof(g_etc1_to_astc_selector_ranges) / sizeof(g_etc1_to_astc_selector_ranges[0]);
 
-	static uint32_t g_etc1_to_astc_selector_range_index[4][4];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_etc1_to_astc_selector_range_index[4][4] BASISD_PRECOMPUTED_TABLE(g_etc1_to_astc_selector_range_index);
 
 	const uint32_t NUM_ETC1_TO_ASTC_SELECTOR_MAPPINGS = 10;
 	static const uint8_t g_etc1_to_astc_selector_mappings[NUM_ETC1_TO_ASTC_SELECTOR_MAPPINGS][4] =
@@ -5205,16 +5793,16 @@ namespace basist
 	};
 
 	// The best selector mapping to use given a base base+inten table and used selector range for converting grayscale data.
-	static uint8_t g_etc1_to_astc_best_grayscale_mapping[32][8][NUM_ETC1_TO_ASTC_SELECTOR_RANGES];
+	static BASISD_PRECOMPUTED_CONST uint8_t g_etc1_to_astc_best_grayscale_mapping[32][8][NUM_ETC1_TO_ASTC_SELECTOR_RANGES] BASISD_PRECOMPUTED_TABLE(g_etc1_to_astc_best_grayscale_mapping);
 	
 #if BASISD_SUPPORT_ASTC_HIGHER_OPAQUE_QUALITY
 	static const etc1_to_astc_solution g_etc1_to_astc_0_255[32 * 8 * NUM_ETC1_TO_ASTC_SELECTOR_MAPPINGS * NUM_ETC1_TO_ASTC_SELECTOR_RANGES] = {
 #include "basisu_transcoder_tables_astc_0_255.inc"
 	};
-	static uint8_t g_etc1_to_astc_best_grayscale_mapping_0_255[32][8][NUM_ETC1_TO_ASTC_SELECTOR_RANGES];
+	static BASISD_PRECOMPUTED_CONST uint8_t g_etc1_to_astc_best_grayscale_mapping_0_255[32][8][NUM_ETC1_TO_ASTC_SELECTOR_RANGES] BASISD_PRECOMPUTED_TABLE(g_etc1_to_astc_best_grayscale_mapping_0_255);
 #endif
 
-	static uint32_t g_ise_to_unquant[48];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_ise_to_unquant[48] BASISD_PRECOMPUTED_TABLE(g_ise_to_unquant);
 
 #if BASISD_WRITE_NEW_ASTC_TABLES
 	static void create_etc1_to_astc_conversion_table_0_47()
@@ -5605,14 +6193,15 @@ namespace basist
 #endif
 
 	// Optimal quantized [0,47] entry to use given [0,255] input
-	static uint8_t g_astc_single_color_encoding_0[256];
+	static BASISD_PRECOMPUTED_CONST uint8_t g_astc_single_color_encoding_0[256] BASISD_PRECOMPUTED_TABLE(g_astc_single_color_encoding_0);
 
 	// Optimal quantized [0,47] low/high values given [0,255] input assuming a selector of 1
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_lo, m_hi;
-	} g_astc_single_color_encoding_1[256];
+	} g_astc_single_color_encoding_1[256] BASISD_PRECOMPUTED_TABLE(g_astc_single_color_encoding_1);
 		
+#if !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_astc()
 	{
 		for (uint32_t base_color = 0; base_color < 32; base_color++)
@@ -5741,6 +6330,7 @@ namespace basist
 			} // lo
 		}
 	}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 
 	// Converts opaque or color+alpha ETC1S block to ASTC 4x4.
 	// This function tries to use the best ASTC mode given the block's actual contents.
@@ -6022,10 +6612,17 @@ namespace basist
 			uint32_t best_mapping = 0;
 
 			assert(NUM_ETC1_TO_ASTC_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
+				best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+			else
+#endif
+			{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+				DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+				DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+			}
 
 			blk.m_endpoints[0] = pTable_r[best_mapping].m_lo;
 			blk.m_endpoints[1] = pTable_r[best_mapping].m_hi;
@@ -6050,18 +6647,28 @@ namespace basist
 
 			const uint8_t* pSelectors_xlat = &g_etc1_to_astc_selector_mappings[best_mapping][0];
 
-			for (uint32_t y = 0; y < 4; y++)
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
 			{
-				for (uint32_t x = 0; x < 4; x++)
+				// 3 - as == as ^ 3 for 2-bit weights
+				etc1s_xlat_astc_weights_sse41(pSelector, etc1s_xlat_table(pSelectors_xlat) ^ (invert ? 0x03030303 : 0), blk.m_weights);
+			}
+			else
+#endif
+			{
+				for (uint32_t y = 0; y < 4; y++)
 				{
-					uint32_t s = pSelector->get_selector(x, y);
-					uint32_t as = pSelectors_xlat[s];
-					if (invert)
-						as = 3 - as;
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						uint32_t s = pSelector->get_selector(x, y);
+						uint32_t as = pSelectors_xlat[s];
+						if (invert)
+							as = 3 - as;
 
-					blk.m_weights[x + y * 4] = static_cast<uint8_t>(as);
-				} // x
-			} // y
+						blk.m_weights[x + y * 4] = static_cast<uint8_t>(as);
+					} // x
+				} // y
+			}
 
 			// Now pack to ASTC
 			astc_pack_block_cem_8_weight_range2(reinterpret_cast<uint32_t*>(pDst_block), &blk);
@@ -6135,16 +6742,26 @@ namespace basist
 
 				const uint8_t* pSelectors_xlat = &g_etc1_to_astc_selector_mappings[best_mapping][0];
 
-				for (uint32_t y = 0; y < 4; y++)
+#if BASISD_SUPPORT_SSE
+				if (g_transcoder_use_sse41)
 				{
-					for (uint32_t x = 0; x < 4; x++)
+					// The color weights (plane 0) are written afterwards.
+					etc1s_xlat_astc_dual_plane_weights_sse41(&alpha_selectors, etc1s_xlat_table(pSelectors_xlat), blk.m_weights, 1);
+				}
+				else
+#endif
+				{
+					for (uint32_t y = 0; y < 4; y++)
 					{
-						uint32_t s = alpha_selectors.get_selector(x, y);
-						uint32_t as = pSelectors_xlat[s];
+						for (uint32_t x = 0; x < 4; x++)
+						{
+							uint32_t s = alpha_selectors.get_selector(x, y);
+							uint32_t as = pSelectors_xlat[s];
 
-						blk.m_weights[(x + y * 4) * 2 + 1] = static_cast<uint8_t>(as);
-					} // x
-				} // y
+							blk.m_weights[(x + y * 4) * 2 + 1] = static_cast<uint8_t>(as);
+						} // x
+					} // y
+				}
 			}
 		}
 		else
@@ -6257,10 +6874,17 @@ namespace basist
 			uint32_t best_mapping = 0;
 
 			assert(NUM_ETC1_TO_ASTC_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
+				best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+			else
+#endif
+			{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+				DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+				DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+			}
 
 			blk.m_endpoints[0] = pTable_r[best_mapping].m_lo;
 			blk.m_endpoints[1] = pTable_r[best_mapping].m_hi;
@@ -6285,18 +6909,27 @@ namespace basist
 
 			const uint8_t* pSelectors_xlat = &g_etc1_to_astc_selector_mappings[best_mapping][0];
 
-			for (uint32_t y = 0; y < 4; y++)
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
 			{
-				for (uint32_t x = 0; x < 4; x++)
+				etc1s_xlat_astc_dual_plane_weights_sse41(pSelector, etc1s_xlat_table(pSelectors_xlat) ^ (invert ? 0x03030303 : 0), blk.m_weights, 0);
+			}
+			else
+#endif
+			{
+				for (uint32_t y = 0; y < 4; y++)
 				{
-					uint32_t s = pSelector->get_selector(x, y);
-					uint32_t as = pSelectors_xlat[s];
-					if (invert)
-						as = 3 - as;
+					for (uint32_t x = 0; x < 4; x++)
+					{
+						uint32_t s = pSelector->get_selector(x, y);
+						uint32_t as = pSelectors_xlat[s];
+						if (invert)
+							as = 3 - as;
 
-					blk.m_weights[(x + y * 4) * 2] = static_cast<uint8_t>(as);
-				} // x
-			} // y
+						blk.m_weights[(x + y * 4) * 2] = static_cast<uint8_t>(as);
+					} // x
+				} // y
+			}
 		}
 
 		// Now pack to ASTC
@@ -6325,7 +6958,7 @@ namespace basist
 
 	const uint32_t NUM_ETC1S_TO_ATC_SELECTOR_RANGES = sizeof(g_etc1s_to_atc_selector_ranges) / sizeof(g_etc1s_to_atc_selector_ranges[0]);
 
-	static uint32_t g_etc1s_to_atc_selector_range_index[4][4];
+	static BASISD_PRECOMPUTED_CONST uint32_t g_etc1s_to_atc_selector_range_index[4][4] BASISD_PRECOMPUTED_TABLE(g_etc1s_to_atc_selector_range_index);
 
 	const uint32_t NUM_ETC1S_TO_ATC_SELECTOR_MAPPINGS = 10;
 	static const uint8_t g_etc1s_to_atc_selector_mappings[NUM_ETC1S_TO_ATC_SELECTOR_MAPPINGS][4] =
@@ -6369,9 +7002,16 @@ namespace basist
 		uint8_t m_lo;
 		uint8_t m_hi;
 	};
-	static atc_match_entry g_pvrtc2_match45_equals_1[256], g_atc_match55_equals_1[256], g_atc_match56_equals_1[256]; // selector 1
-	static atc_match_entry g_pvrtc2_match4[256], g_atc_match5[256], g_atc_match6[256];
-
+	// selector 1
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_pvrtc2_match45_equals_1[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_match45_equals_1);
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_atc_match55_equals_1[256] BASISD_PRECOMPUTED_TABLE(g_atc_match55_equals_1);
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_atc_match56_equals_1[256] BASISD_PRECOMPUTED_TABLE(g_atc_match56_equals_1);
+	// selector 3
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_pvrtc2_match4[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_match4);
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_atc_match5[256] BASISD_PRECOMPUTED_TABLE(g_atc_match5);
+	static BASISD_PRECOMPUTED_CONST atc_match_entry g_atc_match6[256] BASISD_PRECOMPUTED_TABLE(g_atc_match6);
+
+#if !BASISD_USE_PRECOMPUTED_TABLES
 	static void prepare_atc_single_color_table(atc_match_entry* pTable, int size0, int size1, int sel)
 	{
 		for (int i = 0; i < 256; i++)
@@ -6449,6 +7089,7 @@ namespace basist
 			g_etc1s_to_atc_selector_range_index[l][h] = i;
 		}
 	}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 
 	struct atc_block
 	{
@@ -6533,10 +7174,17 @@ namespace basist
 		uint32_t best_mapping = 0;
 
 		assert(NUM_ETC1S_TO_ATC_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+			best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+		else
+#endif
+		{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-		DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-		DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+		}
 
 		pBlock->set_low_color(pTable_r[best_mapping].m_lo, pTable_g[best_mapping].m_lo, pTable_b[best_mapping].m_lo);
 		pBlock->set_high_color(pTable_r[best_mapping].m_hi, pTable_g[best_mapping].m_hi, pTable_b[best_mapping].m_hi);
@@ -6552,6 +7200,19 @@ namespace basist
 		{
 			const uint8_t* pSelectors_xlat = &g_etc1s_to_atc_selector_mappings[best_mapping][0];
 
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
+			{
+				const uint32_t packed_sels = etc1s_xlat_2bit_selectors_sse41(pSelector, etc1s_xlat_table(pSelectors_xlat));
+
+				pBlock->m_sels[0] = (uint8_t)packed_sels;
+				pBlock->m_sels[1] = (uint8_t)(packed_sels >> 8);
+				pBlock->m_sels[2] = (uint8_t)(packed_sels >> 16);
+				pBlock->m_sels[3] = (uint8_t)(packed_sels >> 24);
+				return;
+			}
+#endif
+
 			const uint32_t sel_bits0 = pSelector->m_selectors[0];
 			const uint32_t sel_bits1 = pSelector->m_selectors[1];
 			const uint32_t sel_bits2 = pSelector->m_selectors[2];
@@ -7124,30 +7785,30 @@ namespace basist
 		}
 	};
 
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_l, m_h;
-	} g_pvrtc2_trans_match34[256];
+	} g_pvrtc2_trans_match34[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_trans_match34);
 
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_l, m_h;
-	} g_pvrtc2_trans_match44[256];
+	} g_pvrtc2_trans_match44[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_trans_match44);
 		
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_l, m_h;
-	} g_pvrtc2_alpha_match33[256];
+	} g_pvrtc2_alpha_match33[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_alpha_match33);
 	
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_l, m_h;
-	} g_pvrtc2_alpha_match33_0[256];
+	} g_pvrtc2_alpha_match33_0[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_alpha_match33_0);
 
-	static struct
+	static BASISD_PRECOMPUTED_CONST struct
 	{
 		uint8_t m_l, m_h;
-	} g_pvrtc2_alpha_match33_3[256];
+	} g_pvrtc2_alpha_match33_3[256] BASISD_PRECOMPUTED_TABLE(g_pvrtc2_alpha_match33_3);
 		
 	// PVRTC2 can be forced to look like a slightly weaker variant of ATC/BC1, so that's what we do here for simplicity.
 	static void convert_etc1s_to_pvrtc2_rgb(void* pDst, const endpoint* pEndpoints, const selector* pSelector)
@@ -7214,10 +7875,17 @@ namespace basist
 		uint32_t best_mapping = 0;
 
 		assert(NUM_ETC1S_TO_ATC_SELECTOR_MAPPINGS == 10);
+#if BASISD_SUPPORT_SSE
+		if (g_transcoder_use_sse41)
+			best_mapping = etc1s_find_best_mapping_sse41(pTable_r, pTable_g, pTable_b);
+		else
+#endif
+		{
 #define DO_ITER(m) { uint32_t total_err = pTable_r[m].m_err + pTable_g[m].m_err + pTable_b[m].m_err; if (total_err < best_err) { best_err = total_err; best_mapping = m; } }
-		DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
-		DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
+			DO_ITER(0); DO_ITER(1); DO_ITER(2); DO_ITER(3); DO_ITER(4);
+			DO_ITER(5); DO_ITER(6); DO_ITER(7); DO_ITER(8); DO_ITER(9);
 #undef DO_ITER
+		}
 
 		pBlock->set_low_color(pTable_r[best_mapping].m_lo, pTable_g[best_mapping].m_lo, pTable_b[best_mapping].m_lo);
 		pBlock->set_high_color(pTable_r[best_mapping].m_hi, pTable_g[best_mapping].m_hi, pTable_b[best_mapping].m_hi);
@@ -7234,6 +7902,19 @@ namespace basist
 			// TODO: We could make this faster using several precomputed 256 entry tables, like ETC1S->BC1 does.
 			const uint8_t* pSelectors_xlat = &g_etc1s_to_atc_selector_mappings[best_mapping][0];
 
+#if BASISD_SUPPORT_SSE
+			if (g_transcoder_use_sse41)
+			{
+				const uint32_t packed_sels = etc1s_xlat_2bit_selectors_sse41(pSelector, etc1s_xlat_table(pSelectors_xlat));
+
+				pBlock->m_modulation[0] = (uint8_t)packed_sels;
+				pBlock->m_modulation[1] = (uint8_t)(packed_sels >> 8);
+				pBlock->m_modulation[2] = (uint8_t)(packed_sels >> 16);
+				pBlock->m_modulation[3] = (uint8_t)(packed_sels >> 24);
+				return;
+			}
+#endif
+
 			const uint32_t sel_bits0 = pSelector->m_selectors[0];
 			const uint32_t sel_bits1 = pSelector->m_selectors[1];
 			const uint32_t sel_bits2 = pSelector->m_selectors[2];
@@ -7728,6 +8409,7 @@ namespace basist
 		}
 	}
 		
+#if !BASISD_USE_PRECOMPUTED_TABLES
 	static void transcoder_init_pvrtc2()
 	{
 		for (uint32_t v = 0; v < 256; v++)
@@ -7864,6 +8546,7 @@ namespace basist
 			g_pvrtc2_trans_match44[v].m_h = (uint8_t)best_h;
 		}
 	}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 #endif // BASISD_SUPPORT_PVRTC2
 
 	//------------------------------------------------------------------------------------------------
@@ -7873,10 +8556,11 @@ namespace basist
 #if BASISD_SUPPORT_BC7_MODE5
 	namespace bc7_mode_5_encoder
 	{		
-		static float g_mode5_rgba_midpoints[128];
+		static BASISD_PRECOMPUTED_CONST float g_mode5_rgba_midpoints[128] BASISD_PRECOMPUTED_TABLE(g_mode5_rgba_midpoints);
 
 		void encode_bc7_mode5_init()
 		{
+#if !BASISD_USE_PRECOMPUTED_TABLES
 			// Mode 5 endpoint midpoints
 			for (uint32_t i = 0; i < 128; i++)
 			{
@@ -7893,6 +8577,7 @@ namespace basist
 				else
 					g_mode5_rgba_midpoints[i] = (lo + hi) / 2.0f;
 			}
+#endif
 		}
 
 		static inline uint32_t from_7(uint32_t v)
@@ -8250,7 +8935,8 @@ namespace basist
 
 	basisu_lowlevel_etc1s_transcoder::basisu_lowlevel_etc1s_transcoder() :
 		m_pGlobal_codebook(nullptr),
-		m_selector_history_buf_size(0)
+		m_selector_history_buf_size(0),
+		m_tables_generation(0)
 	{
 	}
 
@@ -8438,8 +9124,74 @@ namespace basist
 		return true;
 	}
 
+	bool basisu_lowlevel_etc1s_transcoder::decode_global_codebooks(const void* pData, uint32_t data_size)
+	{
+		if ((!pData) || (data_size < sizeof(basis_global_codebooks_header)))
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: file is too small\n");
+			return false;
+		}
+
+		const basis_global_codebooks_header* pHeader = static_cast<const basis_global_codebooks_header*>(pData);
+		const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+
+		if ((pHeader->m_sig != basis_global_codebooks_header::cSigValue) || (pHeader->m_ver != basis_global_codebooks_header::cFirstVersion) || 
+			(pHeader->m_header_size != sizeof(basis_global_codebooks_header)))
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: invalid signature, or unsupported file version\n");
+			return false;
+		}
+
+		if ((sizeof(basis_global_codebooks_header) + (uint64_t)pHeader->m_data_size) > data_size)
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: file is truncated\n");
+			return false;
+		}
+
+		if (crc16(&pHeader->m_data_size, sizeof(basis_global_codebooks_header) - BASISU_OFFSETOF(basis_global_codebooks_header, m_data_size), 0) != pHeader->m_header_crc16)
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: header CRC check failed\n");
+			return false;
+		}
+
+		if (crc16(pBytes + sizeof(basis_global_codebooks_header), pHeader->m_data_size, 0) != pHeader->m_data_crc16)
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: data CRC check failed\n");
+			return false;
+		}
+
+		const uint32_t file_size = (uint32_t)sizeof(basis_global_codebooks_header) + (uint32_t)pHeader->m_data_size;
+
+		if ((!pHeader->m_total_endpoints) || (!pHeader->m_total_selectors) || 
+			((uint64_t)pHeader->m_endpoint_cb_file_ofs + pHeader->m_endpoint_cb_file_size > file_size) ||
+			((uint64_t)pHeader->m_selector_cb_file_ofs + pHeader->m_selector_cb_file_size > file_size))
+		{
+			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::decode_global_codebooks: invalid codebook offsets or sizes\n");
+			return false;
+		}
+
+		// The codebooks are decoded into this object, which can't itself reference another one.
+		m_pGlobal_codebook = nullptr;
+
+		return decode_palettes(
+			pHeader->m_total_endpoints, pBytes + pHeader->m_endpoint_cb_file_ofs, pHeader->m_endpoint_cb_file_size,
+			pHeader->m_total_selectors, pBytes + pHeader->m_selector_cb_file_ofs, pHeader->m_selector_cb_file_size);
+	}
+
+#if BASISD_SUPPORT_THREADS
+	static std::atomic<uint32_t> g_etc1s_tables_generation(0);
+#else
+	static uint32_t g_etc1s_tables_generation;
+#endif
+
 	bool basisu_lowlevel_etc1s_transcoder::decode_tables(const uint8_t* pTable_data, uint32_t table_data_size)
 	{
+		// New tables invalidate any seek checkpoints states hold for the old ones (their decoders point into the old tables).
+		do
+		{
+			m_tables_generation = ++g_etc1s_tables_generation;
+		} while (!m_tables_generation);
+
 		basist::bitwise_decoder sym_codec;
 		if (!sym_codec.init(pTable_data, table_data_size))
 		{
@@ -8510,7 +9262,8 @@ namespace basist
 
 	bool basisu_lowlevel_etc1s_transcoder::transcode_slice(void* pDst_blocks, uint32_t num_blocks_x, uint32_t num_blocks_y, const uint8_t* pImage_data, uint32_t image_data_size, block_format fmt,
 		uint32_t output_block_or_pixel_stride_in_bytes, bool bc1_allow_threecolor_blocks, const bool is_video, const bool is_alpha_slice, const uint32_t level_index, const uint32_t orig_width, const uint32_t orig_height, uint32_t output_row_pitch_in_blocks_or_pixels,
-		basisu_transcoder_state* pState, bool transcode_alpha, void *pAlpha_blocks, uint32_t output_rows_in_pixels, uint32_t decode_flags)
+		basisu_transcoder_state* pState, bool transcode_alpha, void *pAlpha_blocks, uint32_t output_rows_in_pixels, uint32_t decode_flags,
+		const basisu_block_rect* pSrc_rect)
 	{
 		// 'pDst_blocks' unused when disabling *all* hardware transcode options
 		// (and 'bc1_allow_threecolor_blocks' when disabling DXT)
@@ -8526,28 +9279,59 @@ namespace basist
 			return false;
 		}
 
+		// Build any lookup tables this source/target format combination needs on first use.
+		init_table_families(get_table_families(basis_tex_format::cETC1S, fmt));
+
 		if (!pState)
 			pState = &m_def_state;
 
 		const uint32_t total_blocks = num_blocks_x * num_blocks_y;
 
+		// The rectangle of blocks written to the output. The output's dimensions are the rectangle's.
+		uint32_t rect_x = 0, rect_y = 0, rect_num_blocks_x = num_blocks_x, rect_num_blocks_y = num_blocks_y;
+		uint32_t rect_width = orig_width, rect_height = orig_height;
+		
+		if (pSrc_rect)
+		{
+			if ((!pSrc_rect->m_width) || (!pSrc_rect->m_height) || 
+				(pSrc_rect->m_x >= num_blocks_x) || ((num_blocks_x - pSrc_rect->m_x) < pSrc_rect->m_width) ||
+				(pSrc_rect->m_y >= num_blocks_y) || ((num_blocks_y - pSrc_rect->m_y) < pSrc_rect->m_height))
+			{
+				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_slice: invalid source rectangle\n");
+				return false;
+			}
+
+			if ((is_video) || (fmt == block_format::cPVRTC1_4_RGB) || (fmt == block_format::cPVRTC1_4_RGBA))
+			{
+				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_slice: source rectangles aren't supported with video or PVRTC1\n");
+				return false;
+			}
+
+			rect_x = pSrc_rect->m_x;
+			rect_y = pSrc_rect->m_y;
+			rect_num_blocks_x = pSrc_rect->m_width;
+			rect_num_blocks_y = pSrc_rect->m_height;
+			rect_width = basisu::minimum(rect_num_blocks_x * 4, orig_width - rect_x * 4);
+			rect_height = basisu::minimum(rect_num_blocks_y * 4, orig_height - rect_y * 4);
+		}
+
 		if (!output_row_pitch_in_blocks_or_pixels)
 		{
 			if (basis_block_format_is_uncompressed(fmt))
-				output_row_pitch_in_blocks_or_pixels = orig_width;
+				output_row_pitch_in_blocks_or_pixels = rect_width;
 			else
 			{
 				if (fmt == block_format::cFXT1_RGB)
-					output_row_pitch_in_blocks_or_pixels = (orig_width + 7) / 8;
+					output_row_pitch_in_blocks_or_pixels = (rect_width + 7) / 8;
 				else
-					output_row_pitch_in_blocks_or_pixels = num_blocks_x;
+					output_row_pitch_in_blocks_or_pixels = rect_num_blocks_x;
 			}
 		}
 
 		if (basis_block_format_is_uncompressed(fmt))
 		{
 			if (!output_rows_in_pixels)
-				output_rows_in_pixels = orig_height;
+				output_rows_in_pixels = rect_height;
 		}
 		
 		basisu::vector<uint32_t>* pPrev_frame_indices = nullptr;
@@ -8656,9 +9440,60 @@ namespace basist
 		}
 #endif
 
-		for (uint32_t block_y = 0; block_y < num_blocks_y; block_y++)
+		uint32_t first_block_y = 0, end_block_y = num_blocks_y;
+		basisu_transcoder_state::etc1s_seek_index* pSeek_index = nullptr;
+
+		if (pSrc_rect)
+		{
+			// The BC7 chroma filter looks at each block's 8 neighbors.
+			const uint32_t margin = bc7_chroma_filtering ? 1 : 0;
+			const uint32_t needed_block_y = rect_y - basisu::minimum(rect_y, margin);
+			end_block_y = basisu::minimum(num_blocks_y, rect_y + rect_num_blocks_y + margin);
+
+			pSeek_index = pState->get_etc1s_seek_index(this, m_tables_generation, pImage_data, image_data_size, num_blocks_x, num_blocks_y);
+
+			// Resume decoding at the closest checkpoint at or above the first block row we need.
+			const uint32_t checkpoint_index = basisu::minimum<uint32_t>(needed_block_y / basisu_transcoder_state::cETC1SCheckpointRows, pSeek_index->m_checkpoints.size_u32());
+			if (checkpoint_index)
+			{
+				const basisu_transcoder_state::etc1s_checkpoint& checkpoint = pSeek_index->m_checkpoints[checkpoint_index - 1];
+
+				sym_codec = checkpoint.m_codec;
+				selector_history_buf = checkpoint.m_selector_history_buf;
+				cur_selector_rle_count = checkpoint.m_cur_selector_rle_count;
+				prev_endpoint_pred_sym = checkpoint.m_prev_endpoint_pred_sym;
+				endpoint_pred_repeat_count = checkpoint.m_endpoint_pred_repeat_count;
+				prev_endpoint_index = checkpoint.m_prev_endpoint_index;
+
+				// Checkpoints are always on even rows, which read the previous row's endpoints from m_block_endpoint_preds[1].
+				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+					pState->m_block_endpoint_preds[1][block_x].m_endpoint_index = checkpoint.m_prev_row_endpoint_indices[block_x];
+
+				first_block_y = checkpoint_index * basisu_transcoder_state::cETC1SCheckpointRows;
+			}
+		}
+
+		for (uint32_t block_y = first_block_y; block_y < end_block_y; block_y++)
 		{
 			const uint32_t cur_block_endpoint_pred_array = block_y & 1;
+			const uint32_t dst_block_y = block_y - rect_y;
+
+			if ((pSeek_index) && (block_y) && ((block_y % basisu_transcoder_state::cETC1SCheckpointRows) == 0) &&
+				((block_y / basisu_transcoder_state::cETC1SCheckpointRows) == (pSeek_index->m_checkpoints.size() + 1)))
+			{
+				basisu_transcoder_state::etc1s_checkpoint& checkpoint = *pSeek_index->m_checkpoints.enlarge(1);
+
+				checkpoint.m_codec = sym_codec;
+				checkpoint.m_selector_history_buf = selector_history_buf;
+				checkpoint.m_cur_selector_rle_count = cur_selector_rle_count;
+				checkpoint.m_prev_endpoint_pred_sym = prev_endpoint_pred_sym;
+				checkpoint.m_endpoint_pred_repeat_count = endpoint_pred_repeat_count;
+				checkpoint.m_prev_endpoint_index = prev_endpoint_index;
+
+				checkpoint.m_prev_row_endpoint_indices.resize(num_blocks_x);
+				for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
+					checkpoint.m_prev_row_endpoint_indices[block_x] = pState->m_block_endpoint_preds[1][block_x].m_endpoint_index;
+			}
 
 			for (uint32_t block_x = 0; block_x < num_blocks_x; block_x++)
 			{
@@ -8843,12 +9678,25 @@ namespace basist
 				if (is_video)
 					(*pPrev_frame_indices)[block_x + block_y * num_blocks_x] = endpoint_index | (selector_index << 16);
 
+				const uint32_t dst_block_x = block_x - rect_x;
+
+				if (pSrc_rect)
+				{
+#if BASISD_SUPPORT_BC7_MODE5
+					if (bc7_chroma_filtering)
+						decoded_endpoints(block_x, block_y) = (uint16_t)endpoint_index;
+#endif
+					// Only the rectangle's blocks are written to the output (relies on unsigned wraparound).
+					if ((dst_block_x >= rect_num_blocks_x) || (dst_block_y >= rect_num_blocks_y))
+						continue;
+				}
+
 #if BASISD_ENABLE_DEBUG_FLAGS
 				if ((g_debug_flags & cDebugFlagVisCRs) && ((fmt == block_format::cETC1) || (fmt == block_format::cBC1)))
 				{
 					if ((is_video) && (pred == 2))
 					{
-						decoder_etc_block* pDst_block = reinterpret_cast<decoder_etc_block*>(static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
+						decoder_etc_block* pDst_block = reinterpret_cast<decoder_etc_block*>(static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
 						memset(pDst_block, 0xFF, 8);
 						continue;
 					}
@@ -8862,7 +9710,7 @@ namespace basist
 				{
 				case block_format::cETC1:
 				{
-					decoder_etc_block* pDst_block = reinterpret_cast<decoder_etc_block*>(static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
+					decoder_etc_block* pDst_block = reinterpret_cast<decoder_etc_block*>(static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
 					
 					block.set_base5_color(decoder_etc_block::pack_color5(pEndpoints->m_color5, false));
 					block.set_inten_table(0, pEndpoints->m_inten5);
@@ -8876,7 +9724,7 @@ namespace basist
 				case block_format::cBC1:
 				{
 #if BASISD_SUPPORT_DXT1
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 #if BASISD_ENABLE_DEBUG_FLAGS
 					if (g_debug_flags & (cDebugFlagVisBC1Sels | cDebugFlagVisBC1Endpoints))
 						convert_etc1s_to_dxt1_vis(static_cast<dxt1_block*>(pDst_block), pEndpoints, pSelector, bc1_allow_threecolor_blocks);
@@ -8891,7 +9739,7 @@ namespace basist
 				case block_format::cBC4:
 				{
 #if BASISD_SUPPORT_DXT5A
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_dxt5a(static_cast<dxt5a_block*>(pDst_block), pEndpoints, pSelector);
 #else
 					assert(0);
@@ -8995,7 +9843,7 @@ namespace basist
 						decoded_endpoints(block_x, block_y) = (uint16_t)endpoint_index;
 					}
 
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_bc7_m5_color(pDst_block, pEndpoints, pSelector);
 #else
 					assert(0);
@@ -9005,7 +9853,7 @@ namespace basist
 				case block_format::cBC7_M5_ALPHA:
 				{
 #if BASISD_SUPPORT_BC7_MODE5
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_bc7_m5_alpha(pDst_block, pEndpoints, pSelector);
 #else
 					assert(0);
@@ -9015,7 +9863,7 @@ namespace basist
 				case block_format::cETC2_EAC_A8:
 				{
 #if BASISD_SUPPORT_ETC2_EAC_A8
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_etc2_eac_a8(static_cast<eac_block*>(pDst_block), pEndpoints, pSelector);
 #else
 					assert(0);
@@ -9025,7 +9873,7 @@ namespace basist
 				case block_format::cASTC_LDR_4x4:
 				{
 #if BASISD_SUPPORT_ASTC
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_astc_4x4(pDst_block, pEndpoints, pSelector, transcode_alpha, &endpoints[0], &selectors[0]);
 #else
 					assert(0);
@@ -9035,7 +9883,7 @@ namespace basist
 				case block_format::cATC_RGB:
 				{
 #if BASISD_SUPPORT_ATC
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_atc(pDst_block, pEndpoints, pSelector);
 #else
 					assert(0);
@@ -9045,9 +9893,9 @@ namespace basist
 				case block_format::cFXT1_RGB:
 				{
 #if BASISD_SUPPORT_FXT1
-					const uint32_t fxt1_block_x = block_x >> 1;
-					const uint32_t fxt1_block_y = block_y;
-					const uint32_t fxt1_subblock = block_x & 1;
+					const uint32_t fxt1_block_x = dst_block_x >> 1;
+					const uint32_t fxt1_block_y = dst_block_y;
+					const uint32_t fxt1_subblock = dst_block_x & 1;
 
 					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (fxt1_block_x + fxt1_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 
@@ -9060,7 +9908,7 @@ namespace basist
 				case block_format::cPVRTC2_4_RGB:
 				{
 #if BASISD_SUPPORT_PVRTC2
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_pvrtc2_rgb(pDst_block, pEndpoints, pSelector);
 #endif
 					break;
@@ -9070,7 +9918,7 @@ namespace basist
 #if BASISD_SUPPORT_PVRTC2
 					assert(transcode_alpha);
 
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 										
 					convert_etc1s_to_pvrtc2_rgba(pDst_block, pEndpoints, pSelector, &endpoints[0], &selectors[0]);
 #endif
@@ -9078,7 +9926,7 @@ namespace basist
 				}
 				case block_format::cIndices:
 				{
-					uint16_t* pDst_block = reinterpret_cast<uint16_t *>(static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
+					uint16_t* pDst_block = reinterpret_cast<uint16_t *>(static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes);
 					pDst_block[0] = static_cast<uint16_t>(endpoint_index);
 					pDst_block[1] = static_cast<uint16_t>(selector_index);
 					break;
@@ -9086,10 +9934,10 @@ namespace basist
 				case block_format::cA32:
 				{
 					assert(sizeof(uint32_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
 										
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 					
 					int colors[4];
 					decoder_etc_block::get_block_colors5_g(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9126,10 +9974,10 @@ namespace basist
 				case block_format::cRGB32:
 				{
 					assert(sizeof(uint32_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9155,10 +10003,10 @@ namespace basist
 				case block_format::cRGBA32:
 				{
 					assert(sizeof(uint32_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint32_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9186,10 +10034,10 @@ namespace basist
 				case block_format::cBGR565:
 				{
 					assert(sizeof(uint16_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9229,10 +10077,10 @@ namespace basist
 				case block_format::cRGBA4444_COLOR:
 				{
 					assert(sizeof(uint16_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9269,10 +10117,10 @@ namespace basist
 				case block_format::cRGBA4444_COLOR_OPAQUE:
 				{
 					assert(sizeof(uint16_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9300,10 +10148,10 @@ namespace basist
 				case block_format::cRGBA4444_ALPHA:
 				{
 					assert(sizeof(uint16_t) == output_block_or_pixel_stride_in_bytes);
-					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (block_x * 4 + block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
+					uint8_t* pDst_pixels = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x * 4 + dst_block_y * 4 * output_row_pitch_in_blocks_or_pixels) * sizeof(uint16_t);
 
-					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)block_x * 4);
-					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)block_y * 4);
+					const uint32_t max_x = basisu::minimum<int>(4, (int)output_row_pitch_in_blocks_or_pixels - (int)dst_block_x * 4);
+					const uint32_t max_y = basisu::minimum<int>(4, (int)output_rows_in_pixels - (int)dst_block_y * 4);
 
 					color32 colors[4];
 					decoder_etc_block::get_block_colors5(colors, pEndpoints->m_color5, pEndpoints->m_inten5);
@@ -9333,7 +10181,7 @@ namespace basist
 				case block_format::cETC2_EAC_R11:
 				{
 #if BASISD_SUPPORT_ETC2_EAC_RG11
-					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (block_x + block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
+					void* pDst_block = static_cast<uint8_t*>(pDst_blocks) + (dst_block_x + dst_block_y * output_row_pitch_in_blocks_or_pixels) * output_block_or_pixel_stride_in_bytes;
 					convert_etc1s_to_etc2_eac_r11(static_cast<eac_block*>(pDst_block), pEndpoints, pSelector);
 #else
 					assert(0);
@@ -9351,7 +10199,7 @@ namespace basist
 
 		} // block_y
 
-		if (endpoint_pred_repeat_count != 0)
+		if ((end_block_y == num_blocks_y) && (endpoint_pred_repeat_count != 0))
 		{
 			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_slice: endpoint_pred_repeat_count != 0. The file is corrupted or this is a bug\n");
 			
@@ -9374,7 +10222,8 @@ namespace basist
 #if BASISD_SUPPORT_BC7_MODE5
 		if (bc7_chroma_filtering)
 		{
-			chroma_filter_bc7_mode5(decoded_endpoints, pDst_blocks, num_blocks_x, num_blocks_y, output_row_pitch_in_blocks_or_pixels, &endpoints[0]);
+			chroma_filter_bc7_mode5(decoded_endpoints, pDst_blocks, num_blocks_x, num_blocks_y, output_row_pitch_in_blocks_or_pixels, &endpoints[0],
+				rect_x, rect_y, rect_num_blocks_x, rect_num_blocks_y);
 		}
 #endif
 
@@ -9472,6 +10321,156 @@ namespace basist
 		return total_dst_blocks * bytes_per_block;
 	}
 
+	static uint32_t upload_layout_lcm(uint32_t a, uint32_t b)
+	{
+		a = basisu::maximum<uint32_t>(a, 1);
+		b = basisu::maximum<uint32_t>(b, 1);
+
+		uint32_t x = a, y = b;
+		while (y)
+		{
+			const uint32_t t = x % y;
+			x = y;
+			y = t;
+		}
+
+		return (a / x) * b;
+	}
+
+	static inline uint64_t upload_layout_align(uint64_t v, uint32_t alignment)
+	{
+		return ((v + alignment - 1) / alignment) * alignment;
+	}
+
+	// Resolves one of transcoder_upload_layout's first/total ranges against the number of available levels/layers/faces.
+	static bool resolve_upload_layout_range(uint32_t first, uint32_t total, uint32_t num_available, uint32_t& end)
+	{
+		if (first >= num_available)
+			return false;
+
+		if (!total)
+			total = num_available - first;
+		else if (total > (num_available - first))
+			return false;
+
+		end = first + total;
+		return true;
+	}
+
+	static void add_upload_layout_subresource(basisu::vector<transcoder_subresource_desc>& subresources, uint32_t level_index, uint32_t layer_index, uint32_t face_index, uint32_t orig_width, uint32_t orig_height)
+	{
+		transcoder_subresource_desc* pDesc = subresources.enlarge(1);
+		memset(pDesc, 0, sizeof(transcoder_subresource_desc));
+
+		pDesc->m_level_index = level_index;
+		pDesc->m_layer_index = layer_index;
+		pDesc->m_face_index = face_index;
+		pDesc->m_orig_width = orig_width;
+		pDesc->m_orig_height = orig_height;
+	}
+
+	// Places subresources (already in buffer order, with their indices and dimensions filled in) in the upload buffer, following layout's rules.
+	static bool assign_upload_layout_offsets(transcoder_texture_format fmt, const transcoder_upload_layout& layout, basisu::vector<transcoder_subresource_desc>& subresources, uint64_t& total_size)
+	{
+		const bool is_uncompressed = basis_transcoder_format_is_uncompressed(fmt);
+		const bool is_pvrtc1 = (fmt == transcoder_texture_format::cTFPVRTC1_4_RGB) || (fmt == transcoder_texture_format::cTFPVRTC1_4_RGBA);
+		const uint32_t bytes_per_block_or_pixel = basis_get_bytes_per_block_or_pixel(fmt);
+		const uint32_t block_width = is_uncompressed ? 1 : basis_get_block_width(fmt);
+		const uint32_t block_height = is_uncompressed ? 1 : basis_get_block_height(fmt);
+
+		// Row pitches must always be a whole number of blocks or pixels.
+		uint32_t row_pitch_alignment = upload_layout_lcm(layout.m_row_pitch_alignment, bytes_per_block_or_pixel);
+		uint32_t subresource_alignment = basisu::maximum<uint32_t>(layout.m_subresource_alignment, 1);
+
+		switch (layout.m_rules)
+		{
+		case transcoder_upload_layout_rules::cVulkan:
+			// VkBufferImageCopy::bufferOffset
+			subresource_alignment = upload_layout_lcm(subresource_alignment, upload_layout_lcm(4, bytes_per_block_or_pixel));
+			break;
+		case transcoder_upload_layout_rules::cD3D12:
+			// D3D12_TEXTURE_DATA_PITCH_ALIGNMENT, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT
+			row_pitch_alignment = upload_layout_lcm(row_pitch_alignment, 256);
+			subresource_alignment = upload_layout_lcm(subresource_alignment, 512);
+			break;
+		default:
+			break;
+		}
+
+		uint64_t cur_ofs = 0;
+
+		for (uint32_t i = 0; i < subresources.size(); i++)
+		{
+			transcoder_subresource_desc& desc = subresources[i];
+
+			desc.m_num_blocks_x = (desc.m_orig_width + block_width - 1) / block_width;
+			desc.m_num_blocks_y = (desc.m_orig_height + block_height - 1) / block_height;
+
+			const uint64_t packed_row_pitch = (uint64_t)desc.m_num_blocks_x * bytes_per_block_or_pixel;
+
+			// PVRTC1 is swizzled, so it doesn't have rows.
+			const uint64_t row_pitch = is_pvrtc1 ? packed_row_pitch : upload_layout_align(packed_row_pitch, row_pitch_alignment);
+			const uint64_t size = is_pvrtc1 ? basis_compute_transcoded_image_size_in_bytes(fmt, desc.m_orig_width, desc.m_orig_height) : (row_pitch * desc.m_num_blocks_y);
+
+			if ((row_pitch > UINT32_MAX) || (size > UINT32_MAX))
+			{
+				BASISU_DEVEL_ERROR("assign_upload_layout_offsets: subresource too large\n");
+				return false;
+			}
+
+			cur_ofs = upload_layout_align(cur_ofs, subresource_alignment);
+
+			desc.m_offset = cur_ofs;
+			desc.m_row_pitch = (uint32_t)row_pitch;
+			desc.m_size = (uint32_t)size;
+
+			cur_ofs += size;
+		}
+
+		total_size = cur_ofs;
+		return true;
+	}
+
+	// The transcode_image_level() output buffer parameters of a subresource placed by assign_upload_layout_offsets().
+	static void get_upload_layout_output_params(transcoder_texture_format fmt, const transcoder_subresource_desc& desc,
+		uint32_t& output_blocks_buf_size_in_blocks_or_pixels, uint32_t& output_row_pitch_in_blocks_or_pixels, uint32_t& output_rows_in_pixels)
+	{
+		const uint32_t bytes_per_block_or_pixel = basis_get_bytes_per_block_or_pixel(fmt);
+
+		output_blocks_buf_size_in_blocks_or_pixels = desc.m_size / bytes_per_block_or_pixel;
+		output_row_pitch_in_blocks_or_pixels = desc.m_row_pitch / bytes_per_block_or_pixel;
+		output_rows_in_pixels = basis_transcoder_format_is_uncompressed(fmt) ? desc.m_orig_height : 0;
+	}
+
+	// Orders subresource indices level by level (the order the data is stored in KTX2 files), so each level's data only needs to be fetched once.
+	struct upload_layout_level_order
+	{
+		const transcoder_subresource_desc* m_pSubresources;
+
+		bool operator()(uint32_t a, uint32_t b) const
+		{
+			const transcoder_subresource_desc& l = m_pSubresources[a];
+			const transcoder_subresource_desc& r = m_pSubresources[b];
+
+			if (l.m_level_index != r.m_level_index)
+				return l.m_level_index < r.m_level_index;
+			if (l.m_layer_index != r.m_layer_index)
+				return l.m_layer_index < r.m_layer_index;
+			return l.m_face_index < r.m_face_index;
+		}
+	};
+
+	static void get_upload_layout_level_order(const basisu::vector<transcoder_subresource_desc>& subresources, basisu::vector<uint32_t>& order)
+	{
+		order.resize(subresources.size());
+		for (uint32_t i = 0; i < order.size(); i++)
+			order[i] = i;
+
+		upload_layout_level_order comp;
+		comp.m_pSubresources = subresources.data();
+		std::sort(order.begin(), order.end(), comp);
+	}
+
 	bool basisu_lowlevel_etc1s_transcoder::transcode_image(
 			transcoder_texture_format target_format,
 			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
@@ -9483,7 +10482,8 @@ namespace basist
 			bool is_video,
 			uint32_t output_row_pitch_in_blocks_or_pixels,
 			basisu_transcoder_state* pState,
-			uint32_t output_rows_in_pixels)
+			uint32_t output_rows_in_pixels,
+			const basisu_block_rect* pSrc_rect)
 	{
 		if (((uint64_t)rgb_offset + rgb_length) > (uint64_t)compressed_data_length)
 		{
@@ -9523,8 +10523,30 @@ namespace basist
 		const bool transcode_alpha_data_to_opaque_formats = (decode_flags & cDecodeFlagsTranscodeAlphaDataToOpaqueFormats) != 0;
 		const uint32_t bytes_per_block_or_pixel = basis_get_bytes_per_block_or_pixel(target_format);
 		const uint32_t total_slice_blocks = num_blocks_x * num_blocks_y;
+
+		// The output's dimensions, which are the source rectangle's if there is one. transcode_slice() validates the rectangle.
+		uint32_t output_num_blocks_x = num_blocks_x, output_num_blocks_y = num_blocks_y, output_width = orig_width, output_height = orig_height;
+		if (pSrc_rect)
+		{
+			if ((!pSrc_rect->m_width) || (!pSrc_rect->m_height) || (pSrc_rect->m_x >= num_blocks_x) || (pSrc_rect->m_y >= num_blocks_y))
+			{
+				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: invalid source rectangle\n");
+				return false;
+			}
+
+			if ((target_format == transcoder_texture_format::cTFPVRTC1_4_RGB) || (target_format == transcoder_texture_format::cTFPVRTC1_4_RGBA))
+			{
+				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: PVRTC1 doesn't support source rectangles\n");
+				return false;
+			}
+
+			output_num_blocks_x = pSrc_rect->m_width;
+			output_num_blocks_y = pSrc_rect->m_height;
+			output_width = basisu::minimum(output_num_blocks_x * 4, orig_width - pSrc_rect->m_x * 4);
+			output_height = basisu::minimum(output_num_blocks_y * 4, orig_height - pSrc_rect->m_y * 4);
+		}
 		
-		if (!basis_validate_output_buffer_size(target_format, output_blocks_buf_size_in_blocks_or_pixels, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels))
+		if (!basis_validate_output_buffer_size(target_format, output_blocks_buf_size_in_blocks_or_pixels, output_width, output_height, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels))
 		{
 			BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: output buffer size too small\n");
 			return false;
@@ -9549,7 +10571,7 @@ namespace basist
 		case transcoder_texture_format::cTFETC1_RGB:
 		{
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC1, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cETC1, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cETC1, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 							
 			if (!status)
 			{
@@ -9564,7 +10586,7 @@ namespace basist
 			return false;
 #else
 			// status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC1, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cBC1, bytes_per_block_or_pixel, true, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cBC1, bytes_per_block_or_pixel, true, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to BC1 failed\n");
@@ -9579,7 +10601,7 @@ namespace basist
 			return false;
 #else
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC4, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to BC4 failed\n");
@@ -9595,7 +10617,7 @@ namespace basist
 #else
 			// output_row_pitch_in_blocks_or_pixels is actually ignored because we're transcoding to PVRTC1. (Print a dev warning if it's != 0?)
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cPVRTC1_4_RGB, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cPVRTC1_4_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cPVRTC1_4_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to PVRTC1 4 RGB failed\n");
@@ -9617,7 +10639,7 @@ namespace basist
 
 			// First transcode alpha data to temp buffer
 			//status = transcode_slice(pData, data_size, slice_index + 1, &temp_block_indices[0], total_slice_blocks, block_format::cIndices, sizeof(uint32_t), decode_flags, pSlice_descs[slice_index].m_num_blocks_x, pState);
-			status = transcode_slice(&temp_block_indices[0], num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, sizeof(uint32_t), false, is_video, true, level_index, orig_width, orig_height, num_blocks_x, pState, false, nullptr, 0, decode_flags);
+			status = transcode_slice(&temp_block_indices[0], num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, sizeof(uint32_t), false, is_video, true, level_index, orig_width, orig_height, num_blocks_x, pState, false, nullptr, 0, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to PVRTC1 4 RGBA failed (0)\n");
@@ -9626,7 +10648,7 @@ namespace basist
 			{
 				// output_row_pitch_in_blocks_or_pixels is actually ignored because we're transcoding to PVRTC1. (Print a dev warning if it's != 0?)
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cPVRTC1_4_RGBA, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState, &temp_block_indices[0]);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC1_4_RGBA, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, &temp_block_indices[0], 0, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC1_4_RGBA, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, &temp_block_indices[0], 0, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to PVRTC1 4 RGBA failed (1)\n");
@@ -9648,13 +10670,13 @@ namespace basist
 
 			// First transcode the color slice. The cBC7_M5_COLOR transcoder will output opaque mode 5 blocks.
 			//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC7_M5_COLOR, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC7_M5_COLOR, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC7_M5_COLOR, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 
 			if ((status) && (basis_file_has_alpha_slices))
 			{
 				// Now transcode the alpha slice. The cBC7_M5_ALPHA transcoder will now change the opaque mode 5 blocks to blocks with alpha.
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC7_M5_ALPHA, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC7_M5_ALPHA, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC7_M5_ALPHA, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			}
 
 			if (!status)
@@ -9677,12 +10699,12 @@ namespace basist
 			{
 				// First decode the alpha data 
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC2_EAC_A8, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cETC2_EAC_A8, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cETC2_EAC_A8, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			}
 			else
 			{
 				//write_opaque_alpha_blocks(pSlice_descs[slice_index].m_num_blocks_x, pSlice_descs[slice_index].m_num_blocks_y, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC2_EAC_A8, 16, output_row_pitch_in_blocks_or_pixels);
-				basisu_transcoder::write_opaque_alpha_blocks(num_blocks_x, num_blocks_y, pOutput_blocks, block_format::cETC2_EAC_A8, 16, output_row_pitch_in_blocks_or_pixels);
+				basisu_transcoder::write_opaque_alpha_blocks(output_num_blocks_x, output_num_blocks_y, pOutput_blocks, block_format::cETC2_EAC_A8, 16, output_row_pitch_in_blocks_or_pixels);
 				status = true;
 			}
 
@@ -9690,7 +10712,7 @@ namespace basist
 			{
 				// Now decode the color data
 				//status = transcode_slice(pData, data_size, slice_index, (uint8_t*)pOutput_blocks + 8, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC1, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cETC1, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cETC1, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to ETC2 RGB failed\n");
@@ -9718,11 +10740,11 @@ namespace basist
 			if (basis_file_has_alpha_slices)
 			{
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC4, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			}
 			else
 			{
-				basisu_transcoder::write_opaque_alpha_blocks(num_blocks_x, num_blocks_y, pOutput_blocks, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
+				basisu_transcoder::write_opaque_alpha_blocks(output_num_blocks_x, output_num_blocks_y, pOutput_blocks, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
 				status = true;
 			}
 
@@ -9730,7 +10752,7 @@ namespace basist
 			{
 				// Now decode the color data. Forbid 3 color blocks, which aren't allowed in BC3.
 				//status = transcode_slice(pData, data_size, slice_index, (uint8_t*)pOutput_blocks + 8, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC1, 16, decode_flags | cDecodeFlagsBC1ForbidThreeColorBlocks, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC1, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC1, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to BC3 RGB failed\n");
@@ -9758,14 +10780,14 @@ namespace basist
 
 			// Decode the R data (actually the green channel of the color data slice in the basis file)
 			//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC4, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (status)
 			{
 				if (basis_file_has_alpha_slices)
 				{
 					// Decode the G data (actually the green channel of the alpha data slice in the basis file)
 					//status = transcode_slice(pData, data_size, slice_index + 1, (uint8_t*)pOutput_blocks + 8, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC4, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-					status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+					status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 					if (!status)
 					{
 						BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to BC5 1 failed\n");
@@ -9773,7 +10795,7 @@ namespace basist
 				}
 				else
 				{
-					basisu_transcoder::write_opaque_alpha_blocks(num_blocks_x, num_blocks_y, (uint8_t*)pOutput_blocks + 8, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
+					basisu_transcoder::write_opaque_alpha_blocks(output_num_blocks_x, output_num_blocks_y, (uint8_t*)pOutput_blocks + 8, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
 					status = true;
 				}
 			}
@@ -9796,18 +10818,18 @@ namespace basist
 			{
 				// First decode the alpha data to the output (we're using the output texture as a temp buffer here).
 				//status = transcode_slice(pData, data_size, slice_index + 1, (uint8_t*)pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cIndices, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (status)
 				{
 					// Now decode the color data and transcode to ASTC. The transcoder function will read the alpha selector data from the output texture as it converts and
 					// transcode both the alpha and color data at the same time to ASTC.
 					//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cASTC_LDR_4x4, 16, decode_flags | cDecodeFlagsOutputHasAlphaIndices, output_row_pitch_in_blocks_or_pixels, pState);
-					status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cASTC_LDR_4x4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, true, nullptr, output_rows_in_pixels, decode_flags);
+					status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cASTC_LDR_4x4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, true, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				}
 			}
 			else
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cASTC_LDR_4x4, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cASTC_LDR_4x4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cASTC_LDR_4x4, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 
 			if (!status)
 			{
@@ -9824,7 +10846,7 @@ namespace basist
 			return false;
 #else
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cATC_RGB, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cATC_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cATC_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to ATC_RGB failed\n");
@@ -9847,18 +10869,18 @@ namespace basist
 			if (basis_file_has_alpha_slices)
 			{
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cBC4, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cBC4, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			}
 			else
 			{
-				basisu_transcoder::write_opaque_alpha_blocks(num_blocks_x, num_blocks_y, pOutput_blocks, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
+				basisu_transcoder::write_opaque_alpha_blocks(output_num_blocks_x, output_num_blocks_y, pOutput_blocks, block_format::cBC4, 16, output_row_pitch_in_blocks_or_pixels);
 				status = true;
 			}
 
 			if (status)
 			{
 				//status = transcode_slice(pData, data_size, slice_index, (uint8_t*)pOutput_blocks + 8, output_blocks_buf_size_in_blocks_or_pixels, block_format::cATC_RGB, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cATC_RGB, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cATC_RGB, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to ATC RGB failed\n");
@@ -9878,7 +10900,7 @@ namespace basist
 			return false;
 #else
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to cPVRTC2_4_RGB failed\n");
@@ -9896,7 +10918,7 @@ namespace basist
 			{
 				// First decode the alpha data to the output (we're using the output texture as a temp buffer here).
 				//status = transcode_slice(pData, data_size, slice_index + 1, (uint8_t*)pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cIndices, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cIndices, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to failed\n");
@@ -9905,12 +10927,12 @@ namespace basist
 				{
 					// Now decode the color data and transcode to PVRTC2 RGBA. 
 					//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cPVRTC2_4_RGBA, bytes_per_block_or_pixel, decode_flags | cDecodeFlagsOutputHasAlphaIndices, output_row_pitch_in_blocks_or_pixels, pState);
-					status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC2_4_RGBA, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, true, nullptr, output_rows_in_pixels, decode_flags);
+					status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC2_4_RGBA, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, true, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				}
 			}
 			else
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cPVRTC2_4_RGB, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 
 			if (!status)
 			{
@@ -9927,14 +10949,14 @@ namespace basist
 			// First decode the alpha data 
 			if (basis_file_has_alpha_slices)
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cA32, sizeof(uint32_t), decode_flags, output_row_pitch_in_blocks_or_pixels, pState, nullptr, output_rows_in_pixels);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cA32, sizeof(uint32_t), false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cA32, sizeof(uint32_t), false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			else
 				status = true;
 
 			if (status)
 			{
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, basis_file_has_alpha_slices ? block_format::cRGB32 : block_format::cRGBA32, sizeof(uint32_t), decode_flags, output_row_pitch_in_blocks_or_pixels, pState, nullptr, output_rows_in_pixels);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, basis_file_has_alpha_slices ? block_format::cRGB32 : block_format::cRGBA32, sizeof(uint32_t), false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, basis_file_has_alpha_slices ? block_format::cRGB32 : block_format::cRGBA32, sizeof(uint32_t), false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to RGBA32 RGB failed\n");
@@ -9953,7 +10975,7 @@ namespace basist
 			// Raw 16bpp pixels, decoded in the usual raster order (NOT block order) into an image in memory.
 
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, (fmt == transcoder_texture_format::cTFRGB565) ? block_format::cRGB565 : block_format::cBGR565, sizeof(uint16_t), decode_flags, output_row_pitch_in_blocks_or_pixels, pState, nullptr, output_rows_in_pixels);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, (target_format == transcoder_texture_format::cTFRGB565) ? block_format::cRGB565 : block_format::cBGR565, sizeof(uint16_t), false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, (target_format == transcoder_texture_format::cTFRGB565) ? block_format::cRGB565 : block_format::cBGR565, sizeof(uint16_t), false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to RGB565 RGB failed\n");
@@ -9968,14 +10990,14 @@ namespace basist
 			// First decode the alpha data 
 			if (basis_file_has_alpha_slices)
 				//status = transcode_slice(pData, data_size, slice_index + 1, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cRGBA4444_ALPHA, sizeof(uint16_t), decode_flags, output_row_pitch_in_blocks_or_pixels, pState, nullptr, output_rows_in_pixels);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cRGBA4444_ALPHA, sizeof(uint16_t), false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cRGBA4444_ALPHA, sizeof(uint16_t), false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			else
 				status = true;
 
 			if (status)
 			{
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, basis_file_has_alpha_slices ? block_format::cRGBA4444_COLOR : block_format::cRGBA4444_COLOR_OPAQUE, sizeof(uint16_t), decode_flags, output_row_pitch_in_blocks_or_pixels, pState, nullptr, output_rows_in_pixels);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, basis_file_has_alpha_slices ? block_format::cRGBA4444_COLOR : block_format::cRGBA4444_COLOR_OPAQUE, sizeof(uint16_t), false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, basis_file_has_alpha_slices ? block_format::cRGBA4444_COLOR : block_format::cRGBA4444_COLOR_OPAQUE, sizeof(uint16_t), false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to RGBA4444 RGB failed\n");
@@ -9995,7 +11017,7 @@ namespace basist
 			return false;
 #else
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cFXT1_RGB, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cFXT1_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cFXT1_RGB, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to FXT1_RGB failed\n");
@@ -10010,7 +11032,7 @@ namespace basist
 			return false;
 #else
 			//status = transcode_slice(pData, data_size, slice_index_to_decode, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+			status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pData, data_len, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, is_alpha_slice, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			if (!status)
 			{
 				BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to ETC2_EAC_R11 failed\n");
@@ -10031,11 +11053,11 @@ namespace basist
 			{
 				// First decode the alpha data to G
 				//status = transcode_slice(pData, data_size, slice_index + 1, (uint8_t*)pOutput_blocks + 8, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC2_EAC_R11, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice((uint8_t *)pOutput_blocks + 8, num_blocks_x, num_blocks_y, pCompressed_data + alpha_offset, alpha_length, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, true, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 			}
 			else
 			{
-				basisu_transcoder::write_opaque_alpha_blocks(num_blocks_x, num_blocks_y, (uint8_t*)pOutput_blocks + 8, block_format::cETC2_EAC_R11, 16, output_row_pitch_in_blocks_or_pixels);
+				basisu_transcoder::write_opaque_alpha_blocks(output_num_blocks_x, output_num_blocks_y, (uint8_t*)pOutput_blocks + 8, block_format::cETC2_EAC_R11, 16, output_row_pitch_in_blocks_or_pixels);
 				status = true;
 			}
 
@@ -10043,7 +11065,7 @@ namespace basist
 			{
 				// Now decode the color data to R
 				//status = transcode_slice(pData, data_size, slice_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, block_format::cETC2_EAC_R11, 16, decode_flags, output_row_pitch_in_blocks_or_pixels, pState);
-				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags);
+				status = transcode_slice(pOutput_blocks, num_blocks_x, num_blocks_y, pCompressed_data + rgb_offset, rgb_length, block_format::cETC2_EAC_R11, bytes_per_block_or_pixel, false, is_video, false, level_index, orig_width, orig_height, output_row_pitch_in_blocks_or_pixels, pState, false, nullptr, output_rows_in_pixels, decode_flags, pSrc_rect);
 				if (!status)
 				{
 					BASISU_DEVEL_ERROR("basisu_lowlevel_etc1s_transcoder::transcode_image: transcode_slice() to ETC2_EAC_R11 R failed\n");
@@ -10091,6 +11113,8 @@ namespace basist
 			return false;
 		}
 
+		init_table_families(get_table_families(basis_tex_format::cUASTC_LDR_4x4, fmt));
+
 #if BASISD_SUPPORT_UASTC
 		const uint32_t total_blocks = num_blocks_x * num_blocks_y;
 
@@ -10621,6 +11645,8 @@ namespace basist
 			return false;
 		}
 
+		init_table_families(get_table_families(basis_tex_format::cUASTC_HDR_4x4, fmt));
+
 #if BASISD_SUPPORT_UASTC_HDR
 		const uint32_t total_blocks = num_blocks_x * num_blocks_y;
 
@@ -10935,6 +11961,8 @@ namespace basist
 			return false;
 		}
 
+		init_table_families(get_table_families(basis_tex_format::cASTC_HDR_6x6, fmt));
+
 #if BASISD_SUPPORT_UASTC_HDR
 		const uint32_t total_src_blocks = num_blocks_x * num_blocks_y;
 
@@ -11371,6 +12399,8 @@ namespace basist
 			return false;
 		}
 
+		init_table_families(get_table_families(basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE, fmt));
+
 #if BASISD_SUPPORT_UASTC_HDR
 
 		// TODO: Optimize this
@@ -12700,6 +13730,27 @@ namespace basist
 				m_lowlevel_etc1s_decoder.clear();
 			}
 		}
+
+		// Index the I-frames once, so seeking and splitting video into GOPs doesn't have to scan the slice descs.
+		m_video_iframe_indices.clear();
+		if ((pHeader->m_tex_type == cBASISTexTypeVideoFrames) && (pHeader->m_tex_format == (int)basis_tex_format::cETC1S))
+		{
+			const basis_slice_desc* pSlice_descs = reinterpret_cast<const basis_slice_desc*>(pDataU8 + pHeader->m_slice_desc_file_ofs);
+
+			// Slices always appear in image order, so each level's list is sorted.
+			for (uint32_t slice_index = 0; slice_index < pHeader->m_total_slices; slice_index++)
+			{
+				const basis_slice_desc& slice_desc = pSlice_descs[slice_index];
+				if ((slice_desc.m_flags & cSliceDescFlagsHasAlpha) || ((slice_desc.m_flags & cSliceDescFlagsFrameIsIFrame) == 0))
+					continue;
+
+				const uint32_t level_index = slice_desc.m_level_index;
+				if (level_index >= m_video_iframe_indices.size())
+					m_video_iframe_indices.resize(level_index + 1);
+
+				m_video_iframe_indices[level_index].push_back(slice_desc.m_image_index);
+			}
+		}
 		
 		m_ready_to_transcode = true;
 
@@ -12709,6 +13760,7 @@ namespace basist
 	bool basisu_transcoder::stop_transcoding()
 	{
 		m_lowlevel_etc1s_decoder.clear();
+		m_video_iframe_indices.clear();
 
 		m_ready_to_transcode = false;
 		
@@ -13216,13 +14268,20 @@ namespace basist
 				assert(pSlice_desc->m_level_index == pAlpha_slice_desc->m_level_index);
 			}
 
+			const bool is_video = (pHeader->m_tex_type == cBASISTexTypeVideoFrames);
+			if ((is_video) && (!pState))
+				pState = &m_lowlevel_etc1s_decoder.m_def_state;
+
 			// Use the container independent image transcode method.
 			status = m_lowlevel_etc1s_decoder.transcode_image(fmt,
 				pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
 				(const uint8_t *)pData, data_size, pSlice_desc->m_num_blocks_x, pSlice_desc->m_num_blocks_y, pSlice_desc->m_orig_width, pSlice_desc->m_orig_height, pSlice_desc->m_level_index,
 				pSlice_desc->m_file_ofs, pSlice_desc->m_file_size,
 				(pAlpha_slice_desc != nullptr) ? (uint32_t)pAlpha_slice_desc->m_file_ofs : 0U, (pAlpha_slice_desc != nullptr) ? (uint32_t)pAlpha_slice_desc->m_file_size : 0U,
-				decode_flags, basis_file_has_alpha_slices, pHeader->m_tex_type == cBASISTexTypeVideoFrames, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels);
+				decode_flags, basis_file_has_alpha_slices, is_video, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels);
+
+			if (is_video)
+				pState->update_prev_frame_index(pSlice_desc->m_level_index, image_index, (pSlice_desc->m_flags & cSliceDescFlagsFrameIsIFrame) != 0, status);
 
 		} // if (pHeader->m_tex_format == (int)basis_tex_format::cUASTC4x4)
       
@@ -13238,6 +14297,338 @@ namespace basist
 		return status;
 	}
 
+	// Returns the closest I-frame at or before frame_index in a sorted I-frame index, or -1.
+	static int find_iframe_in_index(const basisu::vector<uint32_t>& iframe_indices, uint32_t frame_index)
+	{
+		const uint32_t* pNext_iframe = std::upper_bound(iframe_indices.begin(), iframe_indices.end(), frame_index);
+		if (pNext_iframe == iframe_indices.begin())
+			return -1;
+		return (int)pNext_iframe[-1];
+	}
+
+	bool basisu_transcoder::get_video_iframe_index(const void* pData, uint32_t data_size, basisu::vector<uint32_t>& iframe_image_indices, uint32_t level_index) const
+	{
+		iframe_image_indices.resize(0);
+
+		const uint32_t total_images = get_total_images(pData, data_size);
+		if (!total_images)
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::get_video_iframe_index: header validation failed\n");
+			return false;
+		}
+
+		const basis_file_header* pHeader = static_cast<const basis_file_header*>(pData);
+		const basis_slice_desc* pSlice_descs = reinterpret_cast<const basis_slice_desc*>(static_cast<const uint8_t*>(pData) + pHeader->m_slice_desc_file_ofs);
+		const bool is_video = (pHeader->m_tex_type == cBASISTexTypeVideoFrames) && (pHeader->m_tex_format == (int)basis_tex_format::cETC1S);
+
+		if ((is_video) && (m_ready_to_transcode))
+		{
+			if (level_index < m_video_iframe_indices.size())
+				iframe_image_indices = m_video_iframe_indices[level_index];
+			return true;
+		}
+
+		for (uint32_t slice_index = 0; slice_index < pHeader->m_total_slices; slice_index++)
+		{
+			const basis_slice_desc& slice_desc = pSlice_descs[slice_index];
+			if ((slice_desc.m_level_index != level_index) || (slice_desc.m_flags & cSliceDescFlagsHasAlpha))
+				continue;
+
+			if ((!is_video) || (slice_desc.m_flags & cSliceDescFlagsFrameIsIFrame))
+				iframe_image_indices.push_back(slice_desc.m_image_index);
+		}
+
+		return true;
+	}
+
+	int basisu_transcoder::find_video_iframe(const void* pData, uint32_t data_size, uint32_t image_index, uint32_t level_index) const
+	{
+		if (!validate_header_quick(pData, data_size))
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::find_video_iframe: header validation failed\n");
+			return -1;
+		}
+
+		const basis_file_header* pHeader = static_cast<const basis_file_header*>(pData);
+		if (image_index >= pHeader->m_total_images)
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::find_video_iframe: invalid image_index\n");
+			return -1;
+		}
+
+		if ((pHeader->m_tex_type != cBASISTexTypeVideoFrames) || (pHeader->m_tex_format != (int)basis_tex_format::cETC1S))
+			return image_index;
+
+		int iframe_index;
+		if (m_ready_to_transcode)
+		{
+			iframe_index = (level_index < m_video_iframe_indices.size()) ? find_iframe_in_index(m_video_iframe_indices[level_index], image_index) : -1;
+		}
+		else
+		{
+			// No index before start_transcoding(), so scan the slice descs once.
+			basisu::vector<uint32_t> iframe_image_indices;
+			if (!get_video_iframe_index(pData, data_size, iframe_image_indices, level_index))
+				return -1;
+			iframe_index = find_iframe_in_index(iframe_image_indices, image_index);
+		}
+
+		if (iframe_index < 0)
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::find_video_iframe: video doesn't start with an I-frame\n");
+		}
+
+		return iframe_index;
+	}
+
+	bool basisu_transcoder::transcode_video_frame(
+		const void* pData, uint32_t data_size,
+		uint32_t image_index, uint32_t level_index,
+		void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+		transcoder_texture_format fmt,
+		uint32_t decode_flags, uint32_t output_row_pitch_in_blocks_or_pixels, basisu_transcoder_state* pState, uint32_t output_rows_in_pixels) const
+	{
+		if ((!validate_header_quick(pData, data_size)) || 
+			(static_cast<const basis_file_header*>(pData)->m_tex_type != cBASISTexTypeVideoFrames) || (static_cast<const basis_file_header*>(pData)->m_tex_format != (int)basis_tex_format::cETC1S))
+		{
+			return transcode_image_level(pData, data_size, image_index, level_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels);
+		}
+
+		if (!pState)
+			pState = &m_lowlevel_etc1s_decoder.m_def_state;
+
+		// Sequential playback: the state already holds the previous frame (or this one), so no seek is needed.
+		const int prev_frame_index = (level_index < basisu_transcoder_state::cMaxPrevFrameLevels) ? pState->m_prev_frame_index[level_index] : -1;
+		if ((prev_frame_index >= 0) && ((prev_frame_index + 1 == (int)image_index) || (prev_frame_index == (int)image_index)))
+		{
+			return transcode_image_level(pData, data_size, image_index, level_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels);
+		}
+
+		const int iframe_index = find_video_iframe(pData, data_size, image_index, level_index);
+		if (iframe_index < 0)
+			return false;
+
+		// Continue from the frame the state already holds, if it's in the same GOP.
+		uint32_t first_image_index = iframe_index;
+		if ((prev_frame_index >= iframe_index) && (prev_frame_index <= (int)image_index))
+			first_image_index = basisu::minimum<uint32_t>(prev_frame_index + 1, image_index);
+
+		for (uint32_t i = first_image_index; i <= image_index; i++)
+		{
+			if (!transcode_image_level(pData, data_size, i, level_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels))
+			{
+				BASISU_DEVEL_ERROR("basisu_transcoder::transcode_video_frame: transcode_image_level() failed\n");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool basisu_transcoder::get_upload_layout(const void* pData, uint32_t data_size, transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+		basisu::vector<transcoder_subresource_desc>& subresources, uint64_t& total_size) const
+	{
+		subresources.resize(0);
+		total_size = 0;
+
+		const uint32_t total_images = get_total_images(pData, data_size);
+		if (!total_images)
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::get_upload_layout: header validation failed\n");
+			return false;
+		}
+
+		uint32_t max_levels = 0;
+		for (uint32_t image_index = 0; image_index < total_images; image_index++)
+			max_levels = basisu::maximum(max_levels, get_total_image_levels(pData, data_size, image_index));
+
+		uint32_t end_level = 0, end_image = 0, end_face = 0;
+		if ((!resolve_upload_layout_range(layout.m_first_level, layout.m_total_levels, max_levels, end_level)) ||
+			(!resolve_upload_layout_range(layout.m_first_layer, layout.m_total_layers, total_images, end_image)) ||
+			(!resolve_upload_layout_range(layout.m_first_face, layout.m_total_faces, 1, end_face)))
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::get_upload_layout: invalid level/layer/face range\n");
+			return false;
+		}
+
+		// Images may have different resolutions and level counts, so levels an image doesn't have are skipped.
+		const bool image_major = (layout.m_rules == transcoder_upload_layout_rules::cD3D12);
+		const uint32_t outer_end = image_major ? end_image : end_level;
+		const uint32_t inner_end = image_major ? end_level : end_image;
+
+		for (uint32_t outer = image_major ? layout.m_first_layer : layout.m_first_level; outer < outer_end; outer++)
+		{
+			for (uint32_t inner = image_major ? layout.m_first_level : layout.m_first_layer; inner < inner_end; inner++)
+			{
+				const uint32_t image_index = image_major ? outer : inner;
+				const uint32_t level_index = image_major ? inner : outer;
+
+				if (level_index >= get_total_image_levels(pData, data_size, image_index))
+					continue;
+
+				uint32_t orig_width = 0, orig_height = 0, total_blocks = 0;
+				if (!get_image_level_desc(pData, data_size, image_index, level_index, orig_width, orig_height, total_blocks))
+				{
+					BASISU_DEVEL_ERROR("basisu_transcoder::get_upload_layout: get_image_level_desc() failed\n");
+					return false;
+				}
+
+				add_upload_layout_subresource(subresources, level_index, image_index, 0, orig_width, orig_height);
+			}
+		}
+
+		return assign_upload_layout_offsets(fmt, layout, subresources, total_size);
+	}
+
+	// Everything the jobs of basisu_transcoder::transcode_texture() need. The subresources (in transcode order) are split into runs which must be transcoded in order:
+	// single subresources, or the frames of an ETC1S video GOP. Run r is m_pOrder[m_pRun_ends[r - 1]] up to (but not including) m_pOrder[m_pRun_ends[r]].
+	// Job i transcodes every num_jobs'th run starting at i, with its own state.
+	struct basisu_transcode_texture_job
+	{
+		const basisu_transcoder* m_pTranscoder;
+		const void* m_pData;
+		uint32_t m_data_size;
+		uint8_t* m_pOutput;
+		transcoder_texture_format m_fmt;
+		uint32_t m_decode_flags;
+
+		const transcoder_subresource_desc* m_pSubresources;
+		const uint32_t* m_pOrder;
+		const uint32_t* m_pRun_ends;
+		uint32_t m_num_runs;
+		uint32_t m_num_jobs;
+
+		basisu_transcoder_state* m_pStates;
+		uint8_t* m_pStatus;
+	};
+
+	static bool basisu_transcode_subresource(const basisu_transcoder& transcoder, const void* pData, uint32_t data_size, uint8_t* pOutput, transcoder_texture_format fmt, uint32_t decode_flags,
+		const transcoder_subresource_desc& desc, basisu_transcoder_state* pState)
+	{
+		uint32_t output_blocks_buf_size_in_blocks_or_pixels = 0, output_row_pitch_in_blocks_or_pixels = 0, output_rows_in_pixels = 0;
+		get_upload_layout_output_params(fmt, desc, output_blocks_buf_size_in_blocks_or_pixels, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels);
+
+		// Same as transcode_image_level(), except a video frame which doesn't follow the frame in pState is decoded from its I-frame.
+		return transcoder.transcode_video_frame(pData, data_size, desc.m_layer_index, desc.m_level_index,
+			pOutput + desc.m_offset, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+			decode_flags, output_row_pitch_in_blocks_or_pixels, pState, output_rows_in_pixels);
+	}
+
+	static void basisu_transcode_texture_job_func(uint32_t job_index, void* pJob_data)
+	{
+		const basisu_transcode_texture_job& job = *static_cast<const basisu_transcode_texture_job*>(pJob_data);
+
+		for (uint32_t r = job_index; r < job.m_num_runs; r += job.m_num_jobs)
+		{
+			for (uint32_t i = r ? job.m_pRun_ends[r - 1] : 0; i < job.m_pRun_ends[r]; i++)
+			{
+				if (!basisu_transcode_subresource(*job.m_pTranscoder, job.m_pData, job.m_data_size, job.m_pOutput, job.m_fmt, job.m_decode_flags,
+					job.m_pSubresources[job.m_pOrder[i]], &job.m_pStates[job_index]))
+					return;
+			}
+		}
+
+		job.m_pStatus[job_index] = true;
+	}
+
+	bool basisu_transcoder::transcode_texture(const void* pData, uint32_t data_size,
+		void* pOutput_buf, uint64_t output_buf_size,
+		transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+		basisu::vector<transcoder_subresource_desc>& subresources,
+		uint32_t decode_flags, const basisu_transcoder_parallel_params* pMt_params, basisu_transcoder_state* pState) const
+	{
+		if (!m_ready_to_transcode)
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::transcode_texture: must call start_transcoding() first\n");
+			return false;
+		}
+
+		uint64_t total_size = 0;
+		if (!get_upload_layout(pData, data_size, fmt, layout, subresources, total_size))
+			return false;
+
+		if ((!pOutput_buf) || (output_buf_size < total_size))
+		{
+			BASISU_DEVEL_ERROR("basisu_transcoder::transcode_texture: output buffer too small\n");
+			return false;
+		}
+
+		uint8_t* pOutput = static_cast<uint8_t*>(pOutput_buf);
+
+		basisu::vector<uint32_t> order;
+		get_upload_layout_level_order(subresources, order);
+
+		// Video P-frames depend on the previous frame, so each run of frames up to the next I-frame (a GOP) must be transcoded in order by the same job.
+		const bool is_video = (get_texture_type(pData, data_size) == cBASISTexTypeVideoFrames);
+
+		basisu::vector<uint32_t> run_ends;
+		run_ends.reserve(order.size());
+		for (uint32_t i = 1; i <= order.size(); i++)
+		{
+			if ((is_video) && (i < order.size()))
+			{
+				const transcoder_subresource_desc& prev_desc = subresources[order[i - 1]];
+				const transcoder_subresource_desc& desc = subresources[order[i]];
+
+				if ((desc.m_level_index == prev_desc.m_level_index) && (desc.m_layer_index == (prev_desc.m_layer_index + 1)) &&
+					(find_video_iframe(pData, data_size, desc.m_layer_index, desc.m_level_index) != (int)desc.m_layer_index))
+					continue;
+			}
+
+			run_ends.push_back(i);
+		}
+
+		const uint32_t num_jobs = pMt_params ? basisu::minimum<uint32_t>(pMt_params->m_max_threads, run_ends.size_u32()) : 1;
+
+		if (num_jobs <= 1)
+		{
+			for (uint32_t i = 0; i < order.size(); i++)
+			{
+				if (!basisu_transcode_subresource(*this, pData, data_size, pOutput, fmt, decode_flags, subresources[order[i]], pState))
+				{
+					BASISU_DEVEL_ERROR("basisu_transcoder::transcode_texture: transcode_image_level() failed\n");
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		basisu::vector<basisu_transcoder_state> job_states(num_jobs);
+		basisu::uint8_vec job_status(num_jobs);
+
+		basisu_transcode_texture_job job;
+		job.m_pTranscoder = this;
+		job.m_pData = pData;
+		job.m_data_size = data_size;
+		job.m_pOutput = pOutput;
+		job.m_fmt = fmt;
+		job.m_decode_flags = decode_flags;
+		job.m_pSubresources = subresources.data();
+		job.m_pOrder = order.data();
+		job.m_pRun_ends = run_ends.data();
+		job.m_num_runs = run_ends.size_u32();
+		job.m_num_jobs = num_jobs;
+		job.m_pStates = job_states.data();
+		job.m_pStatus = job_status.data();
+
+		basisu_transcoder_parallel_for(*pMt_params, num_jobs, basisu_transcode_texture_job_func, &job);
+
+		for (uint32_t i = 0; i < num_jobs; i++)
+		{
+			if (!job_status[i])
+			{
+				BASISU_DEVEL_ERROR("basisu_transcoder::transcode_texture: transcode_image_level() failed\n");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	uint32_t basis_get_bytes_per_block_or_pixel(transcoder_texture_format fmt)
 	{
 		switch (fmt)
@@ -14464,7 +15855,7 @@ namespace basist
 	}
 
 	// g_astc_unquant[] is the inverse of g_astc_sorted_order_unquant[]
-	astc_quant_bin g_astc_unquant[BC7ENC_TOTAL_ASTC_RANGES][256]; // [ASTC encoded endpoint index]
+	BASISD_PRECOMPUTED_CONST astc_quant_bin g_astc_unquant[BC7ENC_TOTAL_ASTC_RANGES][256] BASISD_PRECOMPUTED_TABLE(g_astc_unquant); // [ASTC encoded endpoint index]
 
 	// Taken right from the ASTC spec.
 	static struct
@@ -14636,8 +16027,8 @@ namespace basist
 
 	const uint8_t g_bc7_alpha_index_bitcount[8] = { 0, 0, 0, 0, 3, 2, 4, 2 }; // note mode 6 has 4 and mode 7 has 2, not really correct as they have a single plane
 
-	endpoint_err g_bc7_mode_6_optimal_endpoints[256][2]; // [c][pbit]
-	endpoint_err g_bc7_mode_5_optimal_endpoints[256]; // [c]
+	BASISD_PRECOMPUTED_CONST endpoint_err g_bc7_mode_6_optimal_endpoints[256][2] BASISD_PRECOMPUTED_TABLE(g_bc7_mode_6_optimal_endpoints); // [c][pbit]
+	BASISD_PRECOMPUTED_CONST endpoint_err g_bc7_mode_5_optimal_endpoints[256] BASISD_PRECOMPUTED_TABLE(g_bc7_mode_5_optimal_endpoints); // [c]
 
 	static inline void bc7_set_block_bits(uint8_t* pBytes, uint32_t val, uint32_t num_bits, uint32_t* pCur_ofs)
 	{
@@ -19644,6 +21035,7 @@ namespace basist
 
 	void uastc_init()
 	{
+#if !BASISD_USE_PRECOMPUTED_TABLES
 		for (uint32_t range = 0; range < BC7ENC_TOTAL_ASTC_RANGES; range++)
 		{
 			if (!astc_is_valid_endpoint_range(range))
@@ -19731,6 +21123,7 @@ namespace basist
 			g_bc7_mode_5_optimal_endpoints[c] = best;
 
 		} // c
+#endif
 	}
 
 #endif // #if BASISD_SUPPORT_UASTC
@@ -19742,6 +21135,72 @@ namespace basist
 #if BASISD_SUPPORT_KTX2
 	const uint8_t g_ktx2_file_identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
 
+	ktx2_transcoder_state::ktx2_transcoder_state() :
+		m_pStream_dctx(nullptr)
+	{
+		clear();
+	}
+
+	ktx2_transcoder_state::ktx2_transcoder_state(const ktx2_transcoder_state& other) :
+		m_pStream_dctx(nullptr)
+	{
+		clear();
+		*this = other;
+	}
+
+	ktx2_transcoder_state::~ktx2_transcoder_state()
+	{
+		clear_stream();
+	}
+
+	ktx2_transcoder_state& ktx2_transcoder_state::operator= (const ktx2_transcoder_state& rhs)
+	{
+		if (this == &rhs)
+			return *this;
+
+		m_transcoder_state = rhs.m_transcoder_state;
+		m_level_uncomp_data = rhs.m_level_uncomp_data;
+		m_uncomp_data_level_index = rhs.m_uncomp_data_level_index;
+		m_band_states = rhs.m_band_states;
+		m_region_blocks = rhs.m_region_blocks;
+		m_region_cache = rhs.m_region_cache;
+		m_region_cache_key = rhs.m_region_cache_key;
+		m_region_cache_valid = rhs.m_region_cache_valid;
+
+		clear_stream();
+
+		return *this;
+	}
+
+	void ktx2_transcoder_state::clear()
+	{
+		m_transcoder_state.clear();
+		m_level_uncomp_data.clear();
+		m_uncomp_data_level_index = -1;
+		m_band_states.clear();
+		m_region_blocks.clear();
+		m_region_cache.clear();
+		basisu::clear_obj(m_region_cache_key);
+		m_region_cache_valid = false;
+
+		clear_stream();
+	}
+
+	void ktx2_transcoder_state::clear_stream()
+	{
+#if BASISD_SUPPORT_KTX2_ZSTD
+		if (m_pStream_dctx)
+			ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(m_pStream_dctx));
+#endif
+		m_pStream_dctx = nullptr;
+		m_pStream_comp_data = nullptr;
+		m_stream_level_index = -1;
+		m_stream_comp_ofs = 0;
+		m_stream_uncomp_ofs = 0;
+		m_stream_image_data.clear();
+		m_stream_image_ofs = UINT64_MAX;
+	}
+
 	ktx2_transcoder::ktx2_transcoder() :
 		m_etc1s_transcoder()
 	{
@@ -19778,6 +21237,7 @@ namespace basist
 		m_has_alpha = false;
 		m_is_video = false;
 		m_ldr_hdr_upconversion_nit_multiplier = 0.0f;
+		m_video_iframe_indices.clear();
 
 		m_deblocking_filter_index = 0;
 	}
@@ -20374,6 +21834,22 @@ namespace basist
 						}
 					}
 				}
+
+				// Index the I-frames once, so seeking and splitting video into GOPs doesn't have to scan the image descs.
+				if (m_is_video)
+				{
+					const uint32_t total_layers = basisu::maximum<uint32_t>(m_header.m_layer_count, 1);
+
+					m_video_iframe_indices.resize(m_levels.size());
+					for (uint32_t level_index = 0; level_index < m_levels.size(); level_index++)
+					{
+						for (uint32_t layer_index = 0; layer_index < total_layers; layer_index++)
+						{
+							if ((get_etc1s_image_descs_image_flags(level_index, layer_index, 0) & KTX2_IMAGE_IS_P_FRAME) == 0)
+								m_video_iframe_indices[level_index].push_back(layer_index);
+						}
+					}
+				}
 			}
 			// check for old-style (non-standard) KTX2 files written by v1.6/v2.0
 			else if ( (m_format == basis_tex_format::cUASTC_HDR_6x6_INTERMEDIATE) || basis_tex_format_is_xuastc_ldr(m_format) )
@@ -20524,35 +22000,11 @@ namespace basist
 			return false;
 		}
 
-		const uint8_t* pComp_level_data = m_pData + m_levels[level_index].m_byte_offset.get_uint64();
-		uint64_t comp_level_data_size = m_levels[level_index].m_byte_length.get_uint64();
-		
-		const uint8_t* pUncomp_level_data = pComp_level_data;
-		uint64_t uncomp_level_data_size = comp_level_data_size;
+		const uint8_t* pUncomp_level_data = nullptr;
+		uint64_t uncomp_level_data_size = 0;
 
-		if (uncomp_level_data_size > UINT32_MAX)
-		{
-			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level: uncomp_level_data_size > UINT32_MAX\n");
+		if (!get_level_data(level_index, decode_flags, pState, pUncomp_level_data, uncomp_level_data_size))
 			return false;
-		}
-				
-		if (m_header.m_supercompression_scheme == KTX2_SS_ZSTANDARD)
-		{
-			// Check if we've already decompressed this level's supercompressed data.
-			if ((int)level_index != pState->m_uncomp_data_level_index)
-			{
-				// Uncompress the entire level's supercompressed data.
-				if (!decompress_level_data(level_index, pState->m_level_uncomp_data))
-				{
-					BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level: decompress_level_data() failed\n");
-					return false;
-				}
-				pState->m_uncomp_data_level_index = level_index;
-			}
-
-			pUncomp_level_data = pState->m_level_uncomp_data.data();
-			uncomp_level_data_size = pState->m_level_uncomp_data.size();
-		}
 				
 		const uint32_t level_width = basisu::maximum<uint32_t>(m_header.m_pixel_width >> level_index, 1);
 		const uint32_t level_height = basisu::maximum<uint32_t>(m_header.m_pixel_height >> level_index, 1);
@@ -20583,14 +22035,19 @@ namespace basist
 
 			const ktx2_etc1s_image_desc& image_desc = m_etc1s_image_descs[etc1s_image_index];
 
-			if (!m_etc1s_transcoder.transcode_image(fmt,
+			const bool status = m_etc1s_transcoder.transcode_image(fmt,
 				pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, m_pData, m_data_size,
 				num_blocks4_x, num_blocks4_y, level_width, level_height,
 				level_index,
 				m_levels[level_index].m_byte_offset.get_uint64() + image_desc.m_rgb_slice_byte_offset, image_desc.m_rgb_slice_byte_length,
 				image_desc.m_alpha_slice_byte_length ? (m_levels[level_index].m_byte_offset.get_uint64() + image_desc.m_alpha_slice_byte_offset) : 0, image_desc.m_alpha_slice_byte_length,
 				decode_flags, m_has_alpha,
-				m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels))
+				m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels);
+
+			if (m_is_video)
+				pState->m_transcoder_state.update_prev_frame_index(level_index, layer_index, (image_desc.m_image_flags & KTX2_IMAGE_IS_P_FRAME) == 0, status);
+
+			if (!status)
 			{
 				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level: ETC1S transcode_image() failed, this is either a bug or the file is corrupted/invalid\n");
 				return false;
@@ -20666,9 +22123,13 @@ namespace basist
 
 			assert(total_2D_image_size <= UINT32_MAX);
 
+			const uint8_t* pImage_data = nullptr;
+			if (!get_image_data(level_index, pUncomp_level_data, uncomp_ofs, total_2D_image_size, pState, pImage_data))
+				return false;
+
 			if (!m_astc_hdr_6x6_transcoder.transcode_image(fmt,
 				pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
-				(const uint8_t*)pUncomp_level_data + (size_t)uncomp_ofs, (uint32_t)total_2D_image_size, num_blocks6_x, num_blocks6_y, level_width, level_height, level_index,
+				pImage_data, (uint32_t)total_2D_image_size, num_blocks6_x, num_blocks6_y, level_width, level_height, level_index,
 				0, (uint32_t)total_2D_image_size,
 				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, nullptr, output_rows_in_pixels, channel0, channel1))
 			{
@@ -20729,12 +22190,16 @@ namespace basist
 
 			assert(total_2D_image_size <= UINT32_MAX);
 
+			const uint8_t* pImage_data = nullptr;
+			if (!get_image_data(level_index, pUncomp_level_data, uncomp_ofs, total_2D_image_size, pState, pImage_data))
+				return false;
+
 			// if the header's vkformat is odd, it's linear, even is sRGB
 			const bool uses_astc_src_decode_profile = ((uint32_t)m_header.m_vk_format & 1) == 0;
 
 			if (!m_xuastc_ldr_transcoder.transcode_image(m_format, uses_astc_src_decode_profile, fmt,
 				pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
-				(const uint8_t*)pUncomp_level_data + (size_t)uncomp_ofs, (uint32_t)total_2D_image_size, num_blocks_x, num_blocks_y, level_width, level_height, level_index,
+				pImage_data, (uint32_t)total_2D_image_size, num_blocks_x, num_blocks_y, level_width, level_height, level_index,
 				0, (uint32_t)total_2D_image_size,
 				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, nullptr, output_rows_in_pixels, channel0, channel1))
 			{
@@ -20830,12 +22295,16 @@ namespace basist
 
 			assert(total_2D_image_size <= UINT32_MAX);
 
+			const uint8_t* pImage_data = nullptr;
+			if (!get_image_data(level_index, pUncomp_level_data, uncomp_ofs, total_2D_image_size, pState, pImage_data))
+				return false;
+
 			if (m_format == basist::basis_tex_format::cUASTC_HDR_4x4)
 			{
 				// UASTC HDR 4x4
 				if (!m_uastc_hdr_transcoder.transcode_image(fmt,
 					pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
-					(const uint8_t*)pUncomp_level_data + uncomp_ofs, (uint32_t)total_2D_image_size, num_blocks4_x, num_blocks4_y, level_width, level_height, level_index,
+					pImage_data, (uint32_t)total_2D_image_size, num_blocks4_x, num_blocks4_y, level_width, level_height, level_index,
 					0, (uint32_t)total_2D_image_size,
 					decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, nullptr, output_rows_in_pixels, channel0, channel1))
 				{
@@ -20848,7 +22317,7 @@ namespace basist
 				// UASTC LDR 4x4
 				if (!m_uastc_ldr_transcoder.transcode_image(fmt,
 					pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
-					(const uint8_t*)pUncomp_level_data + uncomp_ofs, (uint32_t)total_2D_image_size, num_blocks4_x, num_blocks4_y, level_width, level_height, level_index,
+					pImage_data, (uint32_t)total_2D_image_size, num_blocks4_x, num_blocks4_y, level_width, level_height, level_index,
 					0, (uint32_t)total_2D_image_size,
 					decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, nullptr, output_rows_in_pixels, channel0, channel1))
 				{
@@ -20906,6 +22375,1067 @@ namespace basist
 		return true;
 	}
 		
+	// Everything a single band of transcode_image_level_mt() needs. Bands only differ by their first block row.
+	struct ktx2_transcode_band_job
+	{
+		basist::basis_tex_format m_src_format;
+		bool m_uses_astc_srgb_decode_profile;
+
+		basisu_lowlevel_uastc_ldr_4x4_transcoder* m_pUASTC_LDR_transcoder;
+		basisu_lowlevel_uastc_hdr_4x4_transcoder* m_pUASTC_HDR_transcoder;
+		basisu_lowlevel_astc_hdr_6x6_transcoder* m_pASTC_HDR_6x6_transcoder;
+		basisu_lowlevel_xuastc_ldr_transcoder* m_pASTC_LDR_transcoder;
+
+		transcoder_texture_format m_fmt;
+		uint8_t* m_pOutput;
+		uint32_t m_output_buf_size_in_blocks_or_pixels;
+		uint32_t m_bytes_per_block_or_pixel;
+		bool m_is_uncompressed;
+		uint32_t m_dst_block_height;
+		uint32_t m_output_row_pitch_in_blocks_or_pixels;
+		uint32_t m_output_rows_in_pixels;
+
+		const uint8_t* m_pSrc_blocks;
+		uint32_t m_num_blocks_x, m_num_blocks_y;
+		uint32_t m_src_block_height;
+		uint32_t m_block_rows_per_band;
+
+		uint32_t m_level_index, m_level_width, m_level_height;
+		uint32_t m_decode_flags;
+		bool m_has_alpha, m_is_video;
+		int m_channel0, m_channel1;
+
+		basisu_transcoder_state* m_pBand_states;
+		uint8_t* m_pBand_status;
+	};
+
+	static void ktx2_transcode_band(uint32_t band_index, void* pJob_data)
+	{
+		const ktx2_transcode_band_job& job = *static_cast<const ktx2_transcode_band_job*>(pJob_data);
+
+		job.m_pBand_status[band_index] = false;
+
+		const uint32_t first_block_y = band_index * job.m_block_rows_per_band;
+		assert(first_block_y < job.m_num_blocks_y);
+
+		const uint32_t num_band_blocks_y = basisu::minimum(job.m_block_rows_per_band, job.m_num_blocks_y - first_block_y);
+		const uint32_t first_pixel_y = first_block_y * job.m_src_block_height;
+		const uint32_t band_height = basisu::minimum(num_band_blocks_y * job.m_src_block_height, job.m_level_height - first_pixel_y);
+
+		uint32_t band_output_rows_in_pixels = 0;
+		uint64_t output_ofs;
+		if (job.m_is_uncompressed)
+		{
+			if (first_pixel_y >= job.m_output_rows_in_pixels)
+			{
+				// The serial path wouldn't write anything to these rows either.
+				job.m_pBand_status[band_index] = true;
+				return;
+			}
+
+			band_output_rows_in_pixels = basisu::minimum(num_band_blocks_y * job.m_src_block_height, job.m_output_rows_in_pixels - first_pixel_y);
+			output_ofs = (uint64_t)first_pixel_y * job.m_output_row_pitch_in_blocks_or_pixels;
+		}
+		else
+		{
+			assert((first_pixel_y % job.m_dst_block_height) == 0);
+			output_ofs = (uint64_t)(first_pixel_y / job.m_dst_block_height) * job.m_output_row_pitch_in_blocks_or_pixels;
+		}
+
+		if (output_ofs >= job.m_output_buf_size_in_blocks_or_pixels)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcode_band: output buffer too small\n");
+			return;
+		}
+
+		uint8_t* pBand_output = job.m_pOutput + output_ofs * job.m_bytes_per_block_or_pixel;
+		const uint32_t band_output_buf_size = job.m_output_buf_size_in_blocks_or_pixels - (uint32_t)output_ofs;
+
+		const uint32_t band_src_size = job.m_num_blocks_x * num_band_blocks_y * (uint32_t)sizeof(astc_helpers::astc_block);
+		const uint8_t* pBand_src = job.m_pSrc_blocks + (size_t)first_block_y * job.m_num_blocks_x * sizeof(astc_helpers::astc_block);
+
+		basisu_transcoder_state* pBand_state = &job.m_pBand_states[band_index];
+
+		bool status = false;
+
+		switch (job.m_src_format)
+		{
+		case basis_tex_format::cUASTC_LDR_4x4:
+			status = job.m_pUASTC_LDR_transcoder->transcode_image(job.m_fmt, pBand_output, band_output_buf_size,
+				pBand_src, band_src_size, job.m_num_blocks_x, num_band_blocks_y, job.m_level_width, band_height, job.m_level_index,
+				0, band_src_size,
+				job.m_decode_flags, job.m_has_alpha, job.m_is_video, job.m_output_row_pitch_in_blocks_or_pixels, pBand_state, band_output_rows_in_pixels, job.m_channel0, job.m_channel1);
+			break;
+		case basis_tex_format::cUASTC_HDR_4x4:
+			status = job.m_pUASTC_HDR_transcoder->transcode_image(job.m_fmt, pBand_output, band_output_buf_size,
+				pBand_src, band_src_size, job.m_num_blocks_x, num_band_blocks_y, job.m_level_width, band_height, job.m_level_index,
+				0, band_src_size,
+				job.m_decode_flags, job.m_has_alpha, job.m_is_video, job.m_output_row_pitch_in_blocks_or_pixels, pBand_state, band_output_rows_in_pixels, job.m_channel0, job.m_channel1);
+			break;
+		case basis_tex_format::cASTC_HDR_6x6:
+			status = job.m_pASTC_HDR_6x6_transcoder->transcode_image(job.m_fmt, pBand_output, band_output_buf_size,
+				pBand_src, band_src_size, job.m_num_blocks_x, num_band_blocks_y, job.m_level_width, band_height, job.m_level_index,
+				0, band_src_size,
+				job.m_decode_flags, job.m_has_alpha, job.m_is_video, job.m_output_row_pitch_in_blocks_or_pixels, pBand_state, band_output_rows_in_pixels, job.m_channel0, job.m_channel1);
+			break;
+		default:
+			assert(basis_tex_format_is_astc_ldr(job.m_src_format));
+			status = job.m_pASTC_LDR_transcoder->transcode_image(job.m_src_format, job.m_uses_astc_srgb_decode_profile, job.m_fmt, pBand_output, band_output_buf_size,
+				pBand_src, band_src_size, job.m_num_blocks_x, num_band_blocks_y, job.m_level_width, band_height, job.m_level_index,
+				0, band_src_size,
+				job.m_decode_flags, job.m_has_alpha, job.m_is_video, job.m_output_row_pitch_in_blocks_or_pixels, pBand_state, band_output_rows_in_pixels, job.m_channel0, job.m_channel1);
+			break;
+		}
+
+		job.m_pBand_status[band_index] = status;
+	}
+
+	bool ktx2_transcoder::get_video_iframe_index(basisu::vector<uint32_t>& iframe_layer_indices, uint32_t level_index) const
+	{
+		iframe_layer_indices.resize(0);
+
+		if ((!m_pData) || (level_index >= m_levels.size()))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::get_video_iframe_index: Must call init() first, or invalid level_index\n");
+			return false;
+		}
+
+		// Only ETC1S has P-frames, other animations are just texture arrays.
+		if ((m_is_video) && (m_format == basist::basis_tex_format::cETC1S))
+		{
+			if (level_index >= m_video_iframe_indices.size())
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::get_video_iframe_index: Must call start_transcoding() first\n");
+				return false;
+			}
+
+			iframe_layer_indices = m_video_iframe_indices[level_index];
+			return true;
+		}
+
+		const uint32_t total_layers = basisu::maximum<uint32_t>(m_header.m_layer_count, 1);
+		for (uint32_t layer_index = 0; layer_index < total_layers; layer_index++)
+			iframe_layer_indices.push_back(layer_index);
+
+		return true;
+	}
+
+	int ktx2_transcoder::find_video_iframe(uint32_t level_index, uint32_t layer_index) const
+	{
+		if ((!m_pData) || (level_index >= m_levels.size()) || (layer_index >= basisu::maximum<uint32_t>(m_header.m_layer_count, 1)))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::find_video_iframe: Must call init() first, or invalid level_index/layer_index\n");
+			return -1;
+		}
+
+		if ((!m_is_video) || (m_format != basist::basis_tex_format::cETC1S))
+			return layer_index;
+
+		if (level_index >= m_video_iframe_indices.size())
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::find_video_iframe: Must call start_transcoding() first\n");
+			return -1;
+		}
+
+		const int iframe_index = find_iframe_in_index(m_video_iframe_indices[level_index], layer_index);
+		if (iframe_index < 0)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::find_video_iframe: video doesn't start with an I-frame\n");
+		}
+
+		return iframe_index;
+	}
+
+	bool ktx2_transcoder::transcode_video_frame(
+		uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+		void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+		basist::transcoder_texture_format fmt,
+		uint32_t decode_flags, uint32_t output_row_pitch_in_blocks_or_pixels, uint32_t output_rows_in_pixels, int channel0, int channel1,
+		ktx2_transcoder_state* pState)
+	{
+		if (!pState)
+			pState = &m_def_transcoder_state;
+
+		if ((!m_is_video) || (m_format != basist::basis_tex_format::cETC1S))
+		{
+			return transcode_image_level(level_index, layer_index, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, channel0, channel1, pState);
+		}
+
+		// Sequential playback: the state already holds the previous frame (or this one), so no seek is needed.
+		const int prev_frame_index = (level_index < basisu_transcoder_state::cMaxPrevFrameLevels) ? pState->m_transcoder_state.m_prev_frame_index[level_index] : -1;
+		if ((prev_frame_index >= 0) && ((prev_frame_index + 1 == (int)layer_index) || (prev_frame_index == (int)layer_index)))
+		{
+			return transcode_image_level(level_index, layer_index, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, channel0, channel1, pState);
+		}
+
+		const int iframe_index = find_video_iframe(level_index, layer_index);
+		if (iframe_index < 0)
+			return false;
+
+		// Continue from the frame the state already holds, if it's in the same GOP.
+		uint32_t first_layer_index = iframe_index;
+		if ((prev_frame_index >= iframe_index) && (prev_frame_index <= (int)layer_index))
+			first_layer_index = basisu::minimum<uint32_t>(prev_frame_index + 1, layer_index);
+
+		for (uint32_t i = first_layer_index; i <= layer_index; i++)
+		{
+			if (!transcode_image_level(level_index, i, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, channel0, channel1, pState))
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_video_frame: transcode_image_level() failed\n");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ktx2_transcoder::transcode_image_level_mt(
+		uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+		void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+		basist::transcoder_texture_format fmt,
+		const basisu_transcoder_parallel_params& mt_params,
+		uint32_t decode_flags, uint32_t output_row_pitch_in_blocks_or_pixels, uint32_t output_rows_in_pixels, int channel0, int channel1,
+		ktx2_transcoder_state* pState)
+	{
+		if (!m_pData)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: Must call init() first\n");
+			return false;
+		}
+
+		if (!pState)
+			pState = &m_def_transcoder_state;
+
+		// Anything that can't be split into bands (or is invalid) goes through the serial path, which also does all the error reporting.
+		const bool is_pvrtc1 = (fmt == transcoder_texture_format::cTFPVRTC1_4_RGB) || (fmt == transcoder_texture_format::cTFPVRTC1_4_RGBA);
+
+		bool can_split = (mt_params.m_max_threads > 1) && (!is_pvrtc1) &&
+			(level_index < m_levels.size()) &&
+			(face_index < m_header.m_face_count) &&
+			(layer_index < basisu::maximum<uint32_t>(m_header.m_layer_count, 1));
+
+		if (basis_tex_format_is_astc_ldr(m_format))
+		{
+			// Same deblocking decision transcode_image_level() makes. Deblocking reads pixels across block (and band) boundaries.
+			if ((decode_flags & (cDecodeFlagsForceDeblockFiltering | cDecodeFlagsNoDeblockFiltering)) == 0)
+				decode_flags |= (m_deblocking_filter_index >= 1) ? cDecodeFlagsForceDeblockFiltering : cDecodeFlagsNoDeblockFiltering;
+
+			const bool deblock_filtering = ((decode_flags & cDecodeFlagsNoDeblockFiltering) == 0) &&
+				(((decode_flags & cDecodeFlagsForceDeblockFiltering) != 0) || ((get_block_width() * get_block_height()) >= BASISU_DEBLOCKING_BLOCK_SIZE_THRESHOLD));
+
+			// ASTC->ASTC is a plain memcpy.
+			if ((deblock_filtering) || (basis_is_transcoder_texture_format_astc(fmt)))
+				can_split = false;
+		}
+		else if ((m_format != basis_tex_format::cUASTC_LDR_4x4) && (m_format != basis_tex_format::cUASTC_HDR_4x4) && (m_format != basis_tex_format::cASTC_HDR_6x6))
+		{
+			// ETC1S, XUASTC LDR, XUBC7 and UASTC HDR 6x6i: the start of the slice is the only sync point.
+			can_split = false;
+		}
+
+		const uint32_t level_width = basisu::maximum<uint32_t>(m_header.m_pixel_width >> level_index, 1);
+		const uint32_t level_height = basisu::maximum<uint32_t>(m_header.m_pixel_height >> level_index, 1);
+		const uint32_t src_block_width = get_block_width(), src_block_height = get_block_height();
+		const uint32_t num_blocks_x = (level_width + src_block_width - 1) / src_block_width;
+		const uint32_t num_blocks_y = (level_height + src_block_height - 1) / src_block_height;
+
+		const bool is_uncompressed = basis_transcoder_format_is_uncompressed(fmt);
+
+		// Each band must start on a source block row which lines up with the top of an output block row. ASTC HDR 6x6->BC6H transcodes pairs of 6x6 block rows,
+		// and the ASTC LDR->4x4 formats (and all uncompressed formats) buffer enough source block rows to get a multiple of 4 scanlines.
+		const uint32_t dst_block_height = is_uncompressed ? 4 : basis_get_block_height(fmt);
+		uint32_t band_granularity = 1;
+		while ((band_granularity * src_block_height) % dst_block_height)
+			band_granularity++;
+
+		const uint32_t total_block_row_groups = (num_blocks_y + band_granularity - 1) / band_granularity;
+		const uint32_t total_blocks = num_blocks_x * num_blocks_y;
+
+		uint32_t num_bands = basisu::minimum<uint32_t>(mt_params.m_max_threads, total_block_row_groups);
+		num_bands = basisu::minimum<uint32_t>(num_bands, total_blocks / basisu::maximum<uint32_t>(mt_params.m_min_blocks_per_job, 1));
+
+		if ((!can_split) || (num_bands <= 1))
+		{
+			return transcode_image_level(level_index, layer_index, face_index, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, channel0, channel1, pState);
+		}
+
+		if (!basis_validate_output_buffer_size(fmt, output_blocks_buf_size_in_blocks_or_pixels, level_width, level_height, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: output buffer size too small\n");
+			return false;
+		}
+
+		const uint8_t* pUncomp_level_data = nullptr;
+		uint64_t uncomp_level_data_size = 0;
+		if (!get_level_data(level_index, decode_flags, pState, pUncomp_level_data, uncomp_level_data_size))
+			return false;
+
+		if (uncomp_level_data_size != m_levels[level_index].m_uncompressed_byte_length.get_uint64())
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: m_uncompressed_byte_length is invalid\n");
+			return false;
+		}
+
+		// UASTC 4x4 and ASTC blocks are all 16 bytes.
+		static_assert(sizeof(astc_helpers::astc_block) == KTX2_UASTC_BLOCK_SIZE, "sizeof(astc_helpers::astc_block) == KTX2_UASTC_BLOCK_SIZE");
+		const uint64_t total_2D_image_size = (uint64_t)total_blocks * sizeof(astc_helpers::astc_block);
+		const uint64_t uncomp_ofs = ((uint64_t)layer_index * m_header.m_face_count + face_index) * total_2D_image_size;
+
+		if ((total_2D_image_size > UINT32_MAX) || ((size_t)uncomp_ofs != uncomp_ofs) ||
+			(uncomp_ofs >= uncomp_level_data_size) || ((uncomp_level_data_size - uncomp_ofs) < total_2D_image_size))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: invalid level data size\n");
+			return false;
+		}
+
+		const uint8_t* pImage_data = nullptr;
+		if (!get_image_data(level_index, pUncomp_level_data, uncomp_ofs, total_2D_image_size, pState, pImage_data))
+			return false;
+
+		const uint32_t block_rows_per_band = ((total_block_row_groups + num_bands - 1) / num_bands) * band_granularity;
+		num_bands = (num_blocks_y + block_rows_per_band - 1) / block_rows_per_band;
+
+		if (!pState->m_band_states.try_resize(num_bands))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: Out of memory\n");
+			return false;
+		}
+
+		basisu::uint8_vec band_status(num_bands);
+
+		ktx2_transcode_band_job job;
+		job.m_src_format = m_format;
+		job.m_uses_astc_srgb_decode_profile = ((uint32_t)m_header.m_vk_format & 1) == 0; // if the header's vkformat is odd, it's linear, even is sRGB
+		job.m_pUASTC_LDR_transcoder = &m_uastc_ldr_transcoder;
+		job.m_pUASTC_HDR_transcoder = &m_uastc_hdr_transcoder;
+		job.m_pASTC_HDR_6x6_transcoder = &m_astc_hdr_6x6_transcoder;
+		job.m_pASTC_LDR_transcoder = &m_xuastc_ldr_transcoder;
+		job.m_fmt = fmt;
+		job.m_pOutput = static_cast<uint8_t*>(pOutput_blocks);
+		job.m_output_buf_size_in_blocks_or_pixels = output_blocks_buf_size_in_blocks_or_pixels;
+		job.m_bytes_per_block_or_pixel = basis_get_bytes_per_block_or_pixel(fmt);
+		job.m_is_uncompressed = is_uncompressed;
+		job.m_dst_block_height = dst_block_height;
+		job.m_output_row_pitch_in_blocks_or_pixels = output_row_pitch_in_blocks_or_pixels ? output_row_pitch_in_blocks_or_pixels :
+			(is_uncompressed ? level_width : ((level_width + basis_get_block_width(fmt) - 1) / basis_get_block_width(fmt)));
+		job.m_output_rows_in_pixels = output_rows_in_pixels ? output_rows_in_pixels : level_height;
+		job.m_pSrc_blocks = pImage_data;
+		job.m_num_blocks_x = num_blocks_x;
+		job.m_num_blocks_y = num_blocks_y;
+		job.m_src_block_height = src_block_height;
+		job.m_block_rows_per_band = block_rows_per_band;
+		job.m_level_index = level_index;
+		job.m_level_width = level_width;
+		job.m_level_height = level_height;
+		job.m_decode_flags = decode_flags;
+		job.m_has_alpha = m_has_alpha;
+		job.m_is_video = m_is_video;
+		job.m_channel0 = channel0;
+		job.m_channel1 = channel1;
+		job.m_pBand_states = pState->m_band_states.data();
+		job.m_pBand_status = band_status.data();
+
+		basisu_transcoder_parallel_for(mt_params, num_bands, ktx2_transcode_band, &job);
+
+		for (uint32_t i = 0; i < num_bands; i++)
+		{
+			if (!band_status[i])
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_mt: band transcode failed, this is either a bug or the file is corrupted/invalid\n");
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ktx2_transcoder::transcode_image_level_region(
+		uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+		uint32_t block_x0, uint32_t block_y0, uint32_t block_w, uint32_t block_h,
+		void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+		basist::transcoder_texture_format fmt,
+		uint32_t decode_flags, uint32_t output_row_pitch_in_blocks_or_pixels, uint32_t output_rows_in_pixels, int channel0, int channel1,
+		ktx2_transcoder_state* pState)
+	{
+		if (!m_pData)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: Must call init() first\n");
+			return false;
+		}
+
+		if (!pState)
+			pState = &m_def_transcoder_state;
+
+		if ((level_index >= m_levels.size()) || (face_index >= m_header.m_face_count) || (layer_index >= basisu::maximum<uint32_t>(m_header.m_layer_count, 1)))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: invalid level, layer or face index\n");
+			return false;
+		}
+
+		if ((fmt == transcoder_texture_format::cTFPVRTC1_4_RGB) || (fmt == transcoder_texture_format::cTFPVRTC1_4_RGBA))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: PVRTC1 is not supported\n");
+			return false;
+		}
+
+		const uint32_t level_width = basisu::maximum<uint32_t>(m_header.m_pixel_width >> level_index, 1);
+		const uint32_t level_height = basisu::maximum<uint32_t>(m_header.m_pixel_height >> level_index, 1);
+		const uint32_t src_block_width = get_block_width(), src_block_height = get_block_height();
+		const uint32_t num_blocks_x = (level_width + src_block_width - 1) / src_block_width;
+		const uint32_t num_blocks_y = (level_height + src_block_height - 1) / src_block_height;
+
+		if ((!block_w) || (!block_h) || (block_x0 >= num_blocks_x) || ((num_blocks_x - block_x0) < block_w) || (block_y0 >= num_blocks_y) || ((num_blocks_y - block_y0) < block_h))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: invalid block rectangle\n");
+			return false;
+		}
+
+		const bool is_uncompressed = basis_transcoder_format_is_uncompressed(fmt);
+		const uint32_t dst_block_width = is_uncompressed ? 1 : basis_get_block_width(fmt);
+		const uint32_t dst_block_height = is_uncompressed ? 1 : basis_get_block_height(fmt);
+
+		// The rectangle in texels.
+		const uint32_t rect_x = block_x0 * src_block_width, rect_y = block_y0 * src_block_height;
+		const uint32_t rect_width = basisu::minimum(block_w * src_block_width, level_width - rect_x);
+		const uint32_t rect_height = basisu::minimum(block_h * src_block_height, level_height - rect_y);
+
+		if ((rect_x % dst_block_width) || (rect_y % dst_block_height))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: the rectangle's origin isn't on an output block boundary\n");
+			return false;
+		}
+
+		if (!basis_validate_output_buffer_size(fmt, output_blocks_buf_size_in_blocks_or_pixels, rect_width, rect_height, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: output buffer size too small\n");
+			return false;
+		}
+
+		bool deblock_filtering = false;
+		if (basis_tex_format_is_astc_ldr(m_format))
+		{
+			// Same deblocking decision transcode_image_level() makes. Deblocking reads texels across block (and rectangle) boundaries.
+			if ((decode_flags & (cDecodeFlagsForceDeblockFiltering | cDecodeFlagsNoDeblockFiltering)) == 0)
+				decode_flags |= (m_deblocking_filter_index >= 1) ? cDecodeFlagsForceDeblockFiltering : cDecodeFlagsNoDeblockFiltering;
+
+			deblock_filtering = ((decode_flags & cDecodeFlagsNoDeblockFiltering) == 0) &&
+				(((decode_flags & cDecodeFlagsForceDeblockFiltering) != 0) || ((src_block_width * src_block_height) >= BASISU_DEBLOCKING_BLOCK_SIZE_THRESHOLD));
+		}
+
+		if ((m_format == basis_tex_format::cETC1S) && (!m_is_video))
+		{
+			// ETC1S: decode only as far as the rectangle's last block row, starting at the nearest seek index checkpoint.
+			if (m_etc1s_transcoder.get_endpoints().empty())
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: must call start_transcoding() first\n");
+				return false;
+			}
+
+			const uint32_t etc1s_image_index =
+				(level_index * basisu::maximum<uint32_t>(m_header.m_layer_count, 1) * m_header.m_face_count) +
+				layer_index * m_header.m_face_count +
+				face_index;
+
+			if (etc1s_image_index >= m_etc1s_image_descs.size())
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: etc1s_image_index >= m_etc1s_image_descs.size()\n");
+				return false;
+			}
+
+			const ktx2_etc1s_image_desc& image_desc = m_etc1s_image_descs[etc1s_image_index];
+
+			basisu_block_rect src_rect;
+			src_rect.m_x = block_x0;
+			src_rect.m_y = block_y0;
+			src_rect.m_width = block_w;
+			src_rect.m_height = block_h;
+
+			if (!m_etc1s_transcoder.transcode_image(fmt,
+				pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels, m_pData, m_data_size,
+				num_blocks_x, num_blocks_y, level_width, level_height,
+				level_index,
+				m_levels[level_index].m_byte_offset.get_uint64() + image_desc.m_rgb_slice_byte_offset, image_desc.m_rgb_slice_byte_length,
+				image_desc.m_alpha_slice_byte_length ? (m_levels[level_index].m_byte_offset.get_uint64() + image_desc.m_alpha_slice_byte_offset) : 0, image_desc.m_alpha_slice_byte_length,
+				decode_flags, m_has_alpha,
+				m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels, &src_rect))
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: ETC1S transcode_image() failed, this is either a bug or the file is corrupted/invalid\n");
+				return false;
+			}
+
+			return true;
+		}
+
+		const bool independent_blocks = (m_format == basis_tex_format::cUASTC_LDR_4x4) || (m_format == basis_tex_format::cUASTC_HDR_4x4) ||
+			(m_format == basis_tex_format::cASTC_HDR_6x6) || ((basis_tex_format_is_astc_ldr(m_format)) && (!deblock_filtering));
+
+		if (!independent_blocks)
+		{
+			// No random access: transcode the entire image once (at a tight pitch), then copy the rectangle from the cache.
+			const uint32_t cache_row_pitch = (level_width + dst_block_width - 1) / dst_block_width;
+			const uint32_t cache_rows = (level_height + dst_block_height - 1) / dst_block_height;
+			const uint32_t bytes_per_block_or_pixel = basis_get_bytes_per_block_or_pixel(fmt);
+
+			ktx2_transcoder_state::region_cache_key key;
+			basisu::clear_obj(key);
+			key.m_pData = m_pData;
+			key.m_level_index = level_index;
+			key.m_layer_index = layer_index;
+			key.m_face_index = face_index;
+			key.m_fmt = (uint32_t)fmt;
+			key.m_decode_flags = decode_flags;
+			key.m_channel0 = channel0;
+			key.m_channel1 = channel1;
+
+			if ((!pState->m_region_cache_valid) || (!(pState->m_region_cache_key == key)))
+			{
+				pState->m_region_cache_valid = false;
+
+				if (!pState->m_region_cache.try_resize((size_t)cache_row_pitch * cache_rows * bytes_per_block_or_pixel))
+				{
+					BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: Out of memory\n");
+					return false;
+				}
+
+				if (!transcode_video_frame(level_index, layer_index, face_index, pState->m_region_cache.data(), cache_row_pitch * cache_rows, fmt,
+					decode_flags, cache_row_pitch, is_uncompressed ? cache_rows : 0, channel0, channel1, pState))
+				{
+					BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: transcode_video_frame() failed\n");
+					return false;
+				}
+
+				pState->m_region_cache_key = key;
+				pState->m_region_cache_valid = true;
+			}
+
+			uint32_t copy_width = (rect_width + dst_block_width - 1) / dst_block_width;
+			uint32_t copy_rows = (rect_height + dst_block_height - 1) / dst_block_height;
+			const uint32_t output_row_pitch = output_row_pitch_in_blocks_or_pixels ? output_row_pitch_in_blocks_or_pixels : copy_width;
+
+			if (is_uncompressed)
+			{
+				// Like the transcoders, only write what fits in the caller's output rows.
+				copy_width = basisu::minimum(copy_width, output_row_pitch);
+				if (output_rows_in_pixels)
+					copy_rows = basisu::minimum(copy_rows, output_rows_in_pixels);
+			}
+
+			const uint8_t* pSrc = pState->m_region_cache.data() + ((size_t)(rect_y / dst_block_height) * cache_row_pitch + (rect_x / dst_block_width)) * bytes_per_block_or_pixel;
+			uint8_t* pDst = static_cast<uint8_t*>(pOutput_blocks);
+
+			for (uint32_t y = 0; y < copy_rows; y++)
+			{
+				memcpy(pDst, pSrc, (size_t)copy_width * bytes_per_block_or_pixel);
+				pSrc += (size_t)cache_row_pitch * bytes_per_block_or_pixel;
+				pDst += (size_t)output_row_pitch * bytes_per_block_or_pixel;
+			}
+
+			return true;
+		}
+
+		// Every block can be independently decoded, so only read the rectangle's blocks.
+		const uint8_t* pUncomp_level_data = nullptr;
+		uint64_t uncomp_level_data_size = 0;
+		if (!get_level_data(level_index, decode_flags, pState, pUncomp_level_data, uncomp_level_data_size))
+			return false;
+
+		if (uncomp_level_data_size != m_levels[level_index].m_uncompressed_byte_length.get_uint64())
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: m_uncompressed_byte_length is invalid\n");
+			return false;
+		}
+
+		// UASTC 4x4 and ASTC blocks are all 16 bytes.
+		const uint64_t total_2D_image_size = (uint64_t)num_blocks_x * num_blocks_y * sizeof(astc_helpers::astc_block);
+		const uint64_t uncomp_ofs = ((uint64_t)layer_index * m_header.m_face_count + face_index) * total_2D_image_size;
+
+		if ((total_2D_image_size > UINT32_MAX) || ((size_t)uncomp_ofs != uncomp_ofs) ||
+			(uncomp_ofs >= uncomp_level_data_size) || ((uncomp_level_data_size - uncomp_ofs) < total_2D_image_size))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: invalid level data size\n");
+			return false;
+		}
+
+		// Only the rectangle's block rows are needed (and decompressed, when streaming).
+		const uint32_t src_row_size = num_blocks_x * (uint32_t)sizeof(astc_helpers::astc_block);
+		const uint8_t* pSrc_rows = nullptr;
+		if (!get_image_data(level_index, pUncomp_level_data, uncomp_ofs + (uint64_t)block_y0 * src_row_size, (uint64_t)block_h * src_row_size, pState, pSrc_rows))
+			return false;
+
+		const uint32_t rect_row_size = block_w * (uint32_t)sizeof(astc_helpers::astc_block);
+
+		if (basis_tex_format_is_astc_ldr(m_format) && basis_is_transcoder_texture_format_astc(fmt))
+		{
+			// ASTC LDR->ASTC is a plain copy.
+			if ((basis_get_block_width(fmt) != src_block_width) || (basis_get_block_height(fmt) != src_block_height))
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: fmt's ASTC block dimensions don't match the content's block dimensions\n");
+				return false;
+			}
+
+			const uint32_t output_row_pitch = output_row_pitch_in_blocks_or_pixels ? output_row_pitch_in_blocks_or_pixels : block_w;
+			for (uint32_t y = 0; y < block_h; y++)
+				memcpy(static_cast<uint8_t*>(pOutput_blocks) + (size_t)y * output_row_pitch * sizeof(astc_helpers::astc_block), pSrc_rows + (size_t)y * src_row_size + (size_t)block_x0 * sizeof(astc_helpers::astc_block), rect_row_size);
+
+			return true;
+		}
+
+		// Gather the rectangle's blocks, unless they're already contiguous.
+		const uint8_t* pRect_blocks = pSrc_rows;
+		if (block_w != num_blocks_x)
+		{
+			if (!pState->m_region_blocks.try_resize((size_t)rect_row_size * block_h))
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: Out of memory\n");
+				return false;
+			}
+
+			for (uint32_t y = 0; y < block_h; y++)
+				memcpy(pState->m_region_blocks.data() + (size_t)y * rect_row_size, pSrc_rows + (size_t)y * src_row_size + (size_t)block_x0 * sizeof(astc_helpers::astc_block), rect_row_size);
+
+			pRect_blocks = pState->m_region_blocks.data();
+		}
+
+		const uint32_t rect_blocks_size = rect_row_size * block_h;
+		bool status = false;
+
+		if (m_format == basis_tex_format::cUASTC_LDR_4x4)
+		{
+			status = m_uastc_ldr_transcoder.transcode_image(fmt, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+				pRect_blocks, rect_blocks_size, block_w, block_h, rect_width, rect_height, level_index,
+				0, rect_blocks_size,
+				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels, channel0, channel1);
+		}
+		else if (m_format == basis_tex_format::cUASTC_HDR_4x4)
+		{
+			status = m_uastc_hdr_transcoder.transcode_image(fmt, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+				pRect_blocks, rect_blocks_size, block_w, block_h, rect_width, rect_height, level_index,
+				0, rect_blocks_size,
+				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels, channel0, channel1);
+		}
+		else if (m_format == basis_tex_format::cASTC_HDR_6x6)
+		{
+			status = m_astc_hdr_6x6_transcoder.transcode_image(fmt, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+				pRect_blocks, rect_blocks_size, block_w, block_h, rect_width, rect_height, level_index,
+				0, rect_blocks_size,
+				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels, channel0, channel1);
+		}
+		else
+		{
+			// if the header's vkformat is odd, it's linear, even is sRGB
+			const bool uses_astc_srgb_decode_profile = ((uint32_t)m_header.m_vk_format & 1) == 0;
+
+			status = m_xuastc_ldr_transcoder.transcode_image(m_format, uses_astc_srgb_decode_profile, fmt, pOutput_blocks, output_blocks_buf_size_in_blocks_or_pixels,
+				pRect_blocks, rect_blocks_size, block_w, block_h, rect_width, rect_height, level_index,
+				0, rect_blocks_size,
+				decode_flags, m_has_alpha, m_is_video, output_row_pitch_in_blocks_or_pixels, &pState->m_transcoder_state, output_rows_in_pixels, channel0, channel1);
+		}
+
+		if (!status)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_image_level_region: transcode_image() failed, this is either a bug or the file is corrupted/invalid\n");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool ktx2_transcoder::get_upload_layout(basist::transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+		basisu::vector<transcoder_subresource_desc>& subresources, uint64_t& total_size) const
+	{
+		subresources.resize(0);
+		total_size = 0;
+
+		if (!m_pData)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::get_upload_layout: Must call init() first\n");
+			return false;
+		}
+
+		uint32_t end_level = 0, end_layer = 0, end_face = 0;
+		if ((!resolve_upload_layout_range(layout.m_first_level, layout.m_total_levels, m_levels.size_u32(), end_level)) ||
+			(!resolve_upload_layout_range(layout.m_first_layer, layout.m_total_layers, basisu::maximum<uint32_t>(m_header.m_layer_count, 1), end_layer)) ||
+			(!resolve_upload_layout_range(layout.m_first_face, layout.m_total_faces, m_header.m_face_count, end_face)))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::get_upload_layout: invalid level/layer/face range\n");
+			return false;
+		}
+
+		if (layout.m_rules == transcoder_upload_layout_rules::cD3D12)
+		{
+			// D3D12 subresource index order: level + array_slice * levels
+			for (uint32_t layer_index = layout.m_first_layer; layer_index < end_layer; layer_index++)
+				for (uint32_t face_index = layout.m_first_face; face_index < end_face; face_index++)
+					for (uint32_t level_index = layout.m_first_level; level_index < end_level; level_index++)
+						add_upload_layout_subresource(subresources, level_index, layer_index, face_index,
+							basisu::maximum<uint32_t>(m_header.m_pixel_width >> level_index, 1), basisu::maximum<uint32_t>(m_header.m_pixel_height >> level_index, 1));
+		}
+		else
+		{
+			for (uint32_t level_index = layout.m_first_level; level_index < end_level; level_index++)
+				for (uint32_t layer_index = layout.m_first_layer; layer_index < end_layer; layer_index++)
+					for (uint32_t face_index = layout.m_first_face; face_index < end_face; face_index++)
+						add_upload_layout_subresource(subresources, level_index, layer_index, face_index,
+							basisu::maximum<uint32_t>(m_header.m_pixel_width >> level_index, 1), basisu::maximum<uint32_t>(m_header.m_pixel_height >> level_index, 1));
+		}
+
+		return assign_upload_layout_offsets(fmt, layout, subresources, total_size);
+	}
+
+	// Everything the jobs of ktx2_transcoder::transcode_texture() need to transcode a single level's subresources in parallel. 
+	// The subresources are split into runs which must be transcoded in order (single subresources, or the frames of an ETC1S video GOP), like basisu_transcode_texture_job.
+	// Job i transcodes every num_jobs'th run starting at i, with its own state.
+	struct ktx2_transcode_texture_job
+	{
+		ktx2_transcoder* m_pTranscoder;
+		uint8_t* m_pOutput;
+		transcoder_texture_format m_fmt;
+		uint32_t m_decode_flags;
+
+		const transcoder_subresource_desc* m_pSubresources;
+		const uint32_t* m_pOrder;
+		const uint32_t* m_pRun_ends;
+		uint32_t m_num_runs;
+		uint32_t m_num_jobs;
+
+		ktx2_transcoder_state* m_pStates;
+		uint8_t* m_pStatus;
+	};
+
+	static bool ktx2_transcode_subresource(ktx2_transcoder& transcoder, uint8_t* pOutput, transcoder_texture_format fmt, uint32_t decode_flags,
+		const transcoder_subresource_desc& desc, const basisu_transcoder_parallel_params* pMt_params, ktx2_transcoder_state* pState)
+	{
+		uint32_t output_blocks_buf_size_in_blocks_or_pixels = 0, output_row_pitch_in_blocks_or_pixels = 0, output_rows_in_pixels = 0;
+		get_upload_layout_output_params(fmt, desc, output_blocks_buf_size_in_blocks_or_pixels, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels);
+
+		if ((transcoder.is_video()) && (transcoder.get_basis_tex_format() == basis_tex_format::cETC1S))
+		{
+			// An ETC1S video frame which doesn't follow the frame in pState is decoded from its I-frame.
+			return transcoder.transcode_video_frame(desc.m_level_index, desc.m_layer_index, desc.m_face_index,
+				pOutput + desc.m_offset, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, -1, -1, pState);
+		}
+
+		if (pMt_params)
+		{
+			return transcoder.transcode_image_level_mt(desc.m_level_index, desc.m_layer_index, desc.m_face_index,
+				pOutput + desc.m_offset, output_blocks_buf_size_in_blocks_or_pixels, fmt, *pMt_params,
+				decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, -1, -1, pState);
+		}
+
+		return transcoder.transcode_image_level(desc.m_level_index, desc.m_layer_index, desc.m_face_index,
+			pOutput + desc.m_offset, output_blocks_buf_size_in_blocks_or_pixels, fmt,
+			decode_flags, output_row_pitch_in_blocks_or_pixels, output_rows_in_pixels, -1, -1, pState);
+	}
+
+	static void ktx2_transcode_texture_job_func(uint32_t job_index, void* pJob_data)
+	{
+		const ktx2_transcode_texture_job& job = *static_cast<const ktx2_transcode_texture_job*>(pJob_data);
+
+		for (uint32_t r = job_index; r < job.m_num_runs; r += job.m_num_jobs)
+		{
+			for (uint32_t i = r ? job.m_pRun_ends[r - 1] : 0; i < job.m_pRun_ends[r]; i++)
+			{
+				if (!ktx2_transcode_subresource(*job.m_pTranscoder, job.m_pOutput, job.m_fmt, job.m_decode_flags,
+					job.m_pSubresources[job.m_pOrder[i]], nullptr, &job.m_pStates[job_index]))
+					return;
+			}
+		}
+
+		job.m_pStatus[job_index] = true;
+	}
+
+	bool ktx2_transcoder::transcode_texture(void* pOutput_buf, uint64_t output_buf_size,
+		basist::transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+		basisu::vector<transcoder_subresource_desc>& subresources,
+		uint32_t decode_flags, const basisu_transcoder_parallel_params* pMt_params, ktx2_transcoder_state* pState)
+	{
+		uint64_t total_size = 0;
+		if (!get_upload_layout(fmt, layout, subresources, total_size))
+			return false;
+
+		if ((!pOutput_buf) || (output_buf_size < total_size))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_texture: output buffer too small\n");
+			return false;
+		}
+
+		if (!pState)
+			pState = &m_def_transcoder_state;
+
+		if ((pMt_params) && (pMt_params->m_max_threads <= 1))
+			pMt_params = nullptr;
+
+		uint8_t* pOutput = static_cast<uint8_t*>(pOutput_buf);
+
+		basisu::vector<uint32_t> order;
+		get_upload_layout_level_order(subresources, order);
+
+		// A level's images can be transcoded in parallel if each job doesn't need the level's supercompressed data. ETC1S video P-frames depend on the previous frame, 
+		// so each run of frames up to the next I-frame (a GOP) is transcoded in order by the same job.
+		// Otherwise they're transcoded in order on this thread (split into bands by transcode_image_level_mt(), if possible), so the level's data is only decompressed once in pState.
+		const bool parallel_images = (pMt_params != nullptr) && (m_header.m_supercompression_scheme != KTX2_SS_ZSTANDARD);
+
+		basisu::vector<ktx2_transcoder_state> job_states;
+		basisu::uint8_vec job_status;
+		basisu::vector<uint32_t> run_ends;
+
+		uint32_t level_start = 0;
+		while (level_start < order.size())
+		{
+			const uint32_t level_index = subresources[order[level_start]].m_level_index;
+
+			uint32_t level_end = level_start + 1;
+			while ((level_end < order.size()) && (subresources[order[level_end]].m_level_index == level_index))
+				level_end++;
+
+			const uint32_t num_level_subresources = level_end - level_start;
+
+			run_ends.resize(0);
+			for (uint32_t i = 1; i <= num_level_subresources; i++)
+			{
+				if ((m_is_video) && (i < num_level_subresources))
+				{
+					const transcoder_subresource_desc& prev_desc = subresources[order[level_start + i - 1]];
+					const transcoder_subresource_desc& desc = subresources[order[level_start + i]];
+
+					if ((desc.m_layer_index == (prev_desc.m_layer_index + 1)) && (find_video_iframe(level_index, desc.m_layer_index) != (int)desc.m_layer_index))
+						continue;
+				}
+
+				run_ends.push_back(i);
+			}
+
+			const uint32_t num_jobs = parallel_images ? basisu::minimum<uint32_t>(pMt_params->m_max_threads, run_ends.size_u32()) : 1;
+
+			if (num_jobs > 1)
+			{
+				if (job_states.size() < num_jobs)
+					job_states.resize(num_jobs);
+
+				job_status.resize(0);
+				job_status.resize(num_jobs);
+
+				ktx2_transcode_texture_job job;
+				job.m_pTranscoder = this;
+				job.m_pOutput = pOutput;
+				job.m_fmt = fmt;
+				job.m_decode_flags = decode_flags;
+				job.m_pSubresources = subresources.data();
+				job.m_pOrder = order.data() + level_start;
+				job.m_pRun_ends = run_ends.data();
+				job.m_num_runs = run_ends.size_u32();
+				job.m_num_jobs = num_jobs;
+				job.m_pStates = job_states.data();
+				job.m_pStatus = job_status.data();
+
+				basisu_transcoder_parallel_for(*pMt_params, num_jobs, ktx2_transcode_texture_job_func, &job);
+
+				for (uint32_t i = 0; i < num_jobs; i++)
+				{
+					if (!job_status[i])
+					{
+						BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_texture: transcode_image_level() failed\n");
+						return false;
+					}
+				}
+			}
+			else
+			{
+				for (uint32_t i = level_start; i < level_end; i++)
+				{
+					if (!ktx2_transcode_subresource(*this, pOutput, fmt, decode_flags, subresources[order[i]], pMt_params, pState))
+					{
+						BASISU_DEVEL_ERROR("ktx2_transcoder::transcode_texture: transcode_image_level() failed\n");
+						return false;
+					}
+				}
+			}
+
+			level_start = level_end;
+		}
+
+		return true;
+	}
+
+	bool ktx2_transcoder::get_level_data(uint32_t level_index, uint32_t decode_flags, ktx2_transcoder_state* pState, const uint8_t*& pLevel_data, uint64_t& level_data_size)
+	{
+		pLevel_data = m_pData + m_levels[level_index].m_byte_offset.get_uint64();
+		level_data_size = m_levels[level_index].m_byte_length.get_uint64();
+
+		if (level_data_size > UINT32_MAX)
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::get_level_data: level_data_size > UINT32_MAX\n");
+			return false;
+		}
+
+		if (m_header.m_supercompression_scheme == KTX2_SS_ZSTANDARD)
+		{
+			if (decode_flags & cDecodeFlagsStreamZstdLevelData)
+			{
+				// Nothing is decompressed here. get_image_data() will stream decompress each 2D image on demand.
+				pLevel_data = nullptr;
+				level_data_size = m_levels[level_index].m_uncompressed_byte_length.get_uint64();
+				return true;
+			}
+
+			// Check if we've already decompressed this level's supercompressed data.
+			if ((int)level_index != pState->m_uncomp_data_level_index)
+			{
+				// Uncompress the entire level's supercompressed data.
+				if (!decompress_level_data(level_index, pState->m_level_uncomp_data))
+				{
+					BASISU_DEVEL_ERROR("ktx2_transcoder::get_level_data: decompress_level_data() failed\n");
+					return false;
+				}
+				pState->m_uncomp_data_level_index = level_index;
+			}
+
+			pLevel_data = pState->m_level_uncomp_data.data();
+			level_data_size = pState->m_level_uncomp_data.size();
+		}
+
+		return true;
+	}
+		
+	bool ktx2_transcoder::get_image_data(uint32_t level_index, const uint8_t* pLevel_data, uint64_t image_ofs, uint64_t image_size, ktx2_transcoder_state* pState, const uint8_t*& pImage_data)
+	{
+		if (pLevel_data)
+		{
+			// The caller has already validated image_ofs/image_size against the level's size.
+			pImage_data = pLevel_data + (size_t)image_ofs;
+			return true;
+		}
+
+		if (!stream_level_data(level_index, image_ofs, image_size, pState))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::get_image_data: stream_level_data() failed\n");
+			return false;
+		}
+
+		pImage_data = pState->m_stream_image_data.data();
+		return true;
+	}
+
+	// Decompresses the level's Zstd data forward from the state's current stream position, discarding everything before image_ofs, 
+	// and leaves [image_ofs, image_ofs + image_size) in pState->m_stream_image_data. Only restarts at the beginning of the level when seeking backwards.
+	bool ktx2_transcoder::stream_level_data(uint32_t level_index, uint64_t image_ofs, uint64_t image_size, ktx2_transcoder_state* pState)
+	{
+#if BASISD_SUPPORT_KTX2_ZSTD
+		const uint8_t* pComp_data = m_levels[level_index].m_byte_offset.get_uint64() + m_pData;
+		const uint64_t comp_size = m_levels[level_index].m_byte_length.get_uint64();
+		const uint64_t uncomp_size = m_levels[level_index].m_uncompressed_byte_length.get_uint64();
+
+		if ((!image_size) || ((size_t)comp_size != comp_size) || ((size_t)image_size != image_size) || 
+			(image_ofs > uncomp_size) || ((uncomp_size - image_ofs) < image_size))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: invalid image offset or size\n");
+			return false;
+		}
+
+		const bool same_stream = (pState->m_pStream_comp_data == pComp_data) && (pState->m_stream_level_index == (int)level_index);
+
+		// Check if the requested image is the one we last decompressed.
+		if ((same_stream) && (pState->m_stream_image_ofs == image_ofs) && (pState->m_stream_image_data.size() == image_size))
+			return true;
+
+		if (!pState->m_pStream_dctx)
+		{
+			pState->m_pStream_dctx = ZSTD_createDCtx();
+			if (!pState->m_pStream_dctx)
+			{
+				BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: ZSTD_createDCtx() failed\n");
+				return false;
+			}
+		}
+
+		ZSTD_DCtx* pDCtx = static_cast<ZSTD_DCtx*>(pState->m_pStream_dctx);
+
+		if ((!same_stream) || (image_ofs < pState->m_stream_uncomp_ofs))
+		{
+			// New level or seeking backwards, so restart at the beginning of the level's compressed data.
+			ZSTD_DCtx_reset(pDCtx, ZSTD_reset_session_only);
+
+			pState->m_pStream_comp_data = pComp_data;
+			pState->m_stream_level_index = level_index;
+			pState->m_stream_comp_ofs = 0;
+			pState->m_stream_uncomp_ofs = 0;
+		}
+
+		// Invalidate the buffered image until we've successfully decompressed the new one.
+		pState->m_stream_image_ofs = UINT64_MAX;
+
+		if (!pState->m_stream_image_data.try_resize((size_t)image_size))
+		{
+			BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: Out of memory\n");
+			return false;
+		}
+
+		uint8_t* pDst = pState->m_stream_image_data.data();
+
+		ZSTD_inBuffer in_buf = { pComp_data, (size_t)comp_size, (size_t)pState->m_stream_comp_ofs };
+
+		const uint64_t image_end_ofs = image_ofs + image_size;
+
+		while (pState->m_stream_uncomp_ofs < image_end_ofs)
+		{
+			ZSTD_outBuffer out_buf;
+
+			if (pState->m_stream_uncomp_ofs < image_ofs)
+			{
+				// Skip over the data before the requested image, using the image buffer as scratch space.
+				out_buf.dst = pDst;
+				out_buf.size = (size_t)basisu::minimum<uint64_t>(image_size, image_ofs - pState->m_stream_uncomp_ofs);
+			}
+			else
+			{
+				out_buf.dst = pDst + (size_t)(pState->m_stream_uncomp_ofs - image_ofs);
+				out_buf.size = (size_t)(image_end_ofs - pState->m_stream_uncomp_ofs);
+			}
+			out_buf.pos = 0;
+
+			const size_t prev_in_pos = in_buf.pos;
+
+			const size_t res = ZSTD_decompressStream(pDCtx, &out_buf, &in_buf);
+			
+			if (ZSTD_isError(res))
+			{
+				pState->clear_stream();
+
+				BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: Zstd decompression failed, file is invalid or corrupted\n");
+				return false;
+			}
+
+			pState->m_stream_uncomp_ofs += out_buf.pos;
+
+			if ((!out_buf.pos) && (in_buf.pos == prev_in_pos))
+			{
+				pState->clear_stream();
+
+				BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: Zstd decompression returned too few bytes, file is invalid or corrupted\n");
+				return false;
+			}
+		}
+
+		pState->m_stream_comp_ofs = in_buf.pos;
+		pState->m_stream_image_ofs = image_ofs;
+
+		return true;
+#else
+		BASISU_NOTE_UNUSED(level_index);
+		BASISU_NOTE_UNUSED(image_ofs);
+		BASISU_NOTE_UNUSED(image_size);
+		BASISU_NOTE_UNUSED(pState);
+
+		BASISU_DEVEL_ERROR("ktx2_transcoder::stream_level_data: File uses Zstd supercompression, but Zstd support was not enabled at compile time (BASISD_SUPPORT_KTX2_ZSTD is 0)\n");
+		return false;
+#endif
+	}
+		
 	bool ktx2_transcoder::decompress_level_data(uint32_t level_index, basisu::uint8_vec& uncomp_data)
 	{
 		const uint8_t* pComp_data = m_levels[level_index].m_byte_offset.get_uint64() + m_pData;
@@ -21245,6 +23775,68 @@ namespace basist
 #endif
 	}
 
+#if BASISD_SUPPORT_THREADS
+	struct parallel_for_worker_state
+	{
+		std::atomic<uint32_t> m_next_job_index;
+		uint32_t m_num_jobs;
+		basisu_transcoder_job_func m_pJob_func;
+		void* m_pJob_data;
+	};
+
+	static void parallel_for_worker(parallel_for_worker_state* pState)
+	{
+		for ( ; ; )
+		{
+			const uint32_t job_index = pState->m_next_job_index.fetch_add(1);
+			if (job_index >= pState->m_num_jobs)
+				break;
+
+			pState->m_pJob_func(job_index, pState->m_pJob_data);
+		}
+	}
+#endif
+
+	void basisu_transcoder_parallel_for(const basisu_transcoder_parallel_params& params, uint32_t num_jobs, basisu_transcoder_job_func pJob_func, void* pJob_data)
+	{
+		if (!num_jobs)
+			return;
+
+		if ((num_jobs > 1) && (params.m_pParallel_for))
+		{
+			params.m_pParallel_for(num_jobs, pJob_func, pJob_data, params.m_pParallel_for_data);
+			return;
+		}
+
+#if BASISD_SUPPORT_THREADS
+		const uint32_t num_threads = basisu::minimum<uint32_t>(num_jobs, params.m_max_threads);
+		if (num_threads > 1)
+		{
+			parallel_for_worker_state state;
+			state.m_next_job_index = 0;
+			state.m_num_jobs = num_jobs;
+			state.m_pJob_func = pJob_func;
+			state.m_pJob_data = pJob_data;
+
+			// The calling thread also executes jobs.
+			std::vector<std::thread> threads;
+			threads.reserve(num_threads - 1);
+			for (uint32_t i = 1; i < num_threads; i++)
+				threads.emplace_back(parallel_for_worker, &state);
+
+			parallel_for_worker(&state);
+
+			for (auto& t : threads)
+				t.join();
+
+			return;
+		}
+#endif
+
+		for (uint32_t i = 0; i < num_jobs; i++)
+			pJob_func(i, pJob_data);
+	}
+
 	//-------------------------------
 
 #if BASISD_SUPPORT_UASTC_HDR
@@ -22957,8 +25549,8 @@ namespace basist
 		}
 				
 		// Valid for weight ISE ranges 6-192 or 8-192 levels. Preserves upper 2 or 3 bits post-quantization.
-		uint8_t g_quantize_tables_preserve2[21 - 1][256]; // astc_helpers::TOTAL_ISE_RANGES=21, valid for >= BISE_6_LEVELS
-		uint8_t g_quantize_tables_preserve3[21 - 1][256]; // valid for >= BISE_8_LEVELS
+		BASISD_PRECOMPUTED_CONST uint8_t g_quantize_tables_preserve2[21 - 1][256] BASISD_PRECOMPUTED_TABLE(g_quantize_tables_preserve2); // astc_helpers::TOTAL_ISE_RANGES=21, valid for >= BISE_6_LEVELS
+		BASISD_PRECOMPUTED_CONST uint8_t g_quantize_tables_preserve3[21 - 1][256] BASISD_PRECOMPUTED_TABLE(g_quantize_tables_preserve3); // valid for >= BISE_8_LEVELS
 
 		const uint32_t g_part2_unique_index_to_seed[NUM_UNIQUE_PARTITIONS2] =
 		{
@@ -23004,6 +25596,7 @@ namespace basist
 			1007, 1010, 1011, 1012, 1015, 1020, 1023
 		};
 
+#if !BASISD_USE_PRECOMPUTED_TABLES
 		static void init_quantize_tables()
 		{
 			// 9/15/2025 changed lower range for LDR
@@ -23085,6 +25678,7 @@ namespace basist
 
 			} // ise_range
 		}
+#endif // !BASISD_USE_PRECOMPUTED_TABLES
 
 		void requantize_ise_endpoints(uint32_t cem, uint32_t src_ise_endpoint_range, const uint8_t* pSrc_endpoints, uint32_t dst_ise_endpoint_range, uint8_t* pDst_endpoints)
 		{
@@ -43091,6 +45685,8 @@ bool basisu_lowlevel_xuastc_ldr_transcoder::transcode_slice(
 		return false;
 	}
 
+	init_table_families(get_table_families(src_format, fmt));
+
 	if (block_format_is_hdr(fmt))
 	{
 		assert(0);
@@ -45468,6 +48064,8 @@ bool basisu_lowlevel_xubc7_transcoder::transcode_slice(
 		return false;
 	}
 
+	init_table_families(get_table_families(src_tex_format, fmt));
+
 	if (block_format_is_hdr(fmt))
 	{
 		assert(0);
@@ -45953,6 +48551,142 @@ bool basisu_lowlevel_xubc7_transcoder::transcode_image(
 #endif // BASISD_SUPPORT_XUASTC
 }
 
+#if BASISD_WRITE_NEW_PRECOMPUTED_TABLES
+// Writes a table as a BASISD_PRECOMPUTED_<name> macro holding its braced initializer, one brace level per array dimension.
+template<typename T, typename F>
+static void write_precomputed_table(FILE* pFile, const char* pName, const T* pTable, size_t table_size, std::initializer_list<uint32_t> dims, F write_elem)
+{
+	uint32_t total_elems = 1;
+	for (uint32_t d : dims)
+		total_elems *= d;
+	assert(total_elems * sizeof(T) == table_size);
+	BASISU_NOTE_UNUSED(table_size);
+
+	fprintf(pFile, "#define BASISD_PRECOMPUTED_%s \\\n", pName);
+
+	const uint32_t* pDims = dims.begin();
+	const uint32_t num_dims = (uint32_t)dims.size();
+
+	uint32_t counters[4] = { 0, 0, 0, 0 };
+	assert(num_dims <= 4);
+
+	for (uint32_t i = 0; i < num_dims; i++)
+		fputc('{', pFile);
+
+	for (uint32_t elem_index = 0; elem_index < total_elems; elem_index++)
+	{
+		write_elem(pFile, pTable[elem_index]);
+
+		// Close the dimensions that just ended, then reopen them for the next element.
+		int d = (int)num_dims - 1;
+		while ((d >= 0) && (++counters[d] == pDims[d]))
+		{
+			counters[d] = 0;
+			fputc('}', pFile);
+			d--;
+		}
+
+		if (elem_index + 1 < total_elems)
+		{
+			fputc(',', pFile);
+			if ((elem_index & 15) == 15)
+				fputs(" \\\n", pFile);
+			for (int i = d + 1; i < (int)num_dims; i++)
+				fputc('{', pFile);
+		}
+	}
+
+	fputs("\n\n", pFile);
+}
+
+static void create_precomputed_tables()
+{
+	FILE* pFile = fopen("basisu_transcoder_tables_precomputed.inc", "w");
+	if (!pFile)
+		return;
+
+	fprintf(pFile, "// Generated by create_precomputed_tables() (BASISD_WRITE_NEW_PRECOMPUTED_TABLES) - do not edit.\n\n");
+
+	auto write_u8 = [](FILE* pF, uint8_t v) { fprintf(pF, "%u", v); };
+	auto write_u32 = [](FILE* pF, uint32_t v) { fprintf(pF, "%u", v); };
+	auto write_lo_hi = [](FILE* pF, const auto& e) { fprintf(pF, "{%u,%u}", e.m_lo, e.m_hi); };
+	auto write_hi_lo = [](FILE* pF, const auto& e) { fprintf(pF, "{%u,%u}", e.m_hi, e.m_lo); };
+	auto write_l_h = [](FILE* pF, const auto& e) { fprintf(pF, "{%u,%u}", e.m_l, e.m_h); };
+
+#define BASISD_WRITE_PRECOMPUTED_TABLE(name, elem_type, write_elem, ...) write_precomputed_table(pFile, #name, (const elem_type*)&name, sizeof(name), { __VA_ARGS__ }, write_elem)
+
+#if BASISD_SUPPORT_DXT1 || BASISD_SUPPORT_UASTC
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc1_match5_equals_1, bc1_match_entry, write_hi_lo, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc1_match6_equals_1, bc1_match_entry, write_hi_lo, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc1_match5_equals_0, bc1_match_entry, write_hi_lo, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc1_match6_equals_0, bc1_match_entry, write_hi_lo, 256);
+#endif
+
+#if BASISD_SUPPORT_DXT1
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_range_index, uint32_t, write_u32, 4, 4);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_mappings_raw_dxt1_256, uint8_t, write_u8, NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_dxt1_selector_mappings_raw_dxt1_inv_256, uint8_t, write_u8, NUM_ETC1_TO_DXT1_SELECTOR_MAPPINGS, 256);
+#endif
+
+#if BASISD_SUPPORT_BC7_MODE5
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_bc7_m5_selector_range_index, uint32_t, write_u32, 4, 4);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_bc7_m5a_selector_range_index, uint32_t, write_u32, 4, 4);
+
+	{
+		using namespace bc7_mode_5_encoder;
+		// %.9g round trips floats exactly.
+		BASISD_WRITE_PRECOMPUTED_TABLE(g_mode5_rgba_midpoints, float, [](FILE* pF, float v) { fprintf(pF, "%.9gf", v); }, 128);
+	}
+#endif
+
+#if BASISD_SUPPORT_ASTC
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_astc_selector_range_index, uint32_t, write_u32, 4, 4);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_astc_best_grayscale_mapping, uint8_t, write_u8, 32, 8, NUM_ETC1_TO_ASTC_SELECTOR_RANGES);
+#if BASISD_SUPPORT_ASTC_HIGHER_OPAQUE_QUALITY
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1_to_astc_best_grayscale_mapping_0_255, uint8_t, write_u8, 32, 8, NUM_ETC1_TO_ASTC_SELECTOR_RANGES);
+#endif
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_ise_to_unquant, uint32_t, write_u32, 48);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_astc_single_color_encoding_0, uint8_t, write_u8, 256);
+	write_precomputed_table(pFile, "g_astc_single_color_encoding_1", g_astc_single_color_encoding_1, sizeof(g_astc_single_color_encoding_1), { 256 }, write_lo_hi);
+#endif
+
+#if BASISD_SUPPORT_ATC
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_pvrtc2_match45_equals_1, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_atc_match55_equals_1, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_atc_match56_equals_1, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_pvrtc2_match4, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_atc_match5, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_atc_match6, atc_match_entry, write_lo_hi, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_etc1s_to_atc_selector_range_index, uint32_t, write_u32, 4, 4);
+#endif
+
+#if BASISD_SUPPORT_PVRTC2
+	write_precomputed_table(pFile, "g_pvrtc2_trans_match34", g_pvrtc2_trans_match34, sizeof(g_pvrtc2_trans_match34), { 256 }, write_l_h);
+	write_precomputed_table(pFile, "g_pvrtc2_trans_match44", g_pvrtc2_trans_match44, sizeof(g_pvrtc2_trans_match44), { 256 }, write_l_h);
+	write_precomputed_table(pFile, "g_pvrtc2_alpha_match33", g_pvrtc2_alpha_match33, sizeof(g_pvrtc2_alpha_match33), { 256 }, write_l_h);
+	write_precomputed_table(pFile, "g_pvrtc2_alpha_match33_0", g_pvrtc2_alpha_match33_0, sizeof(g_pvrtc2_alpha_match33_0), { 256 }, write_l_h);
+	write_precomputed_table(pFile, "g_pvrtc2_alpha_match33_3", g_pvrtc2_alpha_match33_3, sizeof(g_pvrtc2_alpha_match33_3), { 256 }, write_l_h);
+#endif
+
+#if BASISD_SUPPORT_UASTC
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_astc_unquant, astc_quant_bin, [](FILE* pF, const astc_quant_bin& e) { fprintf(pF, "{%u,%u}", e.m_unquant, e.m_index); }, BC7ENC_TOTAL_ASTC_RANGES, 256);
+
+	auto write_endpoint_err = [](FILE* pF, const endpoint_err& e) { fprintf(pF, "{%u,%u,%u}", e.m_error, e.m_lo, e.m_hi); };
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc7_mode_6_optimal_endpoints, endpoint_err, write_endpoint_err, 256, 2);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_bc7_mode_5_optimal_endpoints, endpoint_err, write_endpoint_err, 256);
+#endif
+
+#if BASISD_SUPPORT_UASTC_HDR
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_quantize_tables_preserve2, uint8_t, write_u8, 21 - 1, 256);
+	BASISD_WRITE_PRECOMPUTED_TABLE(g_quantize_tables_preserve3, uint8_t, write_u8, 21 - 1, 256);
+#endif
+
+#undef BASISD_WRITE_PRECOMPUTED_TABLE
+
+	fclose(pFile);
+}
+#endif // BASISD_WRITE_NEW_PRECOMPUTED_TABLES
+
 } // namespace basist
 
 // XUBC7/XBC7 decoder source code
@@ -218,6 +218,15 @@ namespace basist
 
 	class basisu_transcoder;
 
+	// A rectangle of source blocks within a slice, used for region (tile) transcoding.
+	struct basisu_block_rect
+	{
+		uint32_t m_x, m_y;
+		uint32_t m_width, m_height;
+	};
+
+	class basisu_lowlevel_etc1s_transcoder;
+
 	// This struct holds all state used during transcoding. For video, it needs to persist between image transcodes (it holds the previous frame).
 	// For threading you can use one state per thread.
 	struct basisu_transcoder_state
@@ -233,6 +242,88 @@ namespace basist
 		enum { cMaxPrevFrameLevels = 16 };
 		basisu::vector<uint32_t> m_prev_frame_indices[2][cMaxPrevFrameLevels]; // [alpha_flag][level_index] 
 
+		// The video frame (.basis image index or KTX2 layer index) each level's m_prev_frame_indices currently holds, or -1 if unknown. P-frames can only be 
+		// decoded right after the previous frame, so transcode_video_frame() uses this to continue from the current frame instead of going back to the I-frame.
+		int m_prev_frame_index[cMaxPrevFrameLevels];
+
+		basisu_transcoder_state()
+		{
+			for (uint32_t i = 0; i < cMaxPrevFrameLevels; i++)
+				m_prev_frame_index[i] = -1;
+		}
+
+		// Called after a video frame has been transcoded with this state. Decoding a P-frame which doesn't follow the previous frame leaves the level's state unknown.
+		void update_prev_frame_index(uint32_t level_index, uint32_t frame_index, bool iframe_flag, bool success)
+		{
+			if (level_index >= cMaxPrevFrameLevels)
+				return;
+
+			int& prev_frame_index = m_prev_frame_index[level_index];
+			const bool valid = success && (iframe_flag || (prev_frame_index == (int)frame_index) || ((prev_frame_index >= 0) && ((prev_frame_index + 1) == (int)frame_index)));
+			prev_frame_index = valid ? (int)frame_index : -1;
+		}
+
+		// ETC1S slice seek index, used by region transcoding. The entropy decoder's state is saved at the start of every cETC1SCheckpointRows'th block row 
+		// the first time it's decoded, so later regions can resume decoding at the nearest checkpoint above the region instead of at the top of the slice.
+		enum { cETC1SCheckpointRows = 16 }; // must be even (the endpoint predictor symbols cover 2x2 blocks)
+
+		struct etc1s_checkpoint
+		{
+			bitwise_decoder m_codec;
+			approx_move_to_front m_selector_history_buf;
+			uint32_t m_cur_selector_rle_count;
+			int m_prev_endpoint_pred_sym;
+			int m_endpoint_pred_repeat_count;
+			uint32_t m_prev_endpoint_index;
+			basisu::vector<uint16_t> m_prev_row_endpoint_indices;
+		};
+
+		struct etc1s_seek_index
+		{
+			const basisu_lowlevel_etc1s_transcoder* m_pTranscoder;
+			uint32_t m_tables_generation;
+			const uint8_t* m_pSlice_data;
+			uint32_t m_slice_data_size;
+			uint32_t m_num_blocks_x, m_num_blocks_y;
+			basisu::vector<etc1s_checkpoint> m_checkpoints;
+		};
+
+		// Seek indices keyed by slice data address. At most cMaxETC1SSeekIndices slices are indexed, after that the map is emptied and starts over.
+		enum { cMaxETC1SSeekIndices = 64 };
+		basisu::hash_map<uint64_t, etc1s_seek_index> m_etc1s_seek_indices;
+
+		// tables_generation comes from the low-level transcoder and changes every time it decodes new tables (i.e. on every init()/start_transcoding()), 
+		// so checkpoints saved for a previous file which happened to be at the same address are never reused.
+		etc1s_seek_index* get_etc1s_seek_index(const basisu_lowlevel_etc1s_transcoder* pTranscoder, uint32_t tables_generation, const uint8_t* pSlice_data, uint32_t slice_data_size, uint32_t num_blocks_x, uint32_t num_blocks_y)
+		{
+			const uint64_t key = (uint64_t)(uintptr_t)pSlice_data;
+
+			auto it = m_etc1s_seek_indices.find(key);
+			if (it == m_etc1s_seek_indices.end())
+			{
+				if (m_etc1s_seek_indices.size() >= cMaxETC1SSeekIndices)
+					m_etc1s_seek_indices.clear();
+
+				it = m_etc1s_seek_indices.insert(key).first;
+				it->second.m_pTranscoder = nullptr;
+			}
+
+			etc1s_seek_index& index = it->second;
+			if ((index.m_pTranscoder != pTranscoder) || (index.m_tables_generation != tables_generation) || (index.m_pSlice_data != pSlice_data) || 
+				(index.m_slice_data_size != slice_data_size) || (index.m_num_blocks_x != num_blocks_x) || (index.m_num_blocks_y != num_blocks_y))
+			{
+				index.m_pTranscoder = pTranscoder;
+				index.m_tables_generation = tables_generation;
+				index.m_pSlice_data = pSlice_data;
+				index.m_slice_data_size = slice_data_size;
+				index.m_num_blocks_x = num_blocks_x;
+				index.m_num_blocks_y = num_blocks_y;
+				index.m_checkpoints.clear();
+			}
+
+			return &index;
+		}
+
 		void clear()
 		{
 			for (uint32_t i = 0; i < 2; i++)
@@ -242,6 +333,11 @@ namespace basist
 				for (uint32_t j = 0; j < cMaxPrevFrameLevels; j++)
 					m_prev_frame_indices[i][j].clear();
 			}
+
+			for (uint32_t i = 0; i < cMaxPrevFrameLevels; i++)
+				m_prev_frame_index[i] = -1;
+
+			m_etc1s_seek_indices.clear();
 		}
 	};
 
@@ -283,7 +379,13 @@ namespace basist
 		// By default XUASTC LDR 4x4, 6x6 and 8x6 are directly transcoded to BC7 without always requiring a full ASTC block unpack and analytical BC7 encode. This is 1.4x up to 3x faster in WASM.
 		// This trade offs some quality. The largest transcoding speed gain is achieved when the source XUASTC data isn't dual plane and only uses 1 subset. Otherwise the actual perf. gain is variable.
 		// To disable this optimization for all XUASTC block sizes and always use the fallback encoder, specify cDecodeFlagXUASTCLDRDisableFastBC7Transcoding.
-		cDecodeFlagXUASTCLDRDisableFastBC7Transcoding = 1024
+		cDecodeFlagXUASTCLDRDisableFastBC7Transcoding = 1024,
+
+		// KTX2 Zstd supercompressed files only (UASTC LDR/HDR 4x4, ASTC HDR 6x6, ASTC LDR): Instead of decompressing the entire mipmap level into memory before transcoding, 
+		// stream decompress the level's data only as far as the requested layer/face. The decompression cursor is kept in the ktx2_transcoder_state, so transcoding 
+		// a level's layers/faces in increasing order never decompresses any data twice or holds more than one 2D image (slice) in memory. 
+		// Seeking backwards within a level, or switching levels, restarts decompression at the beginning of the level.
+		cDecodeFlagsStreamZstdLevelData = 2048
 	};
 	
 	// ETC1S
@@ -301,11 +403,17 @@ namespace basist
 			uint32_t num_endpoints, const uint8_t* pEndpoints_data, uint32_t endpoints_data_size,
 			uint32_t num_selectors, const uint8_t* pSelectors_data, uint32_t selectors_data_size);
 
+		// Decodes a standalone global codebook file (see basis_global_codebooks_header) into this object's endpoint/selector codebooks.
+		// Decode it once, then pass this object to set_global_codebooks() on every transcoder (or to the encoder's m_pGlobal_codebooks). 
+		// Transcoders only read from it, so one instance can be shared by any number of transcoders across threads.
+		bool decode_global_codebooks(const void* pData, uint32_t data_size);
+
 		bool decode_tables(const uint8_t* pTable_data, uint32_t table_data_size);
 
 		bool transcode_slice(void* pDst_blocks, uint32_t num_blocks_x, uint32_t num_blocks_y, const uint8_t* pImage_data, uint32_t image_data_size, block_format fmt,
 			uint32_t output_block_or_pixel_stride_in_bytes, bool bc1_allow_threecolor_blocks, const bool is_video, const bool is_alpha_slice, const uint32_t level_index, const uint32_t orig_width, const uint32_t orig_height, uint32_t output_row_pitch_in_blocks_or_pixels = 0,
-			basisu_transcoder_state* pState = nullptr, bool astc_transcode_alpha = false, void* pAlpha_blocks = nullptr, uint32_t output_rows_in_pixels = 0, uint32_t decode_flags = 0);
+			basisu_transcoder_state* pState = nullptr, bool astc_transcode_alpha = false, void* pAlpha_blocks = nullptr, uint32_t output_rows_in_pixels = 0, uint32_t decode_flags = 0,
+			const basisu_block_rect* pSrc_rect = nullptr);
 
 		bool transcode_slice(void* pDst_blocks, uint32_t num_blocks_x, uint32_t num_blocks_y, const uint8_t* pImage_data, uint32_t image_data_size, block_format fmt,
 			uint32_t output_block_or_pixel_stride_in_bytes, bool bc1_allow_threecolor_blocks, const basis_file_header& header, const basis_slice_desc& slice_desc, uint32_t output_row_pitch_in_blocks_or_pixels = 0,
@@ -320,6 +428,8 @@ namespace basist
 		}
 
 		// Container independent transcoding
+		// If pSrc_rect isn't nullptr, only that rectangle of the slice's blocks is transcoded, and the output (and output_row_pitch_in_blocks_or_pixels/output_rows_in_pixels) is sized to the rectangle.
+		// num_blocks_x/num_blocks_y/orig_width/orig_height always describe the entire slice. Not supported for PVRTC1 or video.
 		bool transcode_image(
 			transcoder_texture_format target_format,
 			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
@@ -331,7 +441,8 @@ namespace basist
 			bool is_video = false,
 			uint32_t output_row_pitch_in_blocks_or_pixels = 0,
 			basisu_transcoder_state* pState = nullptr,
-			uint32_t output_rows_in_pixels = 0);
+			uint32_t output_rows_in_pixels = 0,
+			const basisu_block_rect* pSrc_rect = nullptr);
 
 		void clear()
 		{
@@ -342,6 +453,7 @@ namespace basist
 			m_selector_model.clear();
 			m_selector_history_buf_rle_model.clear();
 			m_selector_history_buf_size = 0;
+			m_tables_generation = 0;
 		}
 
 		// Low-level methods
@@ -361,6 +473,9 @@ namespace basist
 
 		uint32_t m_selector_history_buf_size;
 
+		// Process-wide unique ID of the tables last decoded by decode_tables(), 0 if none (see basisu_transcoder_state::get_etc1s_seek_index()).
+		uint32_t m_tables_generation;
+
 		basisu_transcoder_state m_def_state;
 	};
 		
@@ -855,6 +970,62 @@ namespace basist
 		return nullptr;
 	}
 
+	struct basisu_transcoder_parallel_params;
+
+	// Placement rules for the single GPU upload buffer written by ktx2_transcoder::transcode_texture() and basisu_transcoder::transcode_texture().
+	enum class transcoder_upload_layout_rules
+	{
+		// Level major order (all the layers/faces of level 0, then level 1, etc.), like KTX2. Only the caller's alignments are applied.
+		cPacked,
+
+		// vkCmdCopyBufferToImage(): level major order, each subresource's offset is a multiple of 4 and of the format's block (or pixel) size.
+		cVulkan,
+
+		// ID3D12GraphicsCommandList::CopyTextureRegion() placed footprints: D3D12 subresource index order (array slice major, then level, with the array slice = layer * faces + face),
+		// row pitches are a multiple of D3D12_TEXTURE_DATA_PITCH_ALIGNMENT (256) and offsets a multiple of D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT (512).
+		cD3D12
+	};
+
+	// Describes the upload buffer's layout, and which subresources to transcode into it.
+	struct transcoder_upload_layout
+	{
+		transcoder_upload_layout_rules m_rules = transcoder_upload_layout_rules::cPacked;
+
+		// Extra alignments in bytes, combined with m_rules's. Row pitches are always a whole number of blocks (or pixels), so the actual alignment is the lowest common multiple of this and the block size.
+		// Not applied to PVRTC1, which is always tightly packed (it's swizzled).
+		uint32_t m_row_pitch_alignment = 1;
+		uint32_t m_subresource_alignment = 1;
+
+		// The subset of levels/layers/faces to transcode. A count of 0 means all of the remaining ones.
+		uint32_t m_first_level = 0, m_total_levels = 0;
+		uint32_t m_first_layer = 0, m_total_layers = 0;
+		uint32_t m_first_face = 0, m_total_faces = 0;
+	};
+
+	// Where a single transcoded subresource (2D image) was placed in the upload buffer.
+	struct transcoder_subresource_desc
+	{
+		// For .basis files the layer index is the image index, and the face index is always 0.
+		uint32_t m_level_index;
+		uint32_t m_layer_index;
+		uint32_t m_face_index;
+
+		// The image's dimensions in pixels (which may not be divisible by the block size), and in blocks of the target format (or pixels if it's uncompressed).
+		uint32_t m_orig_width;
+		uint32_t m_orig_height;
+		uint32_t m_num_blocks_x;
+		uint32_t m_num_blocks_y;
+
+		// Byte offset from the start of the upload buffer.
+		uint64_t m_offset;
+
+		// Bytes between each row of blocks (or pixels). Divide by basis_get_bytes_per_block_or_pixel() to get the row length in blocks or pixels.
+		uint32_t m_row_pitch;
+
+		// Bytes used by the subresource: normally m_row_pitch * m_num_blocks_y, but larger for very small PVRTC1 textures (see basis_compute_transcoded_image_size_in_bytes()).
+		uint32_t m_size;
+	};
+
 	// High-level transcoder class which accepts .basis file data and allows the caller to query information about the file and transcode image levels to various texture formats.
 	// If you're just starting out this is the class you care about (or see the KTX2 transcoder below).
 	class basisu_transcoder
@@ -925,6 +1096,41 @@ namespace basist
 			transcoder_texture_format fmt,
 			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, basisu_transcoder_state* pState = nullptr, uint32_t output_rows_in_pixels = 0) const;
 
+		// ETC1S video random access. I-frames can be decoded on their own, but every P-frame depends on the frame before it, so decoding must start at an I-frame.
+		// get_video_iframe_index() returns the image indices of the I-frames of a mipmap level in ascending order (every image if the file isn't a video).
+		// start_transcoding() builds an I-frame index, so after it find_video_iframe() is a binary search instead of a scan of the slice descs.
+		bool get_video_iframe_index(const void* pData, uint32_t data_size, basisu::vector<uint32_t>& iframe_image_indices, uint32_t level_index = 0) const;
+
+		// Returns the closest I-frame at or before image_index (image_index itself if the file isn't a video), or -1 on error.
+		int find_video_iframe(const void* pData, uint32_t data_size, uint32_t image_index, uint32_t level_index = 0) const;
+
+		// transcode_video_frame() is transcode_image_level() with random access to ETC1S video frames. If pState already holds image_index's previous frame (or the 
+		// frame itself) only image_index is transcoded, so playing frames in order decodes each one once. Otherwise every frame from the closest I-frame up to image_index 
+		// is transcoded into pOutput_blocks, leaving image_index's. Other files are passed straight to transcode_image_level().
+		// pState (or the internal state if nullptr) must only be used with one file and output format.
+		bool transcode_video_frame(
+			const void* pData, uint32_t data_size,
+			uint32_t image_index, uint32_t level_index,
+			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+			transcoder_texture_format fmt,
+			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, basisu_transcoder_state* pState = nullptr, uint32_t output_rows_in_pixels = 0) const;
+
+		// Computes where every subresource (image/level) selected by layout would be placed in an upload buffer of fmt texture data, without transcoding anything.
+		// subresources is returned in buffer order. total_size is the required size of the upload buffer in bytes.
+		bool get_upload_layout(const void* pData, uint32_t data_size, transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+			basisu::vector<transcoder_subresource_desc>& subresources, uint64_t& total_size) const;
+
+		// Transcodes every subresource selected by layout into a single caller provided upload buffer, which must be at least get_upload_layout()'s total_size bytes.
+		// The placement of each subresource is returned in subresources (the same table get_upload_layout() returns). Bytes between subresources/rows are left untouched.
+		// If pMt_params is not nullptr, independent images are transcoded in parallel. ETC1S video frames are split into GOPs at each I-frame, and the GOPs are 
+		// transcoded in parallel, each in order with its own state. A layout starting at a P-frame is decoded from the closest I-frame (see transcode_video_frame()).
+		// pState is used when transcoding serially. start_transcoding() must have been called first.
+		bool transcode_texture(const void* pData, uint32_t data_size,
+			void* pOutput_buf, uint64_t output_buf_size,
+			transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+			basisu::vector<transcoder_subresource_desc>& subresources,
+			uint32_t decode_flags = 0, const basisu_transcoder_parallel_params* pMt_params = nullptr, basisu_transcoder_state* pState = nullptr) const;
+
 		// Finds the basis slice corresponding to the specified image/level/alpha params, or -1 if the slice can't be found.
 		int find_slice(const void* pData, uint32_t data_size, uint32_t image_index, uint32_t level_index, bool alpha_data) const;
 
@@ -967,14 +1173,57 @@ namespace basist
 
 		bool m_ready_to_transcode;
 
+		// ETC1S video: the I-frame image indices of each mipmap level in ascending order, built by start_transcoding().
+		basisu::vector< basisu::vector<uint32_t> > m_video_iframe_indices;
+
 		int find_first_slice_index(const void* pData, uint32_t data_size, uint32_t image_index, uint32_t level_index) const;
 
 		bool validate_header_quick(const void* pData, uint32_t data_size) const;
 	};
 
 	// basisu_transcoder_init() MUST be called before a .basis file can be transcoded.
+	// It's fast: the transcoder's lookup tables are built on demand (thread safely) the first time each source/target texture format combination is transcoded.
 	void basisu_transcoder_init();
-		
+
+	// Same as basisu_transcoder_init(), but also immediately builds the lookup tables needed to transcode to the pFormats target formats, so the first transcode isn't slowed down. 
+	// Optionally restrict this to the pSource_formats source formats, otherwise the tables needed by any source format are built.
+	// If pFormats is nullptr every lookup table is built. This is required before calling any of the low-level block conversion functions directly (the encoder does this).
+	// Can be called more than once.
+	void basisu_transcoder_init(const transcoder_texture_format* pFormats, uint32_t n, const basis_tex_format* pSource_formats = nullptr, uint32_t num_source_formats = 0);
+
+	// Returns true if the transcoder was compiled with BASISD_SUPPORT_SSE and the CPU supports SSE 4.1.
+	bool basisu_transcoder_supports_sse41();
+
+	// The SSE 4.1 ETC1S block conversion kernels are used automatically when supported. They can be disabled (or reenabled) at runtime for testing and benchmarking.
+	// Not thread safe: only call this while nothing is being transcoded.
+	void basisu_transcoder_enable_sse41(bool enabled);
+	bool basisu_transcoder_is_sse41_enabled();
+
+	// Optional multithreaded transcoding support (see ktx2_transcoder::transcode_image_level_mt()).
+	// The transcoder doesn't depend on any job system. Callers can plug in their own with basisu_transcoder_parallel_for_func, otherwise
+	// if BASISD_SUPPORT_THREADS is 1 a few std::thread workers are created for the duration of each call.
+	typedef void (*basisu_transcoder_job_func)(uint32_t job_index, void* pJob_data);
+
+	// Must call pJob_func(i, pJob_data) exactly once for each i in [0, num_jobs), on any thread and in any order, and only return once all calls have completed.
+	typedef void (*basisu_transcoder_parallel_for_func)(uint32_t num_jobs, basisu_transcoder_job_func pJob_func, void* pJob_data, void* pUser_data);
+
+	struct basisu_transcoder_parallel_params
+	{
+		// Maximum number of jobs (and threads, if using the built-in workers) to split the work into. 0 or 1 disables multithreading.
+		uint32_t m_max_threads = 1;
+
+		// Minimum number of source blocks per job, so small mipmap levels aren't split into tiny jobs.
+		uint32_t m_min_blocks_per_job = 2048;
+
+		// Optional caller supplied job system. If nullptr, the built-in workers are used.
+		basisu_transcoder_parallel_for_func m_pParallel_for = nullptr;
+		void* m_pParallel_for_data = nullptr;
+	};
+
+	// Runs num_jobs jobs using params's job system (or the built-in workers), and returns once they have all completed.
+	// If BASISD_SUPPORT_THREADS is 0 and no job system was supplied, the jobs are executed serially on the calling thread.
+	void basisu_transcoder_parallel_for(const basisu_transcoder_parallel_params& params, uint32_t num_jobs, basisu_transcoder_job_func pJob_func, void* pJob_data);
+
 	enum debug_flags_t
 	{
 		cDebugFlagVisCRs = 1,
@@ -1014,7 +1263,7 @@ namespace basist
 		// true if the image has alpha data
 		bool m_alpha_flag;
 
-		// true if the image is an I-Frame. Currently, for ETC1S textures, the first frame will always be an I-Frame, and subsequent frames will always be P-Frames.
+		// true if the image is an I-Frame. For ETC1S textures, the first frame will always be an I-Frame, and subsequent frames are P-Frames unless the encoder emitted periodic I-Frames.
 		bool m_iframe_flag;
 	};
 
@@ -1239,12 +1488,49 @@ namespace basist
 		basisu::uint8_vec m_level_uncomp_data;
 		int m_uncomp_data_level_index;
 
-		void clear()
+		// One state per band, used by transcode_image_level_mt().
+		basisu::vector<basist::basisu_transcoder_state> m_band_states;
+
+		// Resumable Zstd stream decompression cursor, used when cDecodeFlagsStreamZstdLevelData is specified.
+		void* m_pStream_dctx; // ZSTD_DCtx*
+		const uint8_t* m_pStream_comp_data;
+		int m_stream_level_index;
+		uint64_t m_stream_comp_ofs;
+		uint64_t m_stream_uncomp_ofs;
+		
+		// The most recently decompressed 2D image (slice), and its offset in the uncompressed level data.
+		basisu::uint8_vec m_stream_image_data;
+		uint64_t m_stream_image_ofs;
+
+		// Used by transcode_image_level_region(): the source rectangle's blocks, and the most recently transcoded image of a format which can't be randomly accessed.
+		struct region_cache_key
 		{
-			m_transcoder_state.clear();
-			m_level_uncomp_data.clear();
-			m_uncomp_data_level_index = -1;
-		}
+			const uint8_t* m_pData;
+			uint32_t m_level_index, m_layer_index, m_face_index;
+			uint32_t m_fmt, m_decode_flags;
+			int m_channel0, m_channel1;
+
+			bool operator== (const region_cache_key& rhs) const
+			{
+				return (m_pData == rhs.m_pData) && (m_level_index == rhs.m_level_index) && (m_layer_index == rhs.m_layer_index) && (m_face_index == rhs.m_face_index) &&
+					(m_fmt == rhs.m_fmt) && (m_decode_flags == rhs.m_decode_flags) && (m_channel0 == rhs.m_channel0) && (m_channel1 == rhs.m_channel1);
+			}
+		};
+
+		basisu::uint8_vec m_region_blocks;
+		basisu::uint8_vec m_region_cache;
+		region_cache_key m_region_cache_key;
+		bool m_region_cache_valid;
+
+		ktx2_transcoder_state();
+		ktx2_transcoder_state(const ktx2_transcoder_state& other);
+		~ktx2_transcoder_state();
+
+		// The Zstd stream cursor isn't copied.
+		ktx2_transcoder_state& operator= (const ktx2_transcoder_state& rhs);
+
+		void clear();
+		void clear_stream();
 	};
 		
 	// This class is quite similar to basisu_transcoder. It treats KTX2 files as a simple container for ETC1S/UASTC texture data.
@@ -1384,8 +1670,15 @@ namespace basist
 		uint32_t get_etc1s_image_descs_image_flags(uint32_t level_index, uint32_t layer_index, uint32_t face_index) const;
 
 		// is_video() is only valid after start_transcoding() is called.
-		// For ETC1S data, if this returns true you must currently transcode the file from first to last frame, in order, without skipping any frames.
+		// For ETC1S data, if this returns true frames must be transcoded in order starting at an I-frame, or with transcode_video_frame().
 		bool is_video() const { return m_is_video; }
+
+		// ETC1S video random access (valid after start_transcoding()). I-frames can be decoded on their own, but every P-frame depends on the previous frame (layer).
+		// get_video_iframe_index() returns the layer indices of the I-frames of a mipmap level in ascending order (every layer if the file isn't a video).
+		bool get_video_iframe_index(basisu::vector<uint32_t>& iframe_layer_indices, uint32_t level_index = 0) const;
+
+		// Returns the closest I-frame at or before layer_index (layer_index itself if the file isn't a video), or -1 on error.
+		int find_video_iframe(uint32_t level_index, uint32_t layer_index) const;
 		
 		// Defaults to 0, only non-zero if the key existed in the source KTX2 file.
 		float get_ldr_hdr_upconversion_nit_multiplier() const { return m_ldr_hdr_upconversion_nit_multiplier; }
@@ -1405,7 +1698,7 @@ namespace basist
 		// Internally it uses the same low-level transcode API's as basisu_transcoder::transcode_image_level().
 		// If the file is UASTC and is supercompressed with Zstandard, and the file is a texture array or cubemap, it's highly recommended that each mipmap level is 
 		// completely transcoded before switching to another level. Every time the mipmap level is changed all supercompressed level data must be decompressed using Zstandard as a single unit.
-		// Currently ETC1S videos must always be transcoded from first to last frame (or KTX2 "layer"), in order, with no skipping of frames.
+		// ETC1S video frames (KTX2 "layers") must be transcoded in order starting at an I-frame with this method. Use transcode_video_frame() to seek.
 		// By default this method is not thread safe unless you specify a pointer to a user allocated thread-specific transcoder_state struct.
 		bool transcode_image_level(
 			uint32_t level_index, uint32_t layer_index, uint32_t face_index,
@@ -1413,7 +1706,71 @@ namespace basist
 			basist::transcoder_texture_format fmt,
 			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, uint32_t output_rows_in_pixels = 0, int channel0 = -1, int channel1 = -1,
 			ktx2_transcoder_state *pState = nullptr);
-				
+
+		// transcode_video_frame() is transcode_image_level() with random access to ETC1S video frames. If pState already holds layer_index's previous frame (or the 
+		// frame itself) only layer_index is transcoded, so playing frames in order decodes each one once. Otherwise every frame from the closest I-frame up to layer_index 
+		// is transcoded into pOutput_blocks, leaving layer_index's. Other files are passed straight to transcode_image_level().
+		// Use one pState per stream (the internal state if nullptr), and only with one output format.
+		bool transcode_video_frame(
+			uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+			basist::transcoder_texture_format fmt,
+			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, uint32_t output_rows_in_pixels = 0, int channel0 = -1, int channel1 = -1,
+			ktx2_transcoder_state* pState = nullptr);
+
+		// transcode_image_level_mt() is like transcode_image_level(), except the image is split into horizontal bands of block rows which are transcoded in parallel
+		// using mt_params's job system. The output is byte for byte identical to transcode_image_level(). Each band gets its own basisu_transcoder_state (held in pState).
+		// Bands are only used where every block can be independently decoded: UASTC LDR 4x4, UASTC HDR 4x4, ASTC HDR 6x6, and plain ASTC LDR (when deblocking is disabled).
+		// ETC1S, XUASTC LDR, XUBC7 and UASTC HDR 6x6i slices are entropy coded with prediction state that runs across the entire slice, and the only clean sync point
+		// in these bitstreams is the start of the slice, so these are always transcoded as a single band. PVRTC1 output is also always transcoded serially.
+		// pState must not be shared between threads which call this method concurrently.
+		bool transcode_image_level_mt(
+			uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+			basist::transcoder_texture_format fmt,
+			const basisu_transcoder_parallel_params& mt_params,
+			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, uint32_t output_rows_in_pixels = 0, int channel0 = -1, int channel1 = -1,
+			ktx2_transcoder_state* pState = nullptr);
+
+		// transcode_image_level_region() transcodes a single rectangle of source blocks from an image, for sparse/virtual texture streaming.
+		// block_x0/block_y0/block_w/block_h are in source blocks (get_block_width() by get_block_height() texels). The output is sized to the rectangle: it's as if
+		// transcode_image_level() was called on an image with the rectangle's dimensions in texels (clipped to the level's dimensions), so output_blocks_buf_size_in_blocks_or_pixels,
+		// output_row_pitch_in_blocks_or_pixels and output_rows_in_pixels are all relative to the rectangle.
+		// The rectangle's top left texel must be on an output block boundary, i.e. block_x0*get_block_width() must be a multiple of fmt's block width (the same for y).
+		// Output blocks which straddle the rectangle's right or bottom edge (only possible when the source and output block sizes differ) are encoded from the 
+		// rectangle's texels only. Otherwise the output is identical to the same blocks written by transcode_image_level().
+		// - UASTC LDR/HDR 4x4, ASTC HDR 6x6 and ASTC LDR (without deblocking): only the rectangle's blocks are read. With cDecodeFlagsStreamZstdLevelData, Zstd supercompressed 
+		//   levels are only decompressed up to the rectangle's last block row.
+		// - ETC1S: decoding starts at the closest seek index checkpoint above the rectangle (see basisu_transcoder_state::cETC1SCheckpointRows) and stops at the rectangle's 
+		//   last block row. The seek index is built in pState as rows are decoded, so reuse pState for the same texture.
+		// - XUASTC LDR, XUBC7 and UASTC HDR 6x6i (and deblocked ASTC LDR, and ETC1S video) have adaptive entropy coding or filtering running across the whole image, so the image is 
+		//   transcoded to fmt once and cached in pState, and rectangles are copied from the cache. ETC1S video frames are transcoded with transcode_video_frame().
+		// PVRTC1 isn't supported. start_transcoding() must have been called first. pState must not be shared between threads which call this method concurrently.
+		bool transcode_image_level_region(
+			uint32_t level_index, uint32_t layer_index, uint32_t face_index,
+			uint32_t block_x0, uint32_t block_y0, uint32_t block_w, uint32_t block_h,
+			void* pOutput_blocks, uint32_t output_blocks_buf_size_in_blocks_or_pixels,
+			basist::transcoder_texture_format fmt,
+			uint32_t decode_flags = 0, uint32_t output_row_pitch_in_blocks_or_pixels = 0, uint32_t output_rows_in_pixels = 0, int channel0 = -1, int channel1 = -1,
+			ktx2_transcoder_state* pState = nullptr);
+
+		// Computes where every subresource (level/layer/face) selected by layout would be placed in an upload buffer of fmt texture data, without transcoding anything.
+		// subresources is returned in buffer order. total_size is the required size of the upload buffer in bytes. Valid after init().
+		bool get_upload_layout(basist::transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+			basisu::vector<transcoder_subresource_desc>& subresources, uint64_t& total_size) const;
+
+		// transcode_texture() transcodes every subresource selected by layout in one call, into a single caller provided upload buffer which must be at least
+		// get_upload_layout()'s total_size bytes. The placement of each subresource is returned in subresources. Bytes between subresources/rows are left untouched.
+		// Subresources are always transcoded level by level (whatever the buffer order is), so each level's Zstd supercompressed data is only decompressed once.
+		// If pMt_params is not nullptr: formats which can be split into bands are transcoded with transcode_image_level_mt(), and the images of the other formats
+		// (ETC1S, XUASTC LDR, etc.) are transcoded in parallel. ETC1S video frames are split into GOPs at each I-frame, and the GOPs are transcoded in parallel, 
+		// each in order with its own state. A layout starting at a P-frame is decoded from the closest I-frame (see transcode_video_frame()).
+		// start_transcoding() must have been called first. pState must not be shared between threads which call this method concurrently.
+		bool transcode_texture(void* pOutput_buf, uint64_t output_buf_size,
+			basist::transcoder_texture_format fmt, const transcoder_upload_layout& layout,
+			basisu::vector<transcoder_subresource_desc>& subresources,
+			uint32_t decode_flags = 0, const basisu_transcoder_parallel_params* pMt_params = nullptr, ktx2_transcoder_state* pState = nullptr);
+
 	private:
 		const uint8_t* m_pData;
 		uint32_t m_data_size;
@@ -1455,7 +1812,13 @@ namespace basist
 		bool m_is_video;
 		float m_ldr_hdr_upconversion_nit_multiplier;
 
+		// ETC1S video: the I-frame layer indices of each mipmap level in ascending order, built by start_transcoding().
+		basisu::vector< basisu::vector<uint32_t> > m_video_iframe_indices;
+
 		bool decompress_level_data(uint32_t level_index, basisu::uint8_vec& uncomp_data);
+		bool get_level_data(uint32_t level_index, uint32_t decode_flags, ktx2_transcoder_state* pState, const uint8_t*& pLevel_data, uint64_t& level_data_size);
+		bool get_image_data(uint32_t level_index, const uint8_t* pLevel_data, uint64_t image_ofs, uint64_t image_size, ktx2_transcoder_state* pState, const uint8_t*& pImage_data);
+		bool stream_level_data(uint32_t level_index, uint64_t image_ofs, uint64_t image_size, ktx2_transcoder_state* pState);
 		bool read_slice_offset_len_global_data(bool read_std_structs);
 		bool decompress_etc1s_global_data();
 		bool read_key_values();
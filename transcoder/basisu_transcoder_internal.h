@@ -40,6 +40,18 @@
 
 #define BASISD_znew (z = 36969 * (z & 65535) + (z >> 16))
 
+// Set BASISD_USE_PRECOMPUTED_TABLES to 0 to build the transcoder's small computed lookup tables (single color, selector range index, BC7 optimal endpoint and ASTC requantization tables) at runtime, 
+// instead of compiling them in as read-only data from basisu_transcoder_tables_precomputed.inc. Regenerate the .inc with BASISD_WRITE_NEW_PRECOMPUTED_TABLES in basisu_transcoder.cpp.
+#ifndef BASISD_USE_PRECOMPUTED_TABLES
+	#define BASISD_USE_PRECOMPUTED_TABLES 1
+#endif
+
+#if BASISD_USE_PRECOMPUTED_TABLES
+	#define BASISD_PRECOMPUTED_CONST const
+#else
+	#define BASISD_PRECOMPUTED_CONST
+#endif
+
 namespace basisu
 {
 	extern bool g_debug_printf;
@@ -303,6 +315,7 @@ namespace basist
 		{
 			basisu::clear_vector(m_code_sizes);
 			basisu::clear_vector(m_lookup);
+			basisu::clear_vector(m_pair_lookup);
 			basisu::clear_vector(m_tree);
 		}
 
@@ -442,11 +455,35 @@ namespace basist
 				m_tree[idx] = (int16_t)sym_index;
 			}
 
+			// Second level of the fast lookup table: for each entry holding a code shorter than fast_lookup_bits, the symbol whose code follows it
+			// if that code also fits entirely in the remaining bits, otherwise 0. Uses the same (code_size << 16) | sym_index packing as m_lookup.
+			m_pair_lookup.resize(huffman_fast_lookup_size);
+
+			for (uint32_t i = 0; i < huffman_fast_lookup_size; i++)
+			{
+				uint32_t pair = 0;
+
+				const int first = m_lookup[i];
+				if (first >= 0)
+				{
+					const uint32_t first_code_size = first >> 16;
+					if ((first_code_size) && (first_code_size < fast_lookup_bits))
+					{
+						const int second = m_lookup[i >> first_code_size];
+						if ((second >= 0) && (second >> 16) && ((uint32_t)(second >> 16) <= (fast_lookup_bits - first_code_size)))
+							pair = (uint32_t)second;
+					}
+				}
+
+				m_pair_lookup[i] = pair;
+			}
+
 			return true;
 		}
 
 		const basisu::uint8_vec &get_code_sizes() const { return m_code_sizes; }
 		const basisu::int_vec &get_lookup() const { return m_lookup; }
+		const basisu::uint_vec &get_pair_lookup() const { return m_pair_lookup; }
 		const basisu::int16_vec &get_tree() const { return m_tree; }
 
 		bool is_valid() const { return m_code_sizes.size() > 0; }
@@ -454,6 +491,7 @@ namespace basist
 	private:
 		basisu::uint8_vec m_code_sizes;
 		basisu::int_vec m_lookup;
+		basisu::uint_vec m_pair_lookup;
 		basisu::int16_vec m_tree;
 	};
 
@@ -466,7 +504,9 @@ namespace basist
 			m_pBuf_start(nullptr),
 			m_pBuf_end(nullptr),
 			m_bit_buf(0),
-			m_bit_buf_size(0)
+			m_bit_buf_size(0),
+			m_pPair_table(nullptr),
+			m_pair_entry(0)
 		{
 		}
 
@@ -478,6 +518,8 @@ namespace basist
 			m_pBuf_end = nullptr;
 			m_bit_buf = 0;
 			m_bit_buf_size = 0;
+			m_pPair_table = nullptr;
+			m_pair_entry = 0;
 		}
 
 		bool init(const uint8_t *pBuf, uint32_t buf_size)
@@ -491,62 +533,42 @@ namespace basist
 			m_pBuf_end = pBuf + buf_size;
 			m_bit_buf = 0;
 			m_bit_buf_size = 0;
+			m_pPair_table = nullptr;
+			m_pair_entry = 0;
 			return true;
 		}
 
 		void stop()
 		{
+			m_pPair_table = nullptr;
 		}
 				
 		inline uint32_t peek_bits(uint32_t num_bits)
 		{
-			if (!num_bits)
-				return 0;
+			assert(num_bits <= 32);
 
-			assert(num_bits <= 25);
-
-			while (m_bit_buf_size < num_bits)
-			{
-				uint32_t c = 0;
-				if (m_pBuf < m_pBuf_end)
-					c = *m_pBuf++;
+			if (m_bit_buf_size < num_bits)
+				refill();
 
-				m_bit_buf |= (c << m_bit_buf_size);
-				m_bit_buf_size += 8;
-				assert(m_bit_buf_size <= 32);
-			}
-
-			return m_bit_buf & ((1 << num_bits) - 1);
+			return (uint32_t)(m_bit_buf & ((1ULL << num_bits) - 1));
 		}
 
 		void remove_bits(uint32_t num_bits)
 		{
 			assert(m_bit_buf_size >= num_bits);
 
+			m_pPair_table = nullptr;
+
 			m_bit_buf >>= num_bits;
 			m_bit_buf_size -= num_bits;
 		}
 
 		uint32_t get_bits(uint32_t num_bits)
 		{
-			if (num_bits > 25)
-			{
-				assert(num_bits <= 32);
-
-				const uint32_t bits0 = peek_bits(25);
-				m_bit_buf >>= 25;
-				m_bit_buf_size -= 25;
-				num_bits -= 25;
-
-				const uint32_t bits = peek_bits(num_bits);
-				m_bit_buf >>= num_bits;
-				m_bit_buf_size -= num_bits;
-
-				return bits0 | (bits << 25);
-			}
-
 			const uint32_t bits = peek_bits(num_bits);
 
+			m_pPair_table = nullptr;
+
 			m_bit_buf >>= num_bits;
 			m_bit_buf_size -= num_bits;
 
@@ -627,27 +649,38 @@ namespace basist
 		inline uint32_t decode_huffman(const huffman_decoding_table &ct, int fast_lookup_bits = basisu::cHuffmanFastLookupBits)
 		{
 			assert(ct.m_code_sizes.size());
+			assert(ct.m_lookup.size() == (1U << fast_lookup_bits));
 
-			const uint32_t huffman_fast_lookup_size = 1 << fast_lookup_bits;
-						
-			while (m_bit_buf_size < 16)
+			// The previous lookup already resolved this symbol if it was decoded from the same table, and nothing else has read bits since.
+			if (m_pPair_table == &ct)
 			{
-				uint32_t c = 0;
-				if (m_pBuf < m_pBuf_end)
-					c = *m_pBuf++;
+				m_pPair_table = nullptr;
 
-				m_bit_buf |= (c << m_bit_buf_size);
-				m_bit_buf_size += 8;
-				assert(m_bit_buf_size <= 32);
+				const uint32_t pair_code_len = m_pair_entry >> 16;
+				m_bit_buf >>= pair_code_len;
+				m_bit_buf_size -= pair_code_len;
+
+				return m_pair_entry & 0xFFFF;
 			}
+
+			const uint32_t huffman_fast_lookup_size = 1 << fast_lookup_bits;
+						
+			if (m_bit_buf_size < 16)
+				refill();
+
+			const uint32_t lookup_index = (uint32_t)m_bit_buf & (huffman_fast_lookup_size - 1);
 						
 			int code_len;
 
 			int sym;
-			if ((sym = ct.m_lookup[m_bit_buf & (huffman_fast_lookup_size - 1)]) >= 0)
+			if ((sym = ct.m_lookup[lookup_index]) >= 0)
 			{
 				code_len = sym >> 16;
 				sym &= 0xFFFF;
+
+				// Both codes are in the bit buffer: the refill above guaranteed at least 16 bits, and the pair fits in fast_lookup_bits.
+				m_pair_entry = ct.m_pair_lookup[lookup_index];
+				m_pPair_table = m_pair_entry ? &ct : nullptr;
 			}
 			else
 			{
@@ -656,6 +689,8 @@ namespace basist
 				{
 					sym = ct.m_tree[~sym + ((m_bit_buf >> code_len++) & 1)]; // ~sym = -sym - 1
 				} while (sym < 0);
+
+				m_pPair_table = nullptr;
 			}
 
 			m_bit_buf >>= code_len;
@@ -731,6 +766,9 @@ namespace basist
 			if (cur != total_used_syms)
 				return false;
 
+			// code_length_table is about to go out of scope.
+			m_pPair_table = nullptr;
+
 			return ct.init(total_used_syms, &code_sizes[0]);
 		}
 
@@ -746,8 +784,40 @@ namespace basist
 		const uint8_t *m_pBuf_start;
 		const uint8_t *m_pBuf_end;
 
-		uint32_t m_bit_buf;
+		// Bits above m_bit_buf_size may already hold the following bytes of the stream (the next refill ORs in the same values).
+		uint64_t m_bit_buf;
 		uint32_t m_bit_buf_size;
+
+		// Set when the last decode_huffman() call's fast lookup also resolved the next symbol, which is still in the bit buffer.
+		const huffman_decoding_table* m_pPair_table;
+		uint32_t m_pair_entry;
+
+		// Tops the bit buffer up to at least 56 bits. Loads 8 bytes at once unless it's near the end of the stream.
+		inline void refill()
+		{
+			if ((m_pBuf_end - m_pBuf) >= 8)
+			{
+				m_bit_buf |= basisu::read_le_qword(m_pBuf) << m_bit_buf_size;
+
+				const uint32_t num_bytes = (63 - m_bit_buf_size) >> 3;
+				m_pBuf += num_bytes;
+				m_bit_buf_size += num_bytes << 3;
+			}
+			else
+			{
+				while (m_bit_buf_size <= 56)
+				{
+					uint64_t c = 0;
+					if (m_pBuf < m_pBuf_end)
+						c = *m_pBuf++;
+
+					m_bit_buf |= (c << m_bit_buf_size);
+					m_bit_buf_size += 8;
+				}
+			}
+
+			assert(m_bit_buf_size <= 64);
+		}
 	};
 
 	class simplified_bitwise_decoder
@@ -863,6 +933,10 @@ namespace basist
 	class approx_move_to_front
 	{
 	public:
+		approx_move_to_front() : m_rover(0)
+		{
+		}
+
 		approx_move_to_front(uint32_t n)
 		{
 			init(n);
@@ -1462,8 +1536,8 @@ namespace basist
 
 	namespace astc_6x6_hdr
 	{
-		extern uint8_t g_quantize_tables_preserve2[21 - 1][256]; // astc_helpers::TOTAL_ISE_RANGES=21
-		extern uint8_t g_quantize_tables_preserve3[21 - 1][256];
+		extern BASISD_PRECOMPUTED_CONST uint8_t g_quantize_tables_preserve2[21 - 1][256]; // astc_helpers::TOTAL_ISE_RANGES=21
+		extern BASISD_PRECOMPUTED_CONST uint8_t g_quantize_tables_preserve3[21 - 1][256];
 	} // namespace astc_6x6_hdr
 
 #if BASISD_SUPPORT_XUASTC
@@ -120,7 +120,7 @@ namespace basist
 		uint8_t m_index; // sorted index
 	};
 
-	extern astc_quant_bin g_astc_unquant[BC7ENC_TOTAL_ASTC_RANGES][256]; // [ASTC encoded endpoint index]
+	extern BASISD_PRECOMPUTED_CONST astc_quant_bin g_astc_unquant[BC7ENC_TOTAL_ASTC_RANGES][256]; // [ASTC encoded endpoint index]
 
 	int astc_get_levels(int range);
 	bool astc_is_valid_endpoint_range(uint32_t range);
@@ -176,10 +176,10 @@ namespace basist
 		uint16_t m_error; uint8_t m_lo; uint8_t m_hi;
 	};
 
-	extern endpoint_err g_bc7_mode_6_optimal_endpoints[256][2]; // [c][pbit]
+	extern BASISD_PRECOMPUTED_CONST endpoint_err g_bc7_mode_6_optimal_endpoints[256][2]; // [c][pbit]
 	const uint32_t BC7ENC_MODE_6_OPTIMAL_INDEX = 5;
 
-	extern endpoint_err g_bc7_mode_5_optimal_endpoints[256]; // [c]
+	extern BASISD_PRECOMPUTED_CONST endpoint_err g_bc7_mode_5_optimal_endpoints[256]; // [c]
 	const uint32_t BC7ENC_MODE_5_OPTIMAL_INDEX = 1;
 
 	// Packs a BC7 block from a high-level description. Handles all BC7 modes.
@@ -3084,6 +3084,7 @@ EMSCRIPTEN_BINDINGS(basis_codec) {
     .value("cDecodeFlagsNoDeblockFiltering", cDecodeFlagsNoDeblockFiltering)
     .value("cDecodeFlagsForceDeblockFiltering", cDecodeFlagsForceDeblockFiltering)
     .value("cDecodeFlagXUASTCLDRDisableFastBC7Transcoding", cDecodeFlagXUASTCLDRDisableFastBC7Transcoding)
+    .value("cDecodeFlagsStreamZstdLevelData", cDecodeFlagsStreamZstdLevelData)
   ;
 
   // The low-level ETC1S transcoder is a class because it has persistent state (such as the endpoint/selector codebooks and Huffman tables, and transcoder state for video)